@@ -0,0 +1,137 @@
+#ifndef RAC_BENCH_COMMON_H
+#define RAC_BENCH_COMMON_H
+
+/**
+ * Shared helpers for the rac_bench_* tools: argument parsing, latency
+ * percentiles and process memory. Header-only so each benchmark stays a
+ * single translation unit.
+ */
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#if defined(__APPLE__)
+#include <mach/mach.h>
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+namespace rac {
+namespace bench {
+
+// Parse "1,2,4" into {1, 2, 4}; invalid or non-positive entries are skipped
+inline std::vector<int> parse_int_list(const std::string& value) {
+    std::vector<int> out;
+    std::stringstream ss(value);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        char* end = nullptr;
+        long parsed = std::strtol(item.c_str(), &end, 10);
+        if (end != item.c_str() && parsed > 0) {
+            out.push_back(static_cast<int>(parsed));
+        }
+    }
+    return out;
+}
+
+// Nearest-rank percentile over an unsorted sample (p in [0, 100])
+inline double percentile(std::vector<double> samples, double p) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    std::sort(samples.begin(), samples.end());
+    double rank = std::ceil(p / 100.0 * static_cast<double>(samples.size()));
+    size_t index = rank < 1.0 ? 0 : static_cast<size_t>(rank) - 1;
+    return samples[std::min(index, samples.size() - 1)];
+}
+
+inline nlohmann::json latency_summary(const std::vector<double>& samples_ms) {
+    double sum = 0.0;
+    for (double v : samples_ms) {
+        sum += v;
+    }
+    return {
+        {"count", samples_ms.size()},
+        {"mean", samples_ms.empty() ? 0.0 : sum / static_cast<double>(samples_ms.size())},
+        {"p50", percentile(samples_ms, 50.0)},
+        {"p95", percentile(samples_ms, 95.0)},
+        {"p99", percentile(samples_ms, 99.0)},
+        {"max", percentile(samples_ms, 100.0)},
+    };
+}
+
+// Process high-water mark resident set size in bytes
+inline uint64_t peak_rss_bytes() {
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#if defined(__APPLE__)
+    return static_cast<uint64_t>(usage.ru_maxrss);  // bytes on Darwin
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;  // kilobytes on Linux
+#endif
+}
+
+// Current resident set size in bytes. Unlike the high-water mark this drops
+// when memory is released, so it can be sampled per configuration.
+inline uint64_t current_rss_bytes() {
+#if defined(__APPLE__)
+    mach_task_basic_info_data_t info {};
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, reinterpret_cast<task_info_t>(&info),
+                  &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return static_cast<uint64_t>(info.resident_size);
+#else
+    FILE* file = fopen("/proc/self/statm", "r");
+    if (!file) {
+        return 0;
+    }
+    unsigned long long total_pages = 0;
+    unsigned long long resident_pages = 0;
+    const int read = fscanf(file, "%llu %llu", &total_pages, &resident_pages);
+    fclose(file);
+    if (read != 2) {
+        return 0;
+    }
+    return static_cast<uint64_t>(resident_pages) * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+// User + system CPU time consumed by the whole process, in nanoseconds
+inline uint64_t process_cpu_ns() {
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+    auto to_ns = [](const timeval& tv) {
+        return static_cast<uint64_t>(tv.tv_sec) * 1000000000ULL +
+               static_cast<uint64_t>(tv.tv_usec) * 1000ULL;
+    };
+    return to_ns(usage.ru_utime) + to_ns(usage.ru_stime);
+}
+
+inline double ns_to_ms(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
+// Tokens per second for a token count processed over ns nanoseconds
+inline double tokens_per_second(uint64_t tokens, uint64_t ns) {
+    return ns > 0 ? static_cast<double>(tokens) * 1e9 / static_cast<double>(ns) : 0.0;
+}
+
+}  // namespace bench
+}  // namespace rac
+
+#endif  // RAC_BENCH_COMMON_H
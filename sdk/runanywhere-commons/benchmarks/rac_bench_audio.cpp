@@ -0,0 +1,664 @@
+/**
+ * @file rac_bench_audio.cpp
+ * @brief Audio pipeline benchmark reporting real-time factor per stage
+ *
+ * Replays a WAV corpus through each voice pipeline stage and reports, per
+ * stage: real-time factor (processing time / audio time), per-call latency
+ * percentiles, heap allocations per call and CPU utilisation. cpu_rtf (CPU
+ * time / audio time) bounds how many concurrent sessions one core can hold.
+ *
+ * Stages (each runs only when its model is given, except energy VAD):
+ *   energy_vad   rac_energy_vad_process_audio, 100 ms frames
+ *   onnx_vad     rac_vad_onnx_process (Silero via ONNXVAD::process), 32 ms frames
+ *   wakeword     rac_wakeword_onnx_process, 80 ms frames
+ *   onnx_stt     rac_stt_onnx_transcribe (ONNXSTT::transcribe), one call per file
+ *   whisper_stt  rac_stt_whispercpp_transcribe (WhisperCppSTT), one call per file
+ *   onnx_tts     rac_tts_onnx_synthesize (ONNXTTS::synthesize), one call per sentence
+ *
+ * Usage:
+ *   rac_bench_audio --corpus <dir> [--wav <file>]... [options]
+ *
+ * Options:
+ *   --corpus <dir>             Use every .wav file in dir
+ *   --wav <file>               Add a WAV file (repeatable)
+ *   --vad-model <path>         Silero VAD model (enables onnx_vad)
+ *   --wakeword-model <path>    Wake word classifier (enables wakeword)
+ *   --wakeword-embedding <p>   openWakeWord embedding model
+ *   --wakeword-melspec <p>     openWakeWord melspectrogram model
+ *   --stt-model <dir>          Sherpa-ONNX STT model directory (enables onnx_stt)
+ *   --whisper-model <path>     whisper.cpp model (enables whisper_stt)
+ *   --tts-model <dir>          Sherpa-ONNX TTS model directory (enables onnx_tts)
+ *   --tts-text <file>          Sentences to synthesize, one per line
+ *   --threads, -t <n>          Threads for model stages (default: 1)
+ *   --repetitions, -r <n>      Passes over the corpus per stage (default: 1)
+ *   --output, -o <path>        Write JSON to a file instead of stdout
+ *   --verbose, -v              Keep backend info logging
+ *
+ * Allocations count global operator new calls made anywhere in the process;
+ * malloc from C code inside third-party runtimes is not included.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "bench_common.h"
+#include "rac/core/rac_audio_utils.h"
+#include "rac/core/rac_logger.h"
+#include "rac/core/rac_profiler.h"
+#include "rac/features/vad/rac_vad_energy.h"
+
+#ifdef RAC_BENCH_HAS_ONNX
+#include "rac/backends/rac_stt_onnx.h"
+#include "rac/backends/rac_tts_onnx.h"
+#include "rac/backends/rac_vad_onnx.h"
+#include "rac/backends/rac_wakeword_onnx.h"
+#endif
+
+#ifdef RAC_BENCH_HAS_WHISPERCPP
+#include "rac/backends/rac_stt_whispercpp.h"
+#endif
+
+// =============================================================================
+// ALLOCATION COUNTING
+// =============================================================================
+
+namespace {
+std::atomic<uint64_t> g_allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+constexpr int BENCH_SAMPLE_RATE = 16000;
+
+// =============================================================================
+// OPTIONS
+// =============================================================================
+
+struct BenchOptions {
+    std::vector<std::string> wav_paths;
+    std::string vad_model;
+    std::string wakeword_model;
+    std::string wakeword_embedding;
+    std::string wakeword_melspec;
+    std::string stt_model;
+    std::string whisper_model;
+    std::string tts_model;
+    std::string tts_text_path;
+    int threads = 1;
+    int repetitions = 1;
+    std::string output_path;
+    bool verbose = false;
+};
+
+void print_usage(const char* program) {
+    printf("Usage: %s --corpus <dir> [--wav <file>]... [options]\n\n", program);
+    printf("Options:\n");
+    printf("  --corpus <dir>             Use every .wav file in dir\n");
+    printf("  --wav <file>               Add a WAV file (repeatable)\n");
+    printf("  --vad-model <path>         Silero VAD model (enables onnx_vad)\n");
+    printf("  --wakeword-model <path>    Wake word classifier (enables wakeword)\n");
+    printf("  --wakeword-embedding <p>   openWakeWord embedding model\n");
+    printf("  --wakeword-melspec <p>     openWakeWord melspectrogram model\n");
+    printf("  --stt-model <dir>          Sherpa-ONNX STT model directory (enables onnx_stt)\n");
+    printf("  --whisper-model <path>     whisper.cpp model (enables whisper_stt)\n");
+    printf("  --tts-model <dir>          Sherpa-ONNX TTS model directory (enables onnx_tts)\n");
+    printf("  --tts-text <file>          Sentences to synthesize, one per line\n");
+    printf("  --threads, -t <n>          Threads for model stages (default: 1)\n");
+    printf("  --repetitions, -r <n>      Passes over the corpus per stage (default: 1)\n");
+    printf("  --output, -o <path>        Write JSON to a file instead of stdout\n");
+    printf("  --verbose, -v              Keep backend info logging\n");
+}
+
+bool parse_args(int argc, char* argv[], BenchOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        auto is = [arg](const char* long_name, const char* short_name = nullptr) {
+            return std::strcmp(arg, long_name) == 0 ||
+                   (short_name && std::strcmp(arg, short_name) == 0);
+        };
+
+        if (is("--help", "-h")) {
+            return false;
+        } else if (is("--verbose", "-v")) {
+            opts.verbose = true;
+        } else if (is("--corpus") && has_value) {
+            std::error_code ec;
+            for (const auto& entry : std::filesystem::directory_iterator(argv[++i], ec)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".wav") {
+                    opts.wav_paths.push_back(entry.path().string());
+                }
+            }
+        } else if (is("--wav") && has_value) {
+            opts.wav_paths.emplace_back(argv[++i]);
+        } else if (is("--vad-model") && has_value) {
+            opts.vad_model = argv[++i];
+        } else if (is("--wakeword-model") && has_value) {
+            opts.wakeword_model = argv[++i];
+        } else if (is("--wakeword-embedding") && has_value) {
+            opts.wakeword_embedding = argv[++i];
+        } else if (is("--wakeword-melspec") && has_value) {
+            opts.wakeword_melspec = argv[++i];
+        } else if (is("--stt-model") && has_value) {
+            opts.stt_model = argv[++i];
+        } else if (is("--whisper-model") && has_value) {
+            opts.whisper_model = argv[++i];
+        } else if (is("--tts-model") && has_value) {
+            opts.tts_model = argv[++i];
+        } else if (is("--tts-text") && has_value) {
+            opts.tts_text_path = argv[++i];
+        } else if (is("--threads", "-t") && has_value) {
+            opts.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--repetitions", "-r") && has_value) {
+            opts.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--output", "-o") && has_value) {
+            opts.output_path = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown or incomplete argument: %s\n", arg);
+            return false;
+        }
+    }
+
+    std::sort(opts.wav_paths.begin(), opts.wav_paths.end());
+    return !opts.wav_paths.empty() || !opts.tts_model.empty();
+}
+
+// =============================================================================
+// CORPUS LOADING
+// =============================================================================
+
+struct Clip {
+    std::string path;
+    std::vector<float> samples;  // 16 kHz mono
+
+    double seconds() const {
+        return static_cast<double>(samples.size()) / BENCH_SAMPLE_RATE;
+    }
+};
+
+uint16_t read_u16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t read_u32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+std::vector<float> resample_linear(const std::vector<float>& in, int from_rate, int to_rate) {
+    if (from_rate == to_rate || in.empty()) {
+        return in;
+    }
+    const double ratio = static_cast<double>(from_rate) / to_rate;
+    const size_t out_len = static_cast<size_t>(static_cast<double>(in.size()) / ratio);
+    std::vector<float> out(out_len);
+    for (size_t i = 0; i < out_len; ++i) {
+        const double pos = static_cast<double>(i) * ratio;
+        const size_t idx = static_cast<size_t>(pos);
+        const double frac = pos - static_cast<double>(idx);
+        const float a = in[idx];
+        const float b = idx + 1 < in.size() ? in[idx + 1] : a;
+        out[i] = static_cast<float>(a + (b - a) * frac);
+    }
+    return out;
+}
+
+// Loads 16-bit PCM or 32-bit float WAV and converts to 16 kHz mono float
+bool load_wav(const std::string& path, Clip& clip) {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)),
+                               std::istreambuf_iterator<char>());
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 ||
+        std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        return false;
+    }
+
+    uint16_t format_tag = 0;
+    uint16_t channels = 0;
+    uint32_t sample_rate = 0;
+    uint16_t bits = 0;
+    const uint8_t* data = nullptr;
+    size_t data_size = 0;
+
+    size_t pos = 12;
+    while (pos + 8 <= bytes.size()) {
+        const uint8_t* chunk = bytes.data() + pos;
+        const uint32_t chunk_size = read_u32(chunk + 4);
+        const size_t body = pos + 8;
+        const size_t available = std::min<size_t>(chunk_size, bytes.size() - body);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && available >= 16) {
+            format_tag = read_u16(chunk + 8);
+            channels = read_u16(chunk + 10);
+            sample_rate = read_u32(chunk + 12);
+            bits = read_u16(chunk + 22);
+            if (format_tag == 0xFFFE && available >= 26) {  // WAVE_FORMAT_EXTENSIBLE
+                format_tag = read_u16(chunk + 32);
+            }
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            data_size = available;
+        }
+        pos = body + chunk_size + (chunk_size & 1);
+    }
+
+    rac_audio_view_t view = {};
+    if (format_tag == 1 && bits == 16) {
+        view.format = RAC_AUDIO_SAMPLE_INT16;
+    } else if (format_tag == 3 && bits == 32) {
+        view.format = RAC_AUDIO_SAMPLE_FLOAT32;
+    } else {
+        return false;
+    }
+    if (!data || channels == 0 || sample_rate == 0) {
+        return false;
+    }
+
+    view.data = data;
+    view.channels = channels;
+    view.sample_rate = static_cast<int32_t>(sample_rate);
+    view.num_frames = data_size / (static_cast<size_t>(bits / 8) * channels);
+
+    std::vector<float> mono(view.num_frames);
+    if (rac_audio_view_to_float32_mono(&view, mono.data()) != RAC_SUCCESS) {
+        return false;
+    }
+
+    clip.path = path;
+    clip.samples = resample_linear(mono, static_cast<int>(sample_rate), BENCH_SAMPLE_RATE);
+    return true;
+}
+
+std::vector<std::string> load_lines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty()) {
+            lines.push_back(line);
+        }
+    }
+    return lines;
+}
+
+// =============================================================================
+// STAGE MEASUREMENT
+// =============================================================================
+
+class StageMeter {
+   public:
+    explicit StageMeter(std::string name) : name_(std::move(name)) {
+        cpu_start_ns_ = rac::bench::process_cpu_ns();
+        wall_start_ns_ = rac_profiler_now_ns();
+    }
+
+    // Times one call; fn returns false on failure
+    void call(const std::function<bool()>& fn) {
+        const uint64_t allocs_before = g_allocations.load(std::memory_order_relaxed);
+        const uint64_t start_ns = rac_profiler_now_ns();
+        const bool ok = fn();
+        const uint64_t dur_ns = rac_profiler_now_ns() - start_ns;
+        allocations_ += g_allocations.load(std::memory_order_relaxed) - allocs_before;
+
+        busy_ns_ += dur_ns;
+        call_ms_.push_back(rac::bench::ns_to_ms(dur_ns));
+        if (!ok) {
+            errors_++;
+        }
+    }
+
+    void add_audio_seconds(double seconds) { audio_seconds_ += seconds; }
+
+    nlohmann::json finish() const {
+        const uint64_t cpu_ns = rac::bench::process_cpu_ns() - cpu_start_ns_;
+        const double wall_s = static_cast<double>(rac_profiler_now_ns() - wall_start_ns_) / 1e9;
+        const double busy_s = static_cast<double>(busy_ns_) / 1e9;
+        const double cpu_s = static_cast<double>(cpu_ns) / 1e9;
+        const double calls = static_cast<double>(call_ms_.size());
+        const double rtf = audio_seconds_ > 0 ? busy_s / audio_seconds_ : 0.0;
+        const double cpu_rtf = audio_seconds_ > 0 ? cpu_s / audio_seconds_ : 0.0;
+
+        return {
+            {"stage", name_},
+            {"calls", call_ms_.size()},
+            {"errors", errors_},
+            {"audio_seconds", audio_seconds_},
+            {"processing_seconds", busy_s},
+            {"rtf", rtf},
+            {"latency_ms", rac::bench::latency_summary(call_ms_)},
+            {"allocations_per_call", calls > 0 ? static_cast<double>(allocations_) / calls : 0.0},
+            // Average cores busy while the stage ran
+            {"cpu_utilization", wall_s > 0 ? cpu_s / wall_s : 0.0},
+            {"cpu_rtf", cpu_rtf},
+            {"sessions_per_core", cpu_rtf > 0 ? 1.0 / cpu_rtf : 0.0},
+        };
+    }
+
+   private:
+    std::string name_;
+    std::vector<double> call_ms_;
+    double audio_seconds_ = 0.0;
+    uint64_t busy_ns_ = 0;
+    uint64_t allocations_ = 0;
+    uint64_t cpu_start_ns_ = 0;
+    uint64_t wall_start_ns_ = 0;
+    int errors_ = 0;
+};
+
+// Feeds every clip in fixed-size frames, as a live microphone would
+nlohmann::json run_streaming_stage(const std::string& name, const std::vector<Clip>& corpus,
+                                   size_t frame_samples, int repetitions,
+                                   const std::function<bool(const float*, size_t)>& process) {
+    StageMeter meter(name);
+    for (int rep = 0; rep < repetitions; ++rep) {
+        for (const Clip& clip : corpus) {
+            for (size_t off = 0; off + frame_samples <= clip.samples.size();
+                 off += frame_samples) {
+                const float* frame = clip.samples.data() + off;
+                meter.call([&]() { return process(frame, frame_samples); });
+            }
+            meter.add_audio_seconds(static_cast<double>(clip.samples.size() / frame_samples *
+                                                        frame_samples) /
+                                    BENCH_SAMPLE_RATE);
+        }
+    }
+    fprintf(stderr, "  %s done\n", name.c_str());
+    return meter.finish();
+}
+
+// Processes each clip in one call, as batch transcription does
+nlohmann::json run_utterance_stage(const std::string& name, const std::vector<Clip>& corpus,
+                                   int repetitions,
+                                   const std::function<bool(const Clip&)>& process) {
+    StageMeter meter(name);
+    for (int rep = 0; rep < repetitions; ++rep) {
+        for (const Clip& clip : corpus) {
+            meter.call([&]() { return process(clip); });
+            meter.add_audio_seconds(clip.seconds());
+        }
+    }
+    fprintf(stderr, "  %s done\n", name.c_str());
+    return meter.finish();
+}
+
+// =============================================================================
+// STAGES
+// =============================================================================
+
+nlohmann::json bench_energy_vad(const std::vector<Clip>& corpus, int repetitions) {
+    rac_energy_vad_config_t config = RAC_ENERGY_VAD_CONFIG_DEFAULT;
+    rac_energy_vad_handle_t vad = nullptr;
+    if (rac_energy_vad_create(&config, &vad) != RAC_SUCCESS ||
+        rac_energy_vad_initialize(vad) != RAC_SUCCESS || rac_energy_vad_start(vad) != RAC_SUCCESS) {
+        rac_energy_vad_destroy(vad);
+        return {{"stage", "energy_vad"}, {"error", "initialization failed"}};
+    }
+
+    const size_t frame = static_cast<size_t>(config.sample_rate * config.frame_length);
+    nlohmann::json result =
+        run_streaming_stage("energy_vad", corpus, frame, repetitions, [&](const float* s, size_t n) {
+            rac_bool_t has_voice = RAC_FALSE;
+            return rac_energy_vad_process_audio(vad, s, n, &has_voice) == RAC_SUCCESS;
+        });
+    rac_energy_vad_destroy(vad);
+    return result;
+}
+
+#ifdef RAC_BENCH_HAS_ONNX
+nlohmann::json bench_onnx_vad(const BenchOptions& opts, const std::vector<Clip>& corpus) {
+    rac_vad_onnx_config_t config = RAC_VAD_ONNX_CONFIG_DEFAULT;
+    config.num_threads = opts.threads;
+    rac_handle_t vad = nullptr;
+    if (rac_vad_onnx_create(opts.vad_model.c_str(), &config, &vad) != RAC_SUCCESS) {
+        return {{"stage", "onnx_vad"}, {"error", "model load failed"}};
+    }
+
+    const size_t frame = static_cast<size_t>(config.sample_rate * config.frame_length);
+    nlohmann::json result = run_streaming_stage(
+        "onnx_vad", corpus, frame, opts.repetitions, [&](const float* s, size_t n) {
+            rac_bool_t is_speech = RAC_FALSE;
+            return rac_vad_onnx_process(vad, s, n, &is_speech) == RAC_SUCCESS;
+        });
+    rac_vad_onnx_destroy(vad);
+    return result;
+}
+
+nlohmann::json bench_wakeword(const BenchOptions& opts, const std::vector<Clip>& corpus) {
+    rac_wakeword_onnx_config_t config = RAC_WAKEWORD_ONNX_CONFIG_DEFAULT;
+    config.num_threads = opts.threads;
+    rac_handle_t detector = nullptr;
+    if (rac_wakeword_onnx_create(&config, &detector) != RAC_SUCCESS ||
+        rac_wakeword_onnx_init_shared_models(
+            detector, opts.wakeword_embedding.c_str(),
+            opts.wakeword_melspec.empty() ? nullptr : opts.wakeword_melspec.c_str()) !=
+            RAC_SUCCESS ||
+        rac_wakeword_onnx_load_model(detector, opts.wakeword_model.c_str(), "bench",
+                                     "bench") != RAC_SUCCESS) {
+        if (detector) {
+            rac_wakeword_onnx_destroy(detector);
+        }
+        return {{"stage", "wakeword"}, {"error", "model load failed"}};
+    }
+
+    nlohmann::json result = run_streaming_stage(
+        "wakeword", corpus, static_cast<size_t>(config.frame_length), opts.repetitions,
+        [&](const float* s, size_t n) {
+            int32_t detected = -1;
+            float confidence = 0.0f;
+            return rac_wakeword_onnx_process(detector, s, n, &detected, &confidence) ==
+                   RAC_SUCCESS;
+        });
+    rac_wakeword_onnx_destroy(detector);
+    return result;
+}
+
+nlohmann::json bench_onnx_stt(const BenchOptions& opts, const std::vector<Clip>& corpus) {
+    rac_stt_onnx_config_t config = RAC_STT_ONNX_CONFIG_DEFAULT;
+    config.num_threads = opts.threads;
+    rac_handle_t stt = nullptr;
+    if (rac_stt_onnx_create(opts.stt_model.c_str(), &config, &stt) != RAC_SUCCESS) {
+        return {{"stage", "onnx_stt"}, {"error", "model load failed"}};
+    }
+
+    nlohmann::json result =
+        run_utterance_stage("onnx_stt", corpus, opts.repetitions, [&](const Clip& clip) {
+            rac_stt_result_t out = {};
+            rac_result_t rc = rac_stt_onnx_transcribe(stt, clip.samples.data(),
+                                                      clip.samples.size(),
+                                                      &RAC_STT_OPTIONS_DEFAULT, &out);
+            rac_stt_result_free(&out);
+            return rc == RAC_SUCCESS;
+        });
+    rac_stt_onnx_destroy(stt);
+    return result;
+}
+
+nlohmann::json bench_onnx_tts(const BenchOptions& opts) {
+    std::vector<std::string> sentences;
+    if (!opts.tts_text_path.empty()) {
+        sentences = load_lines(opts.tts_text_path);
+    }
+    if (sentences.empty()) {
+        sentences = {
+            "The quick brown fox jumps over the lazy dog.",
+            "Please set a timer for ten minutes and remind me to check the oven.",
+            "Tomorrow will be mostly sunny with a high of twenty two degrees.",
+        };
+    }
+
+    rac_tts_onnx_config_t config = RAC_TTS_ONNX_CONFIG_DEFAULT;
+    config.num_threads = opts.threads;
+    rac_handle_t tts = nullptr;
+    if (rac_tts_onnx_create(opts.tts_model.c_str(), &config, &tts) != RAC_SUCCESS) {
+        return {{"stage", "onnx_tts"}, {"error", "model load failed"}};
+    }
+
+    // For TTS the "audio time" is the synthesized output duration
+    StageMeter meter("onnx_tts");
+    for (int rep = 0; rep < opts.repetitions; ++rep) {
+        for (const std::string& sentence : sentences) {
+            double produced_seconds = 0.0;
+            meter.call([&]() {
+                rac_tts_result_t out = {};
+                rac_result_t rc =
+                    rac_tts_onnx_synthesize(tts, sentence.c_str(), &RAC_TTS_OPTIONS_DEFAULT, &out);
+                if (rc == RAC_SUCCESS && out.sample_rate > 0) {
+                    produced_seconds = static_cast<double>(out.audio_size / sizeof(float)) /
+                                       out.sample_rate;
+                }
+                rac_tts_result_free(&out);
+                return rc == RAC_SUCCESS;
+            });
+            meter.add_audio_seconds(produced_seconds);
+        }
+    }
+    rac_tts_onnx_destroy(tts);
+    fprintf(stderr, "  onnx_tts done\n");
+    return meter.finish();
+}
+#endif  // RAC_BENCH_HAS_ONNX
+
+#ifdef RAC_BENCH_HAS_WHISPERCPP
+nlohmann::json bench_whisper_stt(const BenchOptions& opts, const std::vector<Clip>& corpus) {
+    rac_stt_whispercpp_config_t config = RAC_STT_WHISPERCPP_CONFIG_DEFAULT;
+    config.num_threads = opts.threads;
+    config.use_gpu = RAC_FALSE;
+    config.language = "en";
+    rac_handle_t stt = nullptr;
+    if (rac_stt_whispercpp_create(opts.whisper_model.c_str(), &config, &stt) != RAC_SUCCESS) {
+        return {{"stage", "whisper_stt"}, {"error", "model load failed"}};
+    }
+
+    nlohmann::json result =
+        run_utterance_stage("whisper_stt", corpus, opts.repetitions, [&](const Clip& clip) {
+            rac_stt_result_t out = {};
+            rac_result_t rc = rac_stt_whispercpp_transcribe(stt, clip.samples.data(),
+                                                            clip.samples.size(),
+                                                            &RAC_STT_OPTIONS_DEFAULT, &out);
+            rac_stt_result_free(&out);
+            return rc == RAC_SUCCESS;
+        });
+    rac_stt_whispercpp_destroy(stt);
+    return result;
+}
+#endif  // RAC_BENCH_HAS_WHISPERCPP
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!opts.verbose) {
+        rac_logger_set_min_level(RAC_LOG_WARNING);
+    }
+
+    std::vector<Clip> corpus;
+    double corpus_seconds = 0.0;
+    for (const std::string& path : opts.wav_paths) {
+        Clip clip;
+        if (!load_wav(path, clip)) {
+            fprintf(stderr, "Skipping unsupported WAV: %s\n", path.c_str());
+            continue;
+        }
+        corpus_seconds += clip.seconds();
+        corpus.push_back(std::move(clip));
+    }
+    fprintf(stderr, "Loaded %zu clips (%.1f s of audio)\n", corpus.size(), corpus_seconds);
+
+    nlohmann::json stages = nlohmann::json::array();
+
+    if (!corpus.empty()) {
+        stages.push_back(bench_energy_vad(corpus, opts.repetitions));
+    }
+
+#ifdef RAC_BENCH_HAS_ONNX
+    if (!corpus.empty() && !opts.vad_model.empty()) {
+        stages.push_back(bench_onnx_vad(opts, corpus));
+    }
+    if (!corpus.empty() && !opts.wakeword_model.empty() && !opts.wakeword_embedding.empty()) {
+        stages.push_back(bench_wakeword(opts, corpus));
+    }
+    if (!corpus.empty() && !opts.stt_model.empty()) {
+        stages.push_back(bench_onnx_stt(opts, corpus));
+    }
+    if (!opts.tts_model.empty()) {
+        stages.push_back(bench_onnx_tts(opts));
+    }
+#endif
+
+#ifdef RAC_BENCH_HAS_WHISPERCPP
+    if (!corpus.empty() && !opts.whisper_model.empty()) {
+        stages.push_back(bench_whisper_stt(opts, corpus));
+    }
+#endif
+
+    nlohmann::json report = {
+        {"tool", "rac_bench_audio"},
+        {"clips", corpus.size()},
+        {"corpus_seconds", corpus_seconds},
+        {"threads", opts.threads},
+        {"repetitions", opts.repetitions},
+        {"peak_rss_bytes", rac::bench::peak_rss_bytes()},
+        {"stages", stages},
+    };
+
+    const std::string text = report.dump(2);
+    if (opts.output_path.empty()) {
+        printf("%s\n", text.c_str());
+    } else {
+        FILE* file = fopen(opts.output_path.c_str(), "w");
+        if (!file) {
+            fprintf(stderr, "Failed to open output file: %s\n", opts.output_path.c_str());
+            return 1;
+        }
+        fprintf(file, "%s\n", text.c_str());
+        fclose(file);
+    }
+
+    return 0;
+}
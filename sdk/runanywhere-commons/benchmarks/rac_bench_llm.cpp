@@ -0,0 +1,328 @@
+/**
+ * @file rac_bench_llm.cpp
+ * @brief LLM throughput/latency benchmark driving LlamaCppTextGeneration directly
+ *
+ * Sweeps prompt length x output length x thread count x concurrency and
+ * reports prefill tok/s, decode tok/s, TTFT percentiles, per-config resident
+ * memory and the process-wide peak RSS as JSON. Sampling is greedy with a
+ * fixed seed and EOS is ignored, so every run decodes exactly the requested
+ * number of tokens and results are comparable across commits.
+ *
+ * Usage:
+ *   rac_bench_llm --model <path.gguf> [options]
+ *
+ * Options:
+ *   --model, -m <path>         GGUF model file (required)
+ *   --prompt-tokens <list>     Prompt lengths to sweep (default: 128,512)
+ *   --output-tokens <list>     Output lengths to sweep (default: 128)
+ *   --threads <list>           Thread counts to sweep (default: 4)
+ *   --concurrency <list>       Concurrent generations to sweep (default: 1)
+ *   --repetitions, -r <n>      Measured runs per configuration (default: 3)
+ *   --warmup <n>               Unmeasured runs per configuration (default: 1)
+ *   --context, -c <n>          Context size (default: fits the largest sweep point)
+ *   --gpu-layers, -ngl <n>     GPU layers to offload (default: 0)
+ *   --seed <n>                 Sampling seed (default: 42)
+ *   --output, -o <path>        Write JSON to a file instead of stdout
+ *   --verbose, -v              Keep backend info logging
+ *
+ * Concurrency N loads N independent model instances, since one
+ * LlamaCppTextGeneration serializes its requests.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_common.h"
+#include "llamacpp_backend.h"
+#include "rac/core/rac_logger.h"
+#include "rac/core/rac_profiler.h"
+
+using runanywhere::GenerationTimings;
+using runanywhere::LlamaCppBackend;
+using runanywhere::TextGenerationRequest;
+
+namespace {
+
+struct BenchOptions {
+    std::string model_path;
+    std::vector<int> prompt_tokens = {128, 512};
+    std::vector<int> output_tokens = {128};
+    std::vector<int> threads = {4};
+    std::vector<int> concurrency = {1};
+    int repetitions = 3;
+    int warmup = 1;
+    int context_size = 0;
+    int gpu_layers = 0;
+    uint32_t seed = 42;
+    std::string output_path;
+    bool verbose = false;
+};
+
+void print_usage(const char* program) {
+    printf("Usage: %s --model <path.gguf> [options]\n\n", program);
+    printf("Options:\n");
+    printf("  --model, -m <path>         GGUF model file (required)\n");
+    printf("  --prompt-tokens <list>     Prompt lengths to sweep (default: 128,512)\n");
+    printf("  --output-tokens <list>     Output lengths to sweep (default: 128)\n");
+    printf("  --threads <list>           Thread counts to sweep (default: 4)\n");
+    printf("  --concurrency <list>       Concurrent generations to sweep (default: 1)\n");
+    printf("  --repetitions, -r <n>      Measured runs per configuration (default: 3)\n");
+    printf("  --warmup <n>               Unmeasured runs per configuration (default: 1)\n");
+    printf("  --context, -c <n>          Context size (default: fits the largest sweep point)\n");
+    printf("  --gpu-layers, -ngl <n>     GPU layers to offload (default: 0)\n");
+    printf("  --seed <n>                 Sampling seed (default: 42)\n");
+    printf("  --output, -o <path>        Write JSON to a file instead of stdout\n");
+    printf("  --verbose, -v              Keep backend info logging\n");
+}
+
+bool parse_args(int argc, char* argv[], BenchOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        auto is = [arg](const char* long_name, const char* short_name = nullptr) {
+            return std::strcmp(arg, long_name) == 0 ||
+                   (short_name && std::strcmp(arg, short_name) == 0);
+        };
+
+        if (is("--help", "-h")) {
+            return false;
+        } else if (is("--verbose", "-v")) {
+            opts.verbose = true;
+        } else if (is("--model", "-m") && has_value) {
+            opts.model_path = argv[++i];
+        } else if (is("--prompt-tokens") && has_value) {
+            opts.prompt_tokens = rac::bench::parse_int_list(argv[++i]);
+        } else if (is("--output-tokens") && has_value) {
+            opts.output_tokens = rac::bench::parse_int_list(argv[++i]);
+        } else if (is("--threads", "-t") && has_value) {
+            opts.threads = rac::bench::parse_int_list(argv[++i]);
+        } else if (is("--concurrency") && has_value) {
+            opts.concurrency = rac::bench::parse_int_list(argv[++i]);
+        } else if (is("--repetitions", "-r") && has_value) {
+            opts.repetitions = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--warmup") && has_value) {
+            opts.warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (is("--context", "-c") && has_value) {
+            opts.context_size = std::atoi(argv[++i]);
+        } else if (is("--gpu-layers", "-ngl") && has_value) {
+            opts.gpu_layers = std::atoi(argv[++i]);
+        } else if (is("--seed") && has_value) {
+            opts.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (is("--output", "-o") && has_value) {
+            opts.output_path = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown or incomplete argument: %s\n", arg);
+            return false;
+        }
+    }
+
+    return !opts.model_path.empty() && !opts.prompt_tokens.empty() &&
+           !opts.output_tokens.empty() && !opts.threads.empty() && !opts.concurrency.empty();
+}
+
+// Deterministic filler text of roughly target_tokens tokens. The exact count
+// depends on the tokenizer and chat template; the measured count is reported.
+std::string build_prompt(int target_tokens) {
+    static const char* const WORDS[] = {
+        "the", "quick", "brown", "fox", "jumps", "over", "a", "lazy", "dog", "while",
+        "small", "birds", "sing", "in", "green", "trees", "near", "an", "old", "river",
+    };
+    constexpr int NUM_WORDS = sizeof(WORDS) / sizeof(WORDS[0]);
+
+    std::string prompt = "Summarize the following text:";
+    prompt.reserve(static_cast<size_t>(target_tokens) * 6);
+    for (int i = 0; i < target_tokens; ++i) {
+        prompt += ' ';
+        prompt += WORDS[i % NUM_WORDS];
+    }
+    return prompt;
+}
+
+struct Worker {
+    std::unique_ptr<LlamaCppBackend> backend;
+};
+
+std::vector<Worker> load_workers(const BenchOptions& opts, int threads, int count,
+                                 int context_size) {
+    std::vector<Worker> workers;
+    for (int i = 0; i < count; ++i) {
+        Worker worker;
+        worker.backend = std::make_unique<LlamaCppBackend>();
+        worker.backend->initialize({{"num_threads", threads}});
+
+        nlohmann::json config = {
+            {"context_size", context_size},
+            {"gpu_layers", opts.gpu_layers},
+        };
+        if (!worker.backend->get_text_generation()->load_model(opts.model_path, config)) {
+            fprintf(stderr, "Failed to load model: %s\n", opts.model_path.c_str());
+            return {};
+        }
+        workers.push_back(std::move(worker));
+    }
+    return workers;
+}
+
+// Runs one request on every worker at once; returns batch wall time
+uint64_t run_batch(std::vector<Worker>& workers, const TextGenerationRequest& request,
+                   std::vector<GenerationTimings>& timings, std::vector<char>& ok) {
+    timings.assign(workers.size(), GenerationTimings());
+    ok.assign(workers.size(), 0);
+
+    const uint64_t start_ns = rac_profiler_now_ns();
+    std::vector<std::thread> threads;
+    threads.reserve(workers.size());
+    for (size_t i = 0; i < workers.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            ok[i] = workers[i].backend->get_text_generation()->generate_stream(
+                request, [](const std::string&) { return true; }, nullptr, &timings[i]);
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    return rac_profiler_now_ns() - start_ns;
+}
+
+nlohmann::json run_config(std::vector<Worker>& workers, const BenchOptions& opts,
+                          int prompt_len, int output_len) {
+    TextGenerationRequest request;
+    request.prompt = build_prompt(prompt_len);
+    request.max_tokens = output_len;
+    request.temperature = 0.0f;  // Greedy
+    request.seed = opts.seed;
+    request.ignore_eos = true;
+
+    std::vector<GenerationTimings> timings;
+    std::vector<char> ok;
+
+    for (int i = 0; i < opts.warmup; ++i) {
+        run_batch(workers, request, timings, ok);
+    }
+
+    std::vector<double> ttft_ms;
+    std::vector<double> e2e_ms;
+    uint64_t prompt_tokens = 0;
+    uint64_t generated_tokens = 0;
+    uint64_t prefill_ns = 0;
+    uint64_t decode_ns = 0;
+    uint64_t wall_ns = 0;
+    int failures = 0;
+    int measured_prompt_tokens = 0;
+
+    for (int rep = 0; rep < opts.repetitions; ++rep) {
+        wall_ns += run_batch(workers, request, timings, ok);
+        for (size_t i = 0; i < timings.size(); ++i) {
+            if (!ok[i]) {
+                failures++;
+                continue;
+            }
+            const GenerationTimings& t = timings[i];
+            measured_prompt_tokens = t.prompt_tokens;
+            prompt_tokens += static_cast<uint64_t>(t.prompt_tokens);
+            generated_tokens += static_cast<uint64_t>(t.generated_tokens);
+            prefill_ns += t.prefill_ns;
+            decode_ns += t.decode_ns;
+            ttft_ms.push_back(rac::bench::ns_to_ms(t.ttft_ns));
+            e2e_ms.push_back(rac::bench::ns_to_ms(t.total_ns));
+        }
+    }
+
+    return {
+        {"prompt_tokens_target", prompt_len},
+        {"prompt_tokens", measured_prompt_tokens},
+        {"output_tokens", output_len},
+        {"requests", ttft_ms.size()},
+        {"failures", failures},
+        // Per-stream rates: tokens over time spent in llama_decode
+        {"prefill_tok_s", rac::bench::tokens_per_second(prompt_tokens, prefill_ns)},
+        {"decode_tok_s", rac::bench::tokens_per_second(generated_tokens, decode_ns)},
+        // Aggregate output throughput across all concurrent streams
+        {"aggregate_tok_s", rac::bench::tokens_per_second(generated_tokens, wall_ns)},
+        {"ttft_ms", rac::bench::latency_summary(ttft_ms)},
+        {"e2e_ms", rac::bench::latency_summary(e2e_ms)},
+        // Resident memory with this config's workers loaded. The high-water
+        // mark is process-wide and only reported once, at the top level.
+        {"rss_bytes", rac::bench::current_rss_bytes()},
+    };
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!opts.verbose) {
+        rac_logger_set_min_level(RAC_LOG_WARNING);
+    }
+
+    int context_size = opts.context_size;
+    if (context_size <= 0) {
+        // Headroom for the chat template and the backend's context reserve
+        context_size = *std::max_element(opts.prompt_tokens.begin(), opts.prompt_tokens.end()) +
+                       *std::max_element(opts.output_tokens.begin(), opts.output_tokens.end()) +
+                       256;
+    }
+
+    nlohmann::json results = nlohmann::json::array();
+
+    for (int threads : opts.threads) {
+        for (int concurrency : opts.concurrency) {
+            std::vector<Worker> workers = load_workers(opts, threads, concurrency, context_size);
+            if (workers.empty()) {
+                return 1;
+            }
+
+            for (int prompt_len : opts.prompt_tokens) {
+                for (int output_len : opts.output_tokens) {
+                    fprintf(stderr, "threads=%d concurrency=%d prompt=%d output=%d\n", threads,
+                            concurrency, prompt_len, output_len);
+                    nlohmann::json entry = run_config(workers, opts, prompt_len, output_len);
+                    entry["threads"] = threads;
+                    entry["concurrency"] = concurrency;
+                    results.push_back(std::move(entry));
+                }
+            }
+        }
+    }
+
+    nlohmann::json report = {
+        {"tool", "rac_bench_llm"},
+        {"model", opts.model_path},
+        {"sampling", "greedy"},
+        {"seed", opts.seed},
+        {"context_size", context_size},
+        {"gpu_layers", opts.gpu_layers},
+        {"repetitions", opts.repetitions},
+        {"warmup", opts.warmup},
+        // Process-wide high-water mark across every config in this run
+        {"process_peak_rss_bytes", rac::bench::peak_rss_bytes()},
+        {"results", results},
+    };
+
+    const std::string text = report.dump(2);
+    if (opts.output_path.empty()) {
+        printf("%s\n", text.c_str());
+    } else {
+        FILE* file = fopen(opts.output_path.c_str(), "w");
+        if (!file) {
+            fprintf(stderr, "Failed to open output file: %s\n", opts.output_path.c_str());
+            return 1;
+        }
+        fprintf(file, "%s\n", text.c_str());
+        fclose(file);
+    }
+
+    return 0;
+}
@@ -0,0 +1,542 @@
+/**
+ * @file rac_bench_rag.cpp
+ * @brief RAG benchmark: ingestion rate, HNSW recall@k vs exact search, and QPS
+ *
+ * Three phases, all on deterministic synthetic data (fixed seed):
+ *   ingest  Documents go through RAGBackend::add_document (chunker, embedding
+ *           provider, vector store). Reports docs/s, chunks/s and embeddings/s.
+ *   recall  Clustered unit vectors are indexed in VectorStoreUSearch for every
+ *           connectivity x expansion_search pair. Reports build rate and
+ *           recall@k against a brute-force exact cosine scan.
+ *   qps     Query throughput and latency percentiles at each thread count.
+ *
+ * The default embedding provider hashes words into a sparse vector, so ingest
+ * numbers isolate pipeline overhead. Pass --embedding-model to measure a real
+ * ONNX embedding model instead (requires the ONNX backend).
+ *
+ * Usage:
+ *   rac_bench_rag [options]
+ *
+ * Options:
+ *   --documents <n>            Documents to ingest (default: 500)
+ *   --words-per-doc <n>        Words per synthetic document (default: 400)
+ *   --embedding-model <path>   ONNX embedding model for the ingest phase
+ *   --vectors <n>              Vectors indexed for recall/QPS (default: 20000)
+ *   --dimension <n>            Vector dimension (default: 384)
+ *   --queries <n>              Queries per measurement (default: 500)
+ *   --top-k <n>                k for recall@k (default: 10)
+ *   --connectivity <list>      HNSW M values (default: 8,16,32)
+ *   --expansion-search <list>  HNSW ef values (default: 16,64,128)
+ *   --query-threads <list>     Thread counts for QPS (default: 1,4)
+ *   --seed <n>                 RNG seed (default: 42)
+ *   --output, -o <path>        Write JSON to a file instead of stdout
+ *   --verbose, -v              Keep backend info logging
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "bench_common.h"
+#include "rac/core/rac_logger.h"
+#include "rac/core/rac_profiler.h"
+#include "rag_backend.h"
+#include "vector_store_usearch.h"
+
+using runanywhere::rag::DocumentChunk;
+using runanywhere::rag::IEmbeddingProvider;
+using runanywhere::rag::RAGBackend;
+using runanywhere::rag::RAGBackendConfig;
+using runanywhere::rag::VectorStoreConfig;
+using runanywhere::rag::VectorStoreUSearch;
+
+namespace {
+
+// =============================================================================
+// OPTIONS
+// =============================================================================
+
+struct BenchOptions {
+    int documents = 500;
+    int words_per_doc = 400;
+    std::string embedding_model;
+    int vectors = 20000;
+    int dimension = 384;
+    int queries = 500;
+    int top_k = 10;
+    std::vector<int> connectivity = {8, 16, 32};
+    std::vector<int> expansion_search = {16, 64, 128};
+    std::vector<int> query_threads = {1, 4};
+    uint32_t seed = 42;
+    std::string output_path;
+    bool verbose = false;
+};
+
+void print_usage(const char* program) {
+    printf("Usage: %s [options]\n\n", program);
+    printf("Options:\n");
+    printf("  --documents <n>            Documents to ingest (default: 500)\n");
+    printf("  --words-per-doc <n>        Words per synthetic document (default: 400)\n");
+    printf("  --embedding-model <path>   ONNX embedding model for the ingest phase\n");
+    printf("  --vectors <n>              Vectors indexed for recall/QPS (default: 20000)\n");
+    printf("  --dimension <n>            Vector dimension (default: 384)\n");
+    printf("  --queries <n>              Queries per measurement (default: 500)\n");
+    printf("  --top-k <n>                k for recall@k (default: 10)\n");
+    printf("  --connectivity <list>      HNSW M values (default: 8,16,32)\n");
+    printf("  --expansion-search <list>  HNSW ef values (default: 16,64,128)\n");
+    printf("  --query-threads <list>     Thread counts for QPS (default: 1,4)\n");
+    printf("  --seed <n>                 RNG seed (default: 42)\n");
+    printf("  --output, -o <path>        Write JSON to a file instead of stdout\n");
+    printf("  --verbose, -v              Keep backend info logging\n");
+}
+
+bool parse_args(int argc, char* argv[], BenchOptions& opts) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const bool has_value = i + 1 < argc;
+
+        auto is = [arg](const char* long_name, const char* short_name = nullptr) {
+            return std::strcmp(arg, long_name) == 0 ||
+                   (short_name && std::strcmp(arg, short_name) == 0);
+        };
+
+        if (is("--help", "-h")) {
+            return false;
+        } else if (is("--verbose", "-v")) {
+            opts.verbose = true;
+        } else if (is("--documents") && has_value) {
+            opts.documents = std::max(0, std::atoi(argv[++i]));
+        } else if (is("--words-per-doc") && has_value) {
+            opts.words_per_doc = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--embedding-model") && has_value) {
+            opts.embedding_model = argv[++i];
+        } else if (is("--vectors") && has_value) {
+            opts.vectors = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--dimension") && has_value) {
+            opts.dimension = std::max(2, std::atoi(argv[++i]));
+        } else if (is("--queries") && has_value) {
+            opts.queries = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--top-k") && has_value) {
+            opts.top_k = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--connectivity") && has_value) {
+            opts.connectivity = rac::bench::parse_int_list(argv[++i]);
+        } else if (is("--expansion-search") && has_value) {
+            opts.expansion_search = rac::bench::parse_int_list(argv[++i]);
+        } else if (is("--query-threads") && has_value) {
+            opts.query_threads = rac::bench::parse_int_list(argv[++i]);
+        } else if (is("--seed") && has_value) {
+            opts.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (is("--output", "-o") && has_value) {
+            opts.output_path = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown or incomplete argument: %s\n", arg);
+            return false;
+        }
+    }
+
+    return !opts.connectivity.empty() && !opts.expansion_search.empty() &&
+           !opts.query_threads.empty();
+}
+
+// =============================================================================
+// EMBEDDING PROVIDERS
+// =============================================================================
+
+// Feature-hashing bag of words: deterministic and model-free
+class HashEmbeddingProvider final : public IEmbeddingProvider {
+   public:
+    explicit HashEmbeddingProvider(size_t dimension) : dimension_(dimension) {}
+
+    std::vector<float> embed(const std::string& text) override {
+        std::vector<float> out(dimension_, 0.0f);
+        uint32_t hash = 2166136261u;
+        bool in_word = false;
+        auto flush = [&]() {
+            out[hash % dimension_] += (hash & 0x80000000u) ? -1.0f : 1.0f;
+            hash = 2166136261u;
+        };
+        for (char c : text) {
+            if (c == ' ' || c == '\n' || c == '\t') {
+                if (in_word) {
+                    flush();
+                }
+                in_word = false;
+                continue;
+            }
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+            in_word = true;
+        }
+        if (in_word) {
+            flush();
+        }
+
+        float norm = 0.0f;
+        for (float v : out) {
+            norm += v * v;
+        }
+        if (norm > 0.0f) {
+            const float inv = 1.0f / std::sqrt(norm);
+            for (float& v : out) {
+                v *= inv;
+            }
+        }
+        return out;
+    }
+
+    size_t dimension() const noexcept override { return dimension_; }
+    bool is_ready() const noexcept override { return true; }
+    const char* name() const noexcept override { return "HashEmbedding"; }
+
+   private:
+    size_t dimension_;
+};
+
+// Counts calls and time spent in the wrapped provider
+class CountingEmbeddingProvider final : public IEmbeddingProvider {
+   public:
+    CountingEmbeddingProvider(std::unique_ptr<IEmbeddingProvider> inner,
+                              std::atomic<uint64_t>* calls, std::atomic<uint64_t>* busy_ns)
+        : inner_(std::move(inner)), calls_(calls), busy_ns_(busy_ns) {}
+
+    std::vector<float> embed(const std::string& text) override {
+        const uint64_t start_ns = rac_profiler_now_ns();
+        std::vector<float> out = inner_->embed(text);
+        busy_ns_->fetch_add(rac_profiler_now_ns() - start_ns, std::memory_order_relaxed);
+        calls_->fetch_add(1, std::memory_order_relaxed);
+        return out;
+    }
+
+    size_t dimension() const noexcept override { return inner_->dimension(); }
+    bool is_ready() const noexcept override { return inner_->is_ready(); }
+    const char* name() const noexcept override { return inner_->name(); }
+
+   private:
+    std::unique_ptr<IEmbeddingProvider> inner_;
+    std::atomic<uint64_t>* calls_;
+    std::atomic<uint64_t>* busy_ns_;
+};
+
+// =============================================================================
+// INGEST
+// =============================================================================
+
+std::vector<std::string> make_documents(const BenchOptions& opts) {
+    constexpr int VOCABULARY = 5000;
+    constexpr int TOPICS = 50;
+
+    std::mt19937 rng(opts.seed);
+    std::uniform_int_distribution<int> topic_dist(0, TOPICS - 1);
+    std::uniform_int_distribution<int> vocab_dist(0, VOCABULARY - 1);
+    std::uniform_int_distribution<int> topical_dist(0, VOCABULARY / TOPICS - 1);
+    std::bernoulli_distribution on_topic(0.6);
+
+    std::vector<std::string> docs;
+    docs.reserve(static_cast<size_t>(opts.documents));
+    for (int d = 0; d < opts.documents; ++d) {
+        const int topic = topic_dist(rng);
+        std::string text;
+        text.reserve(static_cast<size_t>(opts.words_per_doc) * 7);
+        for (int w = 0; w < opts.words_per_doc; ++w) {
+            const int word = on_topic(rng) ? topic * (VOCABULARY / TOPICS) + topical_dist(rng)
+                                           : vocab_dist(rng);
+            text += 'w';
+            text += std::to_string(word);
+            text += (w % 12 == 11) ? ". " : " ";
+        }
+        docs.push_back(std::move(text));
+    }
+    return docs;
+}
+
+nlohmann::json bench_ingest(const BenchOptions& opts) {
+    std::unique_ptr<IEmbeddingProvider> inner;
+    if (!opts.embedding_model.empty()) {
+#ifdef RAC_BENCH_HAS_ONNX_EMBEDDING
+        try {
+            inner = runanywhere::rag::create_onnx_embedding_provider(opts.embedding_model);
+        } catch (const std::exception& e) {
+            return {{"error", std::string("embedding model load failed: ") + e.what()}};
+        }
+#else
+        return {{"error", "built without the ONNX embedding provider"}};
+#endif
+    } else {
+        inner = std::make_unique<HashEmbeddingProvider>(static_cast<size_t>(opts.dimension));
+    }
+
+    std::atomic<uint64_t> embed_calls{0};
+    std::atomic<uint64_t> embed_ns{0};
+
+    RAGBackendConfig config;
+    config.embedding_dimension = inner->dimension();
+    const std::string provider_name = inner->name();
+    RAGBackend backend(config, std::make_unique<CountingEmbeddingProvider>(
+                                   std::move(inner), &embed_calls, &embed_ns));
+
+    const std::vector<std::string> docs = make_documents(opts);
+    size_t bytes = 0;
+    int failures = 0;
+
+    const uint64_t start_ns = rac_profiler_now_ns();
+    for (const std::string& doc : docs) {
+        bytes += doc.size();
+        if (!backend.add_document(doc)) {
+            failures++;
+        }
+    }
+    const uint64_t wall_ns = rac_profiler_now_ns() - start_ns;
+    const size_t chunks = backend.document_count();
+    const uint64_t calls = embed_calls.load();
+    const uint64_t busy = embed_ns.load();
+
+    fprintf(stderr, "  ingest done (%zu chunks)\n", chunks);
+    return {
+        {"embedding_provider", provider_name},
+        {"documents", docs.size()},
+        {"failures", failures},
+        {"bytes", bytes},
+        {"chunks", chunks},
+        {"seconds", static_cast<double>(wall_ns) / 1e9},
+        {"docs_per_s", rac::bench::tokens_per_second(docs.size(), wall_ns)},
+        {"chunks_per_s", rac::bench::tokens_per_second(chunks, wall_ns)},
+        {"mb_per_s", rac::bench::tokens_per_second(bytes, wall_ns) / 1e6},
+        // Embedding rate while embedding; the remainder is chunking + indexing
+        {"embeddings_per_s", rac::bench::tokens_per_second(calls, busy)},
+        {"embedding_time_fraction",
+         wall_ns > 0 ? static_cast<double>(busy) / static_cast<double>(wall_ns) : 0.0},
+    };
+}
+
+// =============================================================================
+// RECALL AND QPS
+// =============================================================================
+
+using Vectors = std::vector<std::vector<float>>;
+
+void normalize(std::vector<float>& v) {
+    float norm = 0.0f;
+    for (float x : v) {
+        norm += x * x;
+    }
+    const float inv = norm > 0.0f ? 1.0f / std::sqrt(norm) : 0.0f;
+    for (float& x : v) {
+        x *= inv;
+    }
+}
+
+// Gaussian clusters around random centers, like embeddings of related passages
+Vectors make_clustered_vectors(std::mt19937& rng, int count, int dimension, int clusters,
+                               float spread) {
+    std::normal_distribution<float> gauss(0.0f, 1.0f);
+    Vectors centers(static_cast<size_t>(clusters), std::vector<float>(dimension));
+    for (auto& c : centers) {
+        for (float& x : c) {
+            x = gauss(rng);
+        }
+        normalize(c);
+    }
+
+    std::uniform_int_distribution<int> pick(0, clusters - 1);
+    Vectors out(static_cast<size_t>(count), std::vector<float>(dimension));
+    for (auto& v : out) {
+        const auto& c = centers[static_cast<size_t>(pick(rng))];
+        for (int d = 0; d < dimension; ++d) {
+            v[d] = c[d] + spread * gauss(rng);
+        }
+        normalize(v);
+    }
+    return out;
+}
+
+// Indices of the k most similar base vectors by exact cosine (inputs are unit length)
+std::vector<int> exact_top_k(const Vectors& base, const std::vector<float>& query, int k) {
+    std::vector<std::pair<float, int>> scored(base.size());
+    for (size_t i = 0; i < base.size(); ++i) {
+        float dot = 0.0f;
+        const float* v = base[i].data();
+        for (size_t d = 0; d < query.size(); ++d) {
+            dot += v[d] * query[d];
+        }
+        scored[i] = {dot, static_cast<int>(i)};
+    }
+    const size_t top = std::min(static_cast<size_t>(k), scored.size());
+    std::partial_sort(scored.begin(), scored.begin() + static_cast<long>(top), scored.end(),
+                      [](const auto& a, const auto& b) { return a.first > b.first; });
+    std::vector<int> ids(top);
+    for (size_t i = 0; i < top; ++i) {
+        ids[i] = scored[i].second;
+    }
+    return ids;
+}
+
+// Chunk ids are "v<index>"
+int parse_vector_id(const std::string& id) {
+    return id.size() > 1 ? std::atoi(id.c_str() + 1) : -1;
+}
+
+// Threshold below any cosine similarity so the store never filters results
+constexpr float NO_THRESHOLD = -2.0f;
+
+nlohmann::json measure_qps(const VectorStoreUSearch& store, const Vectors& queries, int top_k,
+                           int threads) {
+    std::vector<std::vector<double>> per_thread_ms(static_cast<size_t>(threads));
+    std::atomic<size_t> next{0};
+
+    const uint64_t start_ns = rac_profiler_now_ns();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t]() {
+            auto& latencies = per_thread_ms[static_cast<size_t>(t)];
+            for (size_t i = next.fetch_add(1); i < queries.size(); i = next.fetch_add(1)) {
+                const uint64_t q_start = rac_profiler_now_ns();
+                auto results = store.search(queries[i], static_cast<size_t>(top_k), NO_THRESHOLD);
+                latencies.push_back(rac::bench::ns_to_ms(rac_profiler_now_ns() - q_start));
+                (void)results;
+            }
+        });
+    }
+    for (auto& w : workers) {
+        w.join();
+    }
+    const uint64_t wall_ns = rac_profiler_now_ns() - start_ns;
+
+    std::vector<double> all_ms;
+    for (const auto& v : per_thread_ms) {
+        all_ms.insert(all_ms.end(), v.begin(), v.end());
+    }
+    return {
+        {"threads", threads},
+        {"qps", rac::bench::tokens_per_second(queries.size(), wall_ns)},
+        {"latency_ms", rac::bench::latency_summary(all_ms)},
+    };
+}
+
+nlohmann::json bench_index(const BenchOptions& opts) {
+    std::mt19937 rng(opts.seed + 1);
+    const int clusters = std::max(1, opts.vectors / 200);
+    const Vectors base = make_clustered_vectors(rng, opts.vectors, opts.dimension, clusters, 0.35f);
+    const Vectors queries =
+        make_clustered_vectors(rng, opts.queries, opts.dimension, clusters, 0.35f);
+
+    // Ground truth is independent of index parameters
+    std::vector<std::vector<int>> truth;
+    truth.reserve(queries.size());
+    const uint64_t exact_start_ns = rac_profiler_now_ns();
+    for (const auto& q : queries) {
+        truth.push_back(exact_top_k(base, q, opts.top_k));
+    }
+    const uint64_t exact_ns = rac_profiler_now_ns() - exact_start_ns;
+    fprintf(stderr, "  exact ground truth done\n");
+
+    std::vector<DocumentChunk> chunks(base.size());
+    for (size_t i = 0; i < base.size(); ++i) {
+        chunks[i].id = "v" + std::to_string(i);
+        chunks[i].embedding = base[i];
+    }
+
+    nlohmann::json configs = nlohmann::json::array();
+    for (int connectivity : opts.connectivity) {
+        for (int expansion : opts.expansion_search) {
+            VectorStoreConfig config;
+            config.dimension = static_cast<size_t>(opts.dimension);
+            config.max_elements = base.size();
+            config.connectivity = static_cast<size_t>(connectivity);
+            config.expansion_search = static_cast<size_t>(expansion);
+            VectorStoreUSearch store(config);
+
+            const uint64_t build_start_ns = rac_profiler_now_ns();
+            store.add_chunks_batch(chunks);
+            const uint64_t build_ns = rac_profiler_now_ns() - build_start_ns;
+
+            double recall_sum = 0.0;
+            for (size_t q = 0; q < queries.size(); ++q) {
+                auto results = store.search(queries[q], static_cast<size_t>(opts.top_k),
+                                            NO_THRESHOLD);
+                std::unordered_set<int> expected(truth[q].begin(), truth[q].end());
+                size_t hits = 0;
+                for (const auto& r : results) {
+                    hits += expected.count(parse_vector_id(r.chunk_id));
+                }
+                recall_sum += expected.empty() ? 1.0
+                                               : static_cast<double>(hits) /
+                                                     static_cast<double>(expected.size());
+            }
+
+            nlohmann::json qps = nlohmann::json::array();
+            for (int threads : opts.query_threads) {
+                qps.push_back(measure_qps(store, queries, opts.top_k, threads));
+            }
+
+            fprintf(stderr, "  connectivity=%d expansion_search=%d done\n", connectivity,
+                    expansion);
+            configs.push_back({
+                {"connectivity", connectivity},
+                {"expansion_search", expansion},
+                {"build_seconds", static_cast<double>(build_ns) / 1e9},
+                {"inserts_per_s", rac::bench::tokens_per_second(base.size(), build_ns)},
+                {"memory_bytes", store.memory_usage()},
+                {"recall_at_k", recall_sum / static_cast<double>(queries.size())},
+                {"qps", qps},
+            });
+        }
+    }
+
+    return {
+        {"vectors", base.size()},
+        {"dimension", opts.dimension},
+        {"clusters", clusters},
+        {"queries", queries.size()},
+        {"top_k", opts.top_k},
+        {"exact_qps", rac::bench::tokens_per_second(queries.size(), exact_ns)},
+        {"configs", configs},
+    };
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+    BenchOptions opts;
+    if (!parse_args(argc, argv, opts)) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    if (!opts.verbose) {
+        rac_logger_set_min_level(RAC_LOG_WARNING);
+    }
+
+    nlohmann::json report = {
+        {"tool", "rac_bench_rag"},
+        {"seed", opts.seed},
+    };
+
+    if (opts.documents > 0) {
+        report["ingest"] = bench_ingest(opts);
+    }
+    report["index"] = bench_index(opts);
+    report["peak_rss_bytes"] = rac::bench::peak_rss_bytes();
+
+    const std::string text = report.dump(2);
+    if (opts.output_path.empty()) {
+        printf("%s\n", text.c_str());
+    } else {
+        FILE* file = fopen(opts.output_path.c_str(), "w");
+        if (!file) {
+            fprintf(stderr, "Failed to open output file: %s\n", opts.output_path.c_str());
+            return 1;
+        }
+        fprintf(file, "%s\n", text.c_str());
+        fclose(file);
+    }
+
+    return 0;
+}
@@ -0,0 +1,342 @@
+/**
+ * @file rac_microbench.cpp
+ * @brief Google Benchmark microbenchmarks for CPU-bound helper loops
+ *
+ * Covers the pure-CPU hot paths that sit on every request or audio frame, at
+ * input sizes seen in practice. Each benchmark reports bytes/s (and items/s
+ * where samples, pixels or code points are the natural unit).
+ *
+ *   BM_EnergyVadRms            rac_energy_vad_calculate_rms, 10 ms .. 1 s @ 16 kHz
+ *   BM_EnergyVadBank           rac_energy_vad_bank_process, 100 ms frames for 1 .. 512 streams
+ *   BM_BasicTokenize*          RAG embedding pre-tokenizer (scalar / NEON paths)
+ *   BM_ChunkDocument           DocumentChunker::chunk_document (RAG builds only)
+ *   BM_ChunkDocumentViews      DocumentChunker::chunk_document_views (RAG builds only)
+ *   BM_ToolCallParse*          rac_tool_call_parse with and without a tool call
+ *   BM_FindCompleteJson        rac_structured_output_find_complete_json
+ *   BM_Utf8StateProcess        Utf8State::process over streamed token bytes
+ *   BM_BilinearResize          rac_image_resize (bilinear path) to VLM input sizes
+ *
+ * Regression check between two builds:
+ *   rac_microbench --benchmark_out=base.json --benchmark_out_format=json
+ *   rac_microbench --benchmark_out=head.json --benchmark_out_format=json
+ *   python3 <benchmark-src>/tools/compare.py benchmarks base.json head.json
+ *
+ * All inputs are generated from fixed seeds so runs are comparable.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "rac/features/llm/rac_llm_structured_output.h"
+#include "rac/features/llm/rac_tool_calling.h"
+#include "rac/features/vad/rac_vad_energy.h"
+#include "rac/utils/rac_image_utils.h"
+
+#include "backends/llamacpp/utf8_state.h"
+#include "backends/rag/basic_tokenizer.h"
+
+#ifdef RAC_MICROBENCH_HAS_RAG
+#include "backends/rag/rag_chunker.h"
+#endif
+
+namespace {
+
+// =============================================================================
+// INPUT GENERATORS
+// =============================================================================
+
+constexpr uint32_t kSeed = 1234;
+
+const char* const kWords[] = {
+    "the",      "model",    "returns",   "a",        "response", "after",     "reading",
+    "context",  "from",     "retrieved", "chunks",   "of",       "documents", "and",
+    "Embedding", "vectors", "are",       "compared", "using",    "cosine",    "similarity",
+    "2024",     "RunAnywhere", "on-device", "inference", "latency", "is",      "measured",
+};
+constexpr size_t kWordCount = sizeof(kWords) / sizeof(kWords[0]);
+
+// Prose with sentence and paragraph breaks, optionally sprinkled with
+// multi-byte UTF-8 words (accented Latin, CJK, emoji)
+std::string make_prose(size_t bytes, bool with_utf8) {
+    static const char* const kUtf8Words[] = {"caf\xC3\xA9", "\xE6\x97\xA5\xE6\x9C\xAC",
+                                             "\xF0\x9F\x98\x80", "na\xC3\xAFve"};
+    std::mt19937 rng(kSeed);
+    std::uniform_int_distribution<size_t> word(0, kWordCount - 1);
+    std::uniform_int_distribution<int> roll(0, 99);
+
+    std::string text;
+    text.reserve(bytes + 32);
+    int words_in_sentence = 0;
+    while (text.size() < bytes) {
+        if (with_utf8 && roll(rng) < 10) {
+            text += kUtf8Words[static_cast<size_t>(roll(rng)) % 4];
+        } else {
+            text += kWords[word(rng)];
+        }
+        if (++words_in_sentence >= 12 + roll(rng) % 10) {
+            text += roll(rng) < 15 ? ".\n\n" : ". ";
+            words_in_sentence = 0;
+        } else {
+            text += roll(rng) < 5 ? ", " : " ";
+        }
+    }
+    text.resize(bytes);
+    return text;
+}
+
+// Nested JSON object of roughly the requested size
+std::string make_json(size_t bytes) {
+    std::string json = "{\"items\": [";
+    for (size_t i = 0; json.size() < bytes; ++i) {
+        if (i > 0) {
+            json += ", ";
+        }
+        json += "{\"id\": " + std::to_string(i) +
+                ", \"name\": \"item \\\"" + std::to_string(i) +
+                "\\\" {braces} in string\", \"tags\": [\"a\", \"b\"], \"meta\": {\"score\": 0.5}}";
+    }
+    json += "]}";
+    return json;
+}
+
+void set_throughput(benchmark::State& state, size_t bytes_per_iter, size_t items_per_iter) {
+    const auto iterations = static_cast<int64_t>(state.iterations());
+    state.SetBytesProcessed(iterations * static_cast<int64_t>(bytes_per_iter));
+    state.SetItemsProcessed(iterations * static_cast<int64_t>(items_per_iter));
+}
+
+// =============================================================================
+// ENERGY VAD
+// =============================================================================
+
+void BM_EnergyVadRms(benchmark::State& state) {
+    const auto samples = static_cast<size_t>(state.range(0));
+    std::vector<float> audio(samples);
+    std::mt19937 rng(kSeed);
+    std::normal_distribution<float> noise(0.0f, 0.1f);
+    for (size_t i = 0; i < samples; ++i) {
+        audio[i] = 0.3f * std::sin(static_cast<float>(i) * 0.0785f) + noise(rng);
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(rac_energy_vad_calculate_rms(audio.data(), samples));
+    }
+    set_throughput(state, samples * sizeof(float), samples);
+}
+// 10 ms, 32 ms (Silero frame), 100 ms (energy VAD frame), 1 s at 16 kHz
+BENCHMARK(BM_EnergyVadRms)->Arg(160)->Arg(512)->Arg(1600)->Arg(16000);
+
+void BM_EnergyVadBank(benchmark::State& state) {
+    const auto streams = static_cast<int32_t>(state.range(0));
+    constexpr size_t kFrame = 1600;
+    std::vector<float> audio(kFrame * static_cast<size_t>(streams));
+    std::mt19937 rng(kSeed);
+    std::normal_distribution<float> noise(0.0f, 0.01f);
+    for (auto& sample : audio) {
+        sample = noise(rng);
+    }
+
+    rac_energy_vad_bank_handle_t bank = nullptr;
+    if (rac_energy_vad_bank_create(nullptr, streams, &bank) != RAC_SUCCESS) {
+        state.SkipWithError("rac_energy_vad_bank_create failed");
+        return;
+    }
+    std::vector<rac_bool_t> has_voice(static_cast<size_t>(streams));
+    for (auto _ : state) {
+        rac_energy_vad_bank_process(bank, audio.data(), kFrame, has_voice.data(), nullptr);
+        benchmark::DoNotOptimize(has_voice.data());
+    }
+    rac_energy_vad_bank_destroy(bank);
+    set_throughput(state, audio.size() * sizeof(float), audio.size());
+}
+// Interleaved 100 ms frames for one call up to a full server bank
+BENCHMARK(BM_EnergyVadBank)->Arg(1)->Arg(8)->Arg(64)->Arg(512);
+
+// =============================================================================
+// RAG PRE-TOKENIZER
+// =============================================================================
+
+void BM_BasicTokenize(benchmark::State& state) {
+    const std::string text = make_prose(static_cast<size_t>(state.range(0)), state.range(1) != 0);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runanywhere::rag::basic_tokenize(text));
+    }
+    set_throughput(state, text.size(), text.size());
+}
+// Args: {bytes, has_utf8}; 512 B is a typical chunk, 64 KiB a whole document
+BENCHMARK(BM_BasicTokenize)
+    ->ArgNames({"bytes", "utf8"})
+    ->Args({512, 0})
+    ->Args({2048, 0})
+    ->Args({65536, 0})
+    ->Args({2048, 1})
+    ->Args({65536, 1});
+
+void BM_BasicTokenizeScalarAscii(benchmark::State& state) {
+    const std::string text = make_prose(static_cast<size_t>(state.range(0)), false);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runanywhere::rag::basic_tokenize_scalar_ascii(text));
+    }
+    set_throughput(state, text.size(), text.size());
+}
+BENCHMARK(BM_BasicTokenizeScalarAscii)->Arg(2048)->Arg(65536);
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+void BM_BasicTokenizeSimdAscii(benchmark::State& state) {
+    const std::string text = make_prose(static_cast<size_t>(state.range(0)), false);
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(runanywhere::rag::basic_tokenize_simd_ascii(text));
+    }
+    set_throughput(state, text.size(), text.size());
+}
+BENCHMARK(BM_BasicTokenizeSimdAscii)->Arg(2048)->Arg(65536);
+#endif
+
+// =============================================================================
+// RAG CHUNKER
+// =============================================================================
+
+#ifdef RAC_MICROBENCH_HAS_RAG
+void BM_ChunkDocument(benchmark::State& state) {
+    const std::string text = make_prose(static_cast<size_t>(state.range(0)), true);
+    runanywhere::rag::DocumentChunker chunker;
+    size_t chunks = 0;
+    for (auto _ : state) {
+        auto result = chunker.chunk_document(text);
+        chunks = result.size();
+        benchmark::DoNotOptimize(result);
+    }
+    set_throughput(state, text.size(), text.size());
+    state.counters["chunks"] = static_cast<double>(chunks);
+}
+// 16 KiB note, 256 KiB article, 4 MiB book
+BENCHMARK(BM_ChunkDocument)->Arg(16 << 10)->Arg(256 << 10)->Arg(4 << 20)->Unit(benchmark::kMicrosecond);
+
+void BM_ChunkDocumentViews(benchmark::State& state) {
+    const std::string text = make_prose(static_cast<size_t>(state.range(0)), true);
+    runanywhere::rag::DocumentChunker chunker;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(chunker.chunk_document_views(text));
+    }
+    set_throughput(state, text.size(), text.size());
+}
+BENCHMARK(BM_ChunkDocumentViews)->Arg(16 << 10)->Arg(256 << 10)->Arg(4 << 20)->Unit(benchmark::kMicrosecond);
+#endif
+
+// =============================================================================
+// TOOL CALLING / STRUCTURED OUTPUT
+// =============================================================================
+
+void BM_ToolCallParse(benchmark::State& state) {
+    const std::string output =
+        make_prose(static_cast<size_t>(state.range(0)), false) +
+        "\n<tool_call>{\"tool\": \"get_weather\", \"arguments\": {\"location\": \"San "
+        "Francisco, CA\", \"unit\": \"celsius\", \"days\": 3}}</tool_call>";
+    for (auto _ : state) {
+        rac_tool_call_t call = {};
+        benchmark::DoNotOptimize(rac_tool_call_parse(output.c_str(), &call));
+        rac_tool_call_free(&call);
+    }
+    set_throughput(state, output.size(), 1);
+}
+// Args: bytes of reasoning text before the call
+BENCHMARK(BM_ToolCallParse)->Arg(0)->Arg(512)->Arg(4096);
+
+void BM_ToolCallParseNoCall(benchmark::State& state) {
+    const std::string output = make_prose(static_cast<size_t>(state.range(0)), true);
+    for (auto _ : state) {
+        rac_tool_call_t call = {};
+        benchmark::DoNotOptimize(rac_tool_call_parse(output.c_str(), &call));
+        rac_tool_call_free(&call);
+    }
+    set_throughput(state, output.size(), 1);
+}
+BENCHMARK(BM_ToolCallParseNoCall)->Arg(512)->Arg(4096);
+
+void BM_FindCompleteJson(benchmark::State& state) {
+    const std::string text = "Here is the result you asked for:\n```json\n" +
+                             make_json(static_cast<size_t>(state.range(0))) +
+                             "\n```\nLet me know if you need anything else.";
+    for (auto _ : state) {
+        size_t start = 0;
+        size_t end = 0;
+        benchmark::DoNotOptimize(
+            rac_structured_output_find_complete_json(text.c_str(), &start, &end));
+        benchmark::DoNotOptimize(end);
+    }
+    set_throughput(state, text.size(), 1);
+}
+BENCHMARK(BM_FindCompleteJson)->Arg(256)->Arg(4096)->Arg(65536);
+
+// =============================================================================
+// UTF-8 STREAMING
+// =============================================================================
+
+void BM_Utf8StateProcess(benchmark::State& state) {
+    const std::string text = make_prose(static_cast<size_t>(state.range(0)), state.range(1) != 0);
+    const auto* bytes = reinterpret_cast<const uint8_t*>(text.data());
+    for (auto _ : state) {
+        runanywhere::Utf8State scanner;
+        size_t complete = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            complete += scanner.process(bytes[i]) ? 1 : 0;
+        }
+        benchmark::DoNotOptimize(complete);
+    }
+    set_throughput(state, text.size(), text.size());
+}
+// Args: {bytes, has_utf8}; 16 B is about one decoded token piece
+BENCHMARK(BM_Utf8StateProcess)
+    ->ArgNames({"bytes", "utf8"})
+    ->Args({16, 0})
+    ->Args({16, 1})
+    ->Args({65536, 0})
+    ->Args({65536, 1});
+
+// =============================================================================
+// IMAGE RESIZE
+// =============================================================================
+
+void BM_BilinearResize(benchmark::State& state) {
+    const auto src_w = static_cast<int32_t>(state.range(0));
+    const auto src_h = static_cast<int32_t>(state.range(1));
+    const auto dst = static_cast<int32_t>(state.range(2));
+    constexpr int32_t channels = 3;
+
+    std::vector<uint8_t> pixels(static_cast<size_t>(src_w) * src_h * channels);
+    std::mt19937 rng(kSeed);
+    for (auto& p : pixels) {
+        p = static_cast<uint8_t>(rng());
+    }
+    rac_image_data_t image = {};
+    image.pixels = pixels.data();
+    image.width = src_w;
+    image.height = src_h;
+    image.channels = channels;
+    image.size = pixels.size();
+
+    for (auto _ : state) {
+        rac_image_data_t out = {};
+        benchmark::DoNotOptimize(rac_image_resize(&image, dst, dst, &out));
+        rac_image_free(&out);
+    }
+    const size_t out_pixels = static_cast<size_t>(dst) * dst;
+    set_throughput(state, out_pixels * channels, out_pixels);
+}
+// Args: {src_w, src_h, dst}; camera frames down to common VLM encoder sizes
+BENCHMARK(BM_BilinearResize)
+    ->ArgNames({"src_w", "src_h", "dst"})
+    ->Args({640, 480, 224})
+    ->Args({1920, 1080, 336})
+    ->Args({1920, 1080, 448})
+    ->Unit(benchmark::kMicrosecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
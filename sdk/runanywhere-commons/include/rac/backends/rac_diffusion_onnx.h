@@ -0,0 +1,92 @@
+/**
+ * @file rac_diffusion_onnx.h
+ * @brief RunAnywhere Core - ONNX Backend RAC API for Diffusion
+ *
+ * CPU Stable Diffusion pipeline on ONNX Runtime. The model directory uses the
+ * diffusers ONNX export layout:
+ *
+ *   text_encoder/model.onnx, unet/model.onnx, vae_decoder/model.onnx,
+ *   scheduler/scheduler_config.json (optional), vae_decoder/config.json (optional),
+ *   tokenizer/{vocab.json, merges.txt} or vocab.json/merges.txt at the root.
+ *
+ * Text-to-image only, fp32 models. Sampling uses Euler, Euler Ancestral or
+ * LCM (selected automatically for LCM exports); other scheduler choices fall
+ * back to Euler.
+ */
+
+#ifndef RAC_DIFFUSION_ONNX_H
+#define RAC_DIFFUSION_ONNX_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_types.h"
+#include "rac/features/diffusion/rac_diffusion_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// EXPORT MACRO
+// =============================================================================
+
+#if defined(RAC_ONNX_BUILDING)
+#if defined(_WIN32)
+#define RAC_ONNX_API __declspec(dllexport)
+#elif defined(__GNUC__) || defined(__clang__)
+#define RAC_ONNX_API __attribute__((visibility("default")))
+#else
+#define RAC_ONNX_API
+#endif
+#else
+#define RAC_ONNX_API
+#endif
+
+// =============================================================================
+// CONFIGURATION
+// =============================================================================
+
+typedef struct rac_diffusion_onnx_config {
+    /** Text-encoder outputs kept for repeated prompts (0 disables the cache) */
+    int32_t prompt_cache_size;
+    /** Run each session once on dummy inputs at load time */
+    rac_bool_t prewarm;
+} rac_diffusion_onnx_config_t;
+
+static const rac_diffusion_onnx_config_t RAC_DIFFUSION_ONNX_CONFIG_DEFAULT = {
+    .prompt_cache_size = 16, .prewarm = RAC_FALSE};
+
+// =============================================================================
+// ONNX DIFFUSION API
+// =============================================================================
+
+RAC_ONNX_API rac_result_t rac_diffusion_onnx_create(const char* model_dir,
+                                                    const rac_diffusion_onnx_config_t* config,
+                                                    rac_handle_t* out_handle);
+
+RAC_ONNX_API rac_result_t rac_diffusion_onnx_generate(rac_handle_t handle,
+                                                      const rac_diffusion_options_t* options,
+                                                      rac_diffusion_result_t* out_result);
+
+/**
+ * Generate with progress. The callback runs after text encoding, every
+ * progress_stride denoising steps and before VAE decoding; returning
+ * RAC_FALSE stops generation with RAC_ERROR_CANCELLED.
+ */
+RAC_ONNX_API rac_result_t rac_diffusion_onnx_generate_with_progress(
+    rac_handle_t handle, const rac_diffusion_options_t* options,
+    rac_diffusion_progress_callback_fn progress_callback, void* user_data,
+    rac_diffusion_result_t* out_result);
+
+RAC_ONNX_API rac_result_t rac_diffusion_onnx_get_info(rac_handle_t handle,
+                                                      rac_diffusion_info_t* out_info);
+
+/** Request cancellation of the generation in progress (thread-safe) */
+RAC_ONNX_API void rac_diffusion_onnx_cancel(rac_handle_t handle);
+
+RAC_ONNX_API void rac_diffusion_onnx_destroy(rac_handle_t handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_DIFFUSION_ONNX_H */
@@ -56,6 +56,18 @@ typedef struct rac_llm_llamacpp_config {
 
     /** Batch size for prompt processing */
     int32_t batch_size;
+
+    /**
+     * Slide the context window instead of failing when prompt plus generation
+     * exceed the context size. The oldest conversation turns after the pinned
+     * prefix are evicted whole and the KV cache shifted, so the prefix is never
+     * recomputed. Once only the current turn and the reply are left, their
+     * oldest tokens are evicted instead.
+     */
+    rac_bool_t context_shift;
+
+    /** Tokens pinned at the start of the context when shifting (0 = the system prompt) */
+    int32_t keep_tokens;
 } rac_llm_llamacpp_config_t;
 
 /**
@@ -65,7 +77,9 @@ static const rac_llm_llamacpp_config_t RAC_LLM_LLAMACPP_CONFIG_DEFAULT = {
     .context_size = 0,  // Auto-detect
     .num_threads = 0,   // Auto-detect
     .gpu_layers = -1,   // All layers on GPU
-    .batch_size = 512};
+    .batch_size = 512,
+    .context_shift = RAC_FALSE,
+    .keep_tokens = 0};
 
 // =============================================================================
 // LLAMACPP-SPECIFIC API
@@ -163,6 +177,122 @@ RAC_LLAMACPP_API rac_result_t rac_llm_llamacpp_generate_stream(
     rac_handle_t handle, const char* prompt, const rac_llm_options_t* options,
     rac_llm_llamacpp_stream_callback_fn callback, void* user_data);
 
+/** Maximum alternatives per token for rac_llm_llamacpp_generate_stream_logprobs() */
+#define RAC_LLM_LLAMACPP_MAX_TOP_LOGPROBS 20
+
+/**
+ * An alternative token and its log-probability.
+ */
+typedef struct rac_llm_llamacpp_top_logprob {
+    /** Token text */
+    const char* token;
+    /** Natural-log probability under the model's distribution */
+    float logprob;
+} rac_llm_llamacpp_top_logprob_t;
+
+/**
+ * A sampled token, its log-probability and the most likely alternatives.
+ *
+ * Probabilities come from the model's logits before temperature, top-k and
+ * top-p are applied.
+ */
+typedef struct rac_llm_llamacpp_token_logprob {
+    /** Token text */
+    const char* token;
+    /** Natural-log probability of the sampled token */
+    float logprob;
+    /** Most likely tokens, highest first */
+    const rac_llm_llamacpp_top_logprob_t* top_logprobs;
+    int32_t num_top_logprobs;
+} rac_llm_llamacpp_token_logprob_t;
+
+/**
+ * Streaming callback with token log-probabilities.
+ *
+ * The logprobs describe the tokens whose text completes in this piece. Text
+ * held back at a stop sequence or UTF-8 boundary is reported with a later
+ * piece, so a piece may carry zero or several tokens.
+ *
+ * @param token Generated text piece
+ * @param logprobs Tokens for this piece (valid only during the call)
+ * @param num_logprobs Number of entries in logprobs
+ * @param is_final Whether this is the final call
+ * @param user_data User-provided context
+ * @return RAC_TRUE to continue, RAC_FALSE to stop
+ */
+typedef rac_bool_t (*rac_llm_llamacpp_logprob_stream_callback_fn)(
+    const char* token, const rac_llm_llamacpp_token_logprob_t* logprobs, int32_t num_logprobs,
+    rac_bool_t is_final, void* user_data);
+
+/**
+ * Generates text with streaming callback and per-token log-probabilities.
+ *
+ * The log-probabilities are read from the same logits row the sampler uses,
+ * so no extra decode is needed.
+ *
+ * @param handle Service handle
+ * @param prompt Input prompt text
+ * @param options Generation options (can be NULL for defaults)
+ * @param top_logprobs Alternatives per token (0 to RAC_LLM_LLAMACPP_MAX_TOP_LOGPROBS)
+ * @param callback Callback for each text piece
+ * @param user_data User context passed to callback
+ * @return RAC_SUCCESS or error code
+ */
+RAC_LLAMACPP_API rac_result_t rac_llm_llamacpp_generate_stream_logprobs(
+    rac_handle_t handle, const char* prompt, const rac_llm_options_t* options,
+    int32_t top_logprobs, rac_llm_llamacpp_logprob_stream_callback_fn callback, void* user_data);
+
+/**
+ * One completion returned by rac_llm_llamacpp_generate_choices().
+ */
+typedef struct rac_llm_llamacpp_choice {
+    /** Completion text (owned by the choices array) */
+    char* text;
+    /** Tokens generated for this completion */
+    int32_t completion_tokens;
+    /** RAC_TRUE if generation stopped at max_tokens rather than a stop condition */
+    rac_bool_t length_limited;
+    /** Mean log-probability per sampled token (only computed when best_of > n, otherwise 0) */
+    float logprob;
+} rac_llm_llamacpp_choice_t;
+
+/**
+ * Generates several independent completions for one prompt.
+ *
+ * The prompt is decoded once and its KV cache shared by every candidate;
+ * candidates are then sampled with their own samplers and decoded together
+ * in one batch per step. When best_of > n, best_of candidates are sampled
+ * and the n with the highest log-probability per token are returned, so
+ * shorter completions are not favoured.
+ *
+ * The total number of candidates is limited by the "max_parallel_sequences"
+ * model config key (default 8), and the context window is split between
+ * them, so each candidate's max_tokens may be reduced.
+ *
+ * @param handle Service handle
+ * @param prompt Input prompt text
+ * @param options Generation options (can be NULL for defaults)
+ * @param n Number of completions to return (>= 1)
+ * @param best_of Number of candidates to sample (0 = n, otherwise >= n)
+ * @param out_choices Output: Array of n choices (free with rac_llm_llamacpp_free_choices)
+ * @param out_num_choices Output: Number of choices
+ * @param out_prompt_tokens Output: Prompt token count (can be NULL)
+ * @return RAC_SUCCESS or error code
+ */
+RAC_LLAMACPP_API rac_result_t rac_llm_llamacpp_generate_choices(
+    rac_handle_t handle, const char* prompt, const rac_llm_options_t* options, int32_t n,
+    int32_t best_of, rac_llm_llamacpp_choice_t** out_choices, int32_t* out_num_choices,
+    int32_t* out_prompt_tokens);
+
+/**
+ * Frees choices returned by rac_llm_llamacpp_generate_choices().
+ *
+ * @param choices Choices array (can be NULL)
+ * @param num_choices Number of choices
+ */
+RAC_LLAMACPP_API void rac_llm_llamacpp_free_choices(rac_llm_llamacpp_choice_t* choices,
+                                                    int32_t num_choices);
+
 /**
  * Cancels ongoing generation.
  *
@@ -195,9 +325,9 @@ RAC_LLAMACPP_API void rac_llm_llamacpp_destroy(rac_handle_t handle);
 /**
  * Load a LoRA adapter from a GGUF file and apply it.
  *
- * The adapter is loaded against the current model and applied to the context.
- * Context is recreated internally to accommodate the new adapter.
- * KV cache is cleared automatically.
+ * The adapter is loaded against the current model and applied, from the next
+ * request on, to requests made through handles without their own adapter set
+ * (see rac_llm_llamacpp_create_lora_view). The context is not recreated.
  *
  * @param handle Service handle (from rac_llm_llamacpp_create)
  * @param adapter_path Path to the LoRA adapter GGUF file
@@ -210,7 +340,8 @@ RAC_LLAMACPP_API rac_result_t rac_llm_llamacpp_load_lora(rac_handle_t handle,
 
 /**
  * Remove a specific LoRA adapter by path.
- * KV cache is cleared automatically.
+ *
+ * Requests through LoRA views that still select it will fail.
  *
  * @param handle Service handle
  * @param adapter_path Path used when loading the adapter
@@ -220,18 +351,52 @@ RAC_LLAMACPP_API rac_result_t rac_llm_llamacpp_remove_lora(rac_handle_t handle,
                                                             const char* adapter_path);
 
 /**
- * Remove all LoRA adapters from the context.
- * KV cache is cleared automatically.
+ * Remove all LoRA adapters from the context and the adapter pool.
  *
  * @param handle Service handle
  * @return RAC_SUCCESS or error code
  */
 RAC_LLAMACPP_API rac_result_t rac_llm_llamacpp_clear_lora(rac_handle_t handle);
 
+/**
+ * A LoRA adapter and the scale to apply it with.
+ */
+typedef struct rac_llm_llamacpp_lora {
+    /** Path to the LoRA adapter GGUF file */
+    const char* adapter_path;
+    /** Adapter scale factor (0 disables the adapter) */
+    float scale;
+} rac_llm_llamacpp_lora_t;
+
+/**
+ * Create a handle that generates with a fixed set of LoRA adapters.
+ *
+ * The view shares the model, context and adapter pool of handle, and can be
+ * passed to every generate function. Adapters are loaded into the pool on
+ * first use and shared by all views. Before each request the selected scales
+ * are set on the live context (only when they differ from the previous
+ * request), so switching between views costs no context rebuild.
+ * With num_adapters = 0 the view generates with the base model.
+ *
+ * Requests are serialized on the shared context. Destroy views with
+ * rac_llm_llamacpp_destroy before destroying handle.
+ *
+ * @param handle Service handle (from rac_llm_llamacpp_create)
+ * @param adapters Adapters to apply (can be NULL when num_adapters is 0)
+ * @param num_adapters Number of adapters
+ * @param out_handle Output: View handle
+ * @return RAC_SUCCESS or error code
+ */
+RAC_LLAMACPP_API rac_result_t rac_llm_llamacpp_create_lora_view(
+    rac_handle_t handle, const rac_llm_llamacpp_lora_t* adapters, int32_t num_adapters,
+    rac_handle_t* out_handle);
+
 /**
  * Get info about loaded LoRA adapters as JSON.
  *
- * Returns JSON array: [{"path":"...", "scale":1.0, "applied":true}, ...]
+ * Returns JSON array: [{"path":"...", "scale":1.0, "applied":true, "active":true}, ...]
+ * "applied" marks adapters loaded with rac_llm_llamacpp_load_lora; "active"
+ * marks adapters set on the context by the most recent request.
  *
  * @param handle Service handle
  * @param out_json Output: JSON string (caller must free with rac_free)
@@ -55,7 +55,7 @@ typedef struct rac_wakeword_onnx_config {
     /** Detection threshold (0.0 - 1.0, default: 0.5) */
     float threshold;
 
-    /** Number of ONNX Runtime threads (0 = auto) */
+    /** Unused: wake word sessions always run on one dedicated ONNX Runtime thread */
     int32_t num_threads;
 
     /** Frame length in samples (default: 1280 = 80ms @ 16kHz) */
@@ -81,8 +81,146 @@ RAC_API rac_result_t rac_audio_int16_to_wav(const void* pcm_data, size_t pcm_siz
  */
 RAC_API size_t rac_audio_wav_header_size(void);
 
+// =============================================================================
+// PCM KERNELS
+// =============================================================================
+// Vectorized (SSE2 / NEON, scalar fallback) sample kernels shared by the
+// STT, VAD, wake word and TTS paths. Input and output may not overlap unless
+// stated otherwise.
+
+/**
+ * @brief Convert Int16 PCM to Float32 in [-1.0, 1.0) (x / 32768)
+ *
+ * @param in Input Int16 samples
+ * @param out Output Float32 samples (num_samples entries)
+ * @param num_samples Number of samples to convert
+ */
+RAC_API void rac_audio_int16_to_float32(const int16_t* in, float* out, size_t num_samples);
+
+/**
+ * @brief Convert Float32 PCM to Int16, clamping to [-1.0, 1.0] (x * 32767)
+ *
+ * @param in Input Float32 samples
+ * @param out Output Int16 samples (num_samples entries)
+ * @param num_samples Number of samples to convert
+ */
+RAC_API void rac_audio_float32_to_int16(const float* in, int16_t* out, size_t num_samples);
+
+/**
+ * @brief Average interleaved Float32 channels down to mono
+ *
+ * @param in Interleaved input (num_frames * channels samples)
+ * @param num_frames Number of frames
+ * @param channels Channel count (>= 1); 1 is a plain copy
+ * @param out Output mono samples (num_frames entries). May alias in when channels == 1.
+ */
+RAC_API void rac_audio_downmix_float32(const float* in, size_t num_frames, int32_t channels,
+                                       float* out);
+
+/**
+ * @brief Multiply Float32 samples in place by a linear gain
+ *
+ * @param samples Samples to scale
+ * @param num_samples Number of samples
+ * @param gain Linear gain factor (no clamping is applied)
+ */
+RAC_API void rac_audio_apply_gain(float* samples, size_t num_samples, float gain);
+
+/**
+ * @brief Convert any audio view to mono Float32
+ *
+ * Handles Int16 and Float32 views with any channel count.
+ *
+ * @param view Source audio
+ * @param out Output buffer (at least view->num_frames entries)
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_audio_view_to_float32_mono(const rac_audio_view_t* view, float* out);
+
+// =============================================================================
+// SCRATCH BUFFERS
+// =============================================================================
+
+/**
+ * @brief Acquire a 64-byte aligned Float32 scratch buffer from the pool
+ *
+ * Buffers are recycled through a per-thread pool so steady-state streaming
+ * (fixed frame sizes) performs no heap allocation after warm-up.
+ *
+ * @param num_samples Minimum capacity in samples
+ * @return Buffer pointer, or NULL on allocation failure. Release with
+ *         rac_audio_scratch_release().
+ */
+RAC_API float* rac_audio_scratch_acquire(size_t num_samples);
+
+/**
+ * @brief Return a scratch buffer to the pool
+ *
+ * @param buffer Buffer from rac_audio_scratch_acquire (NULL is ignored)
+ */
+RAC_API void rac_audio_scratch_release(float* buffer);
+
 #ifdef __cplusplus
 }
 #endif
 
+// =============================================================================
+// C++ CONVENIENCE CLASS
+// =============================================================================
+
+#ifdef __cplusplus
+
+namespace rac {
+
+/**
+ * @brief Mono Float32 view over an rac_audio_view_t with RAII scratch.
+ *
+ * Aliases the caller's memory when the view is already mono Float32 and only
+ * converts (into pooled scratch) otherwise.
+ *
+ * Usage:
+ *   rac::MonoFloatAudio mono(view);
+ *   if (!mono.ok()) return RAC_ERROR_OUT_OF_MEMORY;
+ *   backend->process(mono.data(), mono.size());
+ */
+class MonoFloatAudio {
+   public:
+    explicit MonoFloatAudio(const rac_audio_view_t& view) : size_(view.num_frames) {
+        if (view.format == RAC_AUDIO_SAMPLE_FLOAT32 && view.channels == 1) {
+            data_ = static_cast<const float*>(view.data);
+            return;
+        }
+        scratch_ = rac_audio_scratch_acquire(size_);
+        if (scratch_ && rac_audio_view_to_float32_mono(&view, scratch_) == RAC_SUCCESS) {
+            data_ = scratch_;
+        }
+    }
+
+    MonoFloatAudio(const int16_t* samples, size_t num_samples) : size_(num_samples) {
+        scratch_ = rac_audio_scratch_acquire(size_);
+        if (scratch_) {
+            rac_audio_int16_to_float32(samples, scratch_, size_);
+            data_ = scratch_;
+        }
+    }
+
+    ~MonoFloatAudio() { rac_audio_scratch_release(scratch_); }
+
+    MonoFloatAudio(const MonoFloatAudio&) = delete;
+    MonoFloatAudio& operator=(const MonoFloatAudio&) = delete;
+
+    bool ok() const { return data_ != nullptr || size_ == 0; }
+    const float* data() const { return data_; }
+    size_t size() const { return size_; }
+
+   private:
+    const float* data_ = nullptr;
+    float* scratch_ = nullptr;
+    size_t size_ = 0;
+};
+
+}  // namespace rac
+
+#endif  // __cplusplus
+
 #endif /* RAC_AUDIO_UTILS_H */
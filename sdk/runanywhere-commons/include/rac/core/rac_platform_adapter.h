@@ -286,7 +286,9 @@ RAC_API int64_t rac_get_current_time_ms(void);
 
 /**
  * Start an HTTP download using the platform adapter.
- * Returns RAC_ERROR_NOT_SUPPORTED if http_download callback is NULL.
+ * Without an adapter http_download callback the built-in downloader
+ * (rac_native_download.h) is used when available; otherwise returns
+ * RAC_ERROR_NOT_SUPPORTED.
  *
  * @param url URL to download
  * @param destination_path Where to save
@@ -312,7 +314,9 @@ RAC_API rac_result_t rac_http_download_cancel(const char* task_id);
 
 /**
  * Extract an archive using the platform adapter.
- * Returns RAC_ERROR_NOT_SUPPORTED if extract_archive callback is NULL.
+ * Without an adapter extract_archive callback, tar.gz/tar.bz2/tar.xz archives
+ * are extracted natively (rac_archive_extract.h); other types return
+ * RAC_ERROR_NOT_SUPPORTED.
  *
  * @param archive_path Path to archive
  * @param destination_dir Where to extract
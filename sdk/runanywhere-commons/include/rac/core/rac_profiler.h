@@ -0,0 +1,220 @@
+/**
+ * @file rac_profiler.h
+ * @brief RunAnywhere Commons - Phase Profiler
+ *
+ * Nanosecond scoped-timer instrumentation for generation hot paths.
+ * Records per-phase aggregates (tokenize, prefill, decode, sample,
+ * detokenize, callback), an inter-token-latency histogram and, optionally,
+ * Chrome trace-event JSON (load in chrome://tracing or Perfetto).
+ *
+ * Profiling is off by default. When disabled each instrumentation point costs
+ * one relaxed atomic load; define RAC_PROFILER_COMPILED_OUT to remove the
+ * scoped timers entirely.
+ */
+
+#ifndef RAC_PROFILER_H
+#define RAC_PROFILER_H
+
+#include "rac/core/rac_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// TYPES
+// =============================================================================
+
+/**
+ * Instrumented generation phases.
+ */
+typedef enum rac_profiler_phase {
+    RAC_PROFILER_PHASE_TOKENIZE = 0,   /**< Prompt templating + tokenization */
+    RAC_PROFILER_PHASE_PREFILL = 1,    /**< Prompt decode (KV fill) */
+    RAC_PROFILER_PHASE_DECODE = 2,     /**< Single-token decode step */
+    RAC_PROFILER_PHASE_SAMPLE = 3,     /**< Sampler chain */
+    RAC_PROFILER_PHASE_DETOKENIZE = 4, /**< Token to text + UTF-8/stop handling */
+    RAC_PROFILER_PHASE_CALLBACK = 5,   /**< Time spent in caller token callbacks */
+    RAC_PROFILER_PHASE_COUNT = 6
+} rac_profiler_phase_t;
+
+/** Number of log2 buckets in the inter-token-latency histogram. */
+#define RAC_PROFILER_ITL_BUCKETS 32
+
+/**
+ * Aggregate statistics for one phase.
+ */
+typedef struct rac_profiler_phase_stats {
+    uint64_t count;    /**< Number of recorded spans */
+    uint64_t total_ns; /**< Sum of span durations */
+    uint64_t min_ns;   /**< Shortest span (0 if count == 0) */
+    uint64_t max_ns;   /**< Longest span */
+} rac_profiler_phase_stats_t;
+
+/**
+ * Inter-token-latency histogram.
+ * Bucket i counts gaps in [2^i, 2^(i+1)) microseconds; bucket 0 also holds
+ * gaps under 1us and the last bucket holds everything above its lower bound.
+ */
+typedef struct rac_profiler_itl_histogram {
+    uint64_t buckets[RAC_PROFILER_ITL_BUCKETS];
+    uint64_t count;    /**< Total recorded gaps */
+    uint64_t total_ns; /**< Sum of recorded gaps */
+    uint64_t max_ns;   /**< Longest gap */
+} rac_profiler_itl_histogram_t;
+
+// =============================================================================
+// CONTROL
+// =============================================================================
+
+/**
+ * @brief Enable or disable phase timing
+ *
+ * @param enabled RAC_TRUE to record phase stats and the ITL histogram
+ */
+RAC_API void rac_profiler_set_enabled(rac_bool_t enabled);
+
+/**
+ * @brief Check whether phase timing is enabled
+ */
+RAC_API rac_bool_t rac_profiler_is_enabled(void);
+
+/**
+ * @brief Enable or disable Chrome trace-event capture
+ *
+ * Implies rac_profiler_set_enabled(RAC_TRUE) when turned on. Captured events
+ * are bounded by max_events; later events are dropped and counted.
+ *
+ * @param enabled RAC_TRUE to capture individual spans
+ * @param max_events Capture limit (0 = default of 1,000,000)
+ */
+RAC_API void rac_profiler_set_trace_enabled(rac_bool_t enabled, size_t max_events);
+
+/**
+ * @brief Clear all stats, histogram and captured trace events
+ */
+RAC_API void rac_profiler_reset(void);
+
+// =============================================================================
+// RECORDING
+// =============================================================================
+
+/**
+ * @brief Monotonic timestamp in nanoseconds
+ */
+RAC_API uint64_t rac_profiler_now_ns(void);
+
+/**
+ * @brief Record a completed phase span
+ *
+ * @param phase Phase to attribute the span to
+ * @param start_ns Span start from rac_profiler_now_ns()
+ * @param end_ns Span end from rac_profiler_now_ns()
+ */
+RAC_API void rac_profiler_record(rac_profiler_phase_t phase, uint64_t start_ns, uint64_t end_ns);
+
+/**
+ * @brief Record the gap between two consecutive emitted tokens
+ *
+ * @param gap_ns Inter-token latency in nanoseconds
+ */
+RAC_API void rac_profiler_record_itl(uint64_t gap_ns);
+
+// =============================================================================
+// REPORTING
+// =============================================================================
+
+/**
+ * @brief Get aggregate stats for a phase
+ *
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_profiler_get_phase_stats(rac_profiler_phase_t phase,
+                                                  rac_profiler_phase_stats_t* out_stats);
+
+/**
+ * @brief Get the inter-token-latency histogram
+ *
+ * @return RAC_SUCCESS or RAC_ERROR_INVALID_ARGUMENT
+ */
+RAC_API rac_result_t rac_profiler_get_itl_histogram(rac_profiler_itl_histogram_t* out_histogram);
+
+/**
+ * @brief Get the display name of a phase (e.g. "prefill")
+ */
+RAC_API const char* rac_profiler_phase_name(rac_profiler_phase_t phase);
+
+/**
+ * @brief Write captured trace events as Chrome trace-event JSON
+ *
+ * @param path Output file path
+ * @return RAC_SUCCESS, RAC_ERROR_INVALID_ARGUMENT or RAC_ERROR_FILE_WRITE_FAILED
+ */
+RAC_API rac_result_t rac_profiler_write_chrome_trace(const char* path);
+
+#ifdef __cplusplus
+}
+#endif
+
+// =============================================================================
+// C++ CONVENIENCE CLASS
+// =============================================================================
+
+#ifdef __cplusplus
+
+#include <atomic>
+
+namespace rac {
+namespace profiler {
+
+/** Shared enable flag; read inline so disabled timers are a single load. */
+extern RAC_API std::atomic<bool> g_enabled;
+
+inline bool enabled() {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief RAII timer attributing its lifetime to a phase.
+ *
+ * Usage:
+ *   {
+ *       rac::profiler::ScopedPhase timer(RAC_PROFILER_PHASE_SAMPLE);
+ *       token = llama_sampler_sample(...);
+ *   }
+ */
+class ScopedPhase {
+   public:
+    explicit ScopedPhase(rac_profiler_phase_t phase)
+        : phase_(phase), start_ns_(enabled() ? rac_profiler_now_ns() : 0) {}
+
+    ~ScopedPhase() {
+        if (start_ns_ != 0) {
+            rac_profiler_record(phase_, start_ns_, rac_profiler_now_ns());
+        }
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+   private:
+    rac_profiler_phase_t phase_;
+    uint64_t start_ns_;
+};
+
+}  // namespace profiler
+}  // namespace rac
+
+#define RAC_PROFILER_CONCAT_INNER(a, b) a##b
+#define RAC_PROFILER_CONCAT(a, b) RAC_PROFILER_CONCAT_INNER(a, b)
+
+#ifndef RAC_PROFILER_COMPILED_OUT
+#define RAC_PROFILE_PHASE(phase) \
+    ::rac::profiler::ScopedPhase RAC_PROFILER_CONCAT(rac_profile_scope_, __LINE__)(phase)
+#else
+#define RAC_PROFILE_PHASE(phase) ((void)0)
+#endif
+
+#endif  // __cplusplus
+
+#endif /* RAC_PROFILER_H */
@@ -29,11 +29,11 @@ extern "C" {
 /**
  * @brief Supported inference backends for diffusion models
  *
- * Currently only CoreML is implemented for iOS/macOS.
- * Other backends are reserved for future expansion.
+ * CoreML is used on iOS/macOS; ONNX Runtime (CPU) on other platforms.
+ * TFLite is reserved for future expansion.
  */
 typedef enum rac_diffusion_backend {
-    RAC_DIFFUSION_BACKEND_ONNX = 0,      /**< ONNX Runtime (reserved for future) */
+    RAC_DIFFUSION_BACKEND_ONNX = 0,      /**< ONNX Runtime (CPU execution provider) */
     RAC_DIFFUSION_BACKEND_COREML = 1,    /**< CoreML (iOS/macOS - currently supported) */
     RAC_DIFFUSION_BACKEND_TFLITE = 2,    /**< TensorFlow Lite (reserved for future) */
     RAC_DIFFUSION_BACKEND_AUTO = 99      /**< Auto-select (defaults to CoreML on Apple) */
@@ -305,7 +305,7 @@ RAC_API rac_result_t rac_diffusion_model_registry_list(
  *
  * This function implements the fallback chain:
  * - iOS/macOS: CoreML (ANE → GPU → CPU automatic via CoreML)
- * - Android: ONNX with NNAPI EP (NPU → DSP → GPU → CPU automatic via NNAPI)
+ * - Android: ONNX with CPU EP
  * - Desktop: ONNX with CPU EP
  *
  * @param model_id Model identifier
@@ -55,13 +55,13 @@ typedef struct rac_search_result {
  * @brief RAG pipeline configuration
  */
 typedef struct rac_rag_config {
-    /** Path to embedding model (ONNX) */
+    /** Path to embedding model (ONNX, or GGUF run with llama.cpp) */
     const char* embedding_model_path;
     
     /** Path to LLM model (GGUF) */
     const char* llm_model_path;
     
-    /** Embedding dimension (default 384 for all-MiniLM-L6-v2) */
+    /** Embedding dimension (default 384 for all-MiniLM-L6-v2; the model's own size wins) */
     size_t embedding_dimension;
     
     /** Number of top chunks to retrieve (default 3) */
@@ -87,6 +87,19 @@ typedef struct rac_rag_config {
     
     /** Configuration JSON for LLM model (optional) */
     const char* llm_config_json;
+    
+    /**
+     * Path to a cross-encoder reranker model (ONNX, optional).
+     * When set, retrieval fetches rerank_candidates chunks by vector
+     * similarity and keeps the top_k the reranker scores highest.
+     */
+    const char* reranker_model_path;
+    
+    /** Configuration JSON for the reranker model (optional) */
+    const char* reranker_config_json;
+    
+    /** Chunks rescored by the reranker per query (default 50) */
+    size_t rerank_candidates;
 } rac_rag_config_t;
 
 /**
@@ -108,6 +121,9 @@ static inline rac_rag_config_t rac_rag_config_default(void) {
     cfg.prompt_template = "Context:\n{context}\n\nQuestion: {query}\n\nAnswer:";
     cfg.embedding_config_json = NULL;
     cfg.llm_config_json = NULL;
+    cfg.reranker_model_path = NULL;
+    cfg.reranker_config_json = NULL;
+    cfg.rerank_candidates = 50;
     return cfg;
 }
 
@@ -172,6 +188,54 @@ RAC_API rac_result_t rac_rag_add_document(
     const char* metadata_json
 );
 
+/**
+ * @brief Reader callback for streamed documents
+ *
+ * @param user_data User data passed to rac_rag_add_document_stream
+ * @param buffer Buffer to fill with the next bytes of the document
+ * @param buffer_size Capacity of buffer
+ * @return Bytes written, 0 at end of document, negative on error
+ */
+typedef int64_t (*rac_rag_read_callback_t)(void* user_data, char* buffer, size_t buffer_size);
+
+/**
+ * @brief Add a document from a file without loading it into memory
+ *
+ * The file is memory-mapped and chunked, embedded and indexed a window at a
+ * time, so memory use does not grow with file size. Indexed chunks refer to
+ * byte ranges of the file instead of copying its text; the text is read back
+ * on retrieval, so the file must not be moved or modified afterwards.
+ *
+ * @param pipeline RAG pipeline handle
+ * @param file_path Path to a UTF-8 text file
+ * @param metadata_json Optional JSON metadata
+ * @return RAC_SUCCESS on success, error code otherwise
+ */
+RAC_API rac_result_t rac_rag_add_document_file(
+    rac_rag_pipeline_t* pipeline,
+    const char* file_path,
+    const char* metadata_json
+);
+
+/**
+ * @brief Add a document produced incrementally by a reader callback
+ *
+ * Same bounded-memory ingestion as rac_rag_add_document_file(). Chunk text
+ * is stored in the index since it cannot be read back later.
+ *
+ * @param pipeline RAG pipeline handle
+ * @param read Reader callback, called until it returns 0
+ * @param user_data User data passed to read
+ * @param metadata_json Optional JSON metadata
+ * @return RAC_SUCCESS on success, error code otherwise
+ */
+RAC_API rac_result_t rac_rag_add_document_stream(
+    rac_rag_pipeline_t* pipeline,
+    rac_rag_read_callback_t read,
+    void* user_data,
+    const char* metadata_json
+);
+
 /**
  * @brief Add multiple documents in batch
  *
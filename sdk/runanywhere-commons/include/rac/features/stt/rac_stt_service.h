@@ -46,6 +46,15 @@ typedef struct rac_stt_service_ops {
 
     /** Destroy the service */
     void (*destroy)(void* impl);
+
+    /**
+     * Transcribe a non-owning audio view (optional).
+     * Lets backends consume Float32 audio without an Int16 round trip.
+     * NULL falls back to converting the view to Int16 for transcribe().
+     */
+    rac_result_t (*transcribe_audio)(void* impl, const rac_audio_view_t* audio,
+                                     const rac_stt_options_t* options,
+                                     rac_stt_result_t* out_result);
 } rac_stt_service_ops_t;
 
 /**
@@ -101,6 +110,23 @@ RAC_API rac_result_t rac_stt_transcribe(rac_handle_t handle, const void* audio_d
                                         size_t audio_size, const rac_stt_options_t* options,
                                         rac_stt_result_t* out_result);
 
+/**
+ * @brief Transcribe an audio view (batch mode)
+ *
+ * Accepts Int16 or Float32 audio with any channel count without the caller
+ * converting first. Backends that implement transcribe_audio receive the
+ * view as-is; others get a single Int16 conversion.
+ *
+ * @param handle Service handle
+ * @param audio Audio view (data is borrowed for the duration of the call)
+ * @param options Transcription options (can be NULL for defaults)
+ * @param out_result Output: Transcription result (caller must free with rac_stt_result_free)
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_stt_transcribe_audio(rac_handle_t handle, const rac_audio_view_t* audio,
+                                              const rac_stt_options_t* options,
+                                              rac_stt_result_t* out_result);
+
 /**
  * @brief Stream transcription for real-time processing
  *
@@ -5,8 +5,12 @@
  * C port of Swift's SimpleEnergyVADService.swift
  * Swift Source: Sources/RunAnywhere/Features/VAD/Services/SimpleEnergyVADService.swift
  *
- * IMPORTANT: This is a direct translation of the Swift implementation.
- * Do NOT add features not present in the Swift code.
+ * IMPORTANT: The single-stream service is a direct translation of the Swift
+ * implementation. Do NOT add features to it that are not present in the Swift
+ * code unless they are opt-in (see rac_energy_vad_set_noise_tracking()).
+ *
+ * The interleaved RMS kernel and the multi-stream bank are native additions
+ * for servers that pre-screen many audio streams before running neural VAD.
  */
 
 #ifndef RAC_VAD_ENERGY_H
@@ -57,6 +61,9 @@ extern "C" {
 /** Maximum recent values for statistics */
 #define RAC_VAD_MAX_RECENT_VALUES 50
 
+/** Maximum channels per interleaved RMS call and streams per bank */
+#define RAC_VAD_MAX_STREAMS 512
+
 // =============================================================================
 // TYPES
 // =============================================================================
@@ -234,6 +241,24 @@ RAC_API rac_result_t rac_energy_vad_process_audio(rac_energy_vad_handle_t handle
  */
 RAC_API float rac_energy_vad_calculate_rms(const float* __restrict audio_data,size_t sample_count);
 
+/**
+ * @brief Calculate the RMS energy of each channel of interleaved audio.
+ *
+ * Sample i of channel c is audio_data[i * channel_count + c]. Channels can be
+ * the channels of one recording or independent streams packed side by side;
+ * one pass over the buffer computes all of them.
+ *
+ * @param audio_data Interleaved audio samples (float32)
+ * @param frame_count Number of samples per channel
+ * @param channel_count Number of channels (1 to RAC_VAD_MAX_STREAMS)
+ * @param out_rms Output: channel_count RMS values (0.0 if frame_count is 0)
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_energy_vad_calculate_rms_interleaved(const float* audio_data,
+                                                              size_t frame_count,
+                                                              int32_t channel_count,
+                                                              float* out_rms);
+
 // =============================================================================
 // PAUSE/RESUME API
 // =============================================================================
@@ -295,6 +320,23 @@ RAC_API rac_result_t rac_energy_vad_is_calibrating(rac_energy_vad_handle_t handl
 RAC_API rac_result_t rac_energy_vad_set_calibration_multiplier(rac_energy_vad_handle_t handle,
                                                                float multiplier);
 
+/**
+ * @brief Keep adapting the threshold to the noise floor after calibration.
+ *
+ * When enabled, every frame after calibration updates a noise floor estimate
+ * that falls quickly on quieter frames and rises slowly on louder ones (very
+ * slowly while voice is detected, so a lasting rise in background noise
+ * cannot hold the VAD in speech). The threshold is recomputed from it with
+ * the calibration multiplier and the same bounds as calibration. Disabled by
+ * default to match the Swift service.
+ *
+ * @param handle Service handle
+ * @param enabled RAC_TRUE to track the noise floor
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_energy_vad_set_noise_tracking(rac_energy_vad_handle_t handle,
+                                                       rac_bool_t enabled);
+
 // =============================================================================
 // TTS FEEDBACK PREVENTION API
 // =============================================================================
@@ -436,6 +478,79 @@ RAC_API rac_result_t rac_energy_vad_set_audio_callback(rac_energy_vad_handle_t h
                                                        rac_audio_buffer_callback_fn callback,
                                                        void* user_data);
 
+// =============================================================================
+// MULTI-STREAM API
+// =============================================================================
+
+/**
+ * @brief Opaque handle for a bank of independent energy VAD streams.
+ *
+ * A bank runs the energy VAD for many streams (for example concurrent call
+ * legs) with one call per frame. All streams share the configuration; each
+ * keeps its own calibration, noise floor, statistics and speech state.
+ * Streams calibrate on their first RAC_VAD_CALIBRATION_FRAMES_NEEDED frames
+ * and track the noise floor afterwards. There is no TTS handling or
+ * callback; the caller reads the per-stream results instead.
+ */
+typedef struct rac_energy_vad_bank* rac_energy_vad_bank_handle_t;
+
+/**
+ * @brief Create a bank of energy VAD streams.
+ *
+ * @param config Configuration shared by all streams (can be NULL for defaults)
+ * @param stream_count Number of streams (1 to RAC_VAD_MAX_STREAMS)
+ * @param out_handle Output: Handle to the created bank
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_energy_vad_bank_create(const rac_energy_vad_config_t* config,
+                                                int32_t stream_count,
+                                                rac_energy_vad_bank_handle_t* out_handle);
+
+/**
+ * @brief Destroy a bank.
+ *
+ * @param handle Bank handle to destroy
+ */
+RAC_API void rac_energy_vad_bank_destroy(rac_energy_vad_bank_handle_t handle);
+
+/**
+ * @brief Process one frame of every stream.
+ *
+ * @param handle Bank handle
+ * @param audio_data Interleaved samples: frame_count samples per stream, in
+ *                   stream order (see rac_energy_vad_calculate_rms_interleaved)
+ * @param frame_count Number of samples per stream
+ * @param out_has_voice Output: Per-stream voice detection for this frame (can be NULL)
+ * @param out_is_speaking Output: Per-stream speech state after hysteresis (can be NULL)
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_energy_vad_bank_process(rac_energy_vad_bank_handle_t handle,
+                                                 const float* audio_data, size_t frame_count,
+                                                 rac_bool_t* out_has_voice,
+                                                 rac_bool_t* out_is_speaking);
+
+/**
+ * @brief Reset one stream and start calibrating it again (e.g. a new call).
+ *
+ * @param handle Bank handle
+ * @param stream_index Stream to reset
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_energy_vad_bank_reset_stream(rac_energy_vad_bank_handle_t handle,
+                                                      int32_t stream_index);
+
+/**
+ * @brief Get the statistics of one stream.
+ *
+ * @param handle Bank handle
+ * @param stream_index Stream to query
+ * @param out_stats Output: Stream statistics
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_energy_vad_bank_get_statistics(rac_energy_vad_bank_handle_t handle,
+                                                        int32_t stream_index,
+                                                        rac_energy_vad_stats_t* out_stats);
+
 #ifdef __cplusplus
 }
 #endif
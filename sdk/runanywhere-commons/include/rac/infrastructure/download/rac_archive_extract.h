@@ -0,0 +1,110 @@
+/**
+ * @file rac_archive_extract.h
+ * @brief Streaming archive extraction (tar.gz, tar.bz2, tar.xz)
+ *
+ * Compressed bytes can be pushed in while they are still downloading, so a
+ * model archive is unpacked as it arrives instead of after it is on disk.
+ *
+ * Entries are written to a temporary directory next to the destination and
+ * moved into place by rac_archive_extractor_finish(). If the destination
+ * does not exist it appears in one rename; otherwise each top-level entry of
+ * the archive replaces the entry of the same name. Destroying an extractor
+ * that was not finished removes everything it wrote.
+ *
+ * ZIP needs its central directory at the end of the file and cannot be
+ * streamed; it keeps using the platform adapter's extract_archive.
+ */
+
+#ifndef RAC_ARCHIVE_EXTRACT_H
+#define RAC_ARCHIVE_EXTRACT_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_platform_adapter.h"
+#include "rac/core/rac_types.h"
+#include "rac/infrastructure/model_management/rac_model_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Opaque handle for a streaming extractor.
+ */
+typedef struct rac_archive_extractor* rac_archive_extractor_handle_t;
+
+/**
+ * @brief Whether this build can stream-extract the archive type.
+ *
+ * Depends on the decompression libraries found at build time.
+ */
+RAC_API rac_bool_t rac_archive_extractor_supports(rac_archive_type_t type);
+
+/**
+ * @brief Create an extractor.
+ *
+ * @param type Archive type
+ * @param destination_dir Directory that receives the archive contents
+ * @param out_handle Output: Extractor handle
+ * @return RAC_SUCCESS, RAC_ERROR_UNSUPPORTED_ARCHIVE or an error code
+ */
+RAC_API rac_result_t rac_archive_extractor_create(rac_archive_type_t type,
+                                                  const char* destination_dir,
+                                                  rac_archive_extractor_handle_t* out_handle);
+
+/**
+ * @brief Push the next bytes of the archive.
+ *
+ * @return RAC_SUCCESS, RAC_ERROR_EXTRACTION_FAILED for corrupt or unsafe
+ *         archives, or a file error. After an error only destroy is valid.
+ */
+RAC_API rac_result_t rac_archive_extractor_write(rac_archive_extractor_handle_t handle,
+                                                 const void* data, size_t size);
+
+/**
+ * @brief Check the archive ended cleanly and move the contents into place.
+ *
+ * @return RAC_SUCCESS, or RAC_ERROR_EXTRACTION_FAILED if it was truncated
+ */
+RAC_API rac_result_t rac_archive_extractor_finish(rac_archive_extractor_handle_t handle);
+
+/**
+ * @brief Get extraction counters.
+ *
+ * @param out_bytes_consumed Output: Archive bytes pushed so far (can be NULL)
+ * @param out_bytes_extracted Output: File bytes written so far (can be NULL)
+ * @param out_files_extracted Output: Files written so far (can be NULL)
+ */
+RAC_API void rac_archive_extractor_get_stats(rac_archive_extractor_handle_t handle,
+                                             int64_t* out_bytes_consumed,
+                                             int64_t* out_bytes_extracted,
+                                             int32_t* out_files_extracted);
+
+/**
+ * @brief Destroy an extractor, discarding its output unless it was finished.
+ */
+RAC_API void rac_archive_extractor_destroy(rac_archive_extractor_handle_t handle);
+
+/**
+ * @brief Extract an archive file with the streaming extractor.
+ *
+ * Used by rac_extract_archive() when the platform adapter has no
+ * extract_archive callback. The total file count is not known up front, so
+ * progress reports total_files as 0 until the end.
+ *
+ * @param archive_path Archive file
+ * @param type Archive type
+ * @param destination_dir Destination directory
+ * @param progress_callback Progress callback (can be NULL)
+ * @param callback_user_data User data for the callback
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_archive_extract_file(const char* archive_path, rac_archive_type_t type,
+                                              const char* destination_dir,
+                                              rac_extract_progress_callback_fn progress_callback,
+                                              void* callback_user_data);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_ARCHIVE_EXTRACT_H */
@@ -0,0 +1,153 @@
+/**
+ * @file rac_native_download.h
+ * @brief Native HTTP downloader (parallel ranges, resume, SHA-256)
+ *
+ * Used by rac_http_download() when the platform adapter does not provide
+ * http_download (plain Linux, servers). Built on libcurl; on builds without
+ * it every function returns RAC_ERROR_NOT_SUPPORTED.
+ *
+ * - Files are written to `<destination>.part` and renamed when complete.
+ * - Large files are fetched as parallel HTTP range requests.
+ * - Progress is recorded in `<destination>.part.json`; a later download of
+ *   the same URL to the same destination continues from there.
+ * - The SHA-256 of the file is computed while it is written and checked
+ *   before the rename.
+ * - Archives can be extracted while they download
+ *   (rac_native_download_extract).
+ */
+
+#ifndef RAC_NATIVE_DOWNLOAD_H
+#define RAC_NATIVE_DOWNLOAD_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_platform_adapter.h"
+#include "rac/core/rac_types.h"
+#include "rac/infrastructure/download/rac_download.h"
+#include "rac/infrastructure/model_management/rac_model_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Native download options.
+ */
+typedef struct rac_native_download_options {
+    /** Maximum parallel range requests per file (default: 4) */
+    int32_t max_connections;
+
+    /** Files smaller than this many bytes per connection use fewer connections
+     *  (default: 8 MiB) */
+    int64_t min_segment_bytes;
+
+    /** Retries per range after a network error, resuming where it stopped
+     *  (default: 5) */
+    int32_t max_retries;
+
+    /** Abort a request that receives nothing for this long (default: 30) */
+    int32_t stall_timeout_seconds;
+
+    /** Expected SHA-256 as 64 hex characters, or NULL to skip verification */
+    const char* expected_sha256;
+} rac_native_download_options_t;
+
+/**
+ * @brief Default native download options.
+ */
+static const rac_native_download_options_t RAC_NATIVE_DOWNLOAD_OPTIONS_DEFAULT = {
+    .max_connections = 4,
+    .min_segment_bytes = 8 * 1024 * 1024,
+    .max_retries = 5,
+    .stall_timeout_seconds = 30,
+    .expected_sha256 = NULL};
+
+/**
+ * @brief Whether this build includes the native downloader.
+ */
+RAC_API rac_bool_t rac_native_download_is_available(void);
+
+/**
+ * @brief Download a file, blocking until it completes, fails or is cancelled.
+ *
+ * @param url URL to download (http or https)
+ * @param destination_path Final file path
+ * @param options Options (NULL for defaults)
+ * @param progress_callback Progress callback (can be NULL); called on the calling thread
+ *                          about every 100 ms
+ * @param callback_user_data User data for the callback
+ * @return RAC_SUCCESS, RAC_ERROR_CHECKSUM_MISMATCH, RAC_ERROR_CANCELLED,
+ *         RAC_ERROR_INSUFFICIENT_STORAGE or a network error code
+ */
+RAC_API rac_result_t rac_native_download_file(const char* url, const char* destination_path,
+                                              const rac_native_download_options_t* options,
+                                              rac_http_progress_callback_fn progress_callback,
+                                              void* callback_user_data);
+
+/**
+ * @brief Start a download on a background thread.
+ *
+ * progress_callback and complete_callback are called from that thread;
+ * complete_callback exactly once.
+ *
+ * @param out_task_id Output: Task ID (owned, free with rac_free)
+ * @return RAC_SUCCESS if started, error code otherwise
+ */
+RAC_API rac_result_t rac_native_download_start(const char* url, const char* destination_path,
+                                               const rac_native_download_options_t* options,
+                                               rac_http_progress_callback_fn progress_callback,
+                                               rac_http_complete_callback_fn complete_callback,
+                                               void* callback_user_data, char** out_task_id);
+
+/**
+ * @brief Download an archive and extract it while it downloads.
+ *
+ * Bytes go straight from the network into the streaming extractor
+ * (rac_archive_extract.h); the archive itself is never stored. Progress is
+ * reported with stage RAC_DOWNLOAD_STAGE_EXTRACTING for the whole transfer,
+ * then once with RAC_DOWNLOAD_STAGE_COMPLETED. options->expected_sha256 is
+ * checked against the archive bytes before the contents are moved into
+ * destination_dir. A dropped connection is continued with a range request
+ * when the server supports it; there is no resume across calls.
+ *
+ * @param archive_type RAC_ARCHIVE_TYPE_TAR_GZ, TAR_BZ2 or TAR_XZ
+ * @return RAC_SUCCESS, RAC_ERROR_UNSUPPORTED_ARCHIVE (e.g. ZIP),
+ *         RAC_ERROR_EXTRACTION_FAILED, RAC_ERROR_CHECKSUM_MISMATCH or a
+ *         network error code
+ */
+RAC_API rac_result_t rac_native_download_extract(const char* url, const char* destination_dir,
+                                                 rac_archive_type_t archive_type,
+                                                 const rac_native_download_options_t* options,
+                                                 rac_download_progress_callback_fn progress_callback,
+                                                 void* callback_user_data);
+
+/**
+ * @brief Start rac_native_download_extract() on a background thread.
+ *
+ * complete_callback receives destination_dir on success. Cancel with
+ * rac_native_download_cancel().
+ *
+ * @param out_task_id Output: Task ID (owned, free with rac_free)
+ */
+RAC_API rac_result_t rac_native_download_extract_start(
+    const char* url, const char* destination_dir, rac_archive_type_t archive_type,
+    const rac_native_download_options_t* options,
+    rac_download_progress_callback_fn progress_callback,
+    rac_http_complete_callback_fn complete_callback, void* callback_user_data, char** out_task_id);
+
+/**
+ * @brief Cancel a task started with rac_native_download_start() or
+ *        rac_native_download_extract_start().
+ *
+ * For plain downloads the partial file and its progress record are kept so
+ * the download can be resumed; a cancelled extraction removes what it wrote.
+ * The complete callback reports RAC_ERROR_CANCELLED.
+ *
+ * @return RAC_SUCCESS, or RAC_ERROR_NOT_FOUND for unknown or finished tasks
+ */
+RAC_API rac_result_t rac_native_download_cancel(const char* task_id);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_NATIVE_DOWNLOAD_H */
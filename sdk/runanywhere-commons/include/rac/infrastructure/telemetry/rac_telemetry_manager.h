@@ -12,6 +12,8 @@
  * Platform SDKs only need to:
  * - Provide device info
  * - Make HTTP calls when callback is invoked
+ * - Call rac_telemetry_manager_poll() periodically (about once a second) from
+ *   a thread they own; the HTTP callback only ever runs inside poll/flush
  */
 
 #ifndef RAC_TELEMETRY_MANAGER_H
@@ -51,10 +53,31 @@ typedef void (*rac_telemetry_http_callback_t)(void* user_data, const char* endpo
                                               const char* json_body, size_t json_length,
                                               rac_bool_t requires_auth);
 
+/**
+ * @brief HTTP request callback that identifies each request
+ *
+ * Same as rac_telemetry_http_callback_t plus a request id, which the platform
+ * passes back to rac_telemetry_manager_http_request_complete(). Required for
+ * the offline spool, since completions may arrive in any order.
+ *
+ * @param user_data User data provided at registration
+ * @param request_id Id of this request, unique per manager
+ * @param endpoint The API endpoint path
+ * @param json_body The JSON request body (null-terminated string)
+ * @param json_length Length of JSON body
+ * @param requires_auth Whether request needs authentication
+ */
+typedef void (*rac_telemetry_http_request_callback_t)(void* user_data, uint64_t request_id,
+                                                      const char* endpoint, const char* json_body,
+                                                      size_t json_length,
+                                                      rac_bool_t requires_auth);
+
 /**
  * @brief HTTP response callback from platform SDK to C++
  *
- * Platform SDK calls this after HTTP completes.
+ * Logs the outcome of a request sent through rac_telemetry_http_callback_t.
+ * Those requests are not tracked, so failures are not spooled; use
+ * rac_telemetry_manager_http_request_complete() for that.
  *
  * @param manager The telemetry manager
  * @param success Whether HTTP call succeeded
@@ -65,6 +88,25 @@ RAC_API void rac_telemetry_manager_http_complete(rac_telemetry_manager_t* manage
                                                  rac_bool_t success, const char* response_json,
                                                  const char* error_message);
 
+/**
+ * @brief Report the outcome of a request from rac_telemetry_http_request_callback_t
+ *
+ * May be called from any thread, including from inside the callback. When a
+ * spool is configured, a failed request is written to disk and replayed
+ * later. Requests not reported within two minutes are assumed lost; a lost
+ * replay stays on disk and is sent again.
+ *
+ * @param manager The telemetry manager
+ * @param request_id Id passed to the request callback
+ * @param success Whether HTTP call succeeded
+ * @param response_json Response JSON (can be NULL on failure)
+ * @param error_message Error message if failed (can be NULL)
+ */
+RAC_API void rac_telemetry_manager_http_request_complete(rac_telemetry_manager_t* manager,
+                                                         uint64_t request_id, rac_bool_t success,
+                                                         const char* response_json,
+                                                         const char* error_message);
+
 // =============================================================================
 // LIFECYCLE
 // =============================================================================
@@ -100,12 +142,24 @@ RAC_API void rac_telemetry_manager_set_device_info(rac_telemetry_manager_t* mana
 /**
  * @brief Register HTTP callback
  *
- * Platform SDK must register this to receive HTTP requests.
+ * Platform SDK must register this or the request callback to receive HTTP
+ * requests. Replaces a registered request callback.
  */
 RAC_API void rac_telemetry_manager_set_http_callback(rac_telemetry_manager_t* manager,
                                                      rac_telemetry_http_callback_t callback,
                                                      void* user_data);
 
+/**
+ * @brief Register HTTP callback with request ids
+ *
+ * Use instead of rac_telemetry_manager_set_http_callback() when the platform
+ * reports outcomes with rac_telemetry_manager_http_request_complete().
+ * Replaces a registered plain callback.
+ */
+RAC_API void rac_telemetry_manager_set_http_request_callback(
+    rac_telemetry_manager_t* manager, rac_telemetry_http_request_callback_t callback,
+    void* user_data);
+
 // =============================================================================
 // EVENT TRACKING
 // =============================================================================
@@ -113,7 +167,13 @@ RAC_API void rac_telemetry_manager_set_http_callback(rac_telemetry_manager_t* ma
 /**
  * @brief Track a telemetry payload directly
  *
- * Queues the payload for batching and sending.
+ * Queues the payload for batching. Never blocks and never calls the HTTP
+ * callback: batches are sent by the next rac_telemetry_manager_poll().
+ * Single-threaded WebAssembly builds are the exception and send inline. If
+ * the queue is full the event is dropped and counted in
+ * rac_telemetry_stats_t::dropped_events.
+ *
+ * @return RAC_SUCCESS, or RAC_ERROR_SERVICE_BUSY if the event was dropped
  */
 RAC_API rac_result_t rac_telemetry_manager_track(rac_telemetry_manager_t* manager,
                                                  const rac_telemetry_payload_t* payload);
@@ -130,10 +190,67 @@ RAC_API rac_result_t rac_telemetry_manager_track_analytics(rac_telemetry_manager
 /**
  * @brief Flush queued events immediately
  *
- * Sends all queued events to the backend.
+ * Sends all queued events to the backend. Runs on the calling thread.
  */
 RAC_API rac_result_t rac_telemetry_manager_flush(rac_telemetry_manager_t* manager);
 
+/**
+ * @brief Send due batches and spooled requests
+ *
+ * Sends the queue if a flush was triggered (development mode, batch size,
+ * completion events) or the 5 s batch timeout has passed, then replays the
+ * spool. Runs the HTTP callback on the calling thread; call it periodically
+ * from a thread the platform owns.
+ *
+ * @return RAC_SUCCESS, or RAC_ERROR_NOT_INITIALIZED without an HTTP callback
+ */
+RAC_API rac_result_t rac_telemetry_manager_poll(rac_telemetry_manager_t* manager);
+
+// =============================================================================
+// OFFLINE SPOOL & STATS
+// =============================================================================
+
+/**
+ * @brief Telemetry queue and spool counters
+ */
+typedef struct rac_telemetry_stats {
+    /** Events waiting in the in-memory queue */
+    size_t queued_events;
+    /** Events dropped because the queue was full */
+    uint64_t dropped_events;
+    /** Requests waiting in the on-disk spool */
+    size_t spooled_requests;
+    /** Bytes used by spool files */
+    size_t spool_bytes;
+    /** Spooled requests evicted to stay under the size cap */
+    uint64_t evicted_requests;
+    /** RAC_TRUE after a failed send, until a send succeeds */
+    rac_bool_t offline;
+} rac_telemetry_stats_t;
+
+/**
+ * @brief Enable the on-disk spool for failed requests
+ *
+ * Requests reported failed via rac_telemetry_manager_http_request_complete()
+ * are appended to files in directory and replayed with exponential backoff.
+ * Requests left by a previous process are replayed too. When the spool
+ * exceeds max_bytes the oldest requests are evicted.
+ *
+ * @param manager The telemetry manager
+ * @param directory Writable directory (e.g. app cache dir), or NULL to disable
+ * @param max_bytes Size cap for spool files
+ * @return RAC_SUCCESS, RAC_ERROR_NOT_SUPPORTED on platforms without file
+ *         mapping (Web, Windows), or RAC_ERROR_FILE_WRITE_FAILED
+ */
+RAC_API rac_result_t rac_telemetry_manager_set_spool(rac_telemetry_manager_t* manager,
+                                                     const char* directory, uint64_t max_bytes);
+
+/**
+ * @brief Get queue and spool counters
+ */
+RAC_API rac_result_t rac_telemetry_manager_get_stats(rac_telemetry_manager_t* manager,
+                                                     rac_telemetry_stats_t* out_stats);
+
 // =============================================================================
 // JSON SERIALIZATION
 // =============================================================================
@@ -339,6 +339,34 @@ typedef struct rac_openai_delta {
     size_t num_tool_calls;
 } rac_openai_delta_t;
 
+/**
+ * @brief Alternative token in a logprobs entry
+ */
+typedef struct rac_openai_top_logprob {
+    /** Token text */
+    const char* token;
+
+    /** Log-probability of the token */
+    float logprob;
+} rac_openai_top_logprob_t;
+
+/**
+ * @brief Log-probability of a generated token
+ *
+ * Mirrors OpenAI's ChatCompletionTokenLogprob.
+ */
+typedef struct rac_openai_token_logprob {
+    /** Token text */
+    const char* token;
+
+    /** Log-probability of the token */
+    float logprob;
+
+    /** Most likely tokens at this position (can be NULL) */
+    const rac_openai_top_logprob_t* top_logprobs;
+    size_t num_top_logprobs;
+} rac_openai_token_logprob_t;
+
 /**
  * @brief Streaming choice chunk
  */
@@ -349,6 +377,10 @@ typedef struct rac_openai_stream_choice {
     /** Delta content */
     rac_openai_delta_t delta;
 
+    /** Logprobs for the tokens in this delta (NULL if not requested) */
+    const rac_openai_token_logprob_t* logprobs;
+    size_t num_logprobs;
+
     /** Finish reason (NULL until done) */
     rac_openai_finish_reason_t finish_reason;
 } rac_openai_stream_choice_t;
@@ -44,6 +44,23 @@ extern "C" {
  *
  * Configure the HTTP server before starting.
  */
+/**
+ * @brief LoRA adapter served under its own model ID
+ *
+ * Requests whose "model" field matches model_id are generated with the
+ * adapter applied to the shared base model; other requests use the base model.
+ */
+typedef struct rac_server_lora_model {
+    /** Model ID clients select in the "model" field (also listed by /v1/models) */
+    const char* model_id;
+
+    /** Path to the LoRA adapter GGUF file */
+    const char* adapter_path;
+
+    /** Adapter scale factor */
+    float scale;
+} rac_server_lora_model_t;
+
 typedef struct rac_server_config {
     /** Host address to bind to (default: "127.0.0.1") */
     const char* host;
@@ -51,7 +68,7 @@ typedef struct rac_server_config {
     /** Port to listen on (default: 8080) */
     uint16_t port;
 
-    /** Path to the GGUF model file (required) */
+    /** Path to the GGUF model file (required unless mock_tokens_per_second > 0) */
     const char* model_path;
 
     /** Model ID to expose via /v1/models (default: derived from filename) */
@@ -60,6 +77,12 @@ typedef struct rac_server_config {
     /** Context window size in tokens (default: 8192) */
     int32_t context_size;
 
+    /**
+     * Slide the context window when a conversation outgrows context_size,
+     * keeping the system prompt pinned (default: false = reject the request)
+     */
+    rac_bool_t context_shift;
+
     /** Number of threads for inference (default: 4, 0 = auto) */
     int32_t threads;
 
@@ -80,6 +103,20 @@ typedef struct rac_server_config {
 
     /** Verbose logging (default: false) */
     rac_bool_t verbose;
+
+    /**
+     * Serve a synthetic LLM that streams placeholder tokens at this rate per
+     * request instead of loading model_path (default: 0 = disabled).
+     * Intended for load testing the HTTP/SSE layer.
+     */
+    int32_t mock_tokens_per_second;
+
+    /** Mock LLM delay before the first token, in ms (default: 0) */
+    int32_t mock_prefill_ms;
+
+    /** LoRA adapters served as additional models (can be NULL, copied on start) */
+    const rac_server_lora_model_t* lora_models;
+    size_t num_lora_models;
 } rac_server_config_t;
 
 /**
@@ -91,13 +128,18 @@ static const rac_server_config_t RAC_SERVER_CONFIG_DEFAULT = {
     .model_path = RAC_NULL,
     .model_id = RAC_NULL,
     .context_size = 8192,
+    .context_shift = RAC_FALSE,
     .threads = 4,
     .gpu_layers = 0,
     .enable_cors = RAC_TRUE,
     .cors_origins = "*",
     .request_timeout_seconds = 300,
     .max_concurrent_requests = 4,
-    .verbose = RAC_FALSE
+    .verbose = RAC_FALSE,
+    .mock_tokens_per_second = 0,
+    .mock_prefill_ms = 0,
+    .lora_models = RAC_NULL,
+    .num_lora_models = 0
 };
 
 // =============================================================================
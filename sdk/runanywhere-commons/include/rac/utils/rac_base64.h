@@ -0,0 +1,139 @@
+/**
+ * @file rac_base64.h
+ * @brief RunAnywhere Commons - Base64 Encoding and Decoding
+ *
+ * Standard (RFC 4648) base64 used for media payloads: images sent to VLMs,
+ * audio clips from the JS bridges and generated images returned as JSON.
+ * Both directions write into caller-provided buffers. Decoding accepts a
+ * "data:<mime>;base64," prefix, skips whitespace and tolerates missing
+ * padding. A streaming decoder handles payloads that arrive in chunks.
+ *
+ * Whole 4-character groups are processed with SSE2/SSSE3/AVX2 or NEON when
+ * the target supports them, with a table-driven scalar fallback.
+ */
+
+#ifndef RAC_BASE64_H
+#define RAC_BASE64_H
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// =============================================================================
+// SIZES
+// =============================================================================
+
+/**
+ * @brief Length of the padded base64 encoding of data_size bytes
+ *
+ * Does not include a NUL terminator.
+ */
+RAC_API size_t rac_base64_encoded_size(size_t data_size);
+
+/**
+ * @brief Upper bound on the decoded size of encoded_size base64 characters
+ *
+ * Any buffer of this size is large enough for rac_base64_decode() and for one
+ * rac_base64_decoder_update() call with the same input length.
+ */
+RAC_API size_t rac_base64_decoded_max_size(size_t encoded_size);
+
+// =============================================================================
+// ONE-SHOT
+// =============================================================================
+
+/**
+ * @brief Encode bytes as padded base64
+ *
+ * @param data Bytes to encode (can be NULL if data_size is 0)
+ * @param data_size Number of bytes
+ * @param out_text Output buffer (not NUL-terminated)
+ * @param out_capacity Size of out_text, at least rac_base64_encoded_size(data_size)
+ * @param out_length Output: Number of characters written (can be NULL)
+ * @return RAC_SUCCESS, RAC_ERROR_NULL_POINTER or RAC_ERROR_BUFFER_TOO_SMALL
+ */
+RAC_API rac_result_t rac_base64_encode(const uint8_t* data, size_t data_size, char* out_text,
+                                       size_t out_capacity, size_t* out_length);
+
+/**
+ * @brief Decode base64 text
+ *
+ * A leading data URI header (everything up to the first ',' when the text
+ * starts with "data:") is skipped, as is whitespace anywhere in the text.
+ *
+ * @param text Base64 text (can be NULL if text_length is 0)
+ * @param text_length Length of text in characters
+ * @param out_data Output buffer
+ * @param out_capacity Size of out_data, at least rac_base64_decoded_max_size(text_length)
+ * @param out_size Output: Number of bytes written
+ * @return RAC_SUCCESS, RAC_ERROR_NULL_POINTER, RAC_ERROR_BUFFER_TOO_SMALL or
+ *         RAC_ERROR_INVALID_FORMAT for characters outside the base64 alphabet,
+ *         misplaced padding or a truncated final group
+ */
+RAC_API rac_result_t rac_base64_decode(const char* text, size_t text_length, uint8_t* out_data,
+                                       size_t out_capacity, size_t* out_size);
+
+// =============================================================================
+// STREAMING DECODE
+// =============================================================================
+
+/**
+ * @brief Incremental base64 decoder state
+ *
+ * Plain value type: initialize with rac_base64_decoder_init(), no cleanup
+ * needed. Fields are private to the implementation.
+ */
+typedef struct rac_base64_decoder {
+    /** Characters of an incomplete group (or data URI header) carried over */
+    char pending[8];
+    int32_t pending_count;
+    /** Parser state */
+    int32_t state;
+} rac_base64_decoder_t;
+
+/**
+ * @brief Reset a decoder to expect the start of a new payload
+ */
+RAC_API void rac_base64_decoder_init(rac_base64_decoder_t* decoder);
+
+/**
+ * @brief Decode the next chunk of base64 text
+ *
+ * Chunks may split the text anywhere, including inside a 4-character group
+ * or the data URI header. Characters of an incomplete group are kept in the
+ * decoder until the next call.
+ *
+ * @param decoder Decoder state
+ * @param text Next chunk (can be NULL if text_length is 0)
+ * @param text_length Chunk length in characters
+ * @param out_data Output buffer
+ * @param out_capacity Size of out_data, at least rac_base64_decoded_max_size(text_length)
+ * @param out_size Output: Number of bytes written for this chunk
+ * @return RAC_SUCCESS, RAC_ERROR_NULL_POINTER, RAC_ERROR_BUFFER_TOO_SMALL or
+ *         RAC_ERROR_INVALID_FORMAT (the decoder must be re-initialized after an error)
+ */
+RAC_API rac_result_t rac_base64_decoder_update(rac_base64_decoder_t* decoder, const char* text,
+                                               size_t text_length, uint8_t* out_data,
+                                               size_t out_capacity, size_t* out_size);
+
+/**
+ * @brief Finish decoding and flush an unpadded final group
+ *
+ * @param decoder Decoder state
+ * @param out_data Output buffer
+ * @param out_capacity Size of out_data, at least 3
+ * @param out_size Output: Number of bytes written (0-3)
+ * @return RAC_SUCCESS, RAC_ERROR_NULL_POINTER, RAC_ERROR_BUFFER_TOO_SMALL or
+ *         RAC_ERROR_INVALID_FORMAT if the text ended inside a group
+ */
+RAC_API rac_result_t rac_base64_decoder_finish(rac_base64_decoder_t* decoder, uint8_t* out_data,
+                                               size_t out_capacity, size_t* out_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RAC_BASE64_H */
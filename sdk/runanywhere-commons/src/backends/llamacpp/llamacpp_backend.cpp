@@ -1,14 +1,18 @@
 #include "llamacpp_backend.h"
+#include "utf8_state.h"
 
 #include "common.h"
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstring>
+#include <iterator>
 #include <string>
 #include <vector>
 
 #include "rac/core/rac_logger.h"
+#include "rac/core/rac_profiler.h"
 
 // Use the RAC logging system
 #define LOGI(...) RAC_LOG_INFO("LLM.LlamaCpp", __VA_ARGS__)
@@ -16,39 +20,18 @@
 
 namespace runanywhere {
 
-// UTF-8 STATE MACHINE (DFA)
-
-struct Utf8State {
-
-    uint32_t state = 0;
-
-    // Bjoern Hoehrmann LUT
-    bool process(uint8_t byte) {
-        static const uint8_t utf8d[] = {
-            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 00..1f
-            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 20..3f
-            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 40..5f
-            0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 60..7f
-            1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, // 80..9f
-            7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7, // a0..bf
-            8,8,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, // c0..df
-            0xa,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x4,0x3,0x3, // e0..ef
-            0xb,0x6,0x6,0x6,0x5,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8, // f0..ff
-            0x0,0x1,0x2,0x3,0x5,0x8,0x7,0x1,0x1,0x1,0x4,0x6,0x1,0x1,0x1,0x1, // s0..s0
-            1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,1,1,1,1,1,0,1,0,1,1,1,1,1,1, // s1..s2
-            1,2,1,1,1,1,1,2,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1, // s3..s4
-            1,2,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,3,1,3,1,1,1,1,1,1, // s5..s6
-            1,3,1,1,1,1,1,3,1,3,1,1,1,1,1,1,1,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1, // s7..s8
-        };
-
-        uint32_t type = utf8d[byte];
-        state = utf8d[256 + state * 16 + type];
-        return (state == 0);
-    }
-
-    void reset() { state = 0; }
+// Text that ends a turn even when the model does not emit an EOG token
+static const std::vector<std::string> STOP_SEQUENCES = {
+    "<|im_end|>", "<|eot_id|>", "</s>", "<|end|>", "<|endoftext|>",
+    "\n\nUser:", "\n\nHuman:",
 };
 
+static const size_t MAX_STOP_LEN = [] {
+    size_t m = 0;
+    for (const auto& s : STOP_SEQUENCES) m = std::max(m, s.size());
+    return m;
+}();
+
 // =============================================================================
 // LOG CALLBACK
 // =============================================================================
@@ -192,6 +175,15 @@ bool LlamaCppTextGeneration::load_model(const std::string& model_path,
     if (config.contains("max_context_size")) {
         max_default_context_ = config["max_context_size"].get<int>();
     }
+    if (config.contains("max_parallel_sequences")) {
+        max_parallel_sequences_ = std::max(1, config["max_parallel_sequences"].get<int>());
+    }
+    if (config.contains("context_shift")) {
+        context_shift_ = config["context_shift"].get<bool>();
+    }
+    if (config.contains("n_keep")) {
+        n_keep_ = std::max(0, config["n_keep"].get<int>());
+    }
 
     model_config_ = config;
     model_path_ = model_path;
@@ -327,15 +319,7 @@ bool LlamaCppTextGeneration::load_model(const std::string& model_path,
              model_train_ctx, max_default_context_, adaptive_max_context);
     }
 
-    llama_context_params ctx_params = llama_context_default_params();
-    ctx_params.n_ctx = context_size_;
-    ctx_params.n_batch = context_size_;   // Allow processing full prompt at once
-    ctx_params.n_ubatch = context_size_;  // Physical batch size must also match
-    ctx_params.n_threads = backend_->get_num_threads();
-    ctx_params.n_threads_batch = backend_->get_num_threads();
-    ctx_params.no_perf = true;
-
-    context_ = llama_init_from_model(model_, ctx_params);
+    context_ = llama_init_from_model(model_, make_context_params());
 
     if (!context_) {
         LOGE("Failed to create context");
@@ -370,9 +354,10 @@ bool LlamaCppTextGeneration::unload_model_internal() {
 
     // Clear LoRA adapters from context before freeing
     // (adapter memory is freed automatically with the model per llama.cpp API)
-    if (context_ && !lora_adapters_.empty()) {
+    if (context_ && !active_lora_.empty()) {
         llama_clear_adapter_lora(context_);
     }
+    active_lora_.clear();
     lora_adapters_.clear();
 
     if (sampler_) {
@@ -402,6 +387,46 @@ bool LlamaCppTextGeneration::unload_model() {
     return unload_model_internal();
 }
 
+llama_context_params LlamaCppTextGeneration::make_context_params() const {
+    llama_context_params ctx_params = llama_context_default_params();
+    ctx_params.n_ctx = context_size_;
+    ctx_params.n_batch = context_size_;   // Allow processing full prompt at once
+    ctx_params.n_ubatch = context_size_;  // Physical batch size must also match
+    ctx_params.n_threads = backend_->get_num_threads();
+    ctx_params.n_threads_batch = backend_->get_num_threads();
+    ctx_params.no_perf = true;
+    // generate_choices forks the prompt into several sequences; a unified KV
+    // cache lets them share the prompt cells and keeps the full context
+    // available to single-sequence requests
+    ctx_params.n_seq_max = static_cast<uint32_t>(max_parallel_sequences_);
+    ctx_params.kv_unified = true;
+    return ctx_params;
+}
+
+llama_sampler* LlamaCppTextGeneration::create_sampler(const TextGenerationRequest& request,
+                                                      uint32_t seed) const {
+    auto sparams = llama_sampler_chain_default_params();
+    sparams.no_perf = true;
+    llama_sampler* sampler = llama_sampler_chain_init(sparams);
+
+    if (request.temperature > 0.0f) {
+        // Use default penalties (1.2f repetition) or request params if added later
+        llama_sampler_chain_add(sampler,
+                                llama_sampler_init_penalties(64, request.repetition_penalty, 0.0f, 0.0f));
+
+        if (request.top_k > 0) {
+            llama_sampler_chain_add(sampler, llama_sampler_init_top_k(request.top_k));
+        }
+
+        llama_sampler_chain_add(sampler, llama_sampler_init_top_p(request.top_p, 1));
+        llama_sampler_chain_add(sampler, llama_sampler_init_temp(request.temperature));
+        llama_sampler_chain_add(sampler, llama_sampler_init_dist(seed));
+    } else {
+        llama_sampler_chain_add(sampler, llama_sampler_init_greedy());
+    }
+    return sampler;
+}
+
 std::string LlamaCppTextGeneration::build_prompt(const TextGenerationRequest& request) {
     std::vector<std::pair<std::string, std::string>> messages;
 
@@ -508,6 +533,56 @@ std::string LlamaCppTextGeneration::apply_chat_template(
     return formatted;
 }
 
+int LlamaCppTextGeneration::pinned_prefix_tokens(const TextGenerationRequest& request,
+                                                 const std::vector<llama_token>& prompt_tokens) {
+    if (n_keep_ > 0) {
+        return std::min(n_keep_, static_cast<int>(prompt_tokens.size()));
+    }
+
+    // The system turn as rendered by the chat template; the pinned prefix is
+    // what it shares with the full prompt (at least the BOS token)
+    const std::string system_text =
+        request.system_prompt.empty() ? "" : apply_chat_template({}, request.system_prompt, false);
+    const std::vector<llama_token> system_tokens = common_tokenize(context_, system_text, true, true);
+
+    size_t n_keep = 0;
+    while (n_keep < system_tokens.size() && n_keep < prompt_tokens.size() &&
+           system_tokens[n_keep] == prompt_tokens[n_keep]) {
+        ++n_keep;
+    }
+    return static_cast<int>(n_keep);
+}
+
+// Token positions after n_keep where an earlier turn ends, found by rendering
+// the conversation up to each turn and matching it against the prompt. The
+// current (last) turn is excluded, so evicting up to a boundary never touches
+// the message being answered.
+std::vector<int> LlamaCppTextGeneration::turn_boundaries(
+    const TextGenerationRequest& request, const std::vector<llama_token>& prompt_tokens,
+    int n_keep) {
+    std::vector<int> boundaries;
+    std::vector<std::pair<std::string, std::string>> turns;
+    for (size_t i = 0; i + 1 < request.messages.size(); ++i) {
+        turns.push_back(request.messages[i]);
+        const std::vector<llama_token> tokens = common_tokenize(
+            context_, apply_chat_template(turns, request.system_prompt, false), true, true);
+
+        size_t common = 0;
+        while (common < tokens.size() && common < prompt_tokens.size() &&
+               tokens[common] == prompt_tokens[common]) {
+            ++common;
+        }
+        // Templates that render earlier turns differently once more follow
+        // only match up to the first difference; that is still a safe cut
+        const int boundary = static_cast<int>(common);
+        if (boundary > n_keep && boundary < static_cast<int>(prompt_tokens.size()) &&
+            (boundaries.empty() || boundary > boundaries.back())) {
+            boundaries.push_back(boundary);
+        }
+    }
+    return boundaries;
+}
+
 TextGenerationResult LlamaCppTextGeneration::generate(const TextGenerationRequest& request) {
     LOGI("generate() START: max_tokens=%d, temp=%.2f, prompt_len=%zu",
          request.max_tokens, request.temperature, request.prompt.length());
@@ -553,13 +628,92 @@ TextGenerationResult LlamaCppTextGeneration::generate(const TextGenerationReques
 
 bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& request,
                                              TextStreamCallback callback,
-                                             int* out_prompt_tokens) {
+                                             int* out_prompt_tokens,
+                                             GenerationTimings* out_timings) {
+    TextGenerationRequest text_request = request;
+    text_request.top_logprobs = -1;
+    return run_generation(
+        text_request,
+        [&callback](const std::string& text, const std::vector<TokenLogprob>&) {
+            return callback(text);
+        },
+        out_prompt_tokens, out_timings);
+}
+
+bool LlamaCppTextGeneration::generate_stream_with_logprobs(const TextGenerationRequest& request,
+                                                           TextLogprobStreamCallback callback,
+                                                           int* out_prompt_tokens) {
+    TextGenerationRequest logprob_request = request;
+    logprob_request.top_logprobs = std::max(0, request.top_logprobs);
+    return run_generation(logprob_request, callback, out_prompt_tokens, nullptr);
+}
+
+// Same as llama_sampler_sample(sampler_, context_, -1), but the candidate array
+// is ours: the raw log-softmax and the top_n alternatives are read from it
+// before the sampler chain truncates and reorders it.
+llama_token LlamaCppTextGeneration::sample_with_logprobs(int top_n, TokenLogprob* out) {
+    const float* logits = llama_get_logits_ith(context_, -1);
+    const int32_t n_vocab = llama_vocab_n_tokens(llama_model_get_vocab(model_));
+
+    candidates_.resize(n_vocab);
+    float max_logit = logits[0];
+    for (llama_token id = 0; id < n_vocab; ++id) {
+        candidates_[id] = llama_token_data{id, logits[id], 0.0f};
+        max_logit = std::max(max_logit, logits[id]);
+    }
+    double sum = 0.0;
+    for (llama_token id = 0; id < n_vocab; ++id) {
+        sum += std::exp(static_cast<double>(logits[id] - max_logit));
+    }
+    const float log_norm = max_logit + static_cast<float>(std::log(sum));
+
+    // Keep the top_n logits in a small sorted array
+    std::vector<llama_token> top;
+    top.reserve(top_n + 1);
+    if (top_n > 0) {
+        for (llama_token id = 0; id < n_vocab; ++id) {
+            if (static_cast<int>(top.size()) == top_n && logits[id] <= logits[top.back()]) {
+                continue;
+            }
+            auto pos = std::upper_bound(top.begin(), top.end(), id, [logits](llama_token a, llama_token b) {
+                return logits[a] > logits[b];
+            });
+            top.insert(pos, id);
+            if (static_cast<int>(top.size()) > top_n) {
+                top.pop_back();
+            }
+        }
+    }
+
+    llama_token_data_array cur_p = {candidates_.data(), candidates_.size(), -1, false};
+    llama_sampler_apply(sampler_, &cur_p);
+    const llama_token token = cur_p.data[cur_p.selected].id;
+    llama_sampler_accept(sampler_, token);
+
+    out->token = common_token_to_piece(context_, token);
+    out->logprob = logits[token] - log_norm;
+    out->top_logprobs.clear();
+    for (llama_token id : top) {
+        out->top_logprobs.push_back({common_token_to_piece(context_, id), logits[id] - log_norm});
+    }
+    return token;
+}
+
+bool LlamaCppTextGeneration::run_generation(const TextGenerationRequest& request,
+                                            const TextLogprobStreamCallback& callback,
+                                            int* out_prompt_tokens,
+                                            GenerationTimings* out_timings) {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    const uint64_t request_start_ns = out_timings ? rac_profiler_now_ns() : 0;
+
     if (!is_ready()) {
         LOGE("Model not ready for generation");
         return false;
     }
+    if (!select_lora_adapters(request)) {
+        return false;
+    }
 
     // Clear KV cache before each new generation to avoid position conflicts on
     // sequential calls (fixes #356: SIGABRT on second decode on Android arm64).
@@ -571,10 +725,13 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
     cancel_requested_.store(false);
     decode_failed_ = false;
 
-    std::string prompt = build_prompt(request);
-    LOGI("Generating with prompt length: %zu", prompt.length());
-
-    const auto tokens_list = common_tokenize(context_, prompt, true, true);
+    std::vector<llama_token> tokens_list;
+    {
+        RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_TOKENIZE);
+        std::string prompt = build_prompt(request);
+        LOGI("Generating with prompt length: %zu", prompt.length());
+        tokens_list = common_tokenize(context_, prompt, true, true);
+    }
 
     int n_ctx = llama_n_ctx(context_);
     int prompt_tokens = static_cast<int>(tokens_list.size());
@@ -582,6 +739,53 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
     if (out_prompt_tokens) {
         *out_prompt_tokens = prompt_tokens;
     }
+    if (out_timings) {
+        *out_timings = GenerationTimings();
+        out_timings->prompt_tokens = prompt_tokens;
+    }
+
+    bool shift_enabled = context_shift_;
+    if (shift_enabled && mem && !llama_memory_can_shift(mem)) {
+        LOGI("Context shift not supported by this model's memory, disabled");
+        shift_enabled = false;
+    }
+
+    int n_keep = 0;
+    std::vector<int> boundaries;  // Ends of earlier turns, in KV positions
+    if (shift_enabled) {
+        // Never pin more than half the window, or nothing could be evicted
+        n_keep = std::min(pinned_prefix_tokens(request, tokens_list), n_ctx / 2);
+        if (prompt_tokens + request.max_tokens > n_ctx - 4) {
+            boundaries = turn_boundaries(request, tokens_list, n_keep);
+        }
+
+        // Prompt alone overflows: drop the oldest turns after the pinned
+        // prefix, leaving room for part of the generation. Only when the
+        // current turn alone is too long are its oldest tokens dropped.
+        if (prompt_tokens > n_ctx - 4) {
+            const int reserve = std::min(request.max_tokens, (n_ctx - n_keep) / 2);
+            int n_erase = prompt_tokens - (n_ctx - 4 - reserve);
+            const auto cut =
+                std::lower_bound(boundaries.begin(), boundaries.end(), n_keep + n_erase);
+            if (cut != boundaries.end()) {
+                n_erase = *cut - n_keep;
+            }
+            boundaries.erase(boundaries.begin(), cut == boundaries.end() ? cut : std::next(cut));
+            for (int& boundary : boundaries) {
+                boundary -= n_erase;
+            }
+            tokens_list.erase(tokens_list.begin() + n_keep, tokens_list.begin() + n_keep + n_erase);
+            LOGI("Prompt truncated: %d -> %zu tokens (n_keep=%d)", prompt_tokens,
+                 tokens_list.size(), n_keep);
+            prompt_tokens = static_cast<int>(tokens_list.size());
+            if (out_prompt_tokens) {
+                *out_prompt_tokens = prompt_tokens;
+            }
+            if (out_timings) {
+                out_timings->prompt_tokens = prompt_tokens;
+            }
+        }
+    }
 
     int available_tokens = n_ctx - prompt_tokens - 4;
 
@@ -590,7 +794,9 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
         return false;
     }
 
-    int effective_max_tokens = std::min(request.max_tokens, available_tokens);
+    // With context shift the window slides, so only max_tokens bounds generation
+    int effective_max_tokens =
+        shift_enabled ? request.max_tokens : std::min(request.max_tokens, available_tokens);
     LOGI("Generation: prompt_tokens=%d, max_tokens=%d, context=%d",
          prompt_tokens, effective_max_tokens, n_ctx);
 
@@ -606,7 +812,16 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
     LOGI("generate_stream: tokens added, n_tokens=%d", batch.n_tokens);
 
     LOGI("generate_stream: calling llama_decode...");
-    if (llama_decode(context_, batch) != 0) {
+    int prefill_status;
+    {
+        RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_PREFILL);
+        const uint64_t prefill_start_ns = out_timings ? rac_profiler_now_ns() : 0;
+        prefill_status = llama_decode(context_, batch);
+        if (out_timings) {
+            out_timings->prefill_ns = rac_profiler_now_ns() - prefill_start_ns;
+        }
+    }
+    if (prefill_status != 0) {
         LOGE("llama_decode failed for prompt");
         llama_batch_free(batch);
         return false;
@@ -617,26 +832,7 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
     if (sampler_) {
         llama_sampler_free(sampler_);
     }
-
-    auto sparams = llama_sampler_chain_default_params();
-    sparams.no_perf = true;
-    sampler_ = llama_sampler_chain_init(sparams);
-
-    if (request.temperature > 0.0f) {
-        // Use default penalties (1.2f repetition) or request params if added later
-        llama_sampler_chain_add(sampler_,
-                                llama_sampler_init_penalties(64, request.repetition_penalty, 0.0f, 0.0f));
-
-        if (request.top_k > 0) {
-            llama_sampler_chain_add(sampler_, llama_sampler_init_top_k(request.top_k));
-        }
-
-        llama_sampler_chain_add(sampler_, llama_sampler_init_top_p(request.top_p, 1));
-        llama_sampler_chain_add(sampler_, llama_sampler_init_temp(request.temperature));
-        llama_sampler_chain_add(sampler_, llama_sampler_init_dist(LLAMA_DEFAULT_SEED));
-    } else {
-        llama_sampler_chain_add(sampler_, llama_sampler_init_greedy());
-    }
+    sampler_ = create_sampler(request, request.seed);
 
     // Log generation parameters
     LOGI("[PARAMS] LLM generate_stream (per-request options): temperature=%.4f, top_p=%.4f, top_k=%d, "
@@ -648,17 +844,6 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
 
     const auto vocab = llama_model_get_vocab(model_);
 
-    static const std::vector<std::string> STOP_SEQUENCES = {
-        "<|im_end|>", "<|eot_id|>", "</s>", "<|end|>", "<|endoftext|>",
-        "\n\nUser:", "\n\nHuman:",
-    };
-
-    static const size_t MAX_STOP_LEN = []{
-        size_t m = 0;
-        for (const auto& s : STOP_SEQUENCES) m = std::max(m, s.size());
-        return m;
-    }();
-
     std::string stop_window;
     stop_window.reserve(MAX_STOP_LEN * 2);
 
@@ -669,27 +854,75 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
     int tokens_generated = 0;
     bool stop_sequence_hit = false;
 
+    // Sampled tokens not yet attached to emitted text, with the byte offset
+    // at which each one's text ends
+    const bool want_logprobs = request.top_logprobs >= 0;
+    std::vector<TokenLogprob> pending_logprobs;
+    std::vector<size_t> pending_ends;
+    std::vector<TokenLogprob> ready_logprobs;
+    size_t text_bytes = 0;
+    size_t emitted_bytes = 0;
+
+    // Caller callbacks are timed separately so slow consumers are visible in profiles
+    auto emit = [&](const std::string& text) {
+        RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_CALLBACK);
+        emitted_bytes += text.size();
+        ready_logprobs.clear();
+        size_t ready = 0;
+        while (ready < pending_ends.size() && pending_ends[ready] <= emitted_bytes) {
+            ready_logprobs.push_back(std::move(pending_logprobs[ready]));
+            ++ready;
+        }
+        pending_logprobs.erase(pending_logprobs.begin(), pending_logprobs.begin() + ready);
+        pending_ends.erase(pending_ends.begin(), pending_ends.begin() + ready);
+        return callback(text, ready_logprobs);
+    };
+    TokenLogprob token_logprob;
+    uint64_t last_token_ns = rac::profiler::enabled() ? rac_profiler_now_ns() : 0;
+
     while (tokens_generated < effective_max_tokens && !cancel_requested_.load()) {
-        const llama_token new_token_id = llama_sampler_sample(sampler_, context_, -1);
+        llama_token new_token_id;
+        {
+            RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_SAMPLE);
+            new_token_id = want_logprobs ? sample_with_logprobs(request.top_logprobs, &token_logprob)
+                                         : llama_sampler_sample(sampler_, context_, -1);
+            llama_sampler_accept(sampler_, new_token_id);
+        }
 
-        llama_sampler_accept(sampler_, new_token_id);
+        if (out_timings && tokens_generated == 0) {
+            out_timings->ttft_ns = rac_profiler_now_ns() - request_start_ns;
+        }
 
-        if (llama_vocab_is_eog(vocab, new_token_id)) {
+        if (rac::profiler::enabled()) {
+            uint64_t now_ns = rac_profiler_now_ns();
+            if (last_token_ns != 0 && tokens_generated > 0) {
+                rac_profiler_record_itl(now_ns - last_token_ns);
+            }
+            last_token_ns = now_ns;
+        }
+
+        if (!request.ignore_eos && llama_vocab_is_eog(vocab, new_token_id)) {
             LOGI("End of generation token received");
             break;
         }
 
-        const std::string new_token_chars =
-            common_token_to_piece(context_, new_token_id);
-
-        partial_utf8_buffer.append(new_token_chars);
-
-        Utf8State scanner_state;
         size_t valid_upto = 0;
-        for (size_t i = 0; i < partial_utf8_buffer.size(); ++i) {
-            scanner_state.process(static_cast<uint8_t>(partial_utf8_buffer[i]));
-            if (scanner_state.state == 0) {
-                valid_upto = i + 1;
+        {
+            RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_DETOKENIZE);
+            const std::string piece = common_token_to_piece(context_, new_token_id);
+            partial_utf8_buffer.append(piece);
+            if (want_logprobs) {
+                text_bytes += piece.size();
+                pending_logprobs.push_back(std::move(token_logprob));
+                pending_ends.push_back(text_bytes);
+            }
+
+            Utf8State scanner_state;
+            for (size_t i = 0; i < partial_utf8_buffer.size(); ++i) {
+                scanner_state.process(static_cast<uint8_t>(partial_utf8_buffer[i]));
+                if (scanner_state.state == 0) {
+                    valid_upto = i + 1;
+                }
             }
         }
 
@@ -708,11 +941,11 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
                 }
             }
 
-            if (found_stop_pos != std::string::npos) {
+            if (found_stop_pos != std::string::npos && !request.ignore_eos) {
                 LOGI("Stop sequence detected");
                 stop_sequence_hit = true;
                 if (found_stop_pos > 0) {
-                    if (!callback(stop_window.substr(0, found_stop_pos))) {
+                    if (!emit(stop_window.substr(0, found_stop_pos))) {
                         cancel_requested_.store(true);
                     }
                 }
@@ -721,7 +954,7 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
 
             if (stop_window.size() > MAX_STOP_LEN) {
                 size_t safe_len = stop_window.size() - MAX_STOP_LEN;
-                if (!callback(stop_window.substr(0, safe_len))) {
+                if (!emit(stop_window.substr(0, safe_len))) {
                     LOGI("Generation cancelled by callback");
                     cancel_requested_.store(true);
                     break;
@@ -730,13 +963,49 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
             }
         }
 
+        // Window full: evict about half of the tokens after the pinned prefix
+        // and slide the rest down, keeping their KV entries. Whole earlier
+        // turns go first, cut at the turn end closest to half; without one
+        // the oldest tokens of the current turn and reply are evicted.
+        if (shift_enabled && n_cur >= n_ctx) {
+            int n_discard = (n_cur - n_keep) / 2;
+            if (!boundaries.empty()) {
+                auto cut = std::lower_bound(boundaries.begin(), boundaries.end(),
+                                            n_keep + n_discard);
+                if (cut == boundaries.end() ||
+                    (cut != boundaries.begin() &&
+                     n_keep + n_discard - *std::prev(cut) < *cut - (n_keep + n_discard))) {
+                    --cut;
+                }
+                n_discard = *cut - n_keep;
+                boundaries.erase(boundaries.begin(), std::next(cut));
+                for (int& boundary : boundaries) {
+                    boundary -= n_discard;
+                }
+            }
+            llama_memory_seq_rm(mem, 0, n_keep, n_keep + n_discard);
+            llama_memory_seq_add(mem, 0, n_keep + n_discard, n_cur, -n_discard);
+            n_cur -= n_discard;
+            LOGI("Context shift: discarded %d tokens, n_keep=%d, n_past=%d", n_discard, n_keep,
+                 n_cur);
+        }
+
         batch.n_tokens = 0;
         common_batch_add(batch, new_token_id, n_cur, {0}, true);
 
         n_cur++;
         tokens_generated++;
 
-        if (llama_decode(context_, batch) != 0) {
+        int decode_status;
+        {
+            RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_DECODE);
+            const uint64_t decode_start_ns = out_timings ? rac_profiler_now_ns() : 0;
+            decode_status = llama_decode(context_, batch);
+            if (out_timings) {
+                out_timings->decode_ns += rac_profiler_now_ns() - decode_start_ns;
+            }
+        }
+        if (decode_status != 0) {
             LOGE("llama_decode failed during generation");
             decode_failed_ = true;
             break;
@@ -744,7 +1013,7 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
     }
 
     if (!cancel_requested_.load() && !stop_sequence_hit && !stop_window.empty()) {
-        callback(stop_window);
+        emit(stop_window);
     }
 
     if (llama_memory_t post_mem = llama_get_memory(context_)) {
@@ -753,10 +1022,257 @@ bool LlamaCppTextGeneration::generate_stream(const TextGenerationRequest& reques
 
     llama_batch_free(batch);
 
+    if (out_timings) {
+        out_timings->generated_tokens = tokens_generated;
+        out_timings->total_ns = rac_profiler_now_ns() - request_start_ns;
+    }
+
     LOGI("Generation complete: %d tokens", tokens_generated);
     return !cancel_requested_.load();
 }
 
+// Log-probability of token under the model's distribution at batch row i
+static double token_logprob(llama_context* ctx, int32_t n_vocab, int32_t i, llama_token token) {
+    const float* logits = llama_get_logits_ith(ctx, i);
+    const float max_logit = *std::max_element(logits, logits + n_vocab);
+    double sum = 0.0;
+    for (int32_t v = 0; v < n_vocab; ++v) {
+        sum += std::exp(static_cast<double>(logits[v] - max_logit));
+    }
+    return static_cast<double>(logits[token] - max_logit) - std::log(sum);
+}
+
+std::vector<TextGenerationResult> LlamaCppTextGeneration::generate_choices(
+    const TextGenerationRequest& request, int* out_prompt_tokens) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::vector<TextGenerationResult> results;
+    if (!is_ready()) {
+        LOGE("Model not ready for generation");
+        return results;
+    }
+    if (!select_lora_adapters(request)) {
+        return results;
+    }
+
+    const int n = std::max(1, request.n);
+    const int n_candidates = std::max(n, request.best_of);
+    if (n_candidates > max_parallel_sequences_) {
+        LOGE("Requested %d candidates, context supports %d sequences", n_candidates,
+             max_parallel_sequences_);
+        return results;
+    }
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    llama_memory_t mem = llama_get_memory(context_);
+    if (mem) {
+        llama_memory_clear(mem, true);
+    }
+
+    cancel_requested_.store(false);
+    decode_failed_ = false;
+
+    std::vector<llama_token> tokens_list;
+    {
+        RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_TOKENIZE);
+        tokens_list = common_tokenize(context_, build_prompt(request), true, true);
+    }
+
+    const int n_ctx = llama_n_ctx(context_);
+    const int prompt_tokens = static_cast<int>(tokens_list.size());
+    if (out_prompt_tokens) {
+        *out_prompt_tokens = prompt_tokens;
+    }
+
+    // The prompt cells are shared; each candidate needs its own cells for its output
+    const int available_tokens = (n_ctx - prompt_tokens - 4) / n_candidates;
+    if (prompt_tokens == 0 || available_tokens <= 0) {
+        LOGE("Prompt too long: %d tokens, context size: %d, candidates: %d", prompt_tokens, n_ctx,
+             n_candidates);
+        return results;
+    }
+    const int effective_max_tokens = std::min(request.max_tokens, available_tokens);
+    LOGI("Generating %d choices (best of %d): prompt_tokens=%d, max_tokens=%d", n, n_candidates,
+         prompt_tokens, effective_max_tokens);
+
+    // Prefill the prompt once as sequence 0, then share its cells with the others
+    llama_batch batch = llama_batch_init(std::max(prompt_tokens, n_candidates), 0, 1);
+    for (size_t i = 0; i < tokens_list.size(); i++) {
+        common_batch_add(batch, tokens_list[i], i, {0}, false);
+    }
+    batch.logits[batch.n_tokens - 1] = true;
+
+    int prefill_status;
+    {
+        RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_PREFILL);
+        prefill_status = llama_decode(context_, batch);
+    }
+    if (prefill_status != 0) {
+        LOGE("llama_decode failed for prompt");
+        decode_failed_ = true;
+        llama_batch_free(batch);
+        return results;
+    }
+    for (int s = 1; s < n_candidates; ++s) {
+        llama_memory_seq_cp(mem, 0, s, -1, -1);
+    }
+
+    struct Candidate {
+        llama_sampler* sampler = nullptr;
+        TextGenerationResult result;
+        int32_t i_batch = 0;  // Batch row holding the next-token logits
+        llama_pos n_past = 0;
+        bool active = true;
+        int scored_tokens = 0;  // Tokens summed into result.logprob, EOS included
+    };
+
+    const auto vocab = llama_model_get_vocab(model_);
+    const int32_t n_vocab = llama_vocab_n_tokens(vocab);
+    const bool rank = n_candidates > n;
+
+    std::vector<Candidate> candidates(n_candidates);
+    for (int s = 0; s < n_candidates; ++s) {
+        // Distinct but reproducible streams when the caller fixes the seed
+        const uint32_t seed = request.seed == LLAMA_DEFAULT_SEED
+                                  ? LLAMA_DEFAULT_SEED
+                                  : request.seed + static_cast<uint32_t>(s);
+        candidates[s].sampler = create_sampler(request, seed);
+        candidates[s].i_batch = batch.n_tokens - 1;
+        candidates[s].n_past = prompt_tokens;
+        candidates[s].result.prompt_tokens = prompt_tokens;
+    }
+
+    int active = n_candidates;
+    auto finish = [&active](Candidate& c, const char* reason) {
+        c.active = false;
+        c.result.finish_reason = reason;
+        --active;
+    };
+
+    while (active > 0) {
+        if (cancel_requested_.load()) {
+            for (auto& c : candidates) {
+                if (c.active) {
+                    finish(c, "cancelled");
+                }
+            }
+            break;
+        }
+
+        // Sample every live candidate, then decode all their tokens in one call
+        batch.n_tokens = 0;
+        for (int s = 0; s < n_candidates; ++s) {
+            Candidate& c = candidates[s];
+            if (!c.active) {
+                continue;
+            }
+
+            llama_token token;
+            {
+                RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_SAMPLE);
+                token = llama_sampler_sample(c.sampler, context_, c.i_batch);
+            }
+            if (rank) {
+                c.result.logprob += token_logprob(context_, n_vocab, c.i_batch, token);
+                c.scored_tokens++;
+            }
+
+            if (!request.ignore_eos && llama_vocab_is_eog(vocab, token)) {
+                finish(c, "stop");
+                continue;
+            }
+
+            const std::string piece = common_token_to_piece(context_, token);
+            std::string& text = c.result.text;
+            text += piece;
+            c.result.tokens_generated++;
+
+            if (!request.ignore_eos) {
+                const size_t tail = MAX_STOP_LEN + piece.size();
+                const size_t from = text.size() > tail ? text.size() - tail : 0;
+                size_t found_stop_pos = std::string::npos;
+                for (const auto& stop_seq : STOP_SEQUENCES) {
+                    found_stop_pos = std::min(found_stop_pos, text.find(stop_seq, from));
+                }
+                if (found_stop_pos != std::string::npos) {
+                    text.resize(found_stop_pos);
+                    finish(c, "stop");
+                    continue;
+                }
+            }
+
+            if (c.result.tokens_generated >= effective_max_tokens) {
+                finish(c, "length");
+                continue;
+            }
+
+            c.i_batch = batch.n_tokens;
+            common_batch_add(batch, token, c.n_past++, {s}, true);
+        }
+
+        if (batch.n_tokens == 0) {
+            break;
+        }
+
+        int decode_status;
+        {
+            RAC_PROFILE_PHASE(RAC_PROFILER_PHASE_DECODE);
+            decode_status = llama_decode(context_, batch);
+        }
+        if (decode_status != 0) {
+            LOGE("llama_decode failed during generation");
+            decode_failed_ = true;
+            for (auto& c : candidates) {
+                if (c.active) {
+                    finish(c, "error");
+                }
+            }
+            break;
+        }
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    const double elapsed_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(end_time - start_time).count();
+
+    results.reserve(candidates.size());
+    for (auto& c : candidates) {
+        llama_sampler_free(c.sampler);
+
+        // Drop a multi-byte character cut off by the token limit
+        size_t valid_upto = 0;
+        Utf8State scanner_state;
+        for (size_t i = 0; i < c.result.text.size(); ++i) {
+            scanner_state.process(static_cast<uint8_t>(c.result.text[i]));
+            if (scanner_state.state == 0) {
+                valid_upto = i + 1;
+            }
+        }
+        c.result.text.resize(valid_upto);
+        c.result.inference_time_ms = elapsed_ms;
+        // Rank by the mean, as OpenAI's best_of does: a sum favours the shortest completion
+        c.result.logprob /= std::max(1, c.scored_tokens);
+        results.push_back(std::move(c.result));
+    }
+
+    llama_batch_free(batch);
+    if (mem) {
+        llama_memory_clear(mem, true);
+    }
+
+    if (rank) {
+        std::stable_sort(results.begin(), results.end(),
+                         [](const TextGenerationResult& a, const TextGenerationResult& b) {
+                             return a.logprob > b.logprob;
+                         });
+        results.resize(n);
+    }
+
+    LOGI("Generated %d choices from %d candidates in %.0f ms", n, n_candidates, elapsed_ms);
+    return results;
+}
+
 void LlamaCppTextGeneration::cancel() {
     cancel_requested_.store(true);
     LOGI("Generation cancel requested");
@@ -788,56 +1304,52 @@ nlohmann::json LlamaCppTextGeneration::get_model_info() const {
 // LORA ADAPTER MANAGEMENT
 // =============================================================================
 
-bool LlamaCppTextGeneration::recreate_context() {
-    LOGI("Recreating context to accommodate LoRA adapters");
-
-    // Free existing sampler and context
-    if (sampler_) {
-        llama_sampler_free(sampler_);
-        sampler_ = nullptr;
-    }
+LoraAdapterEntry* LlamaCppTextGeneration::find_lora_adapter(const std::string& adapter_path) {
+    auto it = std::find_if(lora_adapters_.begin(), lora_adapters_.end(),
+                           [&adapter_path](const LoraAdapterEntry& e) { return e.path == adapter_path; });
+    return it == lora_adapters_.end() ? nullptr : &*it;
+}
 
-    if (context_) {
-        llama_free(context_);
-        context_ = nullptr;
+bool LlamaCppTextGeneration::select_lora_adapters(const TextGenerationRequest& request) {
+    std::vector<std::pair<llama_adapter_lora*, float>> wanted;
+    if (request.lora_adapters) {
+        for (const auto& selection : *request.lora_adapters) {
+            LoraAdapterEntry* entry = find_lora_adapter(selection.path);
+            if (!entry) {
+                LOGE("LoRA adapter not loaded: %s", selection.path.c_str());
+                return false;
+            }
+            if (selection.scale != 0.0f) {
+                wanted.emplace_back(entry->adapter, selection.scale);
+            }
+        }
+    } else {
+        for (const auto& entry : lora_adapters_) {
+            if (entry.applied) {
+                wanted.emplace_back(entry.adapter, entry.scale);
+            }
+        }
     }
 
-    // Create new context (adapters are now visible to it)
-    llama_context_params ctx_params = llama_context_default_params();
-    ctx_params.n_ctx = context_size_;
-    ctx_params.n_batch = context_size_;
-    ctx_params.n_ubatch = context_size_;
-    ctx_params.n_threads = backend_->get_num_threads();
-    ctx_params.n_threads_batch = backend_->get_num_threads();
-    ctx_params.no_perf = true;
-
-    context_ = llama_init_from_model(model_, ctx_params);
-    if (!context_) {
-        LOGE("Failed to recreate context after LoRA adapter load");
-        return false;
+    if (wanted == active_lora_) {
+        return true;
     }
 
-    // Rebuild sampler chain
-    auto sparams = llama_sampler_chain_default_params();
-    sparams.no_perf = true;
-    sampler_ = llama_sampler_chain_init(sparams);
-    llama_sampler_chain_add(sampler_, llama_sampler_init_greedy());
-
-    LOGI("Context recreated successfully");
-    return true;
-}
-
-bool LlamaCppTextGeneration::apply_lora_adapters() {
-    for (auto& entry : lora_adapters_) {
-        int32_t result = llama_set_adapter_lora(context_, entry.adapter, entry.scale);
+    // Adapter scales are read when the compute graph is built, so switching
+    // only updates the context's adapter table. The KV cache is cleared at the
+    // start of every request anyway, so nothing computed with other adapters
+    // is reused.
+    llama_clear_adapter_lora(context_);
+    active_lora_.clear();
+    for (const auto& [adapter, scale] : wanted) {
+        int32_t result = llama_set_adapter_lora(context_, adapter, scale);
         if (result != 0) {
-            LOGE("Failed to apply LoRA adapter: %s (error=%d)", entry.path.c_str(), result);
-            entry.applied = false;
+            LOGE("Failed to apply LoRA adapter (error=%d)", result);
             return false;
         }
-        entry.applied = true;
-        LOGI("Applied LoRA adapter: %s (scale=%.2f)", entry.path.c_str(), entry.scale);
+        active_lora_.emplace_back(adapter, scale);
     }
+    LOGI("LoRA selection changed: %zu adapter(s) active", active_lora_.size());
     return true;
 }
 
@@ -850,48 +1362,62 @@ bool LlamaCppTextGeneration::load_lora_adapter(const std::string& adapter_path,
     }
 
     // Check if adapter already loaded
-    for (const auto& entry : lora_adapters_) {
-        if (entry.path == adapter_path) {
-            LOGE("LoRA adapter already loaded: %s", adapter_path.c_str());
+    LoraAdapterEntry* entry = find_lora_adapter(adapter_path);
+    if (entry && entry->applied) {
+        LOGE("LoRA adapter already loaded: %s", adapter_path.c_str());
+        return false;
+    }
+
+    if (!entry) {
+        LOGI("Loading LoRA adapter: %s (scale=%.2f)", adapter_path.c_str(), scale);
+
+        // Load adapter against model
+        llama_adapter_lora* adapter = llama_adapter_lora_init(model_, adapter_path.c_str());
+        if (!adapter) {
+            LOGE("Failed to load LoRA adapter from: %s", adapter_path.c_str());
             return false;
         }
+
+        LoraAdapterEntry new_entry;
+        new_entry.adapter = adapter;
+        new_entry.path = adapter_path;
+        lora_adapters_.push_back(std::move(new_entry));
+        entry = &lora_adapters_.back();
     }
 
-    LOGI("Loading LoRA adapter: %s (scale=%.2f)", adapter_path.c_str(), scale);
+    // Joins the default set; the live context picks it up on the next request
+    entry->scale = scale;
+    entry->applied = true;
+
+    LOGI("LoRA adapter loaded: %s (%zu total adapters)", adapter_path.c_str(),
+         lora_adapters_.size());
+    return true;
+}
+
+bool LlamaCppTextGeneration::pool_lora_adapter(const std::string& adapter_path) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!model_loaded_ || !model_) {
+        LOGE("Cannot load LoRA adapter: model not loaded");
+        return false;
+    }
+    if (find_lora_adapter(adapter_path)) {
+        return true;
+    }
 
-    // Load adapter against model
     llama_adapter_lora* adapter = llama_adapter_lora_init(model_, adapter_path.c_str());
     if (!adapter) {
         LOGE("Failed to load LoRA adapter from: %s", adapter_path.c_str());
         return false;
     }
 
-    // Store adapter entry
     LoraAdapterEntry entry;
     entry.adapter = adapter;
     entry.path = adapter_path;
-    entry.scale = scale;
-    entry.applied = false;
     lora_adapters_.push_back(std::move(entry));
 
-    // Recreate context so the new adapter is visible
-    if (!recreate_context()) {
-        // Remove the adapter entry we just added on failure
-        lora_adapters_.pop_back();
-        return false;
-    }
-
-    // Apply all loaded adapters to the new context
-    if (!apply_lora_adapters()) {
-        lora_adapters_.pop_back();
-        return false;
-    }
-
-    // Clear KV cache after adapter changes
-    llama_memory_clear(llama_get_memory(context_), true);
-
-    LOGI("LoRA adapter loaded and applied: %s (%zu total adapters)",
-         adapter_path.c_str(), lora_adapters_.size());
+    LOGI("LoRA adapter added to pool: %s (%zu total adapters)", adapter_path.c_str(),
+         lora_adapters_.size());
     return true;
 }
 
@@ -911,20 +1437,22 @@ bool LlamaCppTextGeneration::remove_lora_adapter(const std::string& adapter_path
         return false;
     }
 
-    // Remove from context
-    int32_t result = llama_rm_adapter_lora(context_, it->adapter);
-    if (result != 0) {
-        LOGE("Failed to remove LoRA adapter from context: %s (error=%d)", adapter_path.c_str(), result);
-        return false;
+    // Remove from context if the current selection uses it
+    auto active = std::find_if(active_lora_.begin(), active_lora_.end(),
+                               [&it](const auto& a) { return a.first == it->adapter; });
+    if (active != active_lora_.end()) {
+        int32_t result = llama_rm_adapter_lora(context_, it->adapter);
+        if (result != 0) {
+            LOGE("Failed to remove LoRA adapter from context: %s (error=%d)", adapter_path.c_str(), result);
+            return false;
+        }
+        active_lora_.erase(active);
     }
 
     // Remove from tracking (adapter memory is freed automatically with the model
     // per llama.cpp API — llama_adapter_lora_free is deprecated since b8011)
     lora_adapters_.erase(it);
 
-    // Clear KV cache after adapter changes
-    llama_memory_clear(llama_get_memory(context_), true);
-
     LOGI("LoRA adapter removed: %s (%zu remaining)", adapter_path.c_str(), lora_adapters_.size());
     return true;
 }
@@ -938,9 +1466,9 @@ void LlamaCppTextGeneration::clear_lora_adapters() {
 
     if (context_) {
         llama_clear_adapter_lora(context_);
-        llama_memory_clear(llama_get_memory(context_), true);
     }
 
+    active_lora_.clear();
     lora_adapters_.clear();
     LOGI("All LoRA adapters cleared");
 }
@@ -954,6 +1482,9 @@ nlohmann::json LlamaCppTextGeneration::get_lora_info() const {
         adapter_info["path"] = entry.path;
         adapter_info["scale"] = entry.scale;
         adapter_info["applied"] = entry.applied;
+        adapter_info["active"] =
+            std::any_of(active_lora_.begin(), active_lora_.end(),
+                        [&entry](const auto& a) { return a.first == entry.adapter; });
         adapters.push_back(adapter_info);
     }
     return adapters;
@@ -13,6 +13,7 @@
 #include <atomic>
 #include <functional>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -36,6 +37,12 @@ enum class DeviceType {
 // TEXT GENERATION TYPES (internal use only)
 // =============================================================================
 
+// Adapter from the LoRA pool and the scale to apply it with
+struct LoraSelection {
+    std::string path;
+    float scale = 1.0f;
+};
+
 struct TextGenerationRequest {
     std::string prompt;
     std::string system_prompt;
@@ -46,6 +53,25 @@ struct TextGenerationRequest {
     int top_k = 40;
     float repetition_penalty = 1.1f;
     std::vector<std::string> stop_sequences;
+    uint32_t seed = LLAMA_DEFAULT_SEED;  // Sampling seed (only used when temperature > 0)
+    bool ignore_eos = false;             // Keep decoding past EOG/stop sequences (benchmarks)
+    int n = 1;                           // Completions returned by generate_choices
+    int best_of = 0;                     // Candidates sampled by generate_choices (0 = n)
+    // Adapters for this request, applied to the live context; nullopt uses the
+    // adapters loaded with load_lora_adapter, an empty list the base model
+    std::optional<std::vector<LoraSelection>> lora_adapters;
+    int top_logprobs = -1;               // Alternatives per token for generate_stream_with_logprobs
+                                         // (-1 = no logprobs, 0 = sampled token only)
+};
+
+// Per-request wall-clock breakdown, filled by generate_stream when requested
+struct GenerationTimings {
+    int prompt_tokens = 0;
+    int generated_tokens = 0;
+    uint64_t prefill_ns = 0;  // Prompt decode
+    uint64_t decode_ns = 0;   // Sum of single-token decode steps
+    uint64_t ttft_ns = 0;     // Request start to first sampled token
+    uint64_t total_ns = 0;
 };
 
 struct TextGenerationResult {
@@ -54,11 +80,30 @@ struct TextGenerationResult {
     int prompt_tokens = 0;
     double inference_time_ms = 0.0;
     std::string finish_reason;  // "stop", "length", "cancelled"
+    double logprob = 0.0;       // Mean sampled-token log-probability (generate_choices, best_of > n)
 };
 
 // Streaming callback: receives token, returns false to cancel
 using TextStreamCallback = std::function<bool(const std::string& token)>;
 
+// Log-probability of one token under the model's (pre-sampling) distribution
+struct TokenAlternative {
+    std::string token;
+    float logprob = 0.0f;
+};
+
+struct TokenLogprob {
+    std::string token;
+    float logprob = 0.0f;
+    std::vector<TokenAlternative> top_logprobs;  // Most likely tokens, highest first
+};
+
+// Streaming callback that also receives the tokens making up this piece of text.
+// Tokens whose text has not been emitted yet (held back for stop sequence or
+// UTF-8 boundaries) arrive with a later piece.
+using TextLogprobStreamCallback =
+    std::function<bool(const std::string& text, const std::vector<TokenLogprob>& logprobs)>;
+
 // =============================================================================
 // FORWARD DECLARATIONS
 // =============================================================================
@@ -110,7 +155,7 @@ struct LoraAdapterEntry {
     llama_adapter_lora* adapter = nullptr;
     std::string path;
     float scale = 1.0f;
-    bool applied = false;
+    bool applied = false;  // Part of the default set used by requests without a selection
 };
 
 // =============================================================================
@@ -132,20 +177,44 @@ class LlamaCppTextGeneration {
         return generate_stream(request, callback, nullptr);
     }
     bool generate_stream(const TextGenerationRequest& request, TextStreamCallback callback,
-                         int* out_prompt_tokens);
+                         int* out_prompt_tokens, GenerationTimings* out_timings = nullptr);
+    // Like generate_stream, with per-token logprobs and request.top_logprobs
+    // alternatives taken from the logits row the sampler already reads
+    bool generate_stream_with_logprobs(const TextGenerationRequest& request,
+                                       TextLogprobStreamCallback callback,
+                                       int* out_prompt_tokens = nullptr);
+    // Sample request.best_of completions from one prompt prefill and return the
+    // request.n with the highest log-probability per token (all of them when best_of <= n).
+    // Candidates share the prompt KV cells and decode together in one batch per step.
+    std::vector<TextGenerationResult> generate_choices(const TextGenerationRequest& request,
+                                                       int* out_prompt_tokens = nullptr);
+    int max_parallel_sequences() const { return max_parallel_sequences_; }
     void cancel();
     nlohmann::json get_model_info() const;
 
     // LoRA adapter management
     bool load_lora_adapter(const std::string& adapter_path, float scale);
+    // Load into the pool without adding it to the default set, for
+    // per-request selection (no-op if already loaded)
+    bool pool_lora_adapter(const std::string& adapter_path);
     bool remove_lora_adapter(const std::string& adapter_path);
     void clear_lora_adapters();
     nlohmann::json get_lora_info() const;
 
    private:
     bool unload_model_internal();
-    bool recreate_context();
-    bool apply_lora_adapters();
+    llama_context_params make_context_params() const;
+    llama_sampler* create_sampler(const TextGenerationRequest& request, uint32_t seed) const;
+    bool run_generation(const TextGenerationRequest& request,
+                        const TextLogprobStreamCallback& callback, int* out_prompt_tokens,
+                        GenerationTimings* out_timings);
+    llama_token sample_with_logprobs(int top_n, TokenLogprob* out);
+    int pinned_prefix_tokens(const TextGenerationRequest& request,
+                             const std::vector<llama_token>& prompt_tokens);
+    std::vector<int> turn_boundaries(const TextGenerationRequest& request,
+                                     const std::vector<llama_token>& prompt_tokens, int n_keep);
+    bool select_lora_adapters(const TextGenerationRequest& request);
+    LoraAdapterEntry* find_lora_adapter(const std::string& adapter_path);
     std::string build_prompt(const TextGenerationRequest& request);
     std::string apply_chat_template(const std::vector<std::pair<std::string, std::string>>& messages,
                                     const std::string& system_prompt, bool add_assistant_token);
@@ -154,6 +223,7 @@ class LlamaCppTextGeneration {
     llama_model* model_ = nullptr;
     llama_context* context_ = nullptr;
     llama_sampler* sampler_ = nullptr;
+    std::vector<llama_token_data> candidates_;  // Reused by sample_with_logprobs
 
     bool model_loaded_ = false;
     std::atomic<bool> cancel_requested_{false};
@@ -164,8 +234,13 @@ class LlamaCppTextGeneration {
 
     int context_size_ = 0;
     int max_default_context_ = 8192;
+    int max_parallel_sequences_ = 8;  // Upper bound for generate_choices candidates
+    bool context_shift_ = false;      // Slide the window instead of failing at n_ctx
+    int n_keep_ = 0;                  // Tokens pinned when shifting (0 = system prompt)
 
     std::vector<LoraAdapterEntry> lora_adapters_;
+    // Adapters and scales currently set on context_
+    std::vector<std::pair<llama_adapter_lora*, float>> active_lora_;
 
     mutable std::mutex mutex_;
 };
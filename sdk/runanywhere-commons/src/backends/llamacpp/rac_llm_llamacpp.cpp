@@ -8,10 +8,13 @@
 
 #include "rac_llm_llamacpp.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
+#include <vector>
 
 #include "llamacpp_backend.h"
 
@@ -28,8 +31,11 @@
 
 // Internal handle - wraps C++ objects directly (no intermediate ra_* layer)
 struct rac_llm_llamacpp_handle_impl {
-    std::unique_ptr<runanywhere::LlamaCppBackend> backend;
+    std::unique_ptr<runanywhere::LlamaCppBackend> backend;  // Null for LoRA views
     runanywhere::LlamaCppTextGeneration* text_gen;  // Owned by backend
+    // Adapter set applied to every request made through this handle
+    // (nullopt = the adapters loaded with rac_llm_llamacpp_load_lora)
+    std::optional<std::vector<runanywhere::LoraSelection>> lora;
 
     rac_llm_llamacpp_handle_impl() : backend(nullptr), text_gen(nullptr) {}
 };
@@ -89,6 +95,12 @@ rac_result_t rac_llm_llamacpp_create(const char* model_path,
         if (config->batch_size > 0) {
             model_config["batch_size"] = config->batch_size;
         }
+        if (config->context_shift == RAC_TRUE) {
+            model_config["context_shift"] = true;
+        }
+        if (config->keep_tokens > 0) {
+            model_config["n_keep"] = config->keep_tokens;
+        }
     }
 
     // Load model
@@ -161,6 +173,7 @@ rac_result_t rac_llm_llamacpp_generate(rac_handle_t handle, const char* prompt,
     RAC_LOG_INFO("LLM.LlamaCpp", "rac_llm_llamacpp_generate: building request, prompt_len=%zu", strlen(prompt));
     runanywhere::TextGenerationRequest request;
     request.prompt = prompt;
+    request.lora_adapters = h->lora;
     if (options != nullptr) {
         request.max_tokens = options->max_tokens;
         request.temperature = options->temperature;
@@ -233,6 +246,171 @@ rac_result_t rac_llm_llamacpp_generate(rac_handle_t handle, const char* prompt,
     return RAC_SUCCESS;
 }
 
+rac_result_t rac_llm_llamacpp_generate_stream_logprobs(
+    rac_handle_t handle, const char* prompt, const rac_llm_options_t* options,
+    int32_t top_logprobs, rac_llm_llamacpp_logprob_stream_callback_fn callback, void* user_data) {
+    if (handle == nullptr || prompt == nullptr || callback == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    if (top_logprobs < 0 || top_logprobs > RAC_LLM_LLAMACPP_MAX_TOP_LOGPROBS) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    auto* h = static_cast<rac_llm_llamacpp_handle_impl*>(handle);
+    if (!h->text_gen) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    runanywhere::TextGenerationRequest request;
+    request.prompt = prompt;
+    request.lora_adapters = h->lora;
+    request.top_logprobs = top_logprobs;
+    if (options != nullptr) {
+        request.max_tokens = options->max_tokens;
+        request.temperature = options->temperature;
+        request.top_p = options->top_p;
+        if (options->system_prompt != nullptr) {
+            request.system_prompt = options->system_prompt;
+        }
+    }
+
+    // Flattened views of the C++ logprobs, rebuilt for each piece
+    std::vector<rac_llm_llamacpp_token_logprob_t> entries;
+    std::vector<rac_llm_llamacpp_top_logprob_t> alternatives;
+    auto on_text = [&](const std::string& text,
+                       const std::vector<runanywhere::TokenLogprob>& logprobs) -> bool {
+        entries.clear();
+        alternatives.clear();
+        for (const auto& logprob : logprobs) {
+            for (const auto& alternative : logprob.top_logprobs) {
+                alternatives.push_back({alternative.token.c_str(), alternative.logprob});
+            }
+        }
+        size_t offset = 0;
+        for (const auto& logprob : logprobs) {
+            const int32_t count = static_cast<int32_t>(logprob.top_logprobs.size());
+            entries.push_back({logprob.token.c_str(), logprob.logprob,
+                               count > 0 ? alternatives.data() + offset : nullptr, count});
+            offset += count;
+        }
+        return callback(text.c_str(), entries.data(), static_cast<int32_t>(entries.size()),
+                        RAC_FALSE, user_data) == RAC_TRUE;
+    };
+
+    // See generate for rationale on try-catch
+    bool success = false;
+    try {
+        success = h->text_gen->generate_stream_with_logprobs(request, on_text);
+    } catch (const std::exception& e) {
+        rac_error_set_details(e.what());
+        return RAC_ERROR_INFERENCE_FAILED;
+    } catch (...) {
+        rac_error_set_details("Unknown C++ exception during streaming LLM generation");
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+
+    if (success) {
+        callback("", nullptr, 0, RAC_TRUE, user_data);  // Final token
+    }
+
+    return success ? RAC_SUCCESS : RAC_ERROR_INFERENCE_FAILED;
+}
+
+rac_result_t rac_llm_llamacpp_generate_choices(rac_handle_t handle, const char* prompt,
+                                               const rac_llm_options_t* options, int32_t n,
+                                               int32_t best_of,
+                                               rac_llm_llamacpp_choice_t** out_choices,
+                                               int32_t* out_num_choices,
+                                               int32_t* out_prompt_tokens) {
+    if (handle == nullptr || prompt == nullptr || out_choices == nullptr ||
+        out_num_choices == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_llm_llamacpp_handle_impl*>(handle);
+    if (!h->text_gen) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    if (n < 1 || (best_of != 0 && best_of < n)) {
+        rac_error_set_details("n must be >= 1 and best_of must be 0 or >= n");
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    if (std::max(n, best_of) > h->text_gen->max_parallel_sequences()) {
+        rac_error_set_details("Requested candidates exceed max_parallel_sequences");
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    runanywhere::TextGenerationRequest request;
+    request.prompt = prompt;
+    request.lora_adapters = h->lora;
+    request.n = n;
+    request.best_of = best_of;
+    if (options != nullptr) {
+        request.max_tokens = options->max_tokens;
+        request.temperature = options->temperature;
+        request.top_p = options->top_p;
+        if (options->system_prompt != nullptr) {
+            request.system_prompt = options->system_prompt;
+        }
+    }
+
+    std::vector<runanywhere::TextGenerationResult> results;
+    int prompt_tokens = 0;
+    try {
+        results = h->text_gen->generate_choices(request, &prompt_tokens);
+    } catch (const std::exception& e) {
+        rac_error_set_details(e.what());
+        return RAC_ERROR_INFERENCE_FAILED;
+    } catch (...) {
+        rac_error_set_details("Unknown C++ exception during LLM generation");
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+
+    if (results.empty()) {
+        rac_error_set_details("Generation failed: prompt too long or model not ready");
+        return RAC_ERROR_GENERATION_FAILED;
+    }
+    for (const auto& result : results) {
+        if (result.finish_reason == "error") {
+            rac_error_set_details("Generation failed: llama_decode returned non-zero");
+            return RAC_ERROR_GENERATION_FAILED;
+        }
+    }
+
+    auto* choices = static_cast<rac_llm_llamacpp_choice_t*>(
+        calloc(results.size(), sizeof(rac_llm_llamacpp_choice_t)));
+    if (!choices) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    for (size_t i = 0; i < results.size(); ++i) {
+        choices[i].text = strdup(results[i].text.c_str());
+        choices[i].completion_tokens = results[i].tokens_generated;
+        choices[i].length_limited = results[i].finish_reason == "length" ? RAC_TRUE : RAC_FALSE;
+        choices[i].logprob = static_cast<float>(results[i].logprob);
+    }
+
+    *out_choices = choices;
+    *out_num_choices = static_cast<int32_t>(results.size());
+    if (out_prompt_tokens) {
+        *out_prompt_tokens = prompt_tokens;
+    }
+
+    rac_event_track("llm.generation.completed", RAC_EVENT_CATEGORY_LLM, RAC_EVENT_DESTINATION_ALL,
+                    nullptr);
+    return RAC_SUCCESS;
+}
+
+void rac_llm_llamacpp_free_choices(rac_llm_llamacpp_choice_t* choices, int32_t num_choices) {
+    if (!choices) {
+        return;
+    }
+    for (int32_t i = 0; i < num_choices; ++i) {
+        free(choices[i].text);
+    }
+    free(choices);
+}
+
 rac_result_t rac_llm_llamacpp_generate_stream(rac_handle_t handle, const char* prompt,
                                               const rac_llm_options_t* options,
                                               rac_llm_llamacpp_stream_callback_fn callback,
@@ -248,6 +426,7 @@ rac_result_t rac_llm_llamacpp_generate_stream(rac_handle_t handle, const char* p
 
     runanywhere::TextGenerationRequest request;
     request.prompt = prompt;
+    request.lora_adapters = h->lora;
     if (options != nullptr) {
         request.max_tokens = options->max_tokens;
         request.temperature = options->temperature;
@@ -353,6 +532,42 @@ rac_result_t rac_llm_llamacpp_load_lora(rac_handle_t handle,
     return RAC_SUCCESS;
 }
 
+rac_result_t rac_llm_llamacpp_create_lora_view(rac_handle_t handle,
+                                               const rac_llm_llamacpp_lora_t* adapters,
+                                               int32_t num_adapters, rac_handle_t* out_handle) {
+    if (handle == nullptr || out_handle == nullptr || (adapters == nullptr && num_adapters > 0)) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    auto* h = static_cast<rac_llm_llamacpp_handle_impl*>(handle);
+    if (!h->text_gen) {
+        return RAC_ERROR_INVALID_HANDLE;
+    }
+
+    std::vector<runanywhere::LoraSelection> selection;
+    for (int32_t i = 0; i < num_adapters; ++i) {
+        if (adapters[i].adapter_path == nullptr) {
+            return RAC_ERROR_NULL_POINTER;
+        }
+        // Each adapter is loaded into the shared pool once
+        if (!h->text_gen->pool_lora_adapter(adapters[i].adapter_path)) {
+            rac_error_set_details("Failed to load LoRA adapter");
+            return RAC_ERROR_MODEL_LOAD_FAILED;
+        }
+        selection.push_back({adapters[i].adapter_path, adapters[i].scale});
+    }
+
+    auto* view = new (std::nothrow) rac_llm_llamacpp_handle_impl();
+    if (!view) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    view->text_gen = h->text_gen;
+    view->lora = std::move(selection);
+
+    *out_handle = static_cast<rac_handle_t>(view);
+    return RAC_SUCCESS;
+}
+
 rac_result_t rac_llm_llamacpp_remove_lora(rac_handle_t handle,
                                            const char* adapter_path) {
     if (handle == nullptr || adapter_path == nullptr) {
@@ -408,12 +623,15 @@ void rac_llm_llamacpp_destroy(rac_handle_t handle) {
     }
 
     auto* h = static_cast<rac_llm_llamacpp_handle_impl*>(handle);
+    if (!h->backend) {
+        // LoRA view: the model belongs to the handle it was created from
+        delete h;
+        return;
+    }
     if (h->text_gen) {
         h->text_gen->unload_model();
     }
-    if (h->backend) {
-        h->backend->cleanup();
-    }
+    h->backend->cleanup();
     delete h;
 
     rac_event_track("llm.backend.destroyed", RAC_EVENT_CATEGORY_LLM, RAC_EVENT_DESTINATION_ALL,
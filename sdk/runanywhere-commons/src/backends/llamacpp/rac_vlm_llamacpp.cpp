@@ -30,6 +30,7 @@
 #endif
 
 #include "rac/core/rac_logger.h"
+#include "rac/utils/rac_base64.h"
 #include "rac/utils/rac_image_utils.h"
 
 static const char* LOG_CAT = "VLM.LlamaCPP";
@@ -310,6 +311,34 @@ void configure_sampler(LlamaCppVLMBackend* backend, const rac_vlm_options_t* opt
     RAC_LOG_DEBUG(LOG_CAT, "Sampler configured: temp=%.2f, top_p=%.2f", temperature, top_p);
 }
 
+#ifdef RAC_VLM_USE_MTMD
+/**
+ * Load a request image into an mtmd bitmap (nullptr on failure).
+ */
+mtmd_bitmap* load_image_bitmap(mtmd_context* mtmd_ctx, const rac_vlm_image_t* image) {
+    if (image->format == RAC_VLM_IMAGE_FORMAT_FILE_PATH && image->file_path) {
+        return mtmd_helper_bitmap_init_from_file(mtmd_ctx, image->file_path);
+    }
+    if (image->format == RAC_VLM_IMAGE_FORMAT_RGB_PIXELS && image->pixel_data) {
+        return mtmd_bitmap_init(image->width, image->height, image->pixel_data);
+    }
+    if (image->format == RAC_VLM_IMAGE_FORMAT_BASE64 && image->base64_data) {
+        // Encoded JPEG/PNG bytes; mtmd decodes them like a file
+        const size_t text_size =
+            image->data_size > 0 ? image->data_size : std::strlen(image->base64_data);
+        std::vector<uint8_t> image_bytes(rac_base64_decoded_max_size(text_size));
+        size_t image_size = 0;
+        if (rac_base64_decode(image->base64_data, text_size, image_bytes.data(),
+                              image_bytes.size(), &image_size) != RAC_SUCCESS) {
+            RAC_LOG_ERROR(LOG_CAT, "Invalid base64 image data");
+            return nullptr;
+        }
+        return mtmd_helper_bitmap_init_from_buf(mtmd_ctx, image_bytes.data(), image_size);
+    }
+    return nullptr;
+}
+#endif
+
 }  // namespace
 
 // =============================================================================
@@ -533,19 +562,10 @@ rac_result_t rac_vlm_llamacpp_process(rac_handle_t handle, const rac_vlm_image_t
     mtmd_bitmap* bitmap = nullptr;
 
     if (image && backend->mtmd_ctx) {
-        // Load image based on format
-        if (image->format == RAC_VLM_IMAGE_FORMAT_FILE_PATH && image->file_path) {
-            bitmap = mtmd_helper_bitmap_init_from_file(backend->mtmd_ctx, image->file_path);
-        } else if (image->format == RAC_VLM_IMAGE_FORMAT_RGB_PIXELS && image->pixel_data) {
-            bitmap = mtmd_bitmap_init(image->width, image->height, image->pixel_data);
-        } else if (image->format == RAC_VLM_IMAGE_FORMAT_BASE64 && image->base64_data) {
-            // Decode base64 first
-            // For now, skip base64 - would need base64 decoder
-            RAC_LOG_WARNING(LOG_CAT, "Base64 image format not yet supported, using text-only");
-        }
+        bitmap = load_image_bitmap(backend->mtmd_ctx, image);
 
         has_image = (bitmap != nullptr);
-        if (!has_image && image->format != RAC_VLM_IMAGE_FORMAT_BASE64) {
+        if (!has_image) {
             RAC_LOG_ERROR(LOG_CAT, "Failed to load image");
             return RAC_ERROR_INVALID_INPUT;
         }
@@ -719,12 +739,7 @@ rac_result_t rac_vlm_llamacpp_process_stream(rac_handle_t handle, const rac_vlm_
     mtmd_bitmap* bitmap = nullptr;
 
     if (image && backend->mtmd_ctx) {
-        // Load image based on format
-        if (image->format == RAC_VLM_IMAGE_FORMAT_FILE_PATH && image->file_path) {
-            bitmap = mtmd_helper_bitmap_init_from_file(backend->mtmd_ctx, image->file_path);
-        } else if (image->format == RAC_VLM_IMAGE_FORMAT_RGB_PIXELS && image->pixel_data) {
-            bitmap = mtmd_bitmap_init(image->width, image->height, image->pixel_data);
-        }
+        bitmap = load_image_bitmap(backend->mtmd_ctx, image);
 
         has_image = (bitmap != nullptr);
         if (!has_image) {
@@ -0,0 +1,267 @@
+#include "clip_tokenizer.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <climits>
+#include <fstream>
+#include <sstream>
+
+namespace runanywhere {
+namespace diffusion {
+
+namespace {
+
+const char* const kEndOfWord = "</w>";
+
+bool read_file(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Length of the UTF-8 sequence starting with lead byte c (1 for invalid bytes)
+size_t utf8_length(unsigned char c) {
+    if (c >= 0xF0 && c < 0xF8) return 4;
+    if (c >= 0xE0) return c < 0xF0 ? 3 : 1;
+    if (c >= 0xC0) return 2;
+    return 1;
+}
+
+enum class CharClass { SPACE, LETTER, DIGIT, OTHER };
+
+CharClass classify(unsigned char c) {
+    if (c >= 0x80) return CharClass::LETTER;
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v') {
+        return CharClass::SPACE;
+    }
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')) return CharClass::LETTER;
+    if (c >= '0' && c <= '9') return CharClass::DIGIT;
+    return CharClass::OTHER;
+}
+
+// Matches CLIP's contraction alternatives ('s 't 're 've 'm 'll 'd) at pos
+size_t contraction_length(const std::string& text, size_t pos) {
+    if (text[pos] != '\'') {
+        return 0;
+    }
+    static const char* const kSuffixes[] = {"re", "ve", "ll", "s", "t", "m", "d"};
+    for (const char* suffix : kSuffixes) {
+        const size_t n = std::char_traits<char>::length(suffix);
+        if (text.compare(pos + 1, n, suffix) == 0) {
+            return n + 1;
+        }
+    }
+    return 0;
+}
+
+std::string pad_token_from(const std::string& path) {
+    std::string text;
+    if (!read_file(path, text)) {
+        return {};
+    }
+    nlohmann::json json = nlohmann::json::parse(text, nullptr, false);
+    if (!json.is_object() || !json.contains("pad_token")) {
+        return {};
+    }
+    const auto& pad = json["pad_token"];
+    if (pad.is_string()) {
+        return pad.get<std::string>();
+    }
+    if (pad.is_object() && pad.contains("content") && pad["content"].is_string()) {
+        return pad["content"].get<std::string>();
+    }
+    return {};
+}
+
+}  // namespace
+
+bool ClipTokenizer::load(const std::string& dir, std::string* error) {
+    auto fail = [error](const std::string& message) {
+        if (error) *error = message;
+        return false;
+    };
+
+    std::string vocab_text;
+    if (!read_file(dir + "/vocab.json", vocab_text)) {
+        return fail("vocab.json not found in " + dir);
+    }
+    nlohmann::json vocab = nlohmann::json::parse(vocab_text, nullptr, false);
+    if (!vocab.is_object()) {
+        return fail("vocab.json is not a JSON object");
+    }
+
+    std::ifstream merges(dir + "/merges.txt");
+    if (!merges) {
+        return fail("merges.txt not found in " + dir);
+    }
+
+    vocab_.clear();
+    merge_ranks_.clear();
+    vocab_.reserve(vocab.size());
+    for (auto it = vocab.begin(); it != vocab.end(); ++it) {
+        if (it.value().is_number_integer()) {
+            vocab_[it.key()] = it.value().get<int64_t>();
+        }
+    }
+
+    std::string line;
+    int32_t rank = 0;
+    while (std::getline(merges, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line.rfind("#version", 0) == 0) continue;
+        merge_ranks_.emplace(line, rank++);
+    }
+
+    // GPT-2 byte-to-unicode table: printable bytes map to themselves, the rest
+    // to code points 256+ so every byte has a visible, space-free symbol
+    uint32_t next = 0;
+    for (uint32_t b = 0; b < 256; ++b) {
+        const bool printable = (b >= 33 && b <= 126) || (b >= 161 && b <= 172) || b >= 174;
+        byte_symbols_[b].clear();
+        append_utf8(byte_symbols_[b], printable ? b : 256 + next++);
+    }
+
+    auto lookup = [this](const std::string& token, int64_t fallback) {
+        auto it = vocab_.find(token);
+        return it != vocab_.end() ? it->second : fallback;
+    };
+    bos_id_ = lookup("<|startoftext|>", bos_id_);
+    eos_id_ = lookup("<|endoftext|>", eos_id_);
+    pad_id_ = eos_id_;
+    for (const char* name : {"special_tokens_map.json", "tokenizer_config.json"}) {
+        const std::string pad = pad_token_from(dir + "/" + name);
+        if (!pad.empty()) {
+            pad_id_ = lookup(pad, eos_id_);
+            break;
+        }
+    }
+
+    if (vocab_.empty()) {
+        return fail("vocab.json is empty");
+    }
+    return true;
+}
+
+std::vector<std::string> ClipTokenizer::split_words(const std::string& text) const {
+    // Lowercase ASCII; whitespace acts only as a separator, so collapsing it is implicit
+    std::string lowered = text;
+    for (char& c : lowered) {
+        if (c >= 'A' && c <= 'Z') c = static_cast<char>(c - 'A' + 'a');
+    }
+
+    std::vector<std::string> words;
+    size_t pos = 0;
+    while (pos < lowered.size()) {
+        const auto c = static_cast<unsigned char>(lowered[pos]);
+        const CharClass cls = classify(c);
+        if (cls == CharClass::SPACE) {
+            ++pos;
+            continue;
+        }
+
+        size_t end = pos;
+        if (const size_t n = contraction_length(lowered, pos)) {
+            end = pos + n;
+        } else if (cls == CharClass::DIGIT) {
+            end = pos + 1;
+        } else {
+            while (end < lowered.size() &&
+                   classify(static_cast<unsigned char>(lowered[end])) == cls) {
+                end += cls == CharClass::LETTER
+                           ? utf8_length(static_cast<unsigned char>(lowered[end]))
+                           : 1;
+            }
+        }
+        end = std::min(end, lowered.size());
+        words.push_back(lowered.substr(pos, end - pos));
+        pos = end;
+    }
+    return words;
+}
+
+void ClipTokenizer::bpe(const std::string& word, std::vector<int64_t>& out) const {
+    std::vector<std::string> symbols;
+    symbols.reserve(word.size());
+    for (unsigned char c : word) {
+        symbols.push_back(byte_symbols_[c]);
+    }
+    if (symbols.empty()) {
+        return;
+    }
+    symbols.back() += kEndOfWord;
+
+    while (symbols.size() > 1) {
+        int32_t best_rank = INT32_MAX;
+        size_t best = 0;
+        for (size_t i = 0; i + 1 < symbols.size(); ++i) {
+            auto it = merge_ranks_.find(symbols[i] + " " + symbols[i + 1]);
+            if (it != merge_ranks_.end() && it->second < best_rank) {
+                best_rank = it->second;
+                best = i;
+            }
+        }
+        if (best_rank == INT32_MAX) {
+            break;
+        }
+
+        // Merge every occurrence of the best pair in one left-to-right pass
+        const std::string left = symbols[best];
+        const std::string right = symbols[best + 1];
+        std::vector<std::string> merged;
+        merged.reserve(symbols.size());
+        for (size_t i = 0; i < symbols.size(); ++i) {
+            if (i + 1 < symbols.size() && symbols[i] == left && symbols[i + 1] == right) {
+                merged.push_back(left + right);
+                ++i;
+            } else {
+                merged.push_back(symbols[i]);
+            }
+        }
+        symbols.swap(merged);
+    }
+
+    for (const std::string& symbol : symbols) {
+        auto it = vocab_.find(symbol);
+        if (it != vocab_.end()) {
+            out.push_back(it->second);
+        }
+    }
+}
+
+std::vector<int64_t> ClipTokenizer::encode(const std::string& text) const {
+    std::vector<int64_t> ids;
+    ids.reserve(kContextLength);
+    ids.push_back(bos_id_);
+    for (const std::string& word : split_words(text)) {
+        bpe(word, ids);
+        if (ids.size() >= static_cast<size_t>(kContextLength - 1)) {
+            break;
+        }
+    }
+    ids.resize(std::min(ids.size(), static_cast<size_t>(kContextLength - 1)));
+    ids.push_back(eos_id_);
+    ids.resize(kContextLength, pad_id_);
+    return ids;
+}
+
+}  // namespace diffusion
+}  // namespace runanywhere
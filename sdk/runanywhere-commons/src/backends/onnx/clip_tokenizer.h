@@ -0,0 +1,53 @@
+#ifndef RUNANYWHERE_CLIP_TOKENIZER_H
+#define RUNANYWHERE_CLIP_TOKENIZER_H
+
+/**
+ * CLIP byte-level BPE tokenizer for the ONNX diffusion text encoder
+ *
+ * Reads the vocab.json / merges.txt pair managed by rac_diffusion_tokenizer
+ * and reproduces the Hugging Face CLIPTokenizer output: lowercased,
+ * whitespace-collapsed text, "</w>" end-of-word markers, BOS/EOS framing and
+ * padding to the 77-token context. Pre-tokenization follows CLIP's regex
+ * exactly for ASCII; every non-ASCII code point is treated as a letter.
+ */
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace runanywhere {
+namespace diffusion {
+
+class ClipTokenizer {
+public:
+    static constexpr int32_t kContextLength = 77;
+
+    /**
+     * Load vocab.json and merges.txt from dir. The pad token is read from
+     * special_tokens_map.json or tokenizer_config.json when present and
+     * defaults to the end-of-text token.
+     */
+    bool load(const std::string& dir, std::string* error);
+
+    bool is_loaded() const { return !vocab_.empty(); }
+
+    /** BOS + up to 75 BPE tokens + EOS, padded to kContextLength ids */
+    std::vector<int64_t> encode(const std::string& text) const;
+
+private:
+    std::vector<std::string> split_words(const std::string& text) const;
+    void bpe(const std::string& word, std::vector<int64_t>& out) const;
+
+    std::unordered_map<std::string, int64_t> vocab_;
+    std::unordered_map<std::string, int32_t> merge_ranks_;  // "left right" -> rank
+    std::string byte_symbols_[256];
+    int64_t bos_id_ = 49406;
+    int64_t eos_id_ = 49407;
+    int64_t pad_id_ = 49407;
+};
+
+}  // namespace diffusion
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_CLIP_TOKENIZER_H
@@ -0,0 +1,899 @@
+/**
+ * @file diffusion_onnx.cpp
+ * @brief RunAnywhere Core - ONNX Runtime Stable Diffusion (CPU)
+ *
+ * Text encoder -> UNet denoising loop -> VAE decoder, each a session on the
+ * shared ORT environment. Model I/O is discovered from the sessions rather
+ * than assumed, so standard diffusers/Optimum exports (int32 or int64 ids,
+ * scalar or batched timesteps, static or dynamic batch) all load. Encoded
+ * prompts are cached because apps typically iterate on seeds and settings
+ * while the prompt stays the same, and the text encoder is a full
+ * transformer pass per prompt.
+ */
+
+#include "rac_diffusion_onnx.h"
+
+#include <onnxruntime_c_api.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+#include "clip_tokenizer.h"
+#include "diffusion_scheduler.h"
+#include "ort_model_cache.h"
+#include "ort_shared_env.h"
+
+#include "rac/core/rac_logger.h"
+
+namespace {
+
+using runanywhere::diffusion::ClipTokenizer;
+using runanywhere::diffusion::DiffusionScheduler;
+using runanywhere::diffusion::SchedulerConfig;
+using runanywhere::diffusion::SchedulerKind;
+
+const char* LOG_CAT = "ONNX.Diffusion";
+
+constexpr float kDefaultVaeScaling = 0.18215f;
+constexpr int32_t kDefaultSteps = 20;
+constexpr int32_t kDefaultLcmSteps = 4;
+constexpr int32_t kMaxSteps = 150;
+constexpr int32_t kDefaultMaxSize = 1024;
+constexpr int32_t kLatentFactor = 8;
+
+const OrtApi* ort() {
+    static const OrtApi* api = OrtGetApiBase()->GetApi(ORT_API_VERSION);
+    return api;
+}
+
+struct OrtDeleter {
+    void operator()(OrtStatus* p) const { ort()->ReleaseStatus(p); }
+    void operator()(OrtValue* p) const { ort()->ReleaseValue(p); }
+    void operator()(OrtSession* p) const { ort()->ReleaseSession(p); }
+    void operator()(OrtSessionOptions* p) const { ort()->ReleaseSessionOptions(p); }
+    void operator()(OrtTypeInfo* p) const { ort()->ReleaseTypeInfo(p); }
+    void operator()(OrtTensorTypeAndShapeInfo* p) const { ort()->ReleaseTensorTypeAndShapeInfo(p); }
+    void operator()(OrtMemoryInfo* p) const { ort()->ReleaseMemoryInfo(p); }
+};
+
+template <typename T>
+using OrtPtr = std::unique_ptr<T, OrtDeleter>;
+
+// Takes ownership of status; returns true (and fills error) when it is an error
+bool failed(OrtStatus* status, std::string& error) {
+    if (!status) {
+        return false;
+    }
+    OrtPtr<OrtStatus> guard(status);
+    error = ort()->GetErrorMessage(status);
+    return true;
+}
+
+bool read_text_file(const std::string& path, std::string& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+    std::ostringstream buffer;
+    buffer << file.rdbuf();
+    out = buffer.str();
+    return true;
+}
+
+bool file_exists(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    return static_cast<bool>(file);
+}
+
+// =============================================================================
+// SESSION WRAPPER
+// =============================================================================
+
+struct TensorSpec {
+    std::string name;
+    ONNXTensorElementDataType type = ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+    std::vector<int64_t> shape;  // -1 for dynamic dimensions
+};
+
+struct OnnxModel {
+    OrtPtr<OrtSession> session;
+    std::vector<TensorSpec> inputs;
+    std::vector<std::string> outputs;
+
+    int find_input(const char* name) const {
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            if (inputs[i].name == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+
+    int find_output(const char* name) const {
+        for (size_t i = 0; i < outputs.size(); ++i) {
+            if (outputs[i] == name) return static_cast<int>(i);
+        }
+        return -1;
+    }
+};
+
+bool load_model(const std::string& path, bool prewarm, OnnxModel& model, std::string& error) {
+    OrtSessionOptions* raw_options = nullptr;
+    if (failed(ort()->CreateSessionOptions(&raw_options), error)) {
+        return false;
+    }
+    OrtPtr<OrtSessionOptions> options(raw_options);
+
+    OrtSession* raw_session = nullptr;
+    if (failed(runanywhere::ort_shared_create_session(path.c_str(), options.get(),
+                                                       runanywhere::OrtSessionPriority::NORMAL,
+                                                       ORT_ENABLE_ALL, &raw_session),
+               error)) {
+        error = path + ": " + error;
+        return false;
+    }
+    model.session.reset(raw_session);
+
+    OrtAllocator* allocator = nullptr;
+    if (failed(ort()->GetAllocatorWithDefaultOptions(&allocator), error)) {
+        return false;
+    }
+
+    size_t input_count = 0;
+    size_t output_count = 0;
+    if (failed(ort()->SessionGetInputCount(raw_session, &input_count), error) ||
+        failed(ort()->SessionGetOutputCount(raw_session, &output_count), error)) {
+        return false;
+    }
+
+    for (size_t i = 0; i < input_count; ++i) {
+        TensorSpec spec;
+        char* name = nullptr;
+        if (failed(ort()->SessionGetInputName(raw_session, i, allocator, &name), error)) {
+            return false;
+        }
+        spec.name = name;
+        OrtPtr<OrtStatus>(ort()->AllocatorFree(allocator, name));
+
+        OrtTypeInfo* raw_type = nullptr;
+        if (failed(ort()->SessionGetInputTypeInfo(raw_session, i, &raw_type), error)) {
+            return false;
+        }
+        OrtPtr<OrtTypeInfo> type_info(raw_type);
+        const OrtTensorTypeAndShapeInfo* tensor_info = nullptr;  // Owned by type_info
+        size_t rank = 0;
+        if (failed(ort()->CastTypeInfoToTensorInfo(raw_type, &tensor_info), error) ||
+            !tensor_info ||
+            failed(ort()->GetTensorElementType(tensor_info, &spec.type), error) ||
+            failed(ort()->GetDimensionsCount(tensor_info, &rank), error)) {
+            if (error.empty()) error = "input " + spec.name + " is not a tensor";
+            return false;
+        }
+        spec.shape.resize(rank);
+        if (rank > 0 &&
+            failed(ort()->GetDimensions(tensor_info, spec.shape.data(), rank), error)) {
+            return false;
+        }
+        model.inputs.push_back(std::move(spec));
+    }
+
+    for (size_t i = 0; i < output_count; ++i) {
+        char* name = nullptr;
+        if (failed(ort()->SessionGetOutputName(raw_session, i, allocator, &name), error)) {
+            return false;
+        }
+        model.outputs.emplace_back(name);
+        OrtPtr<OrtStatus>(ort()->AllocatorFree(allocator, name));
+    }
+
+    if (prewarm) {
+        runanywhere::ort_session_prewarm(raw_session);
+    }
+    return true;
+}
+
+// Float output tensor copied out of ORT
+struct FloatTensor {
+    std::vector<float> data;
+    std::vector<int64_t> shape;
+};
+
+bool read_float_output(OrtValue* value, FloatTensor& out, std::string& error) {
+    OrtTensorTypeAndShapeInfo* raw_info = nullptr;
+    if (failed(ort()->GetTensorTypeAndShape(value, &raw_info), error)) {
+        return false;
+    }
+    OrtPtr<OrtTensorTypeAndShapeInfo> info(raw_info);
+
+    ONNXTensorElementDataType type = ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+    size_t rank = 0;
+    if (failed(ort()->GetTensorElementType(raw_info, &type), error) ||
+        failed(ort()->GetDimensionsCount(raw_info, &rank), error)) {
+        return false;
+    }
+    if (type != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT) {
+        error = "model output is not float32";
+        return false;
+    }
+    out.shape.assign(rank, 0);
+    if (rank > 0 && failed(ort()->GetDimensions(raw_info, out.shape.data(), rank), error)) {
+        return false;
+    }
+
+    size_t count = 1;
+    for (int64_t dim : out.shape) {
+        count *= static_cast<size_t>(std::max<int64_t>(dim, 0));
+    }
+    float* data = nullptr;
+    if (failed(ort()->GetTensorMutableData(value, reinterpret_cast<void**>(&data)), error)) {
+        return false;
+    }
+    out.data.assign(data, data + count);
+    return true;
+}
+
+// One entry per input: name, ORT value over a caller-owned buffer
+struct RunInputs {
+    std::vector<const char*> names;
+    std::vector<OrtPtr<OrtValue>> values;
+
+    bool add(const OrtMemoryInfo* memory, const TensorSpec& spec, void* data, size_t bytes,
+             const std::vector<int64_t>& shape, std::string& error) {
+        OrtValue* value = nullptr;
+        if (failed(ort()->CreateTensorWithDataAsOrtValue(memory, data, bytes, shape.data(),
+                                                          shape.size(), spec.type, &value),
+                   error)) {
+            error = spec.name + ": " + error;
+            return false;
+        }
+        names.push_back(spec.name.c_str());
+        values.emplace_back(value);
+        return true;
+    }
+};
+
+bool run_model(const OnnxModel& model, RunInputs& inputs, int output_index, FloatTensor& out,
+               std::string& error) {
+    std::vector<const OrtValue*> values;
+    values.reserve(inputs.values.size());
+    for (const auto& value : inputs.values) {
+        values.push_back(value.get());
+    }
+    const char* output_name = model.outputs[static_cast<size_t>(output_index)].c_str();
+
+    OrtValue* raw_output = nullptr;
+    if (failed(ort()->Run(model.session.get(), nullptr, inputs.names.data(), values.data(),
+                          values.size(), &output_name, 1, &raw_output),
+               error)) {
+        return false;
+    }
+    OrtPtr<OrtValue> output(raw_output);
+    return read_float_output(raw_output, out, error);
+}
+
+bool has_fp16_input(const OnnxModel& model) {
+    for (const auto& spec : model.inputs) {
+        if (spec.type == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16) return true;
+    }
+    return false;
+}
+
+// =============================================================================
+// PIPELINE
+// =============================================================================
+
+struct PromptEmbedding {
+    std::vector<float> data;  // [1, seq, hidden]
+    int64_t seq_len = 0;
+    int64_t hidden = 0;
+};
+
+struct rac_onnx_diffusion_pipeline {
+    std::string model_dir;
+    rac_diffusion_onnx_config_t config = RAC_DIFFUSION_ONNX_CONFIG_DEFAULT;
+
+    bool env_acquired = false;
+    OrtPtr<OrtMemoryInfo> memory;
+    OnnxModel text_encoder;
+    OnnxModel unet;
+    OnnxModel vae_decoder;
+    ClipTokenizer tokenizer;
+    SchedulerConfig scheduler_config;
+    float vae_scaling = kDefaultVaeScaling;
+
+    // Resolved UNet I/O
+    int unet_sample = -1;
+    int unet_timestep = -1;
+    int unet_hidden_states = -1;
+    int unet_timestep_cond = -1;
+    int64_t latent_channels = 4;
+    int64_t timestep_cond_dim = 256;
+    bool dynamic_batch = true;
+    int text_output = 0;
+
+    // LRU cache of encoded prompts, most recent first
+    std::list<std::pair<std::vector<int64_t>, std::shared_ptr<const PromptEmbedding>>> prompt_cache;
+
+    std::mutex generate_mutex;
+    std::atomic<bool> cancel_requested{false};
+
+    ~rac_onnx_diffusion_pipeline() {
+        // Sessions must go before the environment they were created on
+        text_encoder.session.reset();
+        unet.session.reset();
+        vae_decoder.session.reset();
+        if (env_acquired) {
+            runanywhere::ort_shared_env_release();
+        }
+    }
+
+    bool is_lcm() const { return scheduler_config.lcm || unet_timestep_cond >= 0; }
+
+    rac_result_t load(std::string& error);
+    rac_result_t encode_prompt(const std::string& prompt,
+                               std::shared_ptr<const PromptEmbedding>& out, std::string& error);
+    rac_result_t run_unet(const std::vector<float>& sample, int64_t batch, double timestep,
+                          const std::vector<float>& hidden_states, int64_t seq_len, int64_t hidden,
+                          const std::vector<float>& timestep_cond, int64_t latent_h,
+                          int64_t latent_w, FloatTensor& out, std::string& error);
+    rac_result_t generate(const rac_diffusion_options_t* options,
+                          rac_diffusion_progress_callback_fn callback, void* user_data,
+                          rac_diffusion_result_t* out_result, std::string& error);
+};
+
+rac_result_t rac_onnx_diffusion_pipeline::load(std::string& error) {
+    const std::string text_encoder_path = model_dir + "/text_encoder/model.onnx";
+    const std::string unet_path = model_dir + "/unet/model.onnx";
+    const std::string vae_path = model_dir + "/vae_decoder/model.onnx";
+    for (const std::string* path : {&text_encoder_path, &unet_path, &vae_path}) {
+        if (!file_exists(*path)) {
+            error = "missing " + *path;
+            return RAC_ERROR_FILE_NOT_FOUND;
+        }
+    }
+
+    // Tokenizer files live in tokenizer/ for diffusers exports, else at the root
+    // (see rac_diffusion_tokenizer_ensure_files)
+    std::string tokenizer_dir = model_dir + "/tokenizer";
+    if (!file_exists(tokenizer_dir + "/vocab.json")) {
+        tokenizer_dir = model_dir;
+    }
+    if (!tokenizer.load(tokenizer_dir, &error)) {
+        return RAC_ERROR_FILE_NOT_FOUND;
+    }
+
+    std::string json_text;
+    if (read_text_file(model_dir + "/scheduler/scheduler_config.json", json_text)) {
+        scheduler_config = SchedulerConfig::from_json(json_text);
+    }
+    if (read_text_file(model_dir + "/vae_decoder/config.json", json_text)) {
+        nlohmann::json vae_json = nlohmann::json::parse(json_text, nullptr, false);
+        if (vae_json.is_object() && vae_json.contains("scaling_factor") &&
+            vae_json["scaling_factor"].is_number()) {
+            vae_scaling = vae_json["scaling_factor"].get<float>();
+        }
+    }
+
+    if (!runanywhere::ort_shared_env_acquire()) {
+        error = "failed to acquire shared ORT environment";
+        return RAC_ERROR_BACKEND_INIT_FAILED;
+    }
+    env_acquired = true;
+
+    OrtMemoryInfo* raw_memory = nullptr;
+    if (failed(ort()->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &raw_memory),
+               error)) {
+        return RAC_ERROR_BACKEND_INIT_FAILED;
+    }
+    memory.reset(raw_memory);
+
+    const bool prewarm = config.prewarm == RAC_TRUE;
+    if (!load_model(text_encoder_path, prewarm, text_encoder, error) ||
+        !load_model(unet_path, prewarm, unet, error) ||
+        !load_model(vae_path, prewarm, vae_decoder, error)) {
+        return RAC_ERROR_MODEL_LOAD_FAILED;
+    }
+
+    if (has_fp16_input(text_encoder) || has_fp16_input(unet) || has_fp16_input(vae_decoder)) {
+        error = "fp16 diffusion models are not supported by the CPU pipeline";
+        return RAC_ERROR_NOT_SUPPORTED;
+    }
+
+    if (text_encoder.inputs.empty() || vae_decoder.inputs.empty() || unet.outputs.empty() ||
+        text_encoder.outputs.empty() || vae_decoder.outputs.empty()) {
+        error = "unexpected diffusion model signature";
+        return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+    const int hidden_output = text_encoder.find_output("last_hidden_state");
+    text_output = hidden_output >= 0 ? hidden_output : 0;
+
+    unet_sample = unet.find_input("sample");
+    unet_timestep = unet.find_input("timestep");
+    unet_hidden_states = unet.find_input("encoder_hidden_states");
+    unet_timestep_cond = unet.find_input("timestep_cond");
+    if (unet_sample < 0 || unet_timestep < 0 || unet_hidden_states < 0) {
+        error = "UNet needs sample, timestep and encoder_hidden_states inputs";
+        return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+
+    const auto& sample_shape = unet.inputs[static_cast<size_t>(unet_sample)].shape;
+    if (sample_shape.size() != 4) {
+        error = "UNet sample input must be rank 4";
+        return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+    dynamic_batch = sample_shape[0] < 0;
+    if (sample_shape[1] > 0) {
+        latent_channels = sample_shape[1];
+    }
+    if (unet_timestep_cond >= 0) {
+        const auto& cond_shape = unet.inputs[static_cast<size_t>(unet_timestep_cond)].shape;
+        if (cond_shape.size() == 2 && cond_shape[1] > 0) {
+            timestep_cond_dim = cond_shape[1];
+        }
+    }
+
+    RAC_LOG_INFO(LOG_CAT, "Loaded ONNX diffusion model %s (%s, %s batch, vae scale %.5f)",
+                 model_dir.c_str(), is_lcm() ? "LCM" : "standard",
+                 dynamic_batch ? "dynamic" : "static", static_cast<double>(vae_scaling));
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_onnx_diffusion_pipeline::encode_prompt(
+    const std::string& prompt, std::shared_ptr<const PromptEmbedding>& out, std::string& error) {
+    std::vector<int64_t> ids = tokenizer.encode(prompt);
+
+    for (auto it = prompt_cache.begin(); it != prompt_cache.end(); ++it) {
+        if (it->first == ids) {
+            prompt_cache.splice(prompt_cache.begin(), prompt_cache, it);
+            out = prompt_cache.front().second;
+            return RAC_SUCCESS;
+        }
+    }
+
+    const TensorSpec& spec = text_encoder.inputs[0];
+    const std::vector<int64_t> shape = {1, static_cast<int64_t>(ids.size())};
+    std::vector<int32_t> ids32;
+    RunInputs inputs;
+    bool added;
+    if (spec.type == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32) {
+        ids32.assign(ids.begin(), ids.end());
+        added = inputs.add(memory.get(), spec, ids32.data(), ids32.size() * sizeof(int32_t),
+                           shape, error);
+    } else if (spec.type == ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64) {
+        added = inputs.add(memory.get(), spec, ids.data(), ids.size() * sizeof(int64_t), shape,
+                           error);
+    } else {
+        error = "text encoder input_ids must be int32 or int64";
+        return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+    if (!added) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+
+    FloatTensor hidden;
+    if (!run_model(text_encoder, inputs, text_output, hidden, error)) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+    if (hidden.shape.size() != 3 || hidden.shape[0] != 1) {
+        error = "text encoder output must be [1, seq, hidden]";
+        return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+
+    auto embedding = std::make_shared<PromptEmbedding>();
+    embedding->seq_len = hidden.shape[1];
+    embedding->hidden = hidden.shape[2];
+    embedding->data = std::move(hidden.data);
+    out = embedding;
+
+    if (config.prompt_cache_size > 0) {
+        prompt_cache.emplace_front(std::move(ids), embedding);
+        while (prompt_cache.size() > static_cast<size_t>(config.prompt_cache_size)) {
+            prompt_cache.pop_back();
+        }
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_onnx_diffusion_pipeline::run_unet(
+    const std::vector<float>& sample, int64_t batch, double timestep,
+    const std::vector<float>& hidden_states, int64_t seq_len, int64_t hidden,
+    const std::vector<float>& timestep_cond, int64_t latent_h, int64_t latent_w, FloatTensor& out,
+    std::string& error) {
+    // ORT takes non-const buffers but does not write inputs
+    auto* sample_data = const_cast<float*>(sample.data());
+    auto* hidden_data = const_cast<float*>(hidden_states.data());
+
+    RunInputs inputs;
+    if (!inputs.add(memory.get(), unet.inputs[static_cast<size_t>(unet_sample)], sample_data,
+                    sample.size() * sizeof(float), {batch, latent_channels, latent_h, latent_w},
+                    error) ||
+        !inputs.add(memory.get(), unet.inputs[static_cast<size_t>(unet_hidden_states)],
+                    hidden_data, hidden_states.size() * sizeof(float), {batch, seq_len, hidden},
+                    error)) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+
+    // Timestep: float or integer, scalar or one per batch entry
+    const TensorSpec& t_spec = unet.inputs[static_cast<size_t>(unet_timestep)];
+    const size_t t_count = t_spec.shape.empty() ? 1 : static_cast<size_t>(batch);
+    std::vector<int64_t> t_shape;
+    if (!t_spec.shape.empty()) t_shape.push_back(batch);
+    std::vector<float> t_float(t_count, static_cast<float>(timestep));
+    std::vector<int64_t> t_int64(t_count, static_cast<int64_t>(timestep));
+    std::vector<int32_t> t_int32(t_count, static_cast<int32_t>(timestep));
+    bool added;
+    switch (t_spec.type) {
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+            added = inputs.add(memory.get(), t_spec, t_float.data(), t_count * sizeof(float),
+                               t_shape, error);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+            added = inputs.add(memory.get(), t_spec, t_int64.data(), t_count * sizeof(int64_t),
+                               t_shape, error);
+            break;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+            added = inputs.add(memory.get(), t_spec, t_int32.data(), t_count * sizeof(int32_t),
+                               t_shape, error);
+            break;
+        default:
+            error = "unsupported UNet timestep type";
+            return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+    if (!added) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+
+    if (unet_timestep_cond >= 0 &&
+        !inputs.add(memory.get(), unet.inputs[static_cast<size_t>(unet_timestep_cond)],
+                    const_cast<float*>(timestep_cond.data()), timestep_cond.size() * sizeof(float),
+                    {batch, timestep_cond_dim}, error)) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+
+    if (!run_model(unet, inputs, 0, out, error)) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+    if (out.data.size() != sample.size()) {
+        error = "UNet output does not match the latent shape";
+        return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_onnx_diffusion_pipeline::generate(const rac_diffusion_options_t* options,
+                                                   rac_diffusion_progress_callback_fn callback,
+                                                   void* user_data,
+                                                   rac_diffusion_result_t* out_result,
+                                                   std::string& error) {
+    if (options->mode != RAC_DIFFUSION_MODE_TEXT_TO_IMAGE) {
+        error = "ONNX diffusion supports text-to-image only";
+        return RAC_ERROR_NOT_SUPPORTED;
+    }
+
+    const int32_t width = options->width > 0 ? options->width : 512;
+    const int32_t height = options->height > 0 ? options->height : 512;
+    if (width % kLatentFactor != 0 || height % kLatentFactor != 0) {
+        error = "width and height must be multiples of 8";
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    const int64_t latent_h = height / kLatentFactor;
+    const int64_t latent_w = width / kLatentFactor;
+    const auto& sample_shape = unet.inputs[static_cast<size_t>(unet_sample)].shape;
+    if ((sample_shape[2] > 0 && sample_shape[2] != latent_h) ||
+        (sample_shape[3] > 0 && sample_shape[3] != latent_w)) {
+        error = "model has a fixed resolution of " + std::to_string(sample_shape[3] * 8) + "x" +
+                std::to_string(sample_shape[2] * 8);
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const bool lcm = is_lcm();
+    int32_t steps = options->steps > 0 ? options->steps : (lcm ? kDefaultLcmSteps : kDefaultSteps);
+    steps = std::min(steps, kMaxSteps);
+    const int32_t stride = std::max(options->progress_stride, 1);
+    const float guidance = options->guidance_scale;
+
+    SchedulerKind kind = SchedulerKind::EULER;
+    if (lcm) {
+        kind = SchedulerKind::LCM;
+    } else if (options->scheduler == RAC_DIFFUSION_SCHEDULER_EULER_ANCESTRAL) {
+        kind = SchedulerKind::EULER_ANCESTRAL;
+    } else if (options->scheduler != RAC_DIFFUSION_SCHEDULER_EULER) {
+        RAC_LOG_DEBUG(LOG_CAT, "Scheduler %d not available on ONNX, using Euler",
+                      static_cast<int>(options->scheduler));
+    }
+    DiffusionScheduler scheduler(kind, scheduler_config);
+    scheduler.set_timesteps(steps);
+    const size_t total_steps = scheduler.timesteps().size();
+
+    rac_diffusion_progress_t progress = {};
+    progress.total_steps = static_cast<int32_t>(total_steps);
+    auto report = [&](const char* stage, int32_t step, float fraction) {
+        if (cancel_requested.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        if (!callback) {
+            return true;
+        }
+        progress.stage = stage;
+        progress.current_step = step;
+        progress.progress = fraction;
+        if (callback(&progress, user_data) == RAC_FALSE) {
+            cancel_requested.store(true, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    };
+
+    // --- Text encoding ---
+    if (!report("Encoding", 0, 0.0f)) return RAC_ERROR_CANCELLED;
+
+    // LCM models take guidance through timestep_cond instead of a second pass
+    const bool do_cfg = guidance > 1.0f && unet_timestep_cond < 0;
+    std::shared_ptr<const PromptEmbedding> cond;
+    std::shared_ptr<const PromptEmbedding> uncond;
+    rac_result_t rc = encode_prompt(options->prompt ? options->prompt : "", cond, error);
+    if (rc == RAC_SUCCESS && do_cfg) {
+        rc = encode_prompt(options->negative_prompt ? options->negative_prompt : "", uncond,
+                           error);
+    }
+    if (rc != RAC_SUCCESS) {
+        return rc;
+    }
+
+    // --- Initial latents ---
+    int64_t seed = options->seed;
+    if (seed < 0) {
+        std::random_device device;
+        seed = static_cast<int64_t>(((static_cast<uint64_t>(device()) << 32) | device()) >> 1);
+    }
+    std::mt19937_64 rng(static_cast<uint64_t>(seed));
+
+    const size_t latent_count = static_cast<size_t>(latent_channels * latent_h * latent_w);
+    std::vector<float> latents(latent_count);
+    {
+        std::normal_distribution<float> normal(0.0f, 1.0f);
+        const float sigma = scheduler.init_noise_sigma();
+        for (float& value : latents) {
+            value = normal(rng) * sigma;
+        }
+    }
+
+    const std::vector<float> timestep_cond =
+        unet_timestep_cond >= 0
+            ? runanywhere::diffusion::guidance_scale_embedding(guidance, static_cast<int32_t>(timestep_cond_dim))
+            : std::vector<float>();
+    std::vector<float> batched_hidden;
+    if (do_cfg && dynamic_batch) {
+        batched_hidden = uncond->data;
+        batched_hidden.insert(batched_hidden.end(), cond->data.begin(), cond->data.end());
+    }
+
+    // --- Denoising ---
+    std::vector<float> model_input(latent_count);
+    std::vector<float> noise_pred(latent_count);
+    FloatTensor unet_out;
+    for (size_t step = 0; step < total_steps; ++step) {
+        const float scale = scheduler.input_scale(step);
+        for (size_t i = 0; i < latent_count; ++i) {
+            model_input[i] = latents[i] * scale;
+        }
+        const double t = scheduler.timesteps()[step];
+
+        if (do_cfg && dynamic_batch) {
+            std::vector<float> batched_input(model_input);
+            batched_input.insert(batched_input.end(), model_input.begin(), model_input.end());
+            rc = run_unet(batched_input, 2, t, batched_hidden, cond->seq_len, cond->hidden,
+                          timestep_cond, latent_h, latent_w, unet_out, error);
+            if (rc != RAC_SUCCESS) return rc;
+            const float* uncond_pred = unet_out.data.data();
+            const float* cond_pred = uncond_pred + latent_count;
+            for (size_t i = 0; i < latent_count; ++i) {
+                noise_pred[i] = uncond_pred[i] + guidance * (cond_pred[i] - uncond_pred[i]);
+            }
+        } else if (do_cfg) {
+            rc = run_unet(model_input, 1, t, uncond->data, uncond->seq_len, uncond->hidden,
+                          timestep_cond, latent_h, latent_w, unet_out, error);
+            if (rc != RAC_SUCCESS) return rc;
+            noise_pred.swap(unet_out.data);
+            rc = run_unet(model_input, 1, t, cond->data, cond->seq_len, cond->hidden,
+                          timestep_cond, latent_h, latent_w, unet_out, error);
+            if (rc != RAC_SUCCESS) return rc;
+            for (size_t i = 0; i < latent_count; ++i) {
+                noise_pred[i] += guidance * (unet_out.data[i] - noise_pred[i]);
+            }
+        } else {
+            rc = run_unet(model_input, 1, t, cond->data, cond->seq_len, cond->hidden,
+                          timestep_cond, latent_h, latent_w, unet_out, error);
+            if (rc != RAC_SUCCESS) return rc;
+            noise_pred.swap(unet_out.data);
+        }
+
+        scheduler.step(step, noise_pred.data(), latents.data(), latent_count, rng);
+
+        const auto done = static_cast<int32_t>(step + 1);
+        if ((done % stride == 0 || step + 1 == total_steps) &&
+            !report("Denoising", done, static_cast<float>(done) / (total_steps + 1))) {
+            return RAC_ERROR_CANCELLED;
+        }
+        if (cancel_requested.load(std::memory_order_relaxed)) {
+            return RAC_ERROR_CANCELLED;
+        }
+    }
+
+    // --- VAE decode ---
+    if (!report("Decoding", progress.total_steps,
+                static_cast<float>(total_steps) / (total_steps + 1))) {
+        return RAC_ERROR_CANCELLED;
+    }
+    for (float& value : latents) {
+        value /= vae_scaling;
+    }
+    RunInputs vae_inputs;
+    FloatTensor image;
+    if (!vae_inputs.add(memory.get(), vae_decoder.inputs[0], latents.data(),
+                        latents.size() * sizeof(float), {1, latent_channels, latent_h, latent_w},
+                        error) ||
+        !run_model(vae_decoder, vae_inputs, 0, image, error)) {
+        return RAC_ERROR_INFERENCE_FAILED;
+    }
+    const size_t pixels = static_cast<size_t>(width) * static_cast<size_t>(height);
+    if (image.shape.size() != 4 || image.shape[1] < 3 || image.data.size() < pixels * 3) {
+        error = "VAE decoder output must be [1, 3, H, W]";
+        return RAC_ERROR_INVALID_MODEL_FORMAT;
+    }
+
+    // Planar [-1, 1] RGB -> interleaved RGBA8
+    auto* rgba = static_cast<uint8_t*>(malloc(pixels * 4));
+    if (!rgba) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    const size_t plane = static_cast<size_t>(image.shape[2] * image.shape[3]);
+    for (size_t p = 0; p < pixels; ++p) {
+        for (size_t c = 0; c < 3; ++c) {
+            const float value = std::min(std::max(image.data[c * plane + p] * 0.5f + 0.5f, 0.0f), 1.0f);
+            rgba[p * 4 + c] = static_cast<uint8_t>(value * 255.0f + 0.5f);
+        }
+        rgba[p * 4 + 3] = 255;
+    }
+
+    out_result->image_data = rgba;
+    out_result->image_size = pixels * 4;
+    out_result->width = width;
+    out_result->height = height;
+    out_result->seed_used = seed;
+    out_result->generation_time_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                                         std::chrono::steady_clock::now() - start)
+                                         .count();
+    out_result->safety_flagged = RAC_FALSE;
+    out_result->error_code = RAC_SUCCESS;
+
+    report("Decoding", progress.total_steps, 1.0f);
+    RAC_LOG_INFO(LOG_CAT, "Generated %dx%d image in %lld ms (%zu steps, seed %lld)", width,
+                 height, static_cast<long long>(out_result->generation_time_ms), total_steps,
+                 static_cast<long long>(seed));
+    return RAC_SUCCESS;
+}
+
+}  // namespace
+
+// =============================================================================
+// C API
+// =============================================================================
+
+extern "C" {
+
+rac_result_t rac_diffusion_onnx_create(const char* model_dir,
+                                       const rac_diffusion_onnx_config_t* config,
+                                       rac_handle_t* out_handle) {
+    if (out_handle == nullptr || model_dir == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    *out_handle = nullptr;
+
+    auto* pipeline = new (std::nothrow) rac_onnx_diffusion_pipeline();
+    if (!pipeline) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    pipeline->model_dir = model_dir;
+    if (config) {
+        pipeline->config = *config;
+    }
+
+    std::string error;
+    rac_result_t result = pipeline->load(error);
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "Failed to load ONNX diffusion model: %s", error.c_str());
+        rac_error_set_details(error.c_str());
+        delete pipeline;
+        return result;
+    }
+
+    *out_handle = static_cast<rac_handle_t>(pipeline);
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_diffusion_onnx_generate_with_progress(
+    rac_handle_t handle, const rac_diffusion_options_t* options,
+    rac_diffusion_progress_callback_fn progress_callback, void* user_data,
+    rac_diffusion_result_t* out_result) {
+    if (!handle || !options || !out_result) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    auto* pipeline = static_cast<rac_onnx_diffusion_pipeline*>(handle);
+
+    std::lock_guard<std::mutex> lock(pipeline->generate_mutex);
+    pipeline->cancel_requested.store(false, std::memory_order_relaxed);
+    memset(out_result, 0, sizeof(*out_result));
+
+    std::string error;
+    rac_result_t result;
+    try {
+        result = pipeline->generate(options, progress_callback, user_data, out_result, error);
+    } catch (const std::bad_alloc&) {
+        result = RAC_ERROR_OUT_OF_MEMORY;
+        error = "out of memory";
+    }
+
+    if (result != RAC_SUCCESS) {
+        out_result->error_code = result;
+        if (result != RAC_ERROR_CANCELLED) {
+            RAC_LOG_ERROR(LOG_CAT, "Generation failed (%d): %s", result, error.c_str());
+            rac_error_set_details(error.c_str());
+        }
+    }
+    return result;
+}
+
+rac_result_t rac_diffusion_onnx_generate(rac_handle_t handle,
+                                         const rac_diffusion_options_t* options,
+                                         rac_diffusion_result_t* out_result) {
+    return rac_diffusion_onnx_generate_with_progress(handle, options, nullptr, nullptr,
+                                                     out_result);
+}
+
+rac_result_t rac_diffusion_onnx_get_info(rac_handle_t handle, rac_diffusion_info_t* out_info) {
+    if (!handle || !out_info) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    auto* pipeline = static_cast<rac_onnx_diffusion_pipeline*>(handle);
+    const auto& sample_shape = pipeline->unet.inputs[static_cast<size_t>(pipeline->unet_sample)].shape;
+
+    out_info->is_ready = RAC_TRUE;
+    out_info->current_model = pipeline->model_dir.c_str();
+    out_info->model_variant =
+        pipeline->is_lcm() ? RAC_DIFFUSION_MODEL_LCM : RAC_DIFFUSION_MODEL_SD_1_5;
+    out_info->supports_text_to_image = RAC_TRUE;
+    out_info->supports_image_to_image = RAC_FALSE;
+    out_info->supports_inpainting = RAC_FALSE;
+    out_info->safety_checker_enabled = RAC_FALSE;
+    out_info->max_width =
+        sample_shape[3] > 0 ? static_cast<int32_t>(sample_shape[3] * kLatentFactor) : kDefaultMaxSize;
+    out_info->max_height =
+        sample_shape[2] > 0 ? static_cast<int32_t>(sample_shape[2] * kLatentFactor) : kDefaultMaxSize;
+    return RAC_SUCCESS;
+}
+
+void rac_diffusion_onnx_cancel(rac_handle_t handle) {
+    if (handle) {
+        static_cast<rac_onnx_diffusion_pipeline*>(handle)->cancel_requested.store(
+            true, std::memory_order_relaxed);
+    }
+}
+
+void rac_diffusion_onnx_destroy(rac_handle_t handle) {
+    delete static_cast<rac_onnx_diffusion_pipeline*>(handle);
+}
+
+}  // extern "C"
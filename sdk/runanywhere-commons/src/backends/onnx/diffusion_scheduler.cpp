@@ -0,0 +1,197 @@
+#include "diffusion_scheduler.h"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace runanywhere {
+namespace diffusion {
+
+namespace {
+
+// LCM boundary condition constant (sigma_data in the LCM paper)
+constexpr double kLcmSigmaData = 0.5;
+
+}  // namespace
+
+SchedulerConfig SchedulerConfig::from_json(const std::string& json_text) {
+    SchedulerConfig config;
+    nlohmann::json json = nlohmann::json::parse(json_text, nullptr, false);
+    if (!json.is_object()) {
+        return config;
+    }
+
+    config.num_train_timesteps = json.value("num_train_timesteps", config.num_train_timesteps);
+    config.beta_start = json.value("beta_start", config.beta_start);
+    config.beta_end = json.value("beta_end", config.beta_end);
+    config.scaled_linear = json.value("beta_schedule", std::string("scaled_linear")) != "linear";
+    config.v_prediction = json.value("prediction_type", std::string("epsilon")) == "v_prediction";
+    config.lcm = json.value("_class_name", std::string()) == "LCMScheduler";
+    if (json.contains("original_inference_steps") &&
+        json["original_inference_steps"].is_number_integer()) {
+        config.original_inference_steps = json["original_inference_steps"].get<int32_t>();
+    }
+    config.timestep_scaling = json.value("timestep_scaling", config.timestep_scaling);
+
+    config.num_train_timesteps = std::max(config.num_train_timesteps, 1);
+    config.original_inference_steps =
+        std::min(std::max(config.original_inference_steps, 1), config.num_train_timesteps);
+    return config;
+}
+
+DiffusionScheduler::DiffusionScheduler(SchedulerKind kind, const SchedulerConfig& config)
+    : kind_(kind), config_(config) {
+    const int32_t count = config_.num_train_timesteps;
+    alphas_cumprod_.resize(static_cast<size_t>(count));
+
+    double product = 1.0;
+    for (int32_t i = 0; i < count; ++i) {
+        const double t = count > 1 ? static_cast<double>(i) / (count - 1) : 0.0;
+        double beta;
+        if (config_.scaled_linear) {
+            const double root =
+                std::sqrt(config_.beta_start) + t * (std::sqrt(config_.beta_end) - std::sqrt(config_.beta_start));
+            beta = root * root;
+        } else {
+            beta = config_.beta_start + t * (config_.beta_end - config_.beta_start);
+        }
+        product *= 1.0 - beta;
+        alphas_cumprod_[i] = product;
+    }
+}
+
+void DiffusionScheduler::set_timesteps(int32_t num_steps) {
+    num_steps = std::max(num_steps, 1);
+    const int32_t train_steps = config_.num_train_timesteps;
+    timesteps_.clear();
+    sigmas_.clear();
+
+    if (kind_ == SchedulerKind::LCM) {
+        // Skip evenly through the original (distillation) schedule, high to low
+        num_steps = std::min(num_steps, config_.original_inference_steps);
+        const int32_t original = config_.original_inference_steps;
+        const int32_t ratio = train_steps / original;
+        for (int32_t i = 0; i < num_steps; ++i) {
+            const auto index = static_cast<int32_t>(
+                std::floor(static_cast<double>(i) * original / num_steps));
+            timesteps_.push_back(static_cast<double>((original - index) * ratio - 1));
+        }
+        init_noise_sigma_ = 1.0f;
+        return;
+    }
+
+    // Euler: linspace over the training range, sigma interpolated per timestep
+    for (int32_t i = 0; i < num_steps; ++i) {
+        const double t = num_steps > 1
+                             ? (train_steps - 1) * (1.0 - static_cast<double>(i) / (num_steps - 1))
+                             : train_steps - 1;
+        timesteps_.push_back(t);
+
+        const auto low = static_cast<size_t>(std::floor(t));
+        const size_t high = std::min(low + 1, alphas_cumprod_.size() - 1);
+        const double frac = t - static_cast<double>(low);
+        auto sigma_at = [this](size_t i) {
+            return std::sqrt((1.0 - alphas_cumprod_[i]) / alphas_cumprod_[i]);
+        };
+        sigmas_.push_back((1.0 - frac) * sigma_at(low) + frac * sigma_at(high));
+    }
+    sigmas_.push_back(0.0);
+    init_noise_sigma_ = static_cast<float>(*std::max_element(sigmas_.begin(), sigmas_.end()));
+}
+
+float DiffusionScheduler::input_scale(size_t step) const {
+    if (kind_ == SchedulerKind::LCM || step >= timesteps_.size()) {
+        return 1.0f;
+    }
+    const double sigma = sigmas_[step];
+    return static_cast<float>(1.0 / std::sqrt(sigma * sigma + 1.0));
+}
+
+void DiffusionScheduler::step(size_t step, const float* model_output, float* latents,
+                              size_t count, std::mt19937_64& rng) const {
+    if (step >= timesteps_.size()) {
+        return;
+    }
+    std::normal_distribution<float> normal(0.0f, 1.0f);
+
+    if (kind_ == SchedulerKind::LCM) {
+        const auto t = static_cast<size_t>(timesteps_[step]);
+        const bool last = step + 1 == timesteps_.size();
+        const double alpha_t = alphas_cumprod_[t];
+        const double alpha_prev =
+            last ? 1.0 : alphas_cumprod_[static_cast<size_t>(timesteps_[step + 1])];
+
+        const double scaled = timesteps_[step] * config_.timestep_scaling;
+        const double c_skip =
+            kLcmSigmaData * kLcmSigmaData / (scaled * scaled + kLcmSigmaData * kLcmSigmaData);
+        const double c_out = scaled / std::sqrt(scaled * scaled + kLcmSigmaData * kLcmSigmaData);
+
+        const auto sqrt_alpha = static_cast<float>(std::sqrt(alpha_t));
+        const auto sqrt_one_minus = static_cast<float>(std::sqrt(1.0 - alpha_t));
+        const auto skip = static_cast<float>(c_skip);
+        const auto out = static_cast<float>(c_out);
+        const auto prev_signal = static_cast<float>(std::sqrt(alpha_prev));
+        const auto prev_noise = static_cast<float>(std::sqrt(1.0 - alpha_prev));
+
+        for (size_t i = 0; i < count; ++i) {
+            const float sample = latents[i];
+            const float pred_x0 =
+                config_.v_prediction ? sqrt_alpha * sample - sqrt_one_minus * model_output[i]
+                                     : (sample - sqrt_one_minus * model_output[i]) / sqrt_alpha;
+            const float denoised = out * pred_x0 + skip * sample;
+            latents[i] = last ? denoised : prev_signal * denoised + prev_noise * normal(rng);
+        }
+        return;
+    }
+
+    const double sigma = sigmas_[step];
+    const double sigma_next = sigmas_[step + 1];
+    double sigma_target = sigma_next;
+    double sigma_up = 0.0;
+    if (kind_ == SchedulerKind::EULER_ANCESTRAL && sigma_next > 0.0) {
+        sigma_up = std::sqrt(sigma_next * sigma_next * (sigma * sigma - sigma_next * sigma_next) /
+                             (sigma * sigma));
+        sigma_target = std::sqrt(sigma_next * sigma_next - sigma_up * sigma_up);
+    }
+
+    const auto dt = static_cast<float>(sigma_target - sigma);
+    const auto up = static_cast<float>(sigma_up);
+    const auto sigma_f = static_cast<float>(sigma);
+    // v-prediction: x0 = c_in^2 * sample - sigma * c_in * v, with c_in = 1/sqrt(sigma^2+1)
+    const auto c_in = static_cast<float>(1.0 / std::sqrt(sigma * sigma + 1.0));
+
+    for (size_t i = 0; i < count; ++i) {
+        const float sample = latents[i];
+        float derivative = model_output[i];  // epsilon: (sample - x0) / sigma == eps
+        if (config_.v_prediction) {
+            const float pred_x0 = c_in * c_in * sample - sigma_f * c_in * model_output[i];
+            derivative = (sample - pred_x0) / sigma_f;
+        }
+        float next = sample + derivative * dt;
+        if (up > 0.0f) {
+            next += normal(rng) * up;
+        }
+        latents[i] = next;
+    }
+}
+
+std::vector<float> guidance_scale_embedding(float guidance_scale, int32_t dim) {
+    std::vector<float> embedding(static_cast<size_t>(std::max(dim, 0)), 0.0f);
+    const int32_t half = dim / 2;
+    if (half < 2) {
+        return embedding;
+    }
+
+    const double w = (static_cast<double>(guidance_scale) - 1.0) * 1000.0;
+    const double step = std::log(10000.0) / (half - 1);
+    for (int32_t i = 0; i < half; ++i) {
+        const double angle = w * std::exp(-step * i);
+        embedding[i] = static_cast<float>(std::sin(angle));
+        embedding[half + i] = static_cast<float>(std::cos(angle));
+    }
+    return embedding;
+}
+
+}  // namespace diffusion
+}  // namespace runanywhere
@@ -0,0 +1,89 @@
+#ifndef RUNANYWHERE_DIFFUSION_SCHEDULER_H
+#define RUNANYWHERE_DIFFUSION_SCHEDULER_H
+
+/**
+ * Noise schedulers for the ONNX diffusion pipeline
+ *
+ * Ports of the diffusers EulerDiscreteScheduler, EulerAncestralDiscreteScheduler
+ * (timestep_spacing="linspace") and LCMScheduler. The few-step samplers are
+ * the point: Euler gives usable images in 15-25 steps and LCM in 2-8, which
+ * is what makes CPU inference practical. Schedules are computed in double
+ * precision once per set_timesteps(); step() is a single pass over the latents.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace runanywhere {
+namespace diffusion {
+
+/** Fields of scheduler/scheduler_config.json that the samplers use */
+struct SchedulerConfig {
+    int32_t num_train_timesteps = 1000;
+    double beta_start = 0.00085;
+    double beta_end = 0.012;
+    bool scaled_linear = true;  // beta_schedule: "scaled_linear" (else "linear")
+    bool v_prediction = false;  // prediction_type: "v_prediction" (else "epsilon")
+    bool lcm = false;           // _class_name: "LCMScheduler"
+
+    // LCM only
+    int32_t original_inference_steps = 50;
+    double timestep_scaling = 10.0;
+
+    /** Parse a diffusers scheduler_config.json; missing fields keep defaults */
+    static SchedulerConfig from_json(const std::string& json_text);
+};
+
+enum class SchedulerKind {
+    EULER = 0,
+    EULER_ANCESTRAL = 1,
+    LCM = 2,
+};
+
+class DiffusionScheduler {
+public:
+    DiffusionScheduler(SchedulerKind kind, const SchedulerConfig& config);
+
+    /** Compute the schedule for num_steps denoising steps */
+    void set_timesteps(int32_t num_steps);
+
+    SchedulerKind kind() const { return kind_; }
+
+    /** UNet timestep for each step */
+    const std::vector<double>& timesteps() const { return timesteps_; }
+
+    /** Standard deviation of the initial latent noise */
+    float init_noise_sigma() const { return init_noise_sigma_; }
+
+    /** Factor applied to the latents before they go into the UNet at step */
+    float input_scale(size_t step) const;
+
+    /**
+     * Advance latents (count floats) in place from the UNet output at step.
+     * Ancestral Euler and LCM draw fresh noise from rng.
+     */
+    void step(size_t step, const float* model_output, float* latents, size_t count,
+              std::mt19937_64& rng) const;
+
+private:
+    SchedulerKind kind_;
+    SchedulerConfig config_;
+    std::vector<double> alphas_cumprod_;
+    std::vector<double> timesteps_;
+    std::vector<double> sigmas_;  // Euler: one per step plus a trailing 0
+    float init_noise_sigma_ = 1.0f;
+};
+
+/**
+ * LCM guidance embedding (timestep_cond input of LCM UNets) for guidance
+ * scale w: sinusoidal embedding of (w - 1) * 1000 with dim values.
+ */
+std::vector<float> guidance_scale_embedding(float guidance_scale, int32_t dim);
+
+}  // namespace diffusion
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_DIFFUSION_SCHEDULER_H
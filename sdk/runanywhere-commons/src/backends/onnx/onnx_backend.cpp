@@ -13,10 +13,12 @@
  */
 
 #include "onnx_backend.h"
+#include "ort_shared_env.h"
 
 #include <dirent.h>
 #include <sys/stat.h>
 
+#include <algorithm>
 #include <cstring>
 
 #include "rac/core/rac_logger.h"
@@ -64,7 +66,7 @@ void ONNXBackendNew::cleanup() {
     vad_.reset();
 
     if (ort_env_) {
-        ort_api_->ReleaseEnv(ort_env_);
+        ort_shared_env_release();
         ort_env_ = nullptr;
     }
 
@@ -90,11 +92,9 @@ bool ONNXBackendNew::initialize_ort() {
         return false;
     }
 
-    OrtStatus* status = ort_api_->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "runanywhere", &ort_env_);
-    if (status) {
-        RAC_LOG_ERROR("ONNX", "Failed to create ONNX Runtime environment: %s",
-                     ort_api_->GetErrorMessage(status));
-        ort_api_->ReleaseStatus(status);
+    // Taken before sherpa-onnx loads models so it joins the env with global pools
+    ort_env_ = ort_shared_env_acquire();
+    if (!ort_env_) {
         return false;
     }
 
@@ -428,7 +428,7 @@ STTResult ONNXSTT::transcribe(const STTRequest& request) {
         return result;
     }
 
-    RAC_LOG_INFO("ONNX.STT", "Transcribing %zu samples at %d Hz", request.audio_samples.size(),
+    RAC_LOG_INFO("ONNX.STT", "Transcribing %zu samples at %d Hz", request.num_samples,
                 request.sample_rate);
 
     const SherpaOnnxOfflineStream* stream = SherpaOnnxCreateOfflineStream(sherpa_recognizer_);
@@ -438,8 +438,8 @@ STTResult ONNXSTT::transcribe(const STTRequest& request) {
         return result;
     }
 
-    SherpaOnnxAcceptWaveformOffline(stream, request.sample_rate, request.audio_samples.data(),
-                                    static_cast<int32_t>(request.audio_samples.size()));
+    SherpaOnnxAcceptWaveformOffline(stream, request.sample_rate, request.audio_samples,
+                                    static_cast<int32_t>(request.num_samples));
 
     RAC_LOG_DEBUG("ONNX.STT", "Decoding audio...");
     SherpaOnnxDecodeOfflineStream(sherpa_recognizer_, stream);
@@ -505,7 +505,7 @@ std::string ONNXSTT::create_stream(const nlohmann::json& config) {
 #endif
 }
 
-bool ONNXSTT::feed_audio(const std::string& stream_id, const std::vector<float>& samples,
+bool ONNXSTT::feed_audio(const std::string& stream_id, const float* samples, size_t num_samples,
                          int sample_rate) {
 #if SHERPA_ONNX_AVAILABLE
     std::lock_guard<std::mutex> lock(mutex_);
@@ -516,8 +516,8 @@ bool ONNXSTT::feed_audio(const std::string& stream_id, const std::vector<float>&
         return false;
     }
 
-    SherpaOnnxAcceptWaveformOffline(it->second, sample_rate, samples.data(),
-                                    static_cast<int32_t>(samples.size()));
+    SherpaOnnxAcceptWaveformOffline(it->second, sample_rate, samples,
+                                    static_cast<int32_t>(num_samples));
 
     return true;
 #else
@@ -1098,28 +1098,41 @@ bool ONNXVAD::configure_vad(const VADConfig& config) {
     return true;
 }
 
-VADResult ONNXVAD::process(const std::vector<float>& audio_samples, int sample_rate) {
+VADResult ONNXVAD::process(const float* audio_samples, size_t num_samples, int sample_rate) {
     VADResult result;
 
 #if SHERPA_ONNX_AVAILABLE
-    if (!sherpa_vad_ || audio_samples.empty()) {
+    if (!sherpa_vad_ || !audio_samples || num_samples == 0) {
         return result;
     }
 
-    const int32_t window_size = 512;  // Silero native window size
+    const size_t window_size = 512;  // Silero native window size
 
-    // Append incoming audio to the pending buffer.
     // Audio capture may deliver chunks smaller than window_size (e.g. 256 samples),
-    // but Silero VAD requires exactly 512 samples per call.
-    pending_samples_.insert(pending_samples_.end(), audio_samples.begin(), audio_samples.end());
-
-    // Feed complete window_size chunks to Silero VAD
-    while (pending_samples_.size() >= static_cast<size_t>(window_size)) {
-        SherpaOnnxVoiceActivityDetectorAcceptWaveform(
-            sherpa_vad_, pending_samples_.data(), window_size);
-        pending_samples_.erase(pending_samples_.begin(), pending_samples_.begin() + window_size);
+    // but Silero VAD requires exactly 512 samples per call. Top up a pending partial
+    // window first, then feed whole windows directly from the caller's buffer and
+    // keep only the remainder.
+    size_t offset = 0;
+    if (!pending_samples_.empty()) {
+        size_t take = std::min(window_size - pending_samples_.size(), num_samples);
+        pending_samples_.insert(pending_samples_.end(), audio_samples, audio_samples + take);
+        offset = take;
+        if (pending_samples_.size() == window_size) {
+            SherpaOnnxVoiceActivityDetectorAcceptWaveform(sherpa_vad_, pending_samples_.data(),
+                                                          static_cast<int32_t>(window_size));
+            pending_samples_.clear();
+        }
+    }
+
+    while (num_samples - offset >= window_size) {
+        SherpaOnnxVoiceActivityDetectorAcceptWaveform(sherpa_vad_, audio_samples + offset,
+                                                      static_cast<int32_t>(window_size));
+        offset += window_size;
     }
 
+    pending_samples_.insert(pending_samples_.end(), audio_samples + offset,
+                            audio_samples + num_samples);
+
     // Check if speech is currently detected in the latest frame
     result.is_speech = SherpaOnnxVoiceActivityDetectorDetected(sherpa_vad_) != 0;
     result.probability = result.is_speech ? 1.0f : 0.0f;
@@ -68,8 +68,10 @@ struct AudioSegment {
     std::string language;
 };
 
+// Audio is borrowed from the caller for the duration of transcribe()
 struct STTRequest {
-    std::vector<float> audio_samples;
+    const float* audio_samples = nullptr;
+    size_t num_samples = 0;
     int sample_rate = 16000;
     std::string language;
     bool detect_language = false;
@@ -256,7 +258,8 @@ class ONNXSTT {
     bool supports_streaming() const;
 
     std::string create_stream(const nlohmann::json& config = {});
-    bool feed_audio(const std::string& stream_id, const std::vector<float>& samples, int sample_rate);
+    bool feed_audio(const std::string& stream_id, const float* samples, size_t num_samples,
+                    int sample_rate);
     bool is_stream_ready(const std::string& stream_id);
     STTResult decode(const std::string& stream_id);
     bool is_endpoint(const std::string& stream_id);
@@ -347,7 +350,10 @@ class ONNXVAD {
     bool unload_model();
 
     bool configure_vad(const VADConfig& config);
-    VADResult process(const std::vector<float>& audio_samples, int sample_rate);
+    VADResult process(const float* audio_samples, size_t num_samples, int sample_rate);
+    VADResult process(const std::vector<float>& audio_samples, int sample_rate) {
+        return process(audio_samples.data(), audio_samples.size(), sample_rate);
+    }
     std::vector<SpeechSegment> detect_segments(const std::vector<float>& audio_samples, int sample_rate);
 
     std::string create_stream(const VADConfig& config = {});
@@ -369,8 +375,9 @@ class ONNXVAD {
     bool model_loaded_ = false;
     mutable std::mutex mutex_;
 
-    // Internal buffer to accumulate audio until we have a full Silero window (512 samples).
-    // Audio capture may deliver chunks smaller than the required window size.
+    // Holds only the tail of a partial Silero window (< 512 samples) between calls.
+    // Audio capture may deliver chunks smaller than the required window size;
+    // full windows are fed straight from the caller's buffer.
     std::vector<float> pending_samples_;
 };
 
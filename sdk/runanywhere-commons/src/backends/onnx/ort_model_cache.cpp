@@ -0,0 +1,449 @@
+/**
+ * ONNX Runtime optimized-model cache and session prewarm
+ */
+
+#include "ort_model_cache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_logger.h"
+#include "rac/infrastructure/model_management/rac_model_paths.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#define RAC_ORT_CACHE_X86 1
+#elif defined(__APPLE__)
+#include <sys/sysctl.h>
+#elif defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace runanywhere {
+
+namespace {
+
+// Bytes hashed from each end of the model file. Size and mtime cover the rest.
+constexpr size_t kFingerprintSampleBytes = 64 * 1024;
+
+// Session config entries that change the graph ORT saves
+constexpr const char* kGraphConfigKeys[] = {
+    "session.disable_quant_qdq",
+    "session.enable_quant_qdq_cleanup",
+    "session.disable_double_qdq_remover",
+    "session.qdqisint8allowed",
+    "session.x64quantprecision",
+    "session.disable_aot_function_inlining",
+    "optimization.enable_gelu_approximation",
+    "optimization.disable_specified_optimizers",
+    "optimization.minimal_build_optimizations",
+    "mlas.enable_gemm_fastmath_arm64_bfloat16",
+};
+
+const OrtApi* ort_api() {
+    static const OrtApi* api = OrtGetApiBase()->GetApi(ORT_API_VERSION);
+    return api;
+}
+
+uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+constexpr uint64_t kFnvOffset = 0xcbf29ce484222325ULL;
+
+std::string to_hex(uint64_t value) {
+    char buffer[17];
+    std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, value);
+    return buffer;
+}
+
+// Size, mtime and the first and last 64 KiB: cheap enough for every load.
+// An edit in the middle that keeps both size and mtime is not detected.
+bool fingerprint_file(const std::string& path, uint64_t& hash) {
+    std::error_code ec;
+    const uint64_t size = fs::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    const auto mtime = fs::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) {
+        return false;
+    }
+
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    hash = fnv1a(hash, &size, sizeof(size));
+    hash = fnv1a(hash, &mtime, sizeof(mtime));
+
+    std::vector<char> sample(static_cast<size_t>(std::min<uint64_t>(size, kFingerprintSampleBytes)));
+    file.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+    hash = fnv1a(hash, sample.data(), static_cast<size_t>(file.gcount()));
+    if (size > kFingerprintSampleBytes) {
+        file.seekg(static_cast<std::streamoff>(size - kFingerprintSampleBytes));
+        file.read(sample.data(), static_cast<std::streamsize>(sample.size()));
+        hash = fnv1a(hash, sample.data(), static_cast<size_t>(file.gcount()));
+    }
+    return !file.bad();
+}
+
+// Features the CPU execution provider picks kernels and layouts by
+uint64_t cpu_fingerprint() {
+    static const uint64_t fingerprint = [] {
+        uint64_t hash = kFnvOffset;
+#if defined(RAC_ORT_CACHE_X86)
+        // Leaf 1 ECX/EDX (SSE to AVX, FMA, F16C) and leaf 7 (AVX2, AVX-512, VNNI, AMX)
+        const unsigned int leaves[][2] = {{1, 0}, {7, 0}, {7, 1}};
+        for (const auto& leaf : leaves) {
+            unsigned int regs[4] = {};
+#if defined(_MSC_VER)
+            int out[4];
+            __cpuidex(out, static_cast<int>(leaf[0]), static_cast<int>(leaf[1]));
+            std::memcpy(regs, out, sizeof(regs));
+#else
+            __get_cpuid_count(leaf[0], leaf[1], &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+            if (leaf[0] == 1) {
+                regs[0] = regs[1] = 0;  // Stepping and APIC id vary between cores
+            }
+            hash = fnv1a(hash, regs, sizeof(regs));
+        }
+#elif defined(__APPLE__)
+        uint32_t family = 0;
+        size_t size = sizeof(family);
+        if (sysctlbyname("hw.cpufamily", &family, &size, nullptr, 0) == 0) {
+            hash = fnv1a(hash, &family, sizeof(family));
+        }
+#elif defined(__linux__)
+        const unsigned long hwcap[] = {getauxval(AT_HWCAP),
+#if defined(AT_HWCAP2)
+                                       getauxval(AT_HWCAP2)
+#else
+                                       0
+#endif
+        };
+        hash = fnv1a(hash, hwcap, sizeof(hwcap));
+#endif
+        return hash;
+    }();
+    return fingerprint;
+}
+
+// Session config entries from kGraphConfigKeys that are set on options
+uint64_t hash_graph_config(uint64_t hash, const OrtSessionOptions* options) {
+    const OrtApi* api = ort_api();
+    for (const char* key : kGraphConfigKeys) {
+        int present = 0;
+        OrtStatus* status = api->HasSessionConfigEntry(options, key, &present);
+        if (!status && present) {
+            size_t size = 0;
+            status = api->GetSessionConfigEntry(options, key, nullptr, &size);
+            std::string value(size, '\0');
+            if (!status) {
+                status = api->GetSessionConfigEntry(options, key, value.data(), &size);
+            }
+            if (!status) {
+                hash = fnv1a(hash, key, std::strlen(key) + 1);
+                hash = fnv1a(hash, value.data(), value.size());
+            }
+        }
+        if (status) {
+            api->ReleaseStatus(status);
+        }
+    }
+    return hash;
+}
+
+std::string cache_directory() {
+    char buffer[1024];
+    if (rac_model_paths_get_cache_directory(buffer, sizeof(buffer)) != RAC_SUCCESS) {
+        return "";
+    }
+    std::string dir = std::string(buffer) + "/ort";
+    std::error_code ec;
+    fs::create_directories(dir, ec);
+    return ec ? "" : dir;
+}
+
+// Older entries for the same model path: superseded by a new one
+void remove_stale_entries(const fs::path& entry) {
+    const std::string name = entry.filename().string();
+    const std::string prefix = name.substr(0, name.find('-') + 1);
+
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(entry.parent_path(), ec)) {
+        const std::string other = file.path().filename().string();
+        if (other != name && other.compare(0, prefix.size(), prefix) == 0 &&
+            other.find(".tmp") == std::string::npos) {
+            fs::remove(file.path(), ec);
+        }
+    }
+}
+
+bool set_level(OrtSessionOptions* options, GraphOptimizationLevel level) {
+    OrtStatus* status = ort_api()->SetSessionGraphOptimizationLevel(options, level);
+    if (status) {
+        RAC_LOG_WARNING("ONNX", "Failed to set graph optimization level: %s",
+                        ort_api()->GetErrorMessage(status));
+        ort_api()->ReleaseStatus(status);
+        return false;
+    }
+    return true;
+}
+
+bool is_past_input(const std::string& name) {
+    return name.find("past") != std::string::npos || name.find("cache") != std::string::npos;
+}
+
+size_t element_size(ONNXTensorElementDataType type) {
+    switch (type) {
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_BOOL:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT8:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT8:
+            return 1;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT16:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT16:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT16:
+            return 2;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT32:
+            return 4;
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+        case ONNX_TENSOR_ELEMENT_DATA_TYPE_UINT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+}  // namespace
+
+// =============================================================================
+// Optimized-model cache
+// =============================================================================
+
+OrtCachedModel ort_model_cache_prepare(const char* model_path, GraphOptimizationLevel level,
+                                       OrtSessionOptions* options,
+                                       const char* execution_providers) {
+    OrtCachedModel model;
+    model.load_path = model_path;
+
+    if (!set_level(options, level) || level == ORT_DISABLE_ALL) {
+        return model;
+    }
+
+    const std::string dir = cache_directory();
+    if (dir.empty()) {
+        return model;
+    }
+
+    std::error_code ec;
+    const std::string absolute = fs::absolute(model_path, ec).string();
+    const std::string path_prefix =
+        dir + "/" + to_hex(fnv1a(kFnvOffset, absolute.data(), absolute.size()));
+
+    uint64_t key = kFnvOffset;
+    if (!fingerprint_file(model_path, key)) {
+        return model;
+    }
+
+    const std::string version = OrtGetApiBase()->GetVersionString();
+    const std::string providers = execution_providers ? execution_providers : "CPU";
+    const uint64_t cpu = cpu_fingerprint();
+    key = fnv1a(key, version.data(), version.size() + 1);
+    key = fnv1a(key, &level, sizeof(level));
+    key = fnv1a(key, providers.data(), providers.size() + 1);
+    key = hash_graph_config(key, options);
+    key = fnv1a(key, &cpu, sizeof(cpu));
+
+    model.cache_path = path_prefix + "-" + to_hex(key) + ".onnx";
+
+    if (fs::exists(model.cache_path, ec)) {
+        // Already optimized: skip the optimizer entirely
+        if (set_level(options, ORT_DISABLE_ALL)) {
+            model.load_path = model.cache_path;
+            model.hit = true;
+        }
+        return model;
+    }
+
+    // Unique per writer so concurrent cold starts never share a file
+    const size_t writer = std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+                          static_cast<size_t>(
+                              std::chrono::steady_clock::now().time_since_epoch().count());
+    model.pending_path = model.cache_path + ".tmp" + to_hex(writer);
+
+    OrtStatus* status = ort_api()->SetOptimizedModelFilePath(options, model.pending_path.c_str());
+    if (status) {
+        ort_api()->ReleaseStatus(status);
+        model.pending_path.clear();
+    }
+    return model;
+}
+
+void ort_model_cache_finish(const OrtCachedModel& model, bool session_created) {
+    std::error_code ec;
+
+    if (model.hit) {
+        if (!session_created) {
+            RAC_LOG_WARNING("ONNX", "Dropping unusable optimized model cache entry: %s",
+                            model.cache_path.c_str());
+            fs::remove(model.cache_path, ec);
+        }
+        return;
+    }
+
+    if (model.pending_path.empty()) {
+        return;
+    }
+
+    if (session_created) {
+        fs::rename(model.pending_path, model.cache_path, ec);
+        if (!ec) {
+            remove_stale_entries(model.cache_path);
+            RAC_LOG_INFO("ONNX", "Cached optimized model: %s", model.cache_path.c_str());
+            return;
+        }
+    }
+    fs::remove(model.pending_path, ec);
+}
+
+// =============================================================================
+// Prewarm
+// =============================================================================
+
+void ort_session_prewarm(OrtSession* session) {
+    const OrtApi* api = ort_api();
+    const auto start = std::chrono::steady_clock::now();
+
+    OrtAllocator* allocator = nullptr;
+    OrtMemoryInfo* memory_info = nullptr;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+    std::vector<std::vector<char>> buffers;
+    std::vector<OrtValue*> inputs;
+    std::vector<OrtValue*> outputs;
+
+    // Walks the session signature; any failure skips the prewarm
+    auto run = [&]() -> OrtStatus* {
+        OrtStatus* status = api->GetAllocatorWithDefaultOptions(&allocator);
+        if (status) return status;
+        status = api->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info);
+        if (status) return status;
+
+        size_t input_count = 0;
+        size_t output_count = 0;
+        if ((status = api->SessionGetInputCount(session, &input_count))) return status;
+        if ((status = api->SessionGetOutputCount(session, &output_count))) return status;
+
+        for (size_t i = 0; i < output_count; ++i) {
+            char* name = nullptr;
+            if ((status = api->SessionGetOutputName(session, i, allocator, &name))) return status;
+            output_names.emplace_back(name);
+            api->AllocatorFree(allocator, name);
+        }
+
+        for (size_t i = 0; i < input_count; ++i) {
+            char* name = nullptr;
+            if ((status = api->SessionGetInputName(session, i, allocator, &name))) return status;
+            input_names.emplace_back(name);
+            api->AllocatorFree(allocator, name);
+
+            OrtTypeInfo* type_info = nullptr;
+            if ((status = api->SessionGetInputTypeInfo(session, i, &type_info))) return status;
+
+            const OrtTensorTypeAndShapeInfo* tensor_info = nullptr;
+            ONNXTensorElementDataType type = ONNX_TENSOR_ELEMENT_DATA_TYPE_UNDEFINED;
+            size_t rank = 0;
+            std::vector<int64_t> shape;
+            status = api->CastTypeInfoToTensorInfo(type_info, &tensor_info);
+            if (!status && tensor_info) {
+                status = api->GetTensorElementType(tensor_info, &type);
+                if (!status) status = api->GetDimensionsCount(tensor_info, &rank);
+                if (!status) {
+                    shape.resize(rank);
+                    status = api->GetDimensions(tensor_info, shape.data(), rank);
+                }
+            }
+            api->ReleaseTypeInfo(type_info);
+            if (status) return status;
+
+            const size_t bytes_per_element = element_size(type);
+            if (!tensor_info || bytes_per_element == 0) {
+                return api->CreateStatus(ORT_NOT_IMPLEMENTED, "unsupported input type");
+            }
+
+            size_t elements = 1;
+            const int64_t dynamic = is_past_input(input_names.back()) ? 0 : 1;
+            for (auto& dim : shape) {
+                if (dim <= 0) {
+                    dim = dynamic;
+                }
+                elements *= static_cast<size_t>(dim);
+            }
+
+            // Keep at least one byte so empty tensors still get a valid pointer
+            buffers.emplace_back(std::max<size_t>(elements * bytes_per_element, 1), 0);
+            OrtValue* value = nullptr;
+            status = api->CreateTensorWithDataAsOrtValue(memory_info, buffers.back().data(),
+                                                         elements * bytes_per_element,
+                                                         shape.data(), shape.size(), type, &value);
+            if (status) return status;
+            inputs.push_back(value);
+        }
+
+        std::vector<const char*> input_ptrs;
+        std::vector<const char*> output_ptrs;
+        for (const auto& name : input_names) input_ptrs.push_back(name.c_str());
+        for (const auto& name : output_names) output_ptrs.push_back(name.c_str());
+        outputs.resize(output_ptrs.size(), nullptr);
+
+        return api->Run(session, nullptr, input_ptrs.data(), inputs.data(), inputs.size(),
+                        output_ptrs.data(), output_ptrs.size(), outputs.data());
+    };
+
+    OrtStatus* status = run();
+    if (status) {
+        RAC_LOG_WARNING("ONNX", "Session prewarm skipped: %s", api->GetErrorMessage(status));
+        api->ReleaseStatus(status);
+    } else {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+        RAC_LOG_INFO("ONNX", "Session prewarmed in %lld ms",
+                     static_cast<long long>(elapsed.count()));
+    }
+
+    for (OrtValue* value : outputs) {
+        if (value) api->ReleaseValue(value);
+    }
+    for (OrtValue* value : inputs) {
+        api->ReleaseValue(value);
+    }
+    if (memory_info) {
+        api->ReleaseMemoryInfo(memory_info);
+    }
+}
+
+}  // namespace runanywhere
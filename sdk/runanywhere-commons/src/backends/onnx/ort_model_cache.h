@@ -0,0 +1,63 @@
+#ifndef RUNANYWHERE_ORT_MODEL_CACHE_H
+#define RUNANYWHERE_ORT_MODEL_CACHE_H
+
+/**
+ * ONNX Runtime cold-start helpers
+ *
+ * - Optimized-model cache: the first load of a model at a given graph
+ *   optimization level saves ORT's optimized graph under
+ *   `{cache_dir}/ort/`; later loads read that file with optimization
+ *   disabled. Entries are keyed by a fingerprint of the model file, the
+ *   ORT version, the optimization level, the execution providers, the
+ *   session config entries that steer graph rewrites and the CPU features.
+ *   The fingerprint is the size, mtime and first and last 64 KiB, so the
+ *   key trusts size and mtime: a model rewritten in the middle with both
+ *   preserved keeps its stale entry. The cache is active once the SDK base
+ *   directory is set (rac_model_paths_set_base_dir).
+ * - Prewarm: one inference on zero-filled inputs so the first real request
+ *   does not pay for allocation and kernel selection.
+ */
+
+#include <onnxruntime_c_api.h>
+
+#include <string>
+
+#include "ort_shared_env.h"
+
+namespace runanywhere {
+
+struct OrtCachedModel {
+    std::string load_path;     // File to create the session from
+    std::string cache_path;    // Cache entry; empty when caching is off
+    std::string pending_path;  // Written by ORT on a miss, published by finish
+    bool hit = false;
+};
+
+/**
+ * Set the optimization level on options and point them at the cache.
+ *
+ * On a hit, load_path is the cached model and optimization is disabled.
+ * On a miss, ORT is asked to save the optimized graph to pending_path.
+ * execution_providers names the providers appended to options, in order
+ * (e.g. "XNNPACK,CPU"); nullptr means the CPU provider alone.
+ */
+RAC_ORT_SHARED_API OrtCachedModel ort_model_cache_prepare(const char* model_path,
+                                                         GraphOptimizationLevel level,
+                                                         OrtSessionOptions* options,
+                                                         const char* execution_providers = nullptr);
+
+/**
+ * Publish or discard the entry once the session was (or was not) created.
+ * A cache hit that failed to load is removed so the next load rebuilds it.
+ */
+RAC_ORT_SHARED_API void ort_model_cache_finish(const OrtCachedModel& model, bool session_created);
+
+/**
+ * Run the session once on zero-filled inputs. Dynamic dimensions are 1, or
+ * 0 for past key/value inputs (empty cache). Failures are logged and ignored.
+ */
+RAC_ORT_SHARED_API void ort_session_prewarm(OrtSession* session);
+
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_ORT_MODEL_CACHE_H
@@ -0,0 +1,200 @@
+/**
+ * Process-wide ONNX Runtime environment with global thread pools
+ */
+
+#include "ort_shared_env.h"
+#include "ort_model_cache.h"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+#include "rac/core/rac_logger.h"
+
+namespace runanywhere {
+
+namespace {
+
+// Matches the per-session count the RAG providers used to hard-code
+constexpr int kMaxSharedIntraOpThreads = 4;
+
+std::mutex g_mutex;
+const OrtApi* g_api = nullptr;
+OrtEnv* g_env = nullptr;
+int g_refs = 0;
+
+// ORT keeps one OrtEnv per process. If another library (sherpa-onnx) created
+// it first, our options are ignored and there are no global pools to join.
+bool g_global_pools_usable = true;
+
+int shared_intra_op_threads() {
+    const int hardware = static_cast<int>(std::thread::hardware_concurrency());
+    return hardware > 0 ? std::min(hardware, kMaxSharedIntraOpThreads) : 2;
+}
+
+bool check(OrtStatus* status, const char* what) {
+    if (!status) {
+        return true;
+    }
+    RAC_LOG_ERROR("ONNX", "%s: %s", what, g_api->GetErrorMessage(status));
+    g_api->ReleaseStatus(status);
+    return false;
+}
+
+OrtEnv* create_env() {
+    OrtThreadingOptions* threading = nullptr;
+    if (!check(g_api->CreateThreadingOptions(&threading), "Failed to create threading options")) {
+        return nullptr;
+    }
+
+    const int intra_op_threads = shared_intra_op_threads();
+    OrtEnv* env = nullptr;
+    // Pools are shared by bursty workloads: park idle threads instead of spinning
+    bool ok = check(g_api->SetGlobalIntraOpNumThreads(threading, intra_op_threads),
+                    "Failed to set global intra-op threads") &&
+              check(g_api->SetGlobalInterOpNumThreads(threading, 1),
+                    "Failed to set global inter-op threads") &&
+              check(g_api->SetGlobalSpinControl(threading, 0), "Failed to set spin control") &&
+              check(g_api->CreateEnvWithGlobalThreadPools(ORT_LOGGING_LEVEL_WARNING, "runanywhere",
+                                                          threading, &env),
+                    "Failed to create ONNX Runtime environment");
+    g_api->ReleaseThreadingOptions(threading);
+
+    if (ok) {
+        RAC_LOG_INFO("ONNX", "Shared ONNX Runtime environment created (intra-op threads=%d)",
+                     intra_op_threads);
+    }
+    return ok ? env : nullptr;
+}
+
+OrtStatus* apply_threading(OrtSessionOptions* options, OrtSessionPriority priority,
+                           bool use_global_pools) {
+    if (priority == OrtSessionPriority::NORMAL && use_global_pools) {
+        return g_api->DisablePerSessionThreads(options);
+    }
+
+    const int threads = priority == OrtSessionPriority::REALTIME ? 1 : shared_intra_op_threads();
+    if (OrtStatus* status = g_api->SetIntraOpNumThreads(options, threads)) {
+        return status;
+    }
+    return g_api->SetInterOpNumThreads(options, 1);
+}
+
+OrtStatus* clone_options(const OrtSessionOptions* options, OrtSessionPriority priority,
+                         bool use_global_pools, OrtSessionOptions** out_options) {
+    if (OrtStatus* status = g_api->CloneSessionOptions(options, out_options)) {
+        return status;
+    }
+    OrtStatus* status = apply_threading(*out_options, priority, use_global_pools);
+    if (status) {
+        g_api->ReleaseSessionOptions(*out_options);
+        *out_options = nullptr;
+    }
+    return status;
+}
+
+OrtStatus* create_session(const char* model_path, const OrtSessionOptions* options,
+                          OrtSessionPriority priority, GraphOptimizationLevel level,
+                          bool use_global_pools, OrtSession** out_session) {
+    OrtSessionOptions* session_options = nullptr;
+    if (OrtStatus* status = clone_options(options, priority, use_global_pools, &session_options)) {
+        return status;
+    }
+
+    OrtCachedModel cached = ort_model_cache_prepare(model_path, level, session_options);
+    OrtStatus* status =
+        g_api->CreateSession(g_env, cached.load_path.c_str(), session_options, out_session);
+    g_api->ReleaseSessionOptions(session_options);
+    ort_model_cache_finish(cached, status == nullptr);
+
+    if (!status || (!cached.hit && cached.pending_path.empty())) {
+        return status;
+    }
+
+    // The cache got in the way (bad entry, or the graph could not be saved):
+    // load the original model without it
+    g_api->ReleaseStatus(status);
+    if ((status = clone_options(options, priority, use_global_pools, &session_options))) {
+        return status;
+    }
+    status = g_api->SetSessionGraphOptimizationLevel(session_options, level);
+    if (!status) {
+        status = g_api->CreateSession(g_env, model_path, session_options, out_session);
+    }
+    g_api->ReleaseSessionOptions(session_options);
+    return status;
+}
+
+}  // namespace
+
+OrtEnv* ort_shared_env_acquire() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    if (g_env) {
+        ++g_refs;
+        return g_env;
+    }
+
+    if (!g_api) {
+        const OrtApiBase* base = OrtGetApiBase();
+        g_api = base ? base->GetApi(ORT_API_VERSION) : nullptr;
+        if (!g_api) {
+            RAC_LOG_ERROR("ONNX", "Failed to get ONNX Runtime API");
+            return nullptr;
+        }
+    }
+
+    g_env = create_env();
+    if (g_env) {
+        g_refs = 1;
+    }
+    return g_env;
+}
+
+void ort_shared_env_release() {
+    std::lock_guard<std::mutex> lock(g_mutex);
+
+    if (g_refs == 0 || --g_refs > 0) {
+        return;
+    }
+    g_api->ReleaseEnv(g_env);
+    g_env = nullptr;
+}
+
+OrtStatus* ort_shared_create_session(const char* model_path, const OrtSessionOptions* options,
+                                     OrtSessionPriority priority, GraphOptimizationLevel level,
+                                     OrtSession** out_session) {
+    bool use_global_pools;
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        if (!g_env) {
+            return OrtGetApiBase()->GetApi(ORT_API_VERSION)->CreateStatus(
+                ORT_FAIL, "Shared ONNX Runtime environment not acquired");
+        }
+        use_global_pools = g_global_pools_usable;
+    }
+
+    OrtStatus* status = create_session(model_path, options, priority, level, use_global_pools,
+                                       out_session);
+    if (!status || !use_global_pools || priority != OrtSessionPriority::NORMAL) {
+        return status;
+    }
+
+    // The env may predate us without global pools; retry with a small own pool
+    OrtStatus* retry = create_session(model_path, options, priority, level, false, out_session);
+    if (retry) {
+        g_api->ReleaseStatus(retry);
+        return status;
+    }
+
+    RAC_LOG_WARNING("ONNX", "Global ORT thread pools unavailable, using per-session pools: %s",
+                    g_api->GetErrorMessage(status));
+    g_api->ReleaseStatus(status);
+    {
+        std::lock_guard<std::mutex> lock(g_mutex);
+        g_global_pools_usable = false;
+    }
+    return nullptr;
+}
+
+}  // namespace runanywhere
@@ -0,0 +1,64 @@
+#ifndef RUNANYWHERE_ORT_SHARED_ENV_H
+#define RUNANYWHERE_ORT_SHARED_ENV_H
+
+/**
+ * Process-wide ONNX Runtime environment
+ *
+ * Every ORT session in the SDK (RAG embeddings and generation, wake word,
+ * the ONNX backend) is created on one OrtEnv that owns global intra- and
+ * inter-op thread pools. Batch sessions run on those pools instead of each
+ * spinning up its own; realtime sessions keep a small dedicated pool so they
+ * never queue behind batch work.
+ */
+
+#include <onnxruntime_c_api.h>
+
+#if defined(RAC_ONNX_BUILDING)
+#if defined(_WIN32)
+#define RAC_ORT_SHARED_API __declspec(dllexport)
+#elif defined(__GNUC__) || defined(__clang__)
+#define RAC_ORT_SHARED_API __attribute__((visibility("default")))
+#else
+#define RAC_ORT_SHARED_API
+#endif
+#else
+#define RAC_ORT_SHARED_API
+#endif
+
+namespace runanywhere {
+
+enum class OrtSessionPriority {
+    NORMAL = 0,    // Runs on the shared global thread pools
+    REALTIME = 1,  // Dedicated single-threaded pool (wake word)
+};
+
+/**
+ * Take a reference to the shared environment, creating it on first use.
+ * Returns nullptr if ONNX Runtime could not be initialized.
+ * Every successful call must be paired with ort_shared_env_release().
+ */
+RAC_ORT_SHARED_API OrtEnv* ort_shared_env_acquire();
+
+/**
+ * Drop a reference; the environment is released with the last one.
+ */
+RAC_ORT_SHARED_API void ort_shared_env_release();
+
+/**
+ * Create a session on the shared environment.
+ *
+ * options is copied; its threading settings are replaced according to
+ * priority and its optimization level by level. Optimized graphs are
+ * reused across process starts (see ort_model_cache.h).
+ * The caller must hold a reference from ort_shared_env_acquire().
+ * Returns nullptr on success, otherwise a status the caller releases.
+ */
+RAC_ORT_SHARED_API OrtStatus* ort_shared_create_session(const char* model_path,
+                                                       const OrtSessionOptions* options,
+                                                       OrtSessionPriority priority,
+                                                       GraphOptimizationLevel level,
+                                                       OrtSession** out_session);
+
+}  // namespace runanywhere
+
+#endif  // RUNANYWHERE_ORT_SHARED_ENV_H
@@ -3,9 +3,10 @@
  * @brief RunAnywhere Core - ONNX Backend RAC Registration
  *
  * Registers the ONNX backend with the module and service registries.
- * Provides vtable implementations for STT, TTS, and VAD services.
+ * Provides vtable implementations for STT, TTS, VAD and diffusion services.
  */
 
+#include "rac_diffusion_onnx.h"
 #include "rac_stt_onnx.h"
 #include "rac_tts_onnx.h"
 #include "rac_vad_onnx.h"
@@ -21,9 +22,11 @@
 namespace fs = std::filesystem;
 #endif
 
+#include "rac/core/rac_audio_utils.h"
 #include "rac/core/rac_core.h"
 #include "rac/core/rac_error.h"
 #include "rac/core/rac_logger.h"
+#include "rac/features/diffusion/rac_diffusion_service.h"
 #include "rac/features/stt/rac_stt_service.h"
 #include "rac/features/tts/rac_tts_service.h"
 #include "rac/infrastructure/model_management/rac_model_strategy.h"
@@ -37,22 +40,6 @@ namespace {
 
 const char* LOG_CAT = "ONNX";
 
-/**
- * Convert Int16 PCM audio to Float32 normalized to [-1.0, 1.0].
- * SDKs may send Int16 audio but Sherpa-ONNX expects Float32.
- */
-static std::vector<float> convert_int16_to_float32(const void* int16_data, size_t byte_count) {
-    const int16_t* samples = static_cast<const int16_t*>(int16_data);
-    size_t num_samples = byte_count / sizeof(int16_t);
-
-    std::vector<float> float_samples(num_samples);
-    for (size_t i = 0; i < num_samples; ++i) {
-        float_samples[i] = static_cast<float>(samples[i]) / 32768.0f;
-    }
-
-    return float_samples;
-}
-
 // Initialize (no-op for ONNX - model loaded during create)
 static rac_result_t onnx_stt_vtable_initialize(void* impl, const char* model_path) {
     (void)impl;
@@ -73,8 +60,38 @@ static rac_result_t onnx_stt_vtable_transcribe(void* impl, const void* audio_dat
         out_result->confidence = 0.0f;
         return RAC_SUCCESS;
     }
-    std::vector<float> float_samples = convert_int16_to_float32(audio_data, audio_size);
-    return rac_stt_onnx_transcribe(impl, float_samples.data(), float_samples.size(), options,
+    // SDKs send Int16 but Sherpa-ONNX expects Float32; convert once into pooled scratch
+    rac::MonoFloatAudio samples(static_cast<const int16_t*>(audio_data),
+                                audio_size / sizeof(int16_t));
+    if (!samples.ok()) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    return rac_stt_onnx_transcribe(impl, samples.data(), samples.size(), options, out_result);
+}
+
+// Transcribe an audio view - Float32 mono input reaches Sherpa-ONNX without a copy
+static rac_result_t onnx_stt_vtable_transcribe_audio(void* impl, const rac_audio_view_t* audio,
+                                                     const rac_stt_options_t* options,
+                                                     rac_stt_result_t* out_result) {
+    if (!audio || !audio->data || !out_result) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    // Same ~0.05s floor as the Int16 path to avoid Sherpa crash on tiny input
+    if (audio->num_frames < 800) {
+        out_result->text = nullptr;
+        out_result->confidence = 0.0f;
+        return RAC_SUCCESS;
+    }
+    rac::MonoFloatAudio samples(*audio);
+    if (!samples.ok()) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    rac_stt_options_t view_options = options ? *options : RAC_STT_OPTIONS_DEFAULT;
+    if (audio->sample_rate > 0) {
+        view_options.sample_rate = audio->sample_rate;
+    }
+    return rac_stt_onnx_transcribe(impl, samples.data(), samples.size(), &view_options,
                                    out_result);
 }
 
@@ -92,9 +109,14 @@ static rac_result_t onnx_stt_vtable_transcribe_stream(void* impl, const void* au
         return result;
     }
 
-    std::vector<float> float_samples = convert_int16_to_float32(audio_data, audio_size);
+    rac::MonoFloatAudio samples(static_cast<const int16_t*>(audio_data),
+                                audio_size / sizeof(int16_t));
+    if (!samples.ok()) {
+        rac_stt_onnx_destroy_stream(impl, stream);
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
 
-    result = rac_stt_onnx_feed_audio(impl, stream, float_samples.data(), float_samples.size());
+    result = rac_stt_onnx_feed_audio(impl, stream, samples.data(), samples.size());
     if (result != RAC_SUCCESS) {
         rac_stt_onnx_destroy_stream(impl, stream);
         return result;
@@ -146,6 +168,7 @@ static const rac_stt_service_ops_t g_onnx_stt_ops = {
     .get_info = onnx_stt_vtable_get_info,
     .cleanup = onnx_stt_vtable_cleanup,
     .destroy = onnx_stt_vtable_destroy,
+    .transcribe_audio = onnx_stt_vtable_transcribe_audio,
 };
 
 // =============================================================================
@@ -213,6 +236,69 @@ static const rac_tts_service_ops_t g_onnx_tts_ops = {
     .destroy = onnx_tts_vtable_destroy,
 };
 
+// =============================================================================
+// DIFFUSION VTABLE IMPLEMENTATION
+// =============================================================================
+
+// Initialize (no-op - sessions are created with the service)
+static rac_result_t onnx_diffusion_vtable_initialize(void* impl, const char* model_path,
+                                                     const rac_diffusion_config_t* config) {
+    (void)impl;
+    (void)model_path;
+    (void)config;
+    return RAC_SUCCESS;
+}
+
+static rac_result_t onnx_diffusion_vtable_generate(void* impl,
+                                                   const rac_diffusion_options_t* options,
+                                                   rac_diffusion_result_t* out_result) {
+    return rac_diffusion_onnx_generate(impl, options, out_result);
+}
+
+static rac_result_t onnx_diffusion_vtable_generate_with_progress(
+    void* impl, const rac_diffusion_options_t* options,
+    rac_diffusion_progress_callback_fn progress_callback, void* user_data,
+    rac_diffusion_result_t* out_result) {
+    return rac_diffusion_onnx_generate_with_progress(impl, options, progress_callback, user_data,
+                                                     out_result);
+}
+
+static rac_result_t onnx_diffusion_vtable_get_info(void* impl, rac_diffusion_info_t* out_info) {
+    return rac_diffusion_onnx_get_info(impl, out_info);
+}
+
+static uint32_t onnx_diffusion_vtable_get_capabilities(void* impl) {
+    (void)impl;
+    return RAC_DIFFUSION_CAP_TEXT_TO_IMAGE;
+}
+
+static rac_result_t onnx_diffusion_vtable_cancel(void* impl) {
+    rac_diffusion_onnx_cancel(impl);
+    return RAC_SUCCESS;
+}
+
+static rac_result_t onnx_diffusion_vtable_cleanup(void* impl) {
+    (void)impl;
+    return RAC_SUCCESS;
+}
+
+static void onnx_diffusion_vtable_destroy(void* impl) {
+    if (impl) {
+        rac_diffusion_onnx_destroy(impl);
+    }
+}
+
+static const rac_diffusion_service_ops_t g_onnx_diffusion_ops = {
+    .initialize = onnx_diffusion_vtable_initialize,
+    .generate = onnx_diffusion_vtable_generate,
+    .generate_with_progress = onnx_diffusion_vtable_generate_with_progress,
+    .get_info = onnx_diffusion_vtable_get_info,
+    .get_capabilities = onnx_diffusion_vtable_get_capabilities,
+    .cancel = onnx_diffusion_vtable_cancel,
+    .cleanup = onnx_diffusion_vtable_cleanup,
+    .destroy = onnx_diffusion_vtable_destroy,
+};
+
 // =============================================================================
 // SERVICE PROVIDERS
 // =============================================================================
@@ -221,6 +307,7 @@ const char* const MODULE_ID = "onnx";
 const char* const STT_PROVIDER_NAME = "ONNXSTTService";
 const char* const TTS_PROVIDER_NAME = "ONNXTTSService";
 const char* const VAD_PROVIDER_NAME = "ONNXVADService";
+const char* const DIFFUSION_PROVIDER_NAME = "ONNXDiffusionService";
 
 // STT can_handle
 rac_bool_t onnx_stt_can_handle(const rac_service_request_t* request, void* user_data) {
@@ -364,6 +451,63 @@ rac_handle_t onnx_vad_create(const rac_service_request_t* request, void* user_da
     return (result == RAC_SUCCESS) ? handle : nullptr;
 }
 
+// Diffusion can_handle - diffusers ONNX export layout (unet/model.onnx)
+rac_bool_t onnx_diffusion_can_handle(const rac_service_request_t* request, void* user_data) {
+    (void)user_data;
+
+    if (request == nullptr) {
+        return RAC_FALSE;
+    }
+
+    const char* path = request->model_path ? request->model_path : request->identifier;
+    if (path == nullptr || path[0] == '\0') {
+        return RAC_FALSE;
+    }
+    if (request->framework != RAC_FRAMEWORK_ONNX && request->framework != RAC_FRAMEWORK_UNKNOWN) {
+        return RAC_FALSE;
+    }
+
+#ifndef __EMSCRIPTEN__
+    std::error_code ec;
+    return fs::exists(fs::path(path) / "unet" / "model.onnx", ec) ? RAC_TRUE : RAC_FALSE;
+#else
+    return request->framework == RAC_FRAMEWORK_ONNX ? RAC_TRUE : RAC_FALSE;
+#endif
+}
+
+// Diffusion create with vtable
+rac_handle_t onnx_diffusion_create(const rac_service_request_t* request, void* user_data) {
+    (void)user_data;
+
+    if (request == nullptr) {
+        return nullptr;
+    }
+
+    const char* path = request->model_path ? request->model_path : request->identifier;
+    RAC_LOG_INFO(LOG_CAT, "Creating ONNX diffusion service for: %s", path ? path : "(null)");
+
+    rac_handle_t backend_handle = nullptr;
+    rac_result_t result = rac_diffusion_onnx_create(path, nullptr, &backend_handle);
+    if (result != RAC_SUCCESS) {
+        RAC_LOG_ERROR(LOG_CAT, "Failed to create ONNX diffusion backend: %d", result);
+        return nullptr;
+    }
+
+    auto* service =
+        static_cast<rac_diffusion_service_t*>(malloc(sizeof(rac_diffusion_service_t)));
+    if (!service) {
+        rac_diffusion_onnx_destroy(backend_handle);
+        return nullptr;
+    }
+
+    service->ops = &g_onnx_diffusion_ops;
+    service->impl = backend_handle;
+    service->model_id = request->identifier ? strdup(request->identifier) : nullptr;
+
+    RAC_LOG_INFO(LOG_CAT, "ONNX diffusion service created successfully");
+    return service;
+}
+
 // =============================================================================
 // STORAGE AND DOWNLOAD STRATEGIES
 // =============================================================================
@@ -488,15 +632,16 @@ rac_result_t rac_backend_onnx_register(void) {
         return RAC_ERROR_MODULE_ALREADY_REGISTERED;
     }
 
-    // Register module (STT, TTS, VAD only; diffusion is CoreML-only in Swift SDK)
+    // Register module (STT, TTS, VAD and CPU diffusion)
     rac_module_info_t module_info = {};
     module_info.id = MODULE_ID;
     module_info.name = "ONNX Runtime";
     module_info.version = "1.0.0";
-    module_info.description = "STT/TTS/VAD backend using ONNX Runtime";
-    rac_capability_t capabilities[] = {RAC_CAPABILITY_STT, RAC_CAPABILITY_TTS, RAC_CAPABILITY_VAD};
+    module_info.description = "STT/TTS/VAD/diffusion backend using ONNX Runtime";
+    rac_capability_t capabilities[] = {RAC_CAPABILITY_STT, RAC_CAPABILITY_TTS, RAC_CAPABILITY_VAD,
+                                       RAC_CAPABILITY_DIFFUSION};
     module_info.capabilities = capabilities;
-    module_info.num_capabilities = 3;
+    module_info.num_capabilities = 4;
 
     rac_result_t result = rac_module_register(&module_info);
     if (result != RAC_SUCCESS && result != RAC_ERROR_MODULE_ALREADY_REGISTERED) {
@@ -552,8 +697,25 @@ rac_result_t rac_backend_onnx_register(void) {
         return result;
     }
 
+    // Register diffusion provider
+    rac_service_provider_t diffusion_provider = {};
+    diffusion_provider.name = DIFFUSION_PROVIDER_NAME;
+    diffusion_provider.capability = RAC_CAPABILITY_DIFFUSION;
+    diffusion_provider.priority = 100;
+    diffusion_provider.can_handle = onnx_diffusion_can_handle;
+    diffusion_provider.create = onnx_diffusion_create;
+
+    result = rac_service_register_provider(&diffusion_provider);
+    if (result != RAC_SUCCESS) {
+        rac_service_unregister_provider(VAD_PROVIDER_NAME, RAC_CAPABILITY_VAD);
+        rac_service_unregister_provider(TTS_PROVIDER_NAME, RAC_CAPABILITY_TTS);
+        rac_service_unregister_provider(STT_PROVIDER_NAME, RAC_CAPABILITY_STT);
+        rac_module_unregister(MODULE_ID);
+        return result;
+    }
+
     g_registered = true;
-    RAC_LOG_INFO(LOG_CAT, "ONNX backend registered (STT + TTS + VAD)");
+    RAC_LOG_INFO(LOG_CAT, "ONNX backend registered (STT + TTS + VAD + Diffusion)");
     return RAC_SUCCESS;
 }
 
@@ -563,6 +725,7 @@ rac_result_t rac_backend_onnx_unregister(void) {
     }
 
     rac_model_strategy_unregister(RAC_FRAMEWORK_ONNX);
+    rac_service_unregister_provider(DIFFUSION_PROVIDER_NAME, RAC_CAPABILITY_DIFFUSION);
     rac_service_unregister_provider(VAD_PROVIDER_NAME, RAC_CAPABILITY_VAD);
     rac_service_unregister_provider(TTS_PROVIDER_NAME, RAC_CAPABILITY_TTS);
     rac_service_unregister_provider(STT_PROVIDER_NAME, RAC_CAPABILITY_STT);
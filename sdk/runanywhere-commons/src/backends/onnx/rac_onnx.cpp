@@ -128,7 +128,8 @@ rac_result_t rac_stt_onnx_transcribe(rac_handle_t handle, const float* audio_sam
     }
 
     runanywhere::STTRequest request;
-    request.audio_samples.assign(audio_samples, audio_samples + num_samples);
+    request.audio_samples = audio_samples;
+    request.num_samples = num_samples;
     request.sample_rate = (options && options->sample_rate > 0) ? options->sample_rate : 16000;
     if (options && options->language) {
         request.language = options->language;
@@ -186,8 +187,7 @@ rac_result_t rac_stt_onnx_feed_audio(rac_handle_t handle, rac_handle_t stream,
     auto* h = static_cast<rac_onnx_stt_handle_impl*>(handle);
     auto* stream_id = static_cast<char*>(stream);
 
-    std::vector<float> samples(audio_samples, audio_samples + num_samples);
-    bool success = h->stt->feed_audio(stream_id, samples, 16000);
+    bool success = h->stt->feed_audio(stream_id, audio_samples, num_samples, 16000);
 
     return success ? RAC_SUCCESS : RAC_ERROR_INFERENCE_FAILED;
 }
@@ -486,8 +486,7 @@ rac_result_t rac_vad_onnx_process(rac_handle_t handle, const float* samples, siz
         return RAC_ERROR_INVALID_HANDLE;
     }
 
-    std::vector<float> audio(samples, samples + num_samples);
-    auto result = h->vad->process(audio, 16000);
+    auto result = h->vad->process(samples, num_samples, 16000);
 
     *out_is_speech = result.is_speech ? RAC_TRUE : RAC_FALSE;
 
@@ -22,6 +22,8 @@
 
 #ifdef RAC_HAS_ONNX
 #include <onnxruntime_cxx_api.h>
+
+#include "ort_shared_env.h"
 #endif
 
 #include <algorithm>
@@ -73,6 +75,18 @@ static constexpr float VAD_THRESHOLD = 0.5f;
 // INTERNAL TYPES
 // =============================================================================
 
+#ifdef RAC_HAS_ONNX
+// Session created on the shared env through the C API; dropping it releases
+// the OrtSession
+struct SharedSessionDeleter {
+    void operator()(Ort::UnownedSession* session) const {
+        Ort::GetApi().ReleaseSession(*session);
+        delete session;
+    }
+};
+using SharedSession = std::unique_ptr<Ort::UnownedSession, SharedSessionDeleter>;
+#endif
+
 struct WakewordModel {
     std::string model_id;
     std::string wake_word;
@@ -81,7 +95,7 @@ struct WakewordModel {
     int num_embeddings = DEFAULT_CLASSIFIER_EMBEDDINGS;  // Read from model input shape
 
 #ifdef RAC_HAS_ONNX
-    std::unique_ptr<Ort::Session> session;
+    SharedSession session;
     std::string input_name;
     std::string output_name;
 #endif
@@ -96,20 +110,29 @@ struct WakewordOnnxBackend {
     float global_threshold = 0.5f;
 
 #ifdef RAC_HAS_ONNX
+    // Non-owning view of the shared env; dropping it releases our reference
+    struct SharedEnvDeleter {
+        void operator()(Ort::Env* env) const {
+            env->release();
+            delete env;
+            runanywhere::ort_shared_env_release();
+        }
+    };
+
     // ONNX Runtime
-    std::unique_ptr<Ort::Env> env;
+    std::unique_ptr<Ort::Env, SharedEnvDeleter> env;
     std::unique_ptr<Ort::SessionOptions> session_options;
     Ort::MemoryInfo memory_info = Ort::MemoryInfo::CreateCpu(
         OrtArenaAllocator, OrtMemTypeDefault);
     Ort::AllocatorWithDefaultOptions allocator;
 
     // Stage 1: Melspectrogram model
-    std::unique_ptr<Ort::Session> melspec_session;
+    SharedSession melspec_session;
     std::string melspec_input_name;
     std::string melspec_output_name;
 
     // Stage 2: Embedding model
-    std::unique_ptr<Ort::Session> embedding_session;
+    SharedSession embedding_session;
     std::string embedding_input_name;
     std::string embedding_output_name;
 #endif
@@ -124,6 +147,7 @@ struct WakewordOnnxBackend {
     // Streaming buffers
     std::vector<float> audio_buffer;                      // Accumulate to FRAME_SIZE
     std::vector<float> audio_context_buffer;              // Keep last MELSPEC_CONTEXT_SAMPLES for overlap
+    std::vector<float> frame_with_context;                // Reused [context | frame] melspec input
     std::deque<std::vector<float>> melspec_buffer;        // Each entry is [MELSPEC_BINS]
     std::deque<std::vector<float>> embedding_buffer;      // Each entry is [EMBEDDING_DIM]
     size_t last_melspec_embedding_index = 0;              // Track which melspec frames we've embedded
@@ -147,19 +171,26 @@ static bool is_valid_handle(rac_handle_t handle) {
 
 #ifdef RAC_HAS_ONNX
 
-static Ort::SessionOptions create_session_options(int num_threads, bool optimize) {
-    Ort::SessionOptions options;
-
-    if (num_threads > 0) {
-        options.SetIntraOpNumThreads(num_threads);
-        options.SetInterOpNumThreads(num_threads);
-    }
-
-    if (optimize) {
-        options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+// Realtime session on the shared env: a dedicated single-thread pool, so
+// audio never queues behind batch work on the global pools. Optimized graphs
+// are reused from earlier runs.
+static SharedSession create_shared_session(WakewordOnnxBackend* backend,
+                                           const char* model_path) {
+    const GraphOptimizationLevel level = backend->config.enable_optimization == RAC_TRUE
+                                             ? ORT_ENABLE_ALL
+                                             : ORT_DISABLE_ALL;
+    OrtSession* session = nullptr;
+    Ort::ThrowOnError(runanywhere::ort_shared_create_session(
+        model_path, *backend->session_options, runanywhere::OrtSessionPriority::REALTIME, level,
+        &session));
+    SharedSession owned(nullptr);
+    try {
+        owned.reset(new Ort::UnownedSession(session));
+    } catch (...) {
+        Ort::GetApi().ReleaseSession(session);
+        throw;
     }
-
-    return options;
+    return owned;
 }
 
 /**
@@ -522,19 +553,21 @@ RAC_ONNX_API rac_result_t rac_wakeword_onnx_create(
     backend->global_threshold = backend->config.threshold;
 
     try {
-        // Initialize ONNX Runtime
-        backend->env = std::make_unique<Ort::Env>(
-            ORT_LOGGING_LEVEL_WARNING, "WakeWord");
+        // Initialize ONNX Runtime. Wake word sessions are realtime sessions
+        // on the shared env with their own single-thread pool.
+        OrtEnv* shared_env = runanywhere::ort_shared_env_acquire();
+        if (!shared_env) {
+            delete backend;
+            return RAC_ERROR_WAKEWORD_NOT_INITIALIZED;
+        }
+        backend->env.reset(new Ort::Env(shared_env));
 
-        backend->session_options = std::make_unique<Ort::SessionOptions>(
-            create_session_options(backend->config.num_threads,
-                                   backend->config.enable_optimization == RAC_TRUE));
+        backend->session_options = std::make_unique<Ort::SessionOptions>();
 
         backend->initialized = true;
         *out_handle = static_cast<rac_handle_t>(backend);
 
-        RAC_LOG_INFO(LOG_TAG, "Created backend (threads=%d, frame_size=%d)",
-                     backend->config.num_threads, FRAME_SIZE);
+        RAC_LOG_INFO(LOG_TAG, "Created backend (frame_size=%d)", FRAME_SIZE);
 
         return RAC_SUCCESS;
 
@@ -566,8 +599,7 @@ RAC_ONNX_API rac_result_t rac_wakeword_onnx_init_shared_models(
     try {
         // Load melspectrogram model (required for proper pipeline)
         if (melspec_model_path) {
-            backend->melspec_session = std::make_unique<Ort::Session>(
-                *backend->env, melspec_model_path, *backend->session_options);
+            backend->melspec_session = create_shared_session(backend, melspec_model_path);
 
             // Get input/output names
             auto input_name = backend->melspec_session->GetInputNameAllocated(0, backend->allocator);
@@ -583,8 +615,7 @@ RAC_ONNX_API rac_result_t rac_wakeword_onnx_init_shared_models(
 
         // Load embedding model (required)
         if (embedding_model_path) {
-            backend->embedding_session = std::make_unique<Ort::Session>(
-                *backend->env, embedding_model_path, *backend->session_options);
+            backend->embedding_session = create_shared_session(backend, embedding_model_path);
 
             // Get input/output names
             auto input_name = backend->embedding_session->GetInputNameAllocated(0, backend->allocator);
@@ -650,8 +681,7 @@ RAC_ONNX_API rac_result_t rac_wakeword_onnx_load_model(
         model.model_path = model_path;
         model.threshold = backend->global_threshold;
 
-        model.session = std::make_unique<Ort::Session>(
-            *backend->env, model_path, *backend->session_options);
+        model.session = create_shared_session(backend, model_path);
 
         // Get input/output names
         auto input_name = model.session->GetInputNameAllocated(0, backend->allocator);
@@ -804,7 +834,9 @@ RAC_ONNX_API rac_result_t rac_wakeword_onnx_process_with_vad(
     // when computing melspectrogram for frame continuity at boundaries
     while (backend->audio_buffer.size() >= FRAME_SIZE) {
         // Build frame with context: [context_samples | new_frame_samples]
-        std::vector<float> frame_with_context;
+        // Reuses the backend-owned buffer so steady-state frames do not allocate
+        std::vector<float>& frame_with_context = backend->frame_with_context;
+        frame_with_context.clear();
         frame_with_context.reserve(MELSPEC_CONTEXT_SAMPLES + FRAME_SIZE);
 
         // Add context from previous frame (if available)
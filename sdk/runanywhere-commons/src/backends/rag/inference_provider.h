@@ -2,7 +2,7 @@
  * @file inference_provider.h
  * @brief Abstract interfaces for RAG inference providers
  *
- * Strategy pattern interfaces for embedding and text generation.
+ * Strategy pattern interfaces for embedding, reranking and text generation.
  * Allows RAG backend to work with any implementation (ONNX, LlamaCPP, etc.)
  */
 
@@ -40,6 +40,25 @@ public:
      */
     virtual std::vector<float> embed(const std::string& text) = 0;
 
+    /**
+     * @brief Generate embeddings for several texts
+     *
+     * Providers that can run many sequences in one inference call override
+     * this; the default embeds the texts one by one.
+     *
+     * @param texts Input texts to embed
+     * @return One embedding per text, in input order
+     * @throws std::runtime_error on inference failure
+     */
+    virtual std::vector<std::vector<float>> embed_batch(const std::vector<std::string>& texts) {
+        std::vector<std::vector<float>> embeddings;
+        embeddings.reserve(texts.size());
+        for (const auto& text : texts) {
+            embeddings.push_back(embed(text));
+        }
+        return embeddings;
+    }
+
     /**
      * @brief Get embedding dimension
      * 
@@ -60,6 +79,60 @@ public:
      * @return Provider identifier (e.g., "ONNX-MiniLM")
      */
     virtual const char* name() const noexcept = 0;
+
+    /**
+     * @brief Check if count_tokens() uses the model's own tokenizer
+     */
+    virtual bool has_tokenizer() const noexcept { return false; }
+
+    /**
+     * @brief Count model tokens in text, excluding special tokens
+     *
+     * @return Token count, or 0 if the provider has no tokenizer
+     */
+    virtual size_t count_tokens(const std::string& text) {
+        (void)text;
+        return 0;
+    }
+};
+
+// =============================================================================
+// RERANK PROVIDER INTERFACE
+// =============================================================================
+
+/**
+ * @brief Abstract interface for relevance scoring of retrieved passages
+ *
+ * A reranker (typically a cross-encoder) reads the query and each passage
+ * together, which ranks far better than comparing independent embeddings
+ * but is too slow to run over the whole index. It is applied to the vector
+ * search candidates only.
+ */
+class IRerankProvider {
+public:
+    virtual ~IRerankProvider() = default;
+
+    /**
+     * @brief Score passages against a query
+     *
+     * @param query Query text
+     * @param passages Candidate passages
+     * @return One score per passage, higher is more relevant; empty on failure
+     */
+    virtual std::vector<float> score(
+        const std::string& query,
+        const std::vector<std::string>& passages
+    ) = 0;
+
+    /**
+     * @brief Check if provider is ready for inference
+     */
+    virtual bool is_ready() const noexcept = 0;
+
+    /**
+     * @brief Get provider name for logging/debugging
+     */
+    virtual const char* name() const noexcept = 0;
 };
 
 // =============================================================================
@@ -157,6 +230,30 @@ std::unique_ptr<IEmbeddingProvider> create_onnx_embedding_provider(
     const std::string& config_json = ""
 );
 
+/**
+ * @brief Create ONNX cross-encoder rerank provider
+ * 
+ * @param model_path Path to ONNX cross-encoder model file
+ * @param config_json Optional configuration JSON
+ * @return Unique pointer to rerank provider
+ */
+std::unique_ptr<IRerankProvider> create_onnx_rerank_provider(
+    const std::string& model_path,
+    const std::string& config_json = ""
+);
+
+/**
+ * @brief Create LlamaCPP embedding provider for GGUF embedding models
+ * 
+ * @param model_path Path to GGUF embedding model file
+ * @param config_json Optional configuration JSON
+ * @return Unique pointer to embedding provider
+ */
+std::unique_ptr<IEmbeddingProvider> create_llamacpp_embedding_provider(
+    const std::string& model_path,
+    const std::string& config_json = ""
+);
+
 /**
  * @brief Create LlamaCPP text generator
  * 
@@ -0,0 +1,356 @@
+/**
+ * @file llamacpp_embedding_provider.cpp
+ * @brief LlamaCPP embedding provider implementation for RAG
+ *
+ * Loads a GGUF embedding model in embeddings mode. Texts are packed into a
+ * single llama_batch, one sequence id per text, so a whole chunk window is
+ * embedded with one llama_decode call instead of one call per chunk.
+ * Pooling follows the model's GGUF metadata unless overridden in config.
+ */
+
+#include "llamacpp_embedding_provider.h"
+#include <rac/core/rac_logger.h>
+#include <llama.h>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <mutex>
+#include <nlohmann/json.hpp>
+
+#define LOG_TAG "RAG.LlamaCppEmbedding"
+#define LOGI(...) RAC_LOG_INFO(LOG_TAG, __VA_ARGS__)
+#define LOGE(...) RAC_LOG_ERROR(LOG_TAG, __VA_ARGS__)
+#define LOGW(...) RAC_LOG_WARNING(LOG_TAG, __VA_ARGS__)
+
+namespace runanywhere {
+namespace rag {
+
+namespace {
+
+void normalize_vector(std::vector<float>& vec) {
+    float sum_squared = 0.0f;
+    for (float val : vec) {
+        sum_squared += val * val;
+    }
+
+    float norm = std::sqrt(sum_squared);
+    if (norm > 1e-8f) {
+        for (float& val : vec) {
+            val /= norm;
+        }
+    }
+}
+
+enum llama_pooling_type parse_pooling(const std::string& pooling) {
+    if (pooling == "none") return LLAMA_POOLING_TYPE_NONE;
+    if (pooling == "mean") return LLAMA_POOLING_TYPE_MEAN;
+    if (pooling == "cls") return LLAMA_POOLING_TYPE_CLS;
+    if (pooling == "last") return LLAMA_POOLING_TYPE_LAST;
+    return LLAMA_POOLING_TYPE_UNSPECIFIED;
+}
+
+} // namespace
+
+// =============================================================================
+// PIMPL IMPLEMENTATION
+// =============================================================================
+
+class LlamaCppEmbeddingProvider::Impl {
+public:
+    llama_model* model = nullptr;
+    llama_context* context = nullptr;
+    const llama_vocab* vocab = nullptr;
+
+    enum llama_pooling_type pooling = LLAMA_POOLING_TYPE_UNSPECIFIED;
+    size_t dimension = 0;
+    int batch_tokens = 2048;      // Token budget of one llama_decode call
+    int max_sequences = 32;       // Texts per llama_decode call
+    int max_text_tokens = 512;    // Per-text limit; longer texts are truncated
+    bool normalize = true;
+    bool ready = false;
+    std::mutex mutex;
+
+    ~Impl() {
+        if (context) {
+            llama_free(context);
+        }
+        if (model) {
+            llama_model_free(model);
+        }
+    }
+
+    bool initialize(const std::string& path, const std::string& config_json) {
+        static std::once_flag llama_init_once;
+        std::call_once(llama_init_once, []() { llama_backend_init(); });
+
+        std::ifstream file(path);
+        if (!file.good()) {
+            LOGE("Model file not found: %s", path.c_str());
+            return false;
+        }
+        file.close();
+
+        int threads = 0;
+        std::string pooling_name;
+        if (!config_json.empty()) {
+            try {
+                auto config = nlohmann::json::parse(config_json);
+                if (config.is_object()) {
+                    batch_tokens = config.value("context_size", batch_tokens);
+                    max_sequences = config.value("max_sequences", max_sequences);
+                    threads = config.value("threads", threads);
+                    normalize = config.value("normalize", normalize);
+                    pooling_name = config.value("pooling", std::string());
+                }
+            } catch (const std::exception& e) {
+                LOGW("Failed to parse config JSON: %s", e.what());
+            }
+        }
+        batch_tokens = std::max(batch_tokens, 64);
+        max_sequences = std::max(max_sequences, 1);
+
+        llama_model_params model_params = llama_model_default_params();
+        model = llama_model_load_from_file(path.c_str(), model_params);
+        if (!model) {
+            LOGE("Failed to load GGUF embedding model: %s", path.c_str());
+            return false;
+        }
+        vocab = llama_model_get_vocab(model);
+        max_text_tokens = std::min(batch_tokens, llama_model_n_ctx_train(model));
+
+        // Non-causal encoders need a whole batch in one micro-batch, and a
+        // unified KV cache lets causal embedders split n_ctx freely between
+        // sequences of different lengths
+        llama_context_params ctx_params = llama_context_default_params();
+        ctx_params.embeddings = true;
+        ctx_params.pooling_type = parse_pooling(pooling_name);
+        ctx_params.n_ctx = static_cast<uint32_t>(batch_tokens);
+        ctx_params.n_batch = static_cast<uint32_t>(batch_tokens);
+        ctx_params.n_ubatch = static_cast<uint32_t>(batch_tokens);
+        ctx_params.n_seq_max = static_cast<uint32_t>(max_sequences);
+        ctx_params.kv_unified = true;
+        ctx_params.no_perf = true;
+        if (threads > 0) {
+            ctx_params.n_threads = threads;
+            ctx_params.n_threads_batch = threads;
+        }
+
+        context = llama_init_from_model(model, ctx_params);
+        if (!context) {
+            LOGE("Failed to create llama.cpp embedding context");
+            return false;
+        }
+
+        pooling = llama_pooling_type(context);
+        if (pooling == LLAMA_POOLING_TYPE_RANK) {
+            LOGE("Model uses rank pooling (a reranker), not an embedding model: %s",
+                 path.c_str());
+            return false;
+        }
+        dimension = static_cast<size_t>(llama_model_n_embd(model));
+
+        LOGI("LlamaCPP embedding provider initialized: %s (dim=%zu, pooling=%d, "
+             "batch=%d tokens/%d sequences)",
+             path.c_str(), dimension, static_cast<int>(pooling), batch_tokens, max_sequences);
+        ready = true;
+        return true;
+    }
+
+    std::vector<llama_token> tokenize(const std::string& text, bool add_special) const {
+        int32_t n_tokens = llama_tokenize(vocab, text.c_str(), static_cast<int32_t>(text.size()),
+                                          nullptr, 0, add_special, false);
+        if (n_tokens < 0) {
+            n_tokens = -n_tokens;
+        }
+        std::vector<llama_token> tokens(static_cast<size_t>(n_tokens));
+        if (n_tokens > 0) {
+            n_tokens = llama_tokenize(vocab, text.c_str(), static_cast<int32_t>(text.size()),
+                                      tokens.data(), n_tokens, add_special, false);
+            tokens.resize(static_cast<size_t>(std::max(n_tokens, 0)));
+        }
+        return tokens;
+    }
+
+    std::vector<std::vector<float>> embed_batch(const std::vector<std::string>& texts) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        std::vector<std::vector<float>> embeddings(texts.size());
+        if (!ready) {
+            LOGE("Embedding provider not ready");
+            return embeddings;
+        }
+
+        const bool ends_with_separator =
+            llama_vocab_get_add_sep(vocab) || llama_vocab_get_add_eos(vocab);
+
+        llama_batch batch = llama_batch_init(batch_tokens, 0, 1);
+        std::vector<size_t> batch_texts;  // Text index of each sequence id
+
+        auto flush = [&]() {
+            if (batch.n_tokens == 0) {
+                return;
+            }
+            decode_batch(batch, batch_texts, embeddings);
+            batch.n_tokens = 0;
+            batch_texts.clear();
+        };
+
+        for (size_t i = 0; i < texts.size(); ++i) {
+            std::vector<llama_token> tokens = tokenize(texts[i], true);
+            if (tokens.empty()) {
+                embeddings[i].assign(dimension, 0.0f);
+                continue;
+            }
+            if (tokens.size() > static_cast<size_t>(max_text_tokens)) {
+                const llama_token last = tokens.back();
+                tokens.resize(static_cast<size_t>(max_text_tokens));
+                if (ends_with_separator) {
+                    tokens.back() = last;
+                }
+            }
+
+            if (batch.n_tokens + static_cast<int32_t>(tokens.size()) > batch_tokens ||
+                static_cast<int>(batch_texts.size()) >= max_sequences) {
+                flush();
+            }
+
+            const auto seq_id = static_cast<llama_seq_id>(batch_texts.size());
+            for (size_t pos = 0; pos < tokens.size(); ++pos) {
+                const int32_t n = batch.n_tokens++;
+                batch.token[n] = tokens[pos];
+                batch.pos[n] = static_cast<llama_pos>(pos);
+                batch.n_seq_id[n] = 1;
+                batch.seq_id[n][0] = seq_id;
+                batch.logits[n] = true;
+            }
+            batch_texts.push_back(i);
+        }
+        flush();
+
+        llama_batch_free(batch);
+        return embeddings;
+    }
+
+    size_t count_tokens(const std::string& text) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return ready ? tokenize(text, false).size() : 0;
+    }
+
+private:
+    // Run one llama_decode over all packed sequences and read back one
+    // embedding per sequence
+    void decode_batch(const llama_batch& batch, const std::vector<size_t>& batch_texts,
+                      std::vector<std::vector<float>>& embeddings) {
+        // Sequences are independent; drop any cache left by the last call
+        llama_memory_clear(llama_get_memory(context), true);
+
+        if (llama_decode(context, batch) != 0) {
+            LOGE("llama_decode failed for %zu sequences", batch_texts.size());
+            return;
+        }
+
+        if (pooling != LLAMA_POOLING_TYPE_NONE) {
+            for (size_t seq = 0; seq < batch_texts.size(); ++seq) {
+                const float* embd = llama_get_embeddings_seq(context, static_cast<llama_seq_id>(seq));
+                if (embd == nullptr) {
+                    LOGE("No pooled embedding for sequence %zu", seq);
+                    continue;
+                }
+                store(embd, embeddings[batch_texts[seq]]);
+            }
+            return;
+        }
+
+        // No pooling in the model: mean over the token embeddings
+        std::vector<std::vector<float>> sums(batch_texts.size(), std::vector<float>(dimension, 0.0f));
+        std::vector<size_t> counts(batch_texts.size(), 0);
+        for (int32_t i = 0; i < batch.n_tokens; ++i) {
+            const float* embd = llama_get_embeddings_ith(context, i);
+            if (embd == nullptr) {
+                continue;
+            }
+            const auto seq = static_cast<size_t>(batch.seq_id[i][0]);
+            for (size_t d = 0; d < dimension; ++d) {
+                sums[seq][d] += embd[d];
+            }
+            ++counts[seq];
+        }
+        for (size_t seq = 0; seq < batch_texts.size(); ++seq) {
+            if (counts[seq] == 0) {
+                continue;
+            }
+            for (float& val : sums[seq]) {
+                val /= static_cast<float>(counts[seq]);
+            }
+            store(sums[seq].data(), embeddings[batch_texts[seq]]);
+        }
+    }
+
+    void store(const float* embd, std::vector<float>& out) const {
+        out.assign(embd, embd + dimension);
+        if (normalize) {
+            normalize_vector(out);
+        }
+    }
+};
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+LlamaCppEmbeddingProvider::LlamaCppEmbeddingProvider(
+    const std::string& model_path,
+    const std::string& config_json
+) : impl_(std::make_unique<Impl>()) {
+    impl_->initialize(model_path, config_json);
+}
+
+LlamaCppEmbeddingProvider::~LlamaCppEmbeddingProvider() = default;
+
+LlamaCppEmbeddingProvider::LlamaCppEmbeddingProvider(LlamaCppEmbeddingProvider&&) noexcept = default;
+LlamaCppEmbeddingProvider& LlamaCppEmbeddingProvider::operator=(LlamaCppEmbeddingProvider&&) noexcept = default;
+
+std::vector<float> LlamaCppEmbeddingProvider::embed(const std::string& text) {
+    auto embeddings = impl_->embed_batch({text});
+    return std::move(embeddings.front());
+}
+
+std::vector<std::vector<float>> LlamaCppEmbeddingProvider::embed_batch(
+    const std::vector<std::string>& texts
+) {
+    return impl_->embed_batch(texts);
+}
+
+size_t LlamaCppEmbeddingProvider::dimension() const noexcept {
+    return impl_->dimension;
+}
+
+bool LlamaCppEmbeddingProvider::is_ready() const noexcept {
+    return impl_ && impl_->ready;
+}
+
+const char* LlamaCppEmbeddingProvider::name() const noexcept {
+    return "LlamaCPP-Embedding";
+}
+
+bool LlamaCppEmbeddingProvider::has_tokenizer() const noexcept {
+    return is_ready();
+}
+
+size_t LlamaCppEmbeddingProvider::count_tokens(const std::string& text) {
+    return impl_->count_tokens(text);
+}
+
+// =============================================================================
+// FACTORY FUNCTION
+// =============================================================================
+
+std::unique_ptr<IEmbeddingProvider> create_llamacpp_embedding_provider(
+    const std::string& model_path,
+    const std::string& config_json
+) {
+    return std::make_unique<LlamaCppEmbeddingProvider>(model_path, config_json);
+}
+
+} // namespace rag
+} // namespace runanywhere
@@ -0,0 +1,61 @@
+/**
+ * @file llamacpp_embedding_provider.h
+ * @brief LlamaCPP-based embedding provider for GGUF embedding models
+ */
+
+#ifndef RUNANYWHERE_LLAMACPP_EMBEDDING_PROVIDER_H
+#define RUNANYWHERE_LLAMACPP_EMBEDDING_PROVIDER_H
+
+#include "inference_provider.h"
+#include <memory>
+
+namespace runanywhere {
+namespace rag {
+
+/**
+ * @brief LlamaCPP implementation of embedding provider
+ * 
+ * Runs GGUF embedding models (nomic-embed, bge, gte, ...) with llama.cpp.
+ * embed_batch() packs many texts into one llama_decode call, one sequence
+ * per text, and pools each sequence as the model metadata specifies.
+ * Thread-safe after initialization (calls are serialized).
+ */
+class LlamaCppEmbeddingProvider final : public IEmbeddingProvider {
+public:
+    /**
+     * @brief Construct LlamaCPP embedding provider
+     * 
+     * @param model_path Path to GGUF embedding model
+     * @param config_json Optional JSON configuration
+     */
+    explicit LlamaCppEmbeddingProvider(
+        const std::string& model_path,
+        const std::string& config_json = ""
+    );
+
+    ~LlamaCppEmbeddingProvider() override;
+
+    // Disable copy, allow move
+    LlamaCppEmbeddingProvider(const LlamaCppEmbeddingProvider&) = delete;
+    LlamaCppEmbeddingProvider& operator=(const LlamaCppEmbeddingProvider&) = delete;
+    LlamaCppEmbeddingProvider(LlamaCppEmbeddingProvider&&) noexcept;
+    LlamaCppEmbeddingProvider& operator=(LlamaCppEmbeddingProvider&&) noexcept;
+
+    // IEmbeddingProvider interface
+    std::vector<float> embed(const std::string& text) override;
+    std::vector<std::vector<float>> embed_batch(const std::vector<std::string>& texts) override;
+    size_t dimension() const noexcept override;
+    bool is_ready() const noexcept override;
+    const char* name() const noexcept override;
+    bool has_tokenizer() const noexcept override;
+    size_t count_tokens(const std::string& text) override;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace rag
+} // namespace runanywhere
+
+#endif // RUNANYWHERE_LLAMACPP_EMBEDDING_PROVIDER_H
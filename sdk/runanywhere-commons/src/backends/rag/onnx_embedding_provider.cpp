@@ -5,8 +5,11 @@
 
 #include "onnx_embedding_provider.h"
 #include "backends/rag/ort_guards.h"
+#include "simple_tokenizer.h"
 #include "rac/core/rac_logger.h"
 #include "../onnx/onnx_backend.h"
+#include "../onnx/ort_model_cache.h"
+#include "../onnx/ort_shared_env.h"
 
 #include <nlohmann/json.hpp>
 #include <onnxruntime_c_api.h>
@@ -16,12 +19,6 @@
 #include <cmath>
 #include <algorithm>
 #include <cctype>
-#include <unordered_map>
-#include <list>
-
-#if defined(__aarch64__) && defined(__ARM_NEON)
-#include <arm_neon.h>
-#endif
 
 #define LOG_TAG "RAG.ONNXEmbedding"
 #define LOGI(...) RAC_LOG_INFO(LOG_TAG, __VA_ARGS__)
@@ -31,384 +28,6 @@
 namespace runanywhere {
 namespace rag {
 
-// =============================================================================
-// SIMPLE TOKENIZER (Word-level for MVP)
-// =============================================================================
-
-class SimpleTokenizer {
-public:
-    SimpleTokenizer() {
-        // Special tokens (defaults; may be overridden by vocab load)
-        token_to_id_["[CLS]"] = 101;
-        token_to_id_["[SEP]"] = 102;
-        token_to_id_["[PAD]"] = 0;
-        token_to_id_["[UNK]"] = 100;
-        cls_id_ = 101;
-        sep_id_ = 102;
-        pad_id_ = 0;
-        unk_id_ = 100;
-    }
-
-    bool load_vocab(const std::string& vocab_path) {
-        std::ifstream file(vocab_path);
-        if (!file) {
-            return false;
-        }
-
-        token_to_id_.clear();
-
-        std::string line;
-        int64_t id = 0;
-        while (std::getline(file, line)) {
-            if (!line.empty() && line.back() == '\r') {
-                line.pop_back();
-            }
-            token_to_id_[line] = id++;
-        }
-
-        if (token_to_id_.empty()) {
-            return false;
-        }
-
-        vocab_loaded_ = true;
-
-        // Refresh special token IDs if present in vocab
-        cls_id_ = get_token_id("[CLS]", cls_id_);
-        sep_id_ = get_token_id("[SEP]", sep_id_);
-        pad_id_ = get_token_id("[PAD]", pad_id_);
-        unk_id_ = get_token_id("[UNK]", unk_id_);
-
-        return true;
-    }
-    
-    std::vector<int64_t> encode(const std::string& text, size_t max_length = 512) {
-        std::vector<int64_t> token_ids;
-        token_ids.reserve(max_length);
-        token_ids.push_back(cls_id_); // [CLS]
-
-        const auto words = basic_tokenize(text);
-        for (const auto& word : words) {
-            if (token_ids.size() >= max_length - 1) {
-                break;
-            }
-
-            const auto ids = word_to_token_ids(word);
-            for (const auto id : ids) {
-                if (token_ids.size() >= max_length - 1) {
-                    break;
-                }
-                token_ids.push_back(id);
-            }
-        }
-
-        token_ids.push_back(sep_id_); // [SEP]
-        
-        // Pad to max_length
-        while (token_ids.size() < max_length) {
-            token_ids.push_back(pad_id_); // [PAD]
-        }
-        
-        return token_ids;
-    }
-    
-    std::vector<int64_t> create_attention_mask(const std::vector<int64_t>& token_ids) {
-        std::vector<int64_t> mask;
-        for (auto id : token_ids) {
-            mask.push_back(id != 0 ? 1 : 0); // 1 for real tokens, 0 for padding
-        }
-        return mask;
-    }
-    
-    std::vector<int64_t> create_token_type_ids(size_t length) {
-        // Token type IDs: all 0s for single sequence models like all-MiniLM
-        return std::vector<int64_t>(length, 0);
-    }
-
-private:
-    static inline bool is_all_ascii(const std::string& text) {
-        for (unsigned char ch : text) {
-            if (ch & 0x80) {
-                return false;
-            }
-        }
-        return true;
-    }
-
-    static inline bool is_ascii_alnum(unsigned char ch) {
-        return (ch >= 'A' && ch <= 'Z') ||
-               (ch >= 'a' && ch <= 'z') ||
-               (ch >= '0' && ch <= '9');
-    }
-
-    static inline char to_lower_ascii(unsigned char ch) {
-        if (ch >= 'A' && ch <= 'Z') {
-            return static_cast<char>(ch + ('a' - 'A'));
-        }
-        return static_cast<char>(ch);
-    }
-
-    std::vector<std::string> basic_tokenize(const std::string& text) const {
-        const bool all_ascii = is_all_ascii(text);
-#if defined(__aarch64__) && defined(__ARM_NEON)
-        if (all_ascii) {
-            return basic_tokenize_simd_ascii(text);
-        }
-        return basic_tokenize_scalar_mixed(text);
-#else
-        if (all_ascii) {
-            return basic_tokenize_scalar_ascii(text);
-        }
-        return basic_tokenize_scalar_mixed(text);
-#endif
-    }
-
-    std::vector<std::string> basic_tokenize_scalar_ascii(const std::string& text) const {
-        std::vector<std::string> tokens;
-        std::string current;
-        current.reserve(text.size());
-
-        for (unsigned char ch : text) {
-            if (!is_ascii_alnum(ch)) {
-                if (!current.empty()) {
-                    tokens.push_back(std::move(current));
-                    current.clear();
-                }
-                continue;
-            }
-            current.push_back(to_lower_ascii(ch));
-        }
-
-        if (!current.empty()) {
-            tokens.push_back(std::move(current));
-        }
-
-        return tokens;
-    }
-
-    std::vector<std::string> basic_tokenize_scalar_mixed(const std::string& text) const {
-        std::vector<std::string> tokens;
-        std::string current;
-        current.reserve(text.size());
-
-        for (unsigned char ch : text) {
-            if (ch & 0x80) {
-                if (!current.empty()) {
-                    tokens.push_back(std::move(current));
-                    current.clear();
-                }
-                continue;
-            }
-
-            if (!is_ascii_alnum(ch)) {
-                if (!current.empty()) {
-                    tokens.push_back(std::move(current));
-                    current.clear();
-                }
-                continue;
-            }
-
-            current.push_back(to_lower_ascii(ch));
-        }
-
-        if (!current.empty()) {
-            tokens.push_back(std::move(current));
-        }
-
-        return tokens;
-    }
-
-#if defined(__aarch64__) && defined(__ARM_NEON)
-    std::vector<std::string> basic_tokenize_simd_ascii(const std::string& text) const {
-        std::vector<std::string> tokens;
-        std::string current;
-        current.reserve(text.size());
-
-        const char* data = text.data();
-        size_t length = text.size();
-        size_t i = 0;
-
-        const uint8x16_t a_upper = vdupq_n_u8('A');
-        const uint8x16_t z_upper = vdupq_n_u8('Z');
-        const uint8x16_t a_lower = vdupq_n_u8('a');
-        const uint8x16_t z_lower = vdupq_n_u8('z');
-        const uint8x16_t zero_digit = vdupq_n_u8('0');
-        const uint8x16_t nine_digit = vdupq_n_u8('9');
-        const uint8x16_t lower_mask = vdupq_n_u8(0x20);
-
-        while (i + 16 <= length) {
-            uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
-
-            uint8x16_t geA = vcgeq_u8(v, a_upper);
-            uint8x16_t leZ = vcleq_u8(v, z_upper);
-            uint8x16_t is_upper = vandq_u8(geA, leZ);
-
-            uint8x16_t gea = vcgeq_u8(v, a_lower);
-            uint8x16_t lez = vcleq_u8(v, z_lower);
-            uint8x16_t is_lower = vandq_u8(gea, lez);
-
-            uint8x16_t ge0 = vcgeq_u8(v, zero_digit);
-            uint8x16_t le9 = vcleq_u8(v, nine_digit);
-            uint8x16_t is_digit = vandq_u8(ge0, le9);
-
-            uint8x16_t is_alnum = vorrq_u8(vorrq_u8(is_upper, is_lower), is_digit);
-            const bool all_alnum = vminvq_u8(is_alnum) == 0xFF;
-
-            if (all_alnum) {
-                uint8x16_t lower = vaddq_u8(v, vandq_u8(is_upper, lower_mask));
-                alignas(16) char buffer[16];
-                vst1q_u8(reinterpret_cast<uint8_t*>(buffer), lower);
-                current.append(buffer, 16);
-            } else {
-                for (size_t j = 0; j < 16; ++j) {
-                    unsigned char ch = static_cast<unsigned char>(data[i + j]);
-                    if (!is_ascii_alnum(ch)) {
-                        if (!current.empty()) {
-                            tokens.push_back(std::move(current));
-                            current.clear();
-                        }
-                        continue;
-                    }
-                    current.push_back(to_lower_ascii(ch));
-                }
-            }
-
-            i += 16;
-        }
-
-        for (; i < length; ++i) {
-            unsigned char ch = static_cast<unsigned char>(data[i]);
-            if (!is_ascii_alnum(ch)) {
-                if (!current.empty()) {
-                    tokens.push_back(std::move(current));
-                    current.clear();
-                }
-                continue;
-            }
-            current.push_back(to_lower_ascii(ch));
-        }
-
-        if (!current.empty()) {
-            tokens.push_back(std::move(current));
-        }
-
-        return tokens;
-    }
-#endif
-
-    std::vector<std::string> wordpiece_tokenize(const std::string& word) const {
-        if (!vocab_loaded_) {
-            return {word};
-        }
-
-        if (token_to_id_.find(word) != token_to_id_.end()) {
-            return {word};
-        }
-
-        std::vector<std::string> pieces;
-        size_t start = 0;
-        while (start < word.size()) {
-            size_t end = word.size();
-            std::string current_piece;
-            bool found = false;
-
-            while (start < end) {
-                std::string substr = word.substr(start, end - start);
-                if (start > 0) {
-                    substr.insert(0, "##");
-                }
-
-                if (token_to_id_.find(substr) != token_to_id_.end()) {
-                    current_piece = std::move(substr);
-                    found = true;
-                    break;
-                }
-                end--;
-            }
-
-            if (!found) {
-                return {"[UNK]"};
-            }
-
-            pieces.push_back(std::move(current_piece));
-            start = end;
-        }
-
-        return pieces;
-    }
-
-    std::vector<int64_t> word_to_token_ids(const std::string& word) {
-        auto it = token_cache_.find(word);
-        if (it != token_cache_.end()) {
-            touch_cache_entry(it->second.lru_it);
-            return it->second.ids;
-        }
-
-        const auto pieces = wordpiece_tokenize(word);
-        std::vector<int64_t> ids;
-        ids.reserve(pieces.size());
-        for (const auto& piece : pieces) {
-            ids.push_back(token_id_for(piece));
-        }
-
-        insert_cache_entry(word, ids);
-        return ids;
-    }
-
-    int64_t token_id_for(const std::string& token) const {
-        auto it = token_to_id_.find(token);
-        if (it != token_to_id_.end()) {
-            return it->second;
-        }
-
-        if (vocab_loaded_) {
-            return unk_id_;
-        }
-
-        // Hash-based fallback when vocab is unavailable
-        size_t hash = std::hash<std::string>{}(token);
-        constexpr int64_t kVocabSize = 30522;
-        constexpr int64_t kMinId = 1000;
-        constexpr int64_t kMaxId = kVocabSize - 1;
-        const int64_t range = kMaxId - kMinId + 1;
-        return static_cast<int64_t>(hash % static_cast<size_t>(range)) + kMinId;
-    }
-
-    int64_t get_token_id(const std::string& token, int64_t fallback) const {
-        auto it = token_to_id_.find(token);
-        return it != token_to_id_.end() ? it->second : fallback;
-    }
-
-    struct CacheEntry {
-        std::vector<int64_t> ids;
-        std::list<std::string>::iterator lru_it;
-    };
-
-    void touch_cache_entry(std::list<std::string>::iterator it) {
-        lru_list_.splice(lru_list_.begin(), lru_list_, it);
-    }
-
-    void insert_cache_entry(const std::string& word, const std::vector<int64_t>& ids) {
-        if (token_cache_.size() >= token_cache_limit_ && !lru_list_.empty()) {
-            const std::string& lru_key = lru_list_.back();
-            token_cache_.erase(lru_key);
-            lru_list_.pop_back();
-        }
-
-        lru_list_.push_front(word);
-        token_cache_.emplace(word, CacheEntry{ids, lru_list_.begin()});
-    }
-
-    std::unordered_map<std::string, int64_t> token_to_id_;
-    int64_t cls_id_ = 101;
-    int64_t sep_id_ = 102;
-    int64_t pad_id_ = 0;
-    int64_t unk_id_ = 100;
-    bool vocab_loaded_ = false;
-    std::unordered_map<std::string, CacheEntry> token_cache_;
-    std::list<std::string> lru_list_;
-    std::size_t token_cache_limit_ = 4096;
-};
-
 // =============================================================================
 // HELPER FUNCTIONS
 // =============================================================================
@@ -685,6 +304,14 @@ public:
         return ready_;
     }
 
+    bool has_tokenizer() const noexcept {
+        return ready_ && tokenizer_.has_vocab();
+    }
+
+    size_t count_tokens(const std::string& text) {
+        return tokenizer_.count_tokens(text);
+    }
+
 private:
     bool initialize_onnx_runtime() {
         const OrtApiBase* ort_api_base = OrtGetApiBase();
@@ -695,12 +322,10 @@ private:
             return false;
         }
         
-        // Create environment
-        OrtStatus* status = ort_api_->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "RAGEmbedding", &ort_env_);
-        if (status != nullptr) {
-            const char* error_msg = ort_api_->GetErrorMessage(status);
-            LOGE("Failed to create ORT environment: %s", error_msg);
-            ort_api_->ReleaseStatus(status);
+        // Join the process-wide environment
+        ort_env_ = ort_shared_env_acquire();
+        if (!ort_env_) {
+            LOGE("Failed to acquire shared ORT environment");
             return false;
         }
         
@@ -723,24 +348,13 @@ private:
             return false;
         }
         
-        // Configure session options with error checking
-        status_guard.reset(ort_api_->SetIntraOpNumThreads(options_guard.get(), 4));
-        if (status_guard.is_error()) {
-            LOGE("Failed to set intra-op threads: %s", status_guard.error_message());
-            return false;
-        }
-        
-        status_guard.reset(ort_api_->SetSessionGraphOptimizationLevel(options_guard.get(), ORT_ENABLE_ALL));
-        if (status_guard.is_error()) {
-            LOGE("Failed to set graph optimization level: %s", status_guard.error_message());
-            return false;
-        }
-        
-        // Load model with session options
-        status_guard.reset(ort_api_->CreateSession(
-            ort_env_,
+        // Load model with session options. Threading comes from the shared
+        // environment's global pools; the optimized graph is cached on disk.
+        status_guard.reset(ort_shared_create_session(
             model_path.c_str(),
             options_guard.get(),
+            OrtSessionPriority::NORMAL,
+            ORT_ENABLE_ALL,
             &session_
         ));
         // options_guard automatically releases session options on scope exit
@@ -751,6 +365,10 @@ private:
         }
         
         LOGI("Model loaded successfully: %s", model_path.c_str());
+
+        if (config_.is_object() && config_.value("prewarm", false)) {
+            ort_session_prewarm(session_);
+        }
         return true;
     }
     
@@ -761,7 +379,7 @@ private:
         }
         
         if (ort_env_) {
-            ort_api_->ReleaseEnv(ort_env_);
+            ort_shared_env_release();
             ort_env_ = nullptr;
         }
     }
@@ -811,6 +429,14 @@ const char* ONNXEmbeddingProvider::name() const noexcept {
     return "ONNX-Embedding";
 }
 
+bool ONNXEmbeddingProvider::has_tokenizer() const noexcept {
+    return impl_->has_tokenizer();
+}
+
+size_t ONNXEmbeddingProvider::count_tokens(const std::string& text) {
+    return impl_->count_tokens(text);
+}
+
 // =============================================================================
 // FACTORY FUNCTION
 // =============================================================================
@@ -45,6 +45,8 @@ public:
     size_t dimension() const noexcept override;
     bool is_ready() const noexcept override;
     const char* name() const noexcept override;
+    bool has_tokenizer() const noexcept override;
+    size_t count_tokens(const std::string& text) override;
 
 private:
     class Impl;
@@ -5,6 +5,8 @@
 
 #include "onnx_generator.h"
 #include "backends/rag/ort_guards.h"
+#include "../onnx/ort_model_cache.h"
+#include "../onnx/ort_shared_env.h"
 
 #include "rac/core/rac_logger.h"
 #include <nlohmann/json.hpp>
@@ -173,6 +175,7 @@ public:
     // Generation parameters
     int max_context_length = 2048;
     std::string tokenizer_path;
+    bool prewarm = false;  // Run once on dummy inputs during load
     
     bool initialize(const std::string& path, const std::string& config_json) {
         model_path = path;
@@ -190,6 +193,9 @@ public:
                 if (config.contains("tokenizer_path")) {
                     tokenizer_path = config["tokenizer_path"].get<std::string>();
                 }
+                if (config.contains("prewarm")) {
+                    prewarm = config["prewarm"].get<bool>();
+                }
             } catch (const std::exception& e) {
                 LOGE("Failed to parse config JSON: %s", e.what());
                 config = nlohmann::json::object();
@@ -216,11 +222,11 @@ public:
             return false;
         }
         
-        // Create ORT environment (exception-safe with RAII)
+        // Join the process-wide ORT environment (released in cleanup)
         OrtStatusGuard status_guard(cached_api);
-        status_guard.reset(cached_api->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "RAG_ONNX_Generator", &ort_env));
-        if (status_guard.is_error() || !ort_env) {
-            LOGE("Failed to create ONNX Runtime environment: %s", status_guard.error_message());
+        ort_env = ort_shared_env_acquire();
+        if (!ort_env) {
+            LOGE("Failed to acquire shared ONNX Runtime environment");
             return false;
         }
         
@@ -244,10 +250,6 @@ public:
             }
         } options_guard{cached_api, session_options};
         
-        // Configure session for performance (ignore return status - best effort)
-        cached_api->SetIntraOpNumThreads(session_options, 4);
-        cached_api->SetSessionGraphOptimizationLevel(session_options, ORT_ENABLE_ALL);
-        
         // Create memory info for CPU
         status_guard.reset(cached_api->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
         if (status_guard.is_error()) {
@@ -255,14 +257,21 @@ public:
             return false;
         }
         
-        // Load model and create session
+        // Load model and create session. Threads come from the shared
+        // environment's global pools; the optimized graph is cached on disk.
         LOGI("Loading ONNX model: %s", model_path.c_str());
-        status_guard.reset(cached_api->CreateSession(ort_env, model_path.c_str(), session_options, &session));
+        status_guard.reset(ort_shared_create_session(model_path.c_str(), session_options,
+                                                     OrtSessionPriority::NORMAL, ORT_ENABLE_ALL,
+                                                     &session));
         if (status_guard.is_error()) {
             LOGE("Failed to create ONNX session: %s", status_guard.error_message());
             return false;
         }
         
+        if (prewarm) {
+            ort_session_prewarm(session);
+        }
+
         LOGI("ONNX generator initialized successfully");
         LOGI("  Model: %s", model_path.c_str());
         LOGI("  Max context: %d tokens", max_context_length);
@@ -286,7 +295,7 @@ public:
                 memory_info = nullptr;
             }
             if (ort_env) {
-                cached_api->ReleaseEnv(ort_env);
+                ort_shared_env_release();
                 ort_env = nullptr;
             }
         }
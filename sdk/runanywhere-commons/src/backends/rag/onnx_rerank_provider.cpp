@@ -0,0 +1,295 @@
+/**
+ * @file onnx_rerank_provider.cpp
+ * @brief ONNX cross-encoder rerank provider implementation
+ */
+
+#include "onnx_rerank_provider.h"
+#include "backends/rag/ort_guards.h"
+#include "simple_tokenizer.h"
+#include "rac/core/rac_logger.h"
+#include "../onnx/ort_model_cache.h"
+#include "../onnx/ort_shared_env.h"
+
+#include <nlohmann/json.hpp>
+#include <onnxruntime_c_api.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <mutex>
+
+#define LOG_TAG "RAG.ONNXRerank"
+#define LOGI(...) RAC_LOG_INFO(LOG_TAG, __VA_ARGS__)
+#define LOGE(...) RAC_LOG_ERROR(LOG_TAG, __VA_ARGS__)
+
+namespace runanywhere {
+namespace rag {
+
+// =============================================================================
+// PIMPL IMPLEMENTATION
+// =============================================================================
+
+class ONNXRerankProvider::Impl {
+public:
+    explicit Impl(const std::string& model_path, const std::string& config_json) {
+        nlohmann::json config = nlohmann::json::object();
+        if (!config_json.empty()) {
+            try {
+                config = nlohmann::json::parse(config_json);
+            } catch (const std::exception& e) {
+                LOGE("Failed to parse config JSON: %s", e.what());
+            }
+            if (!config.is_object()) {
+                config = nlohmann::json::object();
+            }
+        }
+        max_length_ = config.value("max_length", max_length_);
+
+        const OrtApiBase* ort_api_base = OrtGetApiBase();
+        ort_api_ = ort_api_base ? ort_api_base->GetApi(ORT_API_VERSION) : nullptr;
+        if (!ort_api_) {
+            LOGE("Failed to get ONNX Runtime API (ORT_API_VERSION=%d)", ORT_API_VERSION);
+            return;
+        }
+        ort_env_ = ort_shared_env_acquire();
+        if (!ort_env_) {
+            LOGE("Failed to acquire shared ORT environment");
+            return;
+        }
+
+        // Cross-encoders ship the same vocab.txt as the embedding models
+        std::string vocab_path = config.value("vocab_path", config.value("vocabPath", ""));
+        if (vocab_path.empty()) {
+            vocab_path = (std::filesystem::path(model_path).parent_path() / "vocab.txt").string();
+        }
+        if (!std::filesystem::exists(vocab_path) || !tokenizer_.load_vocab(vocab_path)) {
+            LOGE("Tokenizer vocab not found: %s", vocab_path.c_str());
+            return;
+        }
+
+        if (!load_model(model_path)) {
+            LOGE("Failed to load model: %s", model_path.c_str());
+            return;
+        }
+        if (config.value("prewarm", false)) {
+            ort_session_prewarm(session_);
+        }
+
+        ready_ = true;
+        LOGI("ONNX rerank provider initialized: %s", model_path.c_str());
+    }
+
+    ~Impl() {
+        if (session_) {
+            ort_api_->ReleaseSession(session_);
+        }
+        if (ort_env_) {
+            ort_shared_env_release();
+        }
+    }
+
+    std::vector<float> score(const std::string& query, const std::vector<std::string>& passages) {
+        if (!ready_ || passages.empty()) {
+            return {};
+        }
+
+        // 1. Tokenize every pair and pad to the longest one, not to max_length
+        const size_t batch = passages.size();
+        std::vector<std::vector<int64_t>> pair_ids(batch);
+        std::vector<std::vector<int64_t>> pair_types(batch);
+        size_t seq_length = 0;
+        int64_t pad_id = 0;
+        {
+            std::lock_guard<std::mutex> lock(tokenizer_mutex_);
+            for (size_t i = 0; i < batch; ++i) {
+                tokenizer_.encode_pair(query, passages[i], max_length_, pair_ids[i], pair_types[i]);
+                seq_length = std::max(seq_length, pair_ids[i].size());
+            }
+            pad_id = tokenizer_.pad_id();
+        }
+
+        std::vector<int64_t> input_ids(batch * seq_length, pad_id);
+        std::vector<int64_t> attention_mask(batch * seq_length, 0);
+        std::vector<int64_t> token_type_ids(batch * seq_length, 0);
+        for (size_t i = 0; i < batch; ++i) {
+            const size_t row = i * seq_length;
+            std::copy(pair_ids[i].begin(), pair_ids[i].end(), input_ids.begin() + row);
+            std::copy(pair_types[i].begin(), pair_types[i].end(), token_type_ids.begin() + row);
+            std::fill_n(attention_mask.begin() + row, pair_ids[i].size(), 1);
+        }
+
+        // 2. One [batch, seq_length] inference call
+        std::vector<int64_t> input_shape = {static_cast<int64_t>(batch),
+                                            static_cast<int64_t>(seq_length)};
+        OrtStatusGuard status_guard(ort_api_);
+        OrtMemoryInfoGuard memory_info_guard(ort_api_);
+        status_guard.reset(ort_api_->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault,
+                                                         memory_info_guard.ptr()));
+        if (status_guard.is_error()) {
+            LOGE("CreateCpuMemoryInfo failed: %s", status_guard.error_message());
+            return {};
+        }
+
+        std::vector<OrtValueGuard> tensors;
+        tensors.reserve(input_names_.size());
+        std::vector<const OrtValue*> inputs;
+        std::vector<const char*> names;
+        for (const std::string& input_name : input_names_) {
+            std::vector<int64_t>* data = input_name == "attention_mask"   ? &attention_mask
+                                         : input_name == "token_type_ids" ? &token_type_ids
+                                                                          : &input_ids;
+            tensors.emplace_back(ort_api_);
+            status_guard.reset(ort_api_->CreateTensorWithDataAsOrtValue(
+                memory_info_guard.get(), data->data(), data->size() * sizeof(int64_t),
+                input_shape.data(), input_shape.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64,
+                tensors.back().ptr()));
+            if (status_guard.is_error()) {
+                LOGE("CreateTensorWithDataAsOrtValue (%s) failed: %s", input_name.c_str(),
+                     status_guard.error_message());
+                return {};
+            }
+            inputs.push_back(tensors.back().get());
+            names.push_back(input_name.c_str());
+        }
+
+        const char* output_names[] = {output_name_.c_str()};
+        OrtValueGuard output_guard(ort_api_);
+        status_guard.reset(ort_api_->Run(session_, nullptr, names.data(), inputs.data(),
+                                         inputs.size(), output_names, 1, output_guard.ptr()));
+        if (status_guard.is_error()) {
+            LOGE("ONNX inference failed: %s", status_guard.error_message());
+            return {};
+        }
+
+        // 3. Logits are [batch] or [batch, classes]; the last class is "relevant"
+        float* logits = nullptr;
+        status_guard.reset(ort_api_->GetTensorMutableData(output_guard.get(),
+                                                          reinterpret_cast<void**>(&logits)));
+        if (status_guard.is_error() || logits == nullptr) {
+            LOGE("Failed to get output tensor data");
+            return {};
+        }
+
+        size_t classes = 1;
+        OrtTensorTypeAndShapeInfo* shape_info = nullptr;
+        status_guard.reset(ort_api_->GetTensorTypeAndShape(output_guard.get(), &shape_info));
+        if (!status_guard.is_error() && shape_info != nullptr) {
+            size_t dim_count = 0;
+            ort_api_->GetDimensionsCount(shape_info, &dim_count);
+            if (dim_count == 2) {
+                int64_t dims[2] = {0, 0};
+                ort_api_->GetDimensions(shape_info, dims, 2);
+                classes = dims[1] > 0 ? static_cast<size_t>(dims[1]) : 1;
+            }
+            ort_api_->ReleaseTensorTypeAndShapeInfo(shape_info);
+        }
+
+        std::vector<float> scores(batch);
+        for (size_t i = 0; i < batch; ++i) {
+            const float logit = logits[i * classes + classes - 1];
+            scores[i] = 1.0f / (1.0f + std::exp(-logit));
+        }
+        return scores;
+    }
+
+    bool is_ready() const noexcept { return ready_; }
+
+private:
+    bool load_model(const std::string& model_path) {
+        OrtSessionOptionsGuard options_guard(ort_api_);
+        OrtStatusGuard status_guard(ort_api_);
+
+        status_guard.reset(ort_api_->CreateSessionOptions(options_guard.ptr()));
+        if (status_guard.is_error()) {
+            LOGE("Failed to create session options: %s", status_guard.error_message());
+            return false;
+        }
+
+        status_guard.reset(ort_shared_create_session(model_path.c_str(), options_guard.get(),
+                                                     OrtSessionPriority::NORMAL, ORT_ENABLE_ALL,
+                                                     &session_));
+        if (status_guard.is_error()) {
+            LOGE("Failed to load model: %s", status_guard.error_message());
+            return false;
+        }
+
+        // Feed only the inputs the model declares: XLM-R based rerankers
+        // have no token_type_ids
+        OrtAllocator* allocator = nullptr;
+        status_guard.reset(ort_api_->GetAllocatorWithDefaultOptions(&allocator));
+        if (status_guard.is_error()) {
+            return false;
+        }
+        size_t input_count = 0;
+        ort_api_->SessionGetInputCount(session_, &input_count);
+        for (size_t i = 0; i < input_count; ++i) {
+            char* input_name = nullptr;
+            status_guard.reset(ort_api_->SessionGetInputName(session_, i, allocator, &input_name));
+            if (status_guard.is_error()) {
+                return false;
+            }
+            input_names_.emplace_back(input_name);
+            ort_api_->AllocatorFree(allocator, input_name);
+        }
+
+        char* output_name = nullptr;
+        status_guard.reset(ort_api_->SessionGetOutputName(session_, 0, allocator, &output_name));
+        if (status_guard.is_error()) {
+            return false;
+        }
+        output_name_ = output_name;
+        ort_api_->AllocatorFree(allocator, output_name);
+        return true;
+    }
+
+    const OrtApi* ort_api_ = nullptr;
+    OrtEnv* ort_env_ = nullptr;
+    OrtSession* session_ = nullptr;
+    std::vector<std::string> input_names_;
+    std::string output_name_;
+
+    std::mutex tokenizer_mutex_;
+    SimpleTokenizer tokenizer_;
+    size_t max_length_ = 512;
+    bool ready_ = false;
+};
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+ONNXRerankProvider::ONNXRerankProvider(
+    const std::string& model_path,
+    const std::string& config_json
+) : impl_(std::make_unique<Impl>(model_path, config_json)) {
+}
+
+ONNXRerankProvider::~ONNXRerankProvider() = default;
+
+std::vector<float> ONNXRerankProvider::score(
+    const std::string& query,
+    const std::vector<std::string>& passages
+) {
+    return impl_->score(query, passages);
+}
+
+bool ONNXRerankProvider::is_ready() const noexcept {
+    return impl_->is_ready();
+}
+
+const char* ONNXRerankProvider::name() const noexcept {
+    return "ONNX-CrossEncoder";
+}
+
+// =============================================================================
+// FACTORY FUNCTION
+// =============================================================================
+
+std::unique_ptr<IRerankProvider> create_onnx_rerank_provider(
+    const std::string& model_path,
+    const std::string& config_json
+) {
+    return std::make_unique<ONNXRerankProvider>(model_path, config_json);
+}
+
+} // namespace rag
+} // namespace runanywhere
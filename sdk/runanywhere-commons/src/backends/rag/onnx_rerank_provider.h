@@ -0,0 +1,56 @@
+/**
+ * @file onnx_rerank_provider.h
+ * @brief ONNX cross-encoder rerank provider
+ */
+
+#ifndef RUNANYWHERE_ONNX_RERANK_PROVIDER_H
+#define RUNANYWHERE_ONNX_RERANK_PROVIDER_H
+
+#include "inference_provider.h"
+#include <memory>
+
+namespace runanywhere {
+namespace rag {
+
+/**
+ * @brief ONNX implementation of rerank provider
+ * 
+ * Runs a BERT-style cross-encoder (e.g. ms-marco-MiniLM) over all
+ * query/passage pairs in one batched inference call.
+ * Thread-safe after initialization.
+ */
+class ONNXRerankProvider final : public IRerankProvider {
+public:
+    /**
+     * @brief Construct ONNX rerank provider
+     * 
+     * @param model_path Path to ONNX cross-encoder model
+     * @param config_json Optional JSON configuration
+     */
+    explicit ONNXRerankProvider(
+        const std::string& model_path,
+        const std::string& config_json = ""
+    );
+
+    ~ONNXRerankProvider() override;
+
+    ONNXRerankProvider(const ONNXRerankProvider&) = delete;
+    ONNXRerankProvider& operator=(const ONNXRerankProvider&) = delete;
+
+    // IRerankProvider interface
+    std::vector<float> score(
+        const std::string& query,
+        const std::vector<std::string>& passages
+    ) override;
+    bool is_ready() const noexcept override;
+    const char* name() const noexcept override;
+
+private:
+    class Impl;
+    std::unique_ptr<Impl> impl_;
+};
+
+} // namespace rag
+} // namespace runanywhere
+
+#endif // RUNANYWHERE_ONNX_RERANK_PROVIDER_H
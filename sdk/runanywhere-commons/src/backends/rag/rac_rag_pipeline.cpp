@@ -9,14 +9,18 @@
 
 #ifdef RAG_HAS_ONNX_PROVIDER
 #include "onnx_embedding_provider.h"
+#include "onnx_rerank_provider.h"
 #endif
 
 #ifdef RAG_HAS_LLAMACPP_PROVIDER  
+#include "llamacpp_embedding_provider.h"
 #include "llamacpp_generator.h"
 #endif
 
 #include <memory>
+#include <cctype>
 #include <cstring>
+#include <string>
 #include <chrono>
 
 #include "rac/core/rac_logger.h"
@@ -30,6 +34,22 @@
 
 using namespace runanywhere::rag;
 
+namespace {
+
+bool is_gguf_path(const char* path) {
+    const size_t length = std::strlen(path);
+    if (length < 5) {
+        return false;
+    }
+    std::string extension(path + length - 5);
+    for (char& c : extension) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return extension == ".gguf";
+}
+
+} // namespace
+
 // =============================================================================
 // PIPELINE HANDLE
 // =============================================================================
@@ -75,29 +95,71 @@ rac_result_t rac_rag_pipeline_create(
             ? config->max_context_tokens : 2048;
         backend_config.chunk_size = config->chunk_size > 0 ? config->chunk_size : 512;
         backend_config.chunk_overlap = config->chunk_overlap;
+        backend_config.rerank_candidates = config->rerank_candidates > 0
+            ? config->rerank_candidates : 50;
         
         if (config->prompt_template != nullptr) {
             backend_config.prompt_template = config->prompt_template;
         }
 
-        // Create embedding provider
+        // Create embedding provider: GGUF models run on llama.cpp, the rest on ONNX
         std::unique_ptr<IEmbeddingProvider> embedding_provider;
-#ifdef RAG_HAS_ONNX_PROVIDER
         std::string embedding_config = config->embedding_config_json != nullptr 
             ? config->embedding_config_json : "";
-        embedding_provider = create_onnx_embedding_provider(
-            config->embedding_model_path,
-            embedding_config
-        );
+        if (is_gguf_path(config->embedding_model_path)) {
+#ifdef RAG_HAS_LLAMACPP_PROVIDER
+            embedding_provider = create_llamacpp_embedding_provider(
+                config->embedding_model_path,
+                embedding_config
+            );
+#else
+            LOGE("GGUF embedding model requires the LlamaCPP backend");
+            return RAC_ERROR_NOT_SUPPORTED;
+#endif
+        } else {
+#ifdef RAG_HAS_ONNX_PROVIDER
+            embedding_provider = create_onnx_embedding_provider(
+                config->embedding_model_path,
+                embedding_config
+            );
+#else
+            LOGE("No embedding provider available - ONNX backend not built");
+            return RAC_ERROR_NOT_SUPPORTED;
+#endif
+        }
         
         if (!embedding_provider || !embedding_provider->is_ready()) {
             LOGE("Failed to initialize embedding provider");
             return RAC_ERROR_INITIALIZATION_FAILED;
         }
+
+        // The model decides the vector size; index with what it produces
+        if (embedding_provider->dimension() != backend_config.embedding_dimension) {
+            LOGW("Embedding dimension %zu from config differs from model (%zu), using model's",
+                 backend_config.embedding_dimension, embedding_provider->dimension());
+            backend_config.embedding_dimension = embedding_provider->dimension();
+        }
+
+        // Optional cross-encoder reranker
+        std::unique_ptr<IRerankProvider> rerank_provider;
+        if (config->reranker_model_path != nullptr && config->reranker_model_path[0] != '\0') {
+#ifdef RAG_HAS_ONNX_PROVIDER
+            std::string reranker_config = config->reranker_config_json != nullptr
+                ? config->reranker_config_json : "";
+            rerank_provider = create_onnx_rerank_provider(
+                config->reranker_model_path,
+                reranker_config
+            );
+
+            if (!rerank_provider || !rerank_provider->is_ready()) {
+                LOGE("Failed to initialize rerank provider");
+                return RAC_ERROR_INITIALIZATION_FAILED;
+            }
 #else
-        LOGE("No embedding provider available - ONNX backend not built");
-        return RAC_ERROR_NOT_SUPPORTED;
+            LOGE("Reranker requires the ONNX backend");
+            return RAC_ERROR_NOT_SUPPORTED;
 #endif
+        }
         
         // Create text generator using LlamaCPP (supports .gguf format)
         std::string llm_config = config->llm_config_json != nullptr 
@@ -144,6 +206,10 @@ rac_result_t rac_rag_pipeline_create(
             return RAC_ERROR_INITIALIZATION_FAILED;
         }
 
+        if (rerank_provider) {
+            pipeline->backend->set_rerank_provider(std::move(rerank_provider));
+        }
+
         *out_pipeline = pipeline.release();
         LOGI("RAG pipeline created");
         return RAC_SUCCESS;
@@ -184,6 +250,59 @@ rac_result_t rac_rag_add_document(
     }
 }
 
+rac_result_t rac_rag_add_document_file(
+    rac_rag_pipeline_t* pipeline,
+    const char* file_path,
+    const char* metadata_json
+) {
+    if (pipeline == nullptr || file_path == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    try {
+        nlohmann::json metadata;
+        if (metadata_json != nullptr) {
+            metadata = nlohmann::json::parse(metadata_json);
+        }
+
+        bool success = pipeline->backend->add_document_file(file_path, metadata);
+        return success ? RAC_SUCCESS : RAC_ERROR_PROCESSING_FAILED;
+
+    } catch (const std::exception& e) {
+        LOGE("Exception adding document file: %s", e.what());
+        return RAC_ERROR_PROCESSING_FAILED;
+    }
+}
+
+rac_result_t rac_rag_add_document_stream(
+    rac_rag_pipeline_t* pipeline,
+    rac_rag_read_callback_t read,
+    void* user_data,
+    const char* metadata_json
+) {
+    if (pipeline == nullptr || read == nullptr) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    try {
+        nlohmann::json metadata;
+        if (metadata_json != nullptr) {
+            metadata = nlohmann::json::parse(metadata_json);
+        }
+
+        bool success = pipeline->backend->add_document_stream(
+            [read, user_data](char* buffer, size_t capacity) {
+                return read(user_data, buffer, capacity);
+            },
+            metadata);
+        return success ? RAC_SUCCESS : RAC_ERROR_PROCESSING_FAILED;
+
+    } catch (const std::exception& e) {
+        LOGE("Exception adding document stream: %s", e.what());
+        return RAC_ERROR_PROCESSING_FAILED;
+    }
+}
+
 rac_result_t rac_rag_add_documents_batch(
     rac_rag_pipeline_t* pipeline,
     const char** documents,
@@ -5,6 +5,9 @@
 
 #include "rag_backend.h"
 
+#include <algorithm>
+#include <fstream>
+
 #include "rac/core/rac_logger.h"
 
 #define LOG_TAG "RAG.Backend"
@@ -27,10 +30,7 @@ RAGBackend::RAGBackend(
     vector_store_ = std::make_unique<VectorStoreUSearch>(store_config);
 
     // Create chunker
-    ChunkerConfig chunker_config;
-    chunker_config.chunk_size = config.chunk_size;
-    chunker_config.chunk_overlap = config.chunk_overlap;
-    chunker_ = std::make_unique<DocumentChunker>(chunker_config);
+    rebuild_chunker();
 
     initialized_ = true;
     LOGI("RAG backend initialized: dim=%zu, chunk_size=%zu",
@@ -41,6 +41,22 @@ RAGBackend::~RAGBackend() {
     clear();
 }
 
+void RAGBackend::rebuild_chunker() {
+    ChunkerConfig chunker_config;
+    chunker_config.chunk_size = config_.chunk_size;
+    chunker_config.chunk_overlap = config_.chunk_overlap;
+
+    // Size chunks with the embedding model's tokenizer so they fit its context
+    if (embedding_provider_ && embedding_provider_->has_tokenizer()) {
+        std::shared_ptr<IEmbeddingProvider> provider = embedding_provider_;
+        chunker_config.count_tokens = [provider](std::string_view text) {
+            return provider->count_tokens(std::string(text));
+        };
+    }
+
+    chunker_ = std::make_unique<DocumentChunker>(chunker_config);
+}
+
 void RAGBackend::set_embedding_provider(std::unique_ptr<IEmbeddingProvider> provider) {
     std::lock_guard<std::mutex> lock(mutex_);
     embedding_provider_ = std::shared_ptr<IEmbeddingProvider>(std::move(provider));
@@ -51,6 +67,18 @@ void RAGBackend::set_embedding_provider(std::unique_ptr<IEmbeddingProvider> prov
         LOGI("Set embedding provider: %s, dim=%zu", 
              embedding_provider_->name(), config_.embedding_dimension);
     }
+
+    rebuild_chunker();
+}
+
+void RAGBackend::set_rerank_provider(std::unique_ptr<IRerankProvider> provider) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    rerank_provider_ = std::shared_ptr<IRerankProvider>(std::move(provider));
+
+    if (rerank_provider_ && rerank_provider_->is_ready()) {
+        LOGI("Set rerank provider: %s, candidates=%zu",
+             rerank_provider_->name(), config_.rerank_candidates);
+    }
 }
 
 void RAGBackend::set_text_generator(std::unique_ptr<ITextGenerator> generator) {
@@ -68,6 +96,92 @@ bool RAGBackend::add_document(
 ) {
     std::lock_guard<std::mutex> lock(mutex_);
 
+    if (!ready_for_ingest()) {
+        return false;
+    }
+
+    ChunkWindowState state;
+    size_t consumed = 0;
+    size_t added = 0;
+    if (!ingest_window(text, 0, true, 0, metadata, state, consumed, added)) {
+        return false;
+    }
+
+    LOGI("Successfully added %zu chunks from document", added);
+    return true;
+}
+
+bool RAGBackend::add_document_file(
+    const std::string& path,
+    const nlohmann::json& metadata
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!ready_for_ingest()) {
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        // No mmap on this platform (or not mappable): stream it instead
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if (!stream) {
+            LOGE("Cannot open document file: %s", path.c_str());
+            return false;
+        }
+        const uint64_t size = static_cast<uint64_t>(stream.tellg());
+        stream.seekg(0);
+        const uint32_t file_id = sources_.add(path, size);
+        return ingest_stream(
+            [&stream](char* buffer, size_t capacity) -> int64_t {
+                stream.read(buffer, static_cast<std::streamsize>(capacity));
+                return stream.bad() ? -1 : static_cast<int64_t>(stream.gcount());
+            },
+            file_id, metadata);
+    }
+
+    const uint32_t file_id = sources_.add(path, file.size());
+    const std::string_view text = file.view();
+    ChunkWindowState state;
+    size_t pos = 0;
+    size_t total_added = 0;
+
+    while (pos < text.size()) {
+        const size_t window_size = std::min(kIngestWindowBytes, text.size() - pos);
+        const bool at_end = pos + window_size == text.size();
+        size_t consumed = 0;
+        size_t added = 0;
+        if (!ingest_window(text.substr(pos, window_size), pos, at_end, file_id, metadata,
+                           state, consumed, added)) {
+            return false;
+        }
+        total_added += added;
+        if (at_end) {
+            break;
+        }
+        pos += consumed;
+        file.release_prefix(pos);
+    }
+
+    LOGI("Added %zu chunks from %s (%zu bytes)", total_added, path.c_str(), text.size());
+    return true;
+}
+
+bool RAGBackend::add_document_stream(
+    const ReadCallback& read,
+    const nlohmann::json& metadata
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (!ready_for_ingest()) {
+        return false;
+    }
+
+    // No file to read back from: chunk text is stored inline
+    return ingest_stream(read, 0, metadata);
+}
+
+bool RAGBackend::ready_for_ingest() const {
     if (!initialized_) {
         LOGE("Backend not initialized");
         return false;
@@ -78,16 +192,103 @@ bool RAGBackend::add_document(
         return false;
     }
 
+    return true;
+}
+
+bool RAGBackend::ingest_stream(
+    const ReadCallback& read,
+    uint32_t file_id,
+    const nlohmann::json& metadata
+) {
+    // Holds at most one window; consumed text is shifted out
+    std::string buffer;
+    buffer.reserve(kIngestWindowBytes);
+    uint64_t buffer_offset = 0;
+    bool at_end = false;
+    ChunkWindowState state;
+    size_t total_added = 0;
+
+    while (true) {
+        while (!at_end && buffer.size() < kIngestWindowBytes) {
+            const size_t old_size = buffer.size();
+            buffer.resize(kIngestWindowBytes);
+            const int64_t got = read(&buffer[old_size], kIngestWindowBytes - old_size);
+            if (got < 0) {
+                LOGE("Document reader failed");
+                return false;
+            }
+            buffer.resize(old_size + static_cast<size_t>(got));
+            at_end = got == 0;
+        }
+
+        if (buffer.empty()) {
+            break;
+        }
+
+        size_t consumed = 0;
+        size_t added = 0;
+        if (!ingest_window(buffer, buffer_offset, at_end, file_id, metadata, state, consumed,
+                           added)) {
+            return false;
+        }
+        total_added += added;
+        if (at_end) {
+            break;
+        }
+        buffer.erase(0, consumed);
+        buffer_offset += consumed;
+    }
+
+    LOGI("Added %zu chunks from streamed document (%llu bytes)", total_added,
+         static_cast<unsigned long long>(buffer_offset + buffer.size()));
+    return true;
+}
+
+bool RAGBackend::ingest_window(
+    std::string_view window,
+    uint64_t window_offset,
+    bool at_end,
+    uint32_t file_id,
+    const nlohmann::json& metadata,
+    ChunkWindowState& state,
+    size_t& consumed,
+    size_t& added
+) {
     // Split into chunks
-    auto chunks = chunker_->chunk_document(text);
-    LOGI("Split document into %zu chunks", chunks.size());
+    auto chunks = chunker_->chunk_window(window, at_end, state, consumed);
 
-    // Embed and add each chunk
+    if (chunks.empty()) {
+        return true;
+    }
+
+    // Embed the whole window in one call so batching providers can run
+    // many chunks per inference
+    std::vector<std::string> chunk_texts;
+    chunk_texts.reserve(chunks.size());
     for (const auto& chunk_obj : chunks) {
+        chunk_texts.emplace_back(chunk_obj.text);
+    }
+
+    std::vector<std::vector<float>> embeddings;
+    try {
+        embeddings = embedding_provider_->embed_batch(chunk_texts);
+    } catch (const std::exception& e) {
+        LOGE("Failed to embed chunks: %s", e.what());
+        return false;
+    }
+    if (embeddings.size() != chunks.size()) {
+        LOGE("Embedding count mismatch: got %zu, expected %zu",
+             embeddings.size(), chunks.size());
+        return false;
+    }
+
+    // Add each chunk
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        const auto& chunk_obj = chunks[i];
         try {
-            // Generate embedding
-            auto embedding = embedding_provider_->embed(chunk_obj.text);
-            
+            std::string& chunk_text = chunk_texts[i];
+            auto& embedding = embeddings[i];
+
             if (embedding.size() != config_.embedding_dimension) {
                 LOGE("Embedding dimension mismatch: got %zu, expected %zu",
                      embedding.size(), config_.embedding_dimension);
@@ -97,27 +298,31 @@ bool RAGBackend::add_document(
             // Create document chunk
             DocumentChunk chunk;
             chunk.id = "chunk_" + std::to_string(next_chunk_id_++);
-            chunk.text = chunk_obj.text;
             chunk.embedding = std::move(embedding);
             chunk.metadata = metadata;
-            chunk.metadata["source_text"] = text.substr(0, 100);  // First 100 chars
+            if (file_id != 0) {
+                // Keep a reference instead of a copy of the text
+                chunk.source.file_id = file_id;
+                chunk.source.offset = window_offset +
+                    static_cast<uint64_t>(chunk_obj.text.data() - window.data());
+                chunk.source.length = chunk_obj.text.size();
+            } else {
+                chunk.text = std::move(chunk_text);
+            }
 
             // Add to vector store
             if (!vector_store_->add_chunk(chunk)) {
                 LOGE("Failed to add chunk to vector store");
                 return false;
             }
-            
-            LOGI("Added chunk %s to vector store (text: %.50s...)", 
-                 chunk.id.c_str(), chunk.text.c_str());
-            
+            ++added;
+
         } catch (const std::exception& e) {
-            LOGE("Failed to embed chunk: %s", e.what());
+            LOGE("Failed to add chunk: %s", e.what());
             return false;
         }
     }
 
-    LOGI("Successfully added %zu chunks from document", chunks.size());
     return true;
 }
 
@@ -126,6 +331,8 @@ std::vector<SearchResult> RAGBackend::search(
     size_t top_k
 ) const {
     std::shared_ptr<IEmbeddingProvider> embedding_provider;
+    std::shared_ptr<IRerankProvider> rerank_provider;
+    size_t rerank_candidates = 0;
     size_t embedding_dimension = 0;
     float similarity_threshold = 0.0f;
     bool initialized = false;
@@ -133,6 +340,8 @@ std::vector<SearchResult> RAGBackend::search(
     {
         std::lock_guard<std::mutex> lock(mutex_);
         embedding_provider = embedding_provider_;
+        rerank_provider = rerank_provider_;
+        rerank_candidates = config_.rerank_candidates;
         embedding_dimension = config_.embedding_dimension;
         similarity_threshold = config_.similarity_threshold;
         initialized = initialized_;
@@ -142,6 +351,8 @@ std::vector<SearchResult> RAGBackend::search(
         query_text,
         top_k,
         embedding_provider,
+        rerank_provider,
+        rerank_candidates,
         embedding_dimension,
         similarity_threshold,
         initialized
@@ -152,6 +363,8 @@ std::vector<SearchResult> RAGBackend::search_with_provider(
     const std::string& query_text,
     size_t top_k,
     const std::shared_ptr<IEmbeddingProvider>& embedding_provider,
+    const std::shared_ptr<IRerankProvider>& rerank_provider,
+    size_t rerank_candidates,
     size_t embedding_dimension,
     float similarity_threshold,
     bool initialized
@@ -174,11 +387,52 @@ std::vector<SearchResult> RAGBackend::search_with_provider(
             return {};
         }
 
-        return vector_store_->search(
+        // A reranker picks top_k out of a wider candidate set
+        const bool rerank = rerank_provider && rerank_provider->is_ready();
+        auto results = vector_store_->search(
             query_embedding,
-            top_k,
+            rerank ? std::max(top_k, rerank_candidates) : top_k,
             similarity_threshold
         );
+
+        // Read back text for chunks ingested from files
+        for (auto& result : results) {
+            if (result.source.file_id != 0 && !sources_.read(result.source, result.text)) {
+                LOGE("Cannot read source text for chunk %s", result.id.c_str());
+            }
+        }
+        results.erase(
+            std::remove_if(results.begin(), results.end(),
+                           [](const SearchResult& r) {
+                               return r.source.file_id != 0 && r.text.empty();
+                           }),
+            results.end());
+
+        if (rerank && results.size() > 1) {
+            std::vector<std::string> passages;
+            passages.reserve(results.size());
+            for (const auto& result : results) {
+                passages.push_back(result.text);
+            }
+
+            // One batched scoring call; on failure keep the vector order
+            auto scores = rerank_provider->score(query_text, passages);
+            if (scores.size() == results.size()) {
+                for (size_t i = 0; i < results.size(); ++i) {
+                    results[i].score = scores[i];
+                }
+                std::stable_sort(results.begin(), results.end(),
+                                 [](const SearchResult& a, const SearchResult& b) {
+                                     return a.score > b.score;
+                                 });
+            } else {
+                LOGE("Reranking failed, using vector search order");
+            }
+        }
+        if (results.size() > top_k) {
+            results.resize(top_k);
+        }
+        return results;
         
     } catch (const std::exception& e) {
         LOGE("Search failed: %s", e.what());
@@ -225,7 +479,9 @@ GenerationResult RAGBackend::query(
     const GenerationOptions& options
 ) {
     std::shared_ptr<IEmbeddingProvider> embedding_provider;
+    std::shared_ptr<IRerankProvider> rerank_provider;
     std::shared_ptr<ITextGenerator> text_generator;
+    size_t rerank_candidates = 0;
     size_t embedding_dimension = 0;
     float similarity_threshold = 0.0f;
     size_t top_k = 0;
@@ -235,7 +491,9 @@ GenerationResult RAGBackend::query(
     {
         std::lock_guard<std::mutex> lock(mutex_);
         embedding_provider = embedding_provider_;
+        rerank_provider = rerank_provider_;
         text_generator = text_generator_;
+        rerank_candidates = config_.rerank_candidates;
         embedding_dimension = config_.embedding_dimension;
         similarity_threshold = config_.similarity_threshold;
         top_k = config_.top_k;
@@ -266,6 +524,8 @@ GenerationResult RAGBackend::query(
             query,
             top_k,
             embedding_provider,
+            rerank_provider,
+            rerank_candidates,
             embedding_dimension,
             similarity_threshold,
             initialized
@@ -310,7 +570,11 @@ GenerationResult RAGBackend::query(
                 nlohmann::json source;
                 source["id"] = res.id;
                 source["score"] = res.score;
-                if (res.metadata.contains("source_text")) {
+                if (res.source.file_id != 0) {
+                    source["file"] = sources_.path(res.source.file_id);
+                    source["offset"] = res.source.offset;
+                    source["length"] = res.source.length;
+                } else if (res.metadata.contains("source_text")) {
                     source["source"] = res.metadata["source_text"];
                 }
                 sources.push_back(source);
@@ -334,6 +598,7 @@ void RAGBackend::clear() {
     if (vector_store_) {
         vector_store_->clear();
     }
+    sources_.clear();
     next_chunk_id_ = 0;
 }
 
@@ -348,6 +613,8 @@ nlohmann::json RAGBackend::get_statistics() const {
     stats["config"] = {
         {"embedding_dimension", config_.embedding_dimension},
         {"top_k", config_.top_k},
+        {"rerank_candidates", config_.rerank_candidates},
+        {"reranker", rerank_provider_ ? rerank_provider_->name() : ""},
         {"similarity_threshold", config_.similarity_threshold},
         {"chunk_size", config_.chunk_size},
         {"chunk_overlap", config_.chunk_overlap}
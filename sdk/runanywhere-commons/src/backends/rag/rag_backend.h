@@ -6,8 +6,10 @@
 #ifndef RUNANYWHERE_RAG_BACKEND_H
 #define RUNANYWHERE_RAG_BACKEND_H
 
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <mutex>
 
@@ -15,6 +17,7 @@
 
 #include "vector_store_usearch.h"
 #include "rag_chunker.h"
+#include "rag_source.h"
 #include "inference_provider.h"
 
 namespace runanywhere {
@@ -26,6 +29,7 @@ namespace rag {
 struct RAGBackendConfig {
     size_t embedding_dimension = 384;
     size_t top_k = 3;
+    size_t rerank_candidates = 50;  // Vector search hits rescored when a reranker is set
     float similarity_threshold = 0.15f;
     size_t max_context_tokens = 2048;
     size_t chunk_size = 512;
@@ -34,7 +38,7 @@ struct RAGBackendConfig {
 };
 
 /**
- * @brief RAG backend coordinating vector store, embeddings, and generation
+ * @brief RAG backend coordinating vector store, embeddings, reranking and generation
  * 
  * Uses strategy pattern with pluggable embedding and generation providers.
  * Thread-safe for all operations.
@@ -65,6 +69,17 @@ public:
      */
     void set_embedding_provider(std::unique_ptr<IEmbeddingProvider> provider);
 
+    /**
+     * @brief Set rerank provider (nullptr disables reranking)
+     *
+     * With a reranker, search() fetches rerank_candidates hits from the
+     * vector store, rescores them against the query and keeps the best
+     * top_k, so fewer but more relevant chunks reach the prompt.
+     *
+     * @param provider Rerank provider to use
+     */
+    void set_rerank_provider(std::unique_ptr<IRerankProvider> provider);
+
     /**
      * @brief Set text generator
      * 
@@ -85,12 +100,46 @@ public:
         const nlohmann::json& metadata = {}
     );
 
+    /**
+     * @brief Reads up to capacity bytes; returns the count, 0 at end, <0 on error
+     */
+    using ReadCallback = std::function<int64_t(char* buffer, size_t capacity)>;
+
+    /**
+     * @brief Add a document from a file without loading it into memory
+     *
+     * The file is memory-mapped and chunked, embedded and indexed one window
+     * at a time, so memory stays bounded regardless of file size. Chunks
+     * store a byte range into the file rather than their text; the text is
+     * read back from the file when a chunk is retrieved, so the file must
+     * stay in place and unchanged.
+     *
+     * @param path Document file (UTF-8 text)
+     * @param metadata Optional metadata
+     * @return true on success, false on failure
+     */
+    bool add_document_file(
+        const std::string& path,
+        const nlohmann::json& metadata = {}
+    );
+
+    /**
+     * @brief Add a document produced incrementally by a reader
+     *
+     * Same bounded-memory ingestion as add_document_file(). Chunk text is
+     * stored inline since there is no file to read it back from.
+     */
+    bool add_document_stream(
+        const ReadCallback& read,
+        const nlohmann::json& metadata = {}
+    );
+
     /**
      * @brief Search for relevant chunks using query text
      * 
      * @param query_text Query text to embed and search
      * @param top_k Number of results to return
-     * @return Search results sorted by similarity
+     * @return Search results sorted by score (the reranker's when one is set)
      * @throws std::runtime_error if embedding provider not set
      */
     std::vector<SearchResult> search(
@@ -139,10 +188,26 @@ public:
     size_t document_count() const;
 
 private:
+    // Bytes chunked and embedded per step of file/stream ingestion
+    static constexpr size_t kIngestWindowBytes = 1 << 20;
+
+    // Caller holds mutex_ for the following
+    bool ready_for_ingest() const;
+    bool ingest_stream(const ReadCallback& read, uint32_t file_id,
+                       const nlohmann::json& metadata);
+    bool ingest_window(std::string_view window, uint64_t window_offset, bool at_end,
+                       uint32_t file_id, const nlohmann::json& metadata,
+                       ChunkWindowState& state, size_t& consumed, size_t& added);
+
+    // Recreate the chunker, counting real tokens if the provider can. Caller holds mutex_.
+    void rebuild_chunker();
+
     std::vector<SearchResult> search_with_provider(
         const std::string& query_text,
         size_t top_k,
         const std::shared_ptr<IEmbeddingProvider>& embedding_provider,
+        const std::shared_ptr<IRerankProvider>& rerank_provider,
+        size_t rerank_candidates,
         size_t embedding_dimension,
         float similarity_threshold,
         bool initialized
@@ -151,7 +216,9 @@ private:
     RAGBackendConfig config_;
     std::unique_ptr<VectorStoreUSearch> vector_store_;
     std::unique_ptr<DocumentChunker> chunker_;
+    SourceRegistry sources_;
     std::shared_ptr<IEmbeddingProvider> embedding_provider_;
+    std::shared_ptr<IRerankProvider> rerank_provider_;
     std::shared_ptr<ITextGenerator> text_generator_;
     bool initialized_ = false;
     mutable std::mutex mutex_;
@@ -7,109 +7,295 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RAG_CHUNKER_SSE2 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define RAG_CHUNKER_NEON 1
+#endif
 
 namespace runanywhere {
 namespace rag {
 
+namespace {
+
+inline bool is_sentence_delimiter(char c) {
+    return c == '.' || c == '!' || c == '?' || c == '\n';
+}
+
+inline int count_trailing_zeros(uint64_t value) {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward64(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctzll(value);
+#endif
+}
+
+// Position of the next '.', '!', '?' or '\n' at or after pos, or size if none
+size_t find_next_delimiter(const char* data, size_t size, size_t pos) {
+#if defined(RAG_CHUNKER_SSE2)
+    const __m128i dot = _mm_set1_epi8('.');
+    const __m128i bang = _mm_set1_epi8('!');
+    const __m128i question = _mm_set1_epi8('?');
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; pos + 16 <= size; pos += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        const __m128i hits = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(block, dot), _mm_cmpeq_epi8(block, bang)),
+            _mm_or_si128(_mm_cmpeq_epi8(block, question), _mm_cmpeq_epi8(block, newline)));
+        const int mask = _mm_movemask_epi8(hits);
+        if (mask != 0) {
+            return pos + static_cast<size_t>(count_trailing_zeros(static_cast<uint64_t>(mask)));
+        }
+    }
+#elif defined(RAG_CHUNKER_NEON)
+    const uint8x16_t dot = vdupq_n_u8('.');
+    const uint8x16_t bang = vdupq_n_u8('!');
+    const uint8x16_t question = vdupq_n_u8('?');
+    const uint8x16_t newline = vdupq_n_u8('\n');
+    for (; pos + 16 <= size; pos += 16) {
+        const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t*>(data + pos));
+        const uint8x16_t hits = vorrq_u8(vorrq_u8(vceqq_u8(block, dot), vceqq_u8(block, bang)),
+                                         vorrq_u8(vceqq_u8(block, question),
+                                                  vceqq_u8(block, newline)));
+        // Narrow each byte to a nibble: 4 mask bits per input byte
+        const uint64_t mask =
+            vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hits), 4)), 0);
+        if (mask != 0) {
+            return pos + static_cast<size_t>(count_trailing_zeros(mask) >> 2);
+        }
+    }
+#endif
+    for (; pos < size; ++pos) {
+        if (is_sentence_delimiter(data[pos])) {
+            return pos;
+        }
+    }
+    return size;
+}
+
+std::string_view trim_whitespace(std::string_view text) {
+    const size_t first = text.find_first_not_of(" \t\n\r");
+    if (first == std::string_view::npos) {
+        return {};
+    }
+    const size_t last = text.find_last_not_of(" \t\n\r");
+    return text.substr(first, last - first + 1);
+}
+
+TextChunkView make_view(std::string_view text, size_t start, size_t end, size_t index) {
+    TextChunkView chunk;
+    chunk.text = trim_whitespace(text.substr(start, end - start));
+    chunk.start_position = start;
+    chunk.end_position = end;
+    chunk.chunk_index = index;
+    return chunk;
+}
+
+}  // namespace
+
 DocumentChunker::DocumentChunker(const ChunkerConfig& config) : config_(config) {}
 
 std::vector<TextChunk> DocumentChunker::chunk_document(const std::string& text) const {
+    auto views = chunk_document_views(text);
+
+    std::vector<TextChunk> chunks;
+    chunks.reserve(views.size());
+    for (const auto& view : views) {
+        TextChunk chunk;
+        chunk.text.assign(view.text.data(), view.text.size());
+        chunk.start_position = view.start_position;
+        chunk.end_position = view.end_position;
+        chunk.chunk_index = view.chunk_index;
+        chunks.push_back(std::move(chunk));
+    }
+    return chunks;
+}
+
+std::vector<TextChunkView> DocumentChunker::chunk_document_views(std::string_view text) const {
+    return chunk_views(text, 0, true);
+}
+
+std::vector<TextChunkView> DocumentChunker::chunk_views(std::string_view text,
+                                                        size_t first_index,
+                                                        bool at_end) const {
     if (text.empty()) {
         return {};
     }
 
     // Find sentence boundaries
     auto boundaries = find_sentence_boundaries(text);
-    
+
     // Split into chunks respecting boundaries
-    return split_by_boundaries(text, boundaries);
+    if (config_.count_tokens) {
+        return split_by_token_counts(text, boundaries, first_index);
+    }
+    return split_by_boundaries(text, boundaries, first_index, at_end);
+}
+
+std::vector<TextChunkView> DocumentChunker::chunk_window(
+    std::string_view window,
+    bool at_end,
+    ChunkWindowState& state,
+    size_t& consumed
+) const {
+    auto chunks = chunk_views(window, state.next_chunk_index, at_end);
+    consumed = window.size();
+    if (chunks.empty()) {
+        return chunks;
+    }
+
+    if (at_end || chunks.size() == 1) {
+        // Chunk larger than the window: cut it here
+        if (!at_end) {
+            consumed = chunks.front().end_position;
+        }
+        state.next_chunk_index = chunks.back().chunk_index + 1;
+        return chunks;
+    }
+
+    // The last chunk may grow with more text; redo it in the next window
+    consumed = chunks.back().start_position;
+    state.next_chunk_index = chunks.back().chunk_index;
+    chunks.pop_back();
+    return chunks;
 }
 
-size_t DocumentChunker::estimate_tokens(const std::string& text) const {
+size_t DocumentChunker::estimate_tokens(std::string_view text) const {
+    if (config_.count_tokens) {
+        return config_.count_tokens(text);
+    }
     return text.length() / config_.chars_per_token;
 }
 
-std::vector<size_t> DocumentChunker::find_sentence_boundaries(const std::string& text) const {
+std::vector<size_t> DocumentChunker::find_sentence_boundaries(std::string_view text) const {
     std::vector<size_t> boundaries;
+    boundaries.reserve(text.length() / 64 + 2);
     boundaries.push_back(0); // Start of document
 
-    for (size_t i = 0; i < text.length(); ++i) {
-        char c = text[i];
-        
-        // Check for sentence endings
-        if (c == '.' || c == '!' || c == '?' || c == '\n') {
-            // Look ahead for whitespace
-            if (i + 1 < text.length() && std::isspace(static_cast<unsigned char>(text[i + 1]))) {
-                boundaries.push_back(i + 1);
-            }
+    const size_t length = text.length();
+    for (size_t i = find_next_delimiter(text.data(), length, 0); i < length;
+         i = find_next_delimiter(text.data(), length, i + 1)) {
+        // Sentence ending followed by whitespace
+        if (i + 1 < length && std::isspace(static_cast<unsigned char>(text[i + 1]))) {
+            boundaries.push_back(i + 1);
         }
     }
 
-    boundaries.push_back(text.length()); // End of document
+    boundaries.push_back(length); // End of document
     return boundaries;
 }
 
-std::vector<TextChunk> DocumentChunker::split_by_boundaries(
-    const std::string& text,
-    const std::vector<size_t>& boundaries
+std::vector<TextChunkView> DocumentChunker::split_by_boundaries(
+    std::string_view text,
+    const std::vector<size_t>& boundaries,
+    size_t first_index,
+    bool at_end
 ) const {
-    std::vector<TextChunk> chunks;
-    
-    size_t chunk_size_chars = config_.chunk_size * config_.chars_per_token;
+    std::vector<TextChunkView> chunks;
+
+    size_t chunk_size_chars = std::max<size_t>(config_.chunk_size * config_.chars_per_token, 1);
     size_t overlap_chars = config_.chunk_overlap * config_.chars_per_token;
-    
-    size_t chunk_index = 0;
+
+    size_t chunk_index = first_index;
     size_t start_pos = 0;
-    
+    size_t cursor = 0;  // Only moves forward: start_pos never decreases
+
     while (start_pos < text.length()) {
         // Find end position for this chunk
         size_t target_end = start_pos + chunk_size_chars;
-        
+
         // Find the nearest boundary after target_end
-        size_t end_pos = text.length();
-        for (size_t boundary : boundaries) {
-            if (boundary >= target_end) {
-                end_pos = boundary;
-                break;
-            }
+        while (cursor < boundaries.size() && boundaries[cursor] < target_end) {
+            ++cursor;
         }
-        
-        // Don't create tiny chunks at the end
-        if (end_pos - start_pos < chunk_size_chars / 2 && chunk_index > 0) {
-            // Merge with previous chunk or extend
-            if (!chunks.empty()) {
-                chunks.back().text += " " + text.substr(start_pos);
-                chunks.back().end_position = text.length();
-            }
+        size_t end_pos = cursor < boundaries.size() ? boundaries[cursor] : text.length();
+
+        // Don't create tiny chunks at the end: extend the previous chunk to
+        // the end of the document. A window that stops short of the end has
+        // no tail yet, and a previous chunk that went out with an earlier
+        // window can no longer grow, so keep the tail as its own chunk then.
+        if (at_end && end_pos - start_pos < chunk_size_chars / 2 && chunk_index > 0 &&
+            !chunks.empty()) {
+            TextChunkView& last = chunks.back();
+            last = make_view(text, last.start_position, text.length(), last.chunk_index);
             break;
         }
-        
+
         // Create chunk
-        TextChunk chunk;
-        chunk.text = text.substr(start_pos, end_pos - start_pos);
-        chunk.start_position = start_pos;
-        chunk.end_position = end_pos;
-        chunk.chunk_index = chunk_index++;
-        
-        // Trim whitespace
-        size_t first = chunk.text.find_first_not_of(" \t\n\r");
-        size_t last = chunk.text.find_last_not_of(" \t\n\r");
-        if (first != std::string::npos && last != std::string::npos) {
-            chunk.text = chunk.text.substr(first, last - first + 1);
-        }
-        
+        TextChunkView chunk = make_view(text, start_pos, end_pos, chunk_index++);
         if (!chunk.text.empty()) {
-            chunks.push_back(std::move(chunk));
+            chunks.push_back(chunk);
         }
-        
+
         // Move to next chunk with overlap
         if (end_pos >= text.length()) {
             break;
         }
-        
-        start_pos = end_pos > overlap_chars ? end_pos - overlap_chars : end_pos;
+
+        size_t next_start = end_pos > overlap_chars ? end_pos - overlap_chars : end_pos;
+        start_pos = next_start > start_pos ? next_start : end_pos;
     }
-    
+
+    return chunks;
+}
+
+std::vector<TextChunkView> DocumentChunker::split_by_token_counts(
+    std::string_view text,
+    const std::vector<size_t>& boundaries,
+    size_t first_index
+) const {
+    std::vector<TextChunkView> chunks;
+
+    // Tokens before each boundary. Sentences are tokenized once each;
+    // boundaries sit on whitespace, so per-sentence counts add up.
+    const size_t segments = boundaries.size() - 1;
+    std::vector<size_t> prefix(boundaries.size(), 0);
+    for (size_t k = 0; k < segments; ++k) {
+        prefix[k + 1] = prefix[k] + config_.count_tokens(
+            text.substr(boundaries[k], boundaries[k + 1] - boundaries[k]));
+    }
+
+    const size_t chunk_size = std::max<size_t>(config_.chunk_size, 1);
+    size_t chunk_index = first_index;
+    size_t first = 0;    // Boundary index where the chunk starts
+    size_t last = 0;     // Boundary index where the chunk ends
+    size_t overlap = 0;  // Candidate start of the next chunk
+
+    while (first < segments) {
+        // Take whole sentences while they fit; always at least one
+        last = std::max(last, first + 1);
+        while (last < segments && prefix[last + 1] - prefix[first] <= chunk_size) {
+            ++last;
+        }
+
+        TextChunkView chunk =
+            make_view(text, boundaries[first], boundaries[last], chunk_index++);
+        if (!chunk.text.empty()) {
+            chunks.push_back(chunk);
+        }
+
+        if (last >= segments) {
+            break;
+        }
+
+        // Step back over trailing sentences that fit in the overlap budget
+        overlap = std::max(overlap, first + 1);
+        while (overlap < last && prefix[last] - prefix[overlap] > config_.chunk_overlap) {
+            ++overlap;
+        }
+        first = overlap;
+    }
+
     return chunks;
 }
 
@@ -2,13 +2,16 @@
  * @file rag_chunker.h
  * @brief Document Chunking for RAG
  *
- * Splits documents into overlapping chunks for embedding.
+ * Splits documents into overlapping chunks for embedding. Chunking is a single
+ * pass over the sentence boundaries, so it runs in linear time.
  */
 
 #ifndef RUNANYWHERE_RAG_CHUNKER_H
 #define RUNANYWHERE_RAG_CHUNKER_H
 
+#include <functional>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace runanywhere {
@@ -24,6 +27,25 @@ struct TextChunk {
     size_t chunk_index;
 };
 
+/**
+ * @brief Chunk that refers into the source text instead of owning a copy
+ *
+ * Only valid while the text passed to chunk_document_views() is alive.
+ */
+struct TextChunkView {
+    std::string_view text;  // Trimmed of surrounding whitespace
+    size_t start_position;
+    size_t end_position;
+    size_t chunk_index;
+};
+
+/**
+ * @brief Progress of incremental chunking, carried from one window to the next
+ */
+struct ChunkWindowState {
+    size_t next_chunk_index = 0;  // chunk_index of the first chunk in the next window
+};
+
 /**
  * @brief Chunking configuration
  */
@@ -31,6 +53,10 @@ struct ChunkerConfig {
     size_t chunk_size = 512;      // Approximate tokens per chunk
     size_t chunk_overlap = 50;     // Overlap tokens
     size_t chars_per_token = 4;    // Rough estimate for token counting
+
+    // Optional tokenizer. When set, chunk_size and chunk_overlap are measured
+    // in real tokens and chunks always end on a sentence boundary.
+    std::function<size_t(std::string_view)> count_tokens;
 };
 
 /**
@@ -47,18 +73,54 @@ public:
      */
     std::vector<TextChunk> chunk_document(const std::string& text) const;
 
+    /**
+     * @brief Split document into chunks without copying chunk text
+     */
+    std::vector<TextChunkView> chunk_document_views(std::string_view text) const;
+
+    /**
+     * @brief Chunk one window of a document that is read incrementally
+     *
+     * Returns only the chunks that later text cannot change and sets
+     * consumed to where the next window must start. Feeding successive
+     * windows reproduces chunk_document_views() over the whole text, chunk
+     * indices included, as long as each window holds more than one chunk.
+     * Pass the same state for every window of a document and at_end for the
+     * last one.
+     */
+    std::vector<TextChunkView> chunk_window(
+        std::string_view window,
+        bool at_end,
+        ChunkWindowState& state,
+        size_t& consumed
+    ) const;
+
     /**
      * @brief Estimate token count for text
+     *
+     * Uses the configured tokenizer if any, chars_per_token otherwise.
      */
-    size_t estimate_tokens(const std::string& text) const;
+    size_t estimate_tokens(std::string_view text) const;
 
 private:
     ChunkerConfig config_;
 
-    std::vector<size_t> find_sentence_boundaries(const std::string& text) const;
-    std::vector<TextChunk> split_by_boundaries(
-        const std::string& text,
-        const std::vector<size_t>& boundaries
+    // first_index is the chunk_index of the first chunk; above 0 the text
+    // continues a document whose earlier chunks were already returned.
+    // at_end says whether the text reaches the end of the document.
+    std::vector<TextChunkView> chunk_views(std::string_view text, size_t first_index,
+                                           bool at_end) const;
+    std::vector<size_t> find_sentence_boundaries(std::string_view text) const;
+    std::vector<TextChunkView> split_by_boundaries(
+        std::string_view text,
+        const std::vector<size_t>& boundaries,
+        size_t first_index,
+        bool at_end
+    ) const;
+    std::vector<TextChunkView> split_by_token_counts(
+        std::string_view text,
+        const std::vector<size_t>& boundaries,
+        size_t first_index
     ) const;
 };
 
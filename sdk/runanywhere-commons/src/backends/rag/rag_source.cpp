@@ -0,0 +1,162 @@
+/**
+ * @file rag_source.cpp
+ * @brief Source files for RAG ingestion
+ */
+
+#include "rag_source.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include "rac/core/rac_logger.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define RAG_HAS_MMAP 1
+#endif
+
+#define LOG_TAG "RAG.Source"
+#define LOGW(...) RAC_LOG_WARNING(LOG_TAG, __VA_ARGS__)
+
+namespace runanywhere {
+namespace rag {
+
+// =============================================================================
+// MAPPED FILE
+// =============================================================================
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+#ifdef RAG_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    size_ = static_cast<size_t>(st.st_size);
+    if (size_ == 0) {
+        ::close(fd);
+        return true;  // Empty file: nothing to map
+    }
+
+    void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);  // The mapping keeps the file alive
+    if (data == MAP_FAILED) {
+        size_ = 0;
+        return false;
+    }
+
+    data_ = data;
+    madvise(data_, size_, MADV_SEQUENTIAL);
+    return true;
+#else
+    (void)path;
+    return false;
+#endif
+}
+
+void MappedFile::close() {
+#ifdef RAG_HAS_MMAP
+    if (data_) {
+        munmap(data_, size_);
+    }
+#endif
+    data_ = nullptr;
+    size_ = 0;
+}
+
+void MappedFile::release_prefix(size_t end) {
+#ifdef RAG_HAS_MMAP
+    if (!data_) {
+        return;
+    }
+    const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    end = std::min(end, size_) / page * page;
+    if (end > 0) {
+        // Clean file-backed pages: dropping them only costs a re-read
+        madvise(data_, end, MADV_DONTNEED);
+    }
+#else
+    (void)end;
+#endif
+}
+
+// =============================================================================
+// SOURCE REGISTRY
+// =============================================================================
+
+uint32_t SourceRegistry::add(const std::string& path, uint64_t size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint32_t id = next_id_++;
+    files_[id] = Entry{path, size};
+    return id;
+}
+
+bool SourceRegistry::read(const SourceRef& ref, std::string& out) const {
+    Entry entry;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = files_.find(ref.file_id);
+        if (it == files_.end()) {
+            return false;
+        }
+        entry = it->second;
+    }
+
+    std::ifstream file(entry.path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        LOGW("Source file no longer readable: %s", entry.path.c_str());
+        return false;
+    }
+    if (static_cast<uint64_t>(file.tellg()) != entry.size) {
+        LOGW("Source file changed since ingestion: %s", entry.path.c_str());
+        return false;
+    }
+
+    out.resize(static_cast<size_t>(ref.length));
+    file.seekg(static_cast<std::streamoff>(ref.offset));
+    file.read(out.data(), static_cast<std::streamsize>(ref.length));
+    if (static_cast<uint64_t>(file.gcount()) != ref.length) {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+std::string SourceRegistry::path(uint32_t file_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(file_id);
+    return it != files_.end() ? it->second.path : std::string();
+}
+
+bool SourceRegistry::lookup(uint32_t file_id, std::string& path, uint64_t& size) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = files_.find(file_id);
+    if (it == files_.end()) {
+        return false;
+    }
+    path = it->second.path;
+    size = it->second.size;
+    return true;
+}
+
+void SourceRegistry::clear() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    files_.clear();
+}
+
+} // namespace rag
+} // namespace runanywhere
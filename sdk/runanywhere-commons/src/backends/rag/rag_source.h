@@ -0,0 +1,111 @@
+/**
+ * @file rag_source.h
+ * @brief Source files for RAG ingestion
+ *
+ * Chunks ingested from a file keep a reference (file id plus byte range)
+ * instead of a copy of their text; the text is read back when a chunk is
+ * retrieved.
+ */
+
+#ifndef RUNANYWHERE_RAG_SOURCE_H
+#define RUNANYWHERE_RAG_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace runanywhere {
+namespace rag {
+
+/**
+ * @brief Byte range of a chunk inside a registered source file
+ *
+ * file_id 0 means the chunk text is stored inline.
+ */
+struct SourceRef {
+    uint32_t file_id = 0;
+    uint64_t offset = 0;
+    uint64_t length = 0;
+};
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Map path; false if it cannot be opened or mapped on this platform
+     */
+    bool open(const std::string& path);
+
+    void close();
+
+    std::string_view view() const {
+        return {static_cast<const char*>(data_), size_};
+    }
+
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Drop resident pages of [0, end) once they have been processed
+     */
+    void release_prefix(size_t end);
+
+private:
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief Files that chunks refer to. Thread-safe.
+ */
+class SourceRegistry {
+public:
+    /**
+     * @brief Register path and return its id (never 0)
+     */
+    uint32_t add(const std::string& path, uint64_t size);
+
+    /**
+     * @brief Read the text a reference points to
+     *
+     * @return false if the file is gone or its size changed since ingestion
+     */
+    bool read(const SourceRef& ref, std::string& out) const;
+
+    /**
+     * @brief Path registered for id, or empty if unknown
+     */
+    std::string path(uint32_t file_id) const;
+
+    /**
+     * @brief Path and size registered for id; false if unknown
+     */
+    bool lookup(uint32_t file_id, std::string& path, uint64_t& size) const;
+
+    void clear();
+
+private:
+    struct Entry {
+        std::string path;
+        uint64_t size = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::unordered_map<uint32_t, Entry> files_;
+    uint32_t next_id_ = 1;
+};
+
+} // namespace rag
+} // namespace runanywhere
+
+#endif // RUNANYWHERE_RAG_SOURCE_H
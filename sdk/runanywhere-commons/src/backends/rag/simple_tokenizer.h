@@ -0,0 +1,283 @@
+/**
+ * @file simple_tokenizer.h
+ * @brief Word-level WordPiece tokenizer for BERT-style ONNX models
+ *
+ * Shared by the embedding provider (single sequences padded to a fixed
+ * length) and the reranker (query/passage pairs). Loads a vocab.txt; without
+ * one it falls back to hashing words into the BERT id range. Not thread-safe:
+ * the word cache is mutated on every call.
+ */
+
+#ifndef RUNANYWHERE_RAG_SIMPLE_TOKENIZER_H
+#define RUNANYWHERE_RAG_SIMPLE_TOKENIZER_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "basic_tokenizer.h"
+
+namespace runanywhere {
+namespace rag {
+
+class SimpleTokenizer {
+public:
+    SimpleTokenizer() {
+        // Special tokens (defaults; may be overridden by vocab load)
+        token_to_id_["[CLS]"] = 101;
+        token_to_id_["[SEP]"] = 102;
+        token_to_id_["[PAD]"] = 0;
+        token_to_id_["[UNK]"] = 100;
+        cls_id_ = 101;
+        sep_id_ = 102;
+        pad_id_ = 0;
+        unk_id_ = 100;
+    }
+
+    bool load_vocab(const std::string& vocab_path) {
+        std::ifstream file(vocab_path);
+        if (!file) {
+            return false;
+        }
+
+        token_to_id_.clear();
+
+        std::string line;
+        int64_t id = 0;
+        while (std::getline(file, line)) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            token_to_id_[line] = id++;
+        }
+
+        if (token_to_id_.empty()) {
+            return false;
+        }
+
+        vocab_loaded_ = true;
+
+        // Refresh special token IDs if present in vocab
+        cls_id_ = get_token_id("[CLS]", cls_id_);
+        sep_id_ = get_token_id("[SEP]", sep_id_);
+        pad_id_ = get_token_id("[PAD]", pad_id_);
+        unk_id_ = get_token_id("[UNK]", unk_id_);
+
+        return true;
+    }
+    
+    std::vector<int64_t> encode(const std::string& text, size_t max_length = 512) {
+        std::vector<int64_t> token_ids;
+        token_ids.reserve(max_length);
+        token_ids.push_back(cls_id_); // [CLS]
+
+        const auto words = basic_tokenize(text);
+        for (const auto& word : words) {
+            if (token_ids.size() >= max_length - 1) {
+                break;
+            }
+
+            const auto ids = word_to_token_ids(word);
+            for (const auto id : ids) {
+                if (token_ids.size() >= max_length - 1) {
+                    break;
+                }
+                token_ids.push_back(id);
+            }
+        }
+
+        token_ids.push_back(sep_id_); // [SEP]
+        
+        // Pad to max_length
+        while (token_ids.size() < max_length) {
+            token_ids.push_back(pad_id_); // [PAD]
+        }
+        
+        return token_ids;
+    }
+    
+    // Number of word pieces in text, without [CLS]/[SEP] or truncation
+    size_t count_tokens(const std::string& text) {
+        size_t count = 0;
+        for (const auto& word : basic_tokenize(text)) {
+            count += word_to_token_ids(word).size();
+        }
+        return count;
+    }
+
+    /**
+     * @brief Encode a (query, passage) pair for a cross-encoder
+     *
+     * Produces [CLS] query [SEP] passage [SEP] without padding. The query
+     * keeps at most half of max_length and the passage is truncated to fit
+     * the rest. type_ids is 1 for the passage segment and 0 otherwise.
+     */
+    void encode_pair(const std::string& query, const std::string& passage, size_t max_length,
+                     std::vector<int64_t>& ids, std::vector<int64_t>& type_ids) {
+        max_length = std::max<size_t>(max_length, 4);
+        ids.clear();
+        ids.push_back(cls_id_);
+        append_word_pieces(query, max_length / 2, ids);
+        ids.push_back(sep_id_);
+        const size_t passage_start = ids.size();
+        append_word_pieces(passage, max_length - 1, ids);
+        ids.push_back(sep_id_);
+
+        type_ids.assign(ids.size(), 0);
+        std::fill(type_ids.begin() + static_cast<std::ptrdiff_t>(passage_start), type_ids.end(), 1);
+    }
+
+    int64_t pad_id() const { return pad_id_; }
+
+    bool has_vocab() const { return vocab_loaded_; }
+
+    std::vector<int64_t> create_attention_mask(const std::vector<int64_t>& token_ids) {
+        std::vector<int64_t> mask;
+        for (auto id : token_ids) {
+            mask.push_back(id != 0 ? 1 : 0); // 1 for real tokens, 0 for padding
+        }
+        return mask;
+    }
+    
+    std::vector<int64_t> create_token_type_ids(size_t length) {
+        // Token type IDs: all 0s for single sequence models like all-MiniLM
+        return std::vector<int64_t>(length, 0);
+    }
+
+private:
+    // Append word piece ids of text while ids holds fewer than limit entries
+    void append_word_pieces(const std::string& text, size_t limit, std::vector<int64_t>& ids) {
+        for (const auto& word : basic_tokenize(text)) {
+            for (const auto id : word_to_token_ids(word)) {
+                if (ids.size() >= limit) {
+                    return;
+                }
+                ids.push_back(id);
+            }
+        }
+    }
+
+    std::vector<std::string> wordpiece_tokenize(const std::string& word) const {
+        if (!vocab_loaded_) {
+            return {word};
+        }
+
+        if (token_to_id_.find(word) != token_to_id_.end()) {
+            return {word};
+        }
+
+        std::vector<std::string> pieces;
+        size_t start = 0;
+        while (start < word.size()) {
+            size_t end = word.size();
+            std::string current_piece;
+            bool found = false;
+
+            while (start < end) {
+                std::string substr = word.substr(start, end - start);
+                if (start > 0) {
+                    substr.insert(0, "##");
+                }
+
+                if (token_to_id_.find(substr) != token_to_id_.end()) {
+                    current_piece = std::move(substr);
+                    found = true;
+                    break;
+                }
+                end--;
+            }
+
+            if (!found) {
+                return {"[UNK]"};
+            }
+
+            pieces.push_back(std::move(current_piece));
+            start = end;
+        }
+
+        return pieces;
+    }
+
+    std::vector<int64_t> word_to_token_ids(const std::string& word) {
+        auto it = token_cache_.find(word);
+        if (it != token_cache_.end()) {
+            touch_cache_entry(it->second.lru_it);
+            return it->second.ids;
+        }
+
+        const auto pieces = wordpiece_tokenize(word);
+        std::vector<int64_t> ids;
+        ids.reserve(pieces.size());
+        for (const auto& piece : pieces) {
+            ids.push_back(token_id_for(piece));
+        }
+
+        insert_cache_entry(word, ids);
+        return ids;
+    }
+
+    int64_t token_id_for(const std::string& token) const {
+        auto it = token_to_id_.find(token);
+        if (it != token_to_id_.end()) {
+            return it->second;
+        }
+
+        if (vocab_loaded_) {
+            return unk_id_;
+        }
+
+        // Hash-based fallback when vocab is unavailable
+        size_t hash = std::hash<std::string>{}(token);
+        constexpr int64_t kVocabSize = 30522;
+        constexpr int64_t kMinId = 1000;
+        constexpr int64_t kMaxId = kVocabSize - 1;
+        const int64_t range = kMaxId - kMinId + 1;
+        return static_cast<int64_t>(hash % static_cast<size_t>(range)) + kMinId;
+    }
+
+    int64_t get_token_id(const std::string& token, int64_t fallback) const {
+        auto it = token_to_id_.find(token);
+        return it != token_to_id_.end() ? it->second : fallback;
+    }
+
+    struct CacheEntry {
+        std::vector<int64_t> ids;
+        std::list<std::string>::iterator lru_it;
+    };
+
+    void touch_cache_entry(std::list<std::string>::iterator it) {
+        lru_list_.splice(lru_list_.begin(), lru_list_, it);
+    }
+
+    void insert_cache_entry(const std::string& word, const std::vector<int64_t>& ids) {
+        if (token_cache_.size() >= token_cache_limit_ && !lru_list_.empty()) {
+            const std::string& lru_key = lru_list_.back();
+            token_cache_.erase(lru_key);
+            lru_list_.pop_back();
+        }
+
+        lru_list_.push_front(word);
+        token_cache_.emplace(word, CacheEntry{ids, lru_list_.begin()});
+    }
+
+    std::unordered_map<std::string, int64_t> token_to_id_;
+    int64_t cls_id_ = 101;
+    int64_t sep_id_ = 102;
+    int64_t pad_id_ = 0;
+    int64_t unk_id_ = 100;
+    bool vocab_loaded_ = false;
+    std::unordered_map<std::string, CacheEntry> token_cache_;
+    std::list<std::string> lru_list_;
+    std::size_t token_cache_limit_ = 4096;
+};
+
+} // namespace rag
+} // namespace runanywhere
+
+#endif // RUNANYWHERE_RAG_SIMPLE_TOKENIZER_H
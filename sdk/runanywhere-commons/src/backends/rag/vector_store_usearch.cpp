@@ -198,6 +198,7 @@ public:
             result.similarity = similarity;
             result.score = similarity;  // Alias
             result.metadata = it->second.metadata;
+            result.source = it->second.source;
             results.push_back(std::move(result));
         }
 
@@ -256,9 +257,25 @@ public:
         return stats;
     }
 
-    bool save(const std::string& path) {
+    bool save(const std::string& path, const SourceRegistry* sources) {
         std::lock_guard<std::mutex> lock(mutex_);
-        
+
+        // Files that chunks refer to; ids are reissued on load
+        nlohmann::json files = nlohmann::json::object();
+        for (const auto& [key, chunk] : chunks_) {
+            const uint32_t file_id = chunk.source.file_id;
+            if (file_id == 0 || files.contains(std::to_string(file_id))) {
+                continue;
+            }
+            std::string file_path;
+            uint64_t file_size = 0;
+            if (!sources || !sources->lookup(file_id, file_path, file_size)) {
+                LOGE("Chunk %s refers to unknown source file %u", chunk.id.c_str(), file_id);
+                return false;
+            }
+            files[std::to_string(file_id)] = {{"path", file_path}, {"size", file_size}};
+        }
+
         // Save USearch index
         auto save_result = index_.save(path.c_str());
         if (!save_result) {
@@ -269,6 +286,7 @@ public:
         // Save metadata to JSON file
         nlohmann::json metadata;
         metadata["next_key"] = next_key_;
+        metadata["sources"] = std::move(files);
         metadata["chunks"] = nlohmann::json::array();
         
         for (const auto& [key, chunk] : chunks_) {
@@ -278,6 +296,13 @@ public:
             chunk_json["text"] = chunk.text;
             chunk_json["embedding"] = chunk.embedding;
             chunk_json["metadata"] = chunk.metadata;
+            if (chunk.source.file_id != 0) {
+                chunk_json["source"] = {
+                    {"file_id", chunk.source.file_id},
+                    {"offset", chunk.source.offset},
+                    {"length", chunk.source.length}
+                };
+            }
             metadata["chunks"].push_back(chunk_json);
         }
         
@@ -294,7 +319,7 @@ public:
         return true;
     }
 
-    bool load(const std::string& path) {
+    bool load(const std::string& path, SourceRegistry* sources) {
         std::lock_guard<std::mutex> lock(mutex_);
         
         // Load USearch index
@@ -318,6 +343,7 @@ public:
 
             const auto& chunks_json = metadata.at("chunks");
             const std::size_t parsed_next_key = metadata.at("next_key").get<std::size_t>();
+            const nlohmann::json files = metadata.value("sources", nlohmann::json::object());
 
             decltype(chunks_) new_chunks;
             decltype(id_to_key_) new_id_to_key;
@@ -330,11 +356,41 @@ public:
                 chunk.text = chunk_json.at("text").get<std::string>();
                 chunk.embedding = chunk_json.at("embedding").get<std::vector<float>>();
                 chunk.metadata = chunk_json.at("metadata");
+                if (chunk_json.contains("source")) {
+                    const auto& source = chunk_json.at("source");
+                    chunk.source.file_id = source.at("file_id").get<uint32_t>();
+                    chunk.source.offset = source.at("offset").get<uint64_t>();
+                    chunk.source.length = source.at("length").get<uint64_t>();
+                    if (!files.contains(std::to_string(chunk.source.file_id))) {
+                        LOGE("Chunk %s refers to unsaved source file %u", chunk.id.c_str(),
+                             chunk.source.file_id);
+                        return false;
+                    }
+                }
 
                 new_chunks[key] = std::move(chunk);
                 new_id_to_key[new_chunks[key].id] = key;
             }
 
+            // Register the saved files under ids from this process
+            if (!files.empty()) {
+                if (!sources) {
+                    LOGE("Index refers to source files but no source registry was given");
+                    return false;
+                }
+                std::unordered_map<uint32_t, uint32_t> remap;
+                for (const auto& [saved_id, file] : files.items()) {
+                    remap[static_cast<uint32_t>(std::stoul(saved_id))] =
+                        sources->add(file.at("path").get<std::string>(),
+                                     file.at("size").get<uint64_t>());
+                }
+                for (auto& [key, chunk] : new_chunks) {
+                    if (chunk.source.file_id != 0) {
+                        chunk.source.file_id = remap.at(chunk.source.file_id);
+                    }
+                }
+            }
+
             next_key_ = parsed_next_key;
             chunks_ = std::move(new_chunks);
             id_to_key_ = std::move(new_id_to_key);
@@ -411,12 +467,12 @@ nlohmann::json VectorStoreUSearch::get_statistics() const {
     return impl_->get_statistics();
 }
 
-bool VectorStoreUSearch::save(const std::string& path) const {
-    return impl_->save(path);
+bool VectorStoreUSearch::save(const std::string& path, const SourceRegistry* sources) const {
+    return impl_->save(path, sources);
 }
 
-bool VectorStoreUSearch::load(const std::string& path) {
-    return impl_->load(path);
+bool VectorStoreUSearch::load(const std::string& path, SourceRegistry* sources) {
+    return impl_->load(path, sources);
 }
 
 } // namespace rag
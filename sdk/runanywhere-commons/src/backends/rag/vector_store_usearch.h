@@ -16,6 +16,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include "rag_source.h"
+
 namespace runanywhere {
 namespace rag {
 
@@ -24,9 +26,10 @@ namespace rag {
  */
 struct DocumentChunk {
     std::string id;
-    std::string text;
+    std::string text;         // Empty when the text lives in a source file
     std::vector<float> embedding;
     nlohmann::json metadata;
+    SourceRef source;         // Where text is read from when file_id != 0
 };
 
 /**
@@ -39,6 +42,7 @@ struct SearchResult {
     float score;              // Similarity score (alias for similarity)
     float similarity;         // Similarity score (0.0-1.0)
     nlohmann::json metadata;  // Additional metadata
+    SourceRef source;         // Source file range; text is filled in by RAGBackend
 };
 
 /**
@@ -115,13 +119,21 @@ public:
 
     /**
      * @brief Save index to file
+     *
+     * File ids are only meaningful to the registry that issued them, so the
+     * path and size of every file that chunks refer to are saved as well.
+     * Fails if a chunk refers to a file that sources does not know.
      */
-    bool save(const std::string& path) const;
+    bool save(const std::string& path, const SourceRegistry* sources = nullptr) const;
 
     /**
      * @brief Load index from file
+     *
+     * Files saved with the index are registered in sources and chunk
+     * references are remapped to the new ids. Fails if the index refers to
+     * files and sources is null.
      */
-    bool load(const std::string& path);
+    bool load(const std::string& path, SourceRegistry* sources = nullptr);
 
 private:
     class Impl;
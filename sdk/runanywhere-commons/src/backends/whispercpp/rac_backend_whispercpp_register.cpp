@@ -11,6 +11,7 @@
 #include <cstring>
 #include <vector>
 
+#include "rac/core/rac_audio_utils.h"
 #include "rac/core/rac_core.h"
 #include "rac/core/rac_error.h"
 #include "rac/core/rac_logger.h"
@@ -24,21 +25,6 @@ namespace {
 
 const char* LOG_CAT = "WhisperCPP";
 
-/**
- * Convert Int16 PCM audio to Float32 normalized to [-1.0, 1.0].
- */
-static std::vector<float> convert_int16_to_float32(const void* int16_data, size_t byte_count) {
-    const int16_t* samples = static_cast<const int16_t*>(int16_data);
-    size_t num_samples = byte_count / sizeof(int16_t);
-
-    std::vector<float> float_samples(num_samples);
-    for (size_t i = 0; i < num_samples; ++i) {
-        float_samples[i] = static_cast<float>(samples[i]) / 32768.0f;
-    }
-
-    return float_samples;
-}
-
 // Initialize
 static rac_result_t whispercpp_stt_vtable_initialize(void* impl, const char* model_path) {
     (void)impl;
@@ -51,8 +37,33 @@ static rac_result_t whispercpp_stt_vtable_transcribe(void* impl, const void* aud
                                                      size_t audio_size,
                                                      const rac_stt_options_t* options,
                                                      rac_stt_result_t* out_result) {
-    std::vector<float> float_samples = convert_int16_to_float32(audio_data, audio_size);
-    return rac_stt_whispercpp_transcribe(impl, float_samples.data(), float_samples.size(), options,
+    rac::MonoFloatAudio samples(static_cast<const int16_t*>(audio_data),
+                                audio_size / sizeof(int16_t));
+    if (!samples.ok()) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    return rac_stt_whispercpp_transcribe(impl, samples.data(), samples.size(), options,
+                                         out_result);
+}
+
+// Transcribe a typed audio view; mono Float32 input is passed through without a copy
+static rac_result_t whispercpp_stt_vtable_transcribe_audio(void* impl,
+                                                           const rac_audio_view_t* audio,
+                                                           const rac_stt_options_t* options,
+                                                           rac_stt_result_t* out_result) {
+    if (!audio || !audio->data || !out_result) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    rac::MonoFloatAudio samples(*audio);
+    if (!samples.ok()) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    rac_stt_options_t view_options = options ? *options : RAC_STT_OPTIONS_DEFAULT;
+    if (audio->sample_rate > 0) {
+        view_options.sample_rate = audio->sample_rate;
+    }
+    return rac_stt_whispercpp_transcribe(impl, samples.data(), samples.size(), &view_options,
                                          out_result);
 }
 
@@ -64,10 +75,13 @@ static rac_result_t whispercpp_stt_vtable_transcribe_stream(void* impl, const vo
                                                             void* user_data) {
     // Fall back to batch transcription
     rac_stt_result_t result = {};
-    std::vector<float> float_samples = convert_int16_to_float32(audio_data, audio_size);
+    rac::MonoFloatAudio samples(static_cast<const int16_t*>(audio_data),
+                                audio_size / sizeof(int16_t));
+    if (!samples.ok()) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
     rac_result_t status =
-        rac_stt_whispercpp_transcribe(impl, float_samples.data(), float_samples.size(), options,
-                                      &result);
+        rac_stt_whispercpp_transcribe(impl, samples.data(), samples.size(), options, &result);
     if (status == RAC_SUCCESS && callback && result.text) {
         callback(result.text, RAC_TRUE, user_data);
     }
@@ -106,6 +120,7 @@ static const rac_stt_service_ops_t g_whispercpp_stt_ops = {
     .get_info = whispercpp_stt_vtable_get_info,
     .cleanup = whispercpp_stt_vtable_cleanup,
     .destroy = whispercpp_stt_vtable_destroy,
+    .transcribe_audio = whispercpp_stt_vtable_transcribe_audio,
 };
 
 // =============================================================================
@@ -106,7 +106,8 @@ rac_result_t rac_stt_whispercpp_transcribe(rac_handle_t handle, const float* aud
 
     // Prepare request
     runanywhere::STTRequest request;
-    request.audio_samples.assign(audio_samples, audio_samples + num_samples);
+    request.audio_samples = audio_samples;
+    request.num_samples = num_samples;
     request.sample_rate = (options && options->sample_rate > 0) ? options->sample_rate : 16000;
 
     if (options && options->language) {
@@ -220,17 +220,22 @@ STTResult WhisperCppSTT::transcribe(const STTRequest& request) {
 
     cancel_requested_.store(false);
 
-    std::vector<float> audio = request.audio_samples;
+    const bool detect_language = request.detect_language || request.language.empty();
+
+    // Only resampling needs a new buffer; 16 kHz input is decoded in place
     if (request.sample_rate != WHISPER_SAMPLE_RATE) {
-        audio = resample_to_16khz(request.audio_samples, request.sample_rate);
+        std::vector<float> audio =
+            resample_to_16khz(request.audio_samples, request.num_samples, request.sample_rate);
+        return transcribe_internal(audio.data(), audio.size(), request.language, detect_language,
+                                   request.translate_to_english, request.word_timestamps);
     }
 
-    return transcribe_internal(audio, request.language,
-                               request.detect_language || request.language.empty(),
-                               request.translate_to_english, request.word_timestamps);
+    return transcribe_internal(request.audio_samples, request.num_samples, request.language,
+                               detect_language, request.translate_to_english,
+                               request.word_timestamps);
 }
 
-STTResult WhisperCppSTT::transcribe_internal(const std::vector<float>& audio,
+STTResult WhisperCppSTT::transcribe_internal(const float* audio, size_t num_samples,
                                              const std::string& language, bool detect_language,
                                              bool translate, bool word_timestamps) {
     STTResult result;
@@ -262,7 +267,7 @@ STTResult WhisperCppSTT::transcribe_internal(const std::vector<float>& audio,
     };
     wparams.abort_callback_user_data = &cancel_requested_;
 
-    int ret = whisper_full(ctx_, wparams, audio.data(), static_cast<int>(audio.size()));
+    int ret = whisper_full(ctx_, wparams, audio, static_cast<int>(num_samples));
 
     if (ret != 0) {
         LOGE("whisper_full failed with code: %d", ret);
@@ -316,7 +321,7 @@ STTResult WhisperCppSTT::transcribe_internal(const std::vector<float>& audio,
     }
 
     result.text = full_text;
-    result.audio_duration_ms = (audio.size() / static_cast<double>(WHISPER_SAMPLE_RATE)) * 1000.0;
+    result.audio_duration_ms = (num_samples / static_cast<double>(WHISPER_SAMPLE_RATE)) * 1000.0;
     result.inference_time_ms = static_cast<double>(duration.count());
 
     int lang_id = whisper_full_lang_id(ctx_);
@@ -393,13 +398,14 @@ bool WhisperCppSTT::feed_audio(const std::string& stream_id, const std::vector<f
 
     auto& state = it->second;
 
-    std::vector<float> resampled = samples;
     if (sample_rate != WHISPER_SAMPLE_RATE) {
-        resampled = resample_to_16khz(samples, sample_rate);
+        const std::vector<float> resampled =
+            resample_to_16khz(samples.data(), samples.size(), sample_rate);
+        state->audio_buffer.insert(state->audio_buffer.end(), resampled.begin(), resampled.end());
+    } else {
+        state->audio_buffer.insert(state->audio_buffer.end(), samples.begin(), samples.end());
     }
 
-    state->audio_buffer.insert(state->audio_buffer.end(), resampled.begin(), resampled.end());
-
     return true;
 }
 
@@ -551,15 +557,15 @@ std::vector<std::string> WhisperCppSTT::get_supported_languages() const {
     return languages;
 }
 
-std::vector<float> WhisperCppSTT::resample_to_16khz(const std::vector<float>& samples,
+std::vector<float> WhisperCppSTT::resample_to_16khz(const float* samples, size_t num_samples,
                                                     int source_rate) {
-    if (source_rate == WHISPER_SAMPLE_RATE || samples.empty()) {
-        return samples;
+    if (source_rate == WHISPER_SAMPLE_RATE || num_samples == 0) {
+        return std::vector<float>(samples, samples + num_samples);
     }
 
     const double step = static_cast<double>(source_rate) / WHISPER_SAMPLE_RATE;
     
-    size_t output_size = static_cast<size_t>(samples.size() / step);
+    size_t output_size = static_cast<size_t>(num_samples / step);
     if (output_size == 0) {
         output_size = 1;
     }
@@ -568,7 +574,7 @@ std::vector<float> WhisperCppSTT::resample_to_16khz(const std::vector<float>& sa
     
     if (source_rate % WHISPER_SAMPLE_RATE == 0) {
         const int stride = source_rate / WHISPER_SAMPLE_RATE;
-        const size_t out_len = std::max<size_t>(1, samples.size() / stride);
+        const size_t out_len = std::max<size_t>(1, num_samples / stride);
         
         output.resize(out_len);
         for (size_t i = 0; i < out_len; ++i) {
@@ -579,8 +585,8 @@ std::vector<float> WhisperCppSTT::resample_to_16khz(const std::vector<float>& sa
         
     output.resize(output_size);
 
-    const float* __restrict src_ptr = samples.data();
-    const size_t src_size = samples.size();
+    const float* __restrict src_ptr = samples;
+    const size_t src_size = num_samples;
 
     const size_t safe_output_limit = (output_size > 0) ? output_size - 1 : 0;
 
@@ -614,7 +620,7 @@ std::vector<float> WhisperCppSTT::resample_to_16khz(const std::vector<float>& sa
     }
 
     LOGI("Resampled audio from %d Hz to %d Hz (%zu -> %zu samples)", source_rate,
-         WHISPER_SAMPLE_RATE, samples.size(), output_size);
+         WHISPER_SAMPLE_RATE, num_samples, output_size);
 
     return output;
 }
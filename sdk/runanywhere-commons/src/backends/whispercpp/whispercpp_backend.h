@@ -61,7 +61,8 @@ struct AudioSegment {
 };
 
 struct STTRequest {
-    std::vector<float> audio_samples;
+    const float* audio_samples = nullptr;  // Borrowed for the duration of transcribe()
+    size_t num_samples = 0;
     int sample_rate = 16000;
     std::string language;
     bool detect_language = false;
@@ -162,9 +163,11 @@ class WhisperCppSTT {
     std::vector<std::string> get_supported_languages() const;
 
    private:
-    STTResult transcribe_internal(const std::vector<float>& audio, const std::string& language,
-                                  bool detect_language, bool translate, bool word_timestamps);
-    std::vector<float> resample_to_16khz(const std::vector<float>& samples, int source_rate);
+    STTResult transcribe_internal(const float* audio, size_t num_samples,
+                                  const std::string& language, bool detect_language,
+                                  bool translate, bool word_timestamps);
+    std::vector<float> resample_to_16khz(const float* samples, size_t num_samples,
+                                         int source_rate);
     std::string generate_stream_id();
 
     WhisperCppBackend* backend_;
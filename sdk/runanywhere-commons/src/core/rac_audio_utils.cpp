@@ -11,6 +11,15 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RAC_AUDIO_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RAC_AUDIO_NEON 1
+#endif
 
 #include "rac/core/rac_error.h"
 #include "rac/core/rac_logger.h"
@@ -139,16 +148,10 @@ rac_result_t rac_audio_float32_to_wav(const void* pcm_data, size_t pcm_size, int
     // Build WAV header
     build_wav_header(wav_data, sample_rate, int16_data_size);
 
-    // Convert Float32 to Int16
-    const float* float_samples = static_cast<const float*>(pcm_data);
-    int16_t* int16_samples = reinterpret_cast<int16_t*>(wav_data + WAV_HEADER_SIZE);
-
-    for (size_t i = 0; i < num_samples; ++i) {
-        // Clamp to [-1.0, 1.0] range
-        float sample = std::max(-1.0f, std::min(1.0f, float_samples[i]));
-        // Scale to Int16 range [-32768, 32767]
-        int16_samples[i] = static_cast<int16_t>(sample * 32767.0f);
-    }
+    // Convert Float32 to Int16 directly into the WAV payload
+    rac_audio_float32_to_int16(static_cast<const float*>(pcm_data),
+                               reinterpret_cast<int16_t*>(wav_data + WAV_HEADER_SIZE),
+                               num_samples);
 
     *out_wav_data = wav_data;
     *out_wav_size = wav_size;
@@ -198,3 +201,291 @@ rac_result_t rac_audio_int16_to_wav(const void* pcm_data, size_t pcm_size, int32
 size_t rac_audio_wav_header_size(void) {
     return WAV_HEADER_SIZE;
 }
+
+// =============================================================================
+// PCM KERNELS
+// =============================================================================
+
+static constexpr float INT16_TO_FLOAT_SCALE = 1.0f / 32768.0f;
+static constexpr float FLOAT_TO_INT16_SCALE = 32767.0f;
+
+void rac_audio_int16_to_float32(const int16_t* in, float* out, size_t num_samples) {
+    if (!in || !out) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(RAC_AUDIO_SSE2)
+    const __m128 scale = _mm_set1_ps(INT16_TO_FLOAT_SCALE);
+    for (; i + 8 <= num_samples; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+        // Sign-extend 8 x int16 to two 4 x int32 lanes
+        __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+        __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+        _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+        _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+#elif defined(RAC_AUDIO_NEON)
+    const float32x4_t scale = vdupq_n_f32(INT16_TO_FLOAT_SCALE);
+    for (; i + 8 <= num_samples; i += 8) {
+        int16x8_t v = vld1q_s16(in + i);
+        float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+        float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+        vst1q_f32(out + i, vmulq_f32(lo, scale));
+        vst1q_f32(out + i + 4, vmulq_f32(hi, scale));
+    }
+#endif
+    for (; i < num_samples; ++i) {
+        out[i] = static_cast<float>(in[i]) * INT16_TO_FLOAT_SCALE;
+    }
+}
+
+void rac_audio_float32_to_int16(const float* in, int16_t* out, size_t num_samples) {
+    if (!in || !out) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(RAC_AUDIO_SSE2)
+    const __m128 scale = _mm_set1_ps(FLOAT_TO_INT16_SCALE);
+    const __m128 lo_clamp = _mm_set1_ps(-1.0f);
+    const __m128 hi_clamp = _mm_set1_ps(1.0f);
+    for (; i + 8 <= num_samples; i += 8) {
+        __m128 a = _mm_loadu_ps(in + i);
+        __m128 b = _mm_loadu_ps(in + i + 4);
+        a = _mm_mul_ps(_mm_min_ps(_mm_max_ps(a, lo_clamp), hi_clamp), scale);
+        b = _mm_mul_ps(_mm_min_ps(_mm_max_ps(b, lo_clamp), hi_clamp), scale);
+        // Truncate toward zero to match the scalar static_cast
+        __m128i packed = _mm_packs_epi32(_mm_cvttps_epi32(a), _mm_cvttps_epi32(b));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+#elif defined(RAC_AUDIO_NEON)
+    const float32x4_t scale = vdupq_n_f32(FLOAT_TO_INT16_SCALE);
+    const float32x4_t lo_clamp = vdupq_n_f32(-1.0f);
+    const float32x4_t hi_clamp = vdupq_n_f32(1.0f);
+    for (; i + 8 <= num_samples; i += 8) {
+        float32x4_t a = vld1q_f32(in + i);
+        float32x4_t b = vld1q_f32(in + i + 4);
+        a = vmulq_f32(vminq_f32(vmaxq_f32(a, lo_clamp), hi_clamp), scale);
+        b = vmulq_f32(vminq_f32(vmaxq_f32(b, lo_clamp), hi_clamp), scale);
+        int16x8_t packed =
+            vcombine_s16(vqmovn_s32(vcvtq_s32_f32(a)), vqmovn_s32(vcvtq_s32_f32(b)));
+        vst1q_s16(out + i, packed);
+    }
+#endif
+    for (; i < num_samples; ++i) {
+        float sample = std::max(-1.0f, std::min(1.0f, in[i]));
+        out[i] = static_cast<int16_t>(sample * FLOAT_TO_INT16_SCALE);
+    }
+}
+
+void rac_audio_downmix_float32(const float* in, size_t num_frames, int32_t channels, float* out) {
+    if (!in || !out || channels < 1) {
+        return;
+    }
+
+    if (channels == 1) {
+        if (in != out) {
+            memcpy(out, in, num_frames * sizeof(float));
+        }
+        return;
+    }
+
+    size_t i = 0;
+    if (channels == 2) {
+#if defined(RAC_AUDIO_SSE2)
+        const __m128 half = _mm_set1_ps(0.5f);
+        for (; i + 4 <= num_frames; i += 4) {
+            __m128 a = _mm_loadu_ps(in + 2 * i);      // L0 R0 L1 R1
+            __m128 b = _mm_loadu_ps(in + 2 * i + 4);  // L2 R2 L3 R3
+            __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+            __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+            _mm_storeu_ps(out + i, _mm_mul_ps(_mm_add_ps(left, right), half));
+        }
+#elif defined(RAC_AUDIO_NEON)
+        for (; i + 4 <= num_frames; i += 4) {
+            float32x4x2_t lr = vld2q_f32(in + 2 * i);
+            vst1q_f32(out + i, vmulq_n_f32(vaddq_f32(lr.val[0], lr.val[1]), 0.5f));
+        }
+#endif
+        for (; i < num_frames; ++i) {
+            out[i] = (in[2 * i] + in[2 * i + 1]) * 0.5f;
+        }
+        return;
+    }
+
+    const float inv_channels = 1.0f / static_cast<float>(channels);
+    for (; i < num_frames; ++i) {
+        const float* frame = in + i * static_cast<size_t>(channels);
+        float sum = 0.0f;
+        for (int32_t c = 0; c < channels; ++c) {
+            sum += frame[c];
+        }
+        out[i] = sum * inv_channels;
+    }
+}
+
+void rac_audio_apply_gain(float* samples, size_t num_samples, float gain) {
+    if (!samples || gain == 1.0f) {
+        return;
+    }
+
+    size_t i = 0;
+#if defined(RAC_AUDIO_SSE2)
+    const __m128 g = _mm_set1_ps(gain);
+    for (; i + 4 <= num_samples; i += 4) {
+        _mm_storeu_ps(samples + i, _mm_mul_ps(_mm_loadu_ps(samples + i), g));
+    }
+#elif defined(RAC_AUDIO_NEON)
+    for (; i + 4 <= num_samples; i += 4) {
+        vst1q_f32(samples + i, vmulq_n_f32(vld1q_f32(samples + i), gain));
+    }
+#endif
+    for (; i < num_samples; ++i) {
+        samples[i] *= gain;
+    }
+}
+
+rac_result_t rac_audio_view_to_float32_mono(const rac_audio_view_t* view, float* out) {
+    if (!view || !out || (!view->data && view->num_frames > 0) || view->channels < 1) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const size_t channels = static_cast<size_t>(view->channels);
+
+    switch (view->format) {
+        case RAC_AUDIO_SAMPLE_FLOAT32:
+            rac_audio_downmix_float32(static_cast<const float*>(view->data), view->num_frames,
+                                      view->channels, out);
+            return RAC_SUCCESS;
+
+        case RAC_AUDIO_SAMPLE_INT16: {
+            const int16_t* in = static_cast<const int16_t*>(view->data);
+            if (channels == 1) {
+                rac_audio_int16_to_float32(in, out, view->num_frames);
+                return RAC_SUCCESS;
+            }
+            // Convert in bounded blocks through pooled scratch, then downmix
+            static constexpr size_t BLOCK_FRAMES = 1024;
+            float* block = rac_audio_scratch_acquire(BLOCK_FRAMES * channels);
+            if (!block) {
+                return RAC_ERROR_OUT_OF_MEMORY;
+            }
+            for (size_t f = 0; f < view->num_frames; f += BLOCK_FRAMES) {
+                size_t n = std::min(BLOCK_FRAMES, view->num_frames - f);
+                rac_audio_int16_to_float32(in + f * channels, block, n * channels);
+                rac_audio_downmix_float32(block, n, view->channels, out + f);
+            }
+            rac_audio_scratch_release(block);
+            return RAC_SUCCESS;
+        }
+    }
+
+    return RAC_ERROR_INVALID_ARGUMENT;
+}
+
+// =============================================================================
+// SCRATCH BUFFER POOL
+// =============================================================================
+
+namespace {
+
+constexpr size_t SCRATCH_ALIGNMENT = 64;
+constexpr size_t SCRATCH_POOL_MAX_BUFFERS = 8;
+
+/** Header stored immediately before each aligned scratch buffer. */
+struct ScratchHeader {
+    void* base;
+    size_t capacity;
+};
+
+constexpr size_t SCRATCH_HEADER_SPACE =
+    (sizeof(ScratchHeader) + SCRATCH_ALIGNMENT - 1) / SCRATCH_ALIGNMENT * SCRATCH_ALIGNMENT;
+
+ScratchHeader* scratch_header(float* buffer) {
+    return reinterpret_cast<ScratchHeader*>(reinterpret_cast<uint8_t*>(buffer) -
+                                            sizeof(ScratchHeader));
+}
+
+float* scratch_allocate(size_t capacity) {
+    void* base = malloc(capacity * sizeof(float) + SCRATCH_HEADER_SPACE + SCRATCH_ALIGNMENT);
+    if (!base) {
+        return nullptr;
+    }
+    uintptr_t aligned = (reinterpret_cast<uintptr_t>(base) + SCRATCH_HEADER_SPACE +
+                         SCRATCH_ALIGNMENT - 1) &
+                        ~(static_cast<uintptr_t>(SCRATCH_ALIGNMENT) - 1);
+    float* buffer = reinterpret_cast<float*>(aligned);
+    *scratch_header(buffer) = ScratchHeader{base, capacity};
+    return buffer;
+}
+
+void scratch_free(float* buffer) {
+    free(scratch_header(buffer)->base);
+}
+
+/** Per-thread free list; audio threads reuse their own buffers without locking. */
+struct ScratchPool {
+    std::vector<float*> free_buffers;
+
+    ~ScratchPool() {
+        for (float* buffer : free_buffers) {
+            scratch_free(buffer);
+        }
+    }
+};
+
+ScratchPool& scratch_pool() {
+    thread_local ScratchPool pool;
+    return pool;
+}
+
+}  // namespace
+
+float* rac_audio_scratch_acquire(size_t num_samples) {
+    if (num_samples == 0) {
+        num_samples = 1;
+    }
+
+    auto& buffers = scratch_pool().free_buffers;
+
+    // Best fit: smallest pooled buffer that is large enough
+    size_t best = buffers.size();
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        size_t capacity = scratch_header(buffers[i])->capacity;
+        if (capacity >= num_samples &&
+            (best == buffers.size() || capacity < scratch_header(buffers[best])->capacity)) {
+            best = i;
+        }
+    }
+
+    if (best != buffers.size()) {
+        float* buffer = buffers[best];
+        buffers[best] = buffers.back();
+        buffers.pop_back();
+        return buffer;
+    }
+
+    return scratch_allocate(num_samples);
+}
+
+void rac_audio_scratch_release(float* buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    auto& buffers = scratch_pool().free_buffers;
+    if (buffers.size() < SCRATCH_POOL_MAX_BUFFERS) {
+        buffers.push_back(buffer);
+        return;
+    }
+
+    // Pool full: evict the smallest buffer so large frames stay cached
+    auto smallest = std::min_element(buffers.begin(), buffers.end(), [](float* a, float* b) {
+        return scratch_header(a)->capacity < scratch_header(b)->capacity;
+    });
+    if (scratch_header(*smallest)->capacity < scratch_header(buffer)->capacity) {
+        std::swap(*smallest, buffer);
+    }
+    scratch_free(buffer);
+}
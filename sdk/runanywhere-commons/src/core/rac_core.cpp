@@ -8,6 +8,8 @@
 #include "rac/core/rac_core.h"
 
 #include <atomic>
+#include <cstring>
+#include <filesystem>
 #include <mutex>
 #include <string>
 
@@ -16,6 +18,9 @@
 #include "rac/core/rac_platform_adapter.h"
 #include "rac/core/rac_structured_error.h"
 #include "rac/infrastructure/device/rac_device_manager.h"
+#include "rac/infrastructure/download/rac_archive_extract.h"
+#include "rac/infrastructure/download/rac_native_download.h"
+#include "rac/infrastructure/model_management/rac_model_paths.h"
 #include "rac/infrastructure/model_management/rac_model_registry.h"
 #if !defined(RAC_PLATFORM_ANDROID)
 #include "rac/features/diffusion/rac_diffusion_model_registry.h"
@@ -34,6 +39,7 @@ static std::string s_log_tag = "RAC";
 // Global model registry
 static rac_model_registry_handle_t s_model_registry = nullptr;
 static std::mutex s_model_registry_mutex;
+static bool s_model_catalog_loaded = false;
 
 // Version info
 static const char* s_version_string = "1.0.0";
@@ -54,6 +60,21 @@ static void internal_log(rac_log_level_t level, const char* message) {
     }
 }
 
+// Binary model catalog: {base_dir}/RunAnywhere/Cache/model_registry.catalog
+static bool model_catalog_path(std::string* out_path) {
+    char buffer[1024];
+    if (rac_model_paths_get_cache_directory(buffer, sizeof(buffer)) != RAC_SUCCESS) {
+        return false;
+    }
+    std::error_code ec;
+    std::filesystem::create_directories(buffer, ec);
+    if (ec) {
+        return false;
+    }
+    *out_path = std::string(buffer) + "/model_registry.catalog";
+    return true;
+}
+
 // =============================================================================
 // PLATFORM ADAPTER
 // =============================================================================
@@ -126,6 +147,15 @@ void rac_shutdown(void) {
 
     internal_log(RAC_LOG_INFO, "RunAnywhere Commons shutting down");
 
+    // Persist the registry so the next launch can skip re-registration
+    {
+        std::lock_guard<std::mutex> registry_lock(s_model_registry_mutex);
+        std::string catalog_path;
+        if (s_model_registry != nullptr && model_catalog_path(&catalog_path)) {
+            rac_model_registry_write_catalog(s_model_registry, catalog_path.c_str());
+        }
+    }
+
 #if !defined(RAC_PLATFORM_ANDROID)
     // Cleanup diffusion model registry (iOS/Apple only)
     rac_diffusion_model_registry_cleanup();
@@ -189,12 +219,14 @@ rac_result_t rac_http_download(const char* url, const char* destination_path,
                                rac_http_progress_callback_fn progress_callback,
                                rac_http_complete_callback_fn complete_callback,
                                void* callback_user_data, char** out_task_id) {
-    if (s_platform_adapter == nullptr) {
-        return RAC_ERROR_ADAPTER_NOT_SET;
-    }
-
-    if (s_platform_adapter->http_download == nullptr) {
-        return RAC_ERROR_NOT_SUPPORTED;
+    if (s_platform_adapter == nullptr || s_platform_adapter->http_download == nullptr) {
+        // No platform downloader: use the built-in one where available
+        if (rac_native_download_is_available()) {
+            return rac_native_download_start(url, destination_path, nullptr, progress_callback,
+                                             complete_callback, callback_user_data, out_task_id);
+        }
+        return s_platform_adapter == nullptr ? RAC_ERROR_ADAPTER_NOT_SET
+                                             : RAC_ERROR_NOT_SUPPORTED;
     }
 
     return s_platform_adapter->http_download(url, destination_path, progress_callback,
@@ -203,6 +235,10 @@ rac_result_t rac_http_download(const char* url, const char* destination_path,
 }
 
 rac_result_t rac_http_download_cancel(const char* task_id) {
+    if (task_id != nullptr && std::strncmp(task_id, "native-download-", 16) == 0) {
+        return rac_native_download_cancel(task_id);
+    }
+
     if (s_platform_adapter == nullptr) {
         return RAC_ERROR_ADAPTER_NOT_SET;
     }
@@ -221,12 +257,16 @@ rac_result_t rac_http_download_cancel(const char* task_id) {
 rac_result_t rac_extract_archive(const char* archive_path, const char* destination_dir,
                                  rac_extract_progress_callback_fn progress_callback,
                                  void* callback_user_data) {
-    if (s_platform_adapter == nullptr) {
-        return RAC_ERROR_ADAPTER_NOT_SET;
-    }
-
-    if (s_platform_adapter->extract_archive == nullptr) {
-        return RAC_ERROR_NOT_SUPPORTED;
+    if (s_platform_adapter == nullptr || s_platform_adapter->extract_archive == nullptr) {
+        // No platform extractor: tar archives can be handled natively
+        rac_archive_type_t type;
+        if (archive_path != nullptr && rac_archive_type_from_path(archive_path, &type) &&
+            rac_archive_extractor_supports(type)) {
+            return rac_archive_extract_file(archive_path, type, destination_dir,
+                                            progress_callback, callback_user_data);
+        }
+        return s_platform_adapter == nullptr ? RAC_ERROR_ADAPTER_NOT_SET
+                                             : RAC_ERROR_NOT_SUPPORTED;
     }
 
     return s_platform_adapter->extract_archive(archive_path, destination_dir, progress_callback,
@@ -249,6 +289,18 @@ rac_model_registry_handle_t rac_get_model_registry(void) {
         RAC_LOG_INFO("RAC.Core", "Global model registry created");
     }
 
+    // The catalog lives under the model base directory, which the SDK sets
+    // during initialization; load it on the first access after that
+    std::string catalog_path;
+    if (!s_model_catalog_loaded && model_catalog_path(&catalog_path)) {
+        s_model_catalog_loaded = true;
+        rac_result_t result =
+            rac_model_registry_load_catalog(s_model_registry, catalog_path.c_str(), nullptr);
+        if (result != RAC_SUCCESS && result != RAC_ERROR_FILE_NOT_FOUND) {
+            RAC_LOG_WARNING("RAC.Core", "Ignoring unreadable model catalog (%d)", result);
+        }
+    }
+
     return s_model_registry;
 }
 
@@ -0,0 +1,268 @@
+/**
+ * @file rac_profiler.cpp
+ * @brief RunAnywhere Commons - Phase Profiler Implementation
+ *
+ * Aggregates are lock-free atomics so concurrent generations can record
+ * without contention. Trace capture (opt-in) appends to a bounded vector
+ * under a mutex and is only touched when tracing is enabled.
+ */
+
+#include "rac/core/rac_profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_error.h"
+#include "rac/core/rac_logger.h"
+
+namespace rac {
+namespace profiler {
+std::atomic<bool> g_enabled{false};
+}  // namespace profiler
+}  // namespace rac
+
+namespace {
+
+const char* LOG_CAT = "Profiler";
+
+constexpr size_t DEFAULT_MAX_TRACE_EVENTS = 1000000;
+
+const char* const PHASE_NAMES[RAC_PROFILER_PHASE_COUNT] = {
+    "tokenize", "prefill", "decode", "sample", "detokenize", "callback",
+};
+
+struct PhaseCounters {
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+    std::atomic<uint64_t> min_ns{UINT64_MAX};
+    std::atomic<uint64_t> max_ns{0};
+};
+
+struct TraceEvent {
+    rac_profiler_phase_t phase;
+    uint64_t start_ns;
+    uint64_t dur_ns;
+    uint32_t tid;
+};
+
+struct ProfilerState {
+    PhaseCounters phases[RAC_PROFILER_PHASE_COUNT];
+
+    std::atomic<uint64_t> itl_buckets[RAC_PROFILER_ITL_BUCKETS] = {};
+    std::atomic<uint64_t> itl_count{0};
+    std::atomic<uint64_t> itl_total_ns{0};
+    std::atomic<uint64_t> itl_max_ns{0};
+
+    std::atomic<bool> trace_enabled{false};
+    std::mutex trace_mutex;
+    std::vector<TraceEvent> trace_events;
+    size_t max_trace_events = DEFAULT_MAX_TRACE_EVENTS;
+    uint64_t dropped_events = 0;
+};
+
+ProfilerState& state() {
+    static ProfilerState* s = new ProfilerState();  // Leaked: outlives static destructors
+    return *s;
+}
+
+void atomic_min(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value < current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void atomic_max(std::atomic<uint64_t>& target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current &&
+           !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+uint32_t current_tid() {
+    thread_local uint32_t tid =
+        static_cast<uint32_t>(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    return tid;
+}
+
+size_t itl_bucket(uint64_t gap_ns) {
+    uint64_t us = gap_ns / 1000;
+    size_t bucket = 0;
+    while (us > 1 && bucket + 1 < RAC_PROFILER_ITL_BUCKETS) {
+        us >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+}  // namespace
+
+extern "C" {
+
+void rac_profiler_set_enabled(rac_bool_t enabled) {
+    rac::profiler::g_enabled.store(enabled == RAC_TRUE, std::memory_order_relaxed);
+}
+
+rac_bool_t rac_profiler_is_enabled(void) {
+    return rac::profiler::enabled() ? RAC_TRUE : RAC_FALSE;
+}
+
+void rac_profiler_set_trace_enabled(rac_bool_t enabled, size_t max_events) {
+    auto& s = state();
+    {
+        std::lock_guard<std::mutex> lock(s.trace_mutex);
+        s.max_trace_events = max_events > 0 ? max_events : DEFAULT_MAX_TRACE_EVENTS;
+    }
+    s.trace_enabled.store(enabled == RAC_TRUE, std::memory_order_relaxed);
+    if (enabled == RAC_TRUE) {
+        rac_profiler_set_enabled(RAC_TRUE);
+    }
+}
+
+void rac_profiler_reset(void) {
+    auto& s = state();
+    for (auto& phase : s.phases) {
+        phase.count.store(0, std::memory_order_relaxed);
+        phase.total_ns.store(0, std::memory_order_relaxed);
+        phase.min_ns.store(UINT64_MAX, std::memory_order_relaxed);
+        phase.max_ns.store(0, std::memory_order_relaxed);
+    }
+    for (auto& bucket : s.itl_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    s.itl_count.store(0, std::memory_order_relaxed);
+    s.itl_total_ns.store(0, std::memory_order_relaxed);
+    s.itl_max_ns.store(0, std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(s.trace_mutex);
+    s.trace_events.clear();
+    s.dropped_events = 0;
+}
+
+uint64_t rac_profiler_now_ns(void) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now().time_since_epoch())
+                                     .count());
+}
+
+void rac_profiler_record(rac_profiler_phase_t phase, uint64_t start_ns, uint64_t end_ns) {
+    if (!rac::profiler::enabled() || phase < 0 || phase >= RAC_PROFILER_PHASE_COUNT) {
+        return;
+    }
+
+    auto& s = state();
+    const uint64_t dur = end_ns > start_ns ? end_ns - start_ns : 0;
+
+    auto& counters = s.phases[phase];
+    counters.count.fetch_add(1, std::memory_order_relaxed);
+    counters.total_ns.fetch_add(dur, std::memory_order_relaxed);
+    atomic_min(counters.min_ns, dur);
+    atomic_max(counters.max_ns, dur);
+
+    if (s.trace_enabled.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock(s.trace_mutex);
+        if (s.trace_events.size() < s.max_trace_events) {
+            s.trace_events.push_back({phase, start_ns, dur, current_tid()});
+        } else {
+            s.dropped_events++;
+        }
+    }
+}
+
+void rac_profiler_record_itl(uint64_t gap_ns) {
+    if (!rac::profiler::enabled()) {
+        return;
+    }
+
+    auto& s = state();
+    s.itl_buckets[itl_bucket(gap_ns)].fetch_add(1, std::memory_order_relaxed);
+    s.itl_count.fetch_add(1, std::memory_order_relaxed);
+    s.itl_total_ns.fetch_add(gap_ns, std::memory_order_relaxed);
+    atomic_max(s.itl_max_ns, gap_ns);
+}
+
+rac_result_t rac_profiler_get_phase_stats(rac_profiler_phase_t phase,
+                                          rac_profiler_phase_stats_t* out_stats) {
+    if (!out_stats || phase < 0 || phase >= RAC_PROFILER_PHASE_COUNT) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const auto& counters = state().phases[phase];
+    out_stats->count = counters.count.load(std::memory_order_relaxed);
+    out_stats->total_ns = counters.total_ns.load(std::memory_order_relaxed);
+    out_stats->max_ns = counters.max_ns.load(std::memory_order_relaxed);
+    uint64_t min_ns = counters.min_ns.load(std::memory_order_relaxed);
+    out_stats->min_ns = out_stats->count > 0 ? min_ns : 0;
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_profiler_get_itl_histogram(rac_profiler_itl_histogram_t* out_histogram) {
+    if (!out_histogram) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const auto& s = state();
+    for (size_t i = 0; i < RAC_PROFILER_ITL_BUCKETS; ++i) {
+        out_histogram->buckets[i] = s.itl_buckets[i].load(std::memory_order_relaxed);
+    }
+    out_histogram->count = s.itl_count.load(std::memory_order_relaxed);
+    out_histogram->total_ns = s.itl_total_ns.load(std::memory_order_relaxed);
+    out_histogram->max_ns = s.itl_max_ns.load(std::memory_order_relaxed);
+    return RAC_SUCCESS;
+}
+
+const char* rac_profiler_phase_name(rac_profiler_phase_t phase) {
+    if (phase < 0 || phase >= RAC_PROFILER_PHASE_COUNT) {
+        return "unknown";
+    }
+    return PHASE_NAMES[phase];
+}
+
+rac_result_t rac_profiler_write_chrome_trace(const char* path) {
+    if (!path) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    auto& s = state();
+    std::vector<TraceEvent> events;
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(s.trace_mutex);
+        events = s.trace_events;
+        dropped = s.dropped_events;
+    }
+
+    FILE* file = fopen(path, "w");
+    if (!file) {
+        RAC_LOG_ERROR(LOG_CAT, "Failed to open trace file: %s", path);
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+
+    // Chrome trace-event format: complete ("X") events, timestamps in microseconds
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", file);
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& e = events[i];
+        fprintf(file,
+                "%s\n{\"name\":\"%s\",\"cat\":\"llm\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                "\"pid\":1,\"tid\":%u}",
+                i == 0 ? "" : ",", PHASE_NAMES[e.phase], static_cast<double>(e.start_ns) / 1000.0,
+                static_cast<double>(e.dur_ns) / 1000.0, e.tid);
+    }
+    fprintf(file, "\n],\"otherData\":{\"dropped_events\":%llu}}\n",
+            static_cast<unsigned long long>(dropped));
+
+    bool ok = ferror(file) == 0;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+
+    RAC_LOG_INFO(LOG_CAT, "Wrote %zu trace events to %s", events.size(), path);
+    return RAC_SUCCESS;
+}
+
+}  // extern "C"
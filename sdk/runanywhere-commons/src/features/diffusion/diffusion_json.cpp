@@ -14,6 +14,7 @@
 
 #include "rac/core/rac_types.h"
 #include "rac/infrastructure/model_management/rac_model_types.h"
+#include "rac/utils/rac_base64.h"
 
 namespace {
 
@@ -222,27 +223,12 @@ static rac_inference_framework_t parse_preferred_framework(
 }
 
 static std::string base64_encode(const uint8_t* data, size_t len) {
-    static const char table[] =
-        "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-    std::string out;
-    out.reserve(((len + 2) / 3) * 4);
-
-    size_t i = 0;
-    while (i < len) {
-        size_t remaining = len - i;
-        uint32_t octet_a = data[i++];
-        uint32_t octet_b = remaining > 1 ? data[i++] : 0;
-        uint32_t octet_c = remaining > 2 ? data[i++] : 0;
-
-        uint32_t triple = (octet_a << 16) | (octet_b << 8) | octet_c;
-
-        out.push_back(table[(triple >> 18) & 0x3F]);
-        out.push_back(table[(triple >> 12) & 0x3F]);
-        out.push_back(remaining > 1 ? table[(triple >> 6) & 0x3F] : '=');
-        out.push_back(remaining > 2 ? table[triple & 0x3F] : '=');
+    std::string out(rac_base64_encoded_size(len), '\0');
+    size_t written = 0;
+    if (rac_base64_encode(data, len, &out[0], out.size(), &written) != RAC_SUCCESS) {
+        return {};
     }
-
+    out.resize(written);
     return out;
 }
 
@@ -212,12 +212,12 @@ static rac_result_t builtin_list_models(rac_diffusion_model_def_t** out_models,
 
 static rac_diffusion_backend_t builtin_select_backend(const rac_diffusion_model_def_t* model,
                                                        void* /*user_data*/) {
-    // Diffusion is Apple CoreML-only; no ONNX diffusion.
+    // CoreML on Apple, ONNX Runtime (CPU) everywhere else
     if (!model) {
 #if defined(__APPLE__)
         return RAC_DIFFUSION_BACKEND_COREML;
 #else
-        return RAC_DIFFUSION_BACKEND_COREML;  // Unused on non-Apple (diffusion not built)
+        return RAC_DIFFUSION_BACKEND_ONNX;
 #endif
     }
     if (model->backend != RAC_DIFFUSION_BACKEND_AUTO) {
@@ -228,7 +228,8 @@ static rac_diffusion_backend_t builtin_select_backend(const rac_diffusion_model_
         return RAC_DIFFUSION_BACKEND_COREML;
     }
 #endif
-    return RAC_DIFFUSION_BACKEND_COREML;
+    return model->download.onnx_path != nullptr ? RAC_DIFFUSION_BACKEND_ONNX
+                                                : RAC_DIFFUSION_BACKEND_COREML;
 }
 
 static rac_diffusion_model_strategy_t BUILTIN_STRATEGY = {
@@ -413,9 +414,9 @@ rac_diffusion_backend_t rac_diffusion_model_registry_select_backend(const char*
     rac_diffusion_model_def_t model_def;
     
     if (rac_diffusion_model_registry_get(model_id, &model_def) != RAC_SUCCESS) {
-        RAC_LOG_DEBUG(LOG_CAT, "Model '%s' not found, using CoreML (Apple only)", 
+        RAC_LOG_DEBUG(LOG_CAT, "Model '%s' not found, using the platform default backend",
                       model_id ? model_id : "(null)");
-        return RAC_DIFFUSION_BACKEND_COREML;
+        return builtin_select_backend(nullptr, nullptr);
     }
     
     auto& state = get_state();
@@ -26,8 +26,8 @@ namespace fs = std::filesystem;
 // =============================================================================
 
 /**
- * Detect model format from path. Only Apple CoreML diffusion is supported.
- * ONNX diffusion is not supported; we only look for CoreML.
+ * Detect model format from path: CoreML (.mlmodelc/.mlpackage) for Apple
+ * Stable Diffusion, or the diffusers ONNX export layout (unet/model.onnx).
  */
 static rac_inference_framework_t detect_model_format_from_path(const char* path) {
     if (!path) {
@@ -37,7 +37,11 @@ static rac_inference_framework_t detect_model_format_from_path(const char* path)
     if (!fs::exists(dir_path) || !fs::is_directory(dir_path)) {
         return RAC_FRAMEWORK_UNKNOWN;
     }
-    // Only support CoreML (.mlmodelc, .mlpackage) for Apple Stable Diffusion
+    std::error_code ec;
+    if (fs::exists(dir_path / "unet" / "model.onnx", ec)) {
+        RAC_LOG_DEBUG(LOG_CAT, "Found ONNX diffusion model at path: %s", path);
+        return RAC_FRAMEWORK_ONNX;
+    }
     try {
         for (const auto& entry : fs::directory_iterator(dir_path)) {
             std::string ext = entry.path().extension().string();
@@ -95,11 +99,13 @@ static rac_result_t diffusion_create_service_internal(const char* model_id,
         framework = detect_model_format_from_path(model_id);
 
         if (framework == RAC_FRAMEWORK_UNKNOWN) {
+#if defined(__APPLE__)
             framework = RAC_FRAMEWORK_COREML;
-            RAC_LOG_INFO(LOG_CAT, "Could not detect format, defaulting to CoreML (Apple only)");
-        } else if (framework == RAC_FRAMEWORK_ONNX) {
-            RAC_LOG_WARNING(LOG_CAT, "ONNX diffusion is not supported; only Apple CoreML. Ignoring ONNX.");
-            framework = RAC_FRAMEWORK_COREML;
+            RAC_LOG_INFO(LOG_CAT, "Could not detect format, defaulting to CoreML");
+#else
+            framework = RAC_FRAMEWORK_ONNX;
+            RAC_LOG_INFO(LOG_CAT, "Could not detect format, defaulting to ONNX");
+#endif
         } else {
             RAC_LOG_INFO(LOG_CAT, "Detected framework=%d from path inspection",
                          static_cast<int>(framework));
@@ -522,10 +522,10 @@ static rac_bool_t llm_stream_token_callback(const char* token, void* user_data)
         ctx->first_token_recorded = true;
         ctx->first_token_time = std::chrono::steady_clock::now();
 
-        // Calculate TTFT
-        auto ttft_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            ctx->first_token_time - ctx->start_time);
-        double ttft_ms = static_cast<double>(ttft_duration.count());
+        // Calculate TTFT (sub-millisecond precision for analytics)
+        double ttft_ms = std::chrono::duration<double, std::milli>(ctx->first_token_time -
+                                                                   ctx->start_time)
+                             .count();
 
         // Emit first token event
         rac_analytics_event_data_t event = {};
@@ -709,10 +709,9 @@ extern "C" rac_result_t rac_llm_component_generate_stream(
     double ttft_ms = 0.0;
     // Calculate TTFT
     if (ctx.first_token_recorded) {
-        auto ttft_duration = std::chrono::duration_cast<std::chrono::milliseconds>(
-            ctx.first_token_time - ctx.start_time);
-        final_result.time_to_first_token_ms = ttft_duration.count();
-        ttft_ms = static_cast<double>(ttft_duration.count());
+        ttft_ms = std::chrono::duration<double, std::milli>(ctx.first_token_time - ctx.start_time)
+                      .count();
+        final_result.time_to_first_token_ms = static_cast<int64_t>(ttft_ms);
     }
 
     // Calculate tokens per second
@@ -17,6 +17,7 @@
 
 #include "rac/core/rac_logger.h"
 #include "rac/core/rac_platform_adapter.h"
+#include "rac/core/rac_profiler.h"
 #include "rac/core/rac_structured_error.h"
 #include "rac/features/llm/rac_llm_metrics.h"
 
@@ -37,6 +38,11 @@ struct rac_streaming_metrics_collector {
     int64_t first_token_time_ms{0};
     int64_t end_time_ms{0};
 
+    // Monotonic nanosecond timestamps for sub-millisecond latency/TTFT
+    uint64_t start_ns{0};
+    uint64_t first_token_ns{0};
+    uint64_t end_ns{0};
+
     // State
     std::string full_text{};
     int32_t token_count{0};
@@ -54,6 +60,10 @@ struct rac_streaming_metrics_collector {
     rac_streaming_metrics_collector() = default;
 };
 
+static double ns_to_ms(uint64_t ns) {
+    return static_cast<double>(ns) / 1e6;
+}
+
 // =============================================================================
 // GENERATION TRACKER (Internal)
 // =============================================================================
@@ -127,6 +137,7 @@ rac_result_t rac_streaming_metrics_mark_start(rac_streaming_metrics_handle_t han
 
     std::lock_guard<std::mutex> lock(handle->mutex);
     handle->start_time_ms = rac_get_current_time_ms();
+    handle->start_ns = rac_profiler_now_ns();
     return RAC_SUCCESS;
 }
 
@@ -141,6 +152,7 @@ rac_result_t rac_streaming_metrics_record_token(rac_streaming_metrics_handle_t h
     // Record first token time
     if (!handle->first_token_recorded) {
         handle->first_token_time_ms = rac_get_current_time_ms();
+        handle->first_token_ns = rac_profiler_now_ns();
         handle->first_token_recorded = true;
     }
 
@@ -158,6 +170,7 @@ rac_result_t rac_streaming_metrics_mark_complete(rac_streaming_metrics_handle_t
 
     std::lock_guard<std::mutex> lock(handle->mutex);
     handle->end_time_ms = rac_get_current_time_ms();
+    handle->end_ns = rac_profiler_now_ns();
     handle->is_complete = true;
     return RAC_SUCCESS;
 }
@@ -170,6 +183,7 @@ rac_result_t rac_streaming_metrics_mark_failed(rac_streaming_metrics_handle_t ha
 
     std::lock_guard<std::mutex> lock(handle->mutex);
     handle->end_time_ms = rac_get_current_time_ms();
+    handle->end_ns = rac_profiler_now_ns();
     handle->is_complete = true;
     handle->error_code = error_code;
     return RAC_SUCCESS;
@@ -184,13 +198,13 @@ rac_result_t rac_streaming_metrics_get_result(rac_streaming_metrics_handle_t han
     std::lock_guard<std::mutex> lock(handle->mutex);
 
     // Calculate latency
-    int64_t end_time = handle->end_time_ms > 0 ? handle->end_time_ms : rac_get_current_time_ms();
-    double latency_ms = static_cast<double>(end_time - handle->start_time_ms);
+    uint64_t end_ns = handle->end_ns > 0 ? handle->end_ns : rac_profiler_now_ns();
+    double latency_ms = handle->start_ns > 0 ? ns_to_ms(end_ns - handle->start_ns) : 0.0;
 
     // Calculate TTFT
     double ttft_ms = 0.0;
-    if (handle->first_token_recorded && handle->start_time_ms > 0) {
-        ttft_ms = static_cast<double>(handle->first_token_time_ms - handle->start_time_ms);
+    if (handle->first_token_recorded && handle->start_ns > 0) {
+        ttft_ms = ns_to_ms(handle->first_token_ns - handle->start_ns);
     }
 
     // Use actual token counts from backend if available, otherwise estimate
@@ -244,10 +258,10 @@ rac_result_t rac_streaming_metrics_get_ttft(rac_streaming_metrics_handle_t handl
 
     std::lock_guard<std::mutex> lock(handle->mutex);
 
-    if (!handle->first_token_recorded || handle->start_time_ms == 0) {
+    if (!handle->first_token_recorded || handle->start_ns == 0) {
         *out_ttft_ms = 0.0;
     } else {
-        *out_ttft_ms = static_cast<double>(handle->first_token_time_ms - handle->start_time_ms);
+        *out_ttft_ms = ns_to_ms(handle->first_token_ns - handle->start_ns);
     }
 
     return RAC_SUCCESS;
@@ -11,6 +11,7 @@
 #include <cstdlib>
 #include <cstring>
 
+#include "rac/core/rac_audio_utils.h"
 #include "rac/core/rac_core.h"
 #include "rac/core/rac_logger.h"
 #include "rac/infrastructure/model_management/rac_model_registry.h"
@@ -80,6 +81,46 @@ rac_result_t rac_stt_transcribe(rac_handle_t handle, const void* audio_data, siz
     return service->ops->transcribe(service->impl, audio_data, audio_size, options, out_result);
 }
 
+rac_result_t rac_stt_transcribe_audio(rac_handle_t handle, const rac_audio_view_t* audio,
+                                      const rac_stt_options_t* options,
+                                      rac_stt_result_t* out_result) {
+    if (!handle || !audio || !audio->data || !out_result)
+        return RAC_ERROR_NULL_POINTER;
+
+    auto* service = static_cast<rac_stt_service_t*>(handle);
+    if (!service->ops) {
+        return RAC_ERROR_NOT_SUPPORTED;
+    }
+
+    if (service->ops->transcribe_audio) {
+        return service->ops->transcribe_audio(service->impl, audio, options, out_result);
+    }
+
+    if (!service->ops->transcribe) {
+        return RAC_ERROR_NOT_SUPPORTED;
+    }
+
+    // Legacy backends take mono Int16 bytes
+    if (audio->format == RAC_AUDIO_SAMPLE_INT16 && audio->channels == 1) {
+        return service->ops->transcribe(service->impl, audio->data,
+                                        audio->num_frames * sizeof(int16_t), options, out_result);
+    }
+
+    rac::MonoFloatAudio mono(*audio);
+    if (!mono.ok()) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    void* pcm = malloc(mono.size() * sizeof(int16_t));
+    if (!pcm) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    rac_audio_float32_to_int16(mono.data(), static_cast<int16_t*>(pcm), mono.size());
+    rac_result_t result = service->ops->transcribe(
+        service->impl, pcm, mono.size() * sizeof(int16_t), options, out_result);
+    free(pcm);
+    return result;
+}
+
 rac_result_t rac_stt_transcribe_stream(rac_handle_t handle, const void* audio_data,
                                        size_t audio_size, const rac_stt_options_t* options,
                                        rac_stt_stream_callback_t callback, void* user_data) {
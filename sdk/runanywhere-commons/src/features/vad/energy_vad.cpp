@@ -5,10 +5,13 @@
  * C++ port of Swift's SimpleEnergyVADService.swift from:
  * Sources/RunAnywhere/Features/VAD/Services/SimpleEnergyVADService.swift
  *
- * CRITICAL: This is a direct port of Swift implementation - do NOT add custom logic!
+ * CRITICAL: The single-stream service is a direct port of the Swift
+ * implementation - do NOT add custom logic unless it is opt-in! The
+ * interleaved RMS kernel and the multi-stream bank are native additions.
  */
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdio>
 #include <cstring>
@@ -16,6 +19,14 @@
 #include <string>
 #include <vector>
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RAC_VAD_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RAC_VAD_NEON 1
+#endif
+
 #include "rac/core/rac_logger.h"
 #include "rac/core/rac_platform_adapter.h"
 #include "rac/core/rac_structured_error.h"
@@ -25,6 +36,34 @@
 // INTERNAL STRUCTURE - Mirrors Swift's SimpleEnergyVADService properties
 // =============================================================================
 
+namespace {
+
+/** Per-frame noise floor update rates once calibration is done */
+constexpr float kNoiseFloorFallRate = 0.2f;
+constexpr float kNoiseFloorRiseRate = 0.02f;
+/** Much slower rise while voice is detected, so a noise step cannot pin the VAD on */
+constexpr float kNoiseFloorVoiceRiseRate = 0.001f;
+
+/**
+ * Energy statistics and threshold state of one audio stream.
+ * Fixed-size storage: nothing is allocated per frame or per calibration.
+ */
+struct EnergyTracker {
+    float energy_threshold = RAC_VAD_DEFAULT_ENERGY_THRESHOLD;
+    float ambient_noise_level = 0.0f;
+
+    bool is_calibrating = false;
+    int32_t calibration_frame_count = 0;
+    std::array<float, RAC_VAD_CALIBRATION_FRAMES_NEEDED> calibration_samples{};
+
+    // Ring of the most recent frame energies for getStatistics()
+    std::array<float, RAC_VAD_MAX_RECENT_VALUES> recent_energy_values{};
+    size_t ring_buffer_write_index = 0;
+    size_t ring_buffer_count = 0;
+};
+
+}  // namespace
+
 struct rac_energy_vad {
     
     // Hot data -> accessed frequently 
@@ -33,11 +72,11 @@ struct rac_energy_vad {
     bool is_currently_speaking;
     bool is_paused;
     bool is_tts_active;
+    bool noise_tracking;
 
     int32_t consecutive_silent_frames;
     int32_t consecutive_voice_frames;
 
-    float energy_threshold;
     float base_energy_threshold;
 
     int32_t voice_start_threshold;
@@ -45,8 +84,7 @@ struct rac_energy_vad {
     int32_t tts_voice_start_threshold;
     int32_t tts_voice_end_threshold;
 
-    size_t ring_buffer_write_index;
-    size_t ring_buffer_count;
+    EnergyTracker tracker;
 
     // Cold data -> accessed less frequently
 
@@ -55,14 +93,6 @@ struct rac_energy_vad {
     float tts_threshold_multiplier;
     float calibration_multiplier;
 
-    bool is_calibrating;
-    float ambient_noise_level;
-    int32_t calibration_frame_count;
-    int32_t calibration_frames_needed;
-    std::vector<float> calibration_samples;
-
-    std::vector<float> recent_energy_values;
-    int32_t max_recent_values;
     int32_t debug_frame_count;
 
     rac_speech_activity_callback_fn speech_callback;
@@ -73,6 +103,243 @@ struct rac_energy_vad {
     std::mutex mutex;
 };
 
+/** One stream of a bank: the tracker plus plain hysteresis counters */
+struct EnergyVadBankStream {
+    EnergyTracker tracker;
+    int32_t consecutive_silent_frames = 0;
+    int32_t consecutive_voice_frames = 0;
+    bool is_currently_speaking = false;
+};
+
+struct rac_energy_vad_bank {
+    float base_energy_threshold;
+    std::vector<EnergyVadBankStream> streams;
+    std::vector<float> energies;
+    std::mutex mutex;
+};
+
+// =============================================================================
+// ENERGY KERNEL
+// =============================================================================
+
+namespace {
+
+/**
+ * Number of accumulators for channel_count interleaved channels: a multiple
+ * of both the channel count and the vector width, and at least 16 so that
+ * the mono case still has four independent vector sums in flight. Lane j of
+ * the accumulator block always belongs to channel j % channel_count.
+ */
+size_t accumulator_width(int32_t channel_count) {
+    const auto channels = static_cast<size_t>(channel_count);
+    size_t width = channels % 4 == 0 ? channels : (channels % 2 == 0 ? channels * 2 : channels * 4);
+    while (width < 16) {
+        width *= 2;
+    }
+    return width;
+}
+
+/** Sum of squares of each interleaved channel into out_sums[channel_count] */
+void sum_squares_interleaved(const float* __restrict audio_data, size_t frame_count,
+                             int32_t channel_count, float* __restrict out_sums) {
+    const size_t width = accumulator_width(channel_count);
+    alignas(16) float acc[4 * RAC_VAD_MAX_STREAMS];
+    std::fill(acc, acc + width, 0.0f);
+
+    const size_t total = frame_count * static_cast<size_t>(channel_count);
+    size_t i = 0;
+
+#if defined(RAC_VAD_SSE2)
+    if (width == 16) {
+        // Mono/2/4 channels: keep the four sums in registers
+        __m128 s0 = _mm_setzero_ps(), s1 = _mm_setzero_ps();
+        __m128 s2 = _mm_setzero_ps(), s3 = _mm_setzero_ps();
+        for (; i + 16 <= total; i += 16) {
+            const __m128 a = _mm_loadu_ps(audio_data + i);
+            const __m128 b = _mm_loadu_ps(audio_data + i + 4);
+            const __m128 c = _mm_loadu_ps(audio_data + i + 8);
+            const __m128 d = _mm_loadu_ps(audio_data + i + 12);
+            s0 = _mm_add_ps(s0, _mm_mul_ps(a, a));
+            s1 = _mm_add_ps(s1, _mm_mul_ps(b, b));
+            s2 = _mm_add_ps(s2, _mm_mul_ps(c, c));
+            s3 = _mm_add_ps(s3, _mm_mul_ps(d, d));
+        }
+        _mm_store_ps(acc, s0);
+        _mm_store_ps(acc + 4, s1);
+        _mm_store_ps(acc + 8, s2);
+        _mm_store_ps(acc + 12, s3);
+    } else {
+        for (; i + width <= total; i += width) {
+            for (size_t v = 0; v < width; v += 4) {
+                const __m128 x = _mm_loadu_ps(audio_data + i + v);
+                _mm_store_ps(acc + v, _mm_add_ps(_mm_load_ps(acc + v), _mm_mul_ps(x, x)));
+            }
+        }
+    }
+#elif defined(RAC_VAD_NEON)
+    if (width == 16) {
+        float32x4_t s0 = vdupq_n_f32(0.0f), s1 = vdupq_n_f32(0.0f);
+        float32x4_t s2 = vdupq_n_f32(0.0f), s3 = vdupq_n_f32(0.0f);
+        for (; i + 16 <= total; i += 16) {
+            const float32x4_t a = vld1q_f32(audio_data + i);
+            const float32x4_t b = vld1q_f32(audio_data + i + 4);
+            const float32x4_t c = vld1q_f32(audio_data + i + 8);
+            const float32x4_t d = vld1q_f32(audio_data + i + 12);
+            s0 = vmlaq_f32(s0, a, a);
+            s1 = vmlaq_f32(s1, b, b);
+            s2 = vmlaq_f32(s2, c, c);
+            s3 = vmlaq_f32(s3, d, d);
+        }
+        vst1q_f32(acc, s0);
+        vst1q_f32(acc + 4, s1);
+        vst1q_f32(acc + 8, s2);
+        vst1q_f32(acc + 12, s3);
+    } else {
+        for (; i + width <= total; i += width) {
+            for (size_t v = 0; v < width; v += 4) {
+                const float32x4_t x = vld1q_f32(audio_data + i + v);
+                vst1q_f32(acc + v, vmlaq_f32(vld1q_f32(acc + v), x, x));
+            }
+        }
+    }
+#else
+    for (; i + width <= total; i += width) {
+        for (size_t v = 0; v < width; ++v) {
+            const float x = audio_data[i + v];
+            acc[v] += x * x;
+        }
+    }
+#endif
+
+    // i is a multiple of width, so the tail keeps the same lane mapping
+    for (size_t v = 0; i + v < total; ++v) {
+        const float x = audio_data[i + v];
+        acc[v] += x * x;
+    }
+
+    const auto channels = static_cast<size_t>(channel_count);
+    std::fill(out_sums, out_sums + channels, 0.0f);
+    for (size_t v = 0; v < width; ++v) {
+        out_sums[v % channels] += acc[v];
+    }
+}
+
+// =============================================================================
+// TRACKER HELPERS - Calibration, noise floor and statistics per stream
+// =============================================================================
+
+/**
+ * Threshold for an ambient noise level
+ * Mirrors the threshold computation in Swift's completeCalibration()
+ */
+float threshold_for_ambient(float ambient, float multiplier) {
+    float minimum_threshold = std::max(ambient * 2.0f, RAC_VAD_MIN_THRESHOLD);
+    float calculated_threshold = ambient * multiplier;
+    return std::min(std::max(calculated_threshold, minimum_threshold), RAC_VAD_MAX_THRESHOLD);
+}
+
+void start_calibration(EnergyTracker* tracker) {
+    tracker->is_calibrating = true;
+    tracker->calibration_frame_count = 0;
+}
+
+void reset_recent_energies(EnergyTracker* tracker) {
+    // No need to zero out the ring, just reset indices
+    tracker->ring_buffer_count = 0;
+    tracker->ring_buffer_write_index = 0;
+}
+
+/**
+ * Handle a frame during calibration
+ * Mirrors Swift's handleCalibrationFrame(energy:)
+ *
+ * @return true if this frame completed calibration
+ */
+bool handle_calibration_frame(EnergyTracker* tracker, float energy, float multiplier) {
+    if (!tracker->is_calibrating) {
+        return false;
+    }
+
+    tracker->calibration_samples[tracker->calibration_frame_count++] = energy;
+    if (tracker->calibration_frame_count < RAC_VAD_CALIBRATION_FRAMES_NEEDED) {
+        return false;
+    }
+
+    // Complete calibration - mirrors Swift's completeCalibration()
+    // Use 90th percentile as ambient noise level (mirrors Swift)
+    const size_t count = tracker->calibration_samples.size();
+    const size_t rank = std::min(count - 1, static_cast<size_t>(count * 0.90f));
+    std::array<float, RAC_VAD_CALIBRATION_FRAMES_NEEDED> samples = tracker->calibration_samples;
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    tracker->ambient_noise_level = samples[rank];
+
+    tracker->energy_threshold = threshold_for_ambient(tracker->ambient_noise_level, multiplier);
+    tracker->is_calibrating = false;
+    tracker->calibration_frame_count = 0;
+    return true;
+}
+
+/**
+ * Follow the noise floor after calibration: fall quickly on quieter frames,
+ * rise slowly on louder ones (very slowly while voice is detected)
+ */
+void track_noise_floor(EnergyTracker* tracker, float energy, bool has_voice, float multiplier) {
+    float rate = kNoiseFloorFallRate;
+    if (energy > tracker->ambient_noise_level) {
+        rate = has_voice ? kNoiseFloorVoiceRiseRate : kNoiseFloorRiseRate;
+    }
+    tracker->ambient_noise_level += rate * (energy - tracker->ambient_noise_level);
+    tracker->energy_threshold = threshold_for_ambient(tracker->ambient_noise_level, multiplier);
+}
+
+/**
+ * Update debug statistics
+ * Mirrors Swift's updateDebugStatistics(energy:) 
+ * Optimised to use ring buffer 
+ */
+void update_debug_statistics(EnergyTracker* tracker, float energy) {
+    tracker->recent_energy_values[tracker->ring_buffer_write_index] = energy;
+
+    tracker->ring_buffer_write_index++;
+    if (tracker->ring_buffer_write_index >= tracker->recent_energy_values.size()) {
+        tracker->ring_buffer_write_index = 0;
+    }
+
+    if (tracker->ring_buffer_count < tracker->recent_energy_values.size()) {
+        tracker->ring_buffer_count++;
+    }
+}
+
+/** Mirrors Swift's getStatistics() */
+void fill_statistics(const EnergyTracker& tracker, rac_energy_vad_stats_t* out_stats) {
+    float recent_avg = 0.0f;
+    float recent_max = 0.0f;
+    float current = 0.0f;
+
+    size_t count = tracker.ring_buffer_count;
+    if (count > 0) {
+        size_t last_idx = (tracker.ring_buffer_write_index == 0)
+                              ? (tracker.recent_energy_values.size() - 1)
+                              : (tracker.ring_buffer_write_index - 1);
+        current = tracker.recent_energy_values[last_idx];
+
+        for (size_t i = 0; i < count; ++i) {
+            float val = tracker.recent_energy_values[i];
+            recent_avg += val;
+            recent_max = std::max(recent_max, val);
+        }
+        recent_avg /= static_cast<float>(count);
+    }
+
+    out_stats->current = current;
+    out_stats->threshold = tracker.energy_threshold;
+    out_stats->ambient = tracker.ambient_noise_level;
+    out_stats->recent_avg = recent_avg;
+    out_stats->recent_max = recent_max;
+}
+
+}  // namespace
+
 // =============================================================================
 // HELPER FUNCTIONS - Mirrors Swift's private methods
 // =============================================================================
@@ -131,72 +398,14 @@ static void update_voice_activity_state(rac_energy_vad* vad, bool has_voice) {
  * Mirrors Swift's handleCalibrationFrame(energy:)
  */
 static void handle_calibration_frame(rac_energy_vad* vad, float energy) {
-    if (!vad->is_calibrating) {
-        return;
-    }
-
-    vad->calibration_samples.push_back(energy);
-    vad->calibration_frame_count++;
-
-    if (vad->calibration_frame_count >= vad->calibration_frames_needed) {
-        // Complete calibration - mirrors Swift's completeCalibration()
-        if (vad->calibration_samples.empty()) {
-            vad->is_calibrating = false;
-            return;
-        }
-
-        // Calculate statistics (mirrors Swift logic)
-        std::vector<float> sorted_samples = vad->calibration_samples;
-        std::sort(sorted_samples.begin(), sorted_samples.end());
-
-        size_t count = sorted_samples.size();
-        float percentile_90 =
-            sorted_samples[std::min(count - 1, static_cast<size_t>(count * 0.90f))];
-
-        // Use 90th percentile as ambient noise level (mirrors Swift)
-        vad->ambient_noise_level = percentile_90;
-
-        // Calculate dynamic threshold (mirrors Swift logic)
-        float minimum_threshold = std::max(vad->ambient_noise_level * 2.0f, RAC_VAD_MIN_THRESHOLD);
-        float calculated_threshold = vad->ambient_noise_level * vad->calibration_multiplier;
-
-        // Apply threshold with sensible bounds
-        vad->energy_threshold = std::max(calculated_threshold, minimum_threshold);
-
-        // Cap at reasonable maximum (mirrors Swift cap)
-        if (vad->energy_threshold > RAC_VAD_MAX_THRESHOLD) {
-            vad->energy_threshold = RAC_VAD_MAX_THRESHOLD;
-            RAC_LOG_WARNING("EnergyVAD",
-                            "Calibration detected high ambient noise. Capping threshold.");
-        }
-
-        RAC_LOG_INFO("EnergyVAD", "VAD Calibration Complete");
-
-        vad->is_calibrating = false;
-        vad->calibration_samples.clear();
-    }
-}
-
-/**
- * Update debug statistics
- * Mirrors Swift's updateDebugStatistics(energy:) 
- * Optimised to use ring buffer 
- */
-static void update_debug_statistics(rac_energy_vad* vad, float energy) {
-    if (vad->recent_energy_values.empty()) {
+    if (!handle_calibration_frame(&vad->tracker, energy, vad->calibration_multiplier)) {
         return;
     }
-    
-    vad->recent_energy_values[vad->ring_buffer_write_index] = energy;
-
-    vad->ring_buffer_write_index++;
-    if (vad->ring_buffer_write_index >= vad->recent_energy_values.size()) {
-        vad->ring_buffer_write_index = 0;
-    }
 
-    if (vad->ring_buffer_count < vad->recent_energy_values.size()) {
-        vad->ring_buffer_count++;
+    if (vad->tracker.energy_threshold >= RAC_VAD_MAX_THRESHOLD) {
+        RAC_LOG_WARNING("EnergyVAD", "Calibration detected high ambient noise. Capping threshold.");
     }
+    RAC_LOG_INFO("EnergyVAD", "VAD Calibration Complete");
 }
 
 // =============================================================================
@@ -217,7 +426,7 @@ rac_result_t rac_energy_vad_create(const rac_energy_vad_config_t* config,
     vad->sample_rate = cfg->sample_rate;
     vad->frame_length_samples =
         static_cast<int32_t>(cfg->frame_length * static_cast<float>(cfg->sample_rate));
-    vad->energy_threshold = cfg->energy_threshold;
+    vad->tracker.energy_threshold = cfg->energy_threshold;
     vad->base_energy_threshold = cfg->energy_threshold;
     vad->calibration_multiplier = RAC_VAD_DEFAULT_CALIBRATION_MULTIPLIER;
     vad->tts_threshold_multiplier = RAC_VAD_DEFAULT_TTS_THRESHOLD_MULTIPLIER;
@@ -229,6 +438,7 @@ rac_result_t rac_energy_vad_create(const rac_energy_vad_config_t* config,
     vad->consecutive_voice_frames = 0;
     vad->is_paused = false;
     vad->is_tts_active = false;
+    vad->noise_tracking = false;
 
     // Hysteresis parameters (mirrors Swift constants)
     vad->voice_start_threshold = RAC_VAD_VOICE_START_THRESHOLD;
@@ -236,19 +446,8 @@ rac_result_t rac_energy_vad_create(const rac_energy_vad_config_t* config,
     vad->tts_voice_start_threshold = RAC_VAD_TTS_VOICE_START_THRESHOLD;
     vad->tts_voice_end_threshold = RAC_VAD_TTS_VOICE_END_THRESHOLD;
 
-    // Calibration (mirrors Swift defaults)
-    vad->is_calibrating = false;
-    vad->calibration_frame_count = 0;
-    vad->calibration_frames_needed = RAC_VAD_CALIBRATION_FRAMES_NEEDED;
-    vad->ambient_noise_level = 0.0f;
-
-    // Debug Ring Buffer Init
-    vad->max_recent_values = RAC_VAD_MAX_RECENT_VALUES;
+    // Calibration and debug ring buffer start empty (EnergyTracker defaults)
     vad->debug_frame_count = 0;
-    vad->ring_buffer_write_index = 0;
-    vad->ring_buffer_count = 0;
-
-    vad->recent_energy_values.resize(vad->max_recent_values, 0.0f);
 
     // Callbacks
     vad->speech_callback = nullptr;
@@ -287,9 +486,7 @@ rac_result_t rac_energy_vad_initialize(rac_energy_vad_handle_t handle) {
     // Start calibration (mirrors Swift's startCalibration)
     RAC_LOG_INFO("EnergyVAD", "Starting VAD calibration - measuring ambient noise");
 
-    handle->is_calibrating = true;
-    handle->calibration_samples.clear();
-    handle->calibration_frame_count = 0;
+    start_calibration(&handle->tracker);
 
     return RAC_SUCCESS;
 }
@@ -393,17 +590,21 @@ rac_result_t rac_energy_vad_process_audio(rac_energy_vad_handle_t handle, const
     float energy = rac_energy_vad_calculate_rms(audio_data, sample_count);
 
     // Update debug statistics
-    update_debug_statistics(handle, energy);
+    update_debug_statistics(&handle->tracker, energy);
 
     // Handle calibration if active (mirrors Swift)
-    if (handle->is_calibrating) {
+    if (handle->tracker.is_calibrating) {
         handle_calibration_frame(handle, energy);
         if (out_has_voice)
             *out_has_voice = RAC_FALSE;
         return RAC_SUCCESS;
     }
 
-    bool has_voice = energy > handle->energy_threshold;
+    bool has_voice = energy > handle->tracker.energy_threshold;
+
+    if (handle->noise_tracking) {
+        track_noise_floor(&handle->tracker, energy, has_voice, handle->calibration_multiplier);
+    }
 
     // Update state (mirrors Swift's updateVoiceActivityState)
     update_voice_activity_state(handle, has_voice);
@@ -426,27 +627,29 @@ float rac_energy_vad_calculate_rms(const float* __restrict audio_data,
         return 0.0f;
     }
 
-    float s0 = 0.0f, s1 = 0.0f, s2 = 0.0f, s3 = 0.0f;
-    size_t i = 0;
+    float sum_squares = 0.0f;
+    sum_squares_interleaved(audio_data, sample_count, 1, &sum_squares);
+    return std::sqrt(sum_squares / static_cast<float>(sample_count));
+}
 
-    for (; i + 3 < sample_count; i += 4) {
-        float a = audio_data[i];
-        float b = audio_data[i + 1];
-        float c = audio_data[i + 2];
-        float d = audio_data[i + 3];
-        s0 += a * a;
-        s1 += b * b;
-        s2 += c * c;
-        s3 += d * d;
+rac_result_t rac_energy_vad_calculate_rms_interleaved(const float* audio_data, size_t frame_count,
+                                                      int32_t channel_count, float* out_rms) {
+    if (!out_rms || channel_count < 1 || channel_count > RAC_VAD_MAX_STREAMS ||
+        (!audio_data && frame_count > 0)) {
+        return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    float sum_squares = (s0 + s1) + (s2 + s3);
+    if (frame_count == 0) {
+        std::fill(out_rms, out_rms + channel_count, 0.0f);
+        return RAC_SUCCESS;
+    }
 
-    for (; i < sample_count; ++i) {
-        float x = audio_data[i];
-        sum_squares += x * x;
+    sum_squares_interleaved(audio_data, frame_count, channel_count, out_rms);
+    const float inv_frames = 1.0f / static_cast<float>(frame_count);
+    for (int32_t c = 0; c < channel_count; ++c) {
+        out_rms[c] = std::sqrt(out_rms[c] * inv_frames);
     }
-    return std::sqrt(sum_squares / static_cast<float>(sample_count));
+    return RAC_SUCCESS;
 }
 
 rac_result_t rac_energy_vad_pause(rac_energy_vad_handle_t handle) {
@@ -473,9 +676,7 @@ rac_result_t rac_energy_vad_pause(rac_energy_vad_handle_t handle) {
     }
 
     // Clear recent energy values (Reset Ring Buffer)
-    handle->ring_buffer_count = 0;
-    handle->ring_buffer_write_index = 0;
-    // No need to zero out vector, just reset indices
+    reset_recent_energies(&handle->tracker);
     handle->consecutive_silent_frames = 0;
     handle->consecutive_voice_frames = 0;
 
@@ -500,8 +701,7 @@ rac_result_t rac_energy_vad_resume(rac_energy_vad_handle_t handle) {
     handle->consecutive_silent_frames = 0;
     handle->consecutive_voice_frames = 0;
 
-    handle->ring_buffer_count = 0;
-    handle->ring_buffer_write_index = 0;
+    reset_recent_energies(&handle->tracker);
 
     handle->debug_frame_count = 0;
 
@@ -518,9 +718,7 @@ rac_result_t rac_energy_vad_start_calibration(rac_energy_vad_handle_t handle) {
 
     RAC_LOG_INFO("EnergyVAD", "Starting VAD calibration");
 
-    handle->is_calibrating = true;
-    handle->calibration_samples.clear();
-    handle->calibration_frame_count = 0;
+    start_calibration(&handle->tracker);
 
     return RAC_SUCCESS;
 }
@@ -532,7 +730,7 @@ rac_result_t rac_energy_vad_is_calibrating(rac_energy_vad_handle_t handle,
     }
 
     std::lock_guard<std::mutex> lock(handle->mutex);
-    *out_is_calibrating = handle->is_calibrating ? RAC_TRUE : RAC_FALSE;
+    *out_is_calibrating = handle->tracker.is_calibrating ? RAC_TRUE : RAC_FALSE;
 
     return RAC_SUCCESS;
 }
@@ -551,6 +749,18 @@ rac_result_t rac_energy_vad_set_calibration_multiplier(rac_energy_vad_handle_t h
     return RAC_SUCCESS;
 }
 
+rac_result_t rac_energy_vad_set_noise_tracking(rac_energy_vad_handle_t handle,
+                                               rac_bool_t enabled) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    handle->noise_tracking = enabled == RAC_TRUE;
+
+    return RAC_SUCCESS;
+}
+
 rac_result_t rac_energy_vad_notify_tts_start(rac_energy_vad_handle_t handle) {
     if (!handle) {
         return RAC_ERROR_INVALID_ARGUMENT;
@@ -562,11 +772,11 @@ rac_result_t rac_energy_vad_notify_tts_start(rac_energy_vad_handle_t handle) {
     handle->is_tts_active = true;
 
     // Save base threshold
-    handle->base_energy_threshold = handle->energy_threshold;
+    handle->base_energy_threshold = handle->tracker.energy_threshold;
 
     // Increase threshold significantly to prevent TTS audio from triggering VAD
-    float new_threshold = handle->energy_threshold * handle->tts_threshold_multiplier;
-    handle->energy_threshold = std::min(new_threshold, 0.1f);
+    float new_threshold = handle->tracker.energy_threshold * handle->tts_threshold_multiplier;
+    handle->tracker.energy_threshold = std::min(new_threshold, 0.1f);
 
     RAC_LOG_INFO("EnergyVAD", "TTS starting - VAD blocked and threshold increased");
 
@@ -596,13 +806,12 @@ rac_result_t rac_energy_vad_notify_tts_finish(rac_energy_vad_handle_t handle) {
     handle->is_tts_active = false;
 
     // Immediately restore threshold
-    handle->energy_threshold = handle->base_energy_threshold;
+    handle->tracker.energy_threshold = handle->base_energy_threshold;
 
     RAC_LOG_INFO("EnergyVAD", "TTS finished - VAD threshold restored");
 
     // Reset state for immediate readiness
-    handle->ring_buffer_count = 0;
-    handle->ring_buffer_write_index = 0;
+    reset_recent_energies(&handle->tracker);
     handle->consecutive_silent_frames = 0;
     handle->consecutive_voice_frames = 0;
     handle->is_currently_speaking = false;
@@ -644,7 +853,7 @@ rac_result_t rac_energy_vad_get_threshold(rac_energy_vad_handle_t handle, float*
     }
 
     std::lock_guard<std::mutex> lock(handle->mutex);
-    *out_threshold = handle->energy_threshold;
+    *out_threshold = handle->tracker.energy_threshold;
 
     return RAC_SUCCESS;
 }
@@ -655,7 +864,7 @@ rac_result_t rac_energy_vad_set_threshold(rac_energy_vad_handle_t handle, float
     }
 
     std::lock_guard<std::mutex> lock(handle->mutex);
-    handle->energy_threshold = threshold;
+    handle->tracker.energy_threshold = threshold;
     handle->base_energy_threshold = threshold;
 
     return RAC_SUCCESS;
@@ -670,31 +879,7 @@ rac_result_t rac_energy_vad_get_statistics(rac_energy_vad_handle_t handle,
     std::lock_guard<std::mutex> lock(handle->mutex);
 
     // Mirrors Swift's getStatistics()
-    float recent_avg = 0.0f;
-    float recent_max = 0.0f;
-    float current = 0.0f;
-
-    size_t count = handle->ring_buffer_count;
-    if (count > 0) {
-        
-        size_t last_idx = (handle->ring_buffer_write_index == 0)
-                              ? (handle->recent_energy_values.size() - 1)
-                              : (handle->ring_buffer_write_index - 1);
-        current = handle->recent_energy_values[last_idx];
-
-        for (size_t i = 0; i < count; ++i) {
-            float val = handle->recent_energy_values[i];
-            recent_avg += val;
-            recent_max = std::max(recent_max, val);
-        }
-        recent_avg /= static_cast<float>(count);
-    }
-
-    out_stats->current = current;
-    out_stats->threshold = handle->energy_threshold;
-    out_stats->ambient = handle->ambient_noise_level;
-    out_stats->recent_avg = recent_avg;
-    out_stats->recent_max = recent_max;
+    fill_statistics(handle->tracker, out_stats);
 
     return RAC_SUCCESS;
 }
@@ -752,3 +937,131 @@ rac_result_t rac_energy_vad_set_audio_callback(rac_energy_vad_handle_t handle,
 
     return RAC_SUCCESS;
 }
+
+// =============================================================================
+// MULTI-STREAM API
+// =============================================================================
+
+rac_result_t rac_energy_vad_bank_create(const rac_energy_vad_config_t* config,
+                                        int32_t stream_count,
+                                        rac_energy_vad_bank_handle_t* out_handle) {
+    if (!out_handle || stream_count < 1 || stream_count > RAC_VAD_MAX_STREAMS) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const rac_energy_vad_config_t* cfg = config ? config : &RAC_ENERGY_VAD_CONFIG_DEFAULT;
+
+    rac_energy_vad_bank* bank = new rac_energy_vad_bank();
+    bank->base_energy_threshold = cfg->energy_threshold;
+    bank->streams.resize(static_cast<size_t>(stream_count));
+    bank->energies.resize(static_cast<size_t>(stream_count), 0.0f);
+    for (auto& stream : bank->streams) {
+        stream.tracker.energy_threshold = cfg->energy_threshold;
+        start_calibration(&stream.tracker);
+    }
+
+    RAC_LOG_INFO("EnergyVAD", "Energy VAD bank created with %d streams", stream_count);
+
+    *out_handle = bank;
+    return RAC_SUCCESS;
+}
+
+void rac_energy_vad_bank_destroy(rac_energy_vad_bank_handle_t handle) {
+    if (!handle) {
+        return;
+    }
+
+    delete handle;
+    RAC_LOG_DEBUG("EnergyVAD", "Energy VAD bank destroyed");
+}
+
+rac_result_t rac_energy_vad_bank_process(rac_energy_vad_bank_handle_t handle,
+                                         const float* audio_data, size_t frame_count,
+                                         rac_bool_t* out_has_voice,
+                                         rac_bool_t* out_is_speaking) {
+    if (!handle || !audio_data || frame_count == 0) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+
+    const auto stream_count = static_cast<int32_t>(handle->streams.size());
+    rac_energy_vad_calculate_rms_interleaved(audio_data, frame_count, stream_count,
+                                             handle->energies.data());
+
+    for (int32_t s = 0; s < stream_count; ++s) {
+        EnergyVadBankStream& stream = handle->streams[s];
+        const float energy = handle->energies[s];
+
+        update_debug_statistics(&stream.tracker, energy);
+
+        bool has_voice = false;
+        if (!handle_calibration_frame(&stream.tracker, energy,
+                                      RAC_VAD_DEFAULT_CALIBRATION_MULTIPLIER) &&
+            !stream.tracker.is_calibrating) {
+            has_voice = energy > stream.tracker.energy_threshold;
+            track_noise_floor(&stream.tracker, energy, has_voice,
+                              RAC_VAD_DEFAULT_CALIBRATION_MULTIPLIER);
+
+            // Same hysteresis as the single-stream service outside of TTS
+            if (has_voice) {
+                stream.consecutive_voice_frames++;
+                stream.consecutive_silent_frames = 0;
+                if (stream.consecutive_voice_frames >= RAC_VAD_VOICE_START_THRESHOLD) {
+                    stream.is_currently_speaking = true;
+                }
+            } else {
+                stream.consecutive_silent_frames++;
+                stream.consecutive_voice_frames = 0;
+                if (stream.consecutive_silent_frames >= RAC_VAD_VOICE_END_THRESHOLD) {
+                    stream.is_currently_speaking = false;
+                }
+            }
+        }
+
+        if (out_has_voice) {
+            out_has_voice[s] = has_voice ? RAC_TRUE : RAC_FALSE;
+        }
+        if (out_is_speaking) {
+            out_is_speaking[s] = stream.is_currently_speaking ? RAC_TRUE : RAC_FALSE;
+        }
+    }
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_energy_vad_bank_reset_stream(rac_energy_vad_bank_handle_t handle,
+                                              int32_t stream_index) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    if (stream_index < 0 || stream_index >= static_cast<int32_t>(handle->streams.size())) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    EnergyVadBankStream& stream = handle->streams[stream_index];
+    stream = EnergyVadBankStream();
+    stream.tracker.energy_threshold = handle->base_energy_threshold;
+    start_calibration(&stream.tracker);
+
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_energy_vad_bank_get_statistics(rac_energy_vad_bank_handle_t handle,
+                                                int32_t stream_index,
+                                                rac_energy_vad_stats_t* out_stats) {
+    if (!handle || !out_stats) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::lock_guard<std::mutex> lock(handle->mutex);
+    if (stream_index < 0 || stream_index >= static_cast<int32_t>(handle->streams.size())) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    fill_statistics(handle->streams[stream_index].tracker, out_stats);
+
+    return RAC_SUCCESS;
+}
@@ -10,6 +10,7 @@
  */
 
 #include "rac/features/wakeword/rac_wakeword_service.h"
+#include "rac/core/rac_audio_utils.h"
 #include "rac/core/rac_logger.h"
 
 #include <algorithm>
@@ -456,18 +457,6 @@ RAC_API rac_result_t rac_wakeword_process(rac_handle_t handle,
 
     // Process complete frames
     while (service->audio_buffer.size() >= service->samples_per_frame) {
-        // Extract frame
-        std::vector<float> frame(
-            service->audio_buffer.begin(),
-            service->audio_buffer.begin() + service->samples_per_frame
-        );
-
-        // Remove processed samples
-        service->audio_buffer.erase(
-            service->audio_buffer.begin(),
-            service->audio_buffer.begin() + service->samples_per_frame
-        );
-
         // TODO: Process through ONNX backend
         // For now, simulate with placeholder
         bool detected = false;
@@ -532,6 +521,12 @@ RAC_API rac_result_t rac_wakeword_process(rac_handle_t handle,
             }
         }
 
+        // Remove processed samples
+        service->audio_buffer.erase(
+            service->audio_buffer.begin(),
+            service->audio_buffer.begin() + service->samples_per_frame
+        );
+
         // Release lock before invoking callbacks to avoid deadlock
         lock.unlock();
 
@@ -565,10 +560,10 @@ RAC_API rac_result_t rac_wakeword_process_int16(rac_handle_t handle,
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    // Convert int16 to float
-    std::vector<float> float_samples(num_samples);
-    for (size_t i = 0; i < num_samples; ++i) {
-        float_samples[i] = samples[i] / 32768.0f;
+    // Convert int16 to float into pooled scratch (no per-frame allocation)
+    rac::MonoFloatAudio float_samples(samples, num_samples);
+    if (!float_samples.ok()) {
+        return RAC_ERROR_OUT_OF_MEMORY;
     }
 
     return rac_wakeword_process(handle, float_samples.data(), num_samples, out_result);
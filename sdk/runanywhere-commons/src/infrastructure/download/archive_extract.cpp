@@ -0,0 +1,126 @@
+/**
+ * @file archive_extract.cpp
+ * @brief C API for the streaming archive extractor
+ */
+
+#include "rac/infrastructure/download/rac_archive_extract.h"
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "infrastructure/download/streaming_extractor.h"
+#include "rac/core/rac_logger.h"
+
+struct rac_archive_extractor {
+    std::unique_ptr<rac_internal::StreamingExtractor> impl;
+};
+
+extern "C" {
+
+rac_bool_t rac_archive_extractor_supports(rac_archive_type_t type) {
+    return rac_internal::StreamingExtractor::supports(type) ? RAC_TRUE : RAC_FALSE;
+}
+
+rac_result_t rac_archive_extractor_create(rac_archive_type_t type, const char* destination_dir,
+                                          rac_archive_extractor_handle_t* out_handle) {
+    if (!destination_dir || !out_handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::unique_ptr<rac_internal::StreamingExtractor> impl;
+    rac_result_t result = rac_internal::StreamingExtractor::create(type, destination_dir, &impl);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+
+    *out_handle = new rac_archive_extractor{std::move(impl)};
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_archive_extractor_write(rac_archive_extractor_handle_t handle, const void* data,
+                                         size_t size) {
+    if (!handle || (!data && size > 0)) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    return handle->impl->write(data, size);
+}
+
+rac_result_t rac_archive_extractor_finish(rac_archive_extractor_handle_t handle) {
+    if (!handle) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    return handle->impl->finish();
+}
+
+void rac_archive_extractor_get_stats(rac_archive_extractor_handle_t handle,
+                                     int64_t* out_bytes_consumed, int64_t* out_bytes_extracted,
+                                     int32_t* out_files_extracted) {
+    if (!handle) {
+        return;
+    }
+    if (out_bytes_consumed) {
+        *out_bytes_consumed = handle->impl->bytes_consumed();
+    }
+    if (out_bytes_extracted) {
+        *out_bytes_extracted = handle->impl->bytes_extracted();
+    }
+    if (out_files_extracted) {
+        *out_files_extracted = handle->impl->files_extracted();
+    }
+}
+
+void rac_archive_extractor_destroy(rac_archive_extractor_handle_t handle) {
+    delete handle;
+}
+
+rac_result_t rac_archive_extract_file(const char* archive_path, rac_archive_type_t type,
+                                      const char* destination_dir,
+                                      rac_extract_progress_callback_fn progress_callback,
+                                      void* callback_user_data) {
+    if (!archive_path || !destination_dir) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::unique_ptr<rac_internal::StreamingExtractor> extractor;
+    rac_result_t result = rac_internal::StreamingExtractor::create(type, destination_dir, &extractor);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+
+    FILE* file = std::fopen(archive_path, "rb");
+    if (!file) {
+        RAC_LOG_ERROR("StreamingExtract", "Cannot open archive %s", archive_path);
+        return RAC_ERROR_FILE_NOT_FOUND;
+    }
+
+    std::vector<char> buffer(1024 * 1024);
+    int32_t reported = 0;
+    size_t n;
+    while ((n = std::fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        result = extractor->write(buffer.data(), n);
+        if (result != RAC_SUCCESS) {
+            break;
+        }
+        const int32_t files = extractor->files_extracted();
+        if (progress_callback && files != reported) {
+            reported = files;
+            progress_callback(files, 0, callback_user_data);
+        }
+    }
+    if (result == RAC_SUCCESS && std::ferror(file)) {
+        result = RAC_ERROR_FILE_READ_FAILED;
+    }
+    std::fclose(file);
+
+    if (result == RAC_SUCCESS) {
+        result = extractor->finish();
+    }
+    if (result == RAC_SUCCESS && progress_callback) {
+        const int32_t files = extractor->files_extracted();
+        progress_callback(files, files, callback_user_data);
+    }
+    return result;
+}
+
+}  // extern "C"
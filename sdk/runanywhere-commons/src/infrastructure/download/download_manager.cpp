@@ -9,9 +9,15 @@
  *
  * NOTE: The actual HTTP download is delegated to the platform adapter (Swift/Kotlin).
  * This C layer handles orchestration: progress tracking, state management, retry logic.
+ * Without an adapter http_download callback the manager runs the transfer itself
+ * with the native downloader.
  */
 
+#include <algorithm>
 #include <atomic>
+#include <cctype>
+#include <condition_variable>
+#include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <map>
@@ -19,10 +25,15 @@
 #include <string>
 #include <vector>
 
+#include "infrastructure/download/sha256.h"
+#include "rac/core/rac_error.h"
 #include "rac/core/rac_logger.h"
 #include "rac/core/rac_platform_adapter.h"
 #include "rac/core/rac_structured_error.h"
+#include "rac/infrastructure/download/rac_archive_extract.h"
 #include "rac/infrastructure/download/rac_download.h"
+#include "rac/infrastructure/download/rac_native_download.h"
+#include "rac/infrastructure/model_management/rac_model_types.h"
 
 // =============================================================================
 // INTERNAL STRUCTURES
@@ -45,6 +56,14 @@ struct download_task_internal {
     std::string downloaded_file_path;
     std::string error_message;
     int64_t start_time_ms;
+
+    // Lowercase hex SHA-256 of the downloaded file; empty to skip verification
+    std::string expected_sha256;
+
+    // Native downloader task, when the manager runs the download itself
+    std::string native_task_id;
+    // Whether that task extracts the archive while it downloads
+    bool native_extracts = false;
 };
 
 struct rac_download_manager {
@@ -63,6 +82,16 @@ struct rac_download_manager {
     // Health state
     bool is_healthy;
     bool is_paused;
+
+    // Native downloads whose completion callback has not run yet
+    int native_in_flight;
+    std::condition_variable native_done;
+};
+
+// Passed to the native downloader callbacks
+struct native_download_context {
+    rac_download_manager* manager;
+    std::string task_id;
 };
 
 // Note: rac_strdup is declared in rac_types.h and implemented in rac_memory.cpp
@@ -110,6 +139,231 @@ static void notify_complete(download_task_internal& task, rac_result_t result,
     }
 }
 
+static bool is_terminal(rac_download_state_t state) {
+    return state == RAC_DOWNLOAD_STATE_COMPLETED || state == RAC_DOWNLOAD_STATE_FAILED ||
+           state == RAC_DOWNLOAD_STATE_CANCELLED;
+}
+
+// Lowercase hex SHA-256 of a file, or empty if it cannot be read
+static std::string sha256_of_file(const std::string& path) {
+    FILE* file = fopen(path.c_str(), "rb");
+    if (!file) {
+        return "";
+    }
+    rac_internal::Sha256 hash;
+    std::vector<char> buffer(1024 * 1024);
+    size_t read = 0;
+    while ((read = fread(buffer.data(), 1, buffer.size(), file)) > 0) {
+        hash.update(buffer.data(), read);
+    }
+    const bool ok = !ferror(file);
+    fclose(file);
+    return ok ? hash.finish_hex() : "";
+}
+
+static void apply_download_progress(download_task_internal& task, int64_t bytes_downloaded,
+                                    int64_t total_bytes) {
+    task.progress.state = RAC_DOWNLOAD_STATE_DOWNLOADING;
+    task.progress.stage = RAC_DOWNLOAD_STAGE_DOWNLOADING;
+    task.progress.bytes_downloaded = bytes_downloaded;
+    task.progress.total_bytes = total_bytes;
+
+    if (total_bytes > 0) {
+        task.progress.stage_progress =
+            static_cast<double>(bytes_downloaded) / static_cast<double>(total_bytes);
+    } else {
+        task.progress.stage_progress = 0.0;
+    }
+
+    task.progress.overall_progress =
+        calculate_overall_progress(task.progress.stage, task.progress.stage_progress);
+
+    // Calculate speed
+    int64_t elapsed_ms = rac_get_current_time_ms() - task.start_time_ms;
+    if (elapsed_ms > 0) {
+        task.progress.speed =
+            static_cast<double>(bytes_downloaded) / (static_cast<double>(elapsed_ms) / 1000.0);
+
+        // Calculate ETA
+        if (task.progress.speed > 0 && total_bytes > bytes_downloaded) {
+            int64_t remaining_bytes = total_bytes - bytes_downloaded;
+            task.progress.estimated_time_remaining =
+                static_cast<double>(remaining_bytes) / task.progress.speed;
+        }
+    }
+
+    notify_progress(task);
+}
+
+// Downloaded file accepted: extract next, or finish
+static void finish_download(download_task_internal& task, const char* downloaded_path) {
+    task.downloaded_file_path = downloaded_path;
+
+    if (task.requires_extraction) {
+        // Move to extraction stage
+        task.progress.state = RAC_DOWNLOAD_STATE_EXTRACTING;
+        task.progress.stage = RAC_DOWNLOAD_STAGE_EXTRACTING;
+        task.progress.stage_progress = 0.0;
+        task.progress.overall_progress =
+            calculate_overall_progress(RAC_DOWNLOAD_STAGE_EXTRACTING, 0.0);
+        notify_progress(task);
+
+        // Note: Platform adapter should call extract_archive and then call
+        // rac_download_manager_mark_extraction_complete
+    } else {
+        // No extraction needed, mark as complete
+        task.progress.state = RAC_DOWNLOAD_STATE_COMPLETED;
+        task.progress.stage = RAC_DOWNLOAD_STAGE_COMPLETED;
+        task.progress.stage_progress = 1.0;
+        task.progress.overall_progress = 1.0;
+        notify_progress(task);
+        notify_complete(task, RAC_SUCCESS, downloaded_path);
+    }
+
+    RAC_LOG_INFO("DownloadManager", "Download completed");
+}
+
+static void fail_download(rac_download_manager* mgr, download_task_internal& task,
+                          rac_result_t error_code, const char* error_message, bool can_retry) {
+    // Check if we should retry
+    if (can_retry && task.progress.retry_attempt < mgr->config.max_retry_attempts) {
+        task.progress.retry_attempt++;
+        task.progress.state = RAC_DOWNLOAD_STATE_RETRYING;
+        task.progress.error_code = error_code;
+        if (error_message) {
+            task.error_message = error_message;
+            task.progress.error_message = task.error_message.c_str();
+        }
+        notify_progress(task);
+
+        RAC_LOG_WARNING("DownloadManager", "Download failed, will retry");
+
+        // Note: Platform adapter should retry after delay
+    } else {
+        // Max retries reached, mark as failed
+        task.progress.state = RAC_DOWNLOAD_STATE_FAILED;
+        task.progress.error_code = error_code;
+        if (error_message) {
+            task.error_message = error_message;
+            task.progress.error_message = task.error_message.c_str();
+        }
+        notify_progress(task);
+        notify_complete(task, error_code, nullptr);
+
+        RAC_LOG_ERROR("DownloadManager", "Download failed after all retries");
+    }
+}
+
+// =============================================================================
+// NATIVE DOWNLOADS (no platform http_download)
+// =============================================================================
+
+static bool uses_native_downloader() {
+    const rac_platform_adapter_t* adapter = rac_get_platform_adapter();
+    return (adapter == nullptr || adapter->http_download == nullptr) &&
+           rac_native_download_is_available() == RAC_TRUE;
+}
+
+static void native_download_progress(int64_t bytes_downloaded, int64_t total_bytes,
+                                     void* user_data) {
+    auto* context = static_cast<native_download_context*>(user_data);
+    std::lock_guard<std::mutex> lock(context->manager->mutex);
+
+    auto it = context->manager->tasks.find(context->task_id);
+    if (it != context->manager->tasks.end() && !is_terminal(it->second.progress.state)) {
+        apply_download_progress(it->second, bytes_downloaded, total_bytes);
+    }
+}
+
+// Progress of a streaming extraction: the whole transfer is the extraction stage
+static void native_extract_progress(const rac_download_progress_t* progress, void* user_data) {
+    if (progress->stage == RAC_DOWNLOAD_STAGE_COMPLETED) {
+        return;  // Reported by native_download_complete
+    }
+    auto* context = static_cast<native_download_context*>(user_data);
+    std::lock_guard<std::mutex> lock(context->manager->mutex);
+
+    auto it = context->manager->tasks.find(context->task_id);
+    if (it == context->manager->tasks.end() || is_terminal(it->second.progress.state)) {
+        return;
+    }
+    download_task_internal& task = it->second;
+    task.progress.state = RAC_DOWNLOAD_STATE_EXTRACTING;
+    task.progress.stage = RAC_DOWNLOAD_STAGE_EXTRACTING;
+    task.progress.bytes_downloaded = progress->bytes_downloaded;
+    task.progress.total_bytes = progress->total_bytes;
+    task.progress.stage_progress = progress->stage_progress;
+    task.progress.overall_progress = progress->overall_progress;
+    task.progress.speed = progress->speed;
+    task.progress.estimated_time_remaining = progress->estimated_time_remaining;
+    notify_progress(task);
+}
+
+static void native_download_complete(rac_result_t result, const char* downloaded_path,
+                                     void* user_data) {
+    auto* context = static_cast<native_download_context*>(user_data);
+    rac_download_manager* mgr = context->manager;
+    {
+        std::lock_guard<std::mutex> lock(mgr->mutex);
+
+        auto it = mgr->tasks.find(context->task_id);
+        if (it != mgr->tasks.end()) {
+            it->second.native_task_id.clear();
+        }
+        if (it != mgr->tasks.end() && !is_terminal(it->second.progress.state)) {
+            download_task_internal& task = it->second;
+            if (result == RAC_SUCCESS) {
+                if (task.native_extracts) {
+                    // Already extracted into the destination directory
+                    task.requires_extraction = false;
+                }
+                finish_download(task, downloaded_path);
+            } else {
+                // The native downloader already retried dropped connections
+                fail_download(mgr, task, result, rac_error_message(result), false);
+            }
+        }
+
+        mgr->native_in_flight--;
+        mgr->native_done.notify_all();
+    }
+    delete context;
+}
+
+// Caller holds mgr->mutex
+static rac_result_t start_native_download(rac_download_manager* mgr,
+                                          download_task_internal& task) {
+    rac_native_download_options_t options = RAC_NATIVE_DOWNLOAD_OPTIONS_DEFAULT;
+    options.expected_sha256 = task.expected_sha256.empty() ? nullptr : task.expected_sha256.c_str();
+
+    // Tar archives are extracted while they download and never stored
+    rac_archive_type_t archive_type;
+    const bool extract = task.requires_extraction &&
+                         rac_archive_type_from_path(task.url.c_str(), &archive_type) &&
+                         rac_archive_extractor_supports(archive_type);
+
+    auto* context = new native_download_context{mgr, task.task_id};
+    char* native_task_id = nullptr;
+    rac_result_t result =
+        extract ? rac_native_download_extract_start(task.url.c_str(), task.destination_path.c_str(),
+                                                    archive_type, &options, native_extract_progress,
+                                                    native_download_complete, context,
+                                                    &native_task_id)
+                : rac_native_download_start(task.url.c_str(), task.destination_path.c_str(),
+                                            &options, native_download_progress,
+                                            native_download_complete, context, &native_task_id);
+    if (result != RAC_SUCCESS) {
+        delete context;
+        return result;
+    }
+
+    task.native_extracts = extract;
+    task.native_task_id = native_task_id;
+    rac_free(native_task_id);
+    mgr->native_in_flight++;
+    return RAC_SUCCESS;
+}
+
 // =============================================================================
 // PUBLIC API - LIFECYCLE
 // =============================================================================
@@ -132,6 +386,7 @@ rac_result_t rac_download_manager_create(const rac_download_config_t* config,
     mgr->task_counter = 1;
     mgr->is_healthy = true;
     mgr->is_paused = false;
+    mgr->native_in_flight = 0;
 
     RAC_LOG_INFO("DownloadManager", "Download manager created");
 
@@ -146,15 +401,22 @@ void rac_download_manager_destroy(rac_download_manager_handle_t handle) {
 
     // Cancel any active downloads
     {
-        std::lock_guard<std::mutex> lock(handle->mutex);
+        std::unique_lock<std::mutex> lock(handle->mutex);
         for (auto& pair : handle->tasks) {
             download_task_internal& task = pair.second;
+            if (!task.native_task_id.empty()) {
+                rac_native_download_cancel(task.native_task_id.c_str());
+            }
             if (task.progress.state == RAC_DOWNLOAD_STATE_DOWNLOADING ||
-                task.progress.state == RAC_DOWNLOAD_STATE_EXTRACTING) {
+                task.progress.state == RAC_DOWNLOAD_STATE_EXTRACTING ||
+                (!task.native_task_id.empty() && !is_terminal(task.progress.state))) {
                 task.progress.state = RAC_DOWNLOAD_STATE_CANCELLED;
                 notify_complete(task, RAC_ERROR_CANCELLED, nullptr);
             }
         }
+
+        // Native callbacks reference the manager until they have run
+        handle->native_done.wait(lock, [handle] { return handle->native_in_flight == 0; });
     }
 
     delete handle;
@@ -171,6 +433,16 @@ rac_result_t rac_download_manager_start(rac_download_manager_handle_t handle, co
                                         rac_download_progress_callback_fn progress_callback,
                                         rac_download_complete_callback_fn complete_callback,
                                         void* user_data, char** out_task_id) {
+    return rac_download_manager_start_verified(handle, model_id, url, destination_path,
+                                               requires_extraction, nullptr, progress_callback,
+                                               complete_callback, user_data, out_task_id);
+}
+
+rac_result_t rac_download_manager_start_verified(
+    rac_download_manager_handle_t handle, const char* model_id, const char* url,
+    const char* destination_path, rac_bool_t requires_extraction, const char* expected_sha256,
+    rac_download_progress_callback_fn progress_callback,
+    rac_download_complete_callback_fn complete_callback, void* user_data, char** out_task_id) {
     if (!handle || !model_id || !url || !destination_path || !out_task_id) {
         return RAC_ERROR_INVALID_ARGUMENT;
     }
@@ -197,20 +469,33 @@ rac_result_t rac_download_manager_start(rac_download_manager_handle_t handle, co
     task.complete_callback = complete_callback;
     task.user_data = user_data;
     task.start_time_ms = rac_get_current_time_ms();
+    if (expected_sha256) {
+        task.expected_sha256 = expected_sha256;
+        std::transform(task.expected_sha256.begin(), task.expected_sha256.end(),
+                       task.expected_sha256.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    }
 
     handle->tasks[task_id] = std::move(task);
+    download_task_internal& stored_task = handle->tasks[task_id];
+
+    // Note: With a platform http_download the adapter triggers the actual HTTP
+    // download and this function just creates the tracking state
+    if (uses_native_downloader()) {
+        rac_result_t result = start_native_download(handle, stored_task);
+        if (result != RAC_SUCCESS) {
+            handle->tasks.erase(task_id);
+            return result;
+        }
+    }
 
     *out_task_id = rac_strdup(task_id.c_str());
 
     RAC_LOG_INFO("DownloadManager", "Started download task");
 
     // Notify initial progress
-    download_task_internal& stored_task = handle->tasks[task_id];
     notify_progress(stored_task);
 
-    // Note: Actual HTTP download is triggered by platform adapter
-    // This function just creates the tracking state
-
     return RAC_SUCCESS;
 }
 
@@ -236,6 +521,10 @@ rac_result_t rac_download_manager_cancel(rac_download_manager_handle_t handle,
         return RAC_SUCCESS;
     }
 
+    if (!task.native_task_id.empty()) {
+        rac_native_download_cancel(task.native_task_id.c_str());
+    }
+
     task.progress.state = RAC_DOWNLOAD_STATE_CANCELLED;
     notify_progress(task);
     notify_complete(task, RAC_ERROR_CANCELLED, nullptr);
@@ -356,39 +645,7 @@ rac_result_t rac_download_manager_update_progress(rac_download_manager_handle_t
         return RAC_ERROR_NOT_FOUND;
     }
 
-    download_task_internal& task = it->second;
-
-    // Update progress
-    task.progress.state = RAC_DOWNLOAD_STATE_DOWNLOADING;
-    task.progress.stage = RAC_DOWNLOAD_STAGE_DOWNLOADING;
-    task.progress.bytes_downloaded = bytes_downloaded;
-    task.progress.total_bytes = total_bytes;
-
-    if (total_bytes > 0) {
-        task.progress.stage_progress =
-            static_cast<double>(bytes_downloaded) / static_cast<double>(total_bytes);
-    } else {
-        task.progress.stage_progress = 0.0;
-    }
-
-    task.progress.overall_progress =
-        calculate_overall_progress(task.progress.stage, task.progress.stage_progress);
-
-    // Calculate speed
-    int64_t elapsed_ms = rac_get_current_time_ms() - task.start_time_ms;
-    if (elapsed_ms > 0) {
-        task.progress.speed =
-            static_cast<double>(bytes_downloaded) / (static_cast<double>(elapsed_ms) / 1000.0);
-
-        // Calculate ETA
-        if (task.progress.speed > 0 && total_bytes > bytes_downloaded) {
-            int64_t remaining_bytes = total_bytes - bytes_downloaded;
-            task.progress.estimated_time_remaining =
-                static_cast<double>(remaining_bytes) / task.progress.speed;
-        }
-    }
-
-    notify_progress(task);
+    apply_download_progress(it->second, bytes_downloaded, total_bytes);
 
     return RAC_SUCCESS;
 }
@@ -399,6 +656,20 @@ rac_result_t rac_download_manager_mark_complete(rac_download_manager_handle_t ha
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
+    std::string expected_sha256;
+    {
+        std::lock_guard<std::mutex> lock(handle->mutex);
+        auto it = handle->tasks.find(task_id);
+        if (it == handle->tasks.end()) {
+            return RAC_ERROR_NOT_FOUND;
+        }
+        expected_sha256 = it->second.expected_sha256;
+    }
+
+    // Hash without holding the lock; a large model takes seconds
+    const bool verified =
+        expected_sha256.empty() || sha256_of_file(downloaded_path) == expected_sha256;
+
     std::lock_guard<std::mutex> lock(handle->mutex);
 
     auto it = handle->tasks.find(task_id);
@@ -407,30 +678,14 @@ rac_result_t rac_download_manager_mark_complete(rac_download_manager_handle_t ha
     }
 
     download_task_internal& task = it->second;
-    task.downloaded_file_path = downloaded_path;
-
-    if (task.requires_extraction) {
-        // Move to extraction stage
-        task.progress.state = RAC_DOWNLOAD_STATE_EXTRACTING;
-        task.progress.stage = RAC_DOWNLOAD_STAGE_EXTRACTING;
-        task.progress.stage_progress = 0.0;
-        task.progress.overall_progress =
-            calculate_overall_progress(RAC_DOWNLOAD_STAGE_EXTRACTING, 0.0);
-        notify_progress(task);
-
-        // Note: Platform adapter should call extract_archive and then call
-        // rac_download_manager_mark_extraction_complete
-    } else {
-        // No extraction needed, mark as complete
-        task.progress.state = RAC_DOWNLOAD_STATE_COMPLETED;
-        task.progress.stage = RAC_DOWNLOAD_STAGE_COMPLETED;
-        task.progress.stage_progress = 1.0;
-        task.progress.overall_progress = 1.0;
-        notify_progress(task);
-        notify_complete(task, RAC_SUCCESS, downloaded_path);
+    if (!verified) {
+        RAC_LOG_ERROR("DownloadManager", "SHA-256 mismatch for downloaded file");
+        std::remove(downloaded_path);
+        fail_download(handle, task, RAC_ERROR_CHECKSUM_MISMATCH, "SHA-256 mismatch", true);
+        return RAC_ERROR_CHECKSUM_MISMATCH;
     }
 
-    RAC_LOG_INFO("DownloadManager", "Download completed");
+    finish_download(task, downloaded_path);
 
     return RAC_SUCCESS;
 }
@@ -449,35 +704,7 @@ rac_result_t rac_download_manager_mark_failed(rac_download_manager_handle_t hand
         return RAC_ERROR_NOT_FOUND;
     }
 
-    download_task_internal& task = it->second;
-
-    // Check if we should retry
-    if (task.progress.retry_attempt < handle->config.max_retry_attempts) {
-        task.progress.retry_attempt++;
-        task.progress.state = RAC_DOWNLOAD_STATE_RETRYING;
-        task.progress.error_code = error_code;
-        if (error_message) {
-            task.error_message = error_message;
-            task.progress.error_message = task.error_message.c_str();
-        }
-        notify_progress(task);
-
-        RAC_LOG_WARNING("DownloadManager", "Download failed, will retry");
-
-        // Note: Platform adapter should retry after delay
-    } else {
-        // Max retries reached, mark as failed
-        task.progress.state = RAC_DOWNLOAD_STATE_FAILED;
-        task.progress.error_code = error_code;
-        if (error_message) {
-            task.error_message = error_message;
-            task.progress.error_message = task.error_message.c_str();
-        }
-        notify_progress(task);
-        notify_complete(task, error_code, nullptr);
-
-        RAC_LOG_ERROR("DownloadManager", "Download failed after all retries");
-    }
+    fail_download(handle, it->second, error_code, error_message, true);
 
     return RAC_SUCCESS;
 }
@@ -0,0 +1,1263 @@
+/**
+ * @file native_downloader.cpp
+ * @brief Native HTTP downloader: parallel ranges, resume, streaming SHA-256
+ *
+ * A download runs as:
+ *   1. Probe: GET with "Range: bytes=0-0" for the size, range support and ETag
+ *      (HEAD is not used because presigned CDN URLs often reject it).
+ *   2. Plan: reuse the segments in `<dest>.part.json` if it matches the URL,
+ *      size and ETag; otherwise preallocate `<dest>.part` and split it.
+ *   3. Fetch: one thread per unfinished segment writes with pwrite at its
+ *      offset. The SHA-256 follows the contiguous written prefix, reading it
+ *      back from the page cache.
+ *   4. Finish: verify the digest, rename `.part` over the destination.
+ *
+ * The manifest is rewritten about once a second after an fdatasync, so the
+ * byte counts it records are always on disk. The hash state is saved with it
+ * (at a block boundary) so a resumed download does not rehash the prefix.
+ */
+
+#include "rac/infrastructure/download/rac_native_download.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rac/core/rac_logger.h"
+
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+#include <curl/curl.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <nlohmann/json.hpp>
+
+#include "infrastructure/download/sha256.h"
+#include "infrastructure/download/streaming_extractor.h"
+#endif
+
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+
+namespace {
+
+constexpr const char* kLogCategory = "NativeDownload";
+
+// Hash the written prefix once this much is pending
+constexpr int64_t kHashStepBytes = 1 << 20;
+constexpr auto kManifestInterval = std::chrono::seconds(1);
+constexpr auto kProgressInterval = std::chrono::milliseconds(100);
+
+void init_curl_once() {
+    static std::once_flag once;
+    std::call_once(once, [] { curl_global_init(CURL_GLOBAL_DEFAULT); });
+}
+
+bool iequals_prefix(const char* data, size_t size, const char* prefix) {
+    const size_t n = std::strlen(prefix);
+    if (size < n) {
+        return false;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (std::tolower(static_cast<unsigned char>(data[i])) != prefix[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string trim(std::string value) {
+    const size_t first = value.find_first_not_of(" \t\r\n");
+    const size_t last = value.find_last_not_of(" \t\r\n");
+    return first == std::string::npos ? "" : value.substr(first, last - first + 1);
+}
+
+bool is_retryable(long http_status) {
+    return http_status == 408 || http_status == 429 || http_status >= 500;
+}
+
+rac_result_t map_curl_error(CURLcode code) {
+    switch (code) {
+        case CURLE_COULDNT_RESOLVE_HOST:
+        case CURLE_COULDNT_RESOLVE_PROXY:
+        case CURLE_COULDNT_CONNECT:
+            return RAC_ERROR_NETWORK_UNAVAILABLE;
+        case CURLE_OPERATION_TIMEDOUT:
+            return RAC_ERROR_TIMEOUT;
+        case CURLE_PARTIAL_FILE:
+            return RAC_ERROR_PARTIAL_DOWNLOAD;
+        case CURLE_RECV_ERROR:
+        case CURLE_SEND_ERROR:
+        case CURLE_GOT_NOTHING:
+            return RAC_ERROR_CONNECTION_LOST;
+        default:
+            return RAC_ERROR_NETWORK_ERROR;
+    }
+}
+
+// =============================================================================
+// PROBE
+// =============================================================================
+
+struct ProbeResult {
+    rac_result_t result = RAC_SUCCESS;
+    int64_t total_size = -1;  // -1 if unknown
+    bool ranges = false;
+    std::string etag;
+    std::string effective_url;
+};
+
+size_t probe_header(char* data, size_t size, size_t count, void* user) {
+    auto* probe = static_cast<ProbeResult*>(user);
+    const size_t length = size * count;
+    if (iequals_prefix(data, length, "http/")) {
+        // New response (after a redirect): forget the previous headers
+        probe->etag.clear();
+        probe->total_size = -1;
+        probe->ranges = false;
+    } else if (iequals_prefix(data, length, "etag:")) {
+        probe->etag = trim(std::string(data + 5, length - 5));
+    } else if (iequals_prefix(data, length, "content-range:")) {
+        // "bytes 0-0/12345"
+        std::string value(data + 14, length - 14);
+        const size_t slash = value.find('/');
+        if (slash != std::string::npos && value.find('*', slash) == std::string::npos) {
+            probe->total_size = std::strtoll(value.c_str() + slash + 1, nullptr, 10);
+        }
+    }
+    return length;
+}
+
+// Headers are all we need; stop before a server that ignored Range sends everything
+size_t abort_body(char*, size_t, size_t, void*) {
+    return 0;
+}
+
+ProbeResult probe_url(const std::string& url, int stall_timeout) {
+    ProbeResult probe;
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        probe.result = RAC_ERROR_OUT_OF_MEMORY;
+        return probe;
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_RANGE, "0-0");
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, probe_header);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &probe);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, abort_body);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(stall_timeout));
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(stall_timeout));
+
+    const CURLcode code = curl_easy_perform(curl);
+    long status = 0;
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+
+    if (code != CURLE_OK && code != CURLE_WRITE_ERROR) {
+        RAC_LOG_ERROR(kLogCategory, "Probe failed for %s: %s", url.c_str(),
+                      curl_easy_strerror(code));
+        probe.result = map_curl_error(code);
+    } else if (status == 206) {
+        probe.ranges = probe.total_size >= 0;
+    } else if (status == 200) {
+        // Range ignored: one plain stream
+        curl_off_t length = -1;
+        curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD_T, &length);
+        probe.total_size = length;
+        probe.ranges = false;
+    } else {
+        RAC_LOG_ERROR(kLogCategory, "Probe for %s returned HTTP %ld", url.c_str(), status);
+        probe.result = RAC_ERROR_HTTP_ERROR;
+    }
+
+    char* effective = nullptr;
+    curl_easy_getinfo(curl, CURLINFO_EFFECTIVE_URL, &effective);
+    probe.effective_url = effective ? effective : url;
+
+    curl_easy_cleanup(curl);
+    return probe;
+}
+
+// =============================================================================
+// DOWNLOAD
+// =============================================================================
+
+struct Segment {
+    int64_t start = 0;
+    int64_t end = -1;  // Exclusive; -1 while the size is unknown
+    std::atomic<int64_t> written{0};
+    std::atomic<bool> done{false};
+    std::atomic<rac_result_t> result{RAC_SUCCESS};
+};
+
+class Download {
+public:
+    Download(std::string url, std::string destination, const rac_native_download_options_t& options,
+             rac_http_progress_callback_fn progress_callback, void* user_data,
+             std::shared_ptr<std::atomic<bool>> cancelled)
+        : url_(std::move(url)),
+          destination_(std::move(destination)),
+          part_path_(destination_ + ".part"),
+          manifest_path_(destination_ + ".part.json"),
+          options_(options),
+          expected_sha256_(options.expected_sha256 ? options.expected_sha256 : ""),
+          progress_callback_(progress_callback),
+          user_data_(user_data),
+          cancelled_(std::move(cancelled)) {
+        std::transform(expected_sha256_.begin(), expected_sha256_.end(), expected_sha256_.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    }
+
+    ~Download() {
+        if (fd_ >= 0) {
+            ::close(fd_);
+        }
+    }
+
+    rac_result_t run();
+
+private:
+    struct Request {
+        Download* download;
+        Segment* segment;
+        CURL* curl;
+        bool checked_status = false;
+        rac_result_t error = RAC_SUCCESS;
+    };
+
+    rac_result_t plan(const ProbeResult& probe);
+    bool load_manifest(const ProbeResult& probe);
+    void save_manifest();
+    rac_result_t open_part(bool truncate);
+
+    void fetch_segment(Segment* segment);
+    rac_result_t fetch_once(Segment* segment, long& http_status);
+    static size_t on_body(char* data, size_t size, size_t count, void* user);
+    static int on_progress(void* user, curl_off_t, curl_off_t, curl_off_t, curl_off_t);
+
+    void advance_hash(bool final);
+    int64_t contiguous_bytes() const;
+    int64_t downloaded_bytes() const;
+    void report_progress(bool force);
+
+    std::string url_;
+    std::string fetch_url_;
+    std::string destination_;
+    std::string part_path_;
+    std::string manifest_path_;
+    rac_native_download_options_t options_;
+    std::string expected_sha256_;
+    rac_http_progress_callback_fn progress_callback_;
+    void* user_data_;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+
+    int fd_ = -1;
+    int64_t total_size_ = -1;
+    bool ranges_ = false;
+    std::string etag_;
+    std::vector<std::unique_ptr<Segment>> segments_;
+
+    std::mutex hash_mutex_;
+    rac_internal::Sha256 hash_;
+    int64_t hashed_ = 0;
+
+    std::chrono::steady_clock::time_point last_progress_;
+};
+
+rac_result_t Download::open_part(bool truncate) {
+    int flags = O_RDWR | O_CREAT;
+    if (truncate) {
+        flags |= O_TRUNC;
+    }
+    fd_ = ::open(part_path_.c_str(), flags, 0644);
+    if (fd_ < 0) {
+        RAC_LOG_ERROR(kLogCategory, "Cannot open %s: %s", part_path_.c_str(), strerror(errno));
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    return RAC_SUCCESS;
+}
+
+bool Download::load_manifest(const ProbeResult& probe) {
+    FILE* file = std::fopen(manifest_path_.c_str(), "rb");
+    if (!file) {
+        return false;
+    }
+    std::string text;
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        text.append(buffer, n);
+    }
+    std::fclose(file);
+
+    struct stat st;
+    if (stat(part_path_.c_str(), &st) != 0 || st.st_size != probe.total_size) {
+        return false;
+    }
+
+    try {
+        const auto manifest = nlohmann::json::parse(text);
+        if (manifest.at("url").get<std::string>() != url_ ||
+            manifest.at("size").get<int64_t>() != probe.total_size ||
+            manifest.value("etag", "") != probe.etag) {
+            return false;
+        }
+
+        std::vector<std::unique_ptr<Segment>> segments;
+        for (const auto& entry : manifest.at("segments")) {
+            auto segment = std::make_unique<Segment>();
+            segment->start = entry.at(0).get<int64_t>();
+            segment->end = entry.at(1).get<int64_t>();
+            const int64_t written = entry.at(2).get<int64_t>();
+            if (segment->start < 0 || segment->end > probe.total_size ||
+                written > segment->end - segment->start || written < 0) {
+                return false;
+            }
+            segment->written = written;
+            segment->done = segment->start + written == segment->end;
+            segments.push_back(std::move(segment));
+        }
+
+        if (!expected_sha256_.empty() && manifest.contains("sha256")) {
+            const auto& saved = manifest.at("sha256");
+            std::array<uint32_t, 8> state;
+            for (size_t i = 0; i < state.size(); ++i) {
+                state[i] = saved.at("state").at(i).get<uint32_t>();
+            }
+            const int64_t offset = saved.at("offset").get<int64_t>();
+            if (hash_.restore(state, static_cast<uint64_t>(offset))) {
+                hashed_ = offset;
+            }
+        }
+
+        segments_ = std::move(segments);
+    } catch (const std::exception& e) {
+        RAC_LOG_WARNING(kLogCategory, "Ignoring unreadable manifest %s: %s",
+                        manifest_path_.c_str(), e.what());
+        return false;
+    }
+
+    // Hashed prefix must still be covered by written data
+    if (hashed_ > contiguous_bytes()) {
+        hash_ = rac_internal::Sha256();
+        hashed_ = 0;
+    }
+    return true;
+}
+
+void Download::save_manifest() {
+    if (!ranges_) {
+        return;  // Nothing to resume from
+    }
+
+    nlohmann::json manifest;
+    manifest["url"] = url_;
+    manifest["size"] = total_size_;
+    manifest["etag"] = etag_;
+    nlohmann::json segments = nlohmann::json::array();
+    for (const auto& segment : segments_) {
+        segments.push_back({segment->start, segment->end, segment->written.load()});
+    }
+    manifest["segments"] = std::move(segments);
+
+    if (!expected_sha256_.empty()) {
+        std::lock_guard<std::mutex> lock(hash_mutex_);
+        manifest["sha256"] = {{"offset", hashed_}, {"state", hash_.state()}};
+    }
+
+    // Counts above were read before the sync, so they are all on disk
+#if defined(__APPLE__)
+    fsync(fd_);
+#else
+    fdatasync(fd_);
+#endif
+
+    const std::string tmp_path = manifest_path_ + ".tmp";
+    FILE* file = std::fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+        return;
+    }
+    const std::string text = manifest.dump();
+    const bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    std::fclose(file);
+    if (ok) {
+        std::rename(tmp_path.c_str(), manifest_path_.c_str());
+    } else {
+        std::remove(tmp_path.c_str());
+    }
+}
+
+rac_result_t Download::plan(const ProbeResult& probe) {
+    total_size_ = probe.total_size;
+    ranges_ = probe.ranges;
+    etag_ = probe.etag;
+    fetch_url_ = probe.effective_url;
+
+    if (ranges_ && load_manifest(probe)) {
+        RAC_LOG_INFO(kLogCategory, "Resuming %s at %lld of %lld bytes", destination_.c_str(),
+                     static_cast<long long>(downloaded_bytes()),
+                     static_cast<long long>(total_size_));
+        return open_part(false);
+    }
+
+    std::remove(manifest_path_.c_str());
+    rac_result_t result = open_part(true);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+
+    if (total_size_ > 0) {
+#if defined(__linux__)
+        const int error = posix_fallocate(fd_, 0, total_size_);
+        if (error == ENOSPC) {
+            return RAC_ERROR_INSUFFICIENT_STORAGE;
+        }
+        if (error != 0 && ftruncate(fd_, total_size_) != 0) {
+            return RAC_ERROR_FILE_WRITE_FAILED;
+        }
+#else
+        if (ftruncate(fd_, total_size_) != 0) {
+            return errno == ENOSPC ? RAC_ERROR_INSUFFICIENT_STORAGE : RAC_ERROR_FILE_WRITE_FAILED;
+        }
+#endif
+    }
+
+    int64_t connections = 1;
+    if (ranges_ && total_size_ > 0) {
+        const int64_t min_segment = std::max<int64_t>(options_.min_segment_bytes, 1);
+        connections = std::clamp<int64_t>(total_size_ / min_segment, 1,
+                                          std::max<int32_t>(options_.max_connections, 1));
+    }
+
+    const int64_t step = total_size_ > 0 ? total_size_ / connections : 0;
+    for (int64_t i = 0; i < connections; ++i) {
+        auto segment = std::make_unique<Segment>();
+        segment->start = i * step;
+        segment->end = i + 1 == connections ? total_size_ : (i + 1) * step;
+        segments_.push_back(std::move(segment));
+    }
+    return RAC_SUCCESS;
+}
+
+int64_t Download::contiguous_bytes() const {
+    int64_t frontier = 0;
+    for (const auto& segment : segments_) {
+        frontier = segment->start + segment->written.load(std::memory_order_acquire);
+        if (!segment->done.load(std::memory_order_acquire)) {
+            break;
+        }
+    }
+    return frontier;
+}
+
+int64_t Download::downloaded_bytes() const {
+    int64_t total = 0;
+    for (const auto& segment : segments_) {
+        total += segment->written.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Download::advance_hash(bool final) {
+    if (expected_sha256_.empty()) {
+        return;
+    }
+
+    std::unique_lock<std::mutex> lock(hash_mutex_, std::defer_lock);
+    if (final) {
+        lock.lock();
+    } else if (!lock.try_lock()) {
+        return;  // Another thread is hashing
+    }
+
+    int64_t frontier = contiguous_bytes();
+    if (!final) {
+        if (frontier - hashed_ < kHashStepBytes) {
+            return;
+        }
+        // Stop at a block boundary so the saved state can be resumed
+        frontier -= frontier % static_cast<int64_t>(rac_internal::Sha256::kBlockSize);
+    }
+
+    std::vector<char> buffer(static_cast<size_t>(std::min<int64_t>(kHashStepBytes, frontier - hashed_)));
+    while (hashed_ < frontier) {
+        const size_t want = static_cast<size_t>(std::min<int64_t>(buffer.size(), frontier - hashed_));
+        const ssize_t got = pread(fd_, buffer.data(), want, hashed_);
+        if (got <= 0) {
+            return;
+        }
+        hash_.update(buffer.data(), static_cast<size_t>(got));
+        hashed_ += got;
+    }
+}
+
+void Download::report_progress(bool force) {
+    if (!progress_callback_) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && now - last_progress_ < kProgressInterval) {
+        return;
+    }
+    last_progress_ = now;
+    progress_callback_(downloaded_bytes(), std::max<int64_t>(total_size_, 0), user_data_);
+}
+
+size_t Download::on_body(char* data, size_t size, size_t count, void* user) {
+    auto* request = static_cast<Request*>(user);
+    Segment* segment = request->segment;
+    const size_t length = size * count;
+
+    if (!request->checked_status) {
+        long status = 0;
+        curl_easy_getinfo(request->curl, CURLINFO_RESPONSE_CODE, &status);
+        const bool expect_partial = request->download->ranges_;
+        if ((expect_partial && status != 206) || (!expect_partial && status != 200)) {
+            RAC_LOG_ERROR(kLogCategory, "Unexpected HTTP %ld for range request", status);
+            request->error = RAC_ERROR_INVALID_RESPONSE;
+            return 0;
+        }
+        request->checked_status = true;
+    }
+
+    int64_t offset = segment->start + segment->written.load(std::memory_order_relaxed);
+    size_t usable = length;
+    if (segment->end >= 0) {
+        usable = static_cast<size_t>(std::min<int64_t>(usable, segment->end - offset));
+    }
+
+    size_t done = 0;
+    while (done < usable) {
+        const ssize_t n = pwrite(request->download->fd_, data + done, usable - done,
+                                 offset + static_cast<int64_t>(done));
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            request->error =
+                errno == ENOSPC ? RAC_ERROR_INSUFFICIENT_STORAGE : RAC_ERROR_FILE_WRITE_FAILED;
+            return 0;
+        }
+        done += static_cast<size_t>(n);
+    }
+    segment->written.fetch_add(static_cast<int64_t>(usable), std::memory_order_release);
+
+    request->download->advance_hash(false);
+    return length;
+}
+
+int Download::on_progress(void* user, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    auto* request = static_cast<Request*>(user);
+    return request->download->cancelled_->load() ? 1 : 0;
+}
+
+rac_result_t Download::fetch_once(Segment* segment, long& http_status) {
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    Request request{this, segment, curl};
+    const int64_t from = segment->start + segment->written.load();
+
+    curl_easy_setopt(curl, CURLOPT_URL, fetch_url_.c_str());
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, on_body);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &request);
+    curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, on_progress);
+    curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &request);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, static_cast<long>(options_.stall_timeout_seconds));
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, static_cast<long>(options_.stall_timeout_seconds));
+    curl_easy_setopt(curl, CURLOPT_BUFFERSIZE, 256L * 1024);
+
+    std::string range;
+    if (ranges_) {
+        range = std::to_string(from) + "-" + std::to_string(segment->end - 1);
+        curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+    }
+
+    const CURLcode code = curl_easy_perform(curl);
+    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &http_status);
+    curl_easy_cleanup(curl);
+
+    if (cancelled_->load()) {
+        return RAC_ERROR_CANCELLED;
+    }
+    if (request.error != RAC_SUCCESS) {
+        return request.error;
+    }
+    if (code != CURLE_OK) {
+        RAC_LOG_WARNING(kLogCategory, "Range %s of %s failed: %s", range.c_str(), url_.c_str(),
+                        curl_easy_strerror(code));
+        return map_curl_error(code);
+    }
+    if (http_status >= 400) {
+        return RAC_ERROR_HTTP_ERROR;
+    }
+    if (segment->end >= 0 && segment->start + segment->written.load() < segment->end) {
+        return RAC_ERROR_PARTIAL_DOWNLOAD;
+    }
+    return RAC_SUCCESS;
+}
+
+void Download::fetch_segment(Segment* segment) {
+    for (int attempt = 0;; ++attempt) {
+        long http_status = 0;
+        rac_result_t result = fetch_once(segment, http_status);
+        if (result == RAC_SUCCESS) {
+            if (segment->end < 0) {
+                segment->end = segment->start + segment->written.load();
+            }
+            segment->done.store(true, std::memory_order_release);
+            advance_hash(false);
+            return;
+        }
+
+        const bool retryable = ranges_ && result != RAC_ERROR_CANCELLED &&
+                               result != RAC_ERROR_INSUFFICIENT_STORAGE &&
+                               result != RAC_ERROR_FILE_WRITE_FAILED &&
+                               result != RAC_ERROR_INVALID_RESPONSE &&
+                               (result != RAC_ERROR_HTTP_ERROR || is_retryable(http_status));
+        if (!retryable || attempt >= options_.max_retries) {
+            segment->result = result;
+            return;
+        }
+
+        // Exponential backoff, interruptible by cancel
+        const auto delay = std::chrono::milliseconds(std::min(250 << std::min(attempt, 5), 8000));
+        const auto until = std::chrono::steady_clock::now() + delay;
+        while (std::chrono::steady_clock::now() < until) {
+            if (cancelled_->load()) {
+                segment->result = RAC_ERROR_CANCELLED;
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+}
+
+rac_result_t Download::run() {
+    init_curl_once();
+
+    const ProbeResult probe = probe_url(url_, options_.stall_timeout_seconds);
+    if (probe.result != RAC_SUCCESS) {
+        return probe.result;
+    }
+
+    rac_result_t result = plan(probe);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+
+    std::vector<std::thread> workers;
+    for (auto& segment : segments_) {
+        if (!segment->done) {
+            Segment* raw = segment.get();
+            workers.emplace_back([this, raw] { fetch_segment(raw); });
+        }
+    }
+
+    // Supervise: progress and periodic manifest saves
+    auto last_save = std::chrono::steady_clock::now();
+    report_progress(true);
+    while (true) {
+        bool running = false;
+        for (const auto& segment : segments_) {
+            if (!segment->done && segment->result == RAC_SUCCESS) {
+                running = true;
+            }
+        }
+        if (!running) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        report_progress(false);
+        if (std::chrono::steady_clock::now() - last_save >= kManifestInterval) {
+            save_manifest();
+            last_save = std::chrono::steady_clock::now();
+        }
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (const auto& segment : segments_) {
+        if (segment->result != RAC_SUCCESS) {
+            result = segment->result;
+            break;
+        }
+    }
+
+    if (result != RAC_SUCCESS) {
+        if (ranges_) {
+            save_manifest();  // Keep what we have for the next attempt
+        } else {
+            std::remove(part_path_.c_str());
+        }
+        return cancelled_->load() ? RAC_ERROR_CANCELLED : result;
+    }
+
+    if (!expected_sha256_.empty()) {
+        advance_hash(true);
+        const std::string actual = hash_.finish_hex();
+        if (actual != expected_sha256_) {
+            RAC_LOG_ERROR(kLogCategory, "SHA-256 mismatch for %s: expected %s, got %s",
+                          url_.c_str(), expected_sha256_.c_str(), actual.c_str());
+            std::remove(part_path_.c_str());
+            std::remove(manifest_path_.c_str());
+            return RAC_ERROR_CHECKSUM_MISMATCH;
+        }
+    }
+
+    ::close(fd_);
+    fd_ = -1;
+    if (std::rename(part_path_.c_str(), destination_.c_str()) != 0) {
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    std::remove(manifest_path_.c_str());
+
+    total_size_ = downloaded_bytes();
+    report_progress(true);
+    RAC_LOG_INFO(kLogCategory, "Downloaded %s (%lld bytes, %zu connections)",
+                 destination_.c_str(), static_cast<long long>(total_size_), segments_.size());
+    return RAC_SUCCESS;
+}
+
+// =============================================================================
+// DOWNLOAD AND EXTRACT
+// =============================================================================
+
+// Bounded hand-off between the network thread and the extracting thread
+class ChunkQueue {
+public:
+    explicit ChunkQueue(size_t limit) : limit_(limit) {}
+
+    bool push(const char* data, size_t size) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [&] { return bytes_ < limit_ || aborted_; });
+        if (aborted_) {
+            return false;
+        }
+        chunks_.emplace_back(data, size);
+        bytes_ += size;
+        not_empty_.notify_one();
+        return true;
+    }
+
+    bool pop(std::string* chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_empty_.wait(lock, [&] { return !chunks_.empty() || closed_ || aborted_; });
+        if (aborted_ || chunks_.empty()) {
+            return false;
+        }
+        *chunk = std::move(chunks_.front());
+        chunks_.pop_front();
+        bytes_ -= chunk->size();
+        not_full_.notify_one();
+        return true;
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closed_ = true;
+        not_empty_.notify_all();
+    }
+
+    void abort() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        aborted_ = true;
+        not_empty_.notify_all();
+        not_full_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable not_full_;
+    std::deque<std::string> chunks_;
+    size_t bytes_ = 0;
+    size_t limit_;
+    bool closed_ = false;
+    bool aborted_ = false;
+};
+
+// Decompressed output is written while the network keeps this much in flight
+constexpr size_t kPipelineBytes = 16 * 1024 * 1024;
+
+class ArchiveStream {
+public:
+    ArchiveStream(std::string url, const rac_native_download_options_t& options,
+                  rac_internal::StreamingExtractor* extractor,
+                  rac_download_progress_callback_fn progress_callback, void* user_data,
+                  std::shared_ptr<std::atomic<bool>> cancelled)
+        : url_(std::move(url)),
+          options_(options),
+          expected_sha256_(options.expected_sha256 ? options.expected_sha256 : ""),
+          extractor_(extractor),
+          progress_callback_(progress_callback),
+          user_data_(user_data),
+          cancelled_(std::move(cancelled)),
+          queue_(kPipelineBytes) {
+        std::transform(expected_sha256_.begin(), expected_sha256_.end(), expected_sha256_.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    }
+
+    rac_result_t run();
+
+private:
+    rac_result_t fetch(long& http_status);
+    static size_t on_body(char* data, size_t size, size_t count, void* user);
+    static int on_progress(void* user, curl_off_t, curl_off_t, curl_off_t, curl_off_t);
+    void report(rac_download_stage_t stage, bool force);
+
+    std::string url_;
+    std::string fetch_url_;
+    rac_native_download_options_t options_;
+    std::string expected_sha256_;
+    rac_internal::StreamingExtractor* extractor_;
+    rac_download_progress_callback_fn progress_callback_;
+    void* user_data_;
+    std::shared_ptr<std::atomic<bool>> cancelled_;
+
+    ChunkQueue queue_;
+    std::atomic<rac_result_t> extract_error_{RAC_SUCCESS};
+    rac_internal::Sha256 hash_;
+    CURL* curl_ = nullptr;
+    bool ranges_ = false;
+    bool checked_status_ = false;
+    int64_t received_ = 0;
+    int64_t total_size_ = -1;
+    std::chrono::steady_clock::time_point started_;
+    std::chrono::steady_clock::time_point last_progress_;
+};
+
+void ArchiveStream::report(rac_download_stage_t stage, bool force) {
+    if (!progress_callback_) {
+        return;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (!force && now - last_progress_ < kProgressInterval) {
+        return;
+    }
+    last_progress_ = now;
+
+    rac_download_progress_t progress = RAC_DOWNLOAD_PROGRESS_DEFAULT;
+    progress.stage = stage;
+    progress.bytes_downloaded = received_;
+    progress.total_bytes = std::max<int64_t>(total_size_, 0);
+
+    if (stage == RAC_DOWNLOAD_STAGE_COMPLETED) {
+        progress.state = RAC_DOWNLOAD_STATE_COMPLETED;
+        progress.stage_progress = 1.0;
+        progress.overall_progress = 1.0;
+    } else {
+        // Download and extraction run together, so extraction progress
+        // covers both stages' share of the overall range
+        progress.state = RAC_DOWNLOAD_STATE_EXTRACTING;
+        if (total_size_ > 0) {
+            progress.stage_progress = static_cast<double>(extractor_->bytes_consumed()) /
+                                      static_cast<double>(total_size_);
+        }
+        double start = 0.0;
+        double end = 0.0;
+        rac_download_stage_progress_range(RAC_DOWNLOAD_STAGE_EXTRACTING, &start, &end);
+        progress.overall_progress = progress.stage_progress * end;
+
+        const double seconds = std::chrono::duration<double>(now - started_).count();
+        if (seconds > 0) {
+            progress.speed = static_cast<double>(received_) / seconds;
+            if (progress.speed > 0 && total_size_ > received_) {
+                progress.estimated_time_remaining =
+                    static_cast<double>(total_size_ - received_) / progress.speed;
+            }
+        }
+    }
+    progress_callback_(&progress, user_data_);
+}
+
+size_t ArchiveStream::on_body(char* data, size_t size, size_t count, void* user) {
+    auto* stream = static_cast<ArchiveStream*>(user);
+    const size_t length = size * count;
+
+    if (!stream->checked_status_) {
+        long status = 0;
+        curl_easy_getinfo(stream->curl_, CURLINFO_RESPONSE_CODE, &status);
+        // A resumed request must continue exactly where the stream stopped
+        const bool expect_partial = stream->received_ > 0;
+        if (status >= 400 || (expect_partial ? status != 206 : status >= 300)) {
+            return 0;
+        }
+        stream->checked_status_ = true;
+    }
+
+    if (!stream->queue_.push(data, length)) {
+        return 0;  // Extraction failed
+    }
+    if (!stream->expected_sha256_.empty()) {
+        stream->hash_.update(data, length);
+    }
+    stream->received_ += static_cast<int64_t>(length);
+    return length;
+}
+
+int ArchiveStream::on_progress(void* user, curl_off_t, curl_off_t, curl_off_t, curl_off_t) {
+    auto* stream = static_cast<ArchiveStream*>(user);
+    stream->report(RAC_DOWNLOAD_STAGE_EXTRACTING, false);
+    return stream->cancelled_->load() ? 1 : 0;
+}
+
+rac_result_t ArchiveStream::fetch(long& http_status) {
+    curl_ = curl_easy_init();
+    if (!curl_) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    checked_status_ = false;
+
+    curl_easy_setopt(curl_, CURLOPT_URL, fetch_url_.c_str());
+    curl_easy_setopt(curl_, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl_, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl_, CURLOPT_WRITEFUNCTION, on_body);
+    curl_easy_setopt(curl_, CURLOPT_WRITEDATA, this);
+    curl_easy_setopt(curl_, CURLOPT_NOPROGRESS, 0L);
+    curl_easy_setopt(curl_, CURLOPT_XFERINFOFUNCTION, on_progress);
+    curl_easy_setopt(curl_, CURLOPT_XFERINFODATA, this);
+    curl_easy_setopt(curl_, CURLOPT_CONNECTTIMEOUT,
+                     static_cast<long>(options_.stall_timeout_seconds));
+    curl_easy_setopt(curl_, CURLOPT_LOW_SPEED_LIMIT, 1L);
+    curl_easy_setopt(curl_, CURLOPT_LOW_SPEED_TIME,
+                     static_cast<long>(options_.stall_timeout_seconds));
+    curl_easy_setopt(curl_, CURLOPT_BUFFERSIZE, 256L * 1024);
+
+    std::string range;
+    if (received_ > 0) {
+        range = std::to_string(received_) + "-";
+        curl_easy_setopt(curl_, CURLOPT_RANGE, range.c_str());
+    }
+
+    const CURLcode code = curl_easy_perform(curl_);
+    curl_easy_getinfo(curl_, CURLINFO_RESPONSE_CODE, &http_status);
+    curl_easy_cleanup(curl_);
+    curl_ = nullptr;
+
+    if (cancelled_->load()) {
+        return RAC_ERROR_CANCELLED;
+    }
+    if (extract_error_.load() != RAC_SUCCESS) {
+        return extract_error_.load();
+    }
+    if (http_status >= 400) {
+        return RAC_ERROR_HTTP_ERROR;
+    }
+    if (code == CURLE_WRITE_ERROR) {
+        return RAC_ERROR_INVALID_RESPONSE;  // Unexpected status for a resumed request
+    }
+    if (code != CURLE_OK) {
+        RAC_LOG_WARNING(kLogCategory, "Streaming %s failed at %lld bytes: %s", url_.c_str(),
+                        static_cast<long long>(received_), curl_easy_strerror(code));
+        return map_curl_error(code);
+    }
+    if (total_size_ > 0 && received_ < total_size_) {
+        return RAC_ERROR_PARTIAL_DOWNLOAD;
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t ArchiveStream::run() {
+    init_curl_once();
+    started_ = std::chrono::steady_clock::now();
+
+    const ProbeResult probe = probe_url(url_, options_.stall_timeout_seconds);
+    if (probe.result != RAC_SUCCESS) {
+        return probe.result;
+    }
+    fetch_url_ = probe.effective_url;
+    total_size_ = probe.total_size;
+    ranges_ = probe.ranges;
+
+    std::thread extracting([this] {
+        std::string chunk;
+        while (queue_.pop(&chunk)) {
+            const rac_result_t result = extractor_->write(chunk.data(), chunk.size());
+            if (result != RAC_SUCCESS) {
+                extract_error_.store(result);
+                queue_.abort();
+                return;
+            }
+        }
+    });
+
+    report(RAC_DOWNLOAD_STAGE_EXTRACTING, true);
+    rac_result_t result = RAC_SUCCESS;
+    for (int attempt = 0;; ++attempt) {
+        long http_status = 0;
+        result = fetch(http_status);
+        // Only range-capable servers can continue a half-consumed stream
+        const bool retryable = (ranges_ || received_ == 0) && result != RAC_SUCCESS &&
+                               result != RAC_ERROR_CANCELLED &&
+                               extract_error_.load() == RAC_SUCCESS &&
+                               result != RAC_ERROR_INVALID_RESPONSE &&
+                               (result != RAC_ERROR_HTTP_ERROR || is_retryable(http_status));
+        if (!retryable || attempt >= options_.max_retries) {
+            break;
+        }
+        std::this_thread::sleep_for(
+            std::chrono::milliseconds(std::min(250 << std::min(attempt, 5), 8000)));
+    }
+
+    if (result == RAC_SUCCESS) {
+        queue_.close();
+    } else {
+        queue_.abort();
+    }
+    extracting.join();
+    if (extract_error_.load() != RAC_SUCCESS) {
+        result = extract_error_.load();
+    }
+    if (result != RAC_SUCCESS) {
+        return result;  // The extractor discards its staging directory
+    }
+
+    if (!expected_sha256_.empty()) {
+        const std::string actual = hash_.finish_hex();
+        if (actual != expected_sha256_) {
+            RAC_LOG_ERROR(kLogCategory, "SHA-256 mismatch for %s: expected %s, got %s",
+                          url_.c_str(), expected_sha256_.c_str(), actual.c_str());
+            return RAC_ERROR_CHECKSUM_MISMATCH;
+        }
+    }
+
+    result = extractor_->finish();
+    if (result == RAC_SUCCESS) {
+        report(RAC_DOWNLOAD_STAGE_COMPLETED, true);
+        RAC_LOG_INFO(kLogCategory, "Streamed and extracted %s (%lld bytes, %d files)",
+                     url_.c_str(), static_cast<long long>(received_),
+                     extractor_->files_extracted());
+    }
+    return result;
+}
+
+rac_result_t download_and_extract(const std::string& url, const std::string& destination_dir,
+                                  rac_archive_type_t archive_type,
+                                  const rac_native_download_options_t& options,
+                                  rac_download_progress_callback_fn progress_callback,
+                                  void* user_data, std::shared_ptr<std::atomic<bool>> cancelled) {
+    std::unique_ptr<rac_internal::StreamingExtractor> extractor;
+    rac_result_t result =
+        rac_internal::StreamingExtractor::create(archive_type, destination_dir, &extractor);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+    ArchiveStream stream(url, options, extractor.get(), progress_callback, user_data,
+                         std::move(cancelled));
+    return stream.run();
+}
+
+// =============================================================================
+// ASYNC TASKS
+// =============================================================================
+
+std::mutex g_tasks_mutex;
+std::map<std::string, std::shared_ptr<std::atomic<bool>>> g_tasks;
+std::atomic<uint64_t> g_task_counter{0};
+
+using TaskJob = std::function<rac_result_t(const rac_native_download_options_t&,
+                                           std::shared_ptr<std::atomic<bool>>)>;
+
+rac_result_t start_task(TaskJob job, const rac_native_download_options_t* options,
+                        const std::string& result_path,
+                        rac_http_complete_callback_fn complete_callback, void* user_data,
+                        char** out_task_id) {
+    const std::string task_id = "native-download-" + std::to_string(g_task_counter.fetch_add(1));
+    auto cancelled = std::make_shared<std::atomic<bool>>(false);
+    {
+        std::lock_guard<std::mutex> lock(g_tasks_mutex);
+        g_tasks[task_id] = cancelled;
+    }
+
+    // Options are copied; the hash string must outlive the caller's buffer
+    rac_native_download_options_t copied = options ? *options : RAC_NATIVE_DOWNLOAD_OPTIONS_DEFAULT;
+    std::string expected = copied.expected_sha256 ? copied.expected_sha256 : "";
+
+    std::thread([=, job = std::move(job)]() mutable {
+        copied.expected_sha256 = expected.empty() ? nullptr : expected.c_str();
+        const rac_result_t result = job(copied, cancelled);
+        {
+            std::lock_guard<std::mutex> lock(g_tasks_mutex);
+            g_tasks.erase(task_id);
+        }
+        if (complete_callback) {
+            complete_callback(result, result == RAC_SUCCESS ? result_path.c_str() : nullptr,
+                              user_data);
+        }
+    }).detach();
+
+    *out_task_id = rac_strdup(task_id.c_str());
+    return RAC_SUCCESS;
+}
+
+}  // namespace
+
+#endif  // RAC_HAS_NATIVE_DOWNLOADER
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+extern "C" {
+
+rac_bool_t rac_native_download_is_available(void) {
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+    return RAC_TRUE;
+#else
+    return RAC_FALSE;
+#endif
+}
+
+rac_result_t rac_native_download_file(const char* url, const char* destination_path,
+                                      const rac_native_download_options_t* options,
+                                      rac_http_progress_callback_fn progress_callback,
+                                      void* callback_user_data) {
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+    if (!url || !destination_path) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    Download download(url, destination_path,
+                      options ? *options : RAC_NATIVE_DOWNLOAD_OPTIONS_DEFAULT, progress_callback,
+                      callback_user_data, std::make_shared<std::atomic<bool>>(false));
+    return download.run();
+#else
+    (void)url;
+    (void)destination_path;
+    (void)options;
+    (void)progress_callback;
+    (void)callback_user_data;
+    return RAC_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+rac_result_t rac_native_download_start(const char* url, const char* destination_path,
+                                       const rac_native_download_options_t* options,
+                                       rac_http_progress_callback_fn progress_callback,
+                                       rac_http_complete_callback_fn complete_callback,
+                                       void* callback_user_data, char** out_task_id) {
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+    if (!url || !destination_path || !out_task_id) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    return start_task(
+        [url = std::string(url), destination = std::string(destination_path), progress_callback,
+         callback_user_data](const rac_native_download_options_t& task_options,
+                             std::shared_ptr<std::atomic<bool>> cancelled) {
+            Download download(url, destination, task_options, progress_callback,
+                              callback_user_data, std::move(cancelled));
+            return download.run();
+        },
+        options, destination_path, complete_callback, callback_user_data, out_task_id);
+#else
+    (void)url;
+    (void)destination_path;
+    (void)options;
+    (void)progress_callback;
+    (void)complete_callback;
+    (void)callback_user_data;
+    (void)out_task_id;
+    return RAC_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+rac_result_t rac_native_download_extract(const char* url, const char* destination_dir,
+                                         rac_archive_type_t archive_type,
+                                         const rac_native_download_options_t* options,
+                                         rac_download_progress_callback_fn progress_callback,
+                                         void* callback_user_data) {
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+    if (!url || !destination_dir) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    return download_and_extract(url, destination_dir, archive_type,
+                                options ? *options : RAC_NATIVE_DOWNLOAD_OPTIONS_DEFAULT,
+                                progress_callback, callback_user_data,
+                                std::make_shared<std::atomic<bool>>(false));
+#else
+    (void)url;
+    (void)destination_dir;
+    (void)archive_type;
+    (void)options;
+    (void)progress_callback;
+    (void)callback_user_data;
+    return RAC_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+rac_result_t rac_native_download_extract_start(const char* url, const char* destination_dir,
+                                               rac_archive_type_t archive_type,
+                                               const rac_native_download_options_t* options,
+                                               rac_download_progress_callback_fn progress_callback,
+                                               rac_http_complete_callback_fn complete_callback,
+                                               void* callback_user_data, char** out_task_id) {
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+    if (!url || !destination_dir || !out_task_id) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    return start_task(
+        [url = std::string(url), destination = std::string(destination_dir), archive_type,
+         progress_callback, callback_user_data](const rac_native_download_options_t& task_options,
+                                                std::shared_ptr<std::atomic<bool>> cancelled) {
+            return download_and_extract(url, destination, archive_type, task_options,
+                                        progress_callback, callback_user_data,
+                                        std::move(cancelled));
+        },
+        options, destination_dir, complete_callback, callback_user_data, out_task_id);
+#else
+    (void)url;
+    (void)destination_dir;
+    (void)archive_type;
+    (void)options;
+    (void)progress_callback;
+    (void)complete_callback;
+    (void)callback_user_data;
+    (void)out_task_id;
+    return RAC_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+rac_result_t rac_native_download_cancel(const char* task_id) {
+#ifdef RAC_HAS_NATIVE_DOWNLOADER
+    if (!task_id) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    std::lock_guard<std::mutex> lock(g_tasks_mutex);
+    auto it = g_tasks.find(task_id);
+    if (it == g_tasks.end()) {
+        return RAC_ERROR_NOT_FOUND;
+    }
+    it->second->store(true);
+    return RAC_SUCCESS;
+#else
+    (void)task_id;
+    return RAC_ERROR_NOT_SUPPORTED;
+#endif
+}
+
+}  // extern "C"
@@ -0,0 +1,51 @@
+/**
+ * @file sha256.h
+ * @brief Incremental SHA-256 with a resumable state
+ *
+ * Used by the native downloader to verify files while they are written.
+ * At whole-block boundaries the state is eight words plus a byte count, so a
+ * partially hashed download can be saved and picked up after a restart.
+ */
+
+#ifndef RAC_SHA256_H
+#define RAC_SHA256_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace rac_internal {
+
+class Sha256 {
+public:
+    static constexpr size_t kBlockSize = 64;
+
+    Sha256();
+
+    void update(const void* data, size_t size);
+
+    /** Lowercase hex digest. The object must not be updated afterwards. */
+    std::string finish_hex();
+
+    /** Bytes hashed so far */
+    uint64_t size() const { return total_; }
+
+    /** Chaining state; only meaningful when size() is a multiple of kBlockSize */
+    const std::array<uint32_t, 8>& state() const { return h_; }
+
+    /** Restore a state saved at a block boundary */
+    bool restore(const std::array<uint32_t, 8>& state, uint64_t size);
+
+private:
+    void compress(const uint8_t* block);
+
+    std::array<uint32_t, 8> h_;
+    uint8_t buffer_[kBlockSize];
+    size_t buffered_ = 0;
+    uint64_t total_ = 0;
+};
+
+}  // namespace rac_internal
+
+#endif  // RAC_SHA256_H
@@ -0,0 +1,920 @@
+/**
+ * @file streaming_extractor.cpp
+ * @brief Push-based tar.gz / tar.bz2 / tar.xz extractor
+ *
+ * Layers, each fed by the one before it:
+ *   bytes -> Decompressor (zlib / bzip2 / liblzma) -> TarReader -> files
+ *
+ * TarReader understands ustar, GNU long names and pax path/size records,
+ * which covers archives written by GNU tar, bsdtar and Python's tarfile.
+ * Entries that would land outside the destination are rejected: paths are
+ * walked one component at a time without following symlinks, and every
+ * symlink must resolve inside the destination once the archive is done.
+ */
+
+#include "streaming_extractor.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef RAC_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef RAC_HAS_BZIP2
+#include <bzlib.h>
+#endif
+#ifdef RAC_HAS_LZMA
+#include <lzma.h>
+#endif
+
+#include "rac/core/rac_logger.h"
+
+namespace fs = std::filesystem;
+
+namespace rac_internal {
+
+namespace {
+
+constexpr const char* kLogCategory = "StreamingExtract";
+constexpr size_t kBlockSize = 512;
+constexpr size_t kOutputBufferSize = 256 * 1024;
+// Long names and pax records are small; anything bigger is not a model archive
+constexpr size_t kMaxMetadataSize = 1024 * 1024;
+
+bool is_zero_block(const uint8_t* block) {
+    return std::all_of(block, block + kBlockSize, [](uint8_t b) { return b == 0; });
+}
+
+// Octal, or base-256 (high bit set) for sizes above 8 GiB
+int64_t parse_number(const uint8_t* field, size_t length) {
+    if (field[0] & 0x80) {
+        int64_t value = field[0] & 0x7f;
+        for (size_t i = 1; i < length; ++i) {
+            value = (value << 8) | field[i];
+        }
+        return value;
+    }
+    int64_t value = 0;
+    size_t i = 0;
+    while (i < length && (field[i] == ' ' || field[i] == 0)) {
+        ++i;
+    }
+    for (; i < length && field[i] >= '0' && field[i] <= '7'; ++i) {
+        value = (value << 3) | (field[i] - '0');
+    }
+    return value;
+}
+
+std::string field_string(const uint8_t* field, size_t length) {
+    const auto* end = static_cast<const uint8_t*>(std::memchr(field, 0, length));
+    return std::string(reinterpret_cast<const char*>(field),
+                       end ? static_cast<size_t>(end - field) : length);
+}
+
+bool checksum_ok(const uint8_t* header) {
+    const int64_t expected = parse_number(header + 148, 8);
+    int64_t sum = 0;
+    for (size_t i = 0; i < kBlockSize; ++i) {
+        sum += (i >= 148 && i < 156) ? ' ' : header[i];
+    }
+    return sum == expected;
+}
+
+// Split into components, dropping "." and empty parts; false if it escapes
+bool normalize(const std::string& path, std::vector<std::string>* parts) {
+    if (path.empty() || path[0] == '/') {
+        return false;
+    }
+    size_t start = 0;
+    while (start <= path.size()) {
+        size_t end = path.find('/', start);
+        if (end == std::string::npos) {
+            end = path.size();
+        }
+        const std::string part = path.substr(start, end - start);
+        if (part == "..") {
+            if (parts->empty()) {
+                return false;
+            }
+            parts->pop_back();
+        } else if (!part.empty() && part != ".") {
+            parts->push_back(part);
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+std::string join(const std::vector<std::string>& parts) {
+    std::string result;
+    for (const auto& part : parts) {
+        if (!result.empty()) {
+            result += '/';
+        }
+        result += part;
+    }
+    return result;
+}
+
+}  // namespace
+
+// =============================================================================
+// TAR READER
+// =============================================================================
+
+class TarReader {
+public:
+    explicit TarReader(std::string root) : root_(std::move(root)) {}
+
+    ~TarReader() { close_file(); }
+
+    rac_result_t consume(const uint8_t* data, size_t size);
+
+    /** Stopped on an entry boundary (end-of-archive blocks are optional) */
+    bool at_boundary() const {
+        return state_ == State::END || (state_ == State::HEADER && fill_ == 0);
+    }
+    bool ended() const { return state_ == State::END; }
+
+    /** Fail if a symlink from the archive resolves outside the root */
+    rac_result_t check_symlinks() const;
+
+    std::atomic<int64_t> bytes{0};
+    std::atomic<int32_t> files{0};
+
+private:
+    enum class State { HEADER, FILE_DATA, META_DATA, SKIP, PADDING, END };
+
+    rac_result_t on_header();
+    rac_result_t on_metadata();
+    rac_result_t open_dir(const std::vector<std::string>& parts, size_t depth, bool create,
+                          int* out_fd) const;
+    rac_result_t open_file(const std::vector<std::string>& parts, int64_t mode);
+    rac_result_t make_link(const std::vector<std::string>& parts, const std::string& target,
+                           bool symbolic);
+    void finish_entry(int64_t size);
+    void close_file();
+
+    std::string root_;
+    State state_ = State::HEADER;
+    uint8_t header_[kBlockSize];
+    size_t fill_ = 0;
+    int64_t remaining_ = 0;
+    int64_t padding_ = 0;
+    int64_t entry_size_ = 0;
+    int zero_blocks_ = 0;
+    int fd_ = -1;
+
+    // Metadata entries apply to the entry that follows them
+    char meta_type_ = 0;
+    std::string meta_;
+    std::string next_path_;
+    std::string next_link_;
+    int64_t next_size_ = -1;
+
+    // Symlinks created so far: path relative to the root, and target
+    std::vector<std::pair<std::string, std::string>> symlinks_;
+};
+
+void TarReader::close_file() {
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+}
+
+void TarReader::finish_entry(int64_t size) {
+    padding_ = (kBlockSize - size % kBlockSize) % kBlockSize;
+    state_ = padding_ > 0 ? State::PADDING : State::HEADER;
+}
+
+// Open the directory formed by the first depth components, creating missing
+// ones if asked. No component may be a symlink: an earlier entry could have
+// planted one to redirect later entries outside the root.
+rac_result_t TarReader::open_dir(const std::vector<std::string>& parts, size_t depth, bool create,
+                                 int* out_fd) const {
+    int fd = ::open(root_.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    for (size_t i = 0; i < depth && fd >= 0; ++i) {
+        const char* name = parts[i].c_str();
+        int next = -1;
+        if (!create || ::mkdirat(fd, name, 0755) == 0 || errno == EEXIST) {
+            next = ::openat(fd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+        }
+        const int saved = errno;
+        ::close(fd);
+        errno = saved;
+        fd = next;
+    }
+    if (fd >= 0) {
+        *out_fd = fd;
+        return RAC_SUCCESS;
+    }
+
+    const std::string path = join(std::vector<std::string>(parts.begin(), parts.begin() + depth));
+    if (errno == ELOOP || errno == ENOTDIR) {
+        RAC_LOG_ERROR(kLogCategory, "Refusing path through a symlink or file: %s", path.c_str());
+        return RAC_ERROR_EXTRACTION_FAILED;
+    }
+    RAC_LOG_ERROR(kLogCategory, "Cannot open directory %s: %s", path.c_str(), strerror(errno));
+    return RAC_ERROR_FILE_WRITE_FAILED;
+}
+
+rac_result_t TarReader::open_file(const std::vector<std::string>& parts, int64_t mode) {
+    int dir = -1;
+    if (rac_result_t result = open_dir(parts, parts.size() - 1, true, &dir);
+        result != RAC_SUCCESS) {
+        return result;
+    }
+    const char* name = parts.back().c_str();
+    ::unlinkat(dir, name, 0);  // Replace, never write through an existing link
+
+    fd_ = ::openat(dir, name, O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC,
+                   (mode & 0111) ? 0755 : 0644);
+    const int saved = errno;
+    ::close(dir);
+    if (fd_ < 0) {
+        RAC_LOG_ERROR(kLogCategory, "Cannot create %s: %s", join(parts).c_str(), strerror(saved));
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t TarReader::make_link(const std::vector<std::string>& parts, const std::string& target,
+                                  bool symbolic) {
+    // Symlink targets are relative to the link's directory, hard links to the root
+    std::vector<std::string> resolved;
+    if (symbolic) {
+        resolved.assign(parts.begin(), parts.end() - 1);
+    }
+    std::string combined = join(resolved);
+    combined += (combined.empty() ? "" : "/") + target;
+    resolved.clear();
+    if (target.empty() || target[0] == '/' || !normalize(combined, &resolved) ||
+        resolved.empty()) {
+        RAC_LOG_ERROR(kLogCategory, "Refusing link %s -> %s", join(parts).c_str(), target.c_str());
+        return RAC_ERROR_EXTRACTION_FAILED;
+    }
+
+    int dir = -1;
+    if (rac_result_t result = open_dir(parts, parts.size() - 1, true, &dir);
+        result != RAC_SUCCESS) {
+        return result;
+    }
+    int source_dir = -1;
+    if (!symbolic) {
+        if (rac_result_t result = open_dir(resolved, resolved.size() - 1, false, &source_dir);
+            result != RAC_SUCCESS) {
+            ::close(dir);
+            return result;
+        }
+        // linkat() would copy a symlink as is, moving its target to a new base
+        struct stat st {};
+        if (::fstatat(source_dir, resolved.back().c_str(), &st, AT_SYMLINK_NOFOLLOW) != 0 ||
+            !S_ISREG(st.st_mode)) {
+            RAC_LOG_ERROR(kLogCategory, "Refusing hard link %s -> %s: not a regular file",
+                          join(parts).c_str(), target.c_str());
+            ::close(source_dir);
+            ::close(dir);
+            return RAC_ERROR_EXTRACTION_FAILED;
+        }
+    }
+
+    const char* name = parts.back().c_str();
+    ::unlinkat(dir, name, 0);
+    const int rc = symbolic
+                       ? ::symlinkat(target.c_str(), dir, name)
+                       : ::linkat(source_dir, resolved.back().c_str(), dir, name, 0);
+    const int saved = errno;
+    ::close(dir);
+    if (source_dir >= 0) {
+        ::close(source_dir);
+    }
+    if (rc != 0) {
+        RAC_LOG_ERROR(kLogCategory, "Cannot create link %s: %s", join(parts).c_str(),
+                      strerror(saved));
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    if (symbolic) {
+        symlinks_.emplace_back(join(parts), target);
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t TarReader::check_symlinks() const {
+    // Lexical checks cannot see that a ".." in one link's target climbs out
+    // of another link: resolve against the finished tree instead
+    std::error_code ec;
+    const std::string root = fs::canonical(root_, ec).string();
+    if (ec) {
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    for (const auto& [path, target] : symlinks_) {
+        const fs::path link = fs::path(root) / path;
+        const std::string resolved =
+            fs::weakly_canonical(link.parent_path() / target, ec).string();
+        if (ec || (resolved != root && resolved.compare(0, root.size() + 1, root + "/") != 0)) {
+            RAC_LOG_ERROR(kLogCategory, "Refusing link %s -> %s: resolves outside the archive",
+                          path.c_str(), target.c_str());
+            return RAC_ERROR_EXTRACTION_FAILED;
+        }
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t TarReader::on_metadata() {
+    if (meta_type_ == 'L') {
+        next_path_ = meta_.c_str();  // NUL-terminated inside the data
+    } else if (meta_type_ == 'K') {
+        next_link_ = meta_.c_str();
+    } else if (meta_type_ == 'x') {
+        // Records: "<length> <key>=<value>\n"
+        size_t pos = 0;
+        while (pos < meta_.size()) {
+            const size_t space = meta_.find(' ', pos);
+            const size_t length = std::strtoull(meta_.c_str() + pos, nullptr, 10);
+            if (space == std::string::npos || length == 0 || pos + length > meta_.size()) {
+                return RAC_ERROR_EXTRACTION_FAILED;
+            }
+            const std::string record = meta_.substr(space + 1, pos + length - space - 2);
+            const size_t equals = record.find('=');
+            if (equals != std::string::npos) {
+                const std::string key = record.substr(0, equals);
+                const std::string value = record.substr(equals + 1);
+                if (key == "path") {
+                    next_path_ = value;
+                } else if (key == "linkpath") {
+                    next_link_ = value;
+                } else if (key == "size") {
+                    next_size_ = std::strtoll(value.c_str(), nullptr, 10);
+                }
+            }
+            pos += length;
+        }
+    }
+    meta_.clear();
+    return RAC_SUCCESS;
+}
+
+rac_result_t TarReader::on_header() {
+    if (is_zero_block(header_)) {
+        if (++zero_blocks_ == 2) {
+            state_ = State::END;
+        }
+        return RAC_SUCCESS;
+    }
+    zero_blocks_ = 0;
+
+    if (!checksum_ok(header_)) {
+        RAC_LOG_ERROR(kLogCategory, "Corrupt tar header");
+        return RAC_ERROR_EXTRACTION_FAILED;
+    }
+
+    const char type = static_cast<char>(header_[156]);
+    int64_t size = parse_number(header_ + 124, 12);
+
+    // Metadata for the next entry
+    if (type == 'L' || type == 'K' || type == 'x' || type == 'g') {
+        if (size > static_cast<int64_t>(kMaxMetadataSize)) {
+            return RAC_ERROR_EXTRACTION_FAILED;
+        }
+        meta_type_ = type;
+        meta_.clear();
+        remaining_ = entry_size_ = size;
+        state_ = size > 0 ? State::META_DATA : State::HEADER;
+        return size > 0 ? RAC_SUCCESS : on_metadata();
+    }
+
+    std::string name = next_path_;
+    if (name.empty()) {
+        name = field_string(header_, 100);
+        if (std::memcmp(header_ + 257, "ustar", 5) == 0 && header_[345] != 0) {
+            name = field_string(header_ + 345, 155) + "/" + name;
+        }
+    }
+    std::string link = next_link_.empty() ? field_string(header_ + 157, 100) : next_link_;
+    if (next_size_ >= 0) {
+        size = next_size_;
+    }
+    next_path_.clear();
+    next_link_.clear();
+    next_size_ = -1;
+
+    std::vector<std::string> parts;
+    if (!normalize(name, &parts)) {
+        RAC_LOG_ERROR(kLogCategory, "Refusing unsafe path in archive: %s", name.c_str());
+        return RAC_ERROR_EXTRACTION_FAILED;
+    }
+
+    remaining_ = entry_size_ = size;
+    rac_result_t result = RAC_SUCCESS;
+    switch (type) {
+        case '0':
+        case '\0':
+        case '7':
+            if (parts.empty()) {
+                return RAC_ERROR_EXTRACTION_FAILED;
+            }
+            result = open_file(parts, parse_number(header_ + 100, 8));
+            if (result != RAC_SUCCESS) {
+                return result;
+            }
+            if (size == 0) {
+                close_file();
+                files.fetch_add(1, std::memory_order_relaxed);
+                state_ = State::HEADER;
+            } else {
+                state_ = State::FILE_DATA;
+            }
+            return RAC_SUCCESS;
+
+        case '5': {
+            int dir = -1;
+            result = open_dir(parts, parts.size(), true, &dir);
+            if (dir >= 0) {
+                ::close(dir);
+            }
+            break;
+        }
+
+        case '1':
+        case '2':
+            if (parts.empty()) {
+                return RAC_ERROR_EXTRACTION_FAILED;
+            }
+            result = make_link(parts, link, type == '2');
+            break;
+
+        default:
+            // Devices, FIFOs and unknown types are not model content
+            RAC_LOG_DEBUG(kLogCategory, "Skipping tar entry type '%c': %s", type, name.c_str());
+            break;
+    }
+
+    if (result == RAC_SUCCESS) {
+        if (size > 0) {
+            state_ = State::SKIP;
+        } else {
+            state_ = State::HEADER;
+        }
+    }
+    return result;
+}
+
+rac_result_t TarReader::consume(const uint8_t* data, size_t size) {
+    while (size > 0) {
+        size_t n = 0;
+        switch (state_) {
+            case State::END:
+                return RAC_SUCCESS;  // Trailing blocks after end-of-archive
+
+            case State::HEADER: {
+                n = std::min(kBlockSize - fill_, size);
+                std::memcpy(header_ + fill_, data, n);
+                fill_ += n;
+                if (fill_ == kBlockSize) {
+                    fill_ = 0;
+                    if (rac_result_t result = on_header(); result != RAC_SUCCESS) {
+                        return result;
+                    }
+                }
+                break;
+            }
+
+            case State::FILE_DATA: {
+                n = static_cast<size_t>(std::min<int64_t>(remaining_, size));
+                for (size_t done = 0; done < n;) {
+                    const ssize_t written = ::write(fd_, data + done, n - done);
+                    if (written < 0) {
+                        if (errno == EINTR) {
+                            continue;
+                        }
+                        return errno == ENOSPC ? RAC_ERROR_INSUFFICIENT_STORAGE
+                                               : RAC_ERROR_FILE_WRITE_FAILED;
+                    }
+                    done += static_cast<size_t>(written);
+                }
+                remaining_ -= static_cast<int64_t>(n);
+                bytes.fetch_add(static_cast<int64_t>(n), std::memory_order_relaxed);
+                if (remaining_ == 0) {
+                    close_file();
+                    files.fetch_add(1, std::memory_order_relaxed);
+                    finish_entry(entry_size_);
+                }
+                break;
+            }
+
+            case State::META_DATA:
+            case State::SKIP:
+                n = static_cast<size_t>(std::min<int64_t>(remaining_, size));
+                if (state_ == State::META_DATA) {
+                    meta_.append(reinterpret_cast<const char*>(data), n);
+                }
+                remaining_ -= static_cast<int64_t>(n);
+                if (remaining_ == 0) {
+                    if (state_ == State::META_DATA) {
+                        if (rac_result_t result = on_metadata(); result != RAC_SUCCESS) {
+                            return result;
+                        }
+                    }
+                    finish_entry(entry_size_);
+                }
+                break;
+
+            case State::PADDING:
+                n = static_cast<size_t>(std::min<int64_t>(padding_, size));
+                padding_ -= static_cast<int64_t>(n);
+                if (padding_ == 0) {
+                    state_ = State::HEADER;
+                }
+                break;
+        }
+        data += n;
+        size -= n;
+    }
+    return RAC_SUCCESS;
+}
+
+// =============================================================================
+// DECOMPRESSORS
+// =============================================================================
+
+class Decompressor {
+public:
+    virtual ~Decompressor() = default;
+
+    /** Decompress into the tar reader; `finish` marks the end of the input */
+    virtual rac_result_t process(const uint8_t* data, size_t size, bool finish,
+                                 TarReader& tar) = 0;
+
+protected:
+    uint8_t out_[kOutputBufferSize];
+};
+
+#ifdef RAC_HAS_ZLIB
+class GzipDecompressor : public Decompressor {
+public:
+    GzipDecompressor() { ok_ = inflateInit2(&stream_, 15 + 32) == Z_OK; }
+    ~GzipDecompressor() override {
+        if (ok_) {
+            inflateEnd(&stream_);
+        }
+    }
+
+    rac_result_t process(const uint8_t* data, size_t size, bool finish, TarReader& tar) override {
+        if (!ok_) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        stream_.next_in = const_cast<Bytef*>(data);
+        stream_.avail_in = static_cast<uInt>(size);
+        for (;;) {
+            if (member_ended_) {
+                // Concatenated members, or padding after the archive
+                if (stream_.avail_in == 0 || tar.ended()) {
+                    break;
+                }
+                inflateReset(&stream_);
+                member_ended_ = false;
+            }
+            stream_.next_out = out_;
+            stream_.avail_out = sizeof(out_);
+            const int rc = inflate(&stream_, Z_NO_FLUSH);
+            const size_t produced = sizeof(out_) - stream_.avail_out;
+            if (produced > 0) {
+                if (rac_result_t result = tar.consume(out_, produced); result != RAC_SUCCESS) {
+                    return result;
+                }
+            }
+            if (rc == Z_STREAM_END) {
+                member_ended_ = true;
+                continue;
+            }
+            if (rc == Z_BUF_ERROR || (stream_.avail_in == 0 && stream_.avail_out != 0)) {
+                break;
+            }
+            if (rc != Z_OK) {
+                RAC_LOG_ERROR(kLogCategory, "gzip stream error: %s",
+                              stream_.msg ? stream_.msg : "unknown");
+                return RAC_ERROR_EXTRACTION_FAILED;
+            }
+        }
+        return finish && !member_ended_ ? RAC_ERROR_EXTRACTION_FAILED : RAC_SUCCESS;
+    }
+
+private:
+    z_stream stream_{};
+    bool ok_ = false;
+    bool member_ended_ = false;
+};
+#endif
+
+#ifdef RAC_HAS_BZIP2
+class Bzip2Decompressor : public Decompressor {
+public:
+    Bzip2Decompressor() { ok_ = BZ2_bzDecompressInit(&stream_, 0, 0) == BZ_OK; }
+    ~Bzip2Decompressor() override {
+        if (ok_) {
+            BZ2_bzDecompressEnd(&stream_);
+        }
+    }
+
+    rac_result_t process(const uint8_t* data, size_t size, bool finish, TarReader& tar) override {
+        if (!ok_) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        stream_.next_in = const_cast<char*>(reinterpret_cast<const char*>(data));
+        stream_.avail_in = static_cast<unsigned int>(size);
+        for (;;) {
+            if (stream_ended_) {
+                if (stream_.avail_in == 0 || tar.ended()) {
+                    break;
+                }
+                // Concatenated streams (pbzip2, lbzip2)
+                char* next_in = stream_.next_in;
+                const unsigned int avail_in = stream_.avail_in;
+                BZ2_bzDecompressEnd(&stream_);
+                stream_ = bz_stream{};
+                if (BZ2_bzDecompressInit(&stream_, 0, 0) != BZ_OK) {
+                    ok_ = false;
+                    return RAC_ERROR_OUT_OF_MEMORY;
+                }
+                stream_.next_in = next_in;
+                stream_.avail_in = avail_in;
+                stream_ended_ = false;
+            }
+            stream_.next_out = reinterpret_cast<char*>(out_);
+            stream_.avail_out = sizeof(out_);
+            const int rc = BZ2_bzDecompress(&stream_);
+            const size_t produced = sizeof(out_) - stream_.avail_out;
+            if (produced > 0) {
+                if (rac_result_t result = tar.consume(out_, produced); result != RAC_SUCCESS) {
+                    return result;
+                }
+            }
+            if (rc == BZ_STREAM_END) {
+                stream_ended_ = true;
+                continue;
+            }
+            if (rc != BZ_OK) {
+                RAC_LOG_ERROR(kLogCategory, "bzip2 stream error: %d", rc);
+                return RAC_ERROR_EXTRACTION_FAILED;
+            }
+            if (stream_.avail_in == 0 && stream_.avail_out != 0) {
+                break;
+            }
+        }
+        return finish && !stream_ended_ ? RAC_ERROR_EXTRACTION_FAILED : RAC_SUCCESS;
+    }
+
+private:
+    bz_stream stream_{};
+    bool ok_ = false;
+    bool stream_ended_ = false;
+};
+#endif
+
+#ifdef RAC_HAS_LZMA
+class XzDecompressor : public Decompressor {
+public:
+    XzDecompressor() {
+        ok_ = lzma_stream_decoder(&stream_, UINT64_MAX, LZMA_CONCATENATED) == LZMA_OK;
+    }
+    ~XzDecompressor() override { lzma_end(&stream_); }
+
+    rac_result_t process(const uint8_t* data, size_t size, bool finish, TarReader& tar) override {
+        if (!ok_) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        if (ended_) {
+            return RAC_SUCCESS;
+        }
+        stream_.next_in = data;
+        stream_.avail_in = size;
+        const lzma_action action = finish ? LZMA_FINISH : LZMA_RUN;
+        for (;;) {
+            stream_.next_out = out_;
+            stream_.avail_out = sizeof(out_);
+            const lzma_ret rc = lzma_code(&stream_, action);
+            const size_t produced = sizeof(out_) - stream_.avail_out;
+            if (produced > 0) {
+                if (rac_result_t result = tar.consume(out_, produced); result != RAC_SUCCESS) {
+                    return result;
+                }
+            }
+            if (rc == LZMA_STREAM_END) {
+                ended_ = true;
+                return RAC_SUCCESS;
+            }
+            if (rc != LZMA_OK) {
+                if (rc == LZMA_BUF_ERROR && !finish) {
+                    return RAC_SUCCESS;
+                }
+                RAC_LOG_ERROR(kLogCategory, "xz stream error: %d", static_cast<int>(rc));
+                return RAC_ERROR_EXTRACTION_FAILED;
+            }
+            if (!finish && stream_.avail_in == 0 && stream_.avail_out != 0) {
+                return RAC_SUCCESS;
+            }
+        }
+    }
+
+private:
+    lzma_stream stream_ = LZMA_STREAM_INIT;
+    bool ok_ = false;
+    bool ended_ = false;
+};
+#endif
+
+// =============================================================================
+// STREAMING EXTRACTOR
+// =============================================================================
+
+bool StreamingExtractor::supports(rac_archive_type_t type) {
+    switch (type) {
+#ifdef RAC_HAS_ZLIB
+        case RAC_ARCHIVE_TYPE_TAR_GZ:
+            return true;
+#endif
+#ifdef RAC_HAS_BZIP2
+        case RAC_ARCHIVE_TYPE_TAR_BZ2:
+            return true;
+#endif
+#ifdef RAC_HAS_LZMA
+        case RAC_ARCHIVE_TYPE_TAR_XZ:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
+
+StreamingExtractor::StreamingExtractor(std::string destination_dir, std::string staging_dir)
+    : destination_dir_(std::move(destination_dir)), staging_dir_(std::move(staging_dir)) {}
+
+StreamingExtractor::~StreamingExtractor() {
+    abort();
+}
+
+rac_result_t StreamingExtractor::create(rac_archive_type_t type, const std::string& destination_dir,
+                                        std::unique_ptr<StreamingExtractor>* out) {
+    if (destination_dir.empty() || !out) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::unique_ptr<Decompressor> decompressor;
+    switch (type) {
+#ifdef RAC_HAS_ZLIB
+        case RAC_ARCHIVE_TYPE_TAR_GZ:
+            decompressor = std::make_unique<GzipDecompressor>();
+            break;
+#endif
+#ifdef RAC_HAS_BZIP2
+        case RAC_ARCHIVE_TYPE_TAR_BZ2:
+            decompressor = std::make_unique<Bzip2Decompressor>();
+            break;
+#endif
+#ifdef RAC_HAS_LZMA
+        case RAC_ARCHIVE_TYPE_TAR_XZ:
+            decompressor = std::make_unique<XzDecompressor>();
+            break;
+#endif
+        default:
+            return RAC_ERROR_UNSUPPORTED_ARCHIVE;
+    }
+
+    // Sibling of the destination so the final move is a rename
+    static std::atomic<uint64_t> counter{0};
+    std::string destination = destination_dir;
+    while (destination.size() > 1 && destination.back() == '/') {
+        destination.pop_back();
+    }
+    const std::string staging = destination + ".extracting-" + std::to_string(getpid()) + "-" +
+                                std::to_string(counter.fetch_add(1));
+
+    std::error_code ec;
+    fs::remove_all(staging, ec);
+    if (!fs::create_directories(staging, ec)) {
+        RAC_LOG_ERROR(kLogCategory, "Cannot create %s: %s", staging.c_str(), ec.message().c_str());
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+
+    std::unique_ptr<StreamingExtractor> extractor(new StreamingExtractor(destination, staging));
+    extractor->decompressor_ = std::move(decompressor);
+    extractor->tar_ = std::make_unique<TarReader>(staging);
+    *out = std::move(extractor);
+    return RAC_SUCCESS;
+}
+
+int64_t StreamingExtractor::bytes_extracted() const {
+    return tar_ ? tar_->bytes.load(std::memory_order_relaxed) : 0;
+}
+
+int32_t StreamingExtractor::files_extracted() const {
+    return tar_ ? tar_->files.load(std::memory_order_relaxed) : 0;
+}
+
+rac_result_t StreamingExtractor::write(const void* data, size_t size) {
+    if (error_ != RAC_SUCCESS) {
+        return error_;
+    }
+    if (finished_) {
+        return RAC_ERROR_INVALID_STATE;
+    }
+
+    // Decompressor counters are 32-bit on some platforms
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    constexpr size_t kMaxChunk = 1u << 30;
+    while (size > 0) {
+        const size_t n = std::min(size, kMaxChunk);
+        error_ = decompressor_->process(bytes, n, false, *tar_);
+        if (error_ != RAC_SUCCESS) {
+            return error_;
+        }
+        consumed_.fetch_add(static_cast<int64_t>(n), std::memory_order_relaxed);
+        bytes += n;
+        size -= n;
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t StreamingExtractor::finish() {
+    if (error_ != RAC_SUCCESS) {
+        return error_;
+    }
+    if (finished_) {
+        return RAC_ERROR_INVALID_STATE;
+    }
+
+    error_ = decompressor_->process(nullptr, 0, true, *tar_);
+    if (error_ == RAC_SUCCESS && !tar_->at_boundary()) {
+        error_ = RAC_ERROR_EXTRACTION_FAILED;
+    }
+    if (error_ != RAC_SUCCESS) {
+        RAC_LOG_ERROR(kLogCategory, "Archive for %s is truncated or corrupt",
+                      destination_dir_.c_str());
+        return error_;
+    }
+
+    error_ = tar_->check_symlinks();
+    if (error_ != RAC_SUCCESS) {
+        return error_;
+    }
+
+    error_ = commit();
+    finished_ = error_ == RAC_SUCCESS;
+    return error_;
+}
+
+rac_result_t StreamingExtractor::commit() {
+    std::error_code ec;
+    const fs::path destination(destination_dir_);
+    const fs::path staging(staging_dir_);
+
+    if (!fs::exists(destination, ec)) {
+        fs::create_directories(destination.parent_path(), ec);
+        fs::rename(staging, destination, ec);
+        if (ec) {
+            RAC_LOG_ERROR(kLogCategory, "Cannot move %s into place: %s", staging.c_str(),
+                          ec.message().c_str());
+            return RAC_ERROR_FILE_WRITE_FAILED;
+        }
+        return RAC_SUCCESS;
+    }
+
+    // Destination already exists: replace entry by entry, keeping other files
+    for (const auto& entry : fs::directory_iterator(staging, ec)) {
+        const fs::path target = destination / entry.path().filename();
+        std::error_code remove_ec;
+        fs::remove_all(target, remove_ec);
+        fs::rename(entry.path(), target, ec);
+        if (ec) {
+            RAC_LOG_ERROR(kLogCategory, "Cannot move %s into place: %s", target.c_str(),
+                          ec.message().c_str());
+            return RAC_ERROR_FILE_WRITE_FAILED;
+        }
+    }
+    fs::remove_all(staging, ec);
+    return RAC_SUCCESS;
+}
+
+void StreamingExtractor::abort() {
+    if (finished_ || staging_dir_.empty()) {
+        return;
+    }
+    tar_.reset();
+    std::error_code ec;
+    fs::remove_all(staging_dir_, ec);
+    staging_dir_.clear();
+    if (error_ == RAC_SUCCESS) {
+        error_ = RAC_ERROR_CANCELLED;
+    }
+}
+
+}  // namespace rac_internal
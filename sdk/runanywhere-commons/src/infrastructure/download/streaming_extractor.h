@@ -0,0 +1,68 @@
+/**
+ * @file streaming_extractor.h
+ * @brief Push-based tar.gz / tar.bz2 / tar.xz extractor
+ *
+ * Compressed bytes are pushed in as they arrive; entries are decompressed and
+ * written to a temporary directory next to the destination, which is moved
+ * into place by finish(). Nothing appears at the destination until then.
+ */
+
+#ifndef RAC_STREAMING_EXTRACTOR_H
+#define RAC_STREAMING_EXTRACTOR_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "rac/core/rac_error.h"
+#include "rac/infrastructure/model_management/rac_model_types.h"
+
+namespace rac_internal {
+
+class Decompressor;
+class TarReader;
+
+class StreamingExtractor {
+public:
+    /** Whether this build can stream-extract the given archive type */
+    static bool supports(rac_archive_type_t type);
+
+    static rac_result_t create(rac_archive_type_t type, const std::string& destination_dir,
+                               std::unique_ptr<StreamingExtractor>* out);
+
+    ~StreamingExtractor();
+
+    StreamingExtractor(const StreamingExtractor&) = delete;
+    StreamingExtractor& operator=(const StreamingExtractor&) = delete;
+
+    /** Push the next compressed bytes. After an error the extractor is unusable. */
+    rac_result_t write(const void* data, size_t size);
+
+    /** Validate the end of the archive and move the result into place */
+    rac_result_t finish();
+
+    /** Discard everything extracted so far (also done by the destructor) */
+    void abort();
+
+    int64_t bytes_consumed() const { return consumed_.load(std::memory_order_relaxed); }
+    int64_t bytes_extracted() const;
+    int32_t files_extracted() const;
+
+private:
+    StreamingExtractor(std::string destination_dir, std::string staging_dir);
+
+    rac_result_t commit();
+
+    std::string destination_dir_;
+    std::string staging_dir_;
+    std::unique_ptr<Decompressor> decompressor_;
+    std::unique_ptr<TarReader> tar_;
+    std::atomic<int64_t> consumed_{0};
+    rac_result_t error_ = RAC_SUCCESS;
+    bool finished_ = false;
+};
+
+}  // namespace rac_internal
+
+#endif  // RAC_STREAMING_EXTRACTOR_H
@@ -0,0 +1,398 @@
+/**
+ * @file model_catalog.cpp
+ * @brief On-disk model catalog used by the model registry
+ */
+
+#include "infrastructure/model_management/model_catalog.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include <sys/stat.h>
+
+#include "rac/core/rac_logger.h"
+#include "rac/infrastructure/model_management/rac_model_registry.h"
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define RAC_CATALOG_HAS_MMAP 1
+#endif
+
+namespace rac_internal {
+
+namespace {
+
+// Layout: Header | Record[record_count] | uint32 tag offsets | string pool.
+// Integers are stored in host byte order; a catalog written on a machine
+// with a different byte order fails the byte-order check and is ignored.
+constexpr char kMagic[8] = {'R', 'A', 'C', 'M', 'C', 'A', 'T', '\0'};
+constexpr uint32_t kFormatVersion = 1;
+constexpr uint32_t kByteOrderMark = 0x01020304;
+constexpr uint32_t kNoString = 0xFFFFFFFF;
+
+struct Header {
+    char magic[8];
+    uint32_t format_version;
+    uint32_t byte_order;
+    uint32_t header_size;
+    uint32_t record_size;
+    uint32_t record_count;
+    uint32_t tag_count;
+    uint64_t registry_version;
+    uint64_t strings_size;
+    uint64_t file_size;
+    uint32_t checksum;  // FNV-1a over everything after the header
+    uint32_t reserved;
+};
+static_assert(sizeof(Header) == 64, "catalog header layout changed");
+
+struct Record {
+    // Offsets into the string pool, or kNoString
+    uint32_t id;
+    uint32_t name;
+    uint32_t download_url;
+    uint32_t local_path;
+    uint32_t description;
+    uint32_t strategy_id;
+    // Range in the tag offset table
+    uint32_t first_tag;
+    uint32_t tag_count;
+
+    int32_t category;
+    int32_t format;
+    int32_t framework;
+    int32_t source;
+    int32_t artifact_kind;
+    int32_t archive_type;
+    int32_t archive_structure;
+    int32_t context_length;
+    int32_t supports_thinking;
+    int32_t usage_count;
+
+    int64_t download_size;
+    int64_t memory_required;
+    int64_t created_at;
+    int64_t updated_at;
+    int64_t last_used;
+    int64_t path_size;
+    int64_t path_mtime;
+};
+static_assert(sizeof(Record) == 128, "catalog record layout changed");
+
+uint32_t fnv1a(const uint8_t* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+class StringPool {
+public:
+    uint32_t add(const char* value) {
+        if (!value) {
+            return kNoString;
+        }
+        const auto offset = static_cast<uint32_t>(data_.size());
+        data_.insert(data_.end(), value, value + strlen(value) + 1);
+        return offset;
+    }
+
+    const std::vector<char>& data() const { return data_; }
+
+private:
+    std::vector<char> data_;
+};
+
+// Read-only view of the catalog file, mapped where the platform allows
+class CatalogFile {
+public:
+    ~CatalogFile() {
+#ifdef RAC_CATALOG_HAS_MMAP
+        if (mapped_) {
+            munmap(mapped_, size_);
+        }
+#endif
+    }
+
+    rac_result_t open(const std::string& path) {
+#ifdef RAC_CATALOG_HAS_MMAP
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return RAC_ERROR_FILE_NOT_FOUND;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+            ::close(fd);
+            return RAC_ERROR_INVALID_FORMAT;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        void* data = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);  // The mapping keeps the file alive
+        if (data == MAP_FAILED) {
+            return RAC_ERROR_FILE_READ_FAILED;
+        }
+        mapped_ = data;
+        data_ = static_cast<const uint8_t*>(data);
+        return RAC_SUCCESS;
+#else
+        std::ifstream in(path, std::ios::binary);
+        if (!in) {
+            return RAC_ERROR_FILE_NOT_FOUND;
+        }
+        buffer_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        if (buffer_.size() < sizeof(Header)) {
+            return RAC_ERROR_INVALID_FORMAT;
+        }
+        data_ = reinterpret_cast<const uint8_t*>(buffer_.data());
+        size_ = buffer_.size();
+        return RAC_SUCCESS;
+#endif
+    }
+
+    const uint8_t* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const uint8_t* data_ = nullptr;
+    size_t size_ = 0;
+#ifdef RAC_CATALOG_HAS_MMAP
+    void* mapped_ = nullptr;
+#else
+    std::vector<char> buffer_;
+#endif
+};
+
+}  // namespace
+
+bool stat_model_path(const char* path, CatalogFileStamp* out_stamp) {
+    struct stat st;
+    if (!path || stat(path, &st) != 0) {
+        return false;
+    }
+    out_stamp->size = static_cast<int64_t>(st.st_size);
+    out_stamp->mtime = static_cast<int64_t>(st.st_mtime);
+    return true;
+}
+
+rac_result_t write_model_catalog(const std::string& path, uint64_t registry_version,
+                                 const std::vector<const rac_model_info_t*>& models) {
+    StringPool strings;
+    std::vector<Record> records;
+    std::vector<uint32_t> tags;
+    records.reserve(models.size());
+
+    for (const rac_model_info_t* model : models) {
+        Record record = {};
+        record.id = strings.add(model->id);
+        record.name = strings.add(model->name);
+        record.download_url = strings.add(model->download_url);
+        record.description = strings.add(model->description);
+        record.strategy_id = strings.add(model->artifact_info.strategy_id);
+
+        // A path that is gone is recorded as not downloaded
+        CatalogFileStamp stamp;
+        const bool downloaded = model->local_path && model->local_path[0] != '\0' &&
+                                stat_model_path(model->local_path, &stamp);
+        record.local_path = downloaded ? strings.add(model->local_path) : kNoString;
+        record.path_size = stamp.size;
+        record.path_mtime = stamp.mtime;
+
+        record.first_tag = static_cast<uint32_t>(tags.size());
+        for (size_t i = 0; model->tags && i < model->tag_count; ++i) {
+            if (model->tags[i]) {
+                tags.push_back(strings.add(model->tags[i]));
+            }
+        }
+        record.tag_count = static_cast<uint32_t>(tags.size()) - record.first_tag;
+
+        record.category = model->category;
+        record.format = model->format;
+        record.framework = model->framework;
+        record.source = model->source;
+        record.artifact_kind = model->artifact_info.kind;
+        record.archive_type = model->artifact_info.archive_type;
+        record.archive_structure = model->artifact_info.archive_structure;
+        record.context_length = model->context_length;
+        record.supports_thinking = model->supports_thinking;
+        record.usage_count = model->usage_count;
+        record.download_size = model->download_size;
+        record.memory_required = model->memory_required;
+        record.created_at = model->created_at;
+        record.updated_at = model->updated_at;
+        record.last_used = model->last_used;
+        records.push_back(record);
+    }
+
+    // Assemble the payload so the checksum can go into the header
+    std::vector<uint8_t> payload;
+    const size_t records_bytes = records.size() * sizeof(Record);
+    const size_t tags_bytes = tags.size() * sizeof(uint32_t);
+    payload.resize(records_bytes + tags_bytes + strings.data().size());
+    if (records_bytes > 0) {
+        memcpy(payload.data(), records.data(), records_bytes);
+    }
+    if (tags_bytes > 0) {
+        memcpy(payload.data() + records_bytes, tags.data(), tags_bytes);
+    }
+    if (!strings.data().empty()) {
+        memcpy(payload.data() + records_bytes + tags_bytes, strings.data().data(),
+               strings.data().size());
+    }
+
+    Header header = {};
+    memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.format_version = kFormatVersion;
+    header.byte_order = kByteOrderMark;
+    header.header_size = sizeof(Header);
+    header.record_size = sizeof(Record);
+    header.record_count = static_cast<uint32_t>(records.size());
+    header.tag_count = static_cast<uint32_t>(tags.size());
+    header.registry_version = registry_version;
+    header.strings_size = strings.data().size();
+    header.file_size = sizeof(Header) + payload.size();
+    header.checksum = fnv1a(payload.data(), payload.size());
+
+    const std::string temp_path = path + ".tmp";
+    FILE* file = fopen(temp_path.c_str(), "wb");
+    if (!file) {
+        RAC_LOG_ERROR("ModelCatalog", "Cannot create %s", temp_path.c_str());
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && (payload.empty() || fwrite(payload.data(), payload.size(), 1, file) == 1);
+    ok = (fclose(file) == 0) && ok;
+    if (!ok || rename(temp_path.c_str(), path.c_str()) != 0) {
+        remove(temp_path.c_str());
+        RAC_LOG_ERROR("ModelCatalog", "Failed to write %s", path.c_str());
+        return RAC_ERROR_FILE_WRITE_FAILED;
+    }
+    return RAC_SUCCESS;
+}
+
+rac_result_t read_model_catalog(const std::string& path, std::vector<CatalogEntry>* out_entries,
+                                uint64_t* out_registry_version) {
+    out_entries->clear();
+
+    CatalogFile file;
+    rac_result_t result = file.open(path);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
+
+    Header header;
+    memcpy(&header, file.data(), sizeof(header));
+    if (memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+        header.format_version != kFormatVersion || header.byte_order != kByteOrderMark ||
+        header.header_size != sizeof(Header) || header.record_size != sizeof(Record) ||
+        header.file_size != file.size()) {
+        RAC_LOG_WARNING("ModelCatalog", "Ignoring incompatible catalog %s", path.c_str());
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+
+    const uint8_t* payload = file.data() + sizeof(Header);
+    const size_t payload_size = file.size() - sizeof(Header);
+    const uint64_t records_bytes = uint64_t{header.record_count} * sizeof(Record);
+    const uint64_t tags_bytes = uint64_t{header.tag_count} * sizeof(uint32_t);
+    if (records_bytes + tags_bytes + header.strings_size != payload_size ||
+        fnv1a(payload, payload_size) != header.checksum) {
+        RAC_LOG_WARNING("ModelCatalog", "Ignoring corrupt catalog %s", path.c_str());
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+
+    const uint8_t* tag_table = payload + records_bytes;
+    const char* pool = reinterpret_cast<const char*>(tag_table + tags_bytes);
+    const size_t pool_size = header.strings_size;
+
+    // The checksum rules out accidental damage; the bounds checks keep a
+    // hand-crafted file from reading outside the mapping
+    bool valid = true;
+    auto string_at = [&](uint32_t offset) -> char* {
+        if (offset == kNoString) {
+            return nullptr;
+        }
+        if (offset >= pool_size || !memchr(pool + offset, '\0', pool_size - offset)) {
+            valid = false;
+            return nullptr;
+        }
+        return rac_strdup(pool + offset);
+    };
+
+    out_entries->reserve(header.record_count);
+    for (uint32_t i = 0; i < header.record_count && valid; ++i) {
+        Record record;
+        memcpy(&record, payload + i * sizeof(Record), sizeof(Record));
+
+        rac_model_info_t* model = rac_model_info_alloc();
+        if (!model) {
+            result = RAC_ERROR_OUT_OF_MEMORY;
+            break;
+        }
+        out_entries->push_back({model, {record.path_size, record.path_mtime}});
+
+        model->id = string_at(record.id);
+        model->name = string_at(record.name);
+        model->download_url = string_at(record.download_url);
+        model->local_path = string_at(record.local_path);
+        model->description = string_at(record.description);
+        model->artifact_info.strategy_id = string_at(record.strategy_id);
+        valid = valid && model->id &&
+                uint64_t{record.first_tag} + record.tag_count <= header.tag_count;
+
+        if (valid && record.tag_count > 0) {
+            model->tags = static_cast<char**>(calloc(record.tag_count, sizeof(char*)));
+            if (!model->tags) {
+                result = RAC_ERROR_OUT_OF_MEMORY;
+                break;
+            }
+            model->tag_count = record.tag_count;
+            for (uint32_t t = 0; t < record.tag_count; ++t) {
+                uint32_t offset;
+                memcpy(&offset, tag_table + (record.first_tag + t) * sizeof(uint32_t),
+                       sizeof(offset));
+                model->tags[t] = string_at(offset);
+            }
+        }
+
+        model->category = static_cast<rac_model_category_t>(record.category);
+        model->format = static_cast<rac_model_format_t>(record.format);
+        model->framework = static_cast<rac_inference_framework_t>(record.framework);
+        model->source = static_cast<rac_model_source_t>(record.source);
+        model->artifact_info.kind = static_cast<rac_artifact_type_kind_t>(record.artifact_kind);
+        model->artifact_info.archive_type = static_cast<rac_archive_type_t>(record.archive_type);
+        model->artifact_info.archive_structure =
+            static_cast<rac_archive_structure_t>(record.archive_structure);
+        model->context_length = record.context_length;
+        model->supports_thinking = record.supports_thinking;
+        model->usage_count = record.usage_count;
+        model->download_size = record.download_size;
+        model->memory_required = record.memory_required;
+        model->created_at = record.created_at;
+        model->updated_at = record.updated_at;
+        model->last_used = record.last_used;
+    }
+
+    if (!valid && result == RAC_SUCCESS) {
+        RAC_LOG_WARNING("ModelCatalog", "Ignoring malformed catalog %s", path.c_str());
+        result = RAC_ERROR_INVALID_FORMAT;
+    }
+    if (result != RAC_SUCCESS) {
+        for (CatalogEntry& entry : *out_entries) {
+            rac_model_info_free(entry.model);
+        }
+        out_entries->clear();
+        return result;
+    }
+
+    if (out_registry_version) {
+        *out_registry_version = header.registry_version;
+    }
+    return RAC_SUCCESS;
+}
+
+}  // namespace rac_internal
@@ -0,0 +1,68 @@
+/**
+ * @file model_catalog.h
+ * @brief On-disk model catalog used by the model registry
+ *
+ * The catalog is a single binary file: a fixed header, an array of
+ * fixed-size model records, a table of tag string offsets and a string pool.
+ * Loading maps the file and reads the fixed-size records in place, so there
+ * is no text parsing. Each string field is still copied out of the pool,
+ * because registry models own their strings and outlive the mapping.
+ *
+ * Each downloaded model records the size and modification time of its local
+ * path when the catalog was written. The registry compares them when the
+ * model is first used instead of rescanning the models directory at startup.
+ */
+
+#ifndef RAC_MODEL_CATALOG_H
+#define RAC_MODEL_CATALOG_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rac/core/rac_error.h"
+#include "rac/infrastructure/model_management/rac_model_types.h"
+
+namespace rac_internal {
+
+/** Size and modification time of a model's local path */
+struct CatalogFileStamp {
+    int64_t size = 0;
+    int64_t mtime = 0;
+
+    bool operator==(const CatalogFileStamp& other) const {
+        return size == other.size && mtime == other.mtime;
+    }
+    bool operator!=(const CatalogFileStamp& other) const { return !(*this == other); }
+};
+
+/** Stat a model file or folder; false if it does not exist */
+bool stat_model_path(const char* path, CatalogFileStamp* out_stamp);
+
+struct CatalogEntry {
+    /** Owned model (free with rac_model_info_free) */
+    rac_model_info_t* model = nullptr;
+    /** Stamp of model->local_path when the catalog was written */
+    CatalogFileStamp stamp;
+};
+
+/**
+ * @brief Write the models to path atomically (temporary file plus rename).
+ *
+ * Local paths that no longer exist are written as not downloaded.
+ */
+rac_result_t write_model_catalog(const std::string& path, uint64_t registry_version,
+                                 const std::vector<const rac_model_info_t*>& models);
+
+/**
+ * @brief Read a catalog written by write_model_catalog().
+ *
+ * @return RAC_SUCCESS, RAC_ERROR_FILE_NOT_FOUND, or RAC_ERROR_INVALID_FORMAT
+ *         for a corrupt, truncated or incompatible file
+ */
+rac_result_t read_model_catalog(const std::string& path, std::vector<CatalogEntry>* out_entries,
+                                uint64_t* out_registry_version);
+
+}  // namespace rac_internal
+
+#endif  // RAC_MODEL_CATALOG_H
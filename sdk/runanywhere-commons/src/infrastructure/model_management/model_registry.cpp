@@ -8,16 +8,27 @@
  * CRITICAL: This is a direct port of Swift implementation - do NOT add custom logic!
  *
  * This is an in-memory model metadata store.
+ *
+ * Readers never take a lock: the registry publishes immutable, indexed
+ * snapshots and a read atomically loads the current one. Writers serialize on
+ * a mutex, apply their change to a copy of the ID map (which only holds
+ * shared pointers, so no model is deep-copied) and publish a new snapshot
+ * with rebuilt indexes. Models are deep-copied only when handed to a caller.
  */
 
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <cstring>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "infrastructure/model_management/model_catalog.h"
 #include "rac/core/rac_logger.h"
 #include "rac/core/rac_platform_adapter.h"
 #include "rac/core/rac_structured_error.h"
@@ -28,14 +39,6 @@
 // INTERNAL STRUCTURES
 // =============================================================================
 
-struct rac_model_registry {
-    // Model storage (model_id -> model_info)
-    std::map<std::string, rac_model_info_t*> models;
-
-    // Thread safety
-    std::mutex mutex;
-};
-
 // Note: rac_strdup is declared in rac_types.h and implemented in rac_memory.cpp
 
 static rac_model_info_t* deep_copy_model(const rac_model_info_t* src) {
@@ -118,6 +121,251 @@ static void free_model_info(rac_model_info_t* model) {
     free(model);
 }
 
+namespace {
+
+// A stored model is never modified once published; updates replace it
+using ModelPtr = std::shared_ptr<const rac_model_info_t>;
+using ModelMap = std::map<std::string, ModelPtr, std::less<>>;
+using ModelList = std::vector<const rac_model_info_t*>;
+
+ModelPtr make_model_ptr(rac_model_info_t* model) {
+    return ModelPtr(model, free_model_info);
+}
+
+bool has_local_path(const rac_model_info_t* model) {
+    return model->local_path && model->local_path[0] != '\0';
+}
+
+struct Snapshot {
+    uint64_t version = 0;
+
+    // Owning map (model_id -> model); every list below borrows from it
+    ModelMap by_id;
+
+    // Secondary indexes, each ordered by model ID
+    ModelList all;
+    ModelList downloaded;
+    std::map<rac_inference_framework_t, ModelList> by_framework;
+    std::map<rac_model_category_t, ModelList> by_category;
+
+    // local_path -> model (the first model by ID wins if paths collide)
+    std::map<std::string, const rac_model_info_t*, std::less<>> by_path;
+
+    const rac_model_info_t* find(std::string_view model_id) const {
+        auto it = by_id.find(model_id);
+        return it == by_id.end() ? nullptr : it->second.get();
+    }
+
+    const rac_model_info_t* find_by_path(std::string_view path) const;
+};
+
+std::shared_ptr<const Snapshot> build_snapshot(ModelMap models, uint64_t version) {
+    auto snapshot = std::make_shared<Snapshot>();
+    snapshot->version = version;
+    snapshot->by_id = std::move(models);
+    snapshot->all.reserve(snapshot->by_id.size());
+
+    for (const auto& pair : snapshot->by_id) {
+        const rac_model_info_t* model = pair.second.get();
+        snapshot->all.push_back(model);
+        snapshot->by_framework[model->framework].push_back(model);
+        snapshot->by_category[model->category].push_back(model);
+        if (has_local_path(model)) {
+            snapshot->downloaded.push_back(model);
+            snapshot->by_path.emplace(model->local_path, model);
+        }
+    }
+    return snapshot;
+}
+
+const rac_model_info_t* Snapshot::find_by_path(std::string_view path) const {
+    // Exact match, or else the longest local_path that is a prefix of the
+    // search path. The predecessor of the search path is the only candidate
+    // longer than its common prefix with the search path, so each miss
+    // shrinks the search to that common prefix.
+    std::string_view search = path;
+    auto it = by_path.upper_bound(search);
+    while (it != by_path.begin()) {
+        --it;
+        std::string_view key = it->first;
+        if (search.compare(0, key.size(), key) == 0) {
+            return it->second;
+        }
+        size_t common = 0;
+        while (common < key.size() && common < search.size() && key[common] == search[common]) {
+            ++common;
+        }
+        search = search.substr(0, common);
+        it = by_path.upper_bound(search);
+    }
+
+    // Otherwise a model stored below the search path
+    it = by_path.lower_bound(path);
+    if (it != by_path.end() && std::string_view(it->first).compare(0, path.size(), path) == 0) {
+        return it->second;
+    }
+    return nullptr;
+}
+
+const ModelList kNoModels;
+
+template <typename Key>
+const ModelList& find_list(const std::map<Key, ModelList>& index, Key key) {
+    auto it = index.find(key);
+    return it == index.end() ? kNoModels : it->second;
+}
+
+// Hand deep copies of the given models to the caller
+rac_result_t copy_out(const ModelList& models, rac_model_info_t*** out_models, size_t* out_count) {
+    *out_models = nullptr;
+    *out_count = 0;
+    if (models.empty()) {
+        return RAC_SUCCESS;
+    }
+
+    auto** copies = static_cast<rac_model_info_t**>(malloc(sizeof(rac_model_info_t*) * models.size()));
+    if (!copies) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+
+    for (size_t i = 0; i < models.size(); ++i) {
+        copies[i] = deep_copy_model(models[i]);
+        if (!copies[i]) {
+            // Cleanup on error
+            for (size_t j = 0; j < i; ++j) {
+                free_model_info(copies[j]);
+            }
+            free(copies);
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    *out_models = copies;
+    *out_count = models.size();
+    return RAC_SUCCESS;
+}
+
+rac_result_t borrow_out(const ModelList& models, const rac_model_info_t* const** out_models,
+                        size_t* out_count) {
+    *out_models = models.empty() ? nullptr : models.data();
+    *out_count = models.size();
+    return RAC_SUCCESS;
+}
+
+}  // namespace
+
+struct rac_model_registry {
+    // Current snapshot; only accessed through std::atomic_load / std::atomic_store
+    std::shared_ptr<const Snapshot> current = build_snapshot({}, 0);
+
+    // Serializes writers; readers never take it
+    std::mutex write_mutex;
+
+    std::shared_ptr<const Snapshot> load() const { return std::atomic_load(&current); }
+
+    // Run `change` on a copy of the ID map and publish the result. `change`
+    // returns RAC_SUCCESS to publish, anything else to discard the copy.
+    template <typename Change>
+    rac_result_t modify(Change change) {
+        std::lock_guard<std::mutex> lock(write_mutex);
+        std::shared_ptr<const Snapshot> base = load();
+        ModelMap models = base->by_id;
+        rac_result_t result = change(models);
+        if (result != RAC_SUCCESS) {
+            return result;
+        }
+        std::atomic_store(&current, build_snapshot(std::move(models), base->version + 1));
+        return RAC_SUCCESS;
+    }
+
+    // Local paths loaded from a catalog and not checked against the disk yet
+    // (model_id -> stamp recorded in the catalog). Entries are added and
+    // forgotten under write_mutex; stamp_mutex guards the map itself.
+    std::mutex stamp_mutex;
+    std::map<std::string, rac_internal::CatalogFileStamp, std::less<>> unverified;
+    std::atomic<bool> has_unverified{false};
+
+    // Call with write_mutex held (from a modify() change)
+    void forget_unverified(std::string_view model_id) {
+        if (!has_unverified.load(std::memory_order_acquire)) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock(stamp_mutex);
+        auto it = unverified.find(model_id);
+        if (it != unverified.end()) {
+            unverified.erase(it);
+            has_unverified.store(!unverified.empty(), std::memory_order_release);
+        }
+    }
+
+    // Current snapshot after checking the catalog stamps of one model, or of
+    // every model if model_id is NULL
+    std::shared_ptr<const Snapshot> load_verified(const char* model_id);
+};
+
+std::shared_ptr<const Snapshot> rac_model_registry::load_verified(const char* model_id) {
+    std::shared_ptr<const Snapshot> snapshot = load();
+    if (!has_unverified.load(std::memory_order_acquire)) {
+        return snapshot;
+    }
+
+    std::vector<std::pair<std::string, rac_internal::CatalogFileStamp>> pending;
+    {
+        std::lock_guard<std::mutex> lock(stamp_mutex);
+        if (model_id) {
+            auto it = unverified.find(std::string_view(model_id));
+            if (it != unverified.end()) {
+                pending.emplace_back(*it);
+                unverified.erase(it);
+            }
+        } else {
+            pending.assign(unverified.begin(), unverified.end());
+            unverified.clear();
+        }
+        has_unverified.store(!unverified.empty(), std::memory_order_release);
+    }
+
+    // Stat without holding any lock
+    std::vector<const rac_model_info_t*> stale;
+    for (const auto& entry : pending) {
+        const rac_model_info_t* model = snapshot->find(entry.first);
+        rac_internal::CatalogFileStamp stamp;
+        if (model && has_local_path(model) &&
+            (!rac_internal::stat_model_path(model->local_path, &stamp) || stamp != entry.second)) {
+            stale.push_back(model);
+        }
+    }
+    if (stale.empty()) {
+        return snapshot;
+    }
+
+    modify([&](ModelMap& models) {
+        for (const rac_model_info_t* model : stale) {
+            // Skip models replaced since the check
+            auto it = models.find(std::string_view(model->id));
+            if (it == models.end() || it->second.get() != model) {
+                continue;
+            }
+            rac_model_info_t* copy = deep_copy_model(model);
+            if (!copy) {
+                return RAC_ERROR_OUT_OF_MEMORY;
+            }
+            free(copy->local_path);
+            copy->local_path = nullptr;
+            copy->updated_at = rac_get_current_time_ms() / 1000;
+            it->second = make_model_ptr(copy);
+        }
+        return RAC_SUCCESS;
+    });
+    RAC_LOG_INFO("ModelRegistry", "%zu cataloged models changed on disk; marked not downloaded",
+                 stale.size());
+    return load();
+}
+
+struct rac_model_registry_snapshot {
+    std::shared_ptr<const Snapshot> snapshot;
+};
+
 // =============================================================================
 // PUBLIC API - LIFECYCLE
 // =============================================================================
@@ -140,12 +388,7 @@ void rac_model_registry_destroy(rac_model_registry_handle_t handle) {
         return;
     }
 
-    // Free all stored models
-    for (auto& pair : handle->models) {
-        free_model_info(pair.second);
-    }
-    handle->models.clear();
-
+    // Models are freed when the last snapshot referencing them is released
     delete handle;
     RAC_LOG_DEBUG("ModelRegistry", "Model registry destroyed");
 }
@@ -160,23 +403,19 @@ rac_result_t rac_model_registry_save(rac_model_registry_handle_t handle,
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
-
-    std::string model_id = model->id;
-
-    // If model already exists, free the old one
-    auto it = handle->models.find(model_id);
-    if (it != handle->models.end()) {
-        free_model_info(it->second);
-    }
-
-    // Store a deep copy
+    // Copy before taking the writer lock
     rac_model_info_t* copy = deep_copy_model(model);
     if (!copy) {
         return RAC_ERROR_OUT_OF_MEMORY;
     }
+    std::string model_id = copy->id;
+    ModelPtr stored = make_model_ptr(copy);
 
-    handle->models[model_id] = copy;
+    handle->modify([&](ModelMap& models) {
+        handle->forget_unverified(model_id);
+        models[model_id] = std::move(stored);
+        return RAC_SUCCESS;
+    });
 
     RAC_LOG_DEBUG("ModelRegistry", "Model saved");
 
@@ -189,14 +428,13 @@ rac_result_t rac_model_registry_get(rac_model_registry_handle_t handle, const ch
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
-
-    auto it = handle->models.find(model_id);
-    if (it == handle->models.end()) {
+    std::shared_ptr<const Snapshot> snapshot = handle->load_verified(model_id);
+    const rac_model_info_t* model = snapshot->find(model_id);
+    if (!model) {
         return RAC_ERROR_NOT_FOUND;
     }
 
-    *out_model = deep_copy_model(it->second);
+    *out_model = deep_copy_model(model);
     if (!*out_model) {
         return RAC_ERROR_OUT_OF_MEMORY;
     }
@@ -211,42 +449,22 @@ rac_result_t rac_model_registry_get_by_path(rac_model_registry_handle_t handle,
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
-
-    // Search through all models for matching local_path
-    for (const auto& pair : handle->models) {
-        const rac_model_info_t* model = pair.second;
-        if (model->local_path && strcmp(model->local_path, local_path) == 0) {
-            *out_model = deep_copy_model(model);
-            if (!*out_model) {
-                return RAC_ERROR_OUT_OF_MEMORY;
-            }
-            RAC_LOG_DEBUG("ModelRegistry", "Found model by path: %s -> %s", local_path, model->id);
-            return RAC_SUCCESS;
-        }
+    std::shared_ptr<const Snapshot> snapshot = handle->load();
+    const rac_model_info_t* model = snapshot->find_by_path(local_path);
+    if (model && handle->has_unverified.load(std::memory_order_acquire)) {
+        snapshot = handle->load_verified(model->id);
+        model = snapshot->find_by_path(local_path);
     }
-
-    // Also check if the path starts with or contains the local_path
-    // This handles cases where the input path has extra components
-    std::string search_path(local_path);
-    for (const auto& pair : handle->models) {
-        const rac_model_info_t* model = pair.second;
-        if (model->local_path) {
-            std::string model_path(model->local_path);
-            // Check if search path starts with model's local_path
-            if (search_path.find(model_path) == 0 || model_path.find(search_path) == 0) {
-                *out_model = deep_copy_model(model);
-                if (!*out_model) {
-                    return RAC_ERROR_OUT_OF_MEMORY;
-                }
-                RAC_LOG_DEBUG("ModelRegistry", "Found model by partial path match: %s -> %s",
-                              local_path, model->id);
-                return RAC_SUCCESS;
-            }
-        }
+    if (!model) {
+        return RAC_ERROR_NOT_FOUND;
     }
 
-    return RAC_ERROR_NOT_FOUND;
+    *out_model = deep_copy_model(model);
+    if (!*out_model) {
+        return RAC_ERROR_OUT_OF_MEMORY;
+    }
+    RAC_LOG_DEBUG("ModelRegistry", "Found model by path: %s -> %s", local_path, model->id);
+    return RAC_SUCCESS;
 }
 
 rac_result_t rac_model_registry_get_all(rac_model_registry_handle_t handle,
@@ -255,36 +473,8 @@ rac_result_t rac_model_registry_get_all(rac_model_registry_handle_t handle,
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
-
-    *out_count = handle->models.size();
-    if (*out_count == 0) {
-        *out_models = nullptr;
-        return RAC_SUCCESS;
-    }
-
-    *out_models = static_cast<rac_model_info_t**>(malloc(sizeof(rac_model_info_t*) * *out_count));
-    if (!*out_models) {
-        return RAC_ERROR_OUT_OF_MEMORY;
-    }
-
-    size_t i = 0;
-    for (const auto& pair : handle->models) {
-        (*out_models)[i] = deep_copy_model(pair.second);
-        if (!(*out_models)[i]) {
-            // Cleanup on error
-            for (size_t j = 0; j < i; ++j) {
-                free_model_info((*out_models)[j]);
-            }
-            free(*out_models);
-            *out_models = nullptr;
-            *out_count = 0;
-            return RAC_ERROR_OUT_OF_MEMORY;
-        }
-        ++i;
-    }
-
-    return RAC_SUCCESS;
+    std::shared_ptr<const Snapshot> snapshot = handle->load_verified(nullptr);
+    return copy_out(snapshot->all, out_models, out_count);
 }
 
 rac_result_t rac_model_registry_get_by_frameworks(rac_model_registry_handle_t handle,
@@ -296,46 +486,38 @@ rac_result_t rac_model_registry_get_by_frameworks(rac_model_registry_handle_t ha
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
+    std::shared_ptr<const Snapshot> snapshot = handle->load_verified(nullptr);
 
-    // Collect matching models
-    std::vector<rac_model_info_t*> matches;
+    // Merge the per-framework lists, keeping ID order
+    std::vector<rac_inference_framework_t> wanted(frameworks, frameworks + framework_count);
+    std::sort(wanted.begin(), wanted.end());
+    wanted.erase(std::unique(wanted.begin(), wanted.end()), wanted.end());
 
-    for (const auto& pair : handle->models) {
-        for (size_t i = 0; i < framework_count; ++i) {
-            if (pair.second->framework == frameworks[i]) {
-                matches.push_back(pair.second);
-                break;
-            }
-        }
+    ModelList matches;
+    for (rac_inference_framework_t framework : wanted) {
+        const ModelList& list = find_list(snapshot->by_framework, framework);
+        matches.insert(matches.end(), list.begin(), list.end());
     }
-
-    *out_count = matches.size();
-    if (*out_count == 0) {
-        *out_models = nullptr;
-        return RAC_SUCCESS;
+    if (wanted.size() > 1) {
+        std::sort(matches.begin(), matches.end(),
+                  [](const rac_model_info_t* a, const rac_model_info_t* b) {
+                      return strcmp(a->id, b->id) < 0;
+                  });
     }
 
-    *out_models = static_cast<rac_model_info_t**>(malloc(sizeof(rac_model_info_t*) * *out_count));
-    if (!*out_models) {
-        return RAC_ERROR_OUT_OF_MEMORY;
-    }
+    return copy_out(matches, out_models, out_count);
+}
 
-    for (size_t i = 0; i < matches.size(); ++i) {
-        (*out_models)[i] = deep_copy_model(matches[i]);
-        if (!(*out_models)[i]) {
-            // Cleanup on error
-            for (size_t j = 0; j < i; ++j) {
-                free_model_info((*out_models)[j]);
-            }
-            free(*out_models);
-            *out_models = nullptr;
-            *out_count = 0;
-            return RAC_ERROR_OUT_OF_MEMORY;
-        }
+rac_result_t rac_model_registry_get_by_category(rac_model_registry_handle_t handle,
+                                                rac_model_category_t category,
+                                                rac_model_info_t*** out_models,
+                                                size_t* out_count) {
+    if (!handle || !out_models || !out_count) {
+        return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    return RAC_SUCCESS;
+    std::shared_ptr<const Snapshot> snapshot = handle->load_verified(nullptr);
+    return copy_out(find_list(snapshot->by_category, category), out_models, out_count);
 }
 
 rac_result_t rac_model_registry_update_last_used(rac_model_registry_handle_t handle,
@@ -344,18 +526,21 @@ rac_result_t rac_model_registry_update_last_used(rac_model_registry_handle_t han
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
-
-    auto it = handle->models.find(model_id);
-    if (it == handle->models.end()) {
-        return RAC_ERROR_NOT_FOUND;
-    }
-
-    rac_model_info_t* model = it->second;
-    model->last_used = rac_get_current_time_ms() / 1000;  // Convert to seconds
-    model->usage_count++;
+    return handle->modify([&](ModelMap& models) {
+        auto it = models.find(std::string_view(model_id));
+        if (it == models.end()) {
+            return RAC_ERROR_NOT_FOUND;
+        }
 
-    return RAC_SUCCESS;
+        rac_model_info_t* model = deep_copy_model(it->second.get());
+        if (!model) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+        model->last_used = rac_get_current_time_ms() / 1000;  // Convert to seconds
+        model->usage_count++;
+        it->second = make_model_ptr(model);
+        return RAC_SUCCESS;
+    });
 }
 
 rac_result_t rac_model_registry_remove(rac_model_registry_handle_t handle, const char* model_id) {
@@ -363,19 +548,21 @@ rac_result_t rac_model_registry_remove(rac_model_registry_handle_t handle, const
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
+    rac_result_t result = handle->modify([&](ModelMap& models) {
+        auto it = models.find(std::string_view(model_id));
+        if (it == models.end()) {
+            return RAC_ERROR_NOT_FOUND;
+        }
+        handle->forget_unverified(model_id);
+        models.erase(it);
+        return RAC_SUCCESS;
+    });
 
-    auto it = handle->models.find(model_id);
-    if (it == handle->models.end()) {
-        return RAC_ERROR_NOT_FOUND;
+    if (result == RAC_SUCCESS) {
+        RAC_LOG_DEBUG("ModelRegistry", "Model removed");
     }
 
-    free_model_info(it->second);
-    handle->models.erase(it);
-
-    RAC_LOG_DEBUG("ModelRegistry", "Model removed");
-
-    return RAC_SUCCESS;
+    return result;
 }
 
 rac_result_t rac_model_registry_get_downloaded(rac_model_registry_handle_t handle,
@@ -384,70 +571,185 @@ rac_result_t rac_model_registry_get_downloaded(rac_model_registry_handle_t handl
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
+    std::shared_ptr<const Snapshot> snapshot = handle->load_verified(nullptr);
+    return copy_out(snapshot->downloaded, out_models, out_count);
+}
 
-    // Collect downloaded models
-    std::vector<rac_model_info_t*> downloaded;
+rac_result_t rac_model_registry_update_download_status(rac_model_registry_handle_t handle,
+                                                       const char* model_id,
+                                                       const char* local_path) {
+    if (!handle || !model_id) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
 
-    for (const auto& pair : handle->models) {
-        if (pair.second->local_path && strlen(pair.second->local_path) > 0) {
-            downloaded.push_back(pair.second);
+    return handle->modify([&](ModelMap& models) {
+        auto it = models.find(std::string_view(model_id));
+        if (it == models.end()) {
+            return RAC_ERROR_NOT_FOUND;
         }
-    }
 
-    *out_count = downloaded.size();
-    if (*out_count == 0) {
-        *out_models = nullptr;
+        rac_model_info_t* model = deep_copy_model(it->second.get());
+        if (!model) {
+            return RAC_ERROR_OUT_OF_MEMORY;
+        }
+
+        // Replace local path
+        handle->forget_unverified(model_id);
+        if (model->local_path) {
+            free(model->local_path);
+        }
+        model->local_path = rac_strdup(local_path);
+        model->updated_at = rac_get_current_time_ms() / 1000;
+        it->second = make_model_ptr(model);
         return RAC_SUCCESS;
+    });
+}
+
+uint64_t rac_model_registry_get_version(rac_model_registry_handle_t handle) {
+    return handle ? handle->load()->version : 0;
+}
+
+// =============================================================================
+// PUBLIC API - SNAPSHOTS
+// =============================================================================
+
+rac_result_t rac_model_registry_snapshot_acquire(rac_model_registry_handle_t handle,
+                                                 rac_model_registry_snapshot_t* out_snapshot) {
+    if (!handle || !out_snapshot) {
+        return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    *out_models = static_cast<rac_model_info_t**>(malloc(sizeof(rac_model_info_t*) * *out_count));
-    if (!*out_models) {
-        return RAC_ERROR_OUT_OF_MEMORY;
+    *out_snapshot = new rac_model_registry_snapshot{handle->load_verified(nullptr)};
+    return RAC_SUCCESS;
+}
+
+void rac_model_registry_snapshot_release(rac_model_registry_snapshot_t snapshot) {
+    delete snapshot;
+}
+
+uint64_t rac_model_registry_snapshot_version(rac_model_registry_snapshot_t snapshot) {
+    return snapshot ? snapshot->snapshot->version : 0;
+}
+
+const rac_model_info_t* rac_model_registry_snapshot_find(rac_model_registry_snapshot_t snapshot,
+                                                         const char* model_id) {
+    if (!snapshot || !model_id) {
+        return nullptr;
     }
+    return snapshot->snapshot->find(model_id);
+}
 
-    for (size_t i = 0; i < downloaded.size(); ++i) {
-        (*out_models)[i] = deep_copy_model(downloaded[i]);
-        if (!(*out_models)[i]) {
-            // Cleanup on error
-            for (size_t j = 0; j < i; ++j) {
-                free_model_info((*out_models)[j]);
-            }
-            free(*out_models);
-            *out_models = nullptr;
-            *out_count = 0;
-            return RAC_ERROR_OUT_OF_MEMORY;
-        }
+const rac_model_info_t* rac_model_registry_snapshot_find_by_path(
+    rac_model_registry_snapshot_t snapshot, const char* local_path) {
+    if (!snapshot || !local_path) {
+        return nullptr;
     }
+    return snapshot->snapshot->find_by_path(local_path);
+}
 
-    return RAC_SUCCESS;
+rac_result_t rac_model_registry_snapshot_get_all(rac_model_registry_snapshot_t snapshot,
+                                                 const rac_model_info_t* const** out_models,
+                                                 size_t* out_count) {
+    if (!snapshot || !out_models || !out_count) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    return borrow_out(snapshot->snapshot->all, out_models, out_count);
 }
 
-rac_result_t rac_model_registry_update_download_status(rac_model_registry_handle_t handle,
-                                                       const char* model_id,
-                                                       const char* local_path) {
-    if (!handle || !model_id) {
+rac_result_t rac_model_registry_snapshot_get_by_framework(
+    rac_model_registry_snapshot_t snapshot, rac_inference_framework_t framework,
+    const rac_model_info_t* const** out_models, size_t* out_count) {
+    if (!snapshot || !out_models || !out_count) {
         return RAC_ERROR_INVALID_ARGUMENT;
     }
+    return borrow_out(find_list(snapshot->snapshot->by_framework, framework), out_models,
+                      out_count);
+}
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
+rac_result_t rac_model_registry_snapshot_get_by_category(
+    rac_model_registry_snapshot_t snapshot, rac_model_category_t category,
+    const rac_model_info_t* const** out_models, size_t* out_count) {
+    if (!snapshot || !out_models || !out_count) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    return borrow_out(find_list(snapshot->snapshot->by_category, category), out_models,
+                      out_count);
+}
 
-    auto it = handle->models.find(model_id);
-    if (it == handle->models.end()) {
-        return RAC_ERROR_NOT_FOUND;
+rac_result_t rac_model_registry_snapshot_get_downloaded(rac_model_registry_snapshot_t snapshot,
+                                                        const rac_model_info_t* const** out_models,
+                                                        size_t* out_count) {
+    if (!snapshot || !out_models || !out_count) {
+        return RAC_ERROR_INVALID_ARGUMENT;
     }
+    return borrow_out(snapshot->snapshot->downloaded, out_models, out_count);
+}
 
-    rac_model_info_t* model = it->second;
+// =============================================================================
+// PUBLIC API - CATALOG
+// =============================================================================
 
-    // Free old local path
-    if (model->local_path) {
-        free(model->local_path);
+rac_result_t rac_model_registry_write_catalog(rac_model_registry_handle_t handle,
+                                              const char* catalog_path) {
+    if (!handle || !catalog_path) {
+        return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    // Set new local path
-    model->local_path = rac_strdup(local_path);
-    model->updated_at = rac_get_current_time_ms() / 1000;
+    std::shared_ptr<const Snapshot> snapshot = handle->load();
+    rac_result_t result =
+        rac_internal::write_model_catalog(catalog_path, snapshot->version, snapshot->all);
+    if (result == RAC_SUCCESS) {
+        RAC_LOG_DEBUG("ModelRegistry", "Wrote %zu models to catalog", snapshot->all.size());
+    }
+    return result;
+}
+
+rac_result_t rac_model_registry_load_catalog(rac_model_registry_handle_t handle,
+                                             const char* catalog_path, size_t* out_loaded) {
+    if (!handle || !catalog_path) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    if (out_loaded) {
+        *out_loaded = 0;
+    }
+
+    std::vector<rac_internal::CatalogEntry> entries;
+    uint64_t catalog_version = 0;
+    rac_result_t result = rac_internal::read_model_catalog(catalog_path, &entries, &catalog_version);
+    if (result != RAC_SUCCESS) {
+        return result;
+    }
 
+    std::vector<std::pair<ModelPtr, rac_internal::CatalogFileStamp>> loaded;
+    loaded.reserve(entries.size());
+    for (const rac_internal::CatalogEntry& entry : entries) {
+        loaded.emplace_back(make_model_ptr(entry.model), entry.stamp);
+    }
+
+    // One snapshot for the whole catalog. Models registered before the load
+    // are newer than the catalog and are kept.
+    size_t added = 0;
+    handle->modify([&](ModelMap& models) {
+        std::lock_guard<std::mutex> lock(handle->stamp_mutex);
+        for (auto& entry : loaded) {
+            const ModelPtr& model = entry.first;
+            if (!models.emplace(model->id, model).second) {
+                continue;
+            }
+            if (has_local_path(model.get())) {
+                handle->unverified[model->id] = entry.second;
+            }
+            ++added;
+        }
+        handle->has_unverified.store(!handle->unverified.empty(), std::memory_order_release);
+        return added > 0 ? RAC_SUCCESS : RAC_ERROR_NOT_FOUND;  // Nothing to publish
+    });
+
+    RAC_LOG_INFO("ModelRegistry", "Loaded %zu models from catalog (registry version %llu)", added,
+                 static_cast<unsigned long long>(catalog_version));
+    if (out_loaded) {
+        *out_loaded = added;
+    }
     return RAC_SUCCESS;
 }
 
@@ -600,12 +902,11 @@ rac_result_t rac_model_registry_discover_downloaded(rac_model_registry_handle_t
                                               RAC_FRAMEWORK_SYSTEM_TTS, RAC_FRAMEWORK_UNKNOWN};
     size_t framework_count = sizeof(frameworks) / sizeof(frameworks[0]);
 
-    // Collect discovered models
-    std::vector<rac_discovered_model_t> discovered;
+    // Scan against a snapshot so the platform callbacks run without any lock held
+    std::shared_ptr<const Snapshot> snapshot = handle->load_verified(nullptr);
+    std::vector<rac_discovered_model_t> found;
     size_t unregistered = 0;
 
-    std::lock_guard<std::mutex> lock(handle->mutex);
-
     for (size_t f = 0; f < framework_count; f++) {
         rac_inference_framework_t framework = frameworks[f];
 
@@ -654,27 +955,15 @@ rac_result_t rac_model_registry_discover_downloaded(rac_model_registry_handle_t
             }
 
             // Check if this model is registered
-            auto it = handle->models.find(model_id);
-            if (it != handle->models.end()) {
+            const rac_model_info_t* model = snapshot->find(model_id);
+            if (model) {
                 // Model is registered - check if it needs update
-                rac_model_info_t* model = it->second;
-
-                if (!model->local_path || strlen(model->local_path) == 0) {
-                    // Update the local path
-                    if (model->local_path) {
-                        free(model->local_path);
-                    }
-                    model->local_path = rac_strdup(model_path.c_str());
-                    model->updated_at = rac_get_current_time_ms() / 1000;
-
-                    // Add to discovered list
+                if (!has_local_path(model)) {
                     rac_discovered_model_t disc;
                     disc.model_id = rac_strdup(model_id);
                     disc.local_path = rac_strdup(model_path.c_str());
                     disc.framework = framework;
-                    discovered.push_back(disc);
-
-                    RAC_LOG_INFO("ModelRegistry", "Discovered downloaded model");
+                    found.push_back(disc);
                 }
             } else {
                 // Model folder exists but not registered
@@ -688,6 +977,37 @@ rac_result_t rac_model_registry_discover_downloaded(rac_model_registry_handle_t
         }
     }
 
+    // Record the local paths in one update. A model found under several
+    // frameworks, or given a path since the scan started, keeps its first path.
+    std::vector<rac_discovered_model_t> discovered;
+    handle->modify([&](ModelMap& models) {
+        for (const rac_discovered_model_t& disc : found) {
+            auto it = models.find(std::string_view(disc.model_id));
+            rac_model_info_t* model =
+                it != models.end() && !has_local_path(it->second.get())
+                    ? deep_copy_model(it->second.get())
+                    : nullptr;
+            if (!model) {
+                free(const_cast<char*>(disc.model_id));
+                free(const_cast<char*>(disc.local_path));
+                continue;
+            }
+
+            // Update the local path
+            if (model->local_path) {
+                free(model->local_path);
+            }
+            model->local_path = rac_strdup(disc.local_path);
+            model->updated_at = rac_get_current_time_ms() / 1000;
+            it->second = make_model_ptr(model);
+
+            // Add to discovered list
+            discovered.push_back(disc);
+            RAC_LOG_INFO("ModelRegistry", "Discovered downloaded model");
+        }
+        return discovered.empty() ? RAC_ERROR_NOT_FOUND : RAC_SUCCESS;  // Nothing to publish
+    });
+
     // Build result
     out_result->discovered_count = discovered.size();
     out_result->unregistered_count = unregistered;
@@ -3,21 +3,130 @@
  * @brief Telemetry manager implementation
  *
  * Handles event queuing, batching by modality, and HTTP callbacks.
+ *
+ * Tracking never blocks: events go into a bounded lock-free queue. Batches
+ * are serialized and handed to the HTTP callback only from
+ * rac_telemetry_manager_poll() and rac_telemetry_manager_flush(), so the
+ * callback always runs on a thread the platform owns. With a spool directory
+ * configured, requests the platform reports as failed are written to disk and
+ * replayed once a send succeeds again.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdlib>
 #include <cstring>
+#include <iterator>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <new>
 #include <set>
 #include <string>
 #include <vector>
 
+#include "infrastructure/telemetry/telemetry_spool.h"
 #include "rac/core/rac_logger.h"
 #include "rac/infrastructure/network/rac_endpoints.h"
 #include "rac/infrastructure/telemetry/rac_telemetry_manager.h"
 
+// Single-threaded WebAssembly builds have nobody to poll; flushes run inline there
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+#define RAC_TELEMETRY_INLINE_FLUSH 1
+#endif
+
+// =============================================================================
+// BOUNDED EVENT QUEUE
+// =============================================================================
+
+namespace {
+
+/**
+ * Bounded multi-producer queue of heap-allocated payloads (Vyukov's array
+ * queue). push() and pop() are lock-free and fail instead of waiting when the
+ * queue is full or empty.
+ */
+class BoundedEventQueue {
+public:
+    explicit BoundedEventQueue(size_t capacity_pow2)
+        : mask_(capacity_pow2 - 1), cells_(new Cell[capacity_pow2]) {
+        for (size_t i = 0; i < capacity_pow2; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool push(rac_telemetry_payload_t* item) {
+        size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.item = item;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    size_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;  // Full
+            } else {
+                pos = enqueue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    rac_telemetry_payload_t* pop() {
+        size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            size_t seq = cell.sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    rac_telemetry_payload_t* item = cell.item;
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    size_.fetch_sub(1, std::memory_order_relaxed);
+                    return item;
+                }
+            } else if (diff < 0) {
+                return nullptr;  // Empty
+            } else {
+                pos = dequeue_pos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Approximate; exact only when no push/pop is in progress
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence{0};
+        rac_telemetry_payload_t* item = nullptr;
+    };
+
+    const size_t mask_;
+    std::unique_ptr<Cell[]> cells_;
+    alignas(64) std::atomic<size_t> enqueue_pos_{0};
+    alignas(64) std::atomic<size_t> dequeue_pos_{0};
+    std::atomic<size_t> size_{0};
+};
+
+// A serialized request handed to the HTTP callback, kept until the platform
+// reports the outcome so a failure can be spooled
+struct PendingRequest {
+    std::string endpoint;
+    std::string body;
+    bool requires_auth = false;
+    bool from_spool = false;
+    int64_t sent_ms = 0;
+    rac_internal::TelemetrySpool::Record spool_record;
+};
+
+}  // namespace
+
 // =============================================================================
 // INTERNAL STRUCTURES
 // =============================================================================
@@ -31,13 +140,39 @@ struct rac_telemetry_manager {
     std::string device_model;
     std::string os_version;
 
-    // HTTP callback
+    // HTTP callback; at most one of the two is set
     rac_telemetry_http_callback_t http_callback;
+    rac_telemetry_http_request_callback_t http_request_callback;
     void* http_user_data;
 
-    // Event queue
-    std::vector<rac_telemetry_payload_t> queue;
-    std::mutex queue_mutex;
+    // Event queue (lock-free; tracking never waits on it)
+    static constexpr size_t QUEUE_CAPACITY = 1024;  // Power of two
+    BoundedEventQueue queue{QUEUE_CAPACITY};
+    std::atomic<uint64_t> dropped_events{0};
+
+    // Serializes draining the queue and invoking the HTTP callback
+    std::mutex send_mutex;
+
+    // Set by tracking when a flush trigger fires; the next poll sends
+    std::atomic<bool> flush_requested{false};
+
+    // Offline spool (optional). Guarded by spool_mutex, which is never held
+    // while the HTTP callback runs since platforms may report completion
+    // synchronously from inside it. Outcomes are only known for requests sent
+    // through http_request_callback, so only those are tracked in flight.
+    std::mutex spool_mutex;
+    std::unique_ptr<rac_internal::TelemetrySpool> spool;
+    std::map<uint64_t, PendingRequest> in_flight;  // By request id, oldest first
+    uint64_t next_request_id = 1;
+    uint64_t replay_request_id = 0;  // Spooled request being resent, 0 if none
+    bool offline = false;
+    int64_t retry_backoff_ms = 0;
+    int64_t next_retry_ms = 0;
+    static constexpr size_t MAX_IN_FLIGHT = 32;  // Older requests are assumed delivered
+    static constexpr int64_t IN_FLIGHT_TIMEOUT_MS = 120000;  // Then the outcome is assumed lost
+    static constexpr int64_t RETRY_BACKOFF_MIN_MS = 5000;
+    static constexpr int64_t RETRY_BACKOFF_MAX_MS = 300000;
+    static constexpr int REPLAY_PER_TICK = 16;
 
     // V2 modalities for grouping
     std::set<std::string> v2_modalities = {"llm", "stt", "tts", "model"};
@@ -45,7 +180,7 @@ struct rac_telemetry_manager {
     // Batching configuration
     static constexpr size_t BATCH_SIZE_PRODUCTION = 10;  // Flush after 10 events in production
     static constexpr int64_t BATCH_TIMEOUT_MS = 5000;    // Flush after 5 seconds in production
-    int64_t last_flush_time_ms = 0;                      // Track last flush time for timeout
+    std::atomic<int64_t> last_flush_time_ms{0};          // Track last flush time for timeout
 };
 
 // =============================================================================
@@ -320,6 +455,263 @@ const char* framework_to_string(rac_inference_framework_t framework) {
 
 }  // namespace
 
+// =============================================================================
+// FLUSH CYCLE
+// =============================================================================
+
+namespace {
+
+void free_payload(rac_telemetry_payload_t* event) {
+    free((void*)event->id);
+    free((void*)event->event_type);
+    free((void*)event->modality);
+    free((void*)event->device_id);
+    free((void*)event->session_id);
+    free((void*)event->model_id);
+    free((void*)event->model_name);
+    free((void*)event->framework);
+    free((void*)event->device);
+    free((void*)event->os_version);
+    free((void*)event->platform);
+    free((void*)event->sdk_version);
+    free((void*)event->error_message);
+    free((void*)event->error_code);
+    free((void*)event->language);
+    free((void*)event->voice);
+    free((void*)event->archive_type);
+    delete event;
+}
+
+bool has_http_callback(const rac_telemetry_manager_t* manager) {
+    return manager->http_callback || manager->http_request_callback;
+}
+
+// Outcomes are reported only for requests sent through the request callback,
+// so the spool is only used with that callback. Caller holds spool_mutex.
+bool tracks_outcomes(const rac_telemetry_manager_t* manager) {
+    return manager->spool && manager->http_request_callback;
+}
+
+// Stop waiting for a request's outcome. A spooled request stays on disk and is
+// resent by the next replay. Caller holds spool_mutex.
+void forget_in_flight(rac_telemetry_manager_t* manager,
+                      std::map<uint64_t, PendingRequest>::iterator it) {
+    if (it->first == manager->replay_request_id) {
+        manager->replay_request_id = 0;
+    }
+    manager->in_flight.erase(it);
+}
+
+// Give up on requests the platform never reported back on
+void expire_in_flight(rac_telemetry_manager_t* manager) {
+    std::lock_guard<std::mutex> lock(manager->spool_mutex);
+    const int64_t now = get_current_timestamp_ms();
+    for (auto it = manager->in_flight.begin(); it != manager->in_flight.end();) {
+        auto next = std::next(it);
+        if (now - it->second.sent_ms >= manager->IN_FLIGHT_TIMEOUT_MS) {
+            forget_in_flight(manager, it);
+        }
+        it = next;
+    }
+}
+
+// Hand a request to the platform. Caller holds send_mutex.
+void send_request(rac_telemetry_manager_t* manager, PendingRequest request) {
+    uint64_t request_id = 0;
+    {
+        std::lock_guard<std::mutex> lock(manager->spool_mutex);
+        request_id = manager->next_request_id++;
+        if (tracks_outcomes(manager)) {
+            if (manager->offline && !request.from_spool) {
+                // Known offline: straight to disk, replayed when a probe succeeds
+                manager->spool->append(request.endpoint, request.body.data(),
+                                       request.body.size(), request.requires_auth);
+                return;
+            }
+            if (request.from_spool) {
+                manager->replay_request_id = request_id;
+            }
+            request.sent_ms = get_current_timestamp_ms();
+            manager->in_flight.emplace(request_id, request);
+            while (manager->in_flight.size() > manager->MAX_IN_FLIGHT) {
+                forget_in_flight(manager, manager->in_flight.begin());
+            }
+        }
+    }
+
+    const rac_bool_t requires_auth = request.requires_auth ? RAC_TRUE : RAC_FALSE;
+    if (manager->http_request_callback) {
+        manager->http_request_callback(manager->http_user_data, request_id,
+                                       request.endpoint.c_str(), request.body.c_str(),
+                                       request.body.size(), requires_auth);
+    } else {
+        manager->http_callback(manager->http_user_data, request.endpoint.c_str(),
+                               request.body.c_str(), request.body.size(), requires_auth);
+    }
+}
+
+// Drain the queue and send it as batch requests. Caller holds send_mutex and
+// has checked http_callback.
+void drain_and_send(rac_telemetry_manager_t* manager) {
+    std::vector<rac_telemetry_payload_t> events;
+    std::vector<rac_telemetry_payload_t*> owned;
+    while (rac_telemetry_payload_t* event = manager->queue.pop()) {
+        events.push_back(*event);
+        owned.push_back(event);
+    }
+
+    if (events.empty()) {
+        return;
+    }
+
+    log_debug("Telemetry", "Flushing %zu telemetry events", events.size());
+
+    // Update last flush time
+    manager->last_flush_time_ms = get_current_timestamp_ms();
+
+    // Get endpoint
+    const char* endpoint = rac_endpoint_telemetry(manager->environment);
+    bool requires_auth = (manager->environment != RAC_ENV_DEVELOPMENT);
+
+    if (manager->environment == RAC_ENV_DEVELOPMENT) {
+        // Development: Send array directly to Supabase
+        rac_telemetry_batch_request_t batch = {};
+        batch.events = events.data();
+        batch.events_count = events.size();
+        batch.device_id = manager->device_id.c_str();
+        batch.timestamp_ms = get_current_timestamp_ms();
+        batch.modality = nullptr;  // Not used for development
+
+        char* json = nullptr;
+        size_t json_len = 0;
+        rac_result_t result =
+            rac_telemetry_manager_batch_to_json(&batch, manager->environment, &json, &json_len);
+
+        if (result == RAC_SUCCESS && json) {
+            PendingRequest request;
+            request.endpoint = endpoint;
+            request.body.assign(json, json_len);
+            request.requires_auth = requires_auth;
+            free(json);
+            send_request(manager, std::move(request));
+        }
+    } else {
+        // Production: Group by modality and send batch requests
+        std::map<std::string, std::vector<rac_telemetry_payload_t>> by_modality;
+
+        for (const auto& event : events) {
+            std::string modality = event.modality ? event.modality : "system";
+            // For "system" events, use V1 path (modality = nullptr)
+            if (manager->v2_modalities.find(modality) == manager->v2_modalities.end()) {
+                modality = "system";
+            }
+            by_modality[modality].push_back(event);
+        }
+
+        for (const auto& pair : by_modality) {
+            const std::string& modality = pair.first;
+            const auto& modality_events = pair.second;
+
+            rac_telemetry_batch_request_t batch = {};
+            batch.events = const_cast<rac_telemetry_payload_t*>(modality_events.data());
+            batch.events_count = modality_events.size();
+            batch.device_id = manager->device_id.c_str();
+            batch.timestamp_ms = get_current_timestamp_ms();
+            batch.modality = (modality == "system") ? nullptr : modality.c_str();
+
+            char* json = nullptr;
+            size_t json_len = 0;
+            rac_result_t result =
+                rac_telemetry_manager_batch_to_json(&batch, manager->environment, &json, &json_len);
+
+            if (result == RAC_SUCCESS && json) {
+                // WARN: Log production telemetry payload for debugging (first 500 chars)
+                log_debug("Telemetry",
+                          "Sending production telemetry (modality=%s, %zu bytes): %.500s",
+                          modality.c_str(), json_len, json);
+                PendingRequest request;
+                request.endpoint = endpoint;
+                request.body.assign(json, json_len);
+                request.requires_auth = true;  // Production always requires auth
+                free(json);
+                send_request(manager, std::move(request));
+            }
+        }
+    }
+
+    for (auto* event : owned) {
+        free_payload(event);
+    }
+}
+
+// Resend spooled requests oldest-first, one in flight at a time. While
+// offline only a single probe goes out per retry interval. Caller holds
+// send_mutex and has checked http_callback.
+void replay_spool(rac_telemetry_manager_t* manager) {
+    for (int i = 0; i < manager->REPLAY_PER_TICK; ++i) {
+        PendingRequest request;
+        bool probe = false;
+        {
+            std::lock_guard<std::mutex> lock(manager->spool_mutex);
+            if (!tracks_outcomes(manager) || manager->replay_request_id != 0) {
+                return;
+            }
+            if (manager->offline) {
+                if (get_current_timestamp_ms() < manager->next_retry_ms) {
+                    return;
+                }
+                probe = true;
+                manager->next_retry_ms = get_current_timestamp_ms() + manager->retry_backoff_ms;
+            }
+            if (!manager->spool->peek(request.spool_record)) {
+                manager->offline = false;  // Nothing to probe with; the next batch will do
+                return;
+            }
+        }
+        request.endpoint = request.spool_record.endpoint;
+        request.body = request.spool_record.body;
+        request.requires_auth = request.spool_record.requires_auth;
+        request.from_spool = true;
+        send_request(manager, std::move(request));
+        if (probe) {
+            return;
+        }
+    }
+}
+
+// One poll: send the queue when a flush was requested or the batch timeout
+// has passed, then replay anything spooled. Returns false without a callback.
+bool run_flush_cycle(rac_telemetry_manager_t* manager, bool force) {
+    std::lock_guard<std::mutex> lock(manager->send_mutex);
+    if (!has_http_callback(manager)) {
+        return false;
+    }
+
+    const bool requested = manager->flush_requested.exchange(false) || force;
+    const int64_t last_flush = manager->last_flush_time_ms;
+    const bool timed_out =
+        manager->queue.size() > 0 &&
+        (last_flush == 0 ||
+         get_current_timestamp_ms() - last_flush >= manager->BATCH_TIMEOUT_MS);
+    if (requested || timed_out) {
+        drain_and_send(manager);
+    }
+    expire_in_flight(manager);
+    replay_spool(manager);
+    return true;
+}
+
+// Mark the queue for sending on the next poll; never blocks the caller
+void request_flush(rac_telemetry_manager_t* manager) {
+#ifdef RAC_TELEMETRY_INLINE_FLUSH
+    run_flush_cycle(manager, true);
+#else
+    manager->flush_requested.store(true);
+#endif
+}
+
+}  // namespace
+
 // =============================================================================
 // LIFECYCLE
 // =============================================================================
@@ -336,6 +728,7 @@ rac_telemetry_manager_t* rac_telemetry_manager_create(rac_environment_t env, con
     manager->platform = platform ? platform : "";
     manager->sdk_version = sdk_version ? sdk_version : "";
     manager->http_callback = nullptr;
+    manager->http_request_callback = nullptr;
     manager->http_user_data = nullptr;
     manager->last_flush_time_ms = 0;  // Initialize to 0 (will be set on first flush)
 
@@ -348,8 +741,11 @@ void rac_telemetry_manager_destroy(rac_telemetry_manager_t* manager) {
     if (!manager)
         return;
 
-    // Flush any remaining events
+    // Flush any remaining events on this thread
     rac_telemetry_manager_flush(manager);
+    while (rac_telemetry_payload_t* event = manager->queue.pop()) {
+        free_payload(event);  // No HTTP callback was ever registered
+    }
 
     delete manager;
     log_debug("Telemetry", "Telemetry manager destroyed");
@@ -370,10 +766,72 @@ void rac_telemetry_manager_set_http_callback(rac_telemetry_manager_t* manager,
     if (!manager)
         return;
 
+    std::lock_guard<std::mutex> lock(manager->send_mutex);
     manager->http_callback = callback;
+    manager->http_request_callback = nullptr;
+    manager->http_user_data = user_data;
+}
+
+void rac_telemetry_manager_set_http_request_callback(rac_telemetry_manager_t* manager,
+                                                     rac_telemetry_http_request_callback_t callback,
+                                                     void* user_data) {
+    if (!manager)
+        return;
+
+    std::lock_guard<std::mutex> lock(manager->send_mutex);
+    manager->http_callback = nullptr;
+    manager->http_request_callback = callback;
     manager->http_user_data = user_data;
 }
 
+rac_result_t rac_telemetry_manager_set_spool(rac_telemetry_manager_t* manager,
+                                             const char* directory, uint64_t max_bytes) {
+    if (!manager) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    std::unique_ptr<rac_internal::TelemetrySpool> spool;
+    if (directory) {
+        if (!rac_internal::TelemetrySpool::supported()) {
+            return RAC_ERROR_NOT_SUPPORTED;
+        }
+        spool = rac_internal::TelemetrySpool::open(directory, static_cast<size_t>(max_bytes));
+        if (!spool) {
+            log_warning("Telemetry", "Failed to open telemetry spool at %s", directory);
+            return RAC_ERROR_FILE_WRITE_FAILED;
+        }
+    }
+
+    std::lock_guard<std::mutex> send_lock(manager->send_mutex);
+    std::lock_guard<std::mutex> lock(manager->spool_mutex);
+    manager->spool = std::move(spool);
+    manager->in_flight.clear();
+    manager->replay_request_id = 0;
+    manager->offline = false;
+    manager->retry_backoff_ms = 0;
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_telemetry_manager_get_stats(rac_telemetry_manager_t* manager,
+                                             rac_telemetry_stats_t* out_stats) {
+    if (!manager || !out_stats) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    *out_stats = {};
+    out_stats->queued_events = manager->queue.size();
+    out_stats->dropped_events = manager->dropped_events.load();
+
+    std::lock_guard<std::mutex> lock(manager->spool_mutex);
+    if (manager->spool) {
+        out_stats->spooled_requests = manager->spool->pending_records();
+        out_stats->spool_bytes = manager->spool->size_bytes();
+        out_stats->evicted_requests = manager->spool->evicted_records();
+    }
+    out_stats->offline = manager->offline ? RAC_TRUE : RAC_FALSE;
+    return RAC_SUCCESS;
+}
+
 // =============================================================================
 // EVENT TRACKING
 // =============================================================================
@@ -385,81 +843,56 @@ rac_result_t rac_telemetry_manager_track(rac_telemetry_manager_t* manager,
     }
 
     // Deep copy payload for queue
-    rac_telemetry_payload_t copy = *payload;
-    copy.id = dup_string(payload->id);
-    copy.event_type = dup_string(payload->event_type);
-    copy.modality = dup_string(payload->modality);
-    copy.device_id = dup_string(manager->device_id.c_str());
-    copy.session_id = dup_string(payload->session_id);
-    copy.model_id = dup_string(payload->model_id);
-    copy.model_name = dup_string(payload->model_name);
-    copy.framework = dup_string(payload->framework);
-    copy.device = dup_string(manager->device_model.c_str());
-    copy.os_version = dup_string(manager->os_version.c_str());
-    copy.platform = dup_string(manager->platform.c_str());
-    copy.sdk_version = dup_string(manager->sdk_version.c_str());
-    copy.error_message = dup_string(payload->error_message);
-    copy.error_code = dup_string(payload->error_code);
-    copy.language = dup_string(payload->language);
-    copy.voice = dup_string(payload->voice);
-    copy.archive_type = dup_string(payload->archive_type);
-
-    {
-        std::lock_guard<std::mutex> lock(manager->queue_mutex);
-        manager->queue.push_back(copy);
+    auto* copy = new (std::nothrow) rac_telemetry_payload_t(*payload);
+    if (!copy) {
+        return RAC_ERROR_OUT_OF_MEMORY;
     }
-
-    // Use WARN level for production visibility (INFO is filtered in production)
-    log_debug("Telemetry", "Telemetry event queued: %s", payload->event_type);
-
-    // Auto-flush logic
-    if (!manager->http_callback) {
-        log_debug("Telemetry", "HTTP callback not set, skipping auto-flush");
-        return RAC_SUCCESS;
+    copy->id = dup_string(payload->id);
+    copy->event_type = dup_string(payload->event_type);
+    copy->modality = dup_string(payload->modality);
+    copy->device_id = dup_string(manager->device_id.c_str());
+    copy->session_id = dup_string(payload->session_id);
+    copy->model_id = dup_string(payload->model_id);
+    copy->model_name = dup_string(payload->model_name);
+    copy->framework = dup_string(payload->framework);
+    copy->device = dup_string(manager->device_model.c_str());
+    copy->os_version = dup_string(manager->os_version.c_str());
+    copy->platform = dup_string(manager->platform.c_str());
+    copy->sdk_version = dup_string(manager->sdk_version.c_str());
+    copy->error_message = dup_string(payload->error_message);
+    copy->error_code = dup_string(payload->error_code);
+    copy->language = dup_string(payload->language);
+    copy->voice = dup_string(payload->voice);
+    copy->archive_type = dup_string(payload->archive_type);
+
+    if (!manager->queue.push(copy)) {
+        // Never wait for a flush; shed load instead
+        free_payload(copy);
+        uint64_t dropped = ++manager->dropped_events;
+        if ((dropped & (dropped - 1)) == 0) {  // Log at powers of two
+            log_warning("Telemetry", "Telemetry queue full, %llu events dropped",
+                        static_cast<unsigned long long>(dropped));
+        }
+        return RAC_ERROR_SERVICE_BUSY;
     }
 
-    bool should_flush = false;
-    size_t queue_size = 0;
-    int64_t current_time = get_current_timestamp_ms();
+    log_debug("Telemetry", "Telemetry event queued: %s", payload->event_type);
 
-    {
-        std::lock_guard<std::mutex> lock(manager->queue_mutex);
-        queue_size = manager->queue.size();
-    }
+    // Auto-flush logic; the next poll does the sending and applies the batch
+    // timeout
+    size_t queue_size = manager->queue.size();
 
     if (manager->environment == RAC_ENV_DEVELOPMENT) {
         // Development: Immediate flush for real-time debugging
-        should_flush = true;
         log_debug("Telemetry", "Development mode: auto-flushing immediately (queue size: %zu)",
                   queue_size);
-    } else {
-        // Production: Flush based on batch size or timeout
+        request_flush(manager);
+    } else if (queue_size >= manager->BATCH_SIZE_PRODUCTION) {
+        // Production: Flush if queue reaches batch size
         // (completion events are handled in rac_telemetry_manager_track_analytics)
-        // Flush if queue reaches batch size
-        if (queue_size >= manager->BATCH_SIZE_PRODUCTION) {
-            should_flush = true;
-            log_debug("Telemetry", "Auto-flushing: queue size (%zu) >= batch size (%zu)",
-                      queue_size, manager->BATCH_SIZE_PRODUCTION);
-        }
-        // Flush if timeout reached (5 seconds since last flush)
-        else if (manager->last_flush_time_ms > 0 &&
-                 (current_time - manager->last_flush_time_ms) >= manager->BATCH_TIMEOUT_MS) {
-            should_flush = true;
-            log_debug("Telemetry", "Auto-flushing: timeout reached (%lld ms since last flush)",
-                      current_time - manager->last_flush_time_ms);
-        }
-        // First flush: start the timer by flushing immediately if we have events
-        else if (manager->last_flush_time_ms == 0 && queue_size > 0) {
-            should_flush = true;
-            log_debug("Telemetry", "Production: first flush to start timer (queue size: %zu)",
-                      queue_size);
-        }
-    }
-
-    if (should_flush) {
-        log_debug("Telemetry", "Triggering auto-flush (queue size: %zu)", queue_size);
-        rac_telemetry_manager_flush(manager);
-        // Note: last_flush_time_ms is updated inside flush()
+        log_debug("Telemetry", "Auto-flushing: queue size (%zu) >= batch size (%zu)", queue_size,
+                  manager->BATCH_SIZE_PRODUCTION);
+        request_flush(manager);
     }
 
     return RAC_SUCCESS;
@@ -682,9 +1115,9 @@ rac_result_t rac_telemetry_manager_track_analytics(rac_telemetry_manager_t* mana
     // For completion/failure events in production, trigger immediate flush
     // This ensures important terminal events are captured before app exits
     if (result == RAC_SUCCESS && manager->environment != RAC_ENV_DEVELOPMENT &&
-        is_completion_event(event_type) && manager->http_callback) {
+        is_completion_event(event_type)) {
         log_debug("Telemetry", "Completion event detected, triggering immediate flush");
-        rac_telemetry_manager_flush(manager);
+        request_flush(manager);
     }
 
     return result;
@@ -699,115 +1132,22 @@ rac_result_t rac_telemetry_manager_flush(rac_telemetry_manager_t* manager) {
         return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    if (!manager->http_callback) {
+    std::lock_guard<std::mutex> lock(manager->send_mutex);
+    if (!has_http_callback(manager)) {
         log_debug("Telemetry", "No HTTP callback registered, cannot flush telemetry");
         return RAC_ERROR_NOT_INITIALIZED;
     }
 
-    // Get events from queue
-    std::vector<rac_telemetry_payload_t> events;
-    {
-        std::lock_guard<std::mutex> lock(manager->queue_mutex);
-        events = std::move(manager->queue);
-        manager->queue.clear();
-    }
-
-    if (events.empty()) {
-        return RAC_SUCCESS;
-    }
-
-    log_debug("Telemetry", "Flushing %zu telemetry events", events.size());
-
-    // Update last flush time
-    manager->last_flush_time_ms = get_current_timestamp_ms();
-
-    // Get endpoint
-    const char* endpoint = rac_endpoint_telemetry(manager->environment);
-    bool requires_auth = (manager->environment != RAC_ENV_DEVELOPMENT);
-
-    if (manager->environment == RAC_ENV_DEVELOPMENT) {
-        // Development: Send array directly to Supabase
-        rac_telemetry_batch_request_t batch = {};
-        batch.events = events.data();
-        batch.events_count = events.size();
-        batch.device_id = manager->device_id.c_str();
-        batch.timestamp_ms = get_current_timestamp_ms();
-        batch.modality = nullptr;  // Not used for development
-
-        char* json = nullptr;
-        size_t json_len = 0;
-        rac_result_t result =
-            rac_telemetry_manager_batch_to_json(&batch, manager->environment, &json, &json_len);
-
-        if (result == RAC_SUCCESS && json) {
-            manager->http_callback(manager->http_user_data, endpoint, json, json_len,
-                                   requires_auth ? RAC_TRUE : RAC_FALSE);
-            free(json);
-        }
-    } else {
-        // Production: Group by modality and send batch requests
-        std::map<std::string, std::vector<rac_telemetry_payload_t>> by_modality;
-
-        for (const auto& event : events) {
-            std::string modality = event.modality ? event.modality : "system";
-            // For "system" events, use V1 path (modality = nullptr)
-            if (manager->v2_modalities.find(modality) == manager->v2_modalities.end()) {
-                modality = "system";
-            }
-            by_modality[modality].push_back(event);
-        }
-
-        for (const auto& pair : by_modality) {
-            const std::string& modality = pair.first;
-            const auto& modality_events = pair.second;
-
-            rac_telemetry_batch_request_t batch = {};
-            batch.events = const_cast<rac_telemetry_payload_t*>(modality_events.data());
-            batch.events_count = modality_events.size();
-            batch.device_id = manager->device_id.c_str();
-            batch.timestamp_ms = get_current_timestamp_ms();
-            batch.modality = (modality == "system") ? nullptr : modality.c_str();
-
-            char* json = nullptr;
-            size_t json_len = 0;
-            rac_result_t result =
-                rac_telemetry_manager_batch_to_json(&batch, manager->environment, &json, &json_len);
-
-            if (result == RAC_SUCCESS && json) {
-                // WARN: Log production telemetry payload for debugging (first 500 chars)
-                log_debug("Telemetry",
-                          "Sending production telemetry (modality=%s, %zu bytes): %.500s",
-                          modality.c_str(), json_len, json);
-                manager->http_callback(manager->http_user_data, endpoint, json, json_len,
-                                       RAC_TRUE  // Production always requires auth
-                );
-                free(json);
-            }
-        }
-    }
+    drain_and_send(manager);
+    return RAC_SUCCESS;
+}
 
-    // Free duplicated strings in events
-    for (auto& event : events) {
-        free((void*)event.id);
-        free((void*)event.event_type);
-        free((void*)event.modality);
-        free((void*)event.device_id);
-        free((void*)event.session_id);
-        free((void*)event.model_id);
-        free((void*)event.model_name);
-        free((void*)event.framework);
-        free((void*)event.device);
-        free((void*)event.os_version);
-        free((void*)event.platform);
-        free((void*)event.sdk_version);
-        free((void*)event.error_message);
-        free((void*)event.error_code);
-        free((void*)event.language);
-        free((void*)event.voice);
-        free((void*)event.archive_type);
+rac_result_t rac_telemetry_manager_poll(rac_telemetry_manager_t* manager) {
+    if (!manager) {
+        return RAC_ERROR_INVALID_ARGUMENT;
     }
 
-    return RAC_SUCCESS;
+    return run_flush_cycle(manager, false) ? RAC_SUCCESS : RAC_ERROR_NOT_INITIALIZED;
 }
 
 void rac_telemetry_manager_http_complete(rac_telemetry_manager_t* manager, rac_bool_t success,
@@ -815,12 +1155,47 @@ void rac_telemetry_manager_http_complete(rac_telemetry_manager_t* manager, rac_b
     if (!manager)
         return;
 
+    // Requests from the legacy callback are not tracked, so there is nothing to match
     if (success) {
         log_debug("Telemetry", "Telemetry HTTP request completed successfully");
     } else {
         log_warning("Telemetry", "Telemetry HTTP request failed: %s",
                     error_message ? error_message : "unknown");
     }
+}
+
+void rac_telemetry_manager_http_request_complete(rac_telemetry_manager_t* manager,
+                                                 uint64_t request_id, rac_bool_t success,
+                                                 const char* response_json,
+                                                 const char* error_message) {
+    if (!manager)
+        return;
 
-    // Could parse response and handle retries here if needed
+    rac_telemetry_manager_http_complete(manager, success, response_json, error_message);
+
+    std::lock_guard<std::mutex> lock(manager->spool_mutex);
+    auto it = manager->in_flight.find(request_id);
+    if (it == manager->in_flight.end() || !manager->spool) {
+        return;  // Untracked, already given up on, or the spool was reset
+    }
+    PendingRequest request = std::move(it->second);
+    forget_in_flight(manager, it);
+
+    if (success) {
+        if (request.from_spool) {
+            manager->spool->consume(request.spool_record);
+        }
+        manager->offline = false;
+        manager->retry_backoff_ms = 0;
+    } else {
+        if (!request.from_spool) {
+            manager->spool->append(request.endpoint, request.body.data(), request.body.size(),
+                                   request.requires_auth);
+        }
+        manager->offline = true;
+        manager->retry_backoff_ms =
+            std::min(manager->RETRY_BACKOFF_MAX_MS,
+                     std::max(manager->RETRY_BACKOFF_MIN_MS, manager->retry_backoff_ms * 2));
+        manager->next_retry_ms = get_current_timestamp_ms() + manager->retry_backoff_ms;
+    }
 }
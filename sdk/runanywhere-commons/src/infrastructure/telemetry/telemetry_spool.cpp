@@ -0,0 +1,408 @@
+/**
+ * @file telemetry_spool.cpp
+ * @brief Append-only on-disk telemetry spool (memory-mapped segments)
+ *
+ * Segment layout:
+ *   SegmentHeader (16 bytes)
+ *   Record*        8-byte aligned: RecordHeader, endpoint bytes, body bytes
+ *   zero bytes     unwritten tail (files are pre-sized with ftruncate)
+ *
+ * A record's magic is written last, so a record torn by a crash reads as
+ * zero and marks the end of the segment.
+ */
+
+#include "infrastructure/telemetry/telemetry_spool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "rac/core/rac_logger.h"
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+#define RAC_TELEMETRY_SPOOL_SUPPORTED 1
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace rac_internal {
+
+namespace {
+
+const char* const LOG_CAT = "TelemetrySpool";
+
+constexpr char SEGMENT_MAGIC[8] = {'R', 'A', 'C', 'S', 'P', 'O', 'O', 'L'};
+constexpr uint32_t SEGMENT_VERSION = 1;
+constexpr uint32_t RECORD_LIVE = 0x4C435452;      // "RTCL"
+constexpr uint32_t RECORD_CONSUMED = 0x44435452;  // "RTCD"
+
+struct SegmentHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t reserved;
+};
+static_assert(sizeof(SegmentHeader) == 16, "segment header layout");
+
+struct RecordHeader {
+    uint32_t magic;
+    uint32_t body_length;
+    uint16_t endpoint_length;
+    uint8_t requires_auth;
+    uint8_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 12, "record header layout");
+
+constexpr size_t align8(size_t n) {
+    return (n + 7) & ~static_cast<size_t>(7);
+}
+
+constexpr size_t record_bytes(size_t endpoint_length, size_t body_length) {
+    return align8(sizeof(RecordHeader) + endpoint_length + body_length);
+}
+
+const char* const SEGMENT_PREFIX = "telemetry-";
+const char* const SEGMENT_SUFFIX = ".spool";
+
+std::string segment_path(const std::string& directory, uint64_t seq) {
+    char name[64];
+    snprintf(name, sizeof(name), "%s%016llu%s", SEGMENT_PREFIX,
+             static_cast<unsigned long long>(seq), SEGMENT_SUFFIX);
+    return directory + "/" + name;
+}
+
+// Read the header at offset; false at end of data or on a corrupt record
+bool read_record_header(const uint8_t* data, size_t size, size_t offset, RecordHeader& out) {
+    if (offset + sizeof(RecordHeader) > size) {
+        return false;
+    }
+    std::memcpy(&out, data + offset, sizeof(RecordHeader));
+    if (out.magic != RECORD_LIVE && out.magic != RECORD_CONSUMED) {
+        return false;
+    }
+    return offset + record_bytes(out.endpoint_length, out.body_length) <= size;
+}
+
+}  // namespace
+
+TelemetrySpool::TelemetrySpool(std::string directory, size_t max_bytes, size_t segment_bytes)
+    : directory_(std::move(directory)),
+      max_bytes_(max_bytes),
+      segment_bytes_(std::max(segment_bytes, sizeof(SegmentHeader) + 4096)) {}
+
+TelemetrySpool::~TelemetrySpool() {
+    for (auto& segment : segments_) {
+        close_segment(segment, false);
+    }
+}
+
+bool TelemetrySpool::supported() {
+#ifdef RAC_TELEMETRY_SPOOL_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+std::unique_ptr<TelemetrySpool> TelemetrySpool::open(const std::string& directory,
+                                                     size_t max_bytes, size_t segment_bytes) {
+#ifdef RAC_TELEMETRY_SPOOL_SUPPORTED
+    if (directory.empty() || max_bytes == 0) {
+        return nullptr;
+    }
+    if (mkdir(directory.c_str(), 0700) != 0 && errno != EEXIST) {
+        RAC_LOG_WARNING(LOG_CAT, "Cannot create spool directory %s", directory.c_str());
+        return nullptr;
+    }
+
+    std::unique_ptr<TelemetrySpool> spool(new TelemetrySpool(directory, max_bytes, segment_bytes));
+    if (!spool->load_existing()) {
+        return nullptr;
+    }
+    if (spool->pending_records_ > 0) {
+        RAC_LOG_INFO(LOG_CAT, "Recovered %zu spooled telemetry requests", spool->pending_records_);
+    }
+    return spool;
+#else
+    (void)directory;
+    (void)max_bytes;
+    (void)segment_bytes;
+    return nullptr;
+#endif
+}
+
+bool TelemetrySpool::load_existing() {
+#ifdef RAC_TELEMETRY_SPOOL_SUPPORTED
+    DIR* dir = opendir(directory_.c_str());
+    if (!dir) {
+        return false;
+    }
+
+    std::vector<uint64_t> seqs;
+    const size_t prefix_len = std::strlen(SEGMENT_PREFIX);
+    const size_t suffix_len = std::strlen(SEGMENT_SUFFIX);
+    while (struct dirent* entry = readdir(dir)) {
+        const char* name = entry->d_name;
+        size_t len = std::strlen(name);
+        if (len <= prefix_len + suffix_len || std::strncmp(name, SEGMENT_PREFIX, prefix_len) != 0 ||
+            std::strcmp(name + len - suffix_len, SEGMENT_SUFFIX) != 0) {
+            continue;
+        }
+        char* end = nullptr;
+        uint64_t seq = std::strtoull(name + prefix_len, &end, 10);
+        if (end == name + len - suffix_len) {
+            seqs.push_back(seq);
+        }
+    }
+    closedir(dir);
+    std::sort(seqs.begin(), seqs.end());
+
+    for (uint64_t seq : seqs) {
+        Segment segment;
+        segment.seq = seq;
+        segment.path = segment_path(directory_, seq);
+        next_seq_ = seq + 1;
+        if (!map_segment(segment, false)) {
+            unlink(segment.path.c_str());
+            continue;
+        }
+
+        // Find the end of written data and count live records
+        size_t offset = sizeof(SegmentHeader);
+        bool read_offset_set = false;
+        RecordHeader header;
+        while (read_record_header(segment.data, segment.size, offset, header)) {
+            if (header.magic == RECORD_LIVE) {
+                segment.live_records++;
+                if (!read_offset_set) {
+                    segment.read_offset = offset;
+                    read_offset_set = true;
+                }
+            }
+            offset += record_bytes(header.endpoint_length, header.body_length);
+        }
+        segment.write_offset = offset;
+        if (!read_offset_set) {
+            segment.read_offset = offset;
+        }
+
+        if (segment.live_records == 0) {
+            close_segment(segment, true);
+            continue;
+        }
+        pending_records_ += segment.live_records;
+        segments_.push_back(segment);
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool TelemetrySpool::map_segment(Segment& segment, bool create) {
+#ifdef RAC_TELEMETRY_SPOOL_SUPPORTED
+    int fd = ::open(segment.path.c_str(), create ? (O_RDWR | O_CREAT | O_EXCL) : O_RDWR, 0600);
+    if (fd < 0) {
+        return false;
+    }
+
+    if (create) {
+        if (ftruncate(fd, static_cast<off_t>(segment.size)) != 0) {
+            close(fd);
+            unlink(segment.path.c_str());
+            return false;
+        }
+    } else {
+        struct stat st {};
+        if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(SegmentHeader)) {
+            close(fd);
+            return false;
+        }
+        segment.size = static_cast<size_t>(st.st_size);
+    }
+
+    void* mapped = mmap(nullptr, segment.size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        if (create) {
+            unlink(segment.path.c_str());
+        }
+        return false;
+    }
+    segment.data = static_cast<uint8_t*>(mapped);
+
+    if (create) {
+        SegmentHeader header{};
+        std::memcpy(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC));
+        header.version = SEGMENT_VERSION;
+        std::memcpy(segment.data, &header, sizeof(header));
+        segment.write_offset = sizeof(SegmentHeader);
+        segment.read_offset = sizeof(SegmentHeader);
+    } else {
+        SegmentHeader header;
+        std::memcpy(&header, segment.data, sizeof(header));
+        if (std::memcmp(header.magic, SEGMENT_MAGIC, sizeof(SEGMENT_MAGIC)) != 0 ||
+            header.version != SEGMENT_VERSION) {
+            close_segment(segment, false);
+            return false;
+        }
+    }
+    return true;
+#else
+    (void)segment;
+    (void)create;
+    return false;
+#endif
+}
+
+void TelemetrySpool::close_segment(Segment& segment, bool remove_file) {
+#ifdef RAC_TELEMETRY_SPOOL_SUPPORTED
+    if (segment.data) {
+        munmap(segment.data, segment.size);
+        segment.data = nullptr;
+    }
+    if (remove_file) {
+        unlink(segment.path.c_str());
+    }
+#else
+    (void)segment;
+    (void)remove_file;
+#endif
+}
+
+size_t TelemetrySpool::size_bytes() const {
+    size_t total = 0;
+    for (const auto& segment : segments_) {
+        total += segment.size;
+    }
+    return total;
+}
+
+void TelemetrySpool::evict_oldest() {
+    Segment& oldest = segments_.front();
+    pending_records_ -= oldest.live_records;
+    evicted_records_ += oldest.live_records;
+    RAC_LOG_WARNING(LOG_CAT, "Spool over size cap, dropping %zu oldest telemetry requests",
+                    oldest.live_records);
+    close_segment(oldest, true);
+    segments_.pop_front();
+}
+
+TelemetrySpool::Segment* TelemetrySpool::writable_segment(size_t bytes) {
+    if (!segments_.empty()) {
+        Segment& last = segments_.back();
+        if (last.write_offset + bytes <= last.size) {
+            return &last;
+        }
+    }
+
+    // Oversized requests get a segment of their own
+    Segment segment;
+    segment.size = std::max(segment_bytes_, sizeof(SegmentHeader) + bytes);
+    if (segment.size > max_bytes_) {
+        return nullptr;
+    }
+    while (!segments_.empty() && size_bytes() + segment.size > max_bytes_) {
+        evict_oldest();
+    }
+
+    segment.seq = next_seq_++;
+    segment.path = segment_path(directory_, segment.seq);
+    if (!map_segment(segment, true)) {
+        RAC_LOG_WARNING(LOG_CAT, "Cannot create spool segment %s", segment.path.c_str());
+        return nullptr;
+    }
+    segments_.push_back(segment);
+    return &segments_.back();
+}
+
+bool TelemetrySpool::append(const std::string& endpoint, const char* body, size_t body_length,
+                            bool requires_auth) {
+    if (!body || endpoint.size() > UINT16_MAX || body_length > UINT32_MAX) {
+        return false;
+    }
+
+    const size_t bytes = record_bytes(endpoint.size(), body_length);
+    Segment* segment = writable_segment(bytes);
+    if (!segment) {
+        return false;
+    }
+
+    uint8_t* dst = segment->data + segment->write_offset;
+    RecordHeader header{};
+    header.magic = 0;  // Published last
+    header.body_length = static_cast<uint32_t>(body_length);
+    header.endpoint_length = static_cast<uint16_t>(endpoint.size());
+    header.requires_auth = requires_auth ? 1 : 0;
+    std::memcpy(dst, &header, sizeof(header));
+    std::memcpy(dst + sizeof(header), endpoint.data(), endpoint.size());
+    std::memcpy(dst + sizeof(header) + endpoint.size(), body, body_length);
+
+    std::atomic_thread_fence(std::memory_order_release);
+    const uint32_t live = RECORD_LIVE;
+    std::memcpy(dst, &live, sizeof(live));
+
+#ifdef RAC_TELEMETRY_SPOOL_SUPPORTED
+    // Let the kernel write back in the background; durability across a
+    // process crash comes from MAP_SHARED already
+    msync(segment->data, segment->size, MS_ASYNC);
+#endif
+
+    segment->write_offset += bytes;
+    segment->live_records++;
+    pending_records_++;
+    return true;
+}
+
+bool TelemetrySpool::peek(Record& out) {
+    for (auto& segment : segments_) {
+        RecordHeader header;
+        while (segment.read_offset < segment.write_offset &&
+               read_record_header(segment.data, segment.size, segment.read_offset, header)) {
+            if (header.magic == RECORD_LIVE) {
+                const char* payload =
+                    reinterpret_cast<const char*>(segment.data + segment.read_offset) +
+                    sizeof(RecordHeader);
+                out.segment = segment.seq;
+                out.offset = segment.read_offset;
+                out.endpoint.assign(payload, header.endpoint_length);
+                out.body.assign(payload + header.endpoint_length, header.body_length);
+                out.requires_auth = header.requires_auth != 0;
+                return true;
+            }
+            segment.read_offset += record_bytes(header.endpoint_length, header.body_length);
+        }
+    }
+    return false;
+}
+
+void TelemetrySpool::consume(const Record& record) {
+    auto it = std::find_if(segments_.begin(), segments_.end(),
+                           [&](const Segment& s) { return s.seq == record.segment; });
+    if (it == segments_.end()) {
+        return;  // Evicted while the replay was in flight
+    }
+
+    RecordHeader header;
+    if (!read_record_header(it->data, it->size, record.offset, header) ||
+        header.magic != RECORD_LIVE) {
+        return;
+    }
+    const uint32_t consumed = RECORD_CONSUMED;
+    std::memcpy(it->data + record.offset, &consumed, sizeof(consumed));
+    it->live_records--;
+    pending_records_--;
+
+    if (it->live_records == 0) {
+        close_segment(*it, true);
+        segments_.erase(it);
+    }
+}
+
+}  // namespace rac_internal
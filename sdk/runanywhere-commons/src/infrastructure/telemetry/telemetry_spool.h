@@ -0,0 +1,98 @@
+/**
+ * @file telemetry_spool.h
+ * @brief Append-only on-disk spool for telemetry requests that failed to send
+ *
+ * Requests are appended to fixed-size, memory-mapped segment files
+ * (telemetry-<seq>.spool) and replayed oldest-first once the network is back.
+ * Replayed records are tombstoned in place; a segment file is deleted once
+ * every record in it has been consumed. Total size is capped by evicting the
+ * oldest segment.
+ *
+ * Not thread-safe: the telemetry manager serializes access.
+ */
+
+#ifndef RAC_TELEMETRY_SPOOL_H
+#define RAC_TELEMETRY_SPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <string>
+
+namespace rac_internal {
+
+class TelemetrySpool {
+public:
+    static constexpr size_t kDefaultSegmentBytes = 256 * 1024;
+
+    /** A live record, as returned by peek() */
+    struct Record {
+        uint64_t segment = 0;  // Segment sequence number
+        size_t offset = 0;     // Byte offset of the record header in the segment
+        std::string endpoint;
+        std::string body;
+        bool requires_auth = false;
+    };
+
+    /** Whether this platform supports the spool at all */
+    static bool supported();
+
+    /**
+     * Open (or create) a spool in directory, replaying any segments left by a
+     * previous process. Returns nullptr if the directory cannot be used or
+     * memory-mapped files are unavailable on this platform.
+     */
+    static std::unique_ptr<TelemetrySpool> open(const std::string& directory, size_t max_bytes,
+                                                size_t segment_bytes = kDefaultSegmentBytes);
+
+    ~TelemetrySpool();
+
+    TelemetrySpool(const TelemetrySpool&) = delete;
+    TelemetrySpool& operator=(const TelemetrySpool&) = delete;
+
+    /** Append a request; evicts the oldest segment when over the size cap */
+    bool append(const std::string& endpoint, const char* body, size_t body_length,
+                bool requires_auth);
+
+    /** Oldest record not yet consumed; false when the spool is empty */
+    bool peek(Record& out);
+
+    /** Tombstone a record returned by peek() once it has been delivered */
+    void consume(const Record& record);
+
+    size_t pending_records() const { return pending_records_; }
+    uint64_t evicted_records() const { return evicted_records_; }
+    size_t size_bytes() const;
+
+private:
+    struct Segment {
+        uint64_t seq = 0;
+        std::string path;
+        uint8_t* data = nullptr;
+        size_t size = 0;
+        size_t write_offset = 0;  // End of written records
+        size_t read_offset = 0;   // First record that may still be live
+        size_t live_records = 0;
+    };
+
+    TelemetrySpool(std::string directory, size_t max_bytes, size_t segment_bytes);
+
+    bool load_existing();
+    bool map_segment(Segment& segment, bool create);
+    void close_segment(Segment& segment, bool remove_file);
+    Segment* writable_segment(size_t record_bytes);
+    void evict_oldest();
+
+    std::string directory_;
+    size_t max_bytes_;
+    size_t segment_bytes_;
+    std::deque<Segment> segments_;  // Oldest first
+    uint64_t next_seq_ = 0;
+    size_t pending_records_ = 0;
+    uint64_t evicted_records_ = 0;
+};
+
+}  // namespace rac_internal
+
+#endif  // RAC_TELEMETRY_SPOOL_H
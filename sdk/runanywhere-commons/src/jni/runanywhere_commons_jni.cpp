@@ -2724,7 +2724,9 @@ Java_com_runanywhere_sdk_native_bridge_RunAnywhereBridge_racDeviceManagerGetDevi
 // =============================================================================
 // Mirrors Swift SDK's CppBridge+Telemetry.swift
 
-// Global state for telemetry
+// Global state for telemetry. The manager calls the HTTP callback from
+// racTelemetryManagerPoll/Flush/Destroy, so mtx is never held across those
+// calls: the callback takes it too.
 static struct {
     rac_telemetry_manager_t* manager;
     jobject http_callback_obj;
@@ -2732,17 +2734,33 @@ static struct {
     std::mutex mtx;
 } g_telemetry_jni_state = {};
 
-// Telemetry HTTP callback from C++ to Java
+// Telemetry HTTP callback from C++ to Java. Runs on the Kotlin thread that
+// polls or flushes, which is already attached to the JVM.
 static void jni_telemetry_http_callback(void* user_data, const char* endpoint,
                                         const char* json_body, size_t json_length,
                                         rac_bool_t requires_auth) {
     JNIEnv* env = getJNIEnv();
-    if (!env || !g_telemetry_jni_state.http_callback_obj ||
-        !g_telemetry_jni_state.http_callback_method) {
+    if (!env) {
         LOGw("jni_telemetry_http_callback: JNI not ready");
         return;
     }
 
+    jobject callbackObj = nullptr;
+    jmethodID callbackMethod = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
+        if (g_telemetry_jni_state.http_callback_obj) {
+            callbackObj = env->NewLocalRef(g_telemetry_jni_state.http_callback_obj);
+        }
+        callbackMethod = g_telemetry_jni_state.http_callback_method;
+    }
+    if (!callbackObj || !callbackMethod) {
+        LOGw("jni_telemetry_http_callback: JNI not ready");
+        if (callbackObj)
+            env->DeleteLocalRef(callbackObj);
+        return;
+    }
+
     jstring jEndpoint = env->NewStringUTF(endpoint ? endpoint : "");
     jstring jBody = env->NewStringUTF(json_body ? json_body : "");
 
@@ -2753,11 +2771,11 @@ static void jni_telemetry_http_callback(void* user_data, const char* endpoint,
             env->DeleteLocalRef(jEndpoint);
         if (jBody)
             env->DeleteLocalRef(jBody);
+        env->DeleteLocalRef(callbackObj);
         return;
     }
 
-    env->CallVoidMethod(g_telemetry_jni_state.http_callback_obj,
-                        g_telemetry_jni_state.http_callback_method, jEndpoint, jBody,
+    env->CallVoidMethod(callbackObj, callbackMethod, jEndpoint, jBody,
                         static_cast<jint>(json_length),
                         requires_auth == RAC_TRUE ? JNI_TRUE : JNI_FALSE);
 
@@ -2771,6 +2789,7 @@ static void jni_telemetry_http_callback(void* user_data, const char* endpoint,
     // Always clean up local references
     env->DeleteLocalRef(jEndpoint);
     env->DeleteLocalRef(jBody);
+    env->DeleteLocalRef(callbackObj);
 }
 
 JNIEXPORT jlong JNICALL
@@ -2783,19 +2802,24 @@ Java_com_runanywhere_sdk_native_bridge_RunAnywhereBridge_racTelemetryManagerCrea
     std::string platformStr = getCString(env, platform);
     std::string versionStr = getCString(env, sdkVersion);
 
-    std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
+    rac_telemetry_manager_t* manager =
+        rac_telemetry_manager_create(static_cast<rac_environment_t>(environment),
+                                     deviceIdStr.c_str(), platformStr.c_str(), versionStr.c_str());
 
-    // Destroy existing manager if any
-    if (g_telemetry_jni_state.manager) {
-        rac_telemetry_manager_destroy(g_telemetry_jni_state.manager);
+    rac_telemetry_manager_t* previous = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
+        previous = g_telemetry_jni_state.manager;
+        g_telemetry_jni_state.manager = manager;
     }
 
-    g_telemetry_jni_state.manager =
-        rac_telemetry_manager_create(static_cast<rac_environment_t>(environment),
-                                     deviceIdStr.c_str(), platformStr.c_str(), versionStr.c_str());
+    // Destroy existing manager if any; this flushes through the HTTP callback
+    if (previous) {
+        rac_telemetry_manager_destroy(previous);
+    }
 
-    LOGi("racTelemetryManagerCreate: manager=%p", (void*)g_telemetry_jni_state.manager);
-    return reinterpret_cast<jlong>(g_telemetry_jni_state.manager);
+    LOGi("racTelemetryManagerCreate: manager=%p", (void*)manager);
+    return reinterpret_cast<jlong>(manager);
 }
 
 JNIEXPORT void JNICALL
@@ -2804,20 +2828,28 @@ Java_com_runanywhere_sdk_native_bridge_RunAnywhereBridge_racTelemetryManagerDest
                                                                                     jlong handle) {
     LOGi("racTelemetryManagerDestroy called");
 
-    std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
+    rac_telemetry_manager_t* manager = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
+        if (handle != 0 &&
+            reinterpret_cast<rac_telemetry_manager_t*>(handle) == g_telemetry_jni_state.manager) {
+            manager = g_telemetry_jni_state.manager;
+            g_telemetry_jni_state.manager = nullptr;
+        }
+    }
+    if (!manager) {
+        return;
+    }
 
-    if (handle != 0 &&
-        reinterpret_cast<rac_telemetry_manager_t*>(handle) == g_telemetry_jni_state.manager) {
-        // Flush before destroying
-        rac_telemetry_manager_flush(g_telemetry_jni_state.manager);
-        rac_telemetry_manager_destroy(g_telemetry_jni_state.manager);
-        g_telemetry_jni_state.manager = nullptr;
+    // Flush before destroying; the HTTP callback still needs the Java object
+    rac_telemetry_manager_flush(manager);
+    rac_telemetry_manager_destroy(manager);
 
-        // Clean up callback
-        if (g_telemetry_jni_state.http_callback_obj) {
-            env->DeleteGlobalRef(g_telemetry_jni_state.http_callback_obj);
-            g_telemetry_jni_state.http_callback_obj = nullptr;
-        }
+    // Clean up callback
+    std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
+    if (g_telemetry_jni_state.http_callback_obj) {
+        env->DeleteGlobalRef(g_telemetry_jni_state.http_callback_obj);
+        g_telemetry_jni_state.http_callback_obj = nullptr;
     }
 }
 
@@ -2844,15 +2876,18 @@ Java_com_runanywhere_sdk_native_bridge_RunAnywhereBridge_racTelemetryManagerSetH
     if (handle == 0)
         return;
 
-    std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
+    {
+        std::lock_guard<std::mutex> lock(g_telemetry_jni_state.mtx);
 
-    // Clean up previous callback
-    if (g_telemetry_jni_state.http_callback_obj) {
-        env->DeleteGlobalRef(g_telemetry_jni_state.http_callback_obj);
-        g_telemetry_jni_state.http_callback_obj = nullptr;
-    }
+        // Clean up previous callback
+        if (g_telemetry_jni_state.http_callback_obj) {
+            env->DeleteGlobalRef(g_telemetry_jni_state.http_callback_obj);
+            g_telemetry_jni_state.http_callback_obj = nullptr;
+        }
+        if (!callback) {
+            return;
+        }
 
-    if (callback) {
         g_telemetry_jni_state.http_callback_obj = env->NewGlobalRef(callback);
 
         // Cache method ID
@@ -2860,11 +2895,12 @@ Java_com_runanywhere_sdk_native_bridge_RunAnywhereBridge_racTelemetryManagerSetH
         g_telemetry_jni_state.http_callback_method =
             env->GetMethodID(cls, "onHttpRequest", "(Ljava/lang/String;Ljava/lang/String;IZ)V");
         env->DeleteLocalRef(cls);
-
-        // Register C callback with telemetry manager
-        rac_telemetry_manager_set_http_callback(reinterpret_cast<rac_telemetry_manager_t*>(handle),
-                                                jni_telemetry_http_callback, nullptr);
     }
+
+    // Register C callback with telemetry manager (outside mtx: a poll in
+    // progress holds the manager's send lock and may be inside the callback)
+    rac_telemetry_manager_set_http_callback(reinterpret_cast<rac_telemetry_manager_t*>(handle),
+                                            jni_telemetry_http_callback, nullptr);
 }
 
 JNIEXPORT jint JNICALL
@@ -2880,6 +2916,17 @@ Java_com_runanywhere_sdk_native_bridge_RunAnywhereBridge_racTelemetryManagerFlus
         rac_telemetry_manager_flush(reinterpret_cast<rac_telemetry_manager_t*>(handle)));
 }
 
+JNIEXPORT jint JNICALL
+Java_com_runanywhere_sdk_native_bridge_RunAnywhereBridge_racTelemetryManagerPoll(JNIEnv* env,
+                                                                                 jclass clazz,
+                                                                                 jlong handle) {
+    if (handle == 0)
+        return RAC_ERROR_INVALID_HANDLE;
+
+    return static_cast<jint>(
+        rac_telemetry_manager_poll(reinterpret_cast<rac_telemetry_manager_t*>(handle)));
+}
+
 // =============================================================================
 // JNI FUNCTIONS - Analytics Events (rac_analytics_events.h)
 // =============================================================================
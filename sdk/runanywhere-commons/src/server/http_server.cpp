@@ -5,6 +5,7 @@
 
 #include "http_server.h"
 #include "openai_handler.h"
+#include "mock_llm.h"
 #include "rac/core/rac_logger.h"
 #include "rac/backends/rac_llm_llamacpp.h"
 
@@ -69,23 +70,31 @@ rac_result_t HttpServer::start(const rac_server_config_t& config) {
         return RAC_ERROR_SERVER_ALREADY_RUNNING;
     }
 
+    mockMode_ = config.mock_tokens_per_second > 0;
+
     // Validate config
-    if (!config.model_path) {
-        RAC_LOG_ERROR("Server", "model_path is required");
-        return RAC_ERROR_INVALID_ARGUMENT;
-    }
+    if (!mockMode_) {
+        if (!config.model_path) {
+            RAC_LOG_ERROR("Server", "model_path is required");
+            return RAC_ERROR_INVALID_ARGUMENT;
+        }
 
-    // Check if model file exists
-    if (!std::filesystem::exists(config.model_path)) {
-        RAC_LOG_ERROR("Server", "Model file not found: %s", config.model_path);
-        return RAC_ERROR_SERVER_MODEL_NOT_FOUND;
+        // Check if model file exists
+        if (!std::filesystem::exists(config.model_path)) {
+            RAC_LOG_ERROR("Server", "Model file not found: %s", config.model_path);
+            return RAC_ERROR_SERVER_MODEL_NOT_FOUND;
+        }
     }
 
     // Copy configuration
     config_ = config;
     host_ = config.host ? config.host : "127.0.0.1";
-    modelPath_ = config.model_path;
-    modelId_ = config.model_id ? config.model_id : extractModelIdFromPath(modelPath_);
+    modelPath_ = config.model_path ? config.model_path : "";
+    if (config.model_id) {
+        modelId_ = config.model_id;
+    } else {
+        modelId_ = mockMode_ ? "mock" : extractModelIdFromPath(modelPath_);
+    }
 
     // Load the model
     rac_result_t rc = loadModel(modelPath_);
@@ -208,7 +217,18 @@ void HttpServer::setErrorCallback(rac_server_error_callback_fn callback, void* u
 
 void HttpServer::setupRoutes() {
     // Create handler with LLM handle
-    auto handler = std::make_shared<OpenAIHandler>(llmHandle_, modelId_);
+    LLMFunctions llm;
+    if (mockMode_) {
+        llm.generate = mockLLMGenerate;
+        llm.generateStream = mockLLMGenerateStream;
+        llm.generateChoices = nullptr;
+        llm.generateStreamLogprobs = nullptr;
+        llm.isModelLoaded = mockLLMIsModelLoaded;
+    }
+    auto handler = std::make_shared<OpenAIHandler>(llmHandle_, modelId_, llm);
+    for (const auto& [modelId, view] : loraModels_) {
+        handler->addModel(modelId, view);
+    }
 
     // GET /v1/models
     server_->Get("/v1/models", [this, handler](const httplib::Request& req, httplib::Response& res) {
@@ -282,6 +302,13 @@ void HttpServer::setupCors() {
 }
 
 rac_result_t HttpServer::loadModel(const std::string& modelPath) {
+    if (mockMode_) {
+        llmHandle_ = mockLLMCreate(config_.mock_tokens_per_second, config_.mock_prefill_ms);
+        RAC_LOG_INFO("Server", "Using mock LLM: %d tok/s, %d ms prefill",
+                     config_.mock_tokens_per_second, config_.mock_prefill_ms);
+        return llmHandle_ ? RAC_SUCCESS : RAC_ERROR_SERVER_MODEL_LOAD_FAILED;
+    }
+
     RAC_LOG_INFO("Server", "Loading model: %s", modelPath.c_str());
 
 #ifdef RAC_HAS_LLAMACPP
@@ -291,10 +318,12 @@ rac_result_t HttpServer::loadModel(const std::string& modelPath) {
     // Configure LlamaCPP with server settings
     rac_llm_llamacpp_config_t llamacpp_config = RAC_LLM_LLAMACPP_CONFIG_DEFAULT;
     llamacpp_config.context_size = config_.context_size;
+    llamacpp_config.context_shift = config_.context_shift;
     llamacpp_config.num_threads = config_.threads;
 
-    RAC_LOG_INFO("Server", "LlamaCPP config: context_size=%d, num_threads=%d",
-                 llamacpp_config.context_size, llamacpp_config.num_threads);
+    RAC_LOG_INFO("Server", "LlamaCPP config: context_size=%d, context_shift=%d, num_threads=%d",
+                 llamacpp_config.context_size, llamacpp_config.context_shift,
+                 llamacpp_config.num_threads);
 
     // Create LLM handle using LlamaCPP-specific API with config
     rac_result_t rc = rac_llm_llamacpp_create(modelPath.c_str(), &llamacpp_config, &llmHandle_);
@@ -303,6 +332,27 @@ rac_result_t HttpServer::loadModel(const std::string& modelPath) {
         return RAC_ERROR_SERVER_MODEL_LOAD_FAILED;
     }
 
+    // Each LoRA model shares the base model and context; the adapter scales
+    // are switched on the live context per request
+    for (size_t i = 0; i < config_.num_lora_models; ++i) {
+        const rac_server_lora_model_t& lora = config_.lora_models[i];
+        if (!lora.model_id || !lora.adapter_path) {
+            continue;
+        }
+        rac_llm_llamacpp_lora_t adapter = {lora.adapter_path, lora.scale};
+        rac_handle_t view = nullptr;
+        rc = rac_llm_llamacpp_create_lora_view(llmHandle_, &adapter, 1, &view);
+        if (RAC_FAILED(rc)) {
+            RAC_LOG_ERROR("Server", "Failed to load LoRA adapter %s for model %s: %d",
+                          lora.adapter_path, lora.model_id, rc);
+            unloadModel();
+            return RAC_ERROR_SERVER_MODEL_LOAD_FAILED;
+        }
+        loraModels_.emplace_back(lora.model_id, view);
+        RAC_LOG_INFO("Server", "LoRA model %s: %s (scale=%.2f)", lora.model_id,
+                     lora.adapter_path, lora.scale);
+    }
+
     RAC_LOG_INFO("Server", "Model loaded successfully");
     return RAC_SUCCESS;
 #else
@@ -312,8 +362,20 @@ rac_result_t HttpServer::loadModel(const std::string& modelPath) {
 }
 
 void HttpServer::unloadModel() {
+#ifdef RAC_HAS_LLAMACPP
+    // Views first: they borrow the base handle's model
+    for (auto& [modelId, view] : loraModels_) {
+        rac_llm_llamacpp_destroy(view);
+    }
+#endif
+    loraModels_.clear();
+
     if (llmHandle_) {
-        rac_llm_destroy(llmHandle_);
+        if (mockMode_) {
+            mockLLMDestroy(llmHandle_);
+        } else {
+            rac_llm_destroy(llmHandle_);
+        }
         llmHandle_ = nullptr;
     }
 }
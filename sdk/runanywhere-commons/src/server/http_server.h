@@ -22,6 +22,8 @@
 #include <string>
 #include <thread>
 #include <chrono>
+#include <utility>
+#include <vector>
 
 namespace rac {
 namespace server {
@@ -131,9 +133,13 @@ private:
     std::string modelPath_;
     std::string modelId_;
 
-    // LLM handle
+    // LLM handle (mock LLM when config_.mock_tokens_per_second > 0)
     rac_handle_t llmHandle_{nullptr};
 
+    // LoRA views of llmHandle_, keyed by the model ID that selects them
+    std::vector<std::pair<std::string, rac_handle_t>> loraModels_;
+    bool mockMode_{false};
+
     // Statistics
     std::atomic<int32_t> activeRequests_{0};
     std::atomic<int64_t> totalRequests_{0};
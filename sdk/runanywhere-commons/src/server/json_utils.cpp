@@ -110,6 +110,23 @@ Json serializeStreamChunk(const rac_openai_stream_chunk_t& chunk) {
         }
         choiceJson["delta"] = delta;
 
+        // Logprobs
+        if (choice.num_logprobs > 0 && choice.logprobs) {
+            Json content = Json::array();
+            for (size_t j = 0; j < choice.num_logprobs; ++j) {
+                const auto& entry = choice.logprobs[j];
+                Json entryJson = serializeTopLogprob(entry.token, entry.logprob);
+                Json topLogprobs = Json::array();
+                for (size_t k = 0; k < entry.num_top_logprobs; ++k) {
+                    topLogprobs.push_back(serializeTopLogprob(entry.top_logprobs[k].token,
+                                                              entry.top_logprobs[k].logprob));
+                }
+                entryJson["top_logprobs"] = topLogprobs;
+                content.push_back(entryJson);
+            }
+            choiceJson["logprobs"] = {{"content", content}};
+        }
+
         // Finish reason
         const char* finishStr = rac_openai_finish_reason_to_string(choice.finish_reason);
         if (finishStr) {
@@ -174,6 +191,22 @@ Json serializeToolCall(const rac_openai_tool_call_t& toolCall) {
     return json;
 }
 
+Json serializeTopLogprob(const char* token, float logprob) {
+    Json json;
+
+    const std::string text = token ? token : "";
+    json["token"] = text;
+    json["logprob"] = logprob;
+
+    Json bytes = Json::array();
+    for (unsigned char byte : text) {
+        bytes.push_back(byte);
+    }
+    json["bytes"] = bytes;
+
+    return json;
+}
+
 Json createErrorResponse(const std::string& message, const std::string& type, int code) {
     Json json;
 
@@ -193,7 +226,9 @@ Json createErrorResponse(const std::string& message, const std::string& type, in
 
 std::string formatSSE(const Json& chunk) {
     std::ostringstream ss;
-    ss << "data: " << chunk.dump() << "\n\n";
+    // Logprob tokens can be partial UTF-8 sequences; their exact bytes are
+    // in the "bytes" field
+    ss << "data: " << chunk.dump(-1, ' ', false, Json::error_handler_t::replace) << "\n\n";
     return ss.str();
 }
 
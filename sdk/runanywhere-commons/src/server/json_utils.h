@@ -53,6 +53,11 @@ Json serializeUsage(const rac_openai_usage_t& usage);
  */
 Json serializeToolCall(const rac_openai_tool_call_t& toolCall);
 
+/**
+ * @brief Serialize a token and its log-probability (token, logprob, bytes)
+ */
+Json serializeTopLogprob(const char* token, float logprob);
+
 /**
  * @brief Create an error response JSON
  */
@@ -0,0 +1,117 @@
+/**
+ * @file mock_llm.cpp
+ * @brief Synthetic LLM for server load testing
+ */
+
+#include "mock_llm.h"
+
+#include "rac/core/rac_error.h"
+
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+namespace rac {
+namespace server {
+
+namespace {
+
+struct MockLLM {
+    std::chrono::nanoseconds tokenInterval;
+    std::chrono::milliseconds prefill;
+};
+
+const char* const MOCK_WORDS[] = {
+    "lorem ", "ipsum ", "dolor ", "sit ", "amet ", "consectetur ", "adipiscing ", "elit ",
+};
+constexpr size_t MOCK_WORD_COUNT = sizeof(MOCK_WORDS) / sizeof(MOCK_WORDS[0]);
+
+// Rough prompt token estimate (~4 bytes per token)
+int32_t estimatePromptTokens(const char* prompt) {
+    return prompt ? static_cast<int32_t>(std::strlen(prompt) / 4 + 1) : 0;
+}
+
+int32_t requestedTokens(const rac_llm_options_t* options) {
+    return options && options->max_tokens > 0 ? options->max_tokens
+                                              : RAC_LLM_OPTIONS_DEFAULT.max_tokens;
+}
+
+} // anonymous namespace
+
+rac_handle_t mockLLMCreate(int32_t tokensPerSecond, int32_t prefillMs) {
+    if (tokensPerSecond <= 0) {
+        return nullptr;
+    }
+    auto* mock = new MockLLM();
+    mock->tokenInterval = std::chrono::nanoseconds(1000000000LL / tokensPerSecond);
+    mock->prefill = std::chrono::milliseconds(prefillMs > 0 ? prefillMs : 0);
+    return mock;
+}
+
+void mockLLMDestroy(rac_handle_t handle) {
+    delete static_cast<MockLLM*>(handle);
+}
+
+rac_bool_t mockLLMIsModelLoaded(rac_handle_t handle) {
+    return handle ? RAC_TRUE : RAC_FALSE;
+}
+
+rac_result_t mockLLMGenerateStream(rac_handle_t handle, const char* prompt,
+                                   const rac_llm_options_t* options,
+                                   rac_llm_llamacpp_stream_callback_fn callback, void* userData) {
+    auto* mock = static_cast<MockLLM*>(handle);
+    if (!mock || !callback) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+    (void)prompt;
+
+    // Sleep to absolute deadlines so callback cost does not slow the rate
+    auto next = std::chrono::steady_clock::now() + mock->prefill;
+    const int32_t maxTokens = requestedTokens(options);
+    for (int32_t i = 0; i < maxTokens; ++i) {
+        std::this_thread::sleep_until(next);
+        next += mock->tokenInterval;
+        if (callback(MOCK_WORDS[static_cast<size_t>(i) % MOCK_WORD_COUNT], RAC_FALSE, userData) !=
+            RAC_TRUE) {
+            return RAC_SUCCESS;
+        }
+    }
+    callback("", RAC_TRUE, userData);
+    return RAC_SUCCESS;
+}
+
+rac_result_t mockLLMGenerate(rac_handle_t handle, const char* prompt,
+                             const rac_llm_options_t* options, rac_llm_result_t* outResult) {
+    auto* mock = static_cast<MockLLM*>(handle);
+    if (!mock || !outResult) {
+        return RAC_ERROR_INVALID_ARGUMENT;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    const int32_t maxTokens = requestedTokens(options);
+    std::this_thread::sleep_for(mock->prefill + mock->tokenInterval * maxTokens);
+    const auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+                               std::chrono::steady_clock::now() - start)
+                               .count();
+
+    std::string text;
+    for (int32_t i = 0; i < maxTokens; ++i) {
+        text += MOCK_WORDS[static_cast<size_t>(i) % MOCK_WORD_COUNT];
+    }
+
+    *outResult = {};
+    outResult->text = rac_strdup(text.c_str());
+    outResult->prompt_tokens = estimatePromptTokens(prompt);
+    outResult->completion_tokens = maxTokens;
+    outResult->total_tokens = outResult->prompt_tokens + maxTokens;
+    outResult->time_to_first_token_ms = mock->prefill.count();
+    outResult->total_time_ms = elapsedMs;
+    outResult->tokens_per_second =
+        elapsedMs > 0 ? static_cast<float>(maxTokens) * 1000.0f / static_cast<float>(elapsedMs)
+                      : 0.0f;
+    return RAC_SUCCESS;
+}
+
+} // namespace server
+} // namespace rac
@@ -0,0 +1,43 @@
+/**
+ * @file mock_llm.h
+ * @brief Synthetic LLM for server load testing
+ *
+ * Emits placeholder tokens at a fixed rate after a fixed prefill delay, with
+ * the same entry-point signatures as the LlamaCPP C API. Requests run fully
+ * in parallel, so load tests against it measure HTTP/SSE overhead and
+ * queueing without model cost.
+ */
+
+#ifndef RAC_SERVER_MOCK_LLM_H
+#define RAC_SERVER_MOCK_LLM_H
+
+#include "rac/backends/rac_llm_llamacpp.h"
+#include "rac/features/llm/rac_llm_types.h"
+
+namespace rac {
+namespace server {
+
+/**
+ * @brief Create a mock LLM handle
+ *
+ * @param tokensPerSecond Per-request decode rate (> 0)
+ * @param prefillMs Delay before the first token
+ * @return Handle to pass to the mock entry points (free with mockLLMDestroy)
+ */
+rac_handle_t mockLLMCreate(int32_t tokensPerSecond, int32_t prefillMs);
+
+void mockLLMDestroy(rac_handle_t handle);
+
+rac_bool_t mockLLMIsModelLoaded(rac_handle_t handle);
+
+rac_result_t mockLLMGenerate(rac_handle_t handle, const char* prompt,
+                             const rac_llm_options_t* options, rac_llm_result_t* outResult);
+
+rac_result_t mockLLMGenerateStream(rac_handle_t handle, const char* prompt,
+                                   const rac_llm_options_t* options,
+                                   rac_llm_llamacpp_stream_callback_fn callback, void* userData);
+
+} // namespace server
+} // namespace rac
+
+#endif // RAC_SERVER_MOCK_LLM_H
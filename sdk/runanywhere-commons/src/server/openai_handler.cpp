@@ -15,6 +15,7 @@
 #include <chrono>
 #include <sstream>
 #include <random>
+#include <vector>
 
 namespace rac {
 namespace server {
@@ -39,26 +40,96 @@ int64_t currentTimestamp() {
     ).count();
 }
 
+// Upper bound for the n and best_of request fields
+constexpr int kMaxChoices = 16;
+
+int choiceCount(const nlohmann::json& requestJson, const char* key, int fallback) {
+    if (!requestJson.contains(key) || !requestJson[key].is_number_integer()) {
+        return fallback;
+    }
+    return requestJson[key].get<int>();
+}
+
+// Alternatives per token requested via logprobs / top_logprobs (-1 = none)
+int requestedTopLogprobs(const nlohmann::json& requestJson) {
+    if (!requestJson.contains("logprobs") || !requestJson["logprobs"].is_boolean() ||
+        !requestJson["logprobs"].get<bool>()) {
+        return -1;
+    }
+    return choiceCount(requestJson, "top_logprobs", 0);
+}
+
+// State shared with the streaming callbacks
+struct StreamCtx {
+    httplib::DataSink* sink;
+    const std::string* requestId;
+    const std::string* modelId;
+    int64_t created;
+    int32_t tokenCount;
+};
+
+bool writeStreamChunk(StreamCtx* ctx, const char* content,
+                      const rac_openai_token_logprob_t* logprobs, size_t numLogprobs,
+                      rac_openai_finish_reason_t finishReason) {
+    rac_openai_stream_chunk_t chunk = {};
+    chunk.id = ctx->requestId->c_str();
+    chunk.object = "chat.completion.chunk";
+    chunk.created = ctx->created;
+    chunk.model = ctx->modelId->c_str();
+
+    rac_openai_delta_t delta = {};
+    delta.role = nullptr;
+    delta.content = content;
+
+    rac_openai_stream_choice_t choice = {};
+    choice.index = 0;
+    choice.delta = delta;
+    choice.logprobs = logprobs;
+    choice.num_logprobs = numLogprobs;
+    choice.finish_reason = finishReason;
+
+    chunk.choices = &choice;
+    chunk.num_choices = 1;
+
+    std::string sseData = json::formatSSE(json::serializeStreamChunk(chunk));
+    return ctx->sink->write(sseData.c_str(), sseData.size());
+}
+
+struct Completion {
+    std::string text;
+    int32_t completionTokens = 0;
+    bool lengthLimited = false;
+};
+
 } // anonymous namespace
 
-OpenAIHandler::OpenAIHandler(rac_handle_t llmHandle, const std::string& modelId)
+OpenAIHandler::OpenAIHandler(rac_handle_t llmHandle, const std::string& modelId,
+                             const LLMFunctions& llm)
     : llmHandle_(llmHandle)
+    , llm_(llm)
     , modelId_(modelId)
 {
 }
 
+void OpenAIHandler::addModel(const std::string& modelId, rac_handle_t handle) {
+    extraModels_.emplace_back(modelId, handle);
+}
+
 void OpenAIHandler::handleModels(const httplib::Request& /*req*/, httplib::Response& res) {
     rac_openai_models_response_t response = {};
     response.object = "list";
 
-    rac_openai_model_t model = {};
-    model.id = modelId_.c_str();
-    model.object = "model";
-    model.created = currentTimestamp();
-    model.owned_by = "runanywhere";
+    const int64_t created = currentTimestamp();
+    std::vector<rac_openai_model_t> models(1 + extraModels_.size());
+    for (size_t i = 0; i < models.size(); ++i) {
+        models[i].id = i == 0 ? modelId_.c_str() : extraModels_[i - 1].first.c_str();
+        models[i].object = "model";
+        models[i].created = created;
+        models[i].owned_by = "runanywhere";
+    }
 
-    response.data = &model;
-    response.num_data = 1;
+    response.data = models.data();
+    response.num_data = models.size();
 
     auto jsonResponse = json::serializeModelsResponse(response);
 
@@ -93,10 +164,79 @@ void OpenAIHandler::handleChatCompletions(const httplib::Request& req, httplib::
         stream = requestJson["stream"].get<bool>();
     }
 
+    // n / best_of: several completions sampled from one prompt prefill
+    for (const char* key : {"n", "best_of"}) {
+        if (!requestJson.contains(key) || requestJson[key].is_null()) {
+            continue;
+        }
+        const auto& value = requestJson[key];
+        if (!value.is_number_integer() || value.get<int>() < 1 ||
+            value.get<int>() > kMaxChoices) {
+            sendError(res, 400,
+                      std::string(key) + " must be an integer between 1 and " +
+                          std::to_string(kMaxChoices),
+                      "invalid_request_error");
+            return;
+        }
+    }
+    const int n = choiceCount(requestJson, "n", 1);
+    if (choiceCount(requestJson, "best_of", n) < n) {
+        sendError(res, 400, "best_of must be greater than or equal to n", "invalid_request_error");
+        return;
+    }
+    if (stream && n > 1) {
+        sendError(res, 400, "n > 1 is not supported with stream", "invalid_request_error");
+        return;
+    }
+
+    // logprobs / top_logprobs: reported per token in stream chunks
+    if (requestJson.contains("top_logprobs") && !requestJson["top_logprobs"].is_null()) {
+        const auto& value = requestJson["top_logprobs"];
+        if (!value.is_number_integer() || value.get<int>() < 0 ||
+            value.get<int>() > RAC_LLM_LLAMACPP_MAX_TOP_LOGPROBS) {
+            sendError(res, 400,
+                      "top_logprobs must be an integer between 0 and " +
+                          std::to_string(RAC_LLM_LLAMACPP_MAX_TOP_LOGPROBS),
+                      "invalid_request_error");
+            return;
+        }
+        if (requestedTopLogprobs(requestJson) < 0) {
+            sendError(res, 400, "top_logprobs requires logprobs to be true",
+                      "invalid_request_error");
+            return;
+        }
+    }
+    if (requestedTopLogprobs(requestJson) >= 0) {
+        if (!stream) {
+            sendError(res, 400, "logprobs is only supported with stream", "invalid_request_error");
+            return;
+        }
+        if (!llm_.generateStreamLogprobs) {
+            sendError(res, 400, "logprobs is not supported by this model",
+                      "invalid_request_error");
+            return;
+        }
+    }
+
+    // A LoRA model ID selects its view of the base model; anything else is
+    // served by the base model
+    rac_handle_t handle = llmHandle_;
+    const std::string* modelId = &modelId_;
+    if (requestJson.contains("model") && requestJson["model"].is_string()) {
+        const std::string requested = requestJson["model"].get<std::string>();
+        for (const auto& [extraId, extraHandle] : extraModels_) {
+            if (extraId == requested) {
+                handle = extraHandle;
+                modelId = &extraId;
+                break;
+            }
+        }
+    }
+
     if (stream) {
-        processStreaming(req, res, requestJson);
+        processStreaming(req, res, requestJson, handle, *modelId);
     } else {
-        processNonStreaming(req, res, requestJson);
+        processNonStreaming(req, res, requestJson, handle, *modelId);
     }
 }
 
@@ -107,7 +247,7 @@ void OpenAIHandler::handleHealth(const httplib::Request& /*req*/, httplib::Respo
 
     // Check if LLM is ready
     if (llmHandle_) {
-        response["model_loaded"] = rac_llm_llamacpp_is_model_loaded(llmHandle_) != 0;
+        response["model_loaded"] = llm_.isModelLoaded(llmHandle_) != 0;
     } else {
         response["model_loaded"] = false;
     }
@@ -118,7 +258,9 @@ void OpenAIHandler::handleHealth(const httplib::Request& /*req*/, httplib::Respo
 
 void OpenAIHandler::processNonStreaming(const httplib::Request& /*req*/,
                                          httplib::Response& res,
-                                         const nlohmann::json& requestJson) {
+                                         const nlohmann::json& requestJson,
+                                         rac_handle_t handle,
+                                         const std::string& modelId) {
     RAC_LOG_INFO("Server", "processNonStreaming: START");
 
     // Get messages and tools from request
@@ -144,29 +286,60 @@ void OpenAIHandler::processNonStreaming(const httplib::Request& /*req*/,
     RAC_LOG_INFO("Server", "processNonStreaming: options parsed, max_tokens=%d, temp=%.2f",
                  options.max_tokens, options.temperature);
 
-    // Generate response using LlamaCPP backend directly
-    RAC_LOG_INFO("Server", "processNonStreaming: calling rac_llm_llamacpp_generate with handle=%p", (void*)llmHandle_);
-    rac_llm_result_t result = {};
-    rac_result_t rc = rac_llm_llamacpp_generate(llmHandle_, prompt.c_str(), &options, &result);
-    RAC_LOG_INFO("Server", "processNonStreaming: rac_llm_llamacpp_generate returned rc=%d", rc);
+    const int n = choiceCount(requestJson, "n", 1);
+    const int bestOf = choiceCount(requestJson, "best_of", n);
+
+    // Generate response using the configured LLM backend
+    std::vector<Completion> completions;
+    int32_t promptTokens = 0;
+    rac_result_t rc = RAC_SUCCESS;
+    if (n > 1 || bestOf > n) {
+        if (llm_.generateChoices) {
+            // Shared prompt prefill, candidates decoded together
+            rac_llm_llamacpp_choice_t* choices = nullptr;
+            int32_t numChoices = 0;
+            rc = llm_.generateChoices(handle, prompt.c_str(), &options, n, bestOf, &choices,
+                                      &numChoices, &promptTokens);
+            if (RAC_SUCCEEDED(rc)) {
+                for (int32_t i = 0; i < numChoices; ++i) {
+                    completions.push_back({choices[i].text ? choices[i].text : "",
+                                           choices[i].completion_tokens,
+                                           choices[i].length_limited == RAC_TRUE});
+                }
+                rac_llm_llamacpp_free_choices(choices, numChoices);
+            }
+        } else {
+            // Backend without parallel sampling: one generation per choice
+            for (int i = 0; i < n && RAC_SUCCEEDED(rc); ++i) {
+                rac_llm_result_t result = {};
+                rc = llm_.generate(handle, prompt.c_str(), &options, &result);
+                if (RAC_SUCCEEDED(rc)) {
+                    completions.push_back(
+                        {result.text ? result.text : "", result.completion_tokens, false});
+                    promptTokens = result.prompt_tokens;
+                    rac_llm_result_free(&result);
+                }
+            }
+        }
+    } else {
+        RAC_LOG_INFO("Server", "processNonStreaming: calling generate with handle=%p",
+                     (void*)handle);
+        rac_llm_result_t result = {};
+        rc = llm_.generate(handle, prompt.c_str(), &options, &result);
+        if (RAC_SUCCEEDED(rc)) {
+            completions.push_back({result.text ? result.text : "", result.completion_tokens, false});
+            promptTokens = result.prompt_tokens;
+            rac_llm_result_free(&result);
+        }
+    }
+    RAC_LOG_INFO("Server", "processNonStreaming: generate returned rc=%d, choices=%zu", rc,
+                 completions.size());
 
     if (RAC_FAILED(rc)) {
         sendError(res, 500, "Generation failed", "server_error");
         return;
     }
 
-    // Update token count
-    totalTokensGenerated_ += result.completion_tokens;
-
-    // Check if the response contains a tool call using Commons API
-    rac_tool_call_t toolCall = {};
-    bool hasToolCall = false;
-
-    if (result.text && !tools.empty()) {
-        rac_result_t parseResult = rac_tool_call_parse(result.text, &toolCall);
-        hasToolCall = (parseResult == RAC_SUCCESS && toolCall.has_tool_call);
-    }
-
     // Build response
     std::string requestId = generateId("chatcmpl-");
 
@@ -174,56 +347,79 @@ void OpenAIHandler::processNonStreaming(const httplib::Request& /*req*/,
     response.id = const_cast<char*>(requestId.c_str());
     response.object = "chat.completion";
     response.created = currentTimestamp();
-    response.model = modelId_.c_str();
-
-    // Create message with potential tool calls
-    rac_openai_assistant_message_t message = {};
-    message.role = RAC_OPENAI_ROLE_ASSISTANT;
-
-    // Tool call storage (for lifetime management)
-    rac_openai_tool_call_t openaiToolCall = {};
-    std::string toolCallId;
-    std::string toolName;
-    std::string toolArgs;
-
-    if (hasToolCall) {
-        // Convert Commons tool call to OpenAI format
-        toolCallId = translation::generateToolCallId();
-        toolName = toolCall.tool_name ? toolCall.tool_name : "";
-        toolArgs = toolCall.arguments_json ? toolCall.arguments_json : "{}";
-
-        openaiToolCall.id = toolCallId.c_str();
-        openaiToolCall.type = "function";
-        openaiToolCall.function_name = toolName.c_str();
-        openaiToolCall.function_arguments = toolArgs.c_str();
-
-        message.content = toolCall.clean_text; // Text without tool call tags
-        message.tool_calls = &openaiToolCall;
-        message.num_tool_calls = 1;
-    } else {
-        message.content = result.text;
-        message.tool_calls = nullptr;
-        message.num_tool_calls = 0;
+    response.model = modelId.c_str();
+
+    // Per-choice tool call storage (sized up front so c_str() pointers stay valid)
+    const size_t count = completions.size();
+    std::vector<rac_openai_choice_t> choices(count);
+    std::vector<rac_tool_call_t> toolCalls(count);
+    std::vector<bool> hasToolCall(count, false);
+    std::vector<rac_openai_tool_call_t> openaiToolCalls(count);
+    std::vector<std::string> toolCallIds(count);
+    std::vector<std::string> toolNames(count);
+    std::vector<std::string> toolArgs(count);
+
+    int32_t completionTokens = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const Completion& completion = completions[i];
+        completionTokens += completion.completionTokens;
+
+        // Check if the response contains a tool call using Commons API
+        toolCalls[i] = {};
+        if (!completion.text.empty() && !tools.empty()) {
+            rac_result_t parseResult = rac_tool_call_parse(completion.text.c_str(), &toolCalls[i]);
+            hasToolCall[i] = (parseResult == RAC_SUCCESS && toolCalls[i].has_tool_call);
+        }
+
+        // Create message with potential tool calls
+        rac_openai_assistant_message_t message = {};
+        message.role = RAC_OPENAI_ROLE_ASSISTANT;
+
+        if (hasToolCall[i]) {
+            // Convert Commons tool call to OpenAI format
+            toolCallIds[i] = translation::generateToolCallId();
+            toolNames[i] = toolCalls[i].tool_name ? toolCalls[i].tool_name : "";
+            toolArgs[i] = toolCalls[i].arguments_json ? toolCalls[i].arguments_json : "{}";
+
+            openaiToolCalls[i].id = toolCallIds[i].c_str();
+            openaiToolCalls[i].type = "function";
+            openaiToolCalls[i].function_name = toolNames[i].c_str();
+            openaiToolCalls[i].function_arguments = toolArgs[i].c_str();
+
+            message.content = toolCalls[i].clean_text; // Text without tool call tags
+            message.tool_calls = &openaiToolCalls[i];
+            message.num_tool_calls = 1;
+        } else {
+            message.content =
+                completion.text.empty() ? nullptr : const_cast<char*>(completion.text.c_str());
+            message.tool_calls = nullptr;
+            message.num_tool_calls = 0;
+        }
+
+        choices[i].index = static_cast<int32_t>(i);
+        choices[i].message = message;
+        choices[i].finish_reason = hasToolCall[i]             ? RAC_OPENAI_FINISH_TOOL_CALLS
+                                   : completion.lengthLimited ? RAC_OPENAI_FINISH_LENGTH
+                                                              : RAC_OPENAI_FINISH_STOP;
     }
 
-    rac_openai_choice_t choice = {};
-    choice.index = 0;
-    choice.message = message;
-    choice.finish_reason = hasToolCall ? RAC_OPENAI_FINISH_TOOL_CALLS : RAC_OPENAI_FINISH_STOP;
+    // Update token count
+    totalTokensGenerated_ += completionTokens;
 
-    response.choices = &choice;
-    response.num_choices = 1;
+    response.choices = choices.data();
+    response.num_choices = count;
 
-    response.usage.prompt_tokens = result.prompt_tokens;
-    response.usage.completion_tokens = result.completion_tokens;
-    response.usage.total_tokens = result.total_tokens;
+    response.usage.prompt_tokens = promptTokens;
+    response.usage.completion_tokens = completionTokens;
+    response.usage.total_tokens = promptTokens + completionTokens;
 
     auto jsonResponse = json::serializeChatResponse(response);
 
     // Clean up
-    rac_llm_result_free(&result);
-    if (hasToolCall) {
-        rac_tool_call_free(&toolCall);
+    for (size_t i = 0; i < count; ++i) {
+        if (hasToolCall[i]) {
+            rac_tool_call_free(&toolCalls[i]);
+        }
     }
 
     res.set_content(jsonResponse.dump(), "application/json");
@@ -232,7 +428,9 @@ void OpenAIHandler::processNonStreaming(const httplib::Request& /*req*/,
 
 void OpenAIHandler::processStreaming(const httplib::Request& /*req*/,
                                       httplib::Response& res,
-                                      const nlohmann::json& requestJson) {
+                                      const nlohmann::json& requestJson,
+                                      rac_handle_t handle,
+                                      const std::string& modelId) {
     // Get messages and tools from request
     const auto& messages = requestJson["messages"];
     nlohmann::json tools = requestJson.value("tools", nlohmann::json::array());
@@ -243,6 +441,7 @@ void OpenAIHandler::processStreaming(const httplib::Request& /*req*/,
     // Parse options
     rac_llm_options_t options = parseOptions(requestJson);
     options.streaming_enabled = RAC_TRUE;
+    const int topLogprobs = requestedTopLogprobs(requestJson);
 
     // Generate request ID
     std::string requestId = generateId("chatcmpl-");
@@ -256,14 +455,14 @@ void OpenAIHandler::processStreaming(const httplib::Request& /*req*/,
     // Start streaming via content provider
     res.set_content_provider(
         "text/event-stream",
-        [this, prompt, options, requestId, created](size_t /*offset*/, httplib::DataSink& sink) mutable {
+        [this, prompt, options, requestId, created, topLogprobs, handle, modelId](size_t /*offset*/, httplib::DataSink& sink) mutable {
             // First chunk: send role
             {
                 rac_openai_stream_chunk_t chunk = {};
                 chunk.id = requestId.c_str();
                 chunk.object = "chat.completion.chunk";
                 chunk.created = created;
-                chunk.model = modelId_.c_str();
+                chunk.model = modelId.c_str();
 
                 rac_openai_delta_t delta = {};
                 delta.role = "assistant";
@@ -281,72 +480,73 @@ void OpenAIHandler::processStreaming(const httplib::Request& /*req*/,
                 sink.write(sseData.c_str(), sseData.size());
             }
 
-            // Stream tokens incrementally via rac_llm_llamacpp_generate_stream
-            struct StreamCtx {
-                httplib::DataSink* sink;
-                const std::string* requestId;
-                const std::string* modelId;
-                int64_t created;
-                int32_t tokenCount;
-            };
-
-            StreamCtx ctx = { &sink, &requestId, &modelId_, created, 0 };
+            // Stream tokens incrementally via the backend's generate_stream
+            StreamCtx ctx = { &sink, &requestId, &modelId, created, 0 };
 
             auto streamCallback = [](const char* token, rac_bool_t is_final, void* user_data) -> rac_bool_t {
                 auto* ctx = static_cast<StreamCtx*>(user_data);
 
                 if (is_final) {
                     // Send finish chunk
-                    rac_openai_stream_chunk_t chunk = {};
-                    chunk.id = ctx->requestId->c_str();
-                    chunk.object = "chat.completion.chunk";
-                    chunk.created = ctx->created;
-                    chunk.model = ctx->modelId->c_str();
-
-                    rac_openai_delta_t delta = {};
-                    delta.role = nullptr;
-                    delta.content = nullptr;
-
-                    rac_openai_stream_choice_t choice = {};
-                    choice.index = 0;
-                    choice.delta = delta;
-                    choice.finish_reason = RAC_OPENAI_FINISH_STOP;
-
-                    chunk.choices = &choice;
-                    chunk.num_choices = 1;
-
-                    std::string sseData = json::formatSSE(json::serializeStreamChunk(chunk));
-                    ctx->sink->write(sseData.c_str(), sseData.size());
+                    writeStreamChunk(ctx, nullptr, nullptr, 0, RAC_OPENAI_FINISH_STOP);
                 } else if (token && token[0] != '\0') {
                     // Send content chunk with this token
-                    rac_openai_stream_chunk_t chunk = {};
-                    chunk.id = ctx->requestId->c_str();
-                    chunk.object = "chat.completion.chunk";
-                    chunk.created = ctx->created;
-                    chunk.model = ctx->modelId->c_str();
-
-                    rac_openai_delta_t delta = {};
-                    delta.role = nullptr;
-                    delta.content = token;
-
-                    rac_openai_stream_choice_t choice = {};
-                    choice.index = 0;
-                    choice.delta = delta;
-                    choice.finish_reason = RAC_OPENAI_FINISH_NONE;
-
-                    chunk.choices = &choice;
-                    chunk.num_choices = 1;
-
-                    std::string sseData = json::formatSSE(json::serializeStreamChunk(chunk));
-                    ctx->sink->write(sseData.c_str(), sseData.size());
+                    if (!writeStreamChunk(ctx, token, nullptr, 0, RAC_OPENAI_FINISH_NONE)) {
+                        return RAC_FALSE;  // Client disconnected - stop generating
+                    }
                     ctx->tokenCount++;
                 }
 
                 return RAC_TRUE;  // Continue generating
             };
 
-            rac_result_t rc = rac_llm_llamacpp_generate_stream(
-                llmHandle_, prompt.c_str(), &options, streamCallback, &ctx);
+            auto logprobCallback = [](const char* token,
+                                      const rac_llm_llamacpp_token_logprob_t* logprobs,
+                                      int32_t num_logprobs, rac_bool_t is_final,
+                                      void* user_data) -> rac_bool_t {
+                auto* ctx = static_cast<StreamCtx*>(user_data);
+
+                if (is_final) {
+                    writeStreamChunk(ctx, nullptr, nullptr, 0, RAC_OPENAI_FINISH_STOP);
+                    return RAC_TRUE;
+                }
+                if ((!token || token[0] == '\0') && num_logprobs == 0) {
+                    return RAC_TRUE;
+                }
+
+                std::vector<rac_openai_token_logprob_t> entries(num_logprobs);
+                // Reserved up front so the per-entry pointers stay valid
+                size_t numAlternatives = 0;
+                for (int32_t i = 0; i < num_logprobs; ++i) {
+                    numAlternatives += logprobs[i].num_top_logprobs;
+                }
+                std::vector<rac_openai_top_logprob_t> alternatives;
+                alternatives.reserve(numAlternatives);
+                for (int32_t i = 0; i < num_logprobs; ++i) {
+                    entries[i].token = logprobs[i].token;
+                    entries[i].logprob = logprobs[i].logprob;
+                    entries[i].top_logprobs = alternatives.data() + alternatives.size();
+                    entries[i].num_top_logprobs = logprobs[i].num_top_logprobs;
+                    for (int32_t j = 0; j < logprobs[i].num_top_logprobs; ++j) {
+                        alternatives.push_back(
+                            {logprobs[i].top_logprobs[j].token, logprobs[i].top_logprobs[j].logprob});
+                    }
+                }
+
+                if (!writeStreamChunk(ctx, token, entries.data(), entries.size(),
+                                      RAC_OPENAI_FINISH_NONE)) {
+                    return RAC_FALSE;  // Client disconnected - stop generating
+                }
+                ctx->tokenCount += num_logprobs;
+                return RAC_TRUE;
+            };
+
+            rac_result_t rc =
+                topLogprobs >= 0
+                    ? llm_.generateStreamLogprobs(handle, prompt.c_str(), &options, topLogprobs,
+                                                  logprobCallback, &ctx)
+                    : llm_.generateStream(handle, prompt.c_str(), &options, streamCallback,
+                                          &ctx);
 
             if (RAC_FAILED(rc)) {
                 RAC_LOG_ERROR("Server", "Streaming generation failed: %d", rc);
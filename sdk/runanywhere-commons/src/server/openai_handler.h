@@ -13,16 +13,47 @@
 
 #include "rac/server/rac_openai_types.h"
 #include "rac/features/llm/rac_llm_service.h"
+#include "rac/backends/rac_llm_llamacpp.h"
 
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 
 #include <string>
 #include <atomic>
+#include <utility>
+#include <vector>
 
 namespace rac {
 namespace server {
 
+/**
+ * @brief LLM entry points used by the handler
+ *
+ * Defaults to the LlamaCPP C API; the server swaps in the mock LLM
+ * (mock_llm.h) for load testing.
+ */
+struct LLMFunctions {
+    rac_result_t (*generate)(rac_handle_t handle, const char* prompt,
+                             const rac_llm_options_t* options,
+                             rac_llm_result_t* outResult) = rac_llm_llamacpp_generate;
+    rac_result_t (*generateStream)(rac_handle_t handle, const char* prompt,
+                                   const rac_llm_options_t* options,
+                                   rac_llm_llamacpp_stream_callback_fn callback,
+                                   void* userData) = rac_llm_llamacpp_generate_stream;
+    /** logprobs / top_logprobs streaming; nullptr rejects logprobs requests */
+    rac_result_t (*generateStreamLogprobs)(
+        rac_handle_t handle, const char* prompt, const rac_llm_options_t* options,
+        int32_t topLogprobs, rac_llm_llamacpp_logprob_stream_callback_fn callback,
+        void* userData) = rac_llm_llamacpp_generate_stream_logprobs;
+    /** n > 1 / best_of with a shared prompt prefill; nullptr loops generate() instead */
+    rac_result_t (*generateChoices)(rac_handle_t handle, const char* prompt,
+                                    const rac_llm_options_t* options, int32_t n, int32_t bestOf,
+                                    rac_llm_llamacpp_choice_t** outChoices,
+                                    int32_t* outNumChoices,
+                                    int32_t* outPromptTokens) = rac_llm_llamacpp_generate_choices;
+    rac_bool_t (*isModelLoaded)(rac_handle_t handle) = rac_llm_llamacpp_is_model_loaded;
+};
+
 /**
  * @brief OpenAI API request handler
  *
@@ -36,8 +67,18 @@ public:
      *
      * @param llmHandle LLM service handle (must remain valid)
      * @param modelId Model ID to report
+     * @param llm LLM entry points to call with llmHandle
+     */
+    OpenAIHandler(rac_handle_t llmHandle, const std::string& modelId,
+                  const LLMFunctions& llm = LLMFunctions());
+
+    /**
+     * @brief Serve an additional model ID backed by its own LLM handle
+     *
+     * Used for LoRA views that share the base model; requests whose "model"
+     * field matches modelId are generated with handle.
      */
-    OpenAIHandler(rac_handle_t llmHandle, const std::string& modelId);
+    void addModel(const std::string& modelId, rac_handle_t handle);
 
     /**
      * @brief Handle GET /v1/models
@@ -65,14 +106,18 @@ private:
      */
     void processNonStreaming(const httplib::Request& req,
                              httplib::Response& res,
-                             const nlohmann::json& requestJson);
+                             const nlohmann::json& requestJson,
+                             rac_handle_t handle,
+                             const std::string& modelId);
 
     /**
      * @brief Process a streaming chat completion request
      */
     void processStreaming(const httplib::Request& req,
                           httplib::Response& res,
-                          const nlohmann::json& requestJson);
+                          const nlohmann::json& requestJson,
+                          rac_handle_t handle,
+                          const std::string& modelId);
 
     /**
      * @brief Parse generation options from request
@@ -86,7 +131,9 @@ private:
                    const std::string& message, const std::string& type);
 
     rac_handle_t llmHandle_;
+    LLMFunctions llm_;
     std::string modelId_;
+    std::vector<std::pair<std::string, rac_handle_t>> extraModels_;
     std::atomic<int64_t> totalTokensGenerated_{0};
 };
 
@@ -0,0 +1,621 @@
+/**
+ * @file rac_base64.cpp
+ * @brief RunAnywhere Commons - Base64 Encoding and Decoding Implementation
+ *
+ * The decoder is a small character state machine (data URI header, partial
+ * groups, padding) with a bulk path: whenever it sits on a group boundary it
+ * hands the rest of the chunk to decode_groups(), which converts whole
+ * groups until it meets whitespace, padding or an invalid character.
+ */
+
+#include "rac/utils/rac_base64.h"
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define RAC_BASE64_AVX2 1
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+#include <tmmintrin.h>
+#define RAC_BASE64_SSSE3 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define RAC_BASE64_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define RAC_BASE64_NEON 1
+#endif
+
+namespace {
+
+const char kAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+constexpr uint8_t kInvalid = 0xFF;
+
+constexpr std::array<uint8_t, 256> make_decode_table() {
+    std::array<uint8_t, 256> table{};
+    for (auto& entry : table) {
+        entry = kInvalid;
+    }
+    for (uint8_t i = 0; i < 64; ++i) {
+        table[static_cast<uint8_t>(kAlphabet[i])] = i;
+    }
+    return table;
+}
+
+constexpr std::array<uint8_t, 256> kDecodeTable = make_decode_table();
+
+enum DecoderState : int32_t {
+    STATE_START = 0,   // may still be a "data:" header
+    STATE_HEADER = 1,  // inside a data URI header, skipping to ','
+    STATE_BODY = 2,    // base64 groups; pending holds 0-3 characters
+    STATE_PAD = 3,     // "xx=" seen, expecting the second '='
+    STATE_DONE = 4,    // final padded group seen, only whitespace may follow
+    STATE_ERROR = 5,
+};
+
+inline bool is_space(char c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == '\f' || c == '\v';
+}
+
+inline uint8_t value_of(char c) {
+    return kDecodeTable[static_cast<uint8_t>(c)];
+}
+
+// =============================================================================
+// ENCODING
+// =============================================================================
+
+inline void encode_group_scalar(const uint8_t* in, char* out) {
+    const uint32_t triple = (static_cast<uint32_t>(in[0]) << 16) |
+                            (static_cast<uint32_t>(in[1]) << 8) | in[2];
+    out[0] = kAlphabet[(triple >> 18) & 0x3F];
+    out[1] = kAlphabet[(triple >> 12) & 0x3F];
+    out[2] = kAlphabet[(triple >> 6) & 0x3F];
+    out[3] = kAlphabet[triple & 0x3F];
+}
+
+#if defined(RAC_BASE64_SSSE3)
+/**
+ * 12 input bytes -> 16 characters. Reads 16 bytes, so the caller keeps 4
+ * bytes of input slack.
+ */
+inline __m128i encode_block_ssse3(__m128i in) {
+    // Spread each 3-byte triple over a 32-bit lane as bytes [b1 b0 b2 b1]
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    // Move the four 6-bit fields into the low bits of their own bytes
+    const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+    const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+    const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+    const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+    const __m128i indices = _mm_or_si128(t1, t3);
+
+    // Map 0-63 to ASCII by adding a per-range offset picked with a shuffle
+    __m128i range = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    const __m128i below_26 = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    range = _mm_or_si128(range, _mm_and_si128(below_26, _mm_set1_epi8(13)));
+    const __m128i offsets = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                                          '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    return _mm_add_epi8(_mm_shuffle_epi8(offsets, range), indices);
+}
+#endif
+
+/** Encode whole groups; returns the number of input bytes consumed */
+size_t encode_groups(const uint8_t* in, size_t size, char* out) {
+    size_t pos = 0;
+    char* dst = out;
+
+#if defined(RAC_BASE64_SSSE3)
+    while (size - pos >= 16) {
+        const __m128i block =
+            encode_block_ssse3(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + pos)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), block);
+        pos += 12;
+        dst += 16;
+    }
+#elif defined(RAC_BASE64_NEON)
+    const uint8x16x4_t table = vld1q_u8_x4(reinterpret_cast<const uint8_t*>(kAlphabet));
+    const uint8x16_t low6 = vdupq_n_u8(0x3F);
+    while (size - pos >= 48) {
+        const uint8x16x3_t bytes = vld3q_u8(in + pos);
+        uint8x16x4_t indices;
+        indices.val[0] = vshrq_n_u8(bytes.val[0], 2);
+        indices.val[1] = vandq_u8(
+            vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), low6);
+        indices.val[2] = vandq_u8(
+            vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), low6);
+        indices.val[3] = vandq_u8(bytes.val[2], low6);
+        uint8x16x4_t chars;
+        for (int i = 0; i < 4; ++i) {
+            chars.val[i] = vqtbl4q_u8(table, indices.val[i]);
+        }
+        vst4q_u8(reinterpret_cast<uint8_t*>(dst), chars);
+        pos += 48;
+        dst += 64;
+    }
+#endif
+
+    for (; size - pos >= 3; pos += 3, dst += 4) {
+        encode_group_scalar(in + pos, dst);
+    }
+    return pos;
+}
+
+// =============================================================================
+// DECODING
+// =============================================================================
+
+inline void decode_group_values(uint8_t v0, uint8_t v1, uint8_t v2, uint8_t v3, uint8_t* out) {
+    out[0] = static_cast<uint8_t>((v0 << 2) | (v1 >> 4));
+    out[1] = static_cast<uint8_t>((v1 << 4) | (v2 >> 2));
+    out[2] = static_cast<uint8_t>((v2 << 6) | v3);
+}
+
+#if defined(RAC_BASE64_SSE2)
+/**
+ * ASCII -> 6-bit values for 16 characters. Sets *valid to false if any
+ * character is outside the alphabet (bytes >= 0x80 are negative as signed
+ * chars and fall outside every range).
+ */
+inline __m128i translate_sse2(__m128i c, bool* valid) {
+    const __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)),
+                                        _mm_cmplt_epi8(c, _mm_set1_epi8('Z' + 1)));
+    const __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)),
+                                        _mm_cmplt_epi8(c, _mm_set1_epi8('z' + 1)));
+    const __m128i digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                        _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+    const __m128i plus = _mm_cmpeq_epi8(c, _mm_set1_epi8('+'));
+    const __m128i slash = _mm_cmpeq_epi8(c, _mm_set1_epi8('/'));
+
+    const __m128i matched = _mm_or_si128(_mm_or_si128(upper, lower),
+                                         _mm_or_si128(digit, _mm_or_si128(plus, slash)));
+    *valid = _mm_movemask_epi8(matched) == 0xFFFF;
+
+    __m128i offset = _mm_and_si128(upper, _mm_set1_epi8(-'A'));
+    offset = _mm_or_si128(offset, _mm_and_si128(lower, _mm_set1_epi8(26 - 'a')));
+    offset = _mm_or_si128(offset, _mm_and_si128(digit, _mm_set1_epi8(52 - '0')));
+    offset = _mm_or_si128(offset, _mm_and_si128(plus, _mm_set1_epi8(62 - '+')));
+    offset = _mm_or_si128(offset, _mm_and_si128(slash, _mm_set1_epi8(63 - '/')));
+    return _mm_add_epi8(c, offset);
+}
+
+/** 16 characters -> 12 bytes; false (nothing written) on an invalid character */
+inline bool decode_block_sse(const char* in, uint8_t* out) {
+    bool valid = false;
+    const __m128i values =
+        translate_sse2(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), &valid);
+    if (!valid) {
+        return false;
+    }
+
+#if defined(RAC_BASE64_SSSE3)
+    // (v0 << 6 | v1) per 16-bit lane, then (pair0 << 12 | pair1) per 32-bit lane
+    const __m128i pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+    const __m128i triples = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+    const __m128i bytes = _mm_shuffle_epi8(
+        triples, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    alignas(16) uint8_t tmp[16];
+    _mm_store_si128(reinterpret_cast<__m128i*>(tmp), bytes);
+    std::memcpy(out, tmp, 12);
+#else
+    const __m128i pairs = _mm_or_si128(
+        _mm_slli_epi16(_mm_and_si128(values, _mm_set1_epi16(0x00FF)), 6),
+        _mm_srli_epi16(values, 8));
+    const __m128i triples = _mm_or_si128(
+        _mm_slli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0x0000FFFF)), 12),
+        _mm_srli_epi32(pairs, 16));
+    alignas(16) uint32_t tmp[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(tmp), triples);
+    for (int i = 0; i < 4; ++i) {
+        out[i * 3] = static_cast<uint8_t>(tmp[i] >> 16);
+        out[i * 3 + 1] = static_cast<uint8_t>(tmp[i] >> 8);
+        out[i * 3 + 2] = static_cast<uint8_t>(tmp[i]);
+    }
+#endif
+    return true;
+}
+#endif
+
+#if defined(RAC_BASE64_AVX2)
+/** 32 characters -> 24 bytes; false (nothing written) on an invalid character */
+inline bool decode_block_avx2(const char* in, uint8_t* out) {
+    const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in));
+    const __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('A' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), c));
+    const __m256i lower = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('a' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('z' + 1), c));
+    const __m256i digit = _mm256_and_si256(_mm256_cmpgt_epi8(c, _mm256_set1_epi8('0' - 1)),
+                                           _mm256_cmpgt_epi8(_mm256_set1_epi8('9' + 1), c));
+    const __m256i plus = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('+'));
+    const __m256i slash = _mm256_cmpeq_epi8(c, _mm256_set1_epi8('/'));
+
+    const __m256i matched = _mm256_or_si256(
+        _mm256_or_si256(upper, lower), _mm256_or_si256(digit, _mm256_or_si256(plus, slash)));
+    if (_mm256_movemask_epi8(matched) != -1) {
+        return false;
+    }
+
+    __m256i offset = _mm256_and_si256(upper, _mm256_set1_epi8(-'A'));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(lower, _mm256_set1_epi8(26 - 'a')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(digit, _mm256_set1_epi8(52 - '0')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(plus, _mm256_set1_epi8(62 - '+')));
+    offset = _mm256_or_si256(offset, _mm256_and_si256(slash, _mm256_set1_epi8(63 - '/')));
+    const __m256i values = _mm256_add_epi8(c, offset);
+
+    const __m256i pairs = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+    const __m256i triples = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+    // 12 bytes at the bottom of each 128-bit lane, then join the two lanes
+    __m256i bytes = _mm256_shuffle_epi8(
+        triples, _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1,
+                                  0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    bytes = _mm256_permutevar8x32_epi32(bytes, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+    alignas(32) uint8_t tmp[32];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(tmp), bytes);
+    std::memcpy(out, tmp, 24);
+    return true;
+}
+#endif
+
+#if defined(RAC_BASE64_NEON)
+inline uint8x16_t translate_neon(uint8x16_t c, uint8x16_t* matched) {
+    const uint8x16_t upper = vandq_u8(vcgeq_u8(c, vdupq_n_u8('A')), vcleq_u8(c, vdupq_n_u8('Z')));
+    const uint8x16_t lower = vandq_u8(vcgeq_u8(c, vdupq_n_u8('a')), vcleq_u8(c, vdupq_n_u8('z')));
+    const uint8x16_t digit = vandq_u8(vcgeq_u8(c, vdupq_n_u8('0')), vcleq_u8(c, vdupq_n_u8('9')));
+    const uint8x16_t plus = vceqq_u8(c, vdupq_n_u8('+'));
+    const uint8x16_t slash = vceqq_u8(c, vdupq_n_u8('/'));
+
+    *matched = vandq_u8(*matched, vorrq_u8(vorrq_u8(upper, lower),
+                                           vorrq_u8(digit, vorrq_u8(plus, slash))));
+
+    uint8x16_t offset = vandq_u8(upper, vdupq_n_u8(static_cast<uint8_t>(-'A')));
+    offset = vorrq_u8(offset, vandq_u8(lower, vdupq_n_u8(static_cast<uint8_t>(26 - 'a'))));
+    offset = vorrq_u8(offset, vandq_u8(digit, vdupq_n_u8(static_cast<uint8_t>(52 - '0'))));
+    offset = vorrq_u8(offset, vandq_u8(plus, vdupq_n_u8(static_cast<uint8_t>(62 - '+'))));
+    offset = vorrq_u8(offset, vandq_u8(slash, vdupq_n_u8(static_cast<uint8_t>(63 - '/'))));
+    return vaddq_u8(c, offset);
+}
+
+/** 64 characters -> 48 bytes; false (nothing written) on an invalid character */
+inline bool decode_block_neon(const char* in, uint8_t* out) {
+    // De-interleave so val[i] holds character i of each of the 16 groups
+    const uint8x16x4_t chars = vld4q_u8(reinterpret_cast<const uint8_t*>(in));
+    uint8x16_t matched = vdupq_n_u8(0xFF);
+    const uint8x16_t v0 = translate_neon(chars.val[0], &matched);
+    const uint8x16_t v1 = translate_neon(chars.val[1], &matched);
+    const uint8x16_t v2 = translate_neon(chars.val[2], &matched);
+    const uint8x16_t v3 = translate_neon(chars.val[3], &matched);
+    if (vminvq_u8(matched) != 0xFF) {
+        return false;
+    }
+
+    uint8x16x3_t bytes;
+    bytes.val[0] = vorrq_u8(vshlq_n_u8(v0, 2), vshrq_n_u8(v1, 4));
+    bytes.val[1] = vorrq_u8(vshlq_n_u8(v1, 4), vshrq_n_u8(v2, 2));
+    bytes.val[2] = vorrq_u8(vshlq_n_u8(v2, 6), v3);
+    vst3q_u8(out, bytes);
+    return true;
+}
+#endif
+
+/**
+ * Decode whole groups of alphabet characters from the start of in. Stops at
+ * the first group containing anything else (whitespace, '=', invalid) and
+ * returns the number of characters consumed, always a multiple of 4.
+ */
+size_t decode_groups(const char* in, size_t length, uint8_t* out, size_t* out_written) {
+    size_t pos = 0;
+    uint8_t* dst = out;
+
+    for (;;) {
+#if defined(RAC_BASE64_NEON)
+        constexpr size_t kBlock = 64;
+        while (length - pos >= kBlock && decode_block_neon(in + pos, dst)) {
+            pos += kBlock;
+            dst += kBlock / 4 * 3;
+        }
+#elif defined(RAC_BASE64_AVX2)
+        constexpr size_t kBlock = 32;
+        while (length - pos >= kBlock && decode_block_avx2(in + pos, dst)) {
+            pos += kBlock;
+            dst += kBlock / 4 * 3;
+        }
+#elif defined(RAC_BASE64_SSE2)
+        constexpr size_t kBlock = 16;
+        while (length - pos >= kBlock && decode_block_sse(in + pos, dst)) {
+            pos += kBlock;
+            dst += kBlock / 4 * 3;
+        }
+#else
+        constexpr size_t kBlock = 4;
+#endif
+
+        // The block that stopped the vector loop (or the short tail): walk it
+        // group by group, then retry the vector path behind it
+        const size_t block_end = pos + kBlock < length ? pos + kBlock : length;
+        bool stopped = false;
+        while (pos + 4 <= block_end) {
+            const uint8_t v0 = value_of(in[pos]);
+            const uint8_t v1 = value_of(in[pos + 1]);
+            const uint8_t v2 = value_of(in[pos + 2]);
+            const uint8_t v3 = value_of(in[pos + 3]);
+            if ((v0 | v1 | v2 | v3) & 0xC0) {
+                stopped = true;
+                break;
+            }
+            decode_group_values(v0, v1, v2, v3, dst);
+            pos += 4;
+            dst += 3;
+        }
+        if (stopped || length - pos < 4) {
+            break;
+        }
+    }
+
+    *out_written = static_cast<size_t>(dst - out);
+    return pos;
+}
+
+/** Feed one character through the scalar state machine */
+inline bool feed_char(rac_base64_decoder_t* decoder, char c, uint8_t** dst) {
+    if (is_space(c)) {
+        return true;
+    }
+
+    switch (decoder->state) {
+        case STATE_BODY: {
+            if (value_of(c) != kInvalid) {
+                decoder->pending[decoder->pending_count++] = c;
+                if (decoder->pending_count == 4) {
+                    decode_group_values(value_of(decoder->pending[0]),
+                                        value_of(decoder->pending[1]),
+                                        value_of(decoder->pending[2]),
+                                        value_of(decoder->pending[3]), *dst);
+                    *dst += 3;
+                    decoder->pending_count = 0;
+                }
+                return true;
+            }
+            if (c != '=') {
+                return false;
+            }
+            if (decoder->pending_count == 2) {
+                decoder->state = STATE_PAD;
+                return true;
+            }
+            if (decoder->pending_count == 3) {
+                uint8_t group[3];
+                decode_group_values(value_of(decoder->pending[0]), value_of(decoder->pending[1]),
+                                    value_of(decoder->pending[2]), 0, group);
+                std::memcpy(*dst, group, 2);
+                *dst += 2;
+                decoder->pending_count = 0;
+                decoder->state = STATE_DONE;
+                return true;
+            }
+            return false;
+        }
+        case STATE_PAD: {
+            if (c != '=') {
+                return false;
+            }
+            uint8_t group[3];
+            decode_group_values(value_of(decoder->pending[0]), value_of(decoder->pending[1]), 0, 0,
+                                group);
+            *(*dst)++ = group[0];
+            decoder->pending_count = 0;
+            decoder->state = STATE_DONE;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+/** Leave STATE_START: the buffered characters were body text after all */
+inline bool replay_start(rac_base64_decoder_t* decoder, uint8_t** dst) {
+    char buffered[sizeof(decoder->pending)];
+    const int32_t count = decoder->pending_count;
+    std::memcpy(buffered, decoder->pending, sizeof(buffered));
+    decoder->pending_count = 0;
+    decoder->state = STATE_BODY;
+    for (int32_t i = 0; i < count; ++i) {
+        if (!feed_char(decoder, buffered[i], dst)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+extern "C" {
+
+size_t rac_base64_encoded_size(size_t data_size) {
+    return (data_size + 2) / 3 * 4;
+}
+
+size_t rac_base64_decoded_max_size(size_t encoded_size) {
+    // One group more than the input holds: a chunk may complete a group
+    // whose first characters were carried over from the previous chunk
+    return (encoded_size / 4 + 1) * 3;
+}
+
+rac_result_t rac_base64_encode(const uint8_t* data, size_t data_size, char* out_text,
+                               size_t out_capacity, size_t* out_length) {
+    if ((!data && data_size > 0) || (!out_text && data_size > 0)) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    const size_t needed = rac_base64_encoded_size(data_size);
+    if (out_capacity < needed) {
+        return RAC_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    const size_t consumed = data_size > 0 ? encode_groups(data, data_size, out_text) : 0;
+    const size_t remaining = data_size - consumed;
+    if (remaining > 0) {
+        uint8_t tail[3] = {0, 0, 0};
+        std::memcpy(tail, data + consumed, remaining);
+        char* dst = out_text + consumed / 3 * 4;
+        encode_group_scalar(tail, dst);
+        dst[3] = '=';
+        if (remaining == 1) {
+            dst[2] = '=';
+        }
+    }
+
+    if (out_length) {
+        *out_length = needed;
+    }
+    return RAC_SUCCESS;
+}
+
+void rac_base64_decoder_init(rac_base64_decoder_t* decoder) {
+    if (decoder) {
+        std::memset(decoder, 0, sizeof(*decoder));
+        decoder->state = STATE_START;
+    }
+}
+
+rac_result_t rac_base64_decoder_update(rac_base64_decoder_t* decoder, const char* text,
+                                       size_t text_length, uint8_t* out_data, size_t out_capacity,
+                                       size_t* out_size) {
+    if (!decoder || !out_size || (!text && text_length > 0) || !out_data) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    *out_size = 0;
+    if (decoder->state == STATE_ERROR) {
+        return RAC_ERROR_INVALID_FORMAT;
+    }
+    if (out_capacity < rac_base64_decoded_max_size(text_length)) {
+        return RAC_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t* dst = out_data;
+    size_t pos = 0;
+    while (pos < text_length) {
+        if (decoder->state == STATE_BODY && decoder->pending_count == 0) {
+            size_t written = 0;
+            pos += decode_groups(text + pos, text_length - pos, dst, &written);
+            dst += written;
+            if (pos >= text_length) {
+                break;
+            }
+        }
+
+        const char c = text[pos++];
+        bool ok = true;
+        if (decoder->state == STATE_START) {
+            // Buffer while the text still reads "data"; decide at the 5th character
+            static const char kPrefix[] = "data";
+            if (is_space(c)) {
+                continue;
+            }
+            if (decoder->pending_count < 4 && c == kPrefix[decoder->pending_count]) {
+                decoder->pending[decoder->pending_count++] = c;
+                continue;
+            }
+            if (decoder->pending_count == 4 && c == ':') {
+                decoder->pending_count = 0;
+                decoder->state = STATE_HEADER;
+                continue;
+            }
+            ok = replay_start(decoder, &dst) && feed_char(decoder, c, &dst);
+        } else if (decoder->state == STATE_HEADER) {
+            if (c == ',') {
+                decoder->state = STATE_BODY;
+            }
+        } else {
+            ok = feed_char(decoder, c, &dst);
+        }
+
+        if (!ok) {
+            decoder->state = STATE_ERROR;
+            *out_size = static_cast<size_t>(dst - out_data);
+            return RAC_ERROR_INVALID_FORMAT;
+        }
+    }
+
+    *out_size = static_cast<size_t>(dst - out_data);
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_base64_decoder_finish(rac_base64_decoder_t* decoder, uint8_t* out_data,
+                                       size_t out_capacity, size_t* out_size) {
+    if (!decoder || !out_data || !out_size) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+    *out_size = 0;
+    if (out_capacity < 3) {
+        return RAC_ERROR_BUFFER_TOO_SMALL;
+    }
+
+    uint8_t* dst = out_data;
+    if (decoder->state == STATE_START && !replay_start(decoder, &dst)) {
+        decoder->state = STATE_ERROR;
+    }
+
+    switch (decoder->state) {
+        case STATE_BODY:
+        case STATE_PAD: {
+            // Unpadded (or half-padded) final group
+            const int32_t count = decoder->pending_count;
+            if (count == 1) {
+                decoder->state = STATE_ERROR;
+                return RAC_ERROR_INVALID_FORMAT;
+            }
+            if (count > 1) {
+                uint8_t group[3];
+                decode_group_values(value_of(decoder->pending[0]), value_of(decoder->pending[1]),
+                                    count > 2 ? value_of(decoder->pending[2]) : 0, 0, group);
+                std::memcpy(dst, group, static_cast<size_t>(count - 1));
+                dst += count - 1;
+            }
+            break;
+        }
+        case STATE_DONE:
+            break;
+        default:
+            // Inside a data URI header or after an error
+            decoder->state = STATE_ERROR;
+            return RAC_ERROR_INVALID_FORMAT;
+    }
+
+    decoder->pending_count = 0;
+    decoder->state = STATE_DONE;
+    *out_size = static_cast<size_t>(dst - out_data);
+    return RAC_SUCCESS;
+}
+
+rac_result_t rac_base64_decode(const char* text, size_t text_length, uint8_t* out_data,
+                               size_t out_capacity, size_t* out_size) {
+    if (!out_data || !out_size) {
+        return RAC_ERROR_NULL_POINTER;
+    }
+
+    rac_base64_decoder_t decoder;
+    rac_base64_decoder_init(&decoder);
+
+    size_t written = 0;
+    rac_result_t result =
+        rac_base64_decoder_update(&decoder, text, text_length, out_data, out_capacity, &written);
+    if (result != RAC_SUCCESS) {
+        *out_size = 0;
+        return result;
+    }
+
+    size_t tail = 0;
+    result = rac_base64_decoder_finish(&decoder, out_data + written, out_capacity - written, &tail);
+    *out_size = result == RAC_SUCCESS ? written + tail : 0;
+    return result;
+}
+
+}  // extern "C"
@@ -10,6 +10,7 @@
 #define STB_IMAGE_RESIZE_IMPLEMENTATION
 
 #include "rac/utils/rac_image_utils.h"
+#include "rac/utils/rac_base64.h"
 
 #include <algorithm>
 #include <cmath>
@@ -32,86 +33,8 @@
 
 static const char* LOG_CAT = "ImageUtils";
 
-// =============================================================================
-// BASE64 DECODING
-// =============================================================================
-
 namespace {
 
-/**
- * Base64 decoding table
- */
-static const int base64_decode_table[256] = {
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62,
-    -1, -1, -1, 63, 52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1, -1, 0,
-    1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22,
-    23, 24, 25, -1, -1, -1, -1, -1, -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38,
-    39, 40, 41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
-};
-
-/**
- * Decode base64 string to bytes
- */
-std::vector<uint8_t> base64_decode(const char* data, size_t len) {
-    std::vector<uint8_t> result;
-    if (!data || len == 0)
-        return result;
-
-    // Strip data URI prefix if present (e.g., "data:image/png;base64,")
-    std::string input(data, len);
-    size_t comma_pos = input.find(',');
-    if (comma_pos != std::string::npos) {
-        input = input.substr(comma_pos + 1);
-    }
-
-    // Remove whitespace
-    input.erase(std::remove_if(input.begin(), input.end(), ::isspace), input.end());
-
-    size_t input_len = input.length();
-    if (input_len == 0)
-        return result;
-
-    // Calculate output size
-    size_t out_len = (input_len / 4) * 3;
-    if (input_len >= 2 && input[input_len - 1] == '=')
-        out_len--;
-    if (input_len >= 2 && input[input_len - 2] == '=')
-        out_len--;
-
-    result.resize(out_len);
-
-    size_t out_idx = 0;
-    for (size_t i = 0; i < input_len;) {
-        int v1 = (i < input_len) ? base64_decode_table[(uint8_t)input[i++]] : 0;
-        int v2 = (i < input_len) ? base64_decode_table[(uint8_t)input[i++]] : 0;
-        int v3 = (i < input_len) ? base64_decode_table[(uint8_t)input[i++]] : 0;
-        int v4 = (i < input_len) ? base64_decode_table[(uint8_t)input[i++]] : 0;
-
-        if (v1 < 0 || v2 < 0)
-            break;
-
-        if (out_idx < out_len) {
-            result[out_idx++] = (v1 << 2) | (v2 >> 4);
-        }
-        if (v3 >= 0 && out_idx < out_len) {
-            result[out_idx++] = ((v2 & 0x0F) << 4) | (v3 >> 2);
-        }
-        if (v4 >= 0 && out_idx < out_len) {
-            result[out_idx++] = ((v3 & 0x03) << 6) | v4;
-        }
-    }
-
-    result.resize(out_idx);
-    return result;
-}
-
 /**
  * Simple bilinear resize without stb
  */
@@ -196,11 +119,15 @@ rac_result_t rac_image_decode_base64(const char* base64_data, size_t data_size,
     memset(out_image, 0, sizeof(rac_image_data_t));
 
     // Decode base64
-    std::vector<uint8_t> decoded = base64_decode(base64_data, data_size);
-    if (decoded.empty()) {
+    std::vector<uint8_t> decoded(rac_base64_decoded_max_size(data_size));
+    size_t decoded_size = 0;
+    if (rac_base64_decode(base64_data, data_size, decoded.data(), decoded.size(),
+                          &decoded_size) != RAC_SUCCESS ||
+        decoded_size == 0) {
         RAC_LOG_ERROR(LOG_CAT, "Failed to decode base64 data");
         return RAC_ERROR_INVALID_ARGUMENT;
     }
+    decoded.resize(decoded_size);
 
     // Decode image from bytes
     return rac_image_decode_bytes(decoded.data(), decoded.size(), out_image);
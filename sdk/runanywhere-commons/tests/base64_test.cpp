@@ -0,0 +1,141 @@
+/**
+ * @file base64_test.cpp
+ * @brief Tests for the shared base64 codec
+ *
+ * Lengths are chosen to cover every vector block size plus the scalar tail.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "rac/utils/rac_base64.h"
+
+namespace {
+
+std::vector<uint8_t> make_bytes(size_t size) {
+    std::vector<uint8_t> bytes(size);
+    uint32_t state = 0x12345678u;
+    for (auto& byte : bytes) {
+        state = state * 1664525u + 1013904223u;
+        byte = static_cast<uint8_t>(state >> 24);
+    }
+    return bytes;
+}
+
+// Straightforward reference encoder
+std::string reference_encode(const std::vector<uint8_t>& bytes) {
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    for (size_t i = 0; i < bytes.size(); i += 3) {
+        uint32_t n = static_cast<uint32_t>(bytes[i]) << 16;
+        if (i + 1 < bytes.size()) n |= static_cast<uint32_t>(bytes[i + 1]) << 8;
+        if (i + 2 < bytes.size()) n |= bytes[i + 2];
+        out += table[(n >> 18) & 0x3F];
+        out += table[(n >> 12) & 0x3F];
+        out += i + 1 < bytes.size() ? table[(n >> 6) & 0x3F] : '=';
+        out += i + 2 < bytes.size() ? table[n & 0x3F] : '=';
+    }
+    return out;
+}
+
+std::string encode(const std::vector<uint8_t>& bytes) {
+    std::string text(rac_base64_encoded_size(bytes.size()), '\0');
+    size_t length = 0;
+    EXPECT_EQ(rac_base64_encode(bytes.data(), bytes.size(), &text[0], text.size(), &length),
+              RAC_SUCCESS);
+    text.resize(length);
+    return text;
+}
+
+rac_result_t decode(const std::string& text, std::vector<uint8_t>* out) {
+    out->resize(rac_base64_decoded_max_size(text.size()));
+    size_t size = 0;
+    rac_result_t result = rac_base64_decode(text.data(), text.size(), out->data(), out->size(), &size);
+    out->resize(size);
+    return result;
+}
+
+TEST(Base64Test, RoundTripsEveryLength) {
+    for (size_t size = 0; size < 300; ++size) {
+        SCOPED_TRACE(size);
+        const std::vector<uint8_t> bytes = make_bytes(size);
+        const std::string text = encode(bytes);
+        ASSERT_EQ(text, reference_encode(bytes));
+
+        std::vector<uint8_t> decoded;
+        ASSERT_EQ(decode(text, &decoded), RAC_SUCCESS);
+        ASSERT_EQ(decoded, bytes);
+    }
+}
+
+TEST(Base64Test, KnownVectors) {
+    std::vector<uint8_t> decoded;
+    EXPECT_EQ(encode({'f', 'o', 'o', 'b', 'a', 'r'}), "Zm9vYmFy");
+    EXPECT_EQ(encode({'f', 'o'}), "Zm8=");
+    ASSERT_EQ(decode("Zm9vYg==", &decoded), RAC_SUCCESS);
+    EXPECT_EQ(std::string(decoded.begin(), decoded.end()), "foob");
+    ASSERT_EQ(decode("Zm9vYg", &decoded), RAC_SUCCESS);
+    EXPECT_EQ(std::string(decoded.begin(), decoded.end()), "foob");
+    ASSERT_EQ(decode("data", &decoded), RAC_SUCCESS);
+    EXPECT_EQ(decoded.size(), 3u);
+}
+
+TEST(Base64Test, StripsDataUriAndWhitespace) {
+    const std::vector<uint8_t> bytes = make_bytes(1000);
+    std::string text = encode(bytes);
+    std::string wrapped = "data:image/png;base64,";
+    for (size_t i = 0; i < text.size(); i += 76) {
+        wrapped += text.substr(i, 76) + "\r\n";
+    }
+
+    std::vector<uint8_t> decoded;
+    ASSERT_EQ(decode(wrapped, &decoded), RAC_SUCCESS);
+    EXPECT_EQ(decoded, bytes);
+}
+
+TEST(Base64Test, RejectsInvalidInput) {
+    std::vector<uint8_t> decoded;
+    std::string text = encode(make_bytes(200));
+    text[150] = '*';
+    EXPECT_EQ(decode(text, &decoded), RAC_ERROR_INVALID_FORMAT);
+    EXPECT_EQ(decode("Zm9vY", &decoded), RAC_ERROR_INVALID_FORMAT);
+    EXPECT_EQ(decode("Zm8=Zm8=", &decoded), RAC_ERROR_INVALID_FORMAT);
+    EXPECT_EQ(decode("data:image/png;base64", &decoded), RAC_ERROR_INVALID_FORMAT);
+
+    uint8_t small[2];
+    size_t size = 0;
+    EXPECT_EQ(rac_base64_decode("Zm9vYmFy", 8, small, sizeof(small), &size),
+              RAC_ERROR_BUFFER_TOO_SMALL);
+}
+
+TEST(Base64Test, StreamingMatchesOneShotForAnySplit) {
+    const std::vector<uint8_t> bytes = make_bytes(777);
+    const std::string text = "data:audio/wav;base64," + encode(bytes);
+
+    for (size_t chunk : {1u, 2u, 3u, 5u, 7u, 16u, 33u, 100u}) {
+        SCOPED_TRACE(chunk);
+        rac_base64_decoder_t decoder;
+        rac_base64_decoder_init(&decoder);
+        std::vector<uint8_t> decoded;
+        std::vector<uint8_t> buffer(rac_base64_decoded_max_size(chunk));
+        for (size_t offset = 0; offset < text.size(); offset += chunk) {
+            const size_t length = std::min(chunk, text.size() - offset);
+            size_t written = 0;
+            ASSERT_EQ(rac_base64_decoder_update(&decoder, text.data() + offset, length,
+                                                buffer.data(), buffer.size(), &written),
+                      RAC_SUCCESS);
+            decoded.insert(decoded.end(), buffer.begin(), buffer.begin() + written);
+        }
+        size_t written = 0;
+        ASSERT_EQ(rac_base64_decoder_finish(&decoder, buffer.data(), buffer.size(), &written),
+                  RAC_SUCCESS);
+        decoded.insert(decoded.end(), buffer.begin(), buffer.begin() + written);
+        EXPECT_EQ(decoded, bytes);
+    }
+}
+
+}  // namespace
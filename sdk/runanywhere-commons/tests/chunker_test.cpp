@@ -9,6 +9,7 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "rag_chunker.h"
@@ -281,6 +282,159 @@ TEST_F(ChunkerTest, OnlyPunctuation) {
     EXPECT_LE(chunks.size(), 10ul);
 }
 
+// ============================================================================
+// Zero-Copy Views and Token-Aware Mode
+// ============================================================================
+
+TEST_F(ChunkerTest, ViewsPointIntoSourceText) {
+    std::string text;
+    for (int i = 0; i < 200; ++i) {
+        text += "Sentence number " + std::to_string(i) + " is here. ";
+    }
+
+    auto views = chunker_.chunk_document_views(text);
+    auto chunks = chunker_.chunk_document(text);
+    ASSERT_EQ(views.size(), chunks.size());
+    for (size_t i = 0; i < views.size(); ++i) {
+        EXPECT_GE(views[i].text.data(), text.data());
+        EXPECT_LE(views[i].text.data() + views[i].text.size(), text.data() + text.size());
+        EXPECT_EQ(std::string(views[i].text), chunks[i].text);
+    }
+}
+
+TEST_F(ChunkerTest, LastChunkReachesEndOfText) {
+    std::string text;
+    for (int i = 0; i < 500; ++i) {
+        text += "Another short sentence. ";
+    }
+
+    auto chunks = chunker_.chunk_document(text);
+    ASSERT_FALSE(chunks.empty());
+    EXPECT_EQ(chunks.back().end_position, text.length());
+    for (size_t i = 1; i < chunks.size(); ++i) {
+        EXPECT_GT(chunks[i].start_position, chunks[i - 1].start_position);
+    }
+}
+
+TEST_F(ChunkerTest, OverlapLargerThanChunkStillTerminates) {
+    ChunkerConfig config;
+    config.chunk_size = 8;
+    config.chunk_overlap = 64;
+    DocumentChunker chunker(config);
+
+    std::string text;
+    for (int i = 0; i < 50; ++i) {
+        text += "Tiny. ";
+    }
+
+    auto chunks = chunker.chunk_document(text);
+    EXPECT_GE(chunks.size(), 2ul);
+}
+
+TEST_F(ChunkerTest, TokenAwareChunksRespectTokenBudget) {
+    // Whitespace-separated words stand in for a real tokenizer
+    auto count_words = [](std::string_view text) {
+        size_t words = 0;
+        bool in_word = false;
+        for (char c : text) {
+            bool space = c == ' ' || c == '\n';
+            if (!space && !in_word) {
+                ++words;
+            }
+            in_word = !space;
+        }
+        return words;
+    };
+
+    ChunkerConfig config;
+    config.chunk_size = 20;
+    config.chunk_overlap = 5;
+    config.count_tokens = count_words;
+    DocumentChunker chunker(config);
+
+    std::string text;
+    for (int i = 0; i < 100; ++i) {
+        text += "One two three four. ";  // 4 tokens per sentence
+    }
+
+    auto chunks = chunker.chunk_document(text);
+    ASSERT_GE(chunks.size(), 2ul);
+    for (const auto& chunk : chunks) {
+        EXPECT_LE(count_words(chunk.text), 20ul);
+        EXPECT_EQ(chunk.text.back(), '.');  // Ends on a sentence boundary
+    }
+    // One 4-token sentence fits in the 5-token overlap
+    EXPECT_EQ(chunks[1].start_position, chunks[0].end_position - 20);
+    EXPECT_EQ(chunks.back().end_position, text.length());
+    EXPECT_EQ(chunker.estimate_tokens("One two three."), 3ul);
+}
+
+TEST_F(ChunkerTest, WindowedChunkingMatchesWholeDocument) {
+    std::string text;
+    for (int i = 0; i < 2000; ++i) {
+        text += "Sentence " + std::to_string(i) + (i % 7 == 0 ? " ends a paragraph.\n" : " goes on. ");
+    }
+
+    auto expected = chunker_.chunk_document_views(text);
+
+    std::vector<TextChunkView> windowed;
+    const size_t window_size = 16 * 1024;
+    ChunkWindowState state;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        const bool at_end = pos + window_size >= text.size();
+        std::string_view window(text.data() + pos, std::min(window_size, text.size() - pos));
+        size_t consumed = 0;
+        for (const auto& chunk : chunker_.chunk_window(window, at_end, state, consumed)) {
+            windowed.push_back(chunk);
+        }
+        ASSERT_GT(consumed, 0ul);
+        pos += consumed;
+        if (at_end) {
+            break;
+        }
+    }
+
+    ASSERT_EQ(windowed.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(windowed[i].text, expected[i].text) << "chunk " << i;
+        EXPECT_EQ(windowed[i].chunk_index, expected[i].chunk_index) << "chunk " << i;
+    }
+}
+
+TEST_F(ChunkerTest, TinyTailIsMergedAcrossWindows) {
+    ChunkerConfig config;
+    config.chunk_size = 10;  // 40 characters
+    config.chunk_overlap = 0;
+    DocumentChunker chunker(config);
+
+    // Two full chunks and a tail too small to stand alone
+    const std::string text =
+        "Alpha alpha alpha alpha alpha alpha end. Beta beta beta beta beta beta beta end. Tail.";
+    const auto expected = chunker.chunk_document_views(text);
+    ASSERT_EQ(expected.size(), 2ul);
+    EXPECT_EQ(expected.back().end_position, text.size());
+
+    // The first window ends 10 characters into the second chunk. That stub
+    // is not the document tail, so the first chunk must not absorb it.
+    ChunkWindowState state;
+    size_t consumed = 0;
+    auto first = chunker.chunk_window(std::string_view(text).substr(0, 50), false, state,
+                                      consumed);
+    ASSERT_EQ(first.size(), 1ul);
+    EXPECT_EQ(first[0].text, expected[0].text);
+    EXPECT_EQ(state.next_chunk_index, 1ul);
+
+    // The real tail is chunked in the second window and still folds into
+    // the second chunk
+
+    auto second = chunker.chunk_window(std::string_view(text).substr(consumed), true, state,
+                                       consumed);
+    ASSERT_EQ(second.size(), 1ul);
+    EXPECT_EQ(second[0].text, expected[1].text);
+    EXPECT_EQ(second[0].chunk_index, 1ul);
+}
+
 // ============================================================================
 // Thread Safety - Basic Const Correctness Tests
 // ============================================================================
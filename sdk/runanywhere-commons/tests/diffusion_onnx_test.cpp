@@ -0,0 +1,193 @@
+/**
+ * @file diffusion_onnx_test.cpp
+ * @brief Unit tests for the ONNX diffusion pipeline (tokenizer, schedulers, end to end)
+ *
+ * The end-to-end test runs only when RAC_TEST_DIFFUSION_ONNX_DIR points at a
+ * diffusers ONNX export; tiny randomly initialised exports are enough.
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "clip_tokenizer.h"
+#include "diffusion_scheduler.h"
+#include "rac_diffusion_onnx.h"
+
+namespace runanywhere::diffusion {
+
+class ClipTokenizerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = ::testing::TempDir() + "clip_tokenizer_test";
+        std::filesystem::create_directories(dir_);
+
+        std::ofstream vocab(dir_ + "/vocab.json");
+        vocab << R"({"<|startoftext|>":0,"<|endoftext|>":1,"h":2,"e":3,"l":4,"o</w>":5,)"
+              << R"("he":6,"ll":7,"hell":8,"hello</w>":9,"c":10,"a":11,"t</w>":12,"ca":13,)"
+              << R"("cat</w>":14,"'":15,"s</w>":16,"'s</w>":17,"!</w>":18,"x</w>":19,"2</w>":20})";
+        vocab.close();
+
+        std::ofstream merges(dir_ + "/merges.txt");
+        merges << "#version: 0.2\nh e\nl l\nhe ll\nhell o</w>\nc a\nca t</w>\n' s</w>\n";
+        merges.close();
+
+        std::string error;
+        ASSERT_TRUE(tokenizer_.load(dir_, &error)) << error;
+    }
+
+    void TearDown() override { std::filesystem::remove_all(dir_); }
+
+    std::string dir_;
+    ClipTokenizer tokenizer_;
+};
+
+// Expected ids come from transformers.CLIPTokenizer on the same vocab/merges
+TEST_F(ClipTokenizerTest, MatchesReferenceTokenization) {
+    auto ids = tokenizer_.encode("HELLO  cat's!");
+    ASSERT_EQ(ids.size(), static_cast<size_t>(ClipTokenizer::kContextLength));
+    EXPECT_EQ(std::vector<int64_t>(ids.begin(), ids.begin() + 8),
+              (std::vector<int64_t>{0, 9, 14, 17, 18, 1, 1, 1}));
+
+    // Digits split one per token; newlines are whitespace
+    ids = tokenizer_.encode("hello\ncat 22");
+    EXPECT_EQ(std::vector<int64_t>(ids.begin(), ids.begin() + 8),
+              (std::vector<int64_t>{0, 9, 14, 20, 20, 1, 1, 1}));
+}
+
+TEST_F(ClipTokenizerTest, TruncatesToContextLength) {
+    std::string text;
+    for (int i = 0; i < 100; ++i) text += "x ";
+
+    const auto ids = tokenizer_.encode(text);
+    ASSERT_EQ(ids.size(), static_cast<size_t>(ClipTokenizer::kContextLength));
+    EXPECT_EQ(ids.front(), 0);
+    EXPECT_EQ(ids[75], 19);
+    EXPECT_EQ(ids[76], 1);
+}
+
+TEST(DiffusionSchedulerTest, LcmUsesOriginalScheduleSkips) {
+    SchedulerConfig config;
+    DiffusionScheduler scheduler(SchedulerKind::LCM, config);
+    scheduler.set_timesteps(4);
+
+    EXPECT_EQ(scheduler.timesteps(), (std::vector<double>{999, 759, 499, 259}));
+    EXPECT_FLOAT_EQ(scheduler.init_noise_sigma(), 1.0f);
+    EXPECT_FLOAT_EQ(scheduler.input_scale(0), 1.0f);
+}
+
+TEST(DiffusionSchedulerTest, EulerSigmasMatchReference) {
+    SchedulerConfig config;
+    DiffusionScheduler scheduler(SchedulerKind::EULER, config);
+    scheduler.set_timesteps(4);
+
+    const std::vector<double> expected = {999, 666, 333, 0};
+    ASSERT_EQ(scheduler.timesteps().size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_NEAR(scheduler.timesteps()[i], expected[i], 1e-9);
+    }
+    // diffusers EulerDiscreteScheduler, scaled_linear betas, linspace spacing
+    EXPECT_NEAR(scheduler.init_noise_sigma(), 14.614641f, 1e-4f);
+    EXPECT_NEAR(scheduler.input_scale(3), 0.99957491f, 1e-6f);
+}
+
+TEST(DiffusionSchedulerTest, EulerSingleStepRemovesPredictedNoise) {
+    SchedulerConfig config;
+    DiffusionScheduler scheduler(SchedulerKind::EULER, config);
+    scheduler.set_timesteps(1);
+
+    // One step goes from sigma_max straight to 0: x0 = x - sigma * eps
+    const float sigma = scheduler.init_noise_sigma();
+    std::vector<float> latents = {sigma * 2.0f + 0.5f, -sigma + 0.25f};
+    const std::vector<float> eps = {2.0f, -1.0f};
+    std::mt19937_64 rng(1);
+    scheduler.step(0, eps.data(), latents.data(), latents.size(), rng);
+
+    EXPECT_NEAR(latents[0], 0.5f, 1e-4f);
+    EXPECT_NEAR(latents[1], 0.25f, 1e-4f);
+}
+
+TEST(DiffusionSchedulerTest, ParsesSchedulerConfig) {
+    const auto config = SchedulerConfig::from_json(
+        R"({"_class_name":"LCMScheduler","beta_schedule":"linear","prediction_type":"v_prediction",)"
+        R"("num_train_timesteps":500,"original_inference_steps":25})");
+    EXPECT_TRUE(config.lcm);
+    EXPECT_FALSE(config.scaled_linear);
+    EXPECT_TRUE(config.v_prediction);
+    EXPECT_EQ(config.num_train_timesteps, 500);
+    EXPECT_EQ(config.original_inference_steps, 25);
+
+    // Malformed input keeps the defaults
+    EXPECT_EQ(SchedulerConfig::from_json("not json").num_train_timesteps, 1000);
+}
+
+TEST(DiffusionSchedulerTest, GuidanceEmbeddingMatchesReference) {
+    const auto embedding = guidance_scale_embedding(8.0f, 256);
+    ASSERT_EQ(embedding.size(), 256u);
+    EXPECT_NEAR(embedding[0], 0.50688543f, 1e-4f);
+    EXPECT_NEAR(embedding[1], 0.80438685f, 1e-4f);
+    EXPECT_NEAR(embedding[128], 0.86201343f, 1e-4f);
+}
+
+}  // namespace runanywhere::diffusion
+
+namespace {
+
+const char* model_dir() {
+    return std::getenv("RAC_TEST_DIFFUSION_ONNX_DIR");
+}
+
+rac_bool_t cancel_after_first_step(const rac_diffusion_progress_t* progress, void* user_data) {
+    auto* calls = static_cast<int*>(user_data);
+    ++*calls;
+    return progress->current_step >= 1 ? RAC_FALSE : RAC_TRUE;
+}
+
+TEST(DiffusionOnnxTest, GeneratesDeterministicImage) {
+    if (!model_dir()) {
+        GTEST_SKIP() << "RAC_TEST_DIFFUSION_ONNX_DIR not set";
+    }
+
+    rac_handle_t handle = nullptr;
+    ASSERT_EQ(rac_diffusion_onnx_create(model_dir(), nullptr, &handle), RAC_SUCCESS);
+
+    rac_diffusion_options_t options = RAC_DIFFUSION_OPTIONS_DEFAULT;
+    options.prompt = "a cat";
+    options.width = 64;
+    options.height = 64;
+    options.steps = 2;
+    options.seed = 42;
+
+    rac_diffusion_result_t first = {};
+    rac_diffusion_result_t second = {};
+    ASSERT_EQ(rac_diffusion_onnx_generate(handle, &options, &first), RAC_SUCCESS);
+    ASSERT_EQ(rac_diffusion_onnx_generate(handle, &options, &second), RAC_SUCCESS);
+
+    ASSERT_EQ(first.image_size, 64u * 64u * 4u);
+    EXPECT_EQ(first.seed_used, 42);
+    EXPECT_EQ(first.image_data[3], 255);
+    // The second run hits the prompt cache and must produce the same image
+    ASSERT_EQ(second.image_size, first.image_size);
+    EXPECT_EQ(std::vector<uint8_t>(first.image_data, first.image_data + first.image_size),
+              std::vector<uint8_t>(second.image_data, second.image_data + second.image_size));
+
+    int calls = 0;
+    rac_diffusion_result_t cancelled = {};
+    EXPECT_EQ(rac_diffusion_onnx_generate_with_progress(handle, &options, cancel_after_first_step,
+                                                        &calls, &cancelled),
+              RAC_ERROR_CANCELLED);
+    EXPECT_EQ(cancelled.image_data, nullptr);
+    EXPECT_GE(calls, 2);
+
+    rac_diffusion_result_free(&first);
+    rac_diffusion_result_free(&second);
+    rac_diffusion_onnx_destroy(handle);
+}
+
+}  // namespace
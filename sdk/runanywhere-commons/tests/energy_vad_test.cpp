@@ -0,0 +1,157 @@
+/**
+ * @file energy_vad_test.cpp
+ * @brief Tests for the interleaved RMS kernel, noise floor tracking and the
+ *        multi-stream energy VAD bank
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "rac/features/vad/rac_vad_energy.h"
+
+namespace {
+
+constexpr size_t kFrame = 1600;  // 100 ms at 16 kHz
+
+float sample_at(uint32_t* state, float amplitude) {
+    *state = *state * 1664525u + 1013904223u;
+    return amplitude * (static_cast<float>(*state >> 8) / 8388608.0f - 1.0f);
+}
+
+std::vector<float> noise(size_t count, float amplitude, uint32_t seed) {
+    std::vector<float> samples(count);
+    for (auto& sample : samples) {
+        sample = sample_at(&seed, amplitude);
+    }
+    return samples;
+}
+
+double reference_rms(const std::vector<float>& data, size_t frames, int32_t channels, int32_t c) {
+    double sum = 0.0;
+    for (size_t i = 0; i < frames; ++i) {
+        const double x = data[i * channels + c];
+        sum += x * x;
+    }
+    return frames ? std::sqrt(sum / static_cast<double>(frames)) : 0.0;
+}
+
+TEST(EnergyVadTest, InterleavedRmsMatchesReference) {
+    for (int32_t channels : {1, 2, 3, 5, 8, 17, 64, RAC_VAD_MAX_STREAMS}) {
+        for (size_t frames : {size_t(1), size_t(7), size_t(33), kFrame}) {
+            SCOPED_TRACE(channels);
+            SCOPED_TRACE(frames);
+            std::vector<float> data = noise(frames * channels, 0.5f, 42u + channels);
+            std::vector<float> rms(channels);
+            ASSERT_EQ(rac_energy_vad_calculate_rms_interleaved(data.data(), frames, channels,
+                                                               rms.data()),
+                      RAC_SUCCESS);
+            for (int32_t c = 0; c < channels; ++c) {
+                EXPECT_NEAR(rms[c], reference_rms(data, frames, channels, c), 1e-5);
+            }
+        }
+    }
+
+    std::vector<float> mono = noise(1001, 0.3f, 7u);
+    EXPECT_NEAR(rac_energy_vad_calculate_rms(mono.data(), mono.size()),
+                reference_rms(mono, mono.size(), 1, 0), 1e-5);
+
+    float out = 1.0f;
+    EXPECT_EQ(rac_energy_vad_calculate_rms_interleaved(mono.data(), 1, 0, &out),
+              RAC_ERROR_INVALID_ARGUMENT);
+    EXPECT_EQ(rac_energy_vad_calculate_rms_interleaved(mono.data(), 1, RAC_VAD_MAX_STREAMS + 1,
+                                                       &out),
+              RAC_ERROR_INVALID_ARGUMENT);
+}
+
+TEST(EnergyVadTest, BankCalibratesAndDetectsPerStream) {
+    constexpr int32_t kStreams = 3;
+    rac_energy_vad_bank_handle_t bank = nullptr;
+    ASSERT_EQ(rac_energy_vad_bank_create(nullptr, kStreams, &bank), RAC_SUCCESS);
+
+    std::vector<float> frame(kFrame * kStreams);
+    std::vector<rac_bool_t> has_voice(kStreams);
+    std::vector<rac_bool_t> speaking(kStreams);
+    uint32_t seed = 1u;
+
+    auto run = [&](int frames, float a0, float a1, float a2) {
+        for (int f = 0; f < frames; ++f) {
+            for (size_t i = 0; i < kFrame; ++i) {
+                frame[i * kStreams + 0] = sample_at(&seed, a0);
+                frame[i * kStreams + 1] = sample_at(&seed, a1);
+                frame[i * kStreams + 2] = sample_at(&seed, a2);
+            }
+            ASSERT_EQ(rac_energy_vad_bank_process(bank, frame.data(), kFrame, has_voice.data(),
+                                                  speaking.data()),
+                      RAC_SUCCESS);
+        }
+    };
+
+    // Calibration frames never report voice
+    run(RAC_VAD_CALIBRATION_FRAMES_NEEDED, 0.001f, 0.001f, 0.02f);
+    for (int32_t s = 0; s < kStreams; ++s) {
+        EXPECT_EQ(has_voice[s], RAC_FALSE);
+    }
+
+    // Only stream 0 gets loud; stream 2 stays at its own (noisier) floor
+    run(RAC_VAD_VOICE_START_THRESHOLD, 0.2f, 0.001f, 0.02f);
+    EXPECT_EQ(speaking[0], RAC_TRUE);
+    EXPECT_EQ(speaking[1], RAC_FALSE);
+    EXPECT_EQ(speaking[2], RAC_FALSE);
+
+    run(RAC_VAD_VOICE_END_THRESHOLD, 0.001f, 0.001f, 0.02f);
+    EXPECT_EQ(speaking[0], RAC_FALSE);
+
+    rac_energy_vad_stats_t stats;
+    ASSERT_EQ(rac_energy_vad_bank_get_statistics(bank, 1, &stats), RAC_SUCCESS);
+    EXPECT_GE(stats.threshold, RAC_VAD_MIN_THRESHOLD);
+    EXPECT_LT(stats.ambient, 0.002f);
+
+    ASSERT_EQ(rac_energy_vad_bank_reset_stream(bank, 0), RAC_SUCCESS);
+    ASSERT_EQ(rac_energy_vad_bank_get_statistics(bank, 0, &stats), RAC_SUCCESS);
+    EXPECT_EQ(stats.current, 0.0f);
+    EXPECT_EQ(rac_energy_vad_bank_reset_stream(bank, kStreams), RAC_ERROR_INVALID_ARGUMENT);
+
+    rac_energy_vad_bank_destroy(bank);
+}
+
+TEST(EnergyVadTest, NoiseTrackingFollowsFloorWhenEnabled) {
+    rac_energy_vad_handle_t vad = nullptr;
+    ASSERT_EQ(rac_energy_vad_create(nullptr, &vad), RAC_SUCCESS);
+    ASSERT_EQ(rac_energy_vad_initialize(vad), RAC_SUCCESS);
+
+    auto feed = [&](int frames, float amplitude, uint32_t seed) {
+        rac_bool_t has_voice = RAC_FALSE;
+        for (int f = 0; f < frames; ++f) {
+            std::vector<float> frame = noise(kFrame, amplitude, seed + f);
+            EXPECT_EQ(rac_energy_vad_process_audio(vad, frame.data(), frame.size(), &has_voice),
+                      RAC_SUCCESS);
+        }
+        return has_voice;
+    };
+
+    // Calibrate in a noisy room, then the noise drops
+    feed(RAC_VAD_CALIBRATION_FRAMES_NEEDED, 0.01f, 100u);
+    float calibrated = 0.0f;
+    ASSERT_EQ(rac_energy_vad_get_threshold(vad, &calibrated), RAC_SUCCESS);
+
+    feed(50, 0.001f, 200u);
+    float threshold = 0.0f;
+    ASSERT_EQ(rac_energy_vad_get_threshold(vad, &threshold), RAC_SUCCESS);
+    EXPECT_EQ(threshold, calibrated);  // Swift behaviour: fixed after calibration
+
+    ASSERT_EQ(rac_energy_vad_set_noise_tracking(vad, RAC_TRUE), RAC_SUCCESS);
+    feed(50, 0.001f, 300u);
+    ASSERT_EQ(rac_energy_vad_get_threshold(vad, &threshold), RAC_SUCCESS);
+    EXPECT_LT(threshold, calibrated);
+    EXPECT_GE(threshold, RAC_VAD_MIN_THRESHOLD);
+
+    // Speech over the new floor is now detected
+    EXPECT_EQ(feed(1, 0.02f, 400u), RAC_TRUE);
+
+    rac_energy_vad_destroy(vad);
+}
+
+}  // namespace
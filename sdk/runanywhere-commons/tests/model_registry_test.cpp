@@ -0,0 +1,224 @@
+/**
+ * @file model_registry_test.cpp
+ * @brief Tests for the indexed model registry and its snapshots
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "rac/infrastructure/model_management/rac_model_registry.h"
+
+namespace {
+
+class ModelRegistryTest : public ::testing::Test {
+protected:
+    void SetUp() override { ASSERT_EQ(rac_model_registry_create(&registry_), RAC_SUCCESS); }
+
+    void TearDown() override { rac_model_registry_destroy(registry_); }
+
+    void save(const char* id, rac_inference_framework_t framework, rac_model_category_t category,
+              const char* local_path = nullptr) {
+        rac_model_info_t model = {};
+        model.id = const_cast<char*>(id);
+        model.name = const_cast<char*>(id);
+        model.framework = framework;
+        model.category = category;
+        model.local_path = const_cast<char*>(local_path);
+        ASSERT_EQ(rac_model_registry_save(registry_, &model), RAC_SUCCESS);
+    }
+
+    std::string id_by_path(const char* path) {
+        rac_model_info_t* model = nullptr;
+        if (rac_model_registry_get_by_path(registry_, path, &model) != RAC_SUCCESS) {
+            return "";
+        }
+        std::string id = model->id;
+        rac_model_info_free(model);
+        return id;
+    }
+
+    rac_model_registry_handle_t registry_ = nullptr;
+};
+
+TEST_F(ModelRegistryTest, IndexesByFrameworkCategoryAndDownloadState) {
+    save("b-llm", RAC_FRAMEWORK_LLAMACPP, RAC_MODEL_CATEGORY_LANGUAGE, "/models/b");
+    save("a-llm", RAC_FRAMEWORK_LLAMACPP, RAC_MODEL_CATEGORY_LANGUAGE);
+    save("c-stt", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_SPEECH_RECOGNITION, "/models/c");
+
+    rac_model_info_t** models = nullptr;
+    size_t count = 0;
+    const rac_inference_framework_t frameworks[] = {RAC_FRAMEWORK_ONNX, RAC_FRAMEWORK_LLAMACPP};
+    ASSERT_EQ(rac_model_registry_get_by_frameworks(registry_, frameworks, 2, &models, &count),
+              RAC_SUCCESS);
+    ASSERT_EQ(count, 3u);
+    EXPECT_STREQ(models[0]->id, "a-llm");
+    EXPECT_STREQ(models[2]->id, "c-stt");
+    rac_model_info_array_free(models, count);
+
+    ASSERT_EQ(rac_model_registry_get_by_category(registry_, RAC_MODEL_CATEGORY_LANGUAGE, &models,
+                                                 &count),
+              RAC_SUCCESS);
+    EXPECT_EQ(count, 2u);
+    rac_model_info_array_free(models, count);
+
+    ASSERT_EQ(rac_model_registry_get_downloaded(registry_, &models, &count), RAC_SUCCESS);
+    ASSERT_EQ(count, 2u);
+    EXPECT_STREQ(models[0]->id, "b-llm");
+    rac_model_info_array_free(models, count);
+
+    ASSERT_EQ(rac_model_registry_update_download_status(registry_, "b-llm", nullptr), RAC_SUCCESS);
+    ASSERT_EQ(rac_model_registry_get_downloaded(registry_, &models, &count), RAC_SUCCESS);
+    ASSERT_EQ(count, 1u);
+    EXPECT_STREQ(models[0]->id, "c-stt");
+    rac_model_info_array_free(models, count);
+}
+
+TEST_F(ModelRegistryTest, GetByPathMatchesExactAndPrefixes) {
+    save("tiny", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_LANGUAGE, "/models/onnx/tiny");
+    save("tiny-v2", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_LANGUAGE, "/models/onnx/tiny-v2");
+    save("whisper", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_LANGUAGE, "/models/onnx/whisper/base");
+
+    EXPECT_EQ(id_by_path("/models/onnx/tiny"), "tiny");
+    EXPECT_EQ(id_by_path("/models/onnx/tiny-v2/model.onnx"), "tiny-v2");
+    EXPECT_EQ(id_by_path("/models/onnx/tiny/model.onnx"), "tiny");
+    EXPECT_EQ(id_by_path("/models/onnx/whisper"), "whisper");
+    EXPECT_EQ(id_by_path("/models/llama"), "");
+}
+
+TEST_F(ModelRegistryTest, SnapshotIsUnaffectedByLaterWrites) {
+    save("a", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_LANGUAGE);
+    const uint64_t version = rac_model_registry_get_version(registry_);
+
+    rac_model_registry_snapshot_t snapshot = nullptr;
+    ASSERT_EQ(rac_model_registry_snapshot_acquire(registry_, &snapshot), RAC_SUCCESS);
+    const rac_model_info_t* a = rac_model_registry_snapshot_find(snapshot, "a");
+    ASSERT_NE(a, nullptr);
+
+    ASSERT_EQ(rac_model_registry_update_last_used(registry_, "a"), RAC_SUCCESS);
+    ASSERT_EQ(rac_model_registry_remove(registry_, "a"), RAC_SUCCESS);
+    save("b", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_LANGUAGE);
+    EXPECT_GT(rac_model_registry_get_version(registry_), version);
+
+    // The snapshot still owns the original model
+    EXPECT_EQ(rac_model_registry_snapshot_version(snapshot), version);
+    EXPECT_STREQ(a->id, "a");
+    EXPECT_EQ(a->usage_count, 0);
+    const rac_model_info_t* const* models = nullptr;
+    size_t count = 0;
+    ASSERT_EQ(rac_model_registry_snapshot_get_all(snapshot, &models, &count), RAC_SUCCESS);
+    ASSERT_EQ(count, 1u);
+    EXPECT_EQ(models[0], a);
+    EXPECT_EQ(rac_model_registry_snapshot_find(snapshot, "b"), nullptr);
+    rac_model_registry_snapshot_release(snapshot);
+}
+
+TEST_F(ModelRegistryTest, ReadersRunConcurrentlyWithWriters) {
+    std::atomic<bool> stop{false};
+    std::thread writer([&] {
+        for (int i = 0; i < 500; ++i) {
+            const std::string id = "model-" + std::to_string(i % 20);
+            const std::string path = "/models/" + id;
+            save(id.c_str(), RAC_FRAMEWORK_LLAMACPP, RAC_MODEL_CATEGORY_LANGUAGE, path.c_str());
+            rac_model_registry_update_last_used(registry_, id.c_str());
+        }
+        stop = true;
+    });
+
+    while (!stop) {
+        rac_model_registry_snapshot_t snapshot = nullptr;
+        ASSERT_EQ(rac_model_registry_snapshot_acquire(registry_, &snapshot), RAC_SUCCESS);
+        const rac_model_info_t* const* models = nullptr;
+        size_t count = 0;
+        rac_model_registry_snapshot_get_downloaded(snapshot, &models, &count);
+        for (size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(rac_model_registry_snapshot_find_by_path(snapshot, models[i]->local_path),
+                      models[i]);
+        }
+        rac_model_registry_snapshot_release(snapshot);
+    }
+    writer.join();
+
+    rac_model_info_t** models = nullptr;
+    size_t count = 0;
+    ASSERT_EQ(rac_model_registry_get_all(registry_, &models, &count), RAC_SUCCESS);
+    EXPECT_EQ(count, 20u);
+    rac_model_info_array_free(models, count);
+}
+
+TEST_F(ModelRegistryTest, CatalogRoundTripsAndChecksPathsLazily) {
+    char pattern[] = "/tmp/rac_model_catalog_XXXXXX";
+    ASSERT_NE(mkdtemp(pattern), nullptr);
+    const std::string dir = pattern;
+    const std::string kept = dir + "/kept.gguf";
+    const std::string changed = dir + "/changed.gguf";
+    std::ofstream(kept) << "weights";
+    std::ofstream(changed) << "weights";
+
+    const char* tags[] = {"chat", "small"};
+    rac_model_info_t model = {};
+    model.id = const_cast<char*>("kept");
+    model.name = const_cast<char*>("Kept");
+    model.framework = RAC_FRAMEWORK_LLAMACPP;
+    model.local_path = const_cast<char*>(kept.c_str());
+    model.tags = const_cast<char**>(tags);
+    model.tag_count = 2;
+    model.context_length = 4096;
+    ASSERT_EQ(rac_model_registry_save(registry_, &model), RAC_SUCCESS);
+    save("changed", RAC_FRAMEWORK_LLAMACPP, RAC_MODEL_CATEGORY_LANGUAGE, changed.c_str());
+    save("gone", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_LANGUAGE, (dir + "/missing").c_str());
+    save("remote", RAC_FRAMEWORK_ONNX, RAC_MODEL_CATEGORY_LANGUAGE);
+
+    const std::string catalog = dir + "/catalog.bin";
+    ASSERT_EQ(rac_model_registry_write_catalog(registry_, catalog.c_str()), RAC_SUCCESS);
+    std::ofstream(changed) << "different weights";
+
+    rac_model_registry_handle_t loaded = nullptr;
+    ASSERT_EQ(rac_model_registry_create(&loaded), RAC_SUCCESS);
+    size_t count = 0;
+    ASSERT_EQ(rac_model_registry_load_catalog(loaded, catalog.c_str(), &count), RAC_SUCCESS);
+    EXPECT_EQ(count, 4u);
+
+    rac_model_info_t* info = nullptr;
+    ASSERT_EQ(rac_model_registry_get(loaded, "kept", &info), RAC_SUCCESS);
+    EXPECT_STREQ(info->name, "Kept");
+    EXPECT_STREQ(info->local_path, kept.c_str());
+    EXPECT_EQ(info->context_length, 4096);
+    ASSERT_EQ(info->tag_count, 2u);
+    EXPECT_STREQ(info->tags[1], "small");
+    rac_model_info_free(info);
+
+    // The path was gone when written, and the other one changed afterwards
+    ASSERT_EQ(rac_model_registry_get(loaded, "gone", &info), RAC_SUCCESS);
+    EXPECT_EQ(info->local_path, nullptr);
+    rac_model_info_free(info);
+    ASSERT_EQ(rac_model_registry_get(loaded, "changed", &info), RAC_SUCCESS);
+    EXPECT_EQ(info->local_path, nullptr);
+    rac_model_info_free(info);
+
+    // A damaged file is rejected as a whole
+    {
+        std::fstream file(catalog, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(100);
+        file.put('\x7f');
+    }
+    rac_model_registry_handle_t damaged = nullptr;
+    ASSERT_EQ(rac_model_registry_create(&damaged), RAC_SUCCESS);
+    EXPECT_EQ(rac_model_registry_load_catalog(damaged, catalog.c_str(), &count),
+              RAC_ERROR_INVALID_FORMAT);
+    EXPECT_EQ(count, 0u);
+
+    rac_model_registry_destroy(damaged);
+    rac_model_registry_destroy(loaded);
+    std::system(("rm -rf " + dir).c_str());
+}
+
+}  // namespace
@@ -0,0 +1,464 @@
+/**
+ * @file native_download_test.cpp
+ * @brief Tests for the native downloader against a local range-capable HTTP server
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "rac/infrastructure/download/rac_archive_extract.h"
+#include "rac/infrastructure/download/rac_download.h"
+#include "rac/infrastructure/download/rac_native_download.h"
+
+namespace {
+
+constexpr size_t kBodySize = 3 * 1024 * 1024;
+constexpr const char* kBodySha256 =
+    "1cbc21bf8061157b183e691c3ba5770668a1cfd9f5cca321b117d077e00ab1d6";
+
+std::string make_body() {
+    std::string body(kBodySize, '\0');
+    for (size_t i = 0; i < body.size(); ++i) {
+        body[i] = static_cast<char>((i * 131 + (i >> 12)) & 0xff);
+    }
+    return body;
+}
+
+// Minimal HTTP/1.1 server: one request per connection, honours "Range: bytes=a-b"
+class RangeServer {
+public:
+    explicit RangeServer(std::string body) : body_(std::move(body)) {
+        listen_fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        sockaddr_in addr{};
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+        socklen_t length = sizeof(addr);
+        getsockname(listen_fd_, reinterpret_cast<sockaddr*>(&addr), &length);
+        port_ = ntohs(addr.sin_port);
+        listen(listen_fd_, 16);
+        acceptor_ = std::thread([this] { accept_loop(); });
+    }
+
+    ~RangeServer() {
+        stopping_ = true;
+        shutdown(listen_fd_, SHUT_RDWR);
+        close(listen_fd_);
+        acceptor_.join();
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    std::string url() const {
+        return "http://127.0.0.1:" + std::to_string(port_) + "/model.bin";
+    }
+
+    // Number of upcoming body responses to cut off half-way
+    std::atomic<int> drop_responses{0};
+    // Per-16 KiB delay, to keep downloads running long enough to cancel
+    std::atomic<int> chunk_delay_us{0};
+    std::atomic<int> range_requests{0};
+    std::atomic<size_t> bytes_served{0};
+
+private:
+    void accept_loop() {
+        while (!stopping_) {
+            int fd = accept(listen_fd_, nullptr, nullptr);
+            if (fd < 0) {
+                continue;
+            }
+            std::lock_guard<std::mutex> lock(mutex_);
+            workers_.emplace_back([this, fd] { serve(fd); });
+        }
+    }
+
+    void serve(int fd) {
+        std::string request;
+        char buffer[4096];
+        while (request.find("\r\n\r\n") == std::string::npos) {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) {
+                close(fd);
+                return;
+            }
+            request.append(buffer, static_cast<size_t>(n));
+        }
+
+        size_t start = 0;
+        size_t end = body_.size() - 1;
+        bool ranged = false;
+        const size_t range = request.find("Range: bytes=");
+        if (range != std::string::npos) {
+            ranged = true;
+            start = std::strtoull(request.c_str() + range + 13, nullptr, 10);
+            const char* dash = std::strchr(request.c_str() + range, '-');
+            if (dash && dash[1] >= '0' && dash[1] <= '9') {
+                end = std::min<size_t>(std::strtoull(dash + 1, nullptr, 10), end);
+            }
+            range_requests.fetch_add(1);
+        }
+
+        const size_t length = end - start + 1;
+        std::string header = ranged ? "HTTP/1.1 206 Partial Content\r\n" : "HTTP/1.1 200 OK\r\n";
+        header += "Content-Length: " + std::to_string(length) + "\r\n";
+        if (ranged) {
+            header += "Content-Range: bytes " + std::to_string(start) + "-" + std::to_string(end) +
+                      "/" + std::to_string(body_.size()) + "\r\n";
+        }
+        header += "ETag: \"v1\"\r\nConnection: close\r\n\r\n";
+        send(fd, header.data(), header.size(), MSG_NOSIGNAL);
+
+        size_t limit = length;
+        if (length > 1 && drop_responses.fetch_sub(1) > 0) {
+            limit = length / 2;
+        }
+
+        constexpr size_t kChunk = 16 * 1024;
+        for (size_t sent = 0; sent < limit && !stopping_;) {
+            const size_t n = std::min(kChunk, limit - sent);
+            if (send(fd, body_.data() + start + sent, n, MSG_NOSIGNAL) <= 0) {
+                break;
+            }
+            sent += n;
+            bytes_served.fetch_add(n);
+            if (int delay = chunk_delay_us.load()) {
+                std::this_thread::sleep_for(std::chrono::microseconds(delay));
+            }
+        }
+        close(fd);
+    }
+
+    std::string body_;
+    int listen_fd_ = -1;
+    uint16_t port_ = 0;
+    std::atomic<bool> stopping_{false};
+    std::thread acceptor_;
+    std::mutex mutex_;
+    std::vector<std::thread> workers_;
+};
+
+class NativeDownloadTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        if (!rac_native_download_is_available()) {
+            GTEST_SKIP() << "Built without the native downloader";
+        }
+        char pattern[] = "/tmp/rac_native_download_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern), nullptr);
+        dir_ = pattern;
+        destination_ = dir_ + "/model.bin";
+        body_ = make_body();
+        server_ = std::make_unique<RangeServer>(body_);
+
+        options_ = RAC_NATIVE_DOWNLOAD_OPTIONS_DEFAULT;
+        options_.min_segment_bytes = 512 * 1024;
+        options_.stall_timeout_seconds = 5;
+    }
+
+    void TearDown() override {
+        server_.reset();
+        if (!dir_.empty()) {
+            std::system(("rm -rf " + dir_).c_str());
+        }
+    }
+
+    static bool exists(const std::string& path) { return access(path.c_str(), F_OK) == 0; }
+
+    // Result and final path reported by the download manager's complete callback
+    struct ManagerResult {
+        std::mutex mutex;
+        bool completed = false;
+        rac_result_t result = RAC_SUCCESS;
+        std::string final_path;
+    };
+
+    static void on_manager_complete(const char*, rac_result_t result, const char* final_path,
+                                    void* user) {
+        auto* r = static_cast<ManagerResult*>(user);
+        std::lock_guard<std::mutex> lock(r->mutex);
+        r->completed = true;
+        r->result = result;
+        r->final_path = final_path ? final_path : "";
+    }
+
+    static bool wait_for(ManagerResult& r) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+        while (std::chrono::steady_clock::now() < deadline) {
+            {
+                std::lock_guard<std::mutex> lock(r.mutex);
+                if (r.completed) {
+                    return true;
+                }
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+
+    std::string read_destination() const {
+        std::ifstream in(destination_, std::ios::binary);
+        return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    std::string dir_;
+    std::string destination_;
+    std::string body_;
+    std::unique_ptr<RangeServer> server_;
+    rac_native_download_options_t options_;
+};
+
+TEST_F(NativeDownloadTest, ParallelRangesWithChecksum) {
+    options_.expected_sha256 = kBodySha256;
+
+    std::atomic<int64_t> last_progress{0};
+    auto progress = [](int64_t downloaded, int64_t, void* user) {
+        static_cast<std::atomic<int64_t>*>(user)->store(downloaded);
+    };
+
+    ASSERT_EQ(rac_native_download_file(server_->url().c_str(), destination_.c_str(), &options_,
+                                       progress, &last_progress),
+              RAC_SUCCESS);
+
+    EXPECT_EQ(read_destination(), body_);
+    EXPECT_EQ(last_progress.load(), static_cast<int64_t>(kBodySize));
+    // Probe plus one request per segment
+    EXPECT_EQ(server_->range_requests.load(), 1 + options_.max_connections);
+    EXPECT_FALSE(exists(destination_ + ".part"));
+    EXPECT_FALSE(exists(destination_ + ".part.json"));
+}
+
+TEST_F(NativeDownloadTest, ChecksumMismatchDiscardsFile) {
+    options_.expected_sha256 =
+        "0000000000000000000000000000000000000000000000000000000000000000";
+
+    EXPECT_EQ(rac_native_download_file(server_->url().c_str(), destination_.c_str(), &options_,
+                                       nullptr, nullptr),
+              RAC_ERROR_CHECKSUM_MISMATCH);
+    EXPECT_FALSE(exists(destination_));
+    EXPECT_FALSE(exists(destination_ + ".part"));
+}
+
+// No platform adapter is set in this binary, so the manager downloads natively
+TEST_F(NativeDownloadTest, ManagerPassesExpectedChecksum) {
+    rac_download_manager_handle_t manager = nullptr;
+    ASSERT_EQ(rac_download_manager_create(nullptr, &manager), RAC_SUCCESS);
+
+    ManagerResult good;
+    char* task_id = nullptr;
+    ASSERT_EQ(rac_download_manager_start_verified(manager, "model", server_->url().c_str(),
+                                                  destination_.c_str(), RAC_FALSE, kBodySha256,
+                                                  nullptr, on_manager_complete, &good, &task_id),
+              RAC_SUCCESS);
+    ASSERT_TRUE(wait_for(good));
+    EXPECT_EQ(good.result, RAC_SUCCESS);
+    EXPECT_EQ(good.final_path, destination_);
+    EXPECT_EQ(read_destination(), body_);
+
+    rac_download_progress_t progress;
+    ASSERT_EQ(rac_download_manager_get_progress(manager, task_id, &progress), RAC_SUCCESS);
+    EXPECT_EQ(progress.state, RAC_DOWNLOAD_STATE_COMPLETED);
+    rac_free(task_id);
+
+    ManagerResult bad;
+    const std::string other = dir_ + "/other.bin";
+    ASSERT_EQ(rac_download_manager_start_verified(
+                  manager, "other", server_->url().c_str(), other.c_str(), RAC_FALSE,
+                  "0000000000000000000000000000000000000000000000000000000000000000", nullptr,
+                  on_manager_complete, &bad, &task_id),
+              RAC_SUCCESS);
+    ASSERT_TRUE(wait_for(bad));
+    EXPECT_EQ(bad.result, RAC_ERROR_CHECKSUM_MISMATCH);
+    EXPECT_FALSE(exists(other));
+    rac_free(task_id);
+
+    rac_download_manager_destroy(manager);
+}
+
+TEST_F(NativeDownloadTest, RetriesDroppedConnections) {
+    options_.expected_sha256 = kBodySha256;
+    server_->drop_responses = 3;
+
+    ASSERT_EQ(rac_native_download_file(server_->url().c_str(), destination_.c_str(), &options_,
+                                       nullptr, nullptr),
+              RAC_SUCCESS);
+    EXPECT_EQ(read_destination(), body_);
+}
+
+TEST_F(NativeDownloadTest, CancelKeepsProgressForResume) {
+    options_.expected_sha256 = kBodySha256;
+    server_->chunk_delay_us = 20000;
+
+    struct State {
+        std::atomic<int64_t> downloaded{0};
+        std::atomic<bool> completed{false};
+        std::atomic<rac_result_t> result{RAC_SUCCESS};
+    } state;
+
+    auto progress = [](int64_t downloaded, int64_t, void* user) {
+        static_cast<State*>(user)->downloaded.store(downloaded);
+    };
+    auto complete = [](rac_result_t result, const char*, void* user) {
+        auto* s = static_cast<State*>(user);
+        s->result.store(result);
+        s->completed.store(true);
+    };
+
+    char* task_id = nullptr;
+    ASSERT_EQ(rac_native_download_start(server_->url().c_str(), destination_.c_str(), &options_,
+                                        progress, complete, &state, &task_id),
+              RAC_SUCCESS);
+    ASSERT_NE(task_id, nullptr);
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (state.downloaded.load() < static_cast<int64_t>(kBodySize / 4) &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(rac_native_download_cancel(task_id), RAC_SUCCESS);
+    while (!state.completed.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    ASSERT_TRUE(state.completed.load());
+    EXPECT_EQ(state.result.load(), RAC_ERROR_CANCELLED);
+    EXPECT_EQ(rac_native_download_cancel(task_id), RAC_ERROR_NOT_FOUND);
+    rac_free(task_id);
+
+    EXPECT_TRUE(exists(destination_ + ".part"));
+    EXPECT_TRUE(exists(destination_ + ".part.json"));
+
+    // Resume: only the missing bytes are fetched again
+    server_->chunk_delay_us = 0;
+    const size_t served_before = server_->bytes_served.load();
+    ASSERT_EQ(rac_native_download_file(server_->url().c_str(), destination_.c_str(), &options_,
+                                       nullptr, nullptr),
+              RAC_SUCCESS);
+    EXPECT_EQ(read_destination(), body_);
+    EXPECT_LT(server_->bytes_served.load() - served_before, kBodySize);
+}
+
+TEST_F(NativeDownloadTest, ExtractsArchiveWhileDownloading) {
+    if (!rac_archive_extractor_supports(RAC_ARCHIVE_TYPE_TAR_GZ)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+
+    // Serve a tar.gz of the test body instead of the body itself
+    const std::string source = dir_ + "/src";
+    ASSERT_EQ(std::system(("mkdir -p " + source).c_str()), 0);
+    {
+        std::ofstream out(source + "/model.bin", std::ios::binary);
+        out << body_;
+    }
+    const std::string archive = dir_ + "/model.tar.gz";
+    ASSERT_EQ(std::system(("tar -czf " + archive + " -C " + source + " model.bin").c_str()), 0);
+    std::ifstream in(archive, std::ios::binary);
+    server_ = std::make_unique<RangeServer>(
+        std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+    server_->drop_responses = 1;  // The resumed request must continue the stream
+
+    struct Seen {
+        bool extracting = false;
+        bool completed = false;
+    } seen;
+    auto progress = [](const rac_download_progress_t* progress, void* user) {
+        auto* s = static_cast<Seen*>(user);
+        s->extracting |= progress->stage == RAC_DOWNLOAD_STAGE_EXTRACTING;
+        s->completed |= progress->stage == RAC_DOWNLOAD_STAGE_COMPLETED;
+    };
+
+    const std::string destination = dir_ + "/extracted";
+    ASSERT_EQ(rac_native_download_extract(server_->url().c_str(), destination.c_str(),
+                                          RAC_ARCHIVE_TYPE_TAR_GZ, &options_, progress, &seen),
+              RAC_SUCCESS);
+    EXPECT_TRUE(seen.extracting);
+    EXPECT_TRUE(seen.completed);
+
+    std::ifstream extracted(destination + "/model.bin", std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(extracted),
+                          std::istreambuf_iterator<char>()),
+              body_);
+}
+
+TEST_F(NativeDownloadTest, ManagerExtractsTarArchiveWhileDownloading) {
+    if (!rac_archive_extractor_supports(RAC_ARCHIVE_TYPE_TAR_GZ)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+
+    const std::string source = dir_ + "/src";
+    ASSERT_EQ(std::system(("mkdir -p " + source).c_str()), 0);
+    {
+        std::ofstream out(source + "/model.bin", std::ios::binary);
+        out << body_;
+    }
+    const std::string archive = dir_ + "/model.tar.gz";
+    ASSERT_EQ(std::system(("tar -czf " + archive + " -C " + source + " model.bin").c_str()), 0);
+    std::ifstream in(archive, std::ios::binary);
+    const std::string archive_bytes((std::istreambuf_iterator<char>(in)),
+                                    std::istreambuf_iterator<char>());
+    server_ = std::make_unique<RangeServer>(archive_bytes);
+
+    // The archive type comes from the URL
+    std::string url = server_->url();
+    url.replace(url.rfind(".bin"), 4, ".tar.gz");
+
+    struct Seen {
+        std::atomic<bool> extracting{false};
+        ManagerResult result;
+    } seen;
+    auto progress = [](const rac_download_progress_t* progress, void* user) {
+        if (progress->state == RAC_DOWNLOAD_STATE_EXTRACTING) {
+            static_cast<Seen*>(user)->extracting.store(true);
+        }
+    };
+    auto complete = [](const char* task_id, rac_result_t result, const char* final_path,
+                       void* user) {
+        on_manager_complete(task_id, result, final_path, &static_cast<Seen*>(user)->result);
+    };
+
+    rac_download_manager_handle_t manager = nullptr;
+    ASSERT_EQ(rac_download_manager_create(nullptr, &manager), RAC_SUCCESS);
+    const std::string destination = dir_ + "/extracted";
+    char* task_id = nullptr;
+    ASSERT_EQ(rac_download_manager_start(manager, "archive", url.c_str(), destination.c_str(),
+                                         RAC_TRUE, progress, complete, &seen, &task_id),
+              RAC_SUCCESS);
+    ASSERT_TRUE(wait_for(seen.result));
+    EXPECT_EQ(seen.result.result, RAC_SUCCESS);
+    EXPECT_EQ(seen.result.final_path, destination);
+    EXPECT_TRUE(seen.extracting.load());
+
+    rac_download_progress_t state;
+    ASSERT_EQ(rac_download_manager_get_progress(manager, task_id, &state), RAC_SUCCESS);
+    EXPECT_EQ(state.state, RAC_DOWNLOAD_STATE_COMPLETED);
+    EXPECT_EQ(state.total_bytes, static_cast<int64_t>(archive_bytes.size()));
+    rac_free(task_id);
+    rac_download_manager_destroy(manager);
+
+    std::ifstream extracted(destination + "/model.bin", std::ios::binary);
+    EXPECT_EQ(std::string(std::istreambuf_iterator<char>(extracted),
+                          std::istreambuf_iterator<char>()),
+              body_);
+}
+
+}  // namespace
@@ -0,0 +1,119 @@
+/**
+ * @file ort_model_cache_test.cpp
+ * @brief Unit tests for the ONNX Runtime optimized-model cache key
+ *
+ * No session is created: each test stands in for ORT by writing the file it
+ * would have saved to pending_path.
+ */
+
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "ort_model_cache.h"
+#include "rac/infrastructure/model_management/rac_model_paths.h"
+
+namespace runanywhere {
+namespace {
+
+class OrtModelCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir_ = ::testing::TempDir() + "ort_model_cache_test";
+        std::filesystem::remove_all(dir_);
+        std::filesystem::create_directories(dir_);
+        ASSERT_EQ(rac_model_paths_set_base_dir(dir_.c_str()), RAC_SUCCESS);
+
+        model_path_ = dir_ + "/model.onnx";
+        write_model(std::string(256 * 1024, 'a'));
+
+        api_ = OrtGetApiBase()->GetApi(ORT_API_VERSION);
+        ASSERT_NE(api_, nullptr);
+        ASSERT_EQ(api_->CreateSessionOptions(&options_), nullptr);
+    }
+
+    void TearDown() override {
+        if (options_) {
+            api_->ReleaseSessionOptions(options_);
+        }
+        std::filesystem::remove_all(dir_);
+    }
+
+    void write_model(const std::string& contents) {
+        std::ofstream(model_path_, std::ios::binary | std::ios::trunc) << contents;
+    }
+
+    // Prepare and, on a miss, publish an entry as if the session was created
+    OrtCachedModel load(const char* providers = nullptr) {
+        OrtCachedModel model =
+            ort_model_cache_prepare(model_path_.c_str(), ORT_ENABLE_ALL, options_, providers);
+        if (!model.hit && !model.pending_path.empty()) {
+            std::ofstream(model.pending_path) << "optimized";
+            ort_model_cache_finish(model, true);
+        }
+        return model;
+    }
+
+    std::string dir_;
+    std::string model_path_;
+    const OrtApi* api_ = nullptr;
+    OrtSessionOptions* options_ = nullptr;
+};
+
+TEST_F(OrtModelCacheTest, SecondLoadHitsCache) {
+    const OrtCachedModel first = load();
+    ASSERT_FALSE(first.cache_path.empty());
+    EXPECT_FALSE(first.hit);
+    EXPECT_EQ(first.load_path, model_path_);
+    EXPECT_TRUE(std::filesystem::exists(first.cache_path));
+
+    const OrtCachedModel second = load();
+    EXPECT_TRUE(second.hit);
+    EXPECT_EQ(second.load_path, first.cache_path);
+}
+
+TEST_F(OrtModelCacheTest, ChangedContentMisses) {
+    const OrtCachedModel first = load();
+
+    // Same size, one byte changed in the middle of the file, newer mtime
+    std::string contents(256 * 1024, 'a');
+    contents[128 * 1024] = 'b';
+    write_model(contents);
+    std::filesystem::last_write_time(
+        model_path_, std::filesystem::last_write_time(model_path_) + std::chrono::seconds(1));
+
+    const OrtCachedModel second = load();
+    EXPECT_FALSE(second.hit);
+    EXPECT_NE(second.cache_path, first.cache_path);
+    // The new entry supersedes the old one
+    EXPECT_FALSE(std::filesystem::exists(first.cache_path));
+}
+
+TEST_F(OrtModelCacheTest, SessionSettingsAreKeyed) {
+    const OrtCachedModel cpu = load();
+
+    const OrtCachedModel xnnpack = load("XNNPACK,CPU");
+    EXPECT_FALSE(xnnpack.hit);
+    EXPECT_NE(xnnpack.cache_path, cpu.cache_path);
+
+    ASSERT_EQ(api_->AddSessionConfigEntry(options_, "session.disable_quant_qdq", "1"), nullptr);
+    const OrtCachedModel no_qdq = load();
+    EXPECT_FALSE(no_qdq.hit);
+    EXPECT_NE(no_qdq.cache_path, cpu.cache_path);
+    EXPECT_TRUE(load().hit);
+}
+
+TEST_F(OrtModelCacheTest, UnusableEntryIsDropped) {
+    load();
+    const OrtCachedModel hit =
+        ort_model_cache_prepare(model_path_.c_str(), ORT_ENABLE_ALL, options_);
+    ASSERT_TRUE(hit.hit);
+
+    ort_model_cache_finish(hit, false);
+    EXPECT_FALSE(std::filesystem::exists(hit.cache_path));
+    EXPECT_FALSE(load().hit);
+}
+
+}  // namespace
+}  // namespace runanywhere
@@ -0,0 +1,169 @@
+/**
+ * @file rag_file_ingest_test.cpp
+ * @brief Tests for file and streamed document ingestion in RAGBackend
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "rag_backend.h"
+
+namespace runanywhere::rag {
+
+// Embeds every text as the same vector so any query retrieves all chunks
+class ConstantEmbeddingProvider final : public IEmbeddingProvider {
+public:
+    explicit ConstantEmbeddingProvider(size_t dimension) : dimension_(dimension) {}
+
+    std::vector<float> embed(const std::string&) override {
+        return std::vector<float>(dimension_, 0.5f);
+    }
+
+    size_t dimension() const noexcept override { return dimension_; }
+    bool is_ready() const noexcept override { return true; }
+    const char* name() const noexcept override { return "ConstantEmbeddingProvider"; }
+
+private:
+    size_t dimension_;
+};
+
+} // namespace runanywhere::rag
+
+namespace {
+
+using namespace runanywhere::rag;
+
+RAGBackendConfig small_config() {
+    RAGBackendConfig config;
+    config.embedding_dimension = 4;
+    config.chunk_size = 64;
+    config.chunk_overlap = 8;
+    config.top_k = 1000;
+    config.similarity_threshold = 0.0f;
+    return config;
+}
+
+std::string make_document(size_t min_bytes) {
+    std::string text;
+    for (int i = 0; text.size() < min_bytes; ++i) {
+        text += "Line " + std::to_string(i) + " of the ingestion test document. ";
+    }
+    return text;
+}
+
+std::string write_temp_file(const std::string& contents) {
+    char path[] = "/tmp/rag_ingest_test_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return "";
+    }
+    FILE* file = fdopen(fd, "wb");
+    fwrite(contents.data(), 1, contents.size(), file);
+    fclose(file);
+    return path;
+}
+
+}  // namespace
+
+TEST(RAGFileIngest, FileChunksMatchInMemoryIngestAndReadBackFromFile) {
+    // Larger than one ingestion window
+    const std::string text = make_document(3 << 19);
+    const std::string path = write_temp_file(text);
+    ASSERT_FALSE(path.empty());
+
+    RAGBackend from_memory(small_config(), std::make_unique<ConstantEmbeddingProvider>(4));
+    ASSERT_TRUE(from_memory.add_document(text));
+
+    RAGBackend from_file(small_config(), std::make_unique<ConstantEmbeddingProvider>(4));
+    ASSERT_TRUE(from_file.add_document_file(path, {{"title", "test"}}));
+
+    ASSERT_EQ(from_file.document_count(), from_memory.document_count());
+
+    auto results = from_file.search("anything", 5);
+    ASSERT_FALSE(results.empty());
+    for (const auto& result : results) {
+        EXPECT_NE(result.source.file_id, 0u);
+        EXPECT_EQ(result.text, text.substr(result.source.offset, result.source.length));
+        EXPECT_EQ(result.metadata.value("title", ""), "test");
+    }
+
+    std::remove(path.c_str());
+}
+
+TEST(RAGFileIngest, StreamStoresTextInline) {
+    const std::string text = make_document(3 << 19);
+    size_t pos = 0;
+
+    RAGBackend streamed(small_config(), std::make_unique<ConstantEmbeddingProvider>(4));
+    ASSERT_TRUE(streamed.add_document_stream([&](char* buffer, size_t capacity) -> int64_t {
+        // Deliberately short reads
+        size_t n = std::min<size_t>({capacity, 4096, text.size() - pos});
+        std::memcpy(buffer, text.data() + pos, n);
+        pos += n;
+        return static_cast<int64_t>(n);
+    }));
+
+    RAGBackend from_memory(small_config(), std::make_unique<ConstantEmbeddingProvider>(4));
+    ASSERT_TRUE(from_memory.add_document(text));
+    EXPECT_EQ(streamed.document_count(), from_memory.document_count());
+
+    auto results = streamed.search("anything", 3);
+    ASSERT_FALSE(results.empty());
+    EXPECT_EQ(results[0].source.file_id, 0u);
+    EXPECT_NE(text.find(results[0].text), std::string::npos);
+}
+
+TEST(RAGFileIngest, ReaderErrorFailsIngest) {
+    RAGBackend backend(small_config(), std::make_unique<ConstantEmbeddingProvider>(4));
+    EXPECT_FALSE(backend.add_document_stream([](char*, size_t) -> int64_t { return -1; }));
+    EXPECT_FALSE(backend.add_document_file("/nonexistent/rag_ingest_test.txt"));
+}
+
+TEST(RAGFileIngest, SavedIndexKeepsSourceFiles) {
+    const std::string text = "First chunk text. Second chunk text.";
+    const std::string path = write_temp_file(text);
+    ASSERT_FALSE(path.empty());
+    const std::string index_path = path + ".index";
+
+    VectorStoreConfig config;
+    config.dimension = 4;
+
+    {
+        SourceRegistry sources;
+        sources.add("/unrelated/earlier_file.txt", 1);  // Ids differ between processes
+        const uint32_t file_id = sources.add(path, text.size());
+
+        VectorStoreUSearch store(config);
+        DocumentChunk chunk;
+        chunk.id = "chunk_0";
+        chunk.embedding = {0.5f, 0.5f, 0.5f, 0.5f};
+        chunk.source = {file_id, 18, 18};
+        ASSERT_TRUE(store.add_chunk(chunk));
+
+        EXPECT_FALSE(store.save(index_path));
+        ASSERT_TRUE(store.save(index_path, &sources));
+    }
+
+    SourceRegistry sources;
+    VectorStoreUSearch store(config);
+    EXPECT_FALSE(store.load(index_path));
+    ASSERT_TRUE(store.load(index_path, &sources));
+
+    auto results = store.search({0.5f, 0.5f, 0.5f, 0.5f}, 1);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(sources.path(results[0].source.file_id), path);
+    std::string chunk_text;
+    ASSERT_TRUE(sources.read(results[0].source, chunk_text));
+    EXPECT_EQ(chunk_text, "Second chunk text.");
+
+    std::remove(index_path.c_str());
+    std::remove((index_path + ".metadata.json").c_str());
+    std::remove(path.c_str());
+}
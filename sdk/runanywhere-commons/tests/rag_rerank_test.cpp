@@ -0,0 +1,127 @@
+/**
+ * @file rag_rerank_test.cpp
+ * @brief Tests for the cross-encoder reranking stage in RAGBackend search
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "rag_backend.h"
+
+namespace runanywhere::rag {
+
+// Embeds every text as the same vector so any query retrieves all chunks
+class ConstantEmbeddingProvider final : public IEmbeddingProvider {
+public:
+    explicit ConstantEmbeddingProvider(size_t dimension) : dimension_(dimension) {}
+
+    std::vector<float> embed(const std::string&) override {
+        return std::vector<float>(dimension_, 0.5f);
+    }
+
+    size_t dimension() const noexcept override { return dimension_; }
+    bool is_ready() const noexcept override { return true; }
+    const char* name() const noexcept override { return "ConstantEmbeddingProvider"; }
+
+private:
+    size_t dimension_;
+};
+
+// Scores a passage by whether it contains the query; records batch sizes
+class KeywordRerankProvider final : public IRerankProvider {
+public:
+    explicit KeywordRerankProvider(std::vector<size_t>* batches, bool fail = false)
+        : batches_(batches), fail_(fail) {}
+
+    std::vector<float> score(const std::string& query,
+                             const std::vector<std::string>& passages) override {
+        batches_->push_back(passages.size());
+        if (fail_) {
+            return {};
+        }
+        std::vector<float> scores;
+        for (const auto& passage : passages) {
+            scores.push_back(passage.find(query) != std::string::npos ? 0.9f : 0.1f);
+        }
+        return scores;
+    }
+
+    bool is_ready() const noexcept override { return true; }
+    const char* name() const noexcept override { return "KeywordRerankProvider"; }
+
+private:
+    std::vector<size_t>* batches_;
+    bool fail_;
+};
+
+} // namespace runanywhere::rag
+
+namespace {
+
+using namespace runanywhere::rag;
+
+std::unique_ptr<RAGBackend> make_backend(size_t rerank_candidates) {
+    RAGBackendConfig config;
+    config.embedding_dimension = 4;
+    config.top_k = 1;
+    config.rerank_candidates = rerank_candidates;
+    config.similarity_threshold = 0.0f;
+
+    auto backend = std::make_unique<RAGBackend>(
+        config, std::make_unique<ConstantEmbeddingProvider>(config.embedding_dimension));
+    for (const char* text : {"first filler passage", "second filler passage",
+                             "the passage about zebras", "last filler passage"}) {
+        EXPECT_TRUE(backend->add_document(text));
+    }
+    return backend;
+}
+
+TEST(RAGRerankTest, RerankerPicksTopKFromCandidates) {
+    auto backend = make_backend(50);
+    std::vector<size_t> batches;
+    backend->set_rerank_provider(std::make_unique<KeywordRerankProvider>(&batches));
+
+    const auto results = backend->search("zebras", 1);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].text, "the passage about zebras");
+    EXPECT_FLOAT_EQ(results[0].score, 0.9f);
+
+    // All candidates are scored in a single call
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0], 4u);
+}
+
+TEST(RAGRerankTest, CandidateCountLimitsVectorSearch) {
+    auto backend = make_backend(2);
+    std::vector<size_t> batches;
+    backend->set_rerank_provider(std::make_unique<KeywordRerankProvider>(&batches));
+
+    const auto results = backend->search("zebras", 1);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_EQ(batches.size(), 1u);
+    EXPECT_EQ(batches[0], 2u);
+}
+
+TEST(RAGRerankTest, FailedScoringKeepsVectorOrder) {
+    auto backend = make_backend(50);
+    const auto baseline = backend->search("zebras", 1);
+    ASSERT_EQ(baseline.size(), 1u);
+
+    std::vector<size_t> batches;
+    backend->set_rerank_provider(std::make_unique<KeywordRerankProvider>(&batches, true));
+
+    const auto results = backend->search("zebras", 1);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].text, baseline[0].text);
+    EXPECT_EQ(batches.size(), 1u);
+
+    // Removing the reranker restores plain vector search
+    backend->set_rerank_provider(nullptr);
+    backend->search("zebras", 1);
+    EXPECT_EQ(batches.size(), 1u);
+}
+
+} // namespace
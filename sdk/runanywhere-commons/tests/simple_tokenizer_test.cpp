@@ -1,34 +1,95 @@
 /**
  * @file simple_tokenizer_test.cpp
- * @brief Unit tests for SimpleTokenizer (embedded in ONNX embedding provider)
- * 
- * Note: SimpleTokenizer is currently an internal class inside onnx_embedding_provider.cpp.
- * These tests verify the tokenization logic through the ONNXEmbeddingProvider interface.
- * This file is a placeholder for future public tokenizer interface tests.
+ * @brief Unit tests for SimpleTokenizer (shared by the ONNX embedding and rerank providers)
  */
 
 #include <gtest/gtest.h>
 #include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <string>
 #include <vector>
 
+#include "simple_tokenizer.h"
+
 namespace runanywhere::rag {
 
-// Placeholder test class for SimpleTokenizer
-// Once SimpleTokenizer is extracted to a public header, these tests will be activated
 class SimpleTokenizerTest : public ::testing::Test {
 protected:
-    SimpleTokenizerTest() {}
+    void SetUp() override {
+        vocab_path_ = ::testing::TempDir() + "simple_tokenizer_vocab.txt";
+        std::ofstream out(vocab_path_);
+        // ids: [PAD]=0 [UNK]=1 [CLS]=2 [SEP]=3 what=4 is=5 rag=6 retrieval=7 ##s=8 the=9
+        out << "[PAD]\n[UNK]\n[CLS]\n[SEP]\nwhat\nis\nrag\nretrieval\n##s\nthe\n";
+        out.close();
+        ASSERT_TRUE(tokenizer_.load_vocab(vocab_path_));
+    }
+
+    void TearDown() override { std::remove(vocab_path_.c_str()); }
+
+    std::string vocab_path_;
+    SimpleTokenizer tokenizer_;
 };
 
-// ============================================================================
-// Placeholder Tests - Will be implemented when SimpleTokenizer is public
-// ============================================================================
+TEST_F(SimpleTokenizerTest, EncodePadsToMaxLength) {
+    // Punctuation separates words and is dropped; unknown words map to [UNK]
+    const auto ids = tokenizer_.encode("What is RAG? Unknown", 8);
+    const std::vector<int64_t> expected = {2, 4, 5, 6, 1, 3, 0, 0};
+    EXPECT_EQ(ids, expected);
+
+    const std::vector<int64_t> mask = {1, 1, 1, 1, 1, 1, 0, 0};
+    EXPECT_EQ(tokenizer_.create_attention_mask(ids), mask);
+}
+
+TEST_F(SimpleTokenizerTest, SplitsWordPieces) {
+    EXPECT_EQ(tokenizer_.count_tokens("retrievals"), 2u);
+    const std::vector<int64_t> expected = {2, 7, 8, 3};
+    EXPECT_EQ(tokenizer_.encode("retrievals", 4), expected);
+}
+
+TEST_F(SimpleTokenizerTest, EncodePairMarksPassageSegment) {
+    std::vector<int64_t> ids;
+    std::vector<int64_t> type_ids;
+    tokenizer_.encode_pair("what is rag", "the retrievals", 64, ids, type_ids);
+
+    const std::vector<int64_t> expected_ids = {2, 4, 5, 6, 3, 9, 7, 8, 3};
+    const std::vector<int64_t> expected_types = {0, 0, 0, 0, 0, 1, 1, 1, 1};
+    EXPECT_EQ(ids, expected_ids);
+    EXPECT_EQ(type_ids, expected_types);
+    EXPECT_EQ(tokenizer_.pad_id(), 0);
+}
+
+TEST_F(SimpleTokenizerTest, EncodePairTruncatesToMaxLength) {
+    std::string long_text;
+    for (int i = 0; i < 100; ++i) {
+        long_text += "the ";
+    }
+
+    std::vector<int64_t> ids;
+    std::vector<int64_t> type_ids;
+    tokenizer_.encode_pair(long_text, long_text, 16, ids, type_ids);
+
+    ASSERT_EQ(ids.size(), 16u);
+    ASSERT_EQ(type_ids.size(), 16u);
+    EXPECT_EQ(ids.front(), 2);
+    EXPECT_EQ(ids.back(), 3);
+    // Query keeps at most half of the budget: [CLS] + 7 pieces, then [SEP]
+    EXPECT_EQ(ids[8], 3);
+    EXPECT_EQ(type_ids[8], 0);
+    EXPECT_EQ(type_ids[9], 1);
+}
+
+TEST(SimpleTokenizerNoVocabTest, HashesUnknownWords) {
+    SimpleTokenizer tokenizer;
+    EXPECT_FALSE(tokenizer.has_vocab());
 
-TEST_F(SimpleTokenizerTest, PlaceholderTest) {
-    // SimpleTokenizer is currently private to onnx_embedding_provider.cpp
-    // These tests will be enabled once the class is extracted to a public interface
-    EXPECT_TRUE(true);
+    const auto ids = tokenizer.encode("hello world", 6);
+    ASSERT_EQ(ids.size(), 6u);
+    EXPECT_EQ(ids[0], 101);
+    EXPECT_EQ(ids[3], 102);
+    EXPECT_GE(ids[1], 1000);
+    EXPECT_LT(ids[1], 30522);
+    EXPECT_EQ(ids, tokenizer.encode("hello world", 6));
 }
 
 } // namespace runanywhere::rag
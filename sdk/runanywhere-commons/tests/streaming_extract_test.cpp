@@ -0,0 +1,252 @@
+/**
+ * @file streaming_extract_test.cpp
+ * @brief Tests for push-based tar.gz / tar.bz2 / tar.xz extraction
+ *
+ * Archives are produced with the system tar/gzip tools, or written by hand
+ * for entries tar would refuse to create.
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "rac/infrastructure/download/rac_archive_extract.h"
+
+namespace {
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+void write_file(const std::string& path, const std::string& content) {
+    std::ofstream out(path, std::ios::binary);
+    out << content;
+}
+
+bool exists(const std::string& path) {
+    return access(path.c_str(), F_OK) == 0;
+}
+
+// Append a ustar entry: '0' regular file, '2' symlink to link
+void append_entry(std::string& tar, const std::string& name, char type,
+                  const std::string& link = "", const std::string& content = "") {
+    std::vector<char> header(512, 0);
+    std::memcpy(header.data(), name.data(), name.size());
+    std::memcpy(header.data() + 100, type == '2' ? "0000777" : "0000644", 7);
+    std::snprintf(header.data() + 124, 12, "%011o", static_cast<unsigned>(content.size()));
+    header[156] = type;
+    std::memcpy(header.data() + 157, link.data(), link.size());
+    std::memcpy(header.data() + 257, "ustar", 6);
+    std::memcpy(header.data() + 148, "        ", 8);
+    unsigned sum = 0;
+    for (char c : header) {
+        sum += static_cast<unsigned char>(c);
+    }
+    std::snprintf(header.data() + 148, 8, "%06o", sum);
+
+    tar.append(header.begin(), header.end());
+    tar += content;
+    tar.append((512 - content.size() % 512) % 512, '\0');
+}
+
+// End-of-archive marker, then gzip; returns the .tar.gz path
+std::string write_tar_gz(const std::string& tar_path, std::string tar) {
+    tar.append(1024, '\0');
+    write_file(tar_path, tar);
+    return std::system(("gzip -f " + tar_path).c_str()) == 0 ? tar_path + ".gz" : "";
+}
+
+class StreamingExtractTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        char pattern[] = "/tmp/rac_streaming_extract_XXXXXX";
+        ASSERT_NE(mkdtemp(pattern), nullptr);
+        dir_ = pattern;
+
+        // Source tree: nested dirs, a long name, an empty file and a 2 MiB file
+        source_ = dir_ + "/src";
+        long_name_ = std::string(120, 'n') + ".onnx";
+        ASSERT_EQ(std::system(("mkdir -p " + source_ + "/model/tokenizer").c_str()), 0);
+        big_.resize(2 * 1024 * 1024);
+        for (size_t i = 0; i < big_.size(); ++i) {
+            big_[i] = static_cast<char>((i * 7919) >> 3);
+        }
+        write_file(source_ + "/model/weights.bin", big_);
+        write_file(source_ + "/model/tokenizer/vocab.txt", "hello\nworld\n");
+        write_file(source_ + "/model/" + long_name_, "long");
+        write_file(source_ + "/model/empty", "");
+        ASSERT_EQ(std::system(("ln -s weights.bin " + source_ + "/model/current.bin").c_str()), 0);
+    }
+
+    void TearDown() override { std::system(("rm -rf " + dir_).c_str()); }
+
+    // Returns an empty path if the tools are not available
+    std::string make_archive(const char* flag, const char* extension) {
+        const std::string archive = dir_ + "/model." + extension;
+        const std::string command = std::string("tar -c") + flag + "f " + archive + " -C " +
+                                    source_ + " model 2>/dev/null";
+        return std::system(command.c_str()) == 0 ? archive : "";
+    }
+
+    // Push the archive in odd-sized pieces to cross every block boundary
+    rac_result_t extract_in_chunks(rac_archive_type_t type, const std::string& archive,
+                                   const std::string& destination, size_t chunk = 7919) {
+        rac_archive_extractor_handle_t extractor = nullptr;
+        rac_result_t result = rac_archive_extractor_create(type, destination.c_str(), &extractor);
+        if (result != RAC_SUCCESS) {
+            return result;
+        }
+        const std::string data = read_file(archive);
+        for (size_t offset = 0; offset < data.size() && result == RAC_SUCCESS; offset += chunk) {
+            result = rac_archive_extractor_write(extractor, data.data() + offset,
+                                                 std::min(chunk, data.size() - offset));
+        }
+        if (result == RAC_SUCCESS) {
+            result = rac_archive_extractor_finish(extractor);
+        }
+        rac_archive_extractor_destroy(extractor);
+        return result;
+    }
+
+    void expect_extracted(const std::string& destination) {
+        EXPECT_EQ(read_file(destination + "/model/weights.bin"), big_);
+        EXPECT_EQ(read_file(destination + "/model/tokenizer/vocab.txt"), "hello\nworld\n");
+        EXPECT_EQ(read_file(destination + "/model/" + long_name_), "long");
+        EXPECT_TRUE(exists(destination + "/model/empty"));
+        EXPECT_EQ(read_file(destination + "/model/current.bin"), big_);
+    }
+
+    std::string dir_;
+    std::string source_;
+    std::string long_name_;
+    std::string big_;
+};
+
+TEST_F(StreamingExtractTest, ExtractsEachSupportedFormat) {
+    struct Format {
+        rac_archive_type_t type;
+        const char* flag;
+        const char* extension;
+    };
+    const Format formats[] = {{RAC_ARCHIVE_TYPE_TAR_GZ, "z", "tar.gz"},
+                              {RAC_ARCHIVE_TYPE_TAR_BZ2, "j", "tar.bz2"},
+                              {RAC_ARCHIVE_TYPE_TAR_XZ, "J", "tar.xz"}};
+
+    int tested = 0;
+    for (const auto& format : formats) {
+        if (!rac_archive_extractor_supports(format.type)) {
+            continue;
+        }
+        const std::string archive = make_archive(format.flag, format.extension);
+        if (archive.empty()) {
+            continue;
+        }
+        SCOPED_TRACE(format.extension);
+        const std::string destination = dir_ + "/out-" + format.extension;
+        ASSERT_EQ(extract_in_chunks(format.type, archive, destination), RAC_SUCCESS);
+        expect_extracted(destination);
+        ++tested;
+    }
+    if (tested == 0) {
+        GTEST_SKIP() << "No supported archive format or no tar tool";
+    }
+}
+
+TEST_F(StreamingExtractTest, TruncatedArchiveLeavesNothingBehind) {
+    if (!rac_archive_extractor_supports(RAC_ARCHIVE_TYPE_TAR_GZ)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    const std::string archive = make_archive("z", "tar.gz");
+    ASSERT_FALSE(archive.empty());
+
+    const std::string data = read_file(archive);
+    write_file(archive, data.substr(0, data.size() / 2));
+
+    const std::string destination = dir_ + "/out";
+    EXPECT_NE(extract_in_chunks(RAC_ARCHIVE_TYPE_TAR_GZ, archive, destination), RAC_SUCCESS);
+    EXPECT_FALSE(exists(destination));
+
+    // No staging directories left next to the destination
+    EXPECT_NE(std::system(("ls -d " + destination + ".extracting-* >/dev/null 2>&1").c_str()), 0);
+}
+
+TEST_F(StreamingExtractTest, RejectsPathTraversal) {
+    if (!rac_archive_extractor_supports(RAC_ARCHIVE_TYPE_TAR_GZ)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+
+    std::string tar;
+    append_entry(tar, "../evil", '0', "", "evil");
+    const std::string archive = write_tar_gz(dir_ + "/evil.tar", tar);
+    ASSERT_FALSE(archive.empty());
+
+    const std::string destination = dir_ + "/out";
+    EXPECT_EQ(extract_in_chunks(RAC_ARCHIVE_TYPE_TAR_GZ, archive, destination),
+              RAC_ERROR_EXTRACTION_FAILED);
+    EXPECT_FALSE(exists(dir_ + "/evil"));
+    EXPECT_FALSE(exists(destination));
+}
+
+TEST_F(StreamingExtractTest, ChainedSymlinksCannotEscape) {
+    if (!rac_archive_extractor_supports(RAC_ARCHIVE_TYPE_TAR_GZ)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+
+    // Each target stays inside lexically, but s resolves through t to the
+    // parent of the destination
+    std::string links;
+    append_entry(links, "w/v/t", '2', "..");
+    append_entry(links, "w/v/s", '2', "t/../..");
+
+    std::string write_through = links;
+    append_entry(write_through, "w/v/s/ESCAPED.txt", '0', "", "escaped");
+
+    const std::string destination = dir_ + "/out";
+    for (const auto& tar : {links, write_through}) {
+        const std::string archive = write_tar_gz(dir_ + "/chain.tar", tar);
+        ASSERT_FALSE(archive.empty());
+        EXPECT_EQ(extract_in_chunks(RAC_ARCHIVE_TYPE_TAR_GZ, archive, destination),
+                  RAC_ERROR_EXTRACTION_FAILED);
+        EXPECT_FALSE(exists(destination));
+        EXPECT_FALSE(exists(dir_ + "/ESCAPED.txt"));
+        EXPECT_FALSE(exists(dir_ + "/w/ESCAPED.txt"));
+    }
+}
+
+TEST_F(StreamingExtractTest, ExtractFileReportsProgress) {
+    if (!rac_archive_extractor_supports(RAC_ARCHIVE_TYPE_TAR_GZ)) {
+        GTEST_SKIP() << "Built without zlib";
+    }
+    const std::string archive = make_archive("z", "tar.gz");
+    ASSERT_FALSE(archive.empty());
+
+    int32_t last_files = -1;
+    int32_t last_total = -1;
+    auto progress = [](int32_t files, int32_t total, void* user) {
+        auto* values = static_cast<int32_t**>(user);
+        *values[0] = files;
+        *values[1] = total;
+    };
+    int32_t* values[] = {&last_files, &last_total};
+
+    const std::string destination = dir_ + "/out";
+    ASSERT_EQ(rac_archive_extract_file(archive.c_str(), RAC_ARCHIVE_TYPE_TAR_GZ,
+                                       destination.c_str(), progress, values),
+              RAC_SUCCESS);
+    expect_extracted(destination);
+    EXPECT_EQ(last_files, 4);
+    EXPECT_EQ(last_total, 4);
+}
+
+}  // namespace
@@ -0,0 +1,247 @@
+/**
+ * @file telemetry_manager_test.cpp
+ * @brief Unit tests for telemetry queueing, platform-driven flushing and the offline spool
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include "rac/infrastructure/telemetry/rac_telemetry_manager.h"
+
+namespace {
+
+// Stand-in for the platform HTTP layer
+struct FakeHttp {
+    std::mutex mutex;
+    std::vector<std::string> bodies;
+    std::vector<uint64_t> request_ids;
+    std::vector<std::thread::id> threads;
+    std::atomic<int> calls{0};
+
+    static void callback(void* user_data, const char* /*endpoint*/, const char* json_body,
+                         size_t json_length, rac_bool_t /*requires_auth*/) {
+        auto* self = static_cast<FakeHttp*>(user_data);
+        {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            self->bodies.emplace_back(json_body, json_length);
+            self->threads.push_back(std::this_thread::get_id());
+        }
+        self->calls.fetch_add(1);
+    }
+
+    static void request_callback(void* user_data, uint64_t request_id, const char* endpoint,
+                                 const char* json_body, size_t json_length,
+                                 rac_bool_t requires_auth) {
+        auto* self = static_cast<FakeHttp*>(user_data);
+        {
+            std::lock_guard<std::mutex> lock(self->mutex);
+            self->request_ids.push_back(request_id);
+        }
+        callback(user_data, endpoint, json_body, json_length, requires_auth);
+    }
+};
+
+rac_telemetry_payload_t make_event(const char* id) {
+    rac_telemetry_payload_t payload = rac_telemetry_payload_default();
+    payload.id = id;
+    payload.event_type = "llm.generation.completed";
+    payload.modality = "llm";
+    payload.timestamp_ms = 1700000000000;
+    payload.created_at_ms = 1700000000000;
+    return payload;
+}
+
+std::string make_temp_dir() {
+    char path[] = "/tmp/rac_telemetry_test_XXXXXX";
+    const char* dir = mkdtemp(path);
+    return dir ? dir : "";
+}
+
+void remove_dir(const std::string& dir) {
+    std::string cmd = "rm -rf '" + dir + "'";
+    (void)std::system(cmd.c_str());
+}
+
+rac_telemetry_stats_t stats_of(rac_telemetry_manager_t* manager) {
+    rac_telemetry_stats_t stats = {};
+    EXPECT_EQ(rac_telemetry_manager_get_stats(manager, &stats), RAC_SUCCESS);
+    return stats;
+}
+
+}  // namespace
+
+// ============================================================================
+// Queueing
+// ============================================================================
+
+TEST(TelemetryManagerTest, HttpCallbackRunsOnlyOnPollingThread) {
+    FakeHttp http;
+    rac_telemetry_manager_t* manager =
+        rac_telemetry_manager_create(RAC_ENV_DEVELOPMENT, "device", "linux", "0.0.0");
+    ASSERT_NE(manager, nullptr);
+    rac_telemetry_manager_set_http_callback(manager, FakeHttp::callback, &http);
+
+    // Development mode requests an immediate flush, but tracking never sends
+    for (int i = 0; i < 20; ++i) {
+        rac_telemetry_payload_t event = make_event("evt");
+        EXPECT_EQ(rac_telemetry_manager_track(manager, &event), RAC_SUCCESS);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(http.calls.load(), 0);
+
+    std::thread::id poller;
+    std::thread platform_thread([&]() {
+        poller = std::this_thread::get_id();
+        EXPECT_EQ(rac_telemetry_manager_poll(manager), RAC_SUCCESS);
+    });
+    platform_thread.join();
+
+    ASSERT_EQ(http.calls.load(), 1);
+    EXPECT_EQ(http.threads[0], poller);
+    EXPECT_EQ(stats_of(manager).queued_events, 0u);
+
+    // Nothing due: the next poll sends nothing
+    EXPECT_EQ(rac_telemetry_manager_poll(manager), RAC_SUCCESS);
+    EXPECT_EQ(http.calls.load(), 1);
+
+    rac_telemetry_manager_destroy(manager);
+}
+
+TEST(TelemetryManagerTest, FullQueueDropsAndCounts) {
+    rac_telemetry_manager_t* manager =
+        rac_telemetry_manager_create(RAC_ENV_PRODUCTION, "device", "linux", "0.0.0");
+    ASSERT_NE(manager, nullptr);
+
+    // No HTTP callback: nothing drains the queue
+    int accepted = 0;
+    int dropped = 0;
+    for (int i = 0; i < 1100; ++i) {
+        rac_telemetry_payload_t event = make_event("evt");
+        rac_result_t result = rac_telemetry_manager_track(manager, &event);
+        if (result == RAC_SUCCESS) {
+            ++accepted;
+        } else {
+            EXPECT_EQ(result, RAC_ERROR_SERVICE_BUSY);
+            ++dropped;
+        }
+    }
+
+    EXPECT_GT(dropped, 0);
+    rac_telemetry_stats_t stats = stats_of(manager);
+    EXPECT_EQ(stats.queued_events, static_cast<size_t>(accepted));
+    EXPECT_EQ(stats.dropped_events, static_cast<uint64_t>(dropped));
+
+    rac_telemetry_manager_destroy(manager);
+}
+
+// ============================================================================
+// Offline spool
+// ============================================================================
+
+TEST(TelemetryManagerTest, FailedRequestIsSpooledAndReplayedAfterRestart) {
+    std::string dir = make_temp_dir();
+    ASSERT_FALSE(dir.empty());
+
+    std::string sent_body;
+    {
+        FakeHttp http;
+        rac_telemetry_manager_t* manager =
+            rac_telemetry_manager_create(RAC_ENV_DEVELOPMENT, "device", "linux", "0.0.0");
+        ASSERT_NE(manager, nullptr);
+        ASSERT_EQ(rac_telemetry_manager_set_spool(manager, dir.c_str(), 1024 * 1024),
+                  RAC_SUCCESS);
+        rac_telemetry_manager_set_http_request_callback(manager, FakeHttp::request_callback,
+                                                        &http);
+
+        rac_telemetry_payload_t event = make_event("spooled-event");
+        ASSERT_EQ(rac_telemetry_manager_track(manager, &event), RAC_SUCCESS);
+        ASSERT_EQ(rac_telemetry_manager_poll(manager), RAC_SUCCESS);
+        ASSERT_EQ(http.calls.load(), 1);
+        sent_body = http.bodies[0];
+
+        rac_telemetry_manager_http_request_complete(manager, http.request_ids[0], RAC_FALSE,
+                                                    nullptr, "network down");
+
+        rac_telemetry_stats_t stats = stats_of(manager);
+        EXPECT_EQ(stats.spooled_requests, 1u);
+        EXPECT_GT(stats.spool_bytes, 0u);
+        EXPECT_EQ(stats.offline, RAC_TRUE);
+
+        rac_telemetry_manager_destroy(manager);
+    }
+
+    // A new process picks the spooled request up and resends it
+    FakeHttp http;
+    rac_telemetry_manager_t* manager =
+        rac_telemetry_manager_create(RAC_ENV_DEVELOPMENT, "device", "linux", "0.0.0");
+    ASSERT_NE(manager, nullptr);
+    ASSERT_EQ(rac_telemetry_manager_set_spool(manager, dir.c_str(), 1024 * 1024), RAC_SUCCESS);
+    EXPECT_EQ(stats_of(manager).spooled_requests, 1u);
+    rac_telemetry_manager_set_http_request_callback(manager, FakeHttp::request_callback, &http);
+
+    ASSERT_EQ(rac_telemetry_manager_poll(manager), RAC_SUCCESS);
+    ASSERT_EQ(http.calls.load(), 1);
+    EXPECT_EQ(http.bodies[0], sent_body);
+    rac_telemetry_manager_http_request_complete(manager, http.request_ids[0], RAC_TRUE, "{}",
+                                                nullptr);
+
+    rac_telemetry_stats_t stats = stats_of(manager);
+    EXPECT_EQ(stats.spooled_requests, 0u);
+    EXPECT_EQ(stats.offline, RAC_FALSE);
+
+    rac_telemetry_manager_destroy(manager);
+    remove_dir(dir);
+}
+
+TEST(TelemetryManagerTest, CompletionsAreMatchedByRequestId) {
+    std::string dir = make_temp_dir();
+    ASSERT_FALSE(dir.empty());
+
+    FakeHttp http;
+    rac_telemetry_manager_t* manager =
+        rac_telemetry_manager_create(RAC_ENV_DEVELOPMENT, "device", "linux", "0.0.0");
+    ASSERT_NE(manager, nullptr);
+    ASSERT_EQ(rac_telemetry_manager_set_spool(manager, dir.c_str(), 1024 * 1024), RAC_SUCCESS);
+    rac_telemetry_manager_set_http_request_callback(manager, FakeHttp::request_callback, &http);
+
+    rac_telemetry_payload_t first = make_event("first");
+    ASSERT_EQ(rac_telemetry_manager_track(manager, &first), RAC_SUCCESS);
+    ASSERT_EQ(rac_telemetry_manager_poll(manager), RAC_SUCCESS);
+    rac_telemetry_payload_t second = make_event("second");
+    ASSERT_EQ(rac_telemetry_manager_track(manager, &second), RAC_SUCCESS);
+    ASSERT_EQ(rac_telemetry_manager_poll(manager), RAC_SUCCESS);
+    ASSERT_EQ(http.calls.load(), 2);
+    ASSERT_NE(http.request_ids[0], http.request_ids[1]);
+
+    // The second request fails first; only its body may be spooled
+    rac_telemetry_manager_http_request_complete(manager, http.request_ids[1], RAC_FALSE, nullptr,
+                                                "timeout");
+    rac_telemetry_manager_http_request_complete(manager, http.request_ids[0], RAC_TRUE, "{}",
+                                                nullptr);
+    // Unknown and repeated ids are ignored
+    rac_telemetry_manager_http_request_complete(manager, http.request_ids[1], RAC_FALSE, nullptr,
+                                                "duplicate");
+    rac_telemetry_manager_http_request_complete(manager, 9999, RAC_FALSE, nullptr, "unknown");
+
+    EXPECT_EQ(stats_of(manager).spooled_requests, 1u);
+    EXPECT_EQ(stats_of(manager).offline, RAC_FALSE);  // The later success cleared it
+
+    // The replay resends the second body
+    ASSERT_EQ(rac_telemetry_manager_poll(manager), RAC_SUCCESS);
+    ASSERT_EQ(http.calls.load(), 3);
+    EXPECT_EQ(http.bodies[2], http.bodies[1]);
+    EXPECT_NE(http.bodies[2].find("second"), std::string::npos);
+
+    rac_telemetry_manager_destroy(manager);
+    remove_dir(dir);
+}
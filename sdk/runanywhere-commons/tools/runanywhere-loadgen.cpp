@@ -0,0 +1,584 @@
+/**
+ * @file runanywhere-loadgen.cpp
+ * @brief Load generator and soak test for runanywhere-server
+ *
+ * Drives concurrent streaming POST /v1/chat/completions requests, parses the
+ * SSE stream and reports time-to-first-token, inter-token latency, end-to-end
+ * latency, throughput and errors as JSON.
+ *
+ * Usage:
+ *   runanywhere-loadgen [options]
+ *
+ * Options:
+ *   --host, -H <host>         Server host (default: 127.0.0.1)
+ *   --port, -p <port>         Server port (default: 8080)
+ *   --concurrency, -c <n>     Maximum in-flight streams (default: 4)
+ *   --rate, -r <req/s>        Poisson arrival rate; 0 = closed loop, each stream
+ *                             issues its next request as soon as the last ends
+ *                             (default: 0)
+ *   --requests, -n <n>        Stop after n requests (default: 0 = unlimited)
+ *   --duration, -d <s>        Stop after s seconds (default: 30)
+ *   --prompt-words <lo:hi>    Prompt length in words, uniform (default: 16:128)
+ *   --max-tokens <n>          max_tokens per request (default: 64)
+ *   --seed <n>                Seed for arrivals and prompts (default: 42)
+ *   --timeout <s>             Per-request read timeout (default: 300)
+ *   --report-interval <s>     Print windowed progress to stderr (default: 0 = off)
+ *   --output, -o <path>       Write the JSON report to a file (default: stdout)
+ *   --help, -h                Show this help message
+ *
+ * Example (no model required):
+ *   runanywhere-server --mock 50 --mock-prefill 100 &
+ *   runanywhere-loadgen -c 32 -r 8 -d 600 --report-interval 10
+ *
+ * In open-loop mode (--rate > 0) latencies are measured from each request's
+ * scheduled arrival time, so time spent waiting for a free stream counts
+ * against the server instead of being silently dropped.
+ */
+
+#include "bench_common.h"
+
+#include <httplib.h>
+#include <nlohmann/json.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+// =============================================================================
+// ARGUMENT PARSING
+// =============================================================================
+
+struct LoadOptions {
+    std::string host = "127.0.0.1";
+    int port = 8080;
+    int concurrency = 4;
+    double rate = 0.0;
+    int64_t maxRequests = 0;
+    double durationSeconds = 30.0;
+    int promptWordsMin = 16;
+    int promptWordsMax = 128;
+    int maxTokens = 64;
+    uint32_t seed = 42;
+    int timeoutSeconds = 300;
+    double reportIntervalSeconds = 0.0;
+    std::string outputPath;
+    bool showHelp = false;
+};
+
+static void printUsage(const char* programName) {
+    printf("Usage: %s [options]\n\n", programName);
+    printf("Options:\n");
+    printf("  --host, -H <host>         Server host (default: 127.0.0.1)\n");
+    printf("  --port, -p <port>         Server port (default: 8080)\n");
+    printf("  --concurrency, -c <n>     Maximum in-flight streams (default: 4)\n");
+    printf("  --rate, -r <req/s>        Poisson arrival rate, 0 = closed loop (default: 0)\n");
+    printf("  --requests, -n <n>        Stop after n requests (default: unlimited)\n");
+    printf("  --duration, -d <s>        Stop after s seconds (default: 30)\n");
+    printf("  --prompt-words <lo:hi>    Prompt length in words (default: 16:128)\n");
+    printf("  --max-tokens <n>          max_tokens per request (default: 64)\n");
+    printf("  --seed <n>                Seed for arrivals and prompts (default: 42)\n");
+    printf("  --timeout <s>             Per-request read timeout (default: 300)\n");
+    printf("  --report-interval <s>     Print windowed progress to stderr (default: off)\n");
+    printf("  --output, -o <path>       Write JSON report to a file (default: stdout)\n");
+    printf("  --help, -h                Show this help message\n");
+}
+
+static LoadOptions parseArgs(int argc, char* argv[]) {
+    LoadOptions opts;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        auto is = [arg](const char* longName, const char* shortName = nullptr) {
+            return std::strcmp(arg, longName) == 0 ||
+                   (shortName && std::strcmp(arg, shortName) == 0);
+        };
+
+        if (is("--help", "-h")) {
+            opts.showHelp = true;
+        } else if (i + 1 >= argc) {
+            fprintf(stderr, "Unknown or incomplete option: %s\n", arg);
+            opts.showHelp = true;
+        } else if (is("--host", "-H")) {
+            opts.host = argv[++i];
+        } else if (is("--port", "-p")) {
+            opts.port = std::atoi(argv[++i]);
+        } else if (is("--concurrency", "-c")) {
+            opts.concurrency = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--rate", "-r")) {
+            opts.rate = std::max(0.0, std::atof(argv[++i]));
+        } else if (is("--requests", "-n")) {
+            opts.maxRequests = std::max(0LL, std::atoll(argv[++i]));
+        } else if (is("--duration", "-d")) {
+            opts.durationSeconds = std::atof(argv[++i]);
+        } else if (is("--prompt-words")) {
+            const char* value = argv[++i];
+            const char* colon = std::strchr(value, ':');
+            opts.promptWordsMin = std::max(1, std::atoi(value));
+            opts.promptWordsMax = colon ? std::atoi(colon + 1) : opts.promptWordsMin;
+            opts.promptWordsMax = std::max(opts.promptWordsMin, opts.promptWordsMax);
+        } else if (is("--max-tokens")) {
+            opts.maxTokens = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--seed")) {
+            opts.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (is("--timeout")) {
+            opts.timeoutSeconds = std::max(1, std::atoi(argv[++i]));
+        } else if (is("--report-interval")) {
+            opts.reportIntervalSeconds = std::atof(argv[++i]);
+        } else if (is("--output", "-o")) {
+            opts.outputPath = argv[++i];
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            opts.showHelp = true;
+        }
+    }
+
+    return opts;
+}
+
+// =============================================================================
+// SSE PARSING
+// =============================================================================
+
+/**
+ * Incremental parser for the chat.completion.chunk event stream. Network
+ * chunks can split events anywhere, so bytes are buffered until a full line
+ * is available.
+ */
+class SSEParser {
+public:
+    enum class Event { None, Token, Done, Error };
+
+    // Feed bytes; invokes onEvent for every complete event found
+    template <typename F>
+    void feed(const char* data, size_t len, F&& onEvent) {
+        buffer_.append(data, len);
+        size_t start = 0;
+        size_t newline;
+        while ((newline = buffer_.find('\n', start)) != std::string::npos) {
+            size_t end = newline;
+            if (end > start && buffer_[end - 1] == '\r') {
+                --end;
+            }
+            onEvent(parseLine(buffer_.data() + start, end - start));
+            start = newline + 1;
+        }
+        buffer_.erase(0, start);
+    }
+
+    const std::string& lastError() const { return lastError_; }
+
+private:
+    Event parseLine(const char* line, size_t len) {
+        static constexpr char kPrefix[] = "data:";
+        static constexpr size_t kPrefixLen = sizeof(kPrefix) - 1;
+        if (len < kPrefixLen || std::memcmp(line, kPrefix, kPrefixLen) != 0) {
+            return Event::None;  // Blank separator, comment or other field
+        }
+        std::string payload(line + kPrefixLen, len - kPrefixLen);
+        payload.erase(0, payload.find_first_not_of(' '));
+        if (payload == "[DONE]") {
+            return Event::Done;
+        }
+
+        auto chunk = nlohmann::json::parse(payload, nullptr, false);
+        if (chunk.is_discarded()) {
+            lastError_ = "malformed SSE payload";
+            return Event::Error;
+        }
+        if (chunk.contains("error")) {
+            lastError_ = chunk["error"].value("message", "server error");
+            return Event::Error;
+        }
+        if (!chunk.contains("choices") || !chunk["choices"].is_array() ||
+            chunk["choices"].empty()) {
+            return Event::None;
+        }
+        const auto& delta = chunk["choices"][0].value("delta", nlohmann::json::object());
+        auto content = delta.find("content");
+        if (content != delta.end() && content->is_string() &&
+            !content->get_ref<const std::string&>().empty()) {
+            return Event::Token;
+        }
+        return Event::None;
+    }
+
+    std::string buffer_;
+    std::string lastError_;
+};
+
+// =============================================================================
+// REQUEST EXECUTION
+// =============================================================================
+
+struct RequestResult {
+    bool ok = false;
+    std::string error;  // Error category when !ok
+    int tokens = 0;
+    double queueMs = 0.0;  // Scheduled arrival -> send
+    double ttftMs = -1.0;  // Scheduled arrival -> first content token
+    double e2eMs = 0.0;    // Scheduled arrival -> [DONE]
+    std::vector<double> itlMs;
+};
+
+static const char* const kVocabulary[] = {
+    "the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog", "while", "model",
+    "server", "streams", "tokens", "across", "many", "concurrent", "clients", "under",
+    "steady", "load", "and", "reports", "latency", "percentiles", "for", "each", "phase",
+};
+static constexpr size_t kVocabularySize = sizeof(kVocabulary) / sizeof(kVocabulary[0]);
+
+static std::string makePrompt(std::mt19937& rng, int minWords, int maxWords) {
+    std::uniform_int_distribution<int> lengthDist(minWords, maxWords);
+    std::uniform_int_distribution<size_t> wordDist(0, kVocabularySize - 1);
+    int words = lengthDist(rng);
+    std::string prompt;
+    for (int i = 0; i < words; ++i) {
+        if (i > 0) {
+            prompt += ' ';
+        }
+        prompt += kVocabulary[wordDist(rng)];
+    }
+    return prompt;
+}
+
+static double msSince(Clock::time_point from, Clock::time_point to) {
+    return std::chrono::duration<double, std::milli>(to - from).count();
+}
+
+static RequestResult runRequest(httplib::Client& client, const std::string& body,
+                                Clock::time_point scheduled) {
+    RequestResult result;
+    SSEParser parser;
+    bool done = false;
+    bool streamError = false;
+    Clock::time_point lastToken;
+
+    httplib::Request req;
+    req.method = "POST";
+    req.path = "/v1/chat/completions";
+    req.body = body;
+    req.set_header("Content-Type", "application/json");
+    req.set_header("Accept", "text/event-stream");
+    req.content_receiver = [&](const char* data, size_t len, uint64_t, uint64_t) {
+        parser.feed(data, len, [&](SSEParser::Event event) {
+            auto now = Clock::now();
+            switch (event) {
+                case SSEParser::Event::Token:
+                    if (result.tokens == 0) {
+                        result.ttftMs = msSince(scheduled, now);
+                    } else {
+                        result.itlMs.push_back(msSince(lastToken, now));
+                    }
+                    lastToken = now;
+                    result.tokens++;
+                    break;
+                case SSEParser::Event::Done:
+                    done = true;
+                    break;
+                case SSEParser::Event::Error:
+                    streamError = true;
+                    break;
+                case SSEParser::Event::None:
+                    break;
+            }
+        });
+        return !streamError;
+    };
+
+    auto sendTime = Clock::now();
+    result.queueMs = msSince(scheduled, sendTime);
+    httplib::Response res;
+    httplib::Error transportError = httplib::Error::Success;
+    bool sent = client.send(req, res, transportError);
+    result.e2eMs = msSince(scheduled, Clock::now());
+
+    if (streamError) {
+        result.error = "stream_error";
+    } else if (!sent) {
+        result.error = "transport_" + httplib::to_string(transportError);
+    } else if (res.status != 200) {
+        result.error = "http_" + std::to_string(res.status);
+    } else if (!done) {
+        result.error = "truncated_stream";
+    } else if (result.tokens == 0) {
+        result.error = "empty_stream";
+    } else {
+        result.ok = true;
+    }
+    return result;
+}
+
+// =============================================================================
+// RESULT AGGREGATION
+// =============================================================================
+
+class Stats {
+public:
+    void add(RequestResult&& r) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        completed_++;
+        windowCompleted_++;
+        if (!r.ok) {
+            errors_[r.error]++;
+            windowErrors_++;
+            return;
+        }
+        tokens_ += r.tokens;
+        windowTokens_ += r.tokens;
+        queueMs_.push_back(r.queueMs);
+        ttftMs_.push_back(r.ttftMs);
+        windowTtftMs_.push_back(r.ttftMs);
+        e2eMs_.push_back(r.e2eMs);
+        itlMs_.insert(itlMs_.end(), r.itlMs.begin(), r.itlMs.end());
+    }
+
+    // Print and reset the progress window
+    void reportWindow(double elapsedSeconds, double windowSeconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        fprintf(stderr,
+                "[%7.1fs] completed=%lld errors=%lld req/s=%.2f tok/s=%.1f ttft_p50=%.1fms "
+                "ttft_p99=%.1fms\n",
+                elapsedSeconds, static_cast<long long>(windowCompleted_),
+                static_cast<long long>(windowErrors_),
+                static_cast<double>(windowCompleted_) / windowSeconds,
+                static_cast<double>(windowTokens_) / windowSeconds,
+                rac::bench::percentile(windowTtftMs_, 50.0),
+                rac::bench::percentile(windowTtftMs_, 99.0));
+        windowCompleted_ = 0;
+        windowErrors_ = 0;
+        windowTokens_ = 0;
+        windowTtftMs_.clear();
+    }
+
+    nlohmann::json toJson(double wallSeconds) const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        int64_t errorCount = 0;
+        nlohmann::json errors = nlohmann::json::object();
+        for (const auto& [kind, count] : errors_) {
+            errors[kind] = count;
+            errorCount += count;
+        }
+        return {
+            {"wall_seconds", wallSeconds},
+            {"requests", completed_},
+            {"succeeded", completed_ - errorCount},
+            {"failed", errorCount},
+            {"error_rate",
+             completed_ > 0 ? static_cast<double>(errorCount) / static_cast<double>(completed_)
+                            : 0.0},
+            {"errors", errors},
+            {"requests_per_second", wallSeconds > 0 ? static_cast<double>(completed_) / wallSeconds
+                                                    : 0.0},
+            {"output_tokens", tokens_},
+            {"output_tokens_per_second",
+             wallSeconds > 0 ? static_cast<double>(tokens_) / wallSeconds : 0.0},
+            {"queue_ms", rac::bench::latency_summary(queueMs_)},
+            {"ttft_ms", rac::bench::latency_summary(ttftMs_)},
+            {"itl_ms", rac::bench::latency_summary(itlMs_)},
+            {"e2e_ms", rac::bench::latency_summary(e2eMs_)},
+        };
+    }
+
+private:
+    mutable std::mutex mutex_;
+    int64_t completed_ = 0;
+    int64_t tokens_ = 0;
+    std::map<std::string, int64_t> errors_;
+    std::vector<double> queueMs_, ttftMs_, itlMs_, e2eMs_;
+
+    int64_t windowCompleted_ = 0;
+    int64_t windowErrors_ = 0;
+    int64_t windowTokens_ = 0;
+    std::vector<double> windowTtftMs_;
+};
+
+// =============================================================================
+// MAIN
+// =============================================================================
+
+int main(int argc, char* argv[]) {
+    LoadOptions opts = parseArgs(argc, argv);
+    if (opts.showHelp) {
+        printUsage(argv[0]);
+        return 0;
+    }
+    if (opts.durationSeconds <= 0 && opts.maxRequests <= 0) {
+        fprintf(stderr, "Error: need a positive --duration or --requests\n");
+        return 1;
+    }
+
+    // Fail fast if the server is not up
+    {
+        httplib::Client probe(opts.host, opts.port);
+        probe.set_connection_timeout(5);
+        auto health = probe.Get("/health");
+        if (!health || health->status != 200) {
+            fprintf(stderr, "Error: server not reachable at http://%s:%d/health\n",
+                    opts.host.c_str(), opts.port);
+            return 1;
+        }
+    }
+
+    const auto start = Clock::now();
+    const auto deadline =
+        opts.durationSeconds > 0
+            ? start + std::chrono::duration_cast<Clock::duration>(
+                          std::chrono::duration<double>(opts.durationSeconds))
+            : Clock::time_point::max();
+
+    Stats stats;
+    std::atomic<int64_t> issued{0};
+
+    // Claim the next request slot; false once the request budget is spent
+    auto claimRequest = [&]() {
+        if (opts.maxRequests <= 0) {
+            return true;
+        }
+        return issued.fetch_add(1) < opts.maxRequests;
+    };
+
+    // Open-loop arrivals are queued by a dispatcher; workers take them in order
+    std::mutex queueMutex;
+    std::condition_variable queueCv;
+    std::deque<Clock::time_point> arrivals;
+    bool dispatchDone = false;
+
+    std::thread dispatcher;
+    if (opts.rate > 0) {
+        dispatcher = std::thread([&]() {
+            std::mt19937 rng(opts.seed);
+            std::exponential_distribution<double> gap(opts.rate);
+            auto next = start;
+            while (next < deadline && claimRequest()) {
+                std::this_thread::sleep_until(next);
+                {
+                    std::lock_guard<std::mutex> lock(queueMutex);
+                    arrivals.push_back(next);
+                }
+                queueCv.notify_one();
+                next += std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>(gap(rng)));
+            }
+            {
+                std::lock_guard<std::mutex> lock(queueMutex);
+                dispatchDone = true;
+            }
+            queueCv.notify_all();
+        });
+    }
+
+    std::vector<std::thread> workers;
+    workers.reserve(static_cast<size_t>(opts.concurrency));
+    for (int w = 0; w < opts.concurrency; ++w) {
+        workers.emplace_back([&, w]() {
+            httplib::Client client(opts.host, opts.port);
+            client.set_keep_alive(true);
+            client.set_read_timeout(opts.timeoutSeconds, 0);
+            std::mt19937 rng(opts.seed + 1 + static_cast<uint32_t>(w));
+
+            while (true) {
+                Clock::time_point scheduled;
+                if (opts.rate > 0) {
+                    std::unique_lock<std::mutex> lock(queueMutex);
+                    queueCv.wait(lock, [&]() { return !arrivals.empty() || dispatchDone; });
+                    if (arrivals.empty()) {
+                        break;
+                    }
+                    scheduled = arrivals.front();
+                    arrivals.pop_front();
+                } else {
+                    if (Clock::now() >= deadline || !claimRequest()) {
+                        break;
+                    }
+                    scheduled = Clock::now();
+                }
+
+                nlohmann::json body = {
+                    {"model", "default"},
+                    {"stream", true},
+                    {"max_tokens", opts.maxTokens},
+                    {"messages",
+                     {{{"role", "user"},
+                       {"content", makePrompt(rng, opts.promptWordsMin, opts.promptWordsMax)}}}},
+                };
+                stats.add(runRequest(client, body.dump(), scheduled));
+            }
+        });
+    }
+
+    // Progress reporting doubles as the soak-test heartbeat
+    if (opts.reportIntervalSeconds > 0) {
+        auto interval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(opts.reportIntervalSeconds));
+        auto nextReport = start + interval;
+        bool running = true;
+        while (running) {
+            std::this_thread::sleep_until(std::min(nextReport, deadline));
+            auto now = Clock::now();
+            running = now < deadline;
+            if (now >= nextReport) {
+                stats.reportWindow(std::chrono::duration<double>(now - start).count(),
+                                   opts.reportIntervalSeconds);
+                nextReport += interval;
+            }
+            if (opts.maxRequests > 0 && issued.load() >= opts.maxRequests) {
+                break;
+            }
+        }
+    }
+
+    if (dispatcher.joinable()) {
+        dispatcher.join();
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    const double wallSeconds = std::chrono::duration<double>(Clock::now() - start).count();
+    nlohmann::json results = stats.toJson(wallSeconds);
+
+    nlohmann::json report = {
+        {"tool", "runanywhere-loadgen"},
+        {"config",
+         {
+             {"host", opts.host},
+             {"port", opts.port},
+             {"concurrency", opts.concurrency},
+             {"rate", opts.rate},
+             {"mode", opts.rate > 0 ? "open_loop" : "closed_loop"},
+             {"duration_seconds", opts.durationSeconds},
+             {"max_requests", opts.maxRequests},
+             {"prompt_words", {opts.promptWordsMin, opts.promptWordsMax}},
+             {"max_tokens", opts.maxTokens},
+             {"seed", opts.seed},
+         }},
+        {"results", results},
+        {"peak_rss_bytes", rac::bench::peak_rss_bytes()},
+    };
+
+    std::string out = report.dump(2);
+    if (opts.outputPath.empty()) {
+        printf("%s\n", out.c_str());
+    } else {
+        std::ofstream file(opts.outputPath);
+        file << out << "\n";
+        if (!file) {
+            fprintf(stderr, "Error: failed to write %s\n", opts.outputPath.c_str());
+            return 1;
+        }
+    }
+
+    return results["failed"].get<int64_t>() > 0 ? 2 : 0;
+}
@@ -11,9 +11,14 @@
  *   --port, -p <port>      Port to listen on (default: 8080)
  *   --threads, -t <n>      Number of threads (default: 4)
  *   --context, -c <n>      Context window size (default: 8192)
+ *   --context-shift        Slide the context window instead of failing when full
  *   --gpu-layers, -ngl <n> GPU layers to offload (default: 0)
  *   --cors                 Enable CORS (default: enabled)
  *   --no-cors              Disable CORS
+ *   --profile              Print per-phase generation timings on exit
+ *   --trace <path>         Write a Chrome trace-event JSON on exit (implies --profile)
+ *   --mock <tok/s>         Serve a synthetic LLM at this rate instead of a model
+ *   --mock-prefill <ms>    Mock LLM delay before the first token (default: 0)
  *   --verbose, -v          Enable verbose logging
  *   --help, -h             Show this help message
  *
@@ -33,6 +38,7 @@
 #include "rac/server/rac_server.h"
 #include "rac/core/rac_core.h"
 #include "rac/core/rac_logger.h"
+#include "rac/core/rac_profiler.h"
 
 // Backend registration
 #ifdef RAC_HAS_LLAMACPP
@@ -44,6 +50,8 @@
 #include <cstring>
 #include <csignal>
 #include <string>
+#include <utility>
+#include <vector>
 
 // =============================================================================
 // SIGNAL HANDLING
@@ -68,9 +76,15 @@ struct ServerOptions {
     uint16_t port = 8080;
     int32_t threads = 4;
     int32_t contextSize = 8192;
+    bool contextShift = false;
+    std::vector<std::pair<std::string, std::string>> loraModels;
     int32_t gpuLayers = 0;
     bool enableCors = true;
     bool verbose = false;
+    bool profile = false;
+    std::string tracePath;
+    int32_t mockTokensPerSecond = 0;
+    int32_t mockPrefillMs = 0;
     bool showHelp = false;
 };
 
@@ -84,9 +98,15 @@ static void printUsage(const char* programName) {
     printf("  --port, -p <port>      Port to listen on (default: 8080)\n");
     printf("  --threads, -t <n>      Number of threads (default: 4)\n");
     printf("  --context, -c <n>      Context window size (default: 8192)\n");
+    printf("  --context-shift        Slide the context window instead of failing when full\n");
     printf("  --gpu-layers, -ngl <n> GPU layers to offload (default: 0)\n");
+    printf("  --lora <id>=<path>     Serve a LoRA adapter as model <id> (repeatable)\n");
     printf("  --cors                 Enable CORS (default)\n");
     printf("  --no-cors              Disable CORS\n");
+    printf("  --profile              Print per-phase generation timings on exit\n");
+    printf("  --trace <path>         Write Chrome trace-event JSON on exit (implies --profile)\n");
+    printf("  --mock <tok/s>         Serve a synthetic LLM at this rate (load testing, no model)\n");
+    printf("  --mock-prefill <ms>    Mock LLM delay before the first token (default: 0)\n");
     printf("  --verbose, -v          Enable verbose logging\n");
     printf("  --help, -h             Show this help message\n\n");
     printf("Environment Variables:\n");
@@ -138,6 +158,32 @@ static ServerOptions parseArgs(int argc, char* argv[]) {
         else if (std::strcmp(arg, "--no-cors") == 0) {
             opts.enableCors = false;
         }
+        else if (std::strcmp(arg, "--profile") == 0) {
+            opts.profile = true;
+        }
+        else if (std::strcmp(arg, "--trace") == 0 && i + 1 < argc) {
+            opts.tracePath = argv[++i];
+            opts.profile = true;
+        }
+        else if (std::strcmp(arg, "--context-shift") == 0) {
+            opts.contextShift = true;
+        }
+        else if (std::strcmp(arg, "--lora") == 0 && i + 1 < argc) {
+            std::string spec = argv[++i];
+            size_t eq = spec.find('=');
+            if (eq != std::string::npos && eq > 0 && eq + 1 < spec.size()) {
+                opts.loraModels.emplace_back(spec.substr(0, eq), spec.substr(eq + 1));
+            } else {
+                fprintf(stderr, "Warning: ignoring --lora '%s' (expected <id>=<path>)\n",
+                        spec.c_str());
+            }
+        }
+        else if (std::strcmp(arg, "--mock") == 0 && i + 1 < argc) {
+            opts.mockTokensPerSecond = std::atoi(argv[++i]);
+        }
+        else if (std::strcmp(arg, "--mock-prefill") == 0 && i + 1 < argc) {
+            opts.mockPrefillMs = std::atoi(argv[++i]);
+        }
         else if ((std::strcmp(arg, "--model") == 0 || std::strcmp(arg, "-m") == 0) && i + 1 < argc) {
             opts.modelPath = argv[++i];
         }
@@ -174,7 +220,7 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
-    if (opts.modelPath.empty()) {
+    if (opts.modelPath.empty() && opts.mockTokensPerSecond <= 0) {
         fprintf(stderr, "Error: Model path is required\n\n");
         printUsage(argv[0]);
         return 1;
@@ -200,6 +246,14 @@ int main(int argc, char* argv[]) {
         // TODO: Set log level to debug
     }
 
+    // Profiling (off unless requested; instrumentation is a no-op when disabled)
+    if (opts.profile) {
+        rac_profiler_set_enabled(RAC_TRUE);
+    }
+    if (!opts.tracePath.empty()) {
+        rac_profiler_set_trace_enabled(RAC_TRUE, 0);
+    }
+
     // Register backends
 #ifdef RAC_HAS_LLAMACPP
     printf("Registering LlamaCPP backend...\n");
@@ -214,17 +268,35 @@ int main(int argc, char* argv[]) {
     config.port = opts.port;
     config.model_path = opts.modelPath.c_str();
     config.context_size = opts.contextSize;
+    config.context_shift = opts.contextShift ? RAC_TRUE : RAC_FALSE;
     config.threads = opts.threads;
     config.gpu_layers = opts.gpuLayers;
     config.enable_cors = opts.enableCors ? RAC_TRUE : RAC_FALSE;
     config.verbose = opts.verbose ? RAC_TRUE : RAC_FALSE;
+    config.mock_tokens_per_second = opts.mockTokensPerSecond;
+    config.mock_prefill_ms = opts.mockPrefillMs;
+
+    std::vector<rac_server_lora_model_t> loraModels;
+    for (const auto& lora : opts.loraModels) {
+        loraModels.push_back({lora.first.c_str(), lora.second.c_str(), 1.0f});
+    }
+    config.lora_models = loraModels.empty() ? nullptr : loraModels.data();
+    config.num_lora_models = loraModels.size();
 
     printf("Configuration:\n");
-    printf("  Model:   %s\n", opts.modelPath.c_str());
+    if (opts.mockTokensPerSecond > 0) {
+        printf("  Model:   mock (%d tok/s, %d ms prefill)\n", opts.mockTokensPerSecond,
+               opts.mockPrefillMs);
+    } else {
+        printf("  Model:   %s\n", opts.modelPath.c_str());
+    }
     printf("  Host:    %s\n", opts.host.c_str());
     printf("  Port:    %d\n", opts.port);
     printf("  Threads: %d\n", opts.threads);
-    printf("  Context: %d\n", opts.contextSize);
+    printf("  Context: %d%s\n", opts.contextSize, opts.contextShift ? " (shifting)" : "");
+    for (const auto& lora : opts.loraModels) {
+        printf("  LoRA:    %s -> %s\n", lora.first.c_str(), lora.second.c_str());
+    }
     printf("  CORS:    %s\n", opts.enableCors ? "enabled" : "disabled");
     printf("\n");
 
@@ -268,6 +340,33 @@ int main(int argc, char* argv[]) {
         printf("  Uptime: %lld seconds\n", (long long)status.uptime_seconds);
     }
 
+    if (opts.profile) {
+        printf("\nGeneration Phases:\n");
+        for (int p = 0; p < RAC_PROFILER_PHASE_COUNT; ++p) {
+            rac_profiler_phase_stats_t stats = {};
+            auto phase = static_cast<rac_profiler_phase_t>(p);
+            if (RAC_SUCCEEDED(rac_profiler_get_phase_stats(phase, &stats)) && stats.count > 0) {
+                printf("  %-10s count=%-8llu avg=%.3f ms  max=%.3f ms\n",
+                       rac_profiler_phase_name(phase), (unsigned long long)stats.count,
+                       (double)stats.total_ns / (double)stats.count / 1e6,
+                       (double)stats.max_ns / 1e6);
+            }
+        }
+        rac_profiler_itl_histogram_t itl = {};
+        if (RAC_SUCCEEDED(rac_profiler_get_itl_histogram(&itl)) && itl.count > 0) {
+            printf("  inter-token latency: avg=%.3f ms  max=%.3f ms (%llu gaps)\n",
+                   (double)itl.total_ns / (double)itl.count / 1e6, (double)itl.max_ns / 1e6,
+                   (unsigned long long)itl.count);
+        }
+    }
+    if (!opts.tracePath.empty()) {
+        if (RAC_SUCCEEDED(rac_profiler_write_chrome_trace(opts.tracePath.c_str()))) {
+            printf("Trace written to %s\n", opts.tracePath.c_str());
+        } else {
+            fprintf(stderr, "Error: Failed to write trace to %s\n", opts.tracePath.c_str());
+        }
+    }
+
     printf("\nGoodbye!\n");
 
     return exitCode;
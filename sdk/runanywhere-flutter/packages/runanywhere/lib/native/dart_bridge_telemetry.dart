@@ -31,6 +31,8 @@ import 'package:runanywhere/public/configuration/sdk_environment.dart';
 /// Dart provides:
 /// - Device info
 /// - HTTP transport for sending telemetry
+/// - A poll timer; C++ only calls the HTTP callback from poll/flush, so the
+///   callback always runs on this isolate
 class DartBridgeTelemetry {
   DartBridgeTelemetry._();
 
@@ -43,8 +45,9 @@ class DartBridgeTelemetry {
   static String? _baseURL;
   static String? _accessToken;
   static Pointer<Void>? _managerPtr;
-  static Pointer<NativeFunction<RacTelemetryHttpCallbackNative>>?
+  static Pointer<NativeFunction<RacTelemetryHttpRequestCallbackNative>>?
       _httpCallbackPtr;
+  static Timer? _pollTimer;
 
   // ============================================================================
   // Lifecycle
@@ -75,6 +78,20 @@ class DartBridgeTelemetry {
     }
   }
 
+  /// Send due batches and spooled requests; the HTTP callback runs here
+  static void _poll() {
+    if (!_isInitialized || _managerPtr == null) return;
+
+    try {
+      final lib = PlatformLoader.loadCommons();
+      final pollFn = lib.lookupFunction<Int32 Function(Pointer<Void>),
+          int Function(Pointer<Void>)>('rac_telemetry_manager_poll');
+      pollFn(_managerPtr!);
+    } catch (e) {
+      _logger.debug('poll error: $e');
+    }
+  }
+
   /// Initialize telemetry manager with device info (full async init)
   static Future<void> initialize({
     required SDKEnvironment environment,
@@ -139,6 +156,10 @@ class DartBridgeTelemetry {
         // Register HTTP callback
         _registerHttpCallback();
 
+        // Send due batches and spooled requests from this isolate
+        _pollTimer?.cancel();
+        _pollTimer = Timer.periodic(const Duration(seconds: 1), (_) => _poll());
+
         _isInitialized = true;
         _logger.debug('Telemetry manager initialized');
       } finally {
@@ -158,6 +179,9 @@ class DartBridgeTelemetry {
   static void shutdown() {
     if (!_isInitialized || _managerPtr == null) return;
 
+    _pollTimer?.cancel();
+    _pollTimer = null;
+
     try {
       final lib = PlatformLoader.loadCommons();
       final destroy = lib.lookupFunction<Void Function(Pointer<Void>),
@@ -510,17 +534,19 @@ class DartBridgeTelemetry {
     try {
       final lib = PlatformLoader.loadCommons();
       final setCallback = lib.lookupFunction<
-          Void Function(
-              Pointer<Void>,
-              Pointer<NativeFunction<RacTelemetryHttpCallbackNative>>,
-              Pointer<Void>),
-          void Function(
-              Pointer<Void>,
-              Pointer<NativeFunction<RacTelemetryHttpCallbackNative>>,
-              Pointer<Void>)>('rac_telemetry_manager_set_http_callback');
-
-      _httpCallbackPtr = Pointer.fromFunction<RacTelemetryHttpCallbackNative>(
-          _telemetryHttpCallback);
+              Void Function(
+                  Pointer<Void>,
+                  Pointer<NativeFunction<RacTelemetryHttpRequestCallbackNative>>,
+                  Pointer<Void>),
+              void Function(
+                  Pointer<Void>,
+                  Pointer<NativeFunction<RacTelemetryHttpRequestCallbackNative>>,
+                  Pointer<Void>)>(
+          'rac_telemetry_manager_set_http_request_callback');
+
+      _httpCallbackPtr =
+          Pointer.fromFunction<RacTelemetryHttpRequestCallbackNative>(
+              _telemetryHttpCallback);
 
       setCallback(_managerPtr!, _httpCallbackPtr!, nullptr);
       _logger.debug('Telemetry HTTP callback registered');
@@ -608,9 +634,11 @@ class DartBridgeTelemetry {
 // HTTP Callback Function
 // =============================================================================
 
-/// HTTP callback invoked by C++ when telemetry needs to be sent
+/// HTTP callback invoked by C++ when telemetry needs to be sent.
+/// Only runs inside poll/flush, which are called on this isolate.
 void _telemetryHttpCallback(
   Pointer<Void> userData,
+  int requestId,
   Pointer<Utf8> endpoint,
   Pointer<Utf8> jsonBody,
   int jsonLength,
@@ -624,7 +652,7 @@ void _telemetryHttpCallback(
     final needsAuth = requiresAuth != 0;
 
     // Fire and forget HTTP call
-    unawaited(_sendTelemetryHttp(endpointStr, bodyStr, needsAuth));
+    unawaited(_sendTelemetryHttp(requestId, endpointStr, bodyStr, needsAuth));
   } catch (e) {
     SDKLogger('DartBridge.Telemetry').error('HTTP callback error: $e');
   }
@@ -632,7 +660,7 @@ void _telemetryHttpCallback(
 
 /// Send telemetry via HTTP
 Future<void> _sendTelemetryHttp(
-    String endpoint, String body, bool requiresAuth) async {
+    int requestId, String endpoint, String body, bool requiresAuth) async {
   try {
     final baseURL =
         DartBridgeTelemetry._baseURL ?? 'https://api.runanywhere.ai';
@@ -649,27 +677,30 @@ Future<void> _sendTelemetryHttp(
 
     final response = await http.post(url, headers: headers, body: body);
 
-    // Notify C++ of completion (optional - for retry logic)
+    // Notify C++ of completion (spools failed requests for retry)
     _notifyHttpComplete(
+      requestId,
       response.statusCode >= 200 && response.statusCode < 300,
       response.body,
       null,
     );
   } catch (e) {
-    _notifyHttpComplete(false, null, e.toString());
+    _notifyHttpComplete(requestId, false, null, e.toString());
   }
 }
 
 /// Notify C++ of HTTP completion
-void _notifyHttpComplete(bool success, String? responseJson, String? error) {
+void _notifyHttpComplete(
+    int requestId, bool success, String? responseJson, String? error) {
   if (DartBridgeTelemetry._managerPtr == null) return;
 
   try {
     final lib = PlatformLoader.loadCommons();
     final httpComplete = lib.lookupFunction<
-        Void Function(Pointer<Void>, Int32, Pointer<Utf8>, Pointer<Utf8>),
-        void Function(Pointer<Void>, int, Pointer<Utf8>,
-            Pointer<Utf8>)>('rac_telemetry_manager_http_complete');
+            Void Function(
+                Pointer<Void>, Uint64, Int32, Pointer<Utf8>, Pointer<Utf8>),
+            void Function(Pointer<Void>, int, int, Pointer<Utf8>, Pointer<Utf8>)>(
+        'rac_telemetry_manager_http_request_complete');
 
     final responsePtr = responseJson?.toNativeUtf8() ?? nullptr;
     final errorPtr = error?.toNativeUtf8() ?? nullptr;
@@ -677,6 +708,7 @@ void _notifyHttpComplete(bool success, String? responseJson, String? error) {
     try {
       httpComplete(
         DartBridgeTelemetry._managerPtr!,
+        requestId,
         success ? 1 : 0,
         responsePtr.cast<Utf8>(),
         errorPtr.cast<Utf8>(),
@@ -694,9 +726,10 @@ void _notifyHttpComplete(bool success, String? responseJson, String? error) {
 // FFI Types
 // =============================================================================
 
-/// HTTP callback type: void (*callback)(void*, const char*, const char*, size_t, rac_bool_t)
-typedef RacTelemetryHttpCallbackNative = Void Function(
-    Pointer<Void>, Pointer<Utf8>, Pointer<Utf8>, IntPtr, Int32);
+/// HTTP callback type:
+/// void (*callback)(void*, uint64_t, const char*, const char*, size_t, rac_bool_t)
+typedef RacTelemetryHttpRequestCallbackNative = Void Function(
+    Pointer<Void>, Uint64, Pointer<Utf8>, Pointer<Utf8>, IntPtr, Int32);
 
 /// Analytics event data struct
 base class RacAnalyticsEventDataStruct extends Struct {
@@ -16,6 +16,8 @@ import java.io.OutputStreamWriter
 import java.net.HttpURLConnection
 import java.net.URL
 import java.util.concurrent.Executors
+import java.util.concurrent.ScheduledFuture
+import java.util.concurrent.TimeUnit
 
 /**
  * Telemetry bridge that provides HTTP callback for C++ core telemetry operations.
@@ -96,6 +98,12 @@ object CppBridgeTelemetry {
      */
     private const val DEFAULT_READ_TIMEOUT_MS = 30_000
 
+    /**
+     * Interval between telemetry manager polls in milliseconds.
+     * C++ only sends batches from a poll or flush, never from its own threads.
+     */
+    private const val POLL_INTERVAL_MS = 1_000L
+
     /**
      * Background executor for HTTP requests.
      * Using a cached thread pool to handle concurrent telemetry requests efficiently.
@@ -107,6 +115,19 @@ object CppBridgeTelemetry {
             }
         }
 
+    /**
+     * Background executor that polls the telemetry manager.
+     */
+    private val pollExecutor =
+        Executors.newSingleThreadScheduledExecutor { runnable ->
+            Thread(runnable, "runanywhere-telemetry-poll").apply {
+                isDaemon = true
+            }
+        }
+
+    @Volatile
+    private var pollTask: ScheduledFuture<*>? = null
+
     /**
      * Optional interceptor for customizing HTTP requests.
      * Set this before calling [register] to customize requests (e.g., add auth headers).
@@ -243,6 +264,16 @@ object CppBridgeTelemetry {
                     httpCallback,
                 )
 
+                // Batches are sent when polled, so the HTTP callback runs on the poll thread
+                pollTask?.cancel(false)
+                pollTask =
+                    pollExecutor.scheduleWithFixedDelay(
+                        { poll() },
+                        POLL_INTERVAL_MS,
+                        POLL_INTERVAL_MS,
+                        TimeUnit.MILLISECONDS,
+                    )
+
                 CppBridgePlatformAdapter.logCallback(
                     CppBridgePlatformAdapter.LogLevel.INFO,
                     TAG,
@@ -610,6 +641,26 @@ object CppBridgeTelemetry {
         }
     }
 
+    /**
+     * Send due batches and spooled requests. Runs on the poll executor.
+     */
+    private fun poll() {
+        try {
+            synchronized(lock) {
+                if (telemetryManagerHandle != 0L) {
+                    com.runanywhere.sdk.native.bridge.RunAnywhereBridge
+                        .racTelemetryManagerPoll(telemetryManagerHandle)
+                }
+            }
+        } catch (e: Throwable) {
+            CppBridgePlatformAdapter.logCallback(
+                CppBridgePlatformAdapter.LogLevel.WARN,
+                TAG,
+                "Telemetry poll failed: ${e.message}",
+            )
+        }
+    }
+
     /**
      * Check if the telemetry callback is registered.
      */
@@ -866,6 +917,9 @@ object CppBridgeTelemetry {
                 return
             }
 
+            pollTask?.cancel(false)
+            pollTask = null
+
             // Destroy telemetry manager
             if (telemetryManagerHandle != 0L) {
                 com.runanywhere.sdk.native.bridge.RunAnywhereBridge
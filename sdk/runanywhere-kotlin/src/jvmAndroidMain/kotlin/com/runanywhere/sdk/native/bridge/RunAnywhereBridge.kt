@@ -724,6 +724,13 @@ object RunAnywhereBridge {
     @JvmStatic
     external fun racTelemetryManagerFlush(handle: Long): Int
 
+    /**
+     * Send due telemetry batches and spooled requests.
+     * The HTTP callback runs on the calling thread; call about once a second.
+     */
+    @JvmStatic
+    external fun racTelemetryManagerPoll(handle: Long): Int
+
     // ========================================================================
     // ANALYTICS EVENTS (rac_analytics_events.h)
     // ========================================================================
@@ -53,6 +53,7 @@
 #include "rac_voice_agent.h"
 #include "rac_types.h"
 #include "rac_model_assignment.h"
+#include "rac_base64.h"
 
 #include <sstream>
 #include <chrono>
@@ -92,47 +93,24 @@ using namespace ::runanywhere::bridges;
 
 namespace {
 
-static const std::string base64_chars =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 std::vector<uint8_t> base64Decode(const std::string& encoded) {
-    std::vector<uint8_t> decoded;
-    if (encoded.empty()) return decoded;
-
-    int val = 0, valb = -8;
-    for (char c : encoded) {
-        if (c == '=' || c == '\n' || c == '\r') continue;
-        size_t pos = base64_chars.find(c);
-        if (pos == std::string::npos) continue;
-        val = (val << 6) + static_cast<int>(pos);
-        valb += 6;
-        if (valb >= 0) {
-            decoded.push_back(static_cast<uint8_t>((val >> valb) & 0xFF));
-            valb -= 8;
-        }
+    std::vector<uint8_t> decoded(rac_base64_decoded_max_size(encoded.size()));
+    size_t size = 0;
+    if (rac_base64_decode(encoded.data(), encoded.size(), decoded.data(), decoded.size(),
+                          &size) != RAC_SUCCESS) {
+        return {};
     }
+    decoded.resize(size);
     return decoded;
 }
 
 std::string base64Encode(const uint8_t* data, size_t len) {
-    std::string encoded;
-    if (!data || len == 0) return encoded;
-
-    int val = 0, valb = -6;
-    for (size_t i = 0; i < len; i++) {
-        val = (val << 8) + data[i];
-        valb += 8;
-        while (valb >= 0) {
-            encoded.push_back(base64_chars[(val >> valb) & 0x3F]);
-            valb -= 6;
-        }
-    }
-    if (valb > -6) {
-        encoded.push_back(base64_chars[((val << 8) >> (valb + 8)) & 0x3F]);
-    }
-    while (encoded.size() % 4) {
-        encoded.push_back('=');
+    std::string encoded(rac_base64_encoded_size(len), '\0');
+    size_t length = 0;
+    if (rac_base64_encode(data, len, &encoded[0], encoded.size(), &length) != RAC_SUCCESS) {
+        return {};
     }
+    encoded.resize(length);
     return encoded;
 }
 
@@ -16,9 +16,13 @@
 #include "AuthBridge.hpp"
 #include "rac_dev_config.h"
 
+#include <chrono>
+
 // Platform-specific logging
 #if defined(ANDROID) || defined(__ANDROID__)
 #include <android/log.h>
+#include <jni.h>
+extern JavaVM* g_javaVM;
 #define LOG_TAG "TelemetryBridge"
 #define LOGI(...) __android_log_print(ANDROID_LOG_INFO, LOG_TAG, __VA_ARGS__)
 #define LOGW(...) __android_log_print(ANDROID_LOG_WARN, LOG_TAG, __VA_ARGS__)
@@ -37,6 +41,7 @@ namespace bridges {
 // Forward declarations for callbacks
 static void telemetryHttpCallback(
     void* userData,
+    uint64_t requestId,
     const char* endpoint,
     const char* jsonBody,
     size_t jsonLength,
@@ -77,6 +82,7 @@ void TelemetryBridge::initialize(
 
     // Destroy existing manager if any
     if (manager_) {
+        stopPolling();
         rac_telemetry_manager_flush(manager_);
         rac_telemetry_manager_destroy(manager_);
         manager_ = nullptr;
@@ -105,9 +111,11 @@ void TelemetryBridge::initialize(
     // Matches Swift: rac_telemetry_manager_set_device_info(manager, model, os)
     rac_telemetry_manager_set_device_info(manager_, deviceModel.c_str(), osVersion.c_str());
 
-    // Register HTTP callback - this is where platform provides HTTP transport
-    // Matches Swift: rac_telemetry_manager_set_http_callback(manager, telemetryHttpCallback, userData)
-    rac_telemetry_manager_set_http_callback(manager_, telemetryHttpCallback, this);
+    // Register HTTP callback - this is where platform provides HTTP transport.
+    // The request variant lets completions be reported per request.
+    rac_telemetry_manager_set_http_request_callback(manager_, telemetryHttpCallback, this);
+
+    startPolling();
 
     LOGI("Telemetry manager initialized successfully");
 }
@@ -124,6 +132,8 @@ void TelemetryBridge::shutdown() {
     if (manager_) {
         LOGI("Shutting down telemetry manager...");
 
+        stopPolling();
+
         // Flush pending events
         rac_telemetry_manager_flush(manager_);
 
@@ -161,6 +171,8 @@ void TelemetryBridge::trackAnalyticsEvent(
     if (result != RAC_SUCCESS) {
         LOGE("Failed to track analytics event: %d", result);
     }
+
+    // Tracking only queues; the poll thread sends it
 }
 
 void TelemetryBridge::flush() {
@@ -174,6 +186,51 @@ void TelemetryBridge::flush() {
     rac_telemetry_manager_flush(manager_);
 }
 
+// ============================================================================
+// Poll Thread
+// ============================================================================
+
+/**
+ * Matches the Swift dispatch timer, Kotlin scheduled executor and Dart
+ * Timer.periodic: the manager never sends on its own, so poll it from a
+ * thread the bridge owns. It captures the manager and never takes mutex_,
+ * so tracking is not blocked while a request is in flight; stopPolling()
+ * joins it before the manager is destroyed.
+ */
+void TelemetryBridge::startPolling() {
+    {
+        std::lock_guard<std::mutex> lock(pollMutex_);
+        pollStop_ = false;
+    }
+    rac_telemetry_manager_t* manager = manager_;
+    pollThread_ = std::thread([this, manager]() {
+        std::unique_lock<std::mutex> lock(pollMutex_);
+        while (!pollCv_.wait_for(lock, std::chrono::seconds(1), [this] { return pollStop_; })) {
+            lock.unlock();
+            rac_telemetry_manager_poll(manager);
+            lock.lock();
+        }
+#if defined(ANDROID) || defined(__ANDROID__)
+        // httpPostSync attaches this thread to the JVM
+        if (g_javaVM) {
+            g_javaVM->DetachCurrentThread();
+        }
+#endif
+    });
+}
+
+void TelemetryBridge::stopPolling() {
+    if (!pollThread_.joinable()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pollMutex_);
+        pollStop_ = true;
+    }
+    pollCv_.notify_all();
+    pollThread_.join();
+}
+
 // ============================================================================
 // Events Callback Registration
 // ============================================================================
@@ -215,6 +272,7 @@ void TelemetryBridge::unregisterEventsCallback() {
 
 /**
  * HTTP callback invoked by C++ telemetry manager when it's time to send events.
+ * Runs inside rac_telemetry_manager_poll/flush on the thread that called them.
  *
  * C++ has already:
  * - Built the JSON payload
@@ -227,6 +285,7 @@ void TelemetryBridge::unregisterEventsCallback() {
  */
 static void telemetryHttpCallback(
     void* userData,
+    uint64_t requestId,
     const char* endpoint,
     const char* jsonBody,
     size_t jsonLength,
@@ -305,8 +364,9 @@ static void telemetryHttpCallback(
         LOGI("✅ Telemetry sent successfully (status=%d)", statusCode);
 
         // Notify C++ that HTTP completed
-        rac_telemetry_manager_http_complete(
+        rac_telemetry_manager_http_request_complete(
             bridge->getHandle(),
+            requestId,
             RAC_TRUE,
             responseBody.c_str(),
             nullptr
@@ -315,8 +375,9 @@ static void telemetryHttpCallback(
         LOGE("❌ Telemetry HTTP failed: status=%d, error=%s", statusCode, errorMessage.c_str());
 
         // Notify C++ of failure
-        rac_telemetry_manager_http_complete(
+        rac_telemetry_manager_http_request_complete(
             bridge->getHandle(),
+            requestId,
             RAC_FALSE,
             nullptr,
             errorMessage.c_str()
@@ -9,12 +9,16 @@
  * - C++ telemetry manager handles all event logic (batching, JSON building)
  * - Platform SDK (React Native) only provides HTTP transport
  * - Events from analytics callback are routed to telemetry manager
+ * - A bridge-owned thread polls the manager, so HTTP never runs on the
+ *   thread that tracked the event
  */
 
 #pragma once
 
+#include <condition_variable>
 #include <string>
 #include <mutex>
+#include <thread>
 #include "rac_telemetry_manager.h"
 #include "rac_analytics_events.h"
 #include "rac_environment.h"
@@ -108,6 +112,10 @@ private:
     TelemetryBridge(const TelemetryBridge&) = delete;
     TelemetryBridge& operator=(const TelemetryBridge&) = delete;
 
+    // Poll thread lifecycle (caller holds mutex_)
+    void startPolling();
+    void stopPolling();
+
     // Telemetry manager handle
     rac_telemetry_manager_t* manager_ = nullptr;
 
@@ -119,6 +127,12 @@ private:
 
     // Events callback registered flag
     bool eventsCallbackRegistered_ = false;
+
+    // Sends due batches and spool replays about once a second
+    std::thread pollThread_;
+    std::mutex pollMutex_;
+    std::condition_variable pollCv_;
+    bool pollStop_ = false;
 };
 
 } // namespace bridges
@@ -23,6 +23,7 @@ extern "C" {
 
 // Unified logging via rac_logger.h
 #include "rac_logger.h"
+#include "rac_base64.h"
 
 #include <sstream>
 #include <chrono>
@@ -99,23 +100,13 @@ std::string jsonString(const std::string& value) {
 
 // Base64 decoding for rgbPixels image format
 std::vector<uint8_t> base64Decode(const std::string& encoded) {
-  static const std::string base64_chars =
-      "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
-  std::vector<uint8_t> decoded;
-  std::vector<int> T(256, -1);
-  for (int i = 0; i < 64; i++) T[base64_chars[i]] = i;
-
-  int val = 0, valb = -8;
-  for (unsigned char c : encoded) {
-    if (T[c] == -1) break;
-    val = (val << 6) + T[c];
-    valb += 6;
-    if (valb >= 0) {
-      decoded.push_back(char((val >> valb) & 0xFF));
-      valb -= 8;
-    }
+  std::vector<uint8_t> decoded(rac_base64_decoded_max_size(encoded.size()));
+  size_t size = 0;
+  if (rac_base64_decode(encoded.data(), encoded.size(), decoded.data(), decoded.size(),
+                        &size) != RAC_SUCCESS) {
+    return {};
   }
+  decoded.resize(size);
   return decoded;
 }
 
@@ -22,6 +22,7 @@ extern "C" {
 
 // RACommons logger - unified logging across platforms
 #include "rac_logger.h"
+#include "rac_base64.h"
 
 #include <sstream>
 #include <chrono>
@@ -41,47 +42,24 @@ using namespace ::runanywhere::bridges;
 
 namespace {
 
-static const std::string BASE64_CHARS =
-    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
-
 std::string base64Encode(const unsigned char* data, size_t length) {
-  std::string result;
-  result.reserve(((length + 2) / 3) * 4);
-
-  for (size_t i = 0; i < length; i += 3) {
-    unsigned int n = static_cast<unsigned int>(data[i]) << 16;
-    if (i + 1 < length) n |= static_cast<unsigned int>(data[i + 1]) << 8;
-    if (i + 2 < length) n |= static_cast<unsigned int>(data[i + 2]);
-
-    result.push_back(BASE64_CHARS[(n >> 18) & 0x3F]);
-    result.push_back(BASE64_CHARS[(n >> 12) & 0x3F]);
-    result.push_back((i + 1 < length) ? BASE64_CHARS[(n >> 6) & 0x3F] : '=');
-    result.push_back((i + 2 < length) ? BASE64_CHARS[n & 0x3F] : '=');
+  std::string result(rac_base64_encoded_size(length), '\0');
+  size_t written = 0;
+  if (rac_base64_encode(data, length, &result[0], result.size(), &written) != RAC_SUCCESS) {
+    return {};
   }
-
+  result.resize(written);
   return result;
 }
 
 std::vector<unsigned char> base64Decode(const std::string& encoded) {
-  std::vector<unsigned char> result;
-  result.reserve((encoded.size() / 4) * 3);
-
-  std::vector<int> T(256, -1);
-  for (int i = 0; i < 64; i++) {
-    T[static_cast<unsigned char>(BASE64_CHARS[i])] = i;
+  std::vector<unsigned char> result(rac_base64_decoded_max_size(encoded.size()));
+  size_t size = 0;
+  if (rac_base64_decode(encoded.data(), encoded.size(), result.data(), result.size(),
+                        &size) != RAC_SUCCESS) {
+    return {};
   }
-
-  int val = 0, valb = -8;
-  for (unsigned char c : encoded) {
-    if (T[c] == -1) break;
-    val = (val << 6) + T[c];
-    valb += 6;
-    if (valb >= 0) {
-      result.push_back(static_cast<unsigned char>((val >> valb) & 0xFF));
-      valb -= 8;
-    }
-  }
-
+  result.resize(size);
   return result;
 }
 
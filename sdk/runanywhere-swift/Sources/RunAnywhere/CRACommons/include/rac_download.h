@@ -272,6 +272,33 @@ RAC_API rac_result_t rac_download_manager_start(rac_download_manager_handle_t ha
                                                 rac_download_complete_callback_fn complete_callback,
                                                 void* user_data, char** out_task_id);
 
+/**
+ * @brief Start downloading a model and verify its SHA-256.
+ *
+ * Same as rac_download_manager_start(), plus an expected digest for the
+ * downloaded file (the archive itself when requires_extraction is set).
+ * When the platform adapter has no http_download callback and the native
+ * downloader is available, the manager runs the download itself and the
+ * digest is checked while the file is written. Otherwise the file passed
+ * to rac_download_manager_mark_complete() is hashed before it is accepted.
+ * A mismatch fails the task with RAC_ERROR_CHECKSUM_MISMATCH.
+ *
+ * In the native case a TAR_GZ, TAR_BZ2 or TAR_XZ archive with
+ * requires_extraction set is extracted while it downloads
+ * (rac_native_download_extract_start): destination_path is the directory
+ * the contents go into, the archive is never stored, and the task reports
+ * the extraction stage for the whole transfer.
+ *
+ * @param expected_sha256 Expected SHA-256 as 64 hex characters, or NULL to
+ *                        skip verification
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_download_manager_start_verified(
+    rac_download_manager_handle_t handle, const char* model_id, const char* url,
+    const char* destination_path, rac_bool_t requires_extraction, const char* expected_sha256,
+    rac_download_progress_callback_fn progress_callback,
+    rac_download_complete_callback_fn complete_callback, void* user_data, char** out_task_id);
+
 /**
  * @brief Cancel a download.
  *
@@ -86,6 +86,23 @@ RAC_API rac_result_t rac_model_registry_save(rac_model_registry_handle_t handle,
 RAC_API rac_result_t rac_model_registry_get(rac_model_registry_handle_t handle,
                                             const char* model_id, rac_model_info_t** out_model);
 
+/**
+ * @brief Get model metadata by local path.
+ *
+ * Returns the model whose local_path equals the given path. Otherwise returns
+ * the model whose local_path is the longest prefix of the given path (a file
+ * inside a model folder), or else a model stored below the given path.
+ * This is useful when loading models by path instead of model_id.
+ *
+ * @param handle Registry handle
+ * @param local_path Local path to search for
+ * @param out_model Output: Model info (owned, must be freed with rac_model_info_free)
+ * @return RAC_SUCCESS, RAC_ERROR_NOT_FOUND, or other error code
+ */
+RAC_API rac_result_t rac_model_registry_get_by_path(rac_model_registry_handle_t handle,
+                                                    const char* local_path,
+                                                    rac_model_info_t** out_model);
+
 /**
  * @brief Load all stored models.
  *
@@ -168,6 +185,165 @@ RAC_API rac_result_t rac_model_registry_update_download_status(rac_model_registr
                                                                const char* model_id,
                                                                const char* local_path);
 
+/**
+ * @brief Get models in a category.
+ *
+ * @param handle Registry handle
+ * @param category Model category
+ * @param out_models Output: Array of model info (owned, each must be freed)
+ * @param out_count Output: Number of models
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_model_registry_get_by_category(rac_model_registry_handle_t handle,
+                                                        rac_model_category_t category,
+                                                        rac_model_info_t*** out_models,
+                                                        size_t* out_count);
+
+/**
+ * @brief Get the registry version.
+ *
+ * The version increases with every change to the registry, so callers can
+ * cheaply tell whether a cached model list is stale.
+ *
+ * @param handle Registry handle
+ * @return Current version (0 for a NULL handle)
+ */
+RAC_API uint64_t rac_model_registry_get_version(rac_model_registry_handle_t handle);
+
+// =============================================================================
+// SNAPSHOT API - Lock-free reads without copying
+// =============================================================================
+
+/**
+ * @brief Opaque handle for an immutable view of the registry.
+ *
+ * A snapshot captures the registry at one version. Later saves, removals and
+ * status updates do not affect it. All model pointers returned by the
+ * snapshot functions are borrowed from the snapshot and stay valid until it
+ * is released; they must not be modified or freed.
+ */
+typedef struct rac_model_registry_snapshot* rac_model_registry_snapshot_t;
+
+/**
+ * @brief Acquire the current registry snapshot.
+ *
+ * Does not block on writers and does not copy any model.
+ *
+ * @param handle Registry handle
+ * @param out_snapshot Output: Snapshot (must be released with rac_model_registry_snapshot_release)
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_model_registry_snapshot_acquire(rac_model_registry_handle_t handle,
+                                                         rac_model_registry_snapshot_t* out_snapshot);
+
+/**
+ * @brief Release a snapshot.
+ *
+ * @param snapshot Snapshot to release (can be NULL)
+ */
+RAC_API void rac_model_registry_snapshot_release(rac_model_registry_snapshot_t snapshot);
+
+/**
+ * @brief Get the registry version captured by a snapshot.
+ */
+RAC_API uint64_t rac_model_registry_snapshot_version(rac_model_registry_snapshot_t snapshot);
+
+/**
+ * @brief Find a model by ID in a snapshot.
+ *
+ * @return Borrowed model info, or NULL if not found
+ */
+RAC_API const rac_model_info_t* rac_model_registry_snapshot_find(
+    rac_model_registry_snapshot_t snapshot, const char* model_id);
+
+/**
+ * @brief Find a model by local path in a snapshot.
+ *
+ * Same matching rules as rac_model_registry_get_by_path().
+ *
+ * @return Borrowed model info, or NULL if not found
+ */
+RAC_API const rac_model_info_t* rac_model_registry_snapshot_find_by_path(
+    rac_model_registry_snapshot_t snapshot, const char* local_path);
+
+/**
+ * @brief Get all models in a snapshot, ordered by ID.
+ *
+ * @param snapshot Snapshot
+ * @param out_models Output: Borrowed array of models (NULL when empty)
+ * @param out_count Output: Number of models
+ * @return RAC_SUCCESS or error code
+ */
+RAC_API rac_result_t rac_model_registry_snapshot_get_all(rac_model_registry_snapshot_t snapshot,
+                                                         const rac_model_info_t* const** out_models,
+                                                         size_t* out_count);
+
+/**
+ * @brief Get the models of one framework in a snapshot, ordered by ID.
+ *
+ * @see rac_model_registry_snapshot_get_all
+ */
+RAC_API rac_result_t rac_model_registry_snapshot_get_by_framework(
+    rac_model_registry_snapshot_t snapshot, rac_inference_framework_t framework,
+    const rac_model_info_t* const** out_models, size_t* out_count);
+
+/**
+ * @brief Get the models of one category in a snapshot, ordered by ID.
+ *
+ * @see rac_model_registry_snapshot_get_all
+ */
+RAC_API rac_result_t rac_model_registry_snapshot_get_by_category(
+    rac_model_registry_snapshot_t snapshot, rac_model_category_t category,
+    const rac_model_info_t* const** out_models, size_t* out_count);
+
+/**
+ * @brief Get the downloaded models in a snapshot, ordered by ID.
+ *
+ * @see rac_model_registry_snapshot_get_all
+ */
+RAC_API rac_result_t rac_model_registry_snapshot_get_downloaded(
+    rac_model_registry_snapshot_t snapshot, const rac_model_info_t* const** out_models,
+    size_t* out_count);
+
+// =============================================================================
+// CATALOG API - Persist the registry between launches
+// =============================================================================
+
+/**
+ * @brief Write all registered models to a binary catalog file.
+ *
+ * The file is replaced atomically. For each downloaded model the size and
+ * modification time of its local path are recorded; a local path that no
+ * longer exists is written as not downloaded.
+ *
+ * @param handle Registry handle
+ * @param catalog_path Catalog file to write
+ * @return RAC_SUCCESS or RAC_ERROR_FILE_WRITE_FAILED
+ */
+RAC_API rac_result_t rac_model_registry_write_catalog(rac_model_registry_handle_t handle,
+                                                      const char* catalog_path);
+
+/**
+ * @brief Register the models stored in a catalog file.
+ *
+ * The file is memory-mapped and all models are added in a single registry
+ * update. The global registry (rac_get_model_registry) loads
+ * {base_dir}/RunAnywhere/Cache/model_registry.catalog on first use after
+ * rac_model_paths_set_base_dir, and rac_shutdown writes it back. Models already registered are kept. Local paths are not checked
+ * here: each model's path is compared with the recorded size and
+ * modification time the first time the model is read, and the model is
+ * marked not downloaded if they differ.
+ *
+ * @param handle Registry handle
+ * @param catalog_path Catalog file written by rac_model_registry_write_catalog
+ * @param out_loaded Output: Number of models added (can be NULL)
+ * @return RAC_SUCCESS, RAC_ERROR_FILE_NOT_FOUND, or RAC_ERROR_INVALID_FORMAT
+ *         if the file is corrupt or from an incompatible version
+ */
+RAC_API rac_result_t rac_model_registry_load_catalog(rac_model_registry_handle_t handle,
+                                                     const char* catalog_path,
+                                                     size_t* out_loaded);
+
 // =============================================================================
 // QUERY HELPERS
 // =============================================================================
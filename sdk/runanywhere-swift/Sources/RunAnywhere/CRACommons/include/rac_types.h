@@ -142,6 +142,27 @@ typedef struct rac_audio_format {
     int32_t bits_per_sample; /**< Bits per sample (16 or 32) */
 } rac_audio_format_t;
 
+/**
+ * PCM sample encoding for audio views.
+ */
+typedef enum rac_audio_sample_format {
+    RAC_AUDIO_SAMPLE_FLOAT32 = 0, /**< 32-bit float samples in [-1.0, 1.0] */
+    RAC_AUDIO_SAMPLE_INT16 = 1,   /**< Signed 16-bit little-endian samples */
+} rac_audio_sample_format_t;
+
+/**
+ * Non-owning view over interleaved PCM audio.
+ * Passed through service vtables and backends so audio is only converted
+ * where a backend needs a different encoding, never copied for transport.
+ */
+typedef struct rac_audio_view {
+    const void* data;                 /**< Interleaved samples (not owned) */
+    size_t num_frames;                /**< Frames (samples per channel) */
+    rac_audio_sample_format_t format; /**< Sample encoding of data */
+    int32_t sample_rate;              /**< Sample rate in Hz */
+    int32_t channels;                 /**< Interleaved channel count (>= 1) */
+} rac_audio_view_t;
+
 // =============================================================================
 // MEMORY INFO
 // =============================================================================
@@ -71,12 +71,19 @@ extension CppBridge {
         private static var manager: OpaquePointer?
         private static let lock = NSLock()
 
+        /// C++ only sends batches from a poll or flush, so HTTP callbacks run on this queue
+        private static var pollTimer: DispatchSourceTimer?
+        private static let pollQueue = DispatchQueue(label: "com.runanywhere.sdk.telemetry.poll", qos: .utility)
+        private static let pollInterval: DispatchTimeInterval = .seconds(1)
+
         /// Initialize telemetry manager
         static func initialize(environment: SDKEnvironment) {
             lock.lock()
             defer { lock.unlock() }
 
             // Destroy existing if any
+            pollTimer?.cancel()
+            pollTimer = nil
             if let existing = manager {
                 rac_telemetry_manager_destroy(existing)
             }
@@ -102,6 +109,12 @@ extension CppBridge {
             // Register HTTP callback - Swift provides HTTP transport for C++
             let userData = Unmanaged.passUnretained(Telemetry.self as AnyObject).toOpaque()
             rac_telemetry_manager_set_http_callback(manager, telemetryHttpCallback, userData)
+
+            let timer = DispatchSource.makeTimerSource(queue: pollQueue)
+            timer.schedule(deadline: .now() + pollInterval, repeating: pollInterval)
+            timer.setEventHandler { poll() }
+            timer.resume()
+            pollTimer = timer
         }
 
         /// Shutdown telemetry manager
@@ -109,6 +122,9 @@ extension CppBridge {
             lock.lock()
             defer { lock.unlock() }
 
+            pollTimer?.cancel()
+            pollTimer = nil
+
             if let mgr = manager {
                 rac_telemetry_manager_flush(mgr)
                 rac_telemetry_manager_destroy(mgr)
@@ -129,6 +145,15 @@ extension CppBridge {
             rac_telemetry_manager_track_analytics(mgr, type, data)
         }
 
+        /// Send due batches and spooled requests (runs on the poll queue)
+        private static func poll() {
+            lock.lock()
+            defer { lock.unlock() }
+
+            guard let mgr = manager else { return }
+            rac_telemetry_manager_poll(mgr)
+        }
+
         /// Flush pending events
         public static func flush() {
             lock.lock()
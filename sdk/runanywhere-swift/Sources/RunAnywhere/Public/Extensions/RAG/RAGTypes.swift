@@ -48,6 +48,16 @@ public struct RAGConfiguration: Sendable {
     /// Optional configuration JSON for the LLM model
     public let llmConfigJSON: String?
 
+    /// Optional path to a cross-encoder reranker model (ONNX).
+    /// When set, the top `rerankCandidates` vector hits are rescored and the best `topK` kept.
+    public let rerankerModelPath: String?
+
+    /// Optional configuration JSON for the reranker model
+    public let rerankerConfigJSON: String?
+
+    /// Chunks rescored by the reranker per query (default: 50)
+    public let rerankCandidates: Int
+
     public init(
         embeddingModelPath: String,
         llmModelPath: String,
@@ -59,7 +69,10 @@ public struct RAGConfiguration: Sendable {
         chunkOverlap: Int = 50,
         promptTemplate: String? = nil,
         embeddingConfigJSON: String? = nil,
-        llmConfigJSON: String? = nil
+        llmConfigJSON: String? = nil,
+        rerankerModelPath: String? = nil,
+        rerankerConfigJSON: String? = nil,
+        rerankCandidates: Int = 50
     ) {
         self.embeddingModelPath = embeddingModelPath
         self.llmModelPath = llmModelPath
@@ -72,6 +85,9 @@ public struct RAGConfiguration: Sendable {
         self.promptTemplate = promptTemplate
         self.embeddingConfigJSON = embeddingConfigJSON
         self.llmConfigJSON = llmConfigJSON
+        self.rerankerModelPath = rerankerModelPath
+        self.rerankerConfigJSON = rerankerConfigJSON
+        self.rerankCandidates = rerankCandidates
     }
 
     // MARK: - C Bridge (rac_rag_config_t)
@@ -85,19 +101,26 @@ public struct RAGConfiguration: Sendable {
                 try withOptionalCString(promptTemplate) { promptPtr in
                     try withOptionalCString(embeddingConfigJSON) { embConfigPtr in
                         try withOptionalCString(llmConfigJSON) { llmConfigPtr in
-                            var config = rac_rag_config_t()
-                            config.embedding_model_path = embPathPtr
-                            config.llm_model_path = llmPathPtr
-                            config.embedding_dimension = embeddingDimension
-                            config.top_k = topK
-                            config.similarity_threshold = similarityThreshold
-                            config.max_context_tokens = maxContextTokens
-                            config.chunk_size = chunkSize
-                            config.chunk_overlap = chunkOverlap
-                            config.prompt_template = promptPtr
-                            config.embedding_config_json = embConfigPtr
-                            config.llm_config_json = llmConfigPtr
-                            return try body(config)
+                            try withOptionalCString(rerankerModelPath) { rerankerPathPtr in
+                                try withOptionalCString(rerankerConfigJSON) { rerankerConfigPtr in
+                                    var config = rac_rag_config_t()
+                                    config.embedding_model_path = embPathPtr
+                                    config.llm_model_path = llmPathPtr
+                                    config.embedding_dimension = embeddingDimension
+                                    config.top_k = topK
+                                    config.similarity_threshold = similarityThreshold
+                                    config.max_context_tokens = maxContextTokens
+                                    config.chunk_size = chunkSize
+                                    config.chunk_overlap = chunkOverlap
+                                    config.prompt_template = promptPtr
+                                    config.embedding_config_json = embConfigPtr
+                                    config.llm_config_json = llmConfigPtr
+                                    config.reranker_model_path = rerankerPathPtr
+                                    config.reranker_config_json = rerankerConfigPtr
+                                    config.rerank_candidates = rerankCandidates
+                                    return try body(config)
+                                }
+                            }
                         }
                     }
                 }
@@ -121,6 +121,7 @@ export interface LlamaCppModule {
   _rac_telemetry_manager_set_http_callback?: (handle: number, callbackPtr: number, userData: number) => void;
   _rac_telemetry_manager_track_analytics?: (handle: number, eventType: number, dataPtr: number) => number;
   _rac_telemetry_manager_flush?: (handle: number) => number;
+  _rac_telemetry_manager_poll?: (handle: number) => number;
   _rac_telemetry_manager_http_complete?: (handle: number, success: number, responsePtr: number, errorPtr: number) => void;
 
   // Analytics Events
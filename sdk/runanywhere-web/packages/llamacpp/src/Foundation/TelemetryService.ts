@@ -141,6 +141,10 @@ export class TelemetryService {
       if (typeof this._module._rac_telemetry_manager_track_analytics === 'function') {
         this._module._rac_telemetry_manager_track_analytics!(this._handle, eventType, dataPtr);
       }
+      // Tracking only queues in pthread builds; send what is due from this thread
+      if (typeof this._module._rac_telemetry_manager_poll === 'function') {
+        this._module._rac_telemetry_manager_poll!(this._handle);
+      }
     } catch {
       // Silent — telemetry must never crash the app
     }